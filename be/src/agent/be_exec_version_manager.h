@@ -51,7 +51,11 @@ private:
 // 1: start from doris 1.2
 //    a. remove ColumnString terminating zero.
 //    b. runtime filter use new hash method.
-inline const int BeExecVersionManager::max_be_exec_version = 1;
+// 2: column encodings in Block::serialize
+//    a. bit packed integers.
+//    b. dictionary encoded strings.
+//    c. no null map if a nullable column has no null.
+inline const int BeExecVersionManager::max_be_exec_version = 2;
 inline const int BeExecVersionManager::min_be_exec_version = 0;
 
 } // namespace doris
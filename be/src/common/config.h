@@ -216,6 +216,16 @@ CONF_mInt32(max_pushdown_conditions_per_column, "1024");
 CONF_mInt32(doris_max_pushdown_conjuncts_return_rate, "90");
 // (Advanced) Maximum size of per-query receive-side buffer
 CONF_mInt32(exchg_node_buffer_size_bytes, "20485760");
+// Maximum number of blocks queued from local senders in each sender queue of a pipeline
+// exchange, senders wait for the queue to have room before they send more.
+CONF_mInt32(exchg_node_local_queue_capacity, "16");
+// When fragment_transmission_compression_codec is "adaptive", one of every
+// adaptive_exchange_compression_sample_interval blocks sent to a channel of an exchange is
+// compressed with each codec to choose the one with the lowest cost, given the throughput
+// measured from the RPCs of the channel. adaptive_exchange_compression_bandwidth_mb MB/s is
+// assumed until the first RPC is measured.
+CONF_mInt32(adaptive_exchange_compression_sample_interval, "64");
+CONF_mInt32(adaptive_exchange_compression_bandwidth_mb, "1000");
 
 CONF_mInt64(column_dictionary_key_ratio_threshold, "0");
 CONF_mInt64(column_dictionary_key_size_threshold, "0");
@@ -261,6 +271,12 @@ CONF_String(storage_page_cache_limit, "20%");
 // Shard size for page cache, the value must be power of two.
 // It's recommended to set it to a value close to the number of BE cores in order to reduce lock contentions.
 CONF_Int32(storage_page_cache_shard_size, "16");
+// Admission policy of the page cache, the row cache and the segment cache, LRU or TinyLFU.
+// With TinyLFU a new entry replaces an old one only if it is accessed more frequently,
+// so that big scans could not flush the entries used by other queries.
+CONF_String(storage_page_cache_admission_policy, "LRU");
+CONF_String(row_cache_admission_policy, "LRU");
+CONF_String(segment_cache_admission_policy, "LRU");
 // Percentage for index page cache
 // all storage page cache will be divided into data_page_cache and index_page_cache
 CONF_Int32(index_page_cache_percentage, "10");
@@ -269,6 +285,18 @@ CONF_Bool(disable_storage_page_cache, "false");
 // whether to disable row cache feature in storage
 CONF_Bool(disable_storage_row_cache, "true");
 
+// whether to read the data pages of a column ahead of the scan, in the background by the
+// SegmentPrefetchThreadPool
+CONF_mBool(enable_segment_page_prefetch, "true");
+// max number of data pages of one column read ahead of the scan
+CONF_mInt32(segment_page_prefetch_max_depth, "16");
+CONF_Int32(segment_page_prefetch_thread_num, "32");
+// allow the integer and date/datetime columns of new segments to be written with delta-of-delta
+// encoding, which is smaller for monotonic columns like timestamps and auto-increment ids. It is
+// chosen for each column of a segment if it encodes the first values of the column smaller than
+// the default encoding. segments written with it can not be read by the older versions.
+CONF_mBool(enable_delta_of_delta_encoding, "false");
+
 CONF_Bool(enable_low_cardinality_optimize, "true");
 
 // be policy
@@ -290,6 +318,15 @@ CONF_mInt64(vertical_compaction_max_segment_size, "268435456");
 // In ordered data compaction, min segment size for input rowset
 CONF_mInt32(ordered_data_compaction_min_segment_size, "10485760");
 
+// Split the input rows of a compaction into at most this number of key ranges, and merge
+// the ranges in parallel. 1 means disable.
+CONF_mInt32(compaction_key_range_parallelism, "1");
+// In key range parallel compaction, min input rows of each key range
+CONF_mInt64(compaction_key_range_min_rows, "10000000");
+// The max thread number of the pool to merge the key ranges of compactions. The threads are
+// created on demand and exit after being idle.
+CONF_Int32(compaction_key_range_max_threads, "8");
+
 // This config can be set to limit thread number in compaction thread pool.
 CONF_mInt32(max_base_compaction_threads, "4");
 CONF_mInt32(max_cumu_compaction_threads, "10");
@@ -514,6 +551,9 @@ CONF_Int32(memory_max_alignment, "16");
 CONF_mInt64(write_buffer_size, "209715200");
 // max buffer size used in memtable for the aggregated table, default 400MB
 CONF_mInt64(write_buffer_size_for_agg, "419430400");
+// If true, the memtable appends the loaded rows and sorts and aggregates them column-wise when
+// it is flushed, instead of inserting every row into a skiplist.
+CONF_mBool(enable_memtable_sort_on_flush, "false");
 
 CONF_Int32(load_process_max_memory_limit_percent, "50"); // 50%
 
@@ -709,6 +749,20 @@ CONF_Int32(download_cache_thread_pool_queue_size, "102400");
 // download cache buffer size
 CONF_Int64(download_cache_buffer_size, "10485760");
 
+// number of threads per spill dir doing the file I/O of spilled blocks
+CONF_Int32(spill_io_thread_num_per_disk, "2");
+// compression of spilled blocks, one of NONE, LZ4 and ZSTD
+CONF_String(spill_compression_type, "LZ4");
+// max number of serialized sub blocks of a spill file queued for the I/O threads,
+// a writer waits for the disk beyond it
+CONF_mInt32(spill_max_pending_sub_blocks, "4");
+
+// use io_uring for batched reads of local segment files, fall back to pread if
+// the kernel does not support it
+CONF_Bool(enable_io_uring, "false");
+// number of entries of the io_uring of each thread
+CONF_Int32(io_uring_queue_depth, "64");
+
 // Limit the number of segment of a newly created rowset.
 // The newly created rowset may to be compacted after loading,
 // so if there are too many segment in a rowset, the compaction process
@@ -810,12 +864,32 @@ CONF_mInt32(parquet_header_max_size_mb, "1");
 CONF_mInt32(parquet_rowgroup_max_buffer_mb, "128");
 // Max buffer size for parquet chunk column
 CONF_mInt32(parquet_column_max_buffer_mb, "8");
+// Whether a parquet row group which is not filtered by the min/max statistics is checked
+// against the dictionary pages and the bloom filters of its column chunks. Each check costs
+// an extra read per column chunk, which is a remote read for files in remote storage.
+CONF_mBool(enable_parquet_dict_filter, "true");
+CONF_mBool(enable_parquet_bloom_filter, "true");
+
+// The column chunks of a parquet row group and the streams of an orc stripe in remote storage
+// are coalesced when their gap is not larger than merge_range_io_max_gap_kb, and fetched by
+// at most merge_range_io_parallelism tasks of the MergeRangeIOThreadPool. At most
+// merge_range_io_max_buffer_mb of them are fetched ahead by a reader, and at most
+// merge_range_io_max_total_buffer_mb by all the readers. 0 parallelism disables it.
+CONF_Int32(merge_range_io_thread_num, "64");
+CONF_mInt32(merge_range_io_parallelism, "4");
+CONF_mInt32(merge_range_io_max_gap_kb, "1024");
+CONF_mInt32(merge_range_io_max_buffer_mb, "128");
+CONF_mInt32(merge_range_io_max_total_buffer_mb, "1024");
 
 // OrcReader
 CONF_mInt32(orc_natural_read_size_mb, "8");
 CONF_mInt64(big_column_size_buffer, "65535");
 CONF_mInt64(small_column_size_buffer, "100");
 
+// The uncompressed csv ranges of a file scan node larger than this value are split into ranges
+// of this size, which are read by several scanners in parallel. 0 disables the split.
+CONF_mInt32(csv_scan_range_split_size_mb, "0");
+
 // When the rows number reached this limit, will check the filter rate the of bloomfilter
 // if it is lower than a specific threshold, the predicate will be disabled.
 CONF_mInt32(bloom_filter_predicate_check_row_num, "204800");
@@ -886,7 +960,23 @@ CONF_Bool(enable_java_support, "true");
 CONF_Bool(enable_fuzzy_mode, "false");
 
 CONF_Int32(pipeline_executor_size, "0");
+// Use lock-free work-stealing run queues for the pipeline executors without task group.
+CONF_Bool(enable_pipeline_work_stealing, "false");
 CONF_mInt16(pipeline_short_query_timeout_s, "20");
+// The hard limit of the cpu used by the tasks of the default and the short task group, in percent
+// of the cpu of all pipeline executors, 0 means no limit. The cpu time of a task group is counted
+// in windows of pipeline_task_group_cpu_quota_window_ms, and its tasks are not scheduled for the
+// rest of the window once its quota is used up.
+CONF_Int32(pipeline_default_task_group_cpu_hard_limit, "0");
+CONF_Int32(pipeline_short_task_group_cpu_hard_limit, "0");
+CONF_mInt32(pipeline_task_group_cpu_quota_window_ms, "100");
+// The result of a finalizing hash aggregation whose table has been partitioned (see the session
+// variable partitioned_hash_agg_rows_threshold) is emitted by up to agg_result_parallelism tasks
+// of the AggResultThreadPool, each converting one sub table into blocks at a time. A finalizing
+// merge also merges its input into up to agg_result_parallelism groups of sub tables in
+// parallel. 1 disables both.
+CONF_Int32(agg_result_thread_pool_thread_num, "32");
+CONF_mInt32(agg_result_parallelism, "4");
 
 // Temp config. True to use optimization for bitmap_index apply predicate except leaf node of the and node.
 // Will remove after fully test.
@@ -20,10 +20,50 @@
 #include "runtime/large_int_value.h"
 #include "runtime/raw_value.h"
 #include "util/string_parser.hpp"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
 #include "vec/exprs/vexpr.h"
 
 namespace doris {
 
+namespace {
+
+// Above this number of bounds a binary search is cheaper than comparing with every bound.
+constexpr size_t LINEAR_SEARCH_MAX_BOUNDS = 32;
+
+// Sets positions[i] to the number of the sorted `bounds` that are not greater than keys[i],
+// i.e. the upper bound of keys[i].
+template <typename T>
+void upper_bounds(const T* __restrict bounds, size_t num_bounds, const T* __restrict keys,
+                  size_t num_keys, uint32_t* __restrict positions) {
+    if (num_bounds <= LINEAR_SEARCH_MAX_BOUNDS) {
+        // no branch in the inner loop, the compiler turns it into SIMD compares
+        for (size_t i = 0; i < num_keys; ++i) {
+            uint32_t count = 0;
+            for (size_t j = 0; j < num_bounds; ++j) {
+                count += bounds[j] <= keys[i];
+            }
+            positions[i] = count;
+        }
+        return;
+    }
+    // branchless binary search, the loads of a search do not depend on the mispredicted
+    // branches so the searches of the adjacent keys overlap
+    for (size_t i = 0; i < num_keys; ++i) {
+        const T* base = bounds;
+        size_t len = num_bounds;
+        while (len > 1) {
+            size_t half = len / 2;
+            base += (base[half - 1] <= keys[i]) ? half : 0;
+            len -= half;
+        }
+        positions[i] = base - bounds + (*base <= keys[i]);
+    }
+}
+
+} // namespace
+
 void OlapTableIndexSchema::to_protobuf(POlapTableIndexSchema* pindex) const {
     pindex->set_id(index_id);
     pindex->set_schema_hash(schema_hash);
@@ -293,11 +333,171 @@ Status VOlapTablePartitionParam::init() {
         }
     }
 
+    if (!_is_in_partition && _partition_slot_locs.size() == 1) {
+        _init_range_bounds();
+    }
+
     _mem_usage = _partition_block.allocated_bytes();
     _mem_tracker->consume(_mem_usage);
     return Status::OK();
 }
 
+void VOlapTablePartitionParam::_init_range_bounds() {
+    auto key_type = _slots[_partition_slot_locs[0]]->type().type;
+    switch (key_type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_DATEV2:
+    case TYPE_DATETIMEV2:
+        break;
+    default:
+        return;
+    }
+    const auto* key_column = _partition_block.get_by_position(_partition_slot_locs[0]).column.get();
+    if (key_column->is_nullable()) {
+        const auto& nullable_column = assert_cast<const vectorized::ColumnNullable&>(*key_column);
+        if (nullable_column.has_null()) {
+            return;
+        }
+        key_column = nullable_column.get_nested_column_ptr().get();
+    }
+    _range_start_keys = key_column->clone_empty();
+    _range_end_keys = key_column->clone_empty();
+    for (const auto& [end_key, partition] : *_partitions_map) {
+        _range_partitions.push_back(partition);
+        _range_has_start_key.push_back(partition->start_key.second != -1);
+        if (partition->start_key.second != -1) {
+            _range_start_keys->insert_from(*key_column, partition->start_key.second);
+        } else {
+            _range_start_keys->insert_default();
+        }
+        // the partition without end key is ordered last
+        if (end_key->second != -1) {
+            _range_end_keys->insert_from(*key_column, end_key->second);
+        }
+    }
+    _range_key_type = key_type;
+}
+
+template <typename T>
+bool VOlapTablePartitionParam::_find_range_partitions(
+        vectorized::Block* block, const uint8_t* skip,
+        std::vector<const VOlapTablePartition*>* partitions) const {
+    const auto* column = block->get_by_position(_partition_slot_locs[0]).column.get();
+    const uint8_t* null_map = nullptr;
+    if (const auto* nullable_column =
+                vectorized::check_and_get_column<vectorized::ColumnNullable>(*column)) {
+        null_map = nullable_column->get_null_map_data().data();
+        column = nullable_column->get_nested_column_ptr().get();
+    }
+    const auto* key_column = vectorized::check_and_get_column<vectorized::ColumnVector<T>>(*column);
+    if (key_column == nullptr) {
+        return false;
+    }
+    size_t rows = block->rows();
+    const T* keys = key_column->get_data().data();
+    const auto& start_keys =
+            assert_cast<const vectorized::ColumnVector<T>&>(*_range_start_keys).get_data();
+    const auto& end_keys =
+            assert_cast<const vectorized::ColumnVector<T>&>(*_range_end_keys).get_data();
+
+    std::vector<uint32_t> positions(rows);
+    upper_bounds(end_keys.data(), end_keys.size(), keys, rows, positions.data());
+    for (size_t i = 0; i < rows; ++i) {
+        if (skip != nullptr && skip[i]) {
+            continue;
+        }
+        if (null_map != nullptr && null_map[i]) {
+            // null is less than any key
+            BlockRow block_row {block, (int32_t)i};
+            find_partition(&block_row, &(*partitions)[i]);
+            continue;
+        }
+        uint32_t pos = positions[i];
+        if (pos < _range_partitions.size() &&
+            (!_range_has_start_key[pos] || keys[i] >= start_keys[pos])) {
+            (*partitions)[i] = _range_partitions[pos];
+        }
+    }
+    return true;
+}
+
+void VOlapTablePartitionParam::find_partitions(
+        vectorized::Block* block, const uint8_t* skip,
+        std::vector<const VOlapTablePartition*>* partitions) const {
+    size_t rows = block->rows();
+    partitions->assign(rows, nullptr);
+    bool found = false;
+    switch (_range_key_type) {
+    case TYPE_TINYINT:
+        found = _find_range_partitions<vectorized::Int8>(block, skip, partitions);
+        break;
+    case TYPE_SMALLINT:
+        found = _find_range_partitions<vectorized::Int16>(block, skip, partitions);
+        break;
+    case TYPE_INT:
+        found = _find_range_partitions<vectorized::Int32>(block, skip, partitions);
+        break;
+    case TYPE_BIGINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        found = _find_range_partitions<vectorized::Int64>(block, skip, partitions);
+        break;
+    case TYPE_LARGEINT:
+        found = _find_range_partitions<vectorized::Int128>(block, skip, partitions);
+        break;
+    case TYPE_DATEV2:
+        found = _find_range_partitions<vectorized::UInt32>(block, skip, partitions);
+        break;
+    case TYPE_DATETIMEV2:
+        found = _find_range_partitions<vectorized::UInt64>(block, skip, partitions);
+        break;
+    default:
+        break;
+    }
+    if (found) {
+        return;
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        if (skip != nullptr && skip[i]) {
+            continue;
+        }
+        BlockRow block_row {block, (int32_t)i};
+        find_partition(&block_row, &(*partitions)[i]);
+    }
+}
+
+void VOlapTablePartitionParam::find_tablets(
+        vectorized::Block* block, const std::vector<const VOlapTablePartition*>& partitions,
+        std::vector<uint32_t>* tablet_indexes) const {
+    size_t rows = partitions.size();
+    tablet_indexes->resize(rows);
+    if (_distributed_slot_locs.empty()) {
+        for (size_t i = 0; i < rows; ++i) {
+            if (partitions[i] != nullptr) {
+                (*tablet_indexes)[i] = butil::fast_rand() % partitions[i]->num_buckets;
+            }
+        }
+        return;
+    }
+    // the same crc32 as _compute_tablet_index, computed column by column
+    std::vector<uint64_t> hashes(rows, 0);
+    for (auto slot_loc : _distributed_slot_locs) {
+        block->get_by_position(slot_loc).column->update_crcs_with_value(
+                hashes, _slots[slot_loc]->type().type, nullptr);
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        if (partitions[i] != nullptr) {
+            (*tablet_indexes)[i] = hashes[i] % partitions[i]->num_buckets;
+        }
+    }
+}
+
 bool VOlapTablePartitionParam::find_partition(BlockRow* block_row,
                                               const VOlapTablePartition** partition) const {
     auto it = _is_in_partition ? _partitions_map->find(block_row)
@@ -156,6 +156,16 @@ public:
 
     uint32_t find_tablet(BlockRow* block_row, const VOlapTablePartition& partition) const;
 
+    // Batch version of find_partition() for all rows of `block`, partitions[i] is set to
+    // nullptr if the i-th row is in no partition or if skip[i] is set. `skip` may be nullptr.
+    void find_partitions(vectorized::Block* block, const uint8_t* skip,
+                         std::vector<const VOlapTablePartition*>* partitions) const;
+
+    // Batch version of find_tablet(), the rows whose partition is nullptr are skipped.
+    void find_tablets(vectorized::Block* block,
+                      const std::vector<const VOlapTablePartition*>& partitions,
+                      std::vector<uint32_t>* tablet_indexes) const;
+
     const std::vector<VOlapTablePartition*>& get_partitions() const { return _partitions; }
 
 private:
@@ -165,6 +175,15 @@ private:
 
     std::function<uint32_t(BlockRow*, int64_t)> _compute_tablet_index;
 
+    // Sets up the bounds used by _find_range_partitions(), which is only possible for tables
+    // range partitioned by a single integer or date column.
+    void _init_range_bounds();
+
+    // Returns false if the partition column of `block` is not a plain column of T.
+    template <typename T>
+    bool _find_range_partitions(vectorized::Block* block, const uint8_t* skip,
+                                std::vector<const VOlapTablePartition*>* partitions) const;
+
     // check if this partition contain this key
     bool _part_contains(VOlapTablePartition* part, BlockRow* key) const {
         // start_key.second == -1 means only single partition
@@ -188,6 +207,14 @@ private:
             _partitions_map;
 
     bool _is_in_partition = false;
+    // The range partitions ordered by their end keys, and the start and end keys of them in
+    // plain columns, the partition without end key (MAXVALUE) is the last one and has no end
+    // key in _range_end_keys. Only set up when _range_key_type is not INVALID_TYPE.
+    PrimitiveType _range_key_type = INVALID_TYPE;
+    std::vector<const VOlapTablePartition*> _range_partitions;
+    std::vector<uint8_t> _range_has_start_key;
+    vectorized::MutableColumnPtr _range_start_keys;
+    vectorized::MutableColumnPtr _range_end_keys;
     uint32_t _mem_usage = 0;
     // only works when using list partition, the resource is owned by _partitions
     VOlapTablePartition* _default_partition = nullptr;
@@ -26,6 +26,7 @@
 #include "exprs/hybrid_set.h"
 #include "exprs/minmax_predicate.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "pipeline/blocked_task_notifier.h"
 #include "runtime/define_primitive_type.h"
 #include "runtime/large_int_value.h"
 #include "runtime/primitive_type.h"
@@ -1201,6 +1202,7 @@ void IRuntimeFilter::signal() {
     DCHECK(is_consumer());
     if (_state->enable_pipeline_exec()) {
         _rf_state_atomic.store(RuntimeFilterState::READY);
+        pipeline::notify_blocked_tasks();
     } else {
         std::unique_lock lock(_inner_mutex);
         _rf_state = RuntimeFilterState::READY;
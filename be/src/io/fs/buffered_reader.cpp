@@ -23,7 +23,10 @@
 #include "common/config.h"
 #include "olap/iterators.h"
 #include "olap/olap_define.h"
+#include "runtime/thread_context.h"
 #include "util/bit_util.h"
+#include "util/stopwatch.hpp"
+#include "util/threadpool.h"
 
 namespace doris {
 namespace io {
@@ -88,5 +91,172 @@ Status BufferedFileStreamReader::read_bytes(Slice& slice, uint64_t offset) {
     return read_bytes((const uint8_t**)&slice.data, offset, slice.size);
 }
 
+std::atomic<int64_t> MergeRangeFileReader::_s_total_buffer_bytes = 0;
+
+MergeRangeFileReader::MergeRangeFileReader(FileReaderSPtr reader,
+                                           std::vector<PrefetchRange> ranges,
+                                           ThreadPool* thread_pool, size_t max_gap,
+                                           size_t max_buffer_bytes, int parallelism,
+                                           const IOContext* io_ctx)
+        : _reader(std::move(reader)),
+          _ranges(std::move(ranges)),
+          _thread_pool(thread_pool),
+          _max_gap(max_gap),
+          _max_buffer_bytes(max_buffer_bytes),
+          _parallelism(std::max(parallelism, 1)),
+          _io_ctx(io_ctx) {}
+
+MergeRangeFileReader::~MergeRangeFileReader() {
+    close();
+}
+
+Status MergeRangeFileReader::prefetch() {
+    std::sort(_ranges.begin(), _ranges.end(), [](const PrefetchRange& a, const PrefetchRange& b) {
+        return a.start_offset < b.start_offset;
+    });
+    _statistics.request_ranges = _ranges.size();
+    size_t buffer_bytes = 0;
+    for (auto& range : _ranges) {
+        size_t end_offset = std::min(range.end_offset, _reader->size());
+        if (range.start_offset >= end_offset) {
+            continue;
+        }
+        if (!_merged_ranges.empty() && range.start_offset <= _merged_ranges.back().end_offset) {
+            // overlapped
+            auto& last = _merged_ranges.back();
+            if (end_offset > last.end_offset) {
+                buffer_bytes += end_offset - last.end_offset;
+                last.end_offset = end_offset;
+            }
+        } else if (!_merged_ranges.empty() &&
+                   range.start_offset - _merged_ranges.back().end_offset <= _max_gap) {
+            auto& last = _merged_ranges.back();
+            buffer_bytes += end_offset - last.end_offset;
+            last.end_offset = end_offset;
+        } else {
+            auto& merged = _merged_ranges.emplace_back();
+            merged.start_offset = range.start_offset;
+            merged.end_offset = end_offset;
+            buffer_bytes += end_offset - range.start_offset;
+        }
+        if (buffer_bytes >= _max_buffer_bytes) {
+            // the rest of the ranges are read through
+            break;
+        }
+    }
+    _reserve_buffers();
+    _statistics.merged_ranges = _merged_ranges.size();
+    _statistics.merged_bytes = _reserved_bytes;
+
+    // the fetched buffers are released by the caller, so they are charged to its tracker, which
+    // is the tracker of the query on the scanner threads
+    auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+    std::lock_guard<std::mutex> l(_lock);
+    while (static_cast<size_t>(_running_tasks) <
+           std::min(static_cast<size_t>(_parallelism), _merged_ranges.size())) {
+        Status st = _thread_pool->submit_func([this, mem_tracker] { _fetch_task(mem_tracker); });
+        if (!st.ok()) {
+            if (_running_tasks == 0) {
+                // nothing will be fetched, read all the ranges through
+                _merged_ranges.clear();
+            }
+            return st;
+        }
+        ++_running_tasks;
+    }
+    return Status::OK();
+}
+
+void MergeRangeFileReader::_reserve_buffers() {
+    int64_t max_total_bytes = int64_t(config::merge_range_io_max_total_buffer_mb) << 20;
+    size_t num_ranges = 0;
+    for (; num_ranges < _merged_ranges.size(); ++num_ranges) {
+        auto& range = _merged_ranges[num_ranges];
+        int64_t bytes = range.end_offset - range.start_offset;
+        if (_s_total_buffer_bytes.fetch_add(bytes) + bytes > max_total_bytes) {
+            // the rest of the ranges are read through
+            _s_total_buffer_bytes.fetch_sub(bytes);
+            break;
+        }
+        _reserved_bytes += bytes;
+    }
+    _merged_ranges.erase(_merged_ranges.begin() + num_ranges, _merged_ranges.end());
+}
+
+void MergeRangeFileReader::_fetch_task(const std::shared_ptr<MemTrackerLimiter>& mem_tracker) {
+    SCOPED_ATTACH_TASK(mem_tracker);
+    std::unique_lock<std::mutex> l(_lock);
+    while (!_cancelled && _next_fetch_range < _merged_ranges.size()) {
+        MergedRange& range = _merged_ranges[_next_fetch_range++];
+        l.unlock();
+        size_t length = range.end_offset - range.start_offset;
+        std::unique_ptr<char[]> data(new char[length]);
+        size_t has_read = 0;
+        Status st;
+        while (st.ok() && has_read < length) {
+            size_t loop_read = 0;
+            st = _reader->read_at(range.start_offset + has_read,
+                                  Slice(data.get() + has_read, length - has_read), &loop_read,
+                                  _io_ctx);
+            if (st.ok() && loop_read == 0) {
+                st = Status::Corruption("Try to read {} bytes, but received {} bytes", length,
+                                        has_read);
+            }
+            has_read += loop_read;
+        }
+        l.lock();
+        range.data = std::move(data);
+        range.status = st;
+        range.fetched = true;
+        _cv.notify_all();
+    }
+    --_running_tasks;
+    _cv.notify_all();
+}
+
+void MergeRangeFileReader::_wait_for_fetch_tasks() {
+    std::unique_lock<std::mutex> l(_lock);
+    _cancelled = true;
+    _cv.wait(l, [this] { return _running_tasks == 0; });
+}
+
+Status MergeRangeFileReader::close() {
+    if (!_closed) {
+        _wait_for_fetch_tasks();
+        _merged_ranges.clear();
+        _s_total_buffer_bytes.fetch_sub(_reserved_bytes);
+        _reserved_bytes = 0;
+        _closed = true;
+    }
+    return Status::OK();
+}
+
+Status MergeRangeFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                                          const IOContext* io_ctx) {
+    if (_closed) {
+        return Status::IOError("Read from a closed MergeRangeFileReader: {}",
+                               _reader->path().native());
+    }
+    size_t end_offset = offset + result.size;
+    // the last merged range which starts at or before offset
+    auto iter = std::upper_bound(
+            _merged_ranges.begin(), _merged_ranges.end(), offset,
+            [](size_t value, const MergedRange& range) { return value < range.start_offset; });
+    if (iter == _merged_ranges.begin() || (--iter)->end_offset < end_offset) {
+        _statistics.read_through_bytes += result.size;
+        return _reader->read_at(offset, result, bytes_read, io_ctx);
+    }
+    MergedRange& range = *iter;
+    {
+        SCOPED_RAW_TIMER(&_statistics.wait_time);
+        std::unique_lock<std::mutex> l(_lock);
+        _cv.wait(l, [&] { return range.fetched; });
+    }
+    RETURN_IF_ERROR(range.status);
+    memcpy(result.data, range.data.get() + (offset - range.start_offset), result.size);
+    *bytes_read = result.size;
+    return Status::OK();
+}
+
 } // namespace io
 } // namespace doris
@@ -19,7 +19,11 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "common/status.h"
 #include "io/fs/file_reader.h"
@@ -27,8 +31,104 @@
 #include "util/runtime_profile.h"
 
 namespace doris {
+class MemTrackerLimiter;
+class ThreadPool;
+
 namespace io {
 
+struct PrefetchRange {
+    size_t start_offset;
+    size_t end_offset;
+
+    PrefetchRange(size_t start, size_t end) : start_offset(start), end_offset(end) {}
+};
+
+/**
+ * A FileReader over the planned ranges of another reader, such as the column chunks of a parquet
+ * row group or the streams of an orc stripe, to save the round trips of remote storage.
+ *
+ * The ranges whose gap is not larger than `max_gap` are coalesced into one request, and the
+ * requests are fetched into memory by at most `parallelism` tasks of `thread_pool` after
+ * prefetch(). Only the first `max_buffer_bytes` of the requests are fetched, and only while the
+ * buffers of all the readers stay under merge_range_io_max_total_buffer_mb. The reads inside
+ * the fetched requests wait for them and are served from memory, others go to the inner reader.
+ * The buffers are charged to the mem tracker of the thread calling prefetch().
+ */
+class MergeRangeFileReader : public FileReader {
+public:
+    struct Statistics {
+        int64_t request_ranges = 0;
+        int64_t merged_ranges = 0;
+        // the bytes fetched by the merged requests, including the gaps
+        int64_t merged_bytes = 0;
+        int64_t read_through_bytes = 0;
+        int64_t wait_time = 0;
+    };
+
+    MergeRangeFileReader(FileReaderSPtr reader, std::vector<PrefetchRange> ranges,
+                         ThreadPool* thread_pool, size_t max_gap, size_t max_buffer_bytes,
+                         int parallelism, const IOContext* io_ctx = nullptr);
+
+    ~MergeRangeFileReader() override;
+
+    // Coalesces the ranges and starts fetching them.
+    Status prefetch();
+
+    Status close() override;
+
+    const Path& path() const override { return _reader->path(); }
+
+    size_t size() const override { return _reader->size(); }
+
+    bool closed() const override { return _closed; }
+
+    std::shared_ptr<FileSystem> fs() const override { return _reader->fs(); }
+
+    const Statistics& statistics() const { return _statistics; }
+
+    // the bytes of the buffers of all the readers
+    static int64_t total_buffer_bytes() { return _s_total_buffer_bytes; }
+
+protected:
+    Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                        const IOContext* io_ctx) override;
+
+private:
+    struct MergedRange {
+        size_t start_offset;
+        size_t end_offset;
+        std::unique_ptr<char[]> data;
+        bool fetched = false;
+        Status status;
+    };
+
+    void _fetch_task(const std::shared_ptr<MemTrackerLimiter>& mem_tracker);
+    void _wait_for_fetch_tasks();
+    // Keeps the first merged ranges whose buffers fit in merge_range_io_max_total_buffer_mb.
+    void _reserve_buffers();
+
+    FileReaderSPtr _reader;
+    std::vector<PrefetchRange> _ranges;
+    ThreadPool* _thread_pool;
+    const size_t _max_gap;
+    const size_t _max_buffer_bytes;
+    const int _parallelism;
+    const IOContext* _io_ctx;
+
+    // sorted by offset and not overlapped
+    std::vector<MergedRange> _merged_ranges;
+    std::mutex _lock;
+    std::condition_variable _cv;
+    size_t _next_fetch_range = 0;
+    int _running_tasks = 0;
+    bool _cancelled = false;
+    bool _closed = false;
+    Statistics _statistics;
+    int64_t _reserved_bytes = 0;
+
+    static std::atomic<int64_t> _s_total_buffer_bytes;
+};
+
 /**
  * Load all the needed data in underlying buffer, so the caller does not need to prepare the data container.
  */
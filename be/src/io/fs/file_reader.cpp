@@ -39,5 +39,28 @@ Status FileReader::read_at(size_t offset, Slice result, size_t* bytes_read,
     return st;
 }
 
+Status FileReader::read_batch_at(std::vector<ReadRequest>* requests, const IOContext* io_ctx) {
+    Status st;
+    if (bthread_self() == 0) {
+        st = read_batch_at_impl(requests, io_ctx);
+    } else {
+        auto task = [&] { st = read_batch_at_impl(requests, io_ctx); };
+        AsyncIO::run_task(task, fs()->type());
+    }
+    if (!st) {
+        LOG(WARNING) << st;
+    }
+    return st;
+}
+
+Status FileReader::read_batch_at_impl(std::vector<ReadRequest>* requests,
+                                      const IOContext* io_ctx) {
+    for (auto& request : *requests) {
+        RETURN_IF_ERROR(
+                read_at_impl(request.offset, request.result, &request.bytes_read, io_ctx));
+    }
+    return Status::OK();
+}
+
 } // namespace io
 } // namespace doris
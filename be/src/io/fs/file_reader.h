@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/status.h"
 #include "gutil/macros.h"
 #include "io/fs/file_reader_writer_fwd.h"
@@ -30,6 +32,13 @@ namespace io {
 class FileSystem;
 class IOContext;
 
+// One range of a batched read, see `FileReader::read_batch_at()`.
+struct ReadRequest {
+    size_t offset = 0;
+    Slice result;
+    size_t bytes_read = 0;
+};
+
 class FileReader {
 public:
     FileReader() = default;
@@ -42,6 +51,11 @@ public:
     Status read_at(size_t offset, Slice result, size_t* bytes_read,
                    const IOContext* io_ctx = nullptr);
 
+    /// Reads several ranges at once. Readers which could issue the ranges together
+    /// (e.g. LocalFileReader with io_uring) override read_batch_at_impl(), others
+    /// read the ranges one by one.
+    Status read_batch_at(std::vector<ReadRequest>* requests, const IOContext* io_ctx = nullptr);
+
     virtual Status close() = 0;
 
     virtual const Path& path() const = 0;
@@ -55,6 +69,9 @@ public:
 protected:
     virtual Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
                                 const IOContext* io_ctx) = 0;
+
+    virtual Status read_batch_at_impl(std::vector<ReadRequest>* requests,
+                                      const IOContext* io_ctx);
 };
 
 } // namespace io
@@ -0,0 +1,246 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/io_uring.h"
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "common/config.h"
+#include "common/logging.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define DORIS_WITH_IO_URING
+#endif
+
+namespace doris {
+namespace io {
+
+#ifdef DORIS_WITH_IO_URING
+
+IOUring* IOUring::get_thread_local() {
+    // nullptr after a failed setup, so that it is not retried on every read
+    thread_local std::unique_ptr<IOUring> ring;
+    thread_local bool inited = false;
+    if (!inited) {
+        inited = true;
+        std::unique_ptr<IOUring> new_ring(new IOUring());
+        auto st = new_ring->_init(config::io_uring_queue_depth);
+        if (st.ok()) {
+            ring = std::move(new_ring);
+        } else {
+            LOG_FIRST_N(WARNING, 1) << "io_uring is not available, fall back to pread: " << st;
+        }
+    }
+    return ring.get();
+}
+
+Status IOUring::_init(unsigned entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    _ring_fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (_ring_fd < 0) {
+        return Status::IOError("io_uring_setup failed: {}", std::strerror(errno));
+    }
+    _sq_entries = params.sq_entries;
+
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+    }
+    _sq_ring = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    _ring_fd, IORING_OFF_SQ_RING);
+    if (_sq_ring == MAP_FAILED) {
+        _sq_ring = nullptr;
+        return Status::IOError("failed to mmap io_uring sq ring: {}", std::strerror(errno));
+    }
+    if (single_mmap) {
+        _cq_ring = _sq_ring;
+    } else {
+        _cq_ring = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        _ring_fd, IORING_OFF_CQ_RING);
+        if (_cq_ring == MAP_FAILED) {
+            _cq_ring = nullptr;
+            return Status::IOError("failed to mmap io_uring cq ring: {}", std::strerror(errno));
+        }
+    }
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    _sqes = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                 IORING_OFF_SQES);
+    if (_sqes == MAP_FAILED) {
+        _sqes = nullptr;
+        return Status::IOError("failed to mmap io_uring sqes: {}", std::strerror(errno));
+    }
+
+    auto* sq = static_cast<char*>(_sq_ring);
+    _sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    _sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    auto* cq = static_cast<char*>(_cq_ring);
+    _cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    _cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    _cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    _cqes = cq + params.cq_off.cqes;
+
+    _iovecs.resize(_sq_entries);
+    return Status::OK();
+}
+
+IOUring::~IOUring() {
+    if (_sqes != nullptr) {
+        munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ring != nullptr && _cq_ring != _sq_ring) {
+        munmap(_cq_ring, _cq_ring_size);
+    }
+    if (_sq_ring != nullptr) {
+        munmap(_sq_ring, _sq_ring_size);
+    }
+    if (_ring_fd >= 0) {
+        close(_ring_fd);
+    }
+}
+
+Status IOUring::_submit_and_wait(unsigned to_submit, unsigned to_complete, unsigned* submitted) {
+    *submitted = 0;
+    while (true) {
+        int ret = syscall(__NR_io_uring_enter, _ring_fd, to_submit, to_complete,
+                          IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (ret >= 0) {
+            unsigned consumed = std::min<unsigned>(ret, to_submit);
+            *submitted += consumed;
+            to_submit -= consumed;
+            if (to_submit == 0) {
+                return Status::OK();
+            }
+            // the kernel took only part of the queue, the rest is submitted again
+            to_complete = 0;
+            continue;
+        }
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            return Status::IOError("io_uring_enter failed: {}", std::strerror(errno));
+        }
+    }
+}
+
+// The reads in flight write into the buffers of the caller and into `_iovecs`, so
+// this only returns once all `count` completions have been reaped, even if waiting
+// for them fails. Completions of local file reads arrive without io_uring_enter,
+// they are polled then.
+void IOUring::_reap_completions(unsigned count, std::vector<ReadRequest>* requests,
+                                Status* status) {
+    auto* cqes = static_cast<io_uring_cqe*>(_cqes);
+    unsigned completed = 0;
+    while (completed < count) {
+        unsigned head = *_cq_head;
+        unsigned cq_tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        if (head == cq_tail) {
+            unsigned submitted = 0;
+            auto st = _submit_and_wait(0, count - completed, &submitted);
+            if (!st.ok()) {
+                if (status->ok()) {
+                    *status = st;
+                }
+                sched_yield();
+            }
+            continue;
+        }
+        for (; head != cq_tail; ++head, ++completed) {
+            io_uring_cqe* cqe = &cqes[head & *_cq_mask];
+            auto& request = (*requests)[cqe->user_data];
+            if (cqe->res < 0) {
+                if (status->ok()) {
+                    *status = Status::IOError("io_uring read failed: {}",
+                                              std::strerror(-cqe->res));
+                }
+            } else {
+                request.bytes_read = cqe->res;
+            }
+        }
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+    }
+}
+
+Status IOUring::read_batch(int fd, std::vector<ReadRequest>* requests) {
+    auto* sqes = static_cast<io_uring_sqe*>(_sqes);
+    Status status;
+
+    for (size_t begin = 0; begin < requests->size(); begin += _sq_entries) {
+        unsigned batch_size = std::min<size_t>(_sq_entries, requests->size() - begin);
+
+        // only this thread produces submissions, the tail could be read without a barrier
+        unsigned tail = *_sq_tail;
+        for (unsigned i = 0; i < batch_size; ++i) {
+            auto& request = (*requests)[begin + i];
+            _iovecs[i].iov_base = request.result.data;
+            _iovecs[i].iov_len = request.result.size;
+
+            unsigned index = tail & *_sq_mask;
+            io_uring_sqe* sqe = &sqes[index];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = fd;
+            sqe->off = request.offset;
+            sqe->addr = reinterpret_cast<uint64_t>(&_iovecs[i]);
+            sqe->len = 1;
+            sqe->user_data = begin + i;
+            _sq_array[index] = index;
+            ++tail;
+        }
+        __atomic_store_n(_sq_tail, tail, __ATOMIC_RELEASE);
+        unsigned submitted = 0;
+        auto submit_status = _submit_and_wait(batch_size, batch_size, &submitted);
+        if (submitted < batch_size) {
+            // Take back the entries the kernel has not consumed, so that they are not
+            // submitted by the next call with the iovecs of this batch. The kernel only
+            // consumes entries in io_uring_enter, as the ring is set up without SQPOLL.
+            __atomic_store_n(_sq_tail, tail - (batch_size - submitted), __ATOMIC_RELEASE);
+        }
+
+        // reap all the completions of this batch, the iovecs are reused by the next one
+        _reap_completions(submitted, requests, &status);
+        RETURN_IF_ERROR(submit_status);
+        RETURN_IF_ERROR(status);
+    }
+    return Status::OK();
+}
+
+#else
+
+IOUring* IOUring::get_thread_local() {
+    return nullptr;
+}
+
+IOUring::~IOUring() = default;
+
+Status IOUring::read_batch(int fd, std::vector<ReadRequest>* requests) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+#endif
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include <vector>
+
+#include "common/status.h"
+#include "gutil/macros.h"
+#include "io/fs/file_reader.h"
+
+namespace doris {
+namespace io {
+
+// A minimal io_uring, only used to read local files.
+//
+// It talks to the kernel through the raw system calls, so that no extra
+// library is needed. A ring must not be shared by threads, use
+// `IOUring::get_thread_local()` to get the ring of the current thread.
+class IOUring {
+public:
+    ~IOUring();
+
+    DISALLOW_COPY_AND_ASSIGN(IOUring);
+
+    // Returns nullptr if io_uring is not supported by the kernel or the build.
+    static IOUring* get_thread_local();
+
+    // Reads all the `requests` from `fd` in batches of at most `depth()` reads.
+    // `bytes_read` of a request may be less than its size after a short read,
+    // callers should read the rest by themselves.
+    Status read_batch(int fd, std::vector<ReadRequest>* requests);
+
+    unsigned depth() const { return _sq_entries; }
+
+private:
+    IOUring() = default;
+
+    Status _init(unsigned entries);
+
+    // `submitted` is the number of entries consumed by the kernel, also on failure.
+    Status _submit_and_wait(unsigned to_submit, unsigned to_complete, unsigned* submitted);
+
+    void _reap_completions(unsigned count, std::vector<ReadRequest>* requests, Status* status);
+
+    int _ring_fd = -1;
+    unsigned _sq_entries = 0;
+
+    void* _sq_ring = nullptr;
+    size_t _sq_ring_size = 0;
+    void* _cq_ring = nullptr;
+    size_t _cq_ring_size = 0;
+    void* _sqes = nullptr;
+    size_t _sqes_size = 0;
+
+    unsigned* _sq_tail = nullptr;
+    unsigned* _sq_mask = nullptr;
+    unsigned* _sq_array = nullptr;
+    unsigned* _cq_head = nullptr;
+    unsigned* _cq_tail = nullptr;
+    unsigned* _cq_mask = nullptr;
+    void* _cqes = nullptr;
+
+    std::vector<iovec> _iovecs;
+};
+
+} // namespace io
+} // namespace doris
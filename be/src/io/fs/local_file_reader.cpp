@@ -19,7 +19,9 @@
 
 #include <atomic>
 
+#include "common/config.h"
 #include "io/fs/err_utils.h"
+#include "io/fs/io_uring.h"
 #include "util/async_io.h"
 #include "util/doris_metrics.h"
 
@@ -66,10 +68,46 @@ Status LocalFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_
                                offset, _file_size, _path.native());
     }
     size_t bytes_req = result.size;
-    char* to = result.data;
     bytes_req = std::min(bytes_req, _file_size - offset);
     *bytes_read = 0;
+    RETURN_IF_ERROR(_pread(offset, result.data, bytes_req, bytes_read));
+    DorisMetrics::instance()->local_bytes_read_total->increment(*bytes_read);
+    return Status::OK();
+}
+
+Status LocalFileReader::read_batch_at_impl(std::vector<ReadRequest>* requests,
+                                           const IOContext* /*io_ctx*/) {
+    DCHECK(!closed());
+    for (auto& request : *requests) {
+        if (request.offset > _file_size) {
+            return Status::IOError(
+                    "offset exceeds file size(offset: {}, file size: {}, path: {})",
+                    request.offset, _file_size, _path.native());
+        }
+        request.result.size = std::min(request.result.size, _file_size - request.offset);
+        request.bytes_read = 0;
+    }
 
+    IOUring* ring = config::enable_io_uring ? IOUring::get_thread_local() : nullptr;
+    if (ring != nullptr) {
+        RETURN_IF_ERROR(ring->read_batch(_fd, requests));
+    }
+
+    // pread the whole range without io_uring, and the rest of a short read with it
+    size_t total_read = 0;
+    for (auto& request : *requests) {
+        size_t done = request.bytes_read;
+        if (done < request.result.size) {
+            RETURN_IF_ERROR(_pread(request.offset + done, request.result.data + done,
+                                   request.result.size - done, &request.bytes_read));
+        }
+        total_read += request.bytes_read;
+    }
+    DorisMetrics::instance()->local_bytes_read_total->increment(total_read);
+    return Status::OK();
+}
+
+Status LocalFileReader::_pread(size_t offset, char* to, size_t bytes_req, size_t* bytes_read) {
     while (bytes_req != 0) {
         auto res = ::pread(_fd, to, bytes_req, offset);
         if (UNLIKELY(-1 == res && errno != EINTR)) {
@@ -85,7 +123,6 @@ Status LocalFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_
             *bytes_read += res;
         }
     }
-    DorisMetrics::instance()->local_bytes_read_total->increment(*bytes_read);
     return Status::OK();
 }
 
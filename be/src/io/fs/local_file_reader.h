@@ -46,6 +46,12 @@ private:
     Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
                         const IOContext* io_ctx) override;
 
+    Status read_batch_at_impl(std::vector<ReadRequest>* requests,
+                              const IOContext* io_ctx) override;
+
+    // Reads [offset, offset + bytes_req) with pread, adds the read bytes to `bytes_read`.
+    Status _pread(size_t offset, char* to, size_t bytes_req, size_t* bytes_read);
+
 private:
     int _fd = -1; // owned
     Path _path;
@@ -96,6 +96,21 @@ bool Compaction::should_vertical_compaction() {
     return true;
 }
 
+void Compaction::split_key_ranges(std::vector<Merger::KeyRange>* key_ranges) {
+    // the rowsets of cold data compaction are not written to local disk
+    if (compaction_type() == ReaderType::READER_COLD_DATA_COMPACTION) {
+        return;
+    }
+    int64_t num_ranges = config::compaction_key_range_parallelism;
+    if (config::compaction_key_range_min_rows > 0) {
+        num_ranges = std::min(num_ranges, _input_row_num / config::compaction_key_range_min_rows);
+    }
+    if (num_ranges <= 1) {
+        return;
+    }
+    Merger::split_key_ranges(_cur_tablet_schema, _input_rowsets, num_ranges, key_ranges);
+}
+
 int64_t Compaction::get_avg_segment_rows() {
     // take care of empty rowset
     // input_rowsets_size is total disk_size of input_rowset, this size is the
@@ -267,8 +282,11 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     LOG(INFO) << "start " << compaction_name() << ". tablet=" << _tablet->full_name()
               << ", output_version=" << _output_version << ", permits: " << permits;
     bool vertical_compaction = should_vertical_compaction();
+    std::vector<Merger::KeyRange> key_ranges;
+    split_key_ranges(&key_ranges);
     RETURN_NOT_OK(construct_input_rowset_readers());
-    RETURN_NOT_OK(construct_output_rowset_writer(vertical_compaction));
+    // the output rowset of key ranges only links the segments of the range rowsets
+    RETURN_NOT_OK(construct_output_rowset_writer(vertical_compaction && key_ranges.empty()));
     if (compaction_type() == ReaderType::READER_COLD_DATA_COMPACTION) {
         Tablet::add_pending_remote_rowset(_output_rs_writer->rowset_id().to_string());
     }
@@ -283,7 +301,16 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     }
 
     Status res;
-    if (vertical_compaction) {
+    if (!key_ranges.empty()) {
+        res = Merger::parallel_merge_rowsets(
+                _tablet, compaction_type(), _cur_tablet_schema, _input_rs_readers, key_ranges,
+                vertical_compaction, get_avg_segment_rows(),
+                StorageEngine::instance()->compaction_key_range_thread_pool(),
+                [&](std::unique_ptr<RowsetWriter>* rowset_writer) {
+                    return construct_key_range_rowset_writer(vertical_compaction, rowset_writer);
+                },
+                _output_rs_writer.get(), &stats);
+    } else if (vertical_compaction) {
         res = Merger::vertical_merge_rowsets(_tablet, compaction_type(), _cur_tablet_schema,
                                              _input_rs_readers, _output_rs_writer.get(),
                                              get_avg_segment_rows(), &stats);
@@ -345,6 +372,7 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     auto cumu_policy = _tablet->cumulative_compaction_policy();
     DCHECK(cumu_policy);
     LOG(INFO) << "succeed to do " << compaction_name() << " is_vertical=" << vertical_compaction
+              << ", key_ranges=" << key_ranges.size()
               << ". tablet=" << _tablet->full_name() << ", output_version=" << _output_version
               << ", current_max_version=" << current_max_version
               << ", disk=" << _tablet->data_dir()->path() << ", segments=" << _input_num_segments
@@ -386,6 +414,20 @@ Status Compaction::construct_output_rowset_writer(bool is_vertical) {
     return _tablet->create_rowset_writer(ctx, &_output_rs_writer);
 }
 
+Status Compaction::construct_key_range_rowset_writer(
+        bool is_vertical, std::unique_ptr<RowsetWriter>* rowset_writer) {
+    RowsetWriterContext ctx;
+    ctx.version = _output_version;
+    ctx.rowset_state = VISIBLE;
+    ctx.segments_overlap = NONOVERLAPPING;
+    ctx.tablet_schema = _cur_tablet_schema;
+    ctx.newest_write_timestamp = _newest_write_timestamp;
+    if (is_vertical) {
+        return _tablet->create_vertical_rowset_writer(ctx, rowset_writer);
+    }
+    return _tablet->create_rowset_writer(ctx, rowset_writer);
+}
+
 Status Compaction::construct_input_rowset_readers() {
     for (auto& rowset : _input_rowsets) {
         RowsetReaderSharedPtr rs_reader;
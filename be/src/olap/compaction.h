@@ -79,6 +79,11 @@ protected:
     bool should_vertical_compaction();
     int64_t get_avg_segment_rows();
 
+    // key ranges of the input rowsets to merge in parallel, empty if not to split
+    void split_key_ranges(std::vector<Merger::KeyRange>* key_ranges);
+    Status construct_key_range_rowset_writer(bool is_vertical,
+                                             std::unique_ptr<RowsetWriter>* rowset_writer);
+
     bool handle_ordered_data_compaction();
     Status do_compact_ordered_rowsets();
     bool is_rowset_tidy(std::string& pre_max_key, const RowsetSharedPtr& rhs);
@@ -84,6 +84,9 @@ public:
     std::vector<ColumnPredicate*> column_predicates_except_leafnode_of_andnode;
     std::unordered_map<int32_t, std::shared_ptr<AndBlockColumnPredicate>> col_id_to_predicates;
     std::unordered_map<int32_t, std::vector<const ColumnPredicate*>> del_predicates_for_zone_map;
+    // predicates of the runtime filters arrived after the scan started, they only prune the
+    // unread pages by zone map and bloom filter
+    const std::vector<ColumnPredicate*>* late_runtime_filter_predicates = nullptr;
     TPushAggOp::type push_down_agg_type_opt = TPushAggOp::NONE;
 
     // REQUIRED (null is not allowed)
@@ -103,6 +106,8 @@ public:
     vectorized::VExpr* remaining_vconjunct_root = nullptr;
     vectorized::VExprContext* common_vexpr_ctxs_pushdown = nullptr;
     const std::set<int32_t>* output_columns = nullptr;
+    // string columns which may be returned as dictionary codes, see ColumnDictCodes
+    const std::set<ColumnId>* dict_code_columns = nullptr;
     // runtime state
     RuntimeState* runtime_state = nullptr;
     RowsetId rowset_id;
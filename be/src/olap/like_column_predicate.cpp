@@ -52,16 +52,12 @@ uint16_t LikeColumnPredicate::evaluate(const vectorized::IColumn& column, uint16
             auto* nested_col_ptr = vectorized::check_and_get_column<
                     vectorized::ColumnDictionary<vectorized::Int32>>(nested_col);
             auto& data_array = nested_col_ptr->get_data();
+            auto& dict_res = _find_res_in_dictionary(*nested_col_ptr);
             if (!nullable_col->has_null()) {
                 for (uint16_t i = 0; i != size; i++) {
                     uint16_t idx = sel[i];
                     sel[new_size] = idx;
-                    StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[idx]);
-                    unsigned char flag = 0;
-                    (_state->scalar_function)(
-                            const_cast<vectorized::LikeSearchState*>(&_like_state),
-                            StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                    new_size += _opposite ^ flag;
+                    new_size += _opposite ^ dict_res[data_array[idx]];
                 }
             } else {
                 for (uint16_t i = 0; i != size; i++) {
@@ -71,13 +67,7 @@ uint16_t LikeColumnPredicate::evaluate(const vectorized::IColumn& column, uint16
                         new_size += _opposite;
                         continue;
                     }
-
-                    StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[idx]);
-                    unsigned char flag = 0;
-                    (_state->scalar_function)(
-                            const_cast<vectorized::LikeSearchState*>(&_like_state),
-                            StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                    new_size += _opposite ^ flag;
+                    new_size += _opposite ^ dict_res[data_array[idx]];
                 }
             }
         } else {
@@ -117,15 +107,11 @@ uint16_t LikeColumnPredicate::evaluate(const vectorized::IColumn& column, uint16
             auto* nested_col_ptr = vectorized::check_and_get_column<
                     vectorized::ColumnDictionary<vectorized::Int32>>(column);
             auto& data_array = nested_col_ptr->get_data();
+            auto& dict_res = _find_res_in_dictionary(*nested_col_ptr);
             for (uint16_t i = 0; i != size; i++) {
                 uint16_t idx = sel[i];
                 sel[new_size] = idx;
-                StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[idx]);
-                unsigned char flag = 0;
-                (_state->scalar_function)(const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                          StringRef(cell_value.data, cell_value.size), pattern,
-                                          &flag);
-                new_size += _opposite ^ flag;
+                new_size += _opposite ^ dict_res[data_array[idx]];
             }
         } else {
             auto* str_col =
@@ -145,4 +131,22 @@ uint16_t LikeColumnPredicate::evaluate(const vectorized::IColumn& column, uint16
     return new_size;
 }
 
+const std::vector<vectorized::UInt8>& LikeColumnPredicate::_find_res_in_dictionary(
+        const vectorized::ColumnDictionary<vectorized::Int32>& column) const {
+    auto& res = _segment_id_to_cached_res_flags[column.get_rowset_segment_id()];
+    if (res.empty()) {
+        size_t dict_size = column.dict_size();
+        res.resize(dict_size);
+        for (size_t code = 0; code < dict_size; ++code) {
+            StringRef cell_value = column.get_shrink_value(code);
+            unsigned char flag = 0;
+            (_state->scalar_function)(const_cast<vectorized::LikeSearchState*>(&_like_state),
+                                      StringRef(cell_value.data, cell_value.size), pattern, &flag);
+            res[code] = flag;
+        }
+    }
+    DCHECK_EQ(res.size(), column.dict_size());
+    return res;
+}
+
 } //namespace doris
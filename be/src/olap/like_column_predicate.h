@@ -73,6 +73,7 @@ private:
                 auto* nested_col_ptr = vectorized::check_and_get_column<
                         vectorized::ColumnDictionary<vectorized::Int32>>(nested_col);
                 auto& data_array = nested_col_ptr->get_data();
+                auto& dict_res = _find_res_in_dictionary(*nested_col_ptr);
                 for (uint16_t i = 0; i < size; i++) {
                     if (null_map_data[i]) {
                         if constexpr (is_and) {
@@ -82,20 +83,10 @@ private:
                         }
                         continue;
                     }
-
-                    StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[i]);
                     if constexpr (is_and) {
-                        unsigned char flag = 0;
-                        (_state->scalar_function)(
-                                const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                        flags[i] &= _opposite ^ flag;
+                        flags[i] &= _opposite ^ dict_res[data_array[i]];
                     } else {
-                        unsigned char flag = 0;
-                        (_state->scalar_function)(
-                                const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                        flags[i] = _opposite ^ flag;
+                        flags[i] = _opposite ^ dict_res[data_array[i]];
                     }
                 }
             } else {
@@ -106,20 +97,12 @@ private:
                 auto* nested_col_ptr = vectorized::check_and_get_column<
                         vectorized::ColumnDictionary<vectorized::Int32>>(column);
                 auto& data_array = nested_col_ptr->get_data();
+                auto& dict_res = _find_res_in_dictionary(*nested_col_ptr);
                 for (uint16_t i = 0; i < size; i++) {
-                    StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[i]);
                     if constexpr (is_and) {
-                        unsigned char flag = 0;
-                        (_state->scalar_function)(
-                                const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                        flags[i] &= _opposite ^ flag;
+                        flags[i] &= _opposite ^ dict_res[data_array[i]];
                     } else {
-                        unsigned char flag = 0;
-                        (_state->scalar_function)(
-                                const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                        flags[i] = _opposite ^ flag;
+                        flags[i] = _opposite ^ dict_res[data_array[i]];
                     }
                 }
             } else {
@@ -128,6 +111,11 @@ private:
         }
     }
 
+    // Matches the pattern against every word in the dictionary of the segment only
+    // once, the rows are evaluated by looking up their codes in the result.
+    const std::vector<vectorized::UInt8>& _find_res_in_dictionary(
+            const vectorized::ColumnDictionary<vectorized::Int32>& column) const;
+
     std::string _debug_string() const override {
         std::string info = "LikeColumnPredicate";
         return info;
@@ -144,6 +132,8 @@ private:
     // Hyperscan API. So here _like_state is separate for each instance of
     // LikeColumnPredicate.
     vectorized::LikeSearchState _like_state;
+    mutable std::map<std::pair<RowsetId, uint32_t>, std::vector<vectorized::UInt8>>
+            _segment_id_to_cached_res_flags;
     std::unique_ptr<segment_v2::BloomFilter> _page_ng_bf; // for ngram-bf index
 };
 
@@ -16,7 +16,9 @@
 #include "olap/olap_define.h"
 #include "olap/utils.h"
 #include "runtime/thread_context.h"
+#include "util/bit_util.h"
 #include "util/doris_metrics.h"
+#include "util/string_util.h"
 
 using std::string;
 using std::stringstream;
@@ -29,6 +31,27 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(cache_usage_ratio, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(cache_lookup_count, MetricUnit::OPERATIONS);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(cache_hit_count, MetricUnit::OPERATIONS);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(cache_hit_ratio, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(cache_admission_reject_count, MetricUnit::OPERATIONS);
+
+CacheAdmissionPolicy parse_cache_admission_policy(const std::string& policy) {
+    if (iequal(policy, "TinyLFU")) {
+        return CacheAdmissionPolicy::TINY_LFU;
+    }
+    if (!iequal(policy, "LRU")) {
+        LOG(WARNING) << "unknown cache admission policy " << policy << ", use LRU";
+    }
+    return CacheAdmissionPolicy::LRU;
+}
+
+const char* cache_admission_policy_name(CacheAdmissionPolicy policy) {
+    switch (policy) {
+    case CacheAdmissionPolicy::TINY_LFU:
+        return "TinyLFU";
+    case CacheAdmissionPolicy::LRU:
+    default:
+        return "LRU";
+    }
+}
 
 uint32_t CacheKey::hash(const char* data, size_t n, uint32_t seed) const {
     // Similar to murmur hash
@@ -167,6 +190,55 @@ uint32_t HandleTable::element_count() const {
     return _elems;
 }
 
+FrequencySketch::FrequencySketch(size_t width) {
+    width = static_cast<size_t>(BitUtil::RoundUpToPowerOfTwo(std::max<size_t>(width, 64)));
+    // 4 counters per entry, 16 counters per word
+    _table.resize(width / 4);
+    _counter_mask = width * 4 - 1;
+    _sample_size = width * 10;
+}
+
+size_t FrequencySketch::_index_of(uint32_t hash, int row) const {
+    static constexpr uint64_t kSeeds[kDepth] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+                                                0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+    uint64_t h = (hash + kSeeds[row]) * kSeeds[row];
+    h += h >> 32;
+    return h & _counter_mask;
+}
+
+void FrequencySketch::increment(uint32_t hash) {
+    bool added = false;
+    for (int i = 0; i < kDepth; ++i) {
+        size_t index = _index_of(hash, i);
+        uint64_t& word = _table[index >> 4];
+        int offset = (index & 15) << 2;
+        if (((word >> offset) & 0xfULL) != 0xfULL) {
+            word += 1ULL << offset;
+            added = true;
+        }
+    }
+    if (added && ++_size >= _sample_size) {
+        _reset();
+    }
+}
+
+uint32_t FrequencySketch::frequency(uint32_t hash) const {
+    uint32_t freq = 0xf;
+    for (int i = 0; i < kDepth; ++i) {
+        size_t index = _index_of(hash, i);
+        int offset = (index & 15) << 2;
+        freq = std::min<uint32_t>(freq, (_table[index >> 4] >> offset) & 0xfULL);
+    }
+    return freq;
+}
+
+void FrequencySketch::_reset() {
+    for (auto& word : _table) {
+        word = (word >> 1) & 0x7777777777777777ULL;
+    }
+    _size /= 2;
+}
+
 LRUCache::LRUCache(LRUCacheType type) : _type(type) {
     // Make empty circular linked list
     _lru_normal.next = &_lru_normal;
@@ -236,6 +308,9 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
     std::lock_guard l(_mutex);
     ++_lookup_count;
+    if (_sketch != nullptr) {
+        _sketch->increment(hash);
+    }
     LRUHandle* e = _table.lookup(key, hash);
     if (e != nullptr) {
         // we get it from _table, so in_cache must be true
@@ -250,6 +325,20 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
     return reinterpret_cast<Cache::Handle*>(e);
 }
 
+void LRUCache::set_admission_policy(CacheAdmissionPolicy policy) {
+    if (policy != CacheAdmissionPolicy::TINY_LFU) {
+        _sketch.reset();
+        return;
+    }
+    // the sketch should hold about as many keys as the cache,
+    // entries of a SIZE cache are assumed to be 4KB on average
+    size_t entries = _type == LRUCacheType::NUMBER ? _capacity : _capacity / 4096;
+    if (_element_count_capacity != 0) {
+        entries = std::min<size_t>(entries, _element_count_capacity);
+    }
+    _sketch = std::make_unique<FrequencySketch>(std::min<size_t>(entries, 1 << 20));
+}
+
 void LRUCache::release(Cache::Handle* handle) {
     if (handle == nullptr) {
         return;
@@ -350,6 +439,40 @@ bool LRUCache::_check_element_count_limit() {
     return _element_count_capacity != 0 && _table.element_count() >= _element_count_capacity;
 }
 
+// TinyLFU: when the cache is full, the new entry is admitted only if it is accessed
+// more frequently than the first entry to evict. Entries which are seldom accessed
+// but keep coming, such as the pages of a big scan, are rejected so that the hot
+// entries stay in the cache.
+bool LRUCache::_admit(const LRUHandle* e) {
+    if (_sketch == nullptr || e->priority == CachePriority::DURABLE) {
+        return true;
+    }
+    _sketch->increment(e->hash);
+    if (_usage + e->total_size <= _capacity && !_check_element_count_limit()) {
+        return true;
+    }
+    const LRUHandle* victim = _lru_normal.next;
+    if (victim == &_lru_normal) {
+        // only durable or referenced entries, nothing to compare with
+        return true;
+    }
+    if (_table.lookup(e->key(), e->hash) != nullptr) {
+        // replace the old value of the same key
+        return true;
+    }
+    uint32_t candidate_freq = _sketch->frequency(e->hash);
+    uint32_t victim_freq = _sketch->frequency(victim->hash);
+    if (candidate_freq > victim_freq) {
+        return true;
+    }
+    // admit a warm entry once in a while, otherwise a hot victim whose counter
+    // collides with others could never be replaced
+    if (candidate_freq > 5 && (++_warm_admission_count & 127) == 0) {
+        return true;
+    }
+    return false;
+}
+
 Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
                                 void (*deleter)(const CacheKey& key, void* value),
                                 MemTrackerLimiter* tracker, CachePriority priority, size_t bytes) {
@@ -377,6 +500,15 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     {
         std::lock_guard l(_mutex);
 
+        if (!_admit(e)) {
+            // not cached, the entry is freed when the returned handle is released
+            e->in_cache = false;
+            e->refs = 1;
+            _usage += e->total_size;
+            ++_admission_reject_count;
+            return reinterpret_cast<Cache::Handle*>(e);
+        }
+
         // Free the space following strict LRU policy until enough space
         // is freed or the lru list is empty
         if (_cache_value_check_timestamp) {
@@ -518,7 +650,8 @@ inline uint32_t ShardedLRUCache::_hash_slice(const CacheKey& s) {
 }
 
 ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
-                                 uint32_t num_shards, uint32_t total_element_count_capacity)
+                                 uint32_t num_shards, uint32_t total_element_count_capacity,
+                                 CacheAdmissionPolicy policy)
         : _name(name),
           _num_shard_bits(Bits::FindLSBSetNonZero(num_shards)),
           _num_shards(num_shards),
@@ -538,11 +671,13 @@ ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity,
         shards[s] = new LRUCache(type);
         shards[s]->set_capacity(per_shard);
         shards[s]->set_element_count_capacity(per_shard_element_count_capacity);
+        shards[s]->set_admission_policy(policy);
     }
     _shards = shards;
 
     _entity = DorisMetrics::instance()->metric_registry()->register_entity(
-            std::string("lru_cache:") + name, {{"name", name}});
+            std::string("lru_cache:") + name,
+            {{"name", name}, {"policy", cache_admission_policy_name(policy)}});
     _entity->register_hook(name, std::bind(&ShardedLRUCache::update_cache_metrics, this));
     INT_GAUGE_METRIC_REGISTER(_entity, cache_capacity);
     INT_GAUGE_METRIC_REGISTER(_entity, cache_usage);
@@ -550,6 +685,7 @@ ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity,
     INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, cache_lookup_count);
     INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, cache_hit_count);
     INT_DOUBLE_METRIC_REGISTER(_entity, cache_hit_ratio);
+    INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, cache_admission_reject_count);
 }
 
 ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
@@ -644,25 +780,28 @@ void ShardedLRUCache::update_cache_metrics() const {
     size_t total_usage = 0;
     size_t total_lookup_count = 0;
     size_t total_hit_count = 0;
+    size_t total_admission_reject_count = 0;
     for (int i = 0; i < _num_shards; i++) {
         total_capacity += _shards[i]->get_capacity();
         total_usage += _shards[i]->get_usage();
         total_lookup_count += _shards[i]->get_lookup_count();
         total_hit_count += _shards[i]->get_hit_count();
+        total_admission_reject_count += _shards[i]->get_admission_reject_count();
     }
 
     cache_capacity->set_value(total_capacity);
     cache_usage->set_value(total_usage);
     cache_lookup_count->set_value(total_lookup_count);
     cache_hit_count->set_value(total_hit_count);
+    cache_admission_reject_count->set_value(total_admission_reject_count);
     cache_usage_ratio->set_value(total_capacity == 0 ? 0 : ((double)total_usage / total_capacity));
     cache_hit_ratio->set_value(
             total_lookup_count == 0 ? 0 : ((double)total_hit_count / total_lookup_count));
 }
 
 Cache* new_lru_cache(const std::string& name, size_t capacity, LRUCacheType type,
-                     uint32_t num_shards) {
-    return new ShardedLRUCache(name, capacity, type, num_shards);
+                     uint32_t num_shards, CacheAdmissionPolicy policy) {
+    return new ShardedLRUCache(name, capacity, type, num_shards, 0, policy);
 }
 
 } // namespace doris
@@ -10,6 +10,7 @@
 #include <string.h>
 
 #include <functional>
+#include <memory>
 #include <queue>
 #include <string>
 #include <vector>
@@ -55,10 +56,25 @@ enum LRUCacheType {
     NUMBER // The capacity of cache is based on the number of cache entry.
 };
 
+// Decides whether a new entry is admitted into a full cache.
+enum class CacheAdmissionPolicy {
+    // Always admit the new entry, the least recently used entries are evicted.
+    LRU,
+    // Admit the new entry only if it is accessed more frequently than the entry
+    // to evict, so that a one-off scan could not flush the hot entries.
+    TINY_LFU
+};
+
+// Returns the policy named by `policy` ("LRU" or "TinyLFU", case insensitive),
+// or LRU if the name is unknown.
+CacheAdmissionPolicy parse_cache_admission_policy(const std::string& policy);
+const char* cache_admission_policy_name(CacheAdmissionPolicy policy);
+
 // Create a new cache with a specified name and capacity.
 // This implementation of Cache uses a least-recently-used eviction policy.
 extern Cache* new_lru_cache(const std::string& name, size_t capacity,
-                            LRUCacheType type = LRUCacheType::SIZE, uint32_t num_shards = 16);
+                            LRUCacheType type = LRUCacheType::SIZE, uint32_t num_shards = 16,
+                            CacheAdmissionPolicy policy = CacheAdmissionPolicy::LRU);
 
 class CacheKey {
 public:
@@ -314,6 +330,34 @@ private:
     void _resize();
 };
 
+// A count-min sketch of the access frequency of keys, used by the TinyLFU admission.
+// Each counter takes 4 bits, and all the counters are halved once the number of
+// increments reaches 10 times the width, so that old accesses fade out.
+class FrequencySketch {
+public:
+    // `width` is the expected number of entries, rounded up to a power of two.
+    explicit FrequencySketch(size_t width);
+
+    void increment(uint32_t hash);
+
+    // Returns the estimated access count of `hash`, at most 15.
+    uint32_t frequency(uint32_t hash) const;
+
+private:
+    FRIEND_TEST(CacheTest, FrequencySketch);
+
+    static constexpr int kDepth = 4;
+
+    size_t _index_of(uint32_t hash, int row) const;
+    void _reset();
+
+    // 16 counters in each word
+    std::vector<uint64_t> _table;
+    size_t _counter_mask;
+    size_t _sample_size;
+    size_t _size = 0;
+};
+
 // pair first is timestatmp, put <timestatmp, LRUHandle*> into asc set,
 // when need to free space, can first evict the begin of the set,
 // because the begin element's timestamp is the oldest.
@@ -330,6 +374,8 @@ public:
     void set_element_count_capacity(uint32_t element_count_capacity) {
         _element_count_capacity = element_count_capacity;
     }
+    // Must be called after set_capacity() and set_element_count_capacity().
+    void set_admission_policy(CacheAdmissionPolicy policy);
 
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -347,6 +393,7 @@ public:
 
     uint64_t get_lookup_count() const { return _lookup_count; }
     uint64_t get_hit_count() const { return _hit_count; }
+    uint64_t get_admission_reject_count() const { return _admission_reject_count; }
     size_t get_usage() const { return _usage; }
     size_t get_capacity() const { return _capacity; }
 
@@ -358,6 +405,7 @@ private:
     void _evict_from_lru_with_time(size_t total_size, LRUHandle** to_remove_head);
     void _evict_one_entry(LRUHandle* e);
     bool _check_element_count_limit();
+    bool _admit(const LRUHandle* e);
 
 private:
     LRUCacheType _type;
@@ -387,12 +435,18 @@ private:
     LRUHandleSortedSet _sorted_durable_entries_with_timestamp;
 
     uint32_t _element_count_capacity = 0;
+
+    // only set for CacheAdmissionPolicy::TINY_LFU
+    std::unique_ptr<FrequencySketch> _sketch;
+    uint64_t _admission_reject_count = 0;
+    uint32_t _warm_admission_count = 0;
 };
 
 class ShardedLRUCache : public Cache {
 public:
     explicit ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
-                             uint32_t num_shards, uint32_t element_count_capacity = 0);
+                             uint32_t num_shards, uint32_t element_count_capacity = 0,
+                             CacheAdmissionPolicy policy = CacheAdmissionPolicy::LRU);
     explicit ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
                              uint32_t num_shards,
                              CacheValueTimeExtractor cache_value_time_extractor,
@@ -439,6 +493,7 @@ private:
     IntAtomicCounter* cache_lookup_count = nullptr;
     IntAtomicCounter* cache_hit_count = nullptr;
     DoubleGauge* cache_hit_ratio = nullptr;
+    IntAtomicCounter* cache_admission_reject_count = nullptr;
 };
 
 } // namespace doris
@@ -17,6 +17,8 @@
 
 #include "olap/memtable.h"
 
+#include <numeric>
+
 #include "common/logging.h"
 #include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset_writer.h"
@@ -29,6 +31,8 @@
 #include "vec/columns/column_object.h"
 #include "vec/core/columns_with_type_and_name.h"
 #include "vec/core/field.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_number.h"
 #include "vec/jsonb/serialize.h"
 
 namespace doris {
@@ -66,9 +70,14 @@ MemTable::MemTable(TabletSharedPtr tablet, Schema* schema, const TabletSchema* t
 #endif
     _arena = std::make_unique<vectorized::Arena>();
     _vec_row_comparator = std::make_shared<RowInBlockComparator>(_schema);
-    // TODO: Support ZOrderComparator in the future
-    _vec_skip_list = std::make_unique<VecTable>(_vec_row_comparator.get(), _arena.get(),
-                                                _keys_type == KeysType::DUP_KEYS);
+    // the columns of the dynamic schema may change between the inserts
+    _sort_on_flush =
+            config::enable_memtable_sort_on_flush && !_tablet_schema->is_dynamic_schema();
+    if (!_sort_on_flush) {
+        // TODO: Support ZOrderComparator in the future
+        _vec_skip_list = std::make_unique<VecTable>(_vec_row_comparator.get(), _arena.get(),
+                                                    _keys_type == KeysType::DUP_KEYS);
+    }
     _init_columns_offset_by_slot_descs(slot_descs, tuple_desc);
 }
 void MemTable::_init_columns_offset_by_slot_descs(const std::vector<SlotDescriptor*>* slot_descs,
@@ -181,6 +190,10 @@ void MemTable::insert(const vectorized::Block* input_block, const std::vector<in
     size_t input_size = target_block.allocated_bytes() * num_rows / target_block.rows();
     _mem_usage += input_size;
     _insert_mem_tracker->consume(input_size);
+    if (_sort_on_flush) {
+        _rows += num_rows;
+        return;
+    }
     for (int i = 0; i < num_rows; i++) {
         _row_in_blocks.emplace_back(new RowInBlock {cursor_in_mutableblock + i});
         _insert_one_row_from_block(_row_in_blocks.back());
@@ -302,11 +315,160 @@ void MemTable::_collect_vskiplist_results() {
     }
 }
 
+void MemTable::_sort_by_keys(const vectorized::Block& block, std::vector<int>* row_ids,
+                             std::vector<uint8_t>* same_key) {
+    size_t rows = block.rows();
+    // sort by the key columns and then by the row position, like the skiplist does
+    vectorized::Block key_block;
+    vectorized::SortDescription description;
+    for (size_t i = 0; i < _schema->num_key_columns(); ++i) {
+        key_block.insert(block.get_by_position(i));
+        description.emplace_back(i, 1, -1);
+    }
+    auto row_pos_column = vectorized::ColumnInt32::create(rows);
+    auto& row_pos = row_pos_column->get_data();
+    std::iota(row_pos.begin(), row_pos.end(), 0);
+    key_block.insert({std::move(row_pos_column), std::make_shared<vectorized::DataTypeInt32>(),
+                      "__row_pos__"});
+    description.emplace_back(key_block.columns() - 1, 1, -1);
+
+    vectorized::Block sorted_block = key_block.clone_empty();
+    vectorized::sort_block(key_block, sorted_block, description);
+
+    size_t row_pos_idx = sorted_block.columns() - 1;
+    const auto& sorted_row_pos = assert_cast<const vectorized::ColumnInt32&>(
+                                         *sorted_block.get_by_position(row_pos_idx).column)
+                                         .get_data();
+    row_ids->assign(sorted_row_pos.begin(), sorted_row_pos.end());
+    if (same_key == nullptr) {
+        return;
+    }
+    // compare the adjacent rows column by column
+    same_key->assign(rows, 1);
+    if (rows > 0) {
+        (*same_key)[0] = 0;
+    }
+    for (size_t i = 0; i < row_pos_idx; ++i) {
+        const auto& column = *sorted_block.get_by_position(i).column;
+        auto* flags = same_key->data();
+        for (size_t row = 1; row < rows; ++row) {
+            flags[row] &= column.compare_at(row, row - 1, column, -1) == 0;
+        }
+    }
+}
+
+template <bool is_final>
+void MemTable::_sort_and_aggregate() {
+    vectorized::Block in_block = _input_mutable_block.to_block();
+    size_t rows = in_block.rows();
+    if (rows == 0) {
+        return;
+    }
+    std::vector<int> row_ids;
+    if (_keys_type == KeysType::DUP_KEYS) {
+        _sort_by_keys(in_block, &row_ids, nullptr);
+        _output_mutable_block.add_rows(&in_block, row_ids.data(), row_ids.data() + rows);
+        return;
+    }
+
+    std::vector<uint8_t> same_key;
+    _sort_by_keys(in_block, &row_ids, &same_key);
+    // the first row of each key
+    std::vector<int> group_starts;
+    for (size_t i = 0; i < rows; ++i) {
+        if (!same_key[i]) {
+            group_starts.push_back(i);
+        }
+    }
+    size_t num_groups = group_starts.size();
+    _merged_rows += rows - num_groups;
+
+    if (_keys_type == KeysType::UNIQUE_KEYS) {
+        // The value columns of the unique key model are replaced, so the result of a key is one
+        // of its rows: the last one, or the last one of the max sequence value.
+        const vectorized::IColumn* sequence_column = nullptr;
+        if (_tablet_schema->has_sequence_col()) {
+            sequence_column = in_block.get_by_position(_tablet_schema->sequence_col_idx())
+                                      .column.get();
+        }
+        std::vector<int> result_rows(num_groups);
+        for (size_t group = 0; group < num_groups; ++group) {
+            size_t begin = group_starts[group];
+            size_t end = group + 1 < num_groups ? group_starts[group + 1] : rows;
+            size_t result = end - 1;
+            if (sequence_column != nullptr) {
+                result = begin;
+                for (size_t i = begin + 1; i < end; ++i) {
+                    if (sequence_column->compare_at(row_ids[i], row_ids[result], *sequence_column,
+                                                    -1) >= 0) {
+                        result = i;
+                    }
+                }
+            }
+            result_rows[group] = row_ids[result];
+        }
+        _output_mutable_block.add_rows(&in_block, result_rows.data(),
+                                       result_rows.data() + num_groups);
+    } else {
+        std::vector<int> key_rows(num_groups);
+        for (size_t group = 0; group < num_groups; ++group) {
+            key_rows[group] = row_ids[group_starts[group]];
+        }
+        for (size_t i = 0; i < _schema->num_key_columns(); ++i) {
+            _output_mutable_block.get_column_by_position(i)->insert_indices_from(
+                    *in_block.get_by_position(i).column, key_rows.data(),
+                    key_rows.data() + num_groups);
+        }
+
+        // the aggregation state of each key, and of each row in the input order
+        std::vector<vectorized::AggregateDataPtr> group_places(num_groups);
+        std::vector<vectorized::AggregateDataPtr> row_places(rows);
+        for (size_t group = 0; group < num_groups; ++group) {
+            auto place = _arena->aligned_alloc(_total_size_of_aggregate_states, 16);
+            for (auto cid = _schema->num_key_columns(); cid < _schema->num_columns(); ++cid) {
+                _agg_functions[cid]->create(place + _offsets_of_aggregate_states[cid]);
+            }
+            group_places[group] = place;
+            size_t end = group + 1 < num_groups ? group_starts[group + 1] : rows;
+            for (size_t i = group_starts[group]; i < end; ++i) {
+                row_places[row_ids[i]] = place;
+            }
+        }
+        for (auto cid = _schema->num_key_columns(); cid < _schema->num_columns(); ++cid) {
+            const auto* column = in_block.get_by_position(cid).column.get();
+            auto& function = _agg_functions[cid];
+            function->add_batch(rows, row_places.data(), _offsets_of_aggregate_states[cid],
+                                &column, _arena.get());
+            auto& dst = *_output_mutable_block.get_column_by_position(cid);
+            for (auto place : group_places) {
+                function->insert_result_into(place + _offsets_of_aggregate_states[cid], dst);
+                function->destroy(place + _offsets_of_aggregate_states[cid]);
+            }
+        }
+    }
+
+    if constexpr (!is_final) {
+        // continue to insert into the aggregated rows
+        size_t shrunked_after_agg = _output_mutable_block.allocated_bytes();
+        _insert_mem_tracker->consume(shrunked_after_agg - _mem_usage);
+        _mem_usage = shrunked_after_agg;
+        _input_mutable_block.swap(_output_mutable_block);
+        std::unique_ptr<vectorized::Block> empty_input_block = in_block.create_same_struct_block(0);
+        _output_mutable_block =
+                vectorized::MutableBlock::build_mutable_block(empty_input_block.get());
+        _output_mutable_block.clear_column_data();
+    }
+}
+
 void MemTable::shrink_memtable_by_agg() {
     SCOPED_CONSUME_MEM_TRACKER(_insert_mem_tracker_use_hook.get());
     if (_keys_type == KeysType::DUP_KEYS) {
         return;
     }
+    if (_sort_on_flush) {
+        _sort_and_aggregate<false>();
+        return;
+    }
     _collect_vskiplist_results<false>();
 }
 
@@ -371,7 +533,11 @@ Status MemTable::flush() {
 
 Status MemTable::_do_flush(int64_t& duration_ns) {
     SCOPED_RAW_TIMER(&duration_ns);
-    _collect_vskiplist_results<true>();
+    if (_sort_on_flush) {
+        _sort_and_aggregate<true>();
+    } else {
+        _collect_vskiplist_results<true>();
+    }
     vectorized::Block block = _output_mutable_block.to_block();
     if (_tablet_schema->store_row_column()) {
         // convert block to row store format
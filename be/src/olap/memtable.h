@@ -177,6 +177,18 @@ private:
     void _collect_vskiplist_results();
     bool _is_first_insertion;
 
+    // In sort-on-flush mode the rows are only appended to _input_mutable_block, and they are
+    // sorted and aggregated column-wise when the memtable is flushed or shrunk, instead of
+    // being inserted into the skiplist one by one.
+    bool _sort_on_flush = false;
+    template <bool is_final>
+    void _sort_and_aggregate();
+    // Returns the positions of the rows of `block` ordered by the key columns, the rows of the
+    // same key keep the order they were inserted in. `same_key[i]` is set to 1 if the i-th
+    // row in this order has the same key as the one before it.
+    void _sort_by_keys(const vectorized::Block& block, std::vector<int>* row_ids,
+                       std::vector<uint8_t>* same_key);
+
     void _init_agg_functions(const vectorized::Block* block);
     std::vector<vectorized::AggregateFunctionPtr> _agg_functions;
     std::vector<size_t> _offsets_of_aggregate_states;
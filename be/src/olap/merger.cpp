@@ -17,22 +17,75 @@
 
 #include "olap/merger.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
+#include "olap/key_coder.h"
 #include "olap/olap_define.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/segment_loader.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
+#include "olap/types.h"
+#include "util/key_util.h"
+#include "util/threadpool.h"
 #include "util/trace.h"
 #include "vec/olap/block_reader.h"
 
 namespace doris {
 
+namespace {
+
+void set_key_range(const Merger::KeyRange* key_range, TabletReader::ReaderParams* reader_params) {
+    if (key_range == nullptr) {
+        return;
+    }
+    reader_params->start_key.push_back(key_range->start_key);
+    reader_params->end_key.push_back(key_range->end_key);
+    reader_params->start_key_include = true;
+    reader_params->end_key_include = key_range->end_key_include;
+}
+
+// The rowid map of a key range of parallel_merge_rowsets() is set up by it for all ranges.
+Status init_rowid_conversion(const std::vector<RowsetReaderSharedPtr>& rs_readers,
+                             RowsetWriter* dst_rowset_writer, Merger::Statistics* stats_output) {
+    if (stats_output->key_range_id >= 0) {
+        return Status::OK();
+    }
+    stats_output->rowid_conversion->set_dst_rowset_id(dst_rowset_writer->rowset_id());
+    // init segment rowid map for rowid conversion
+    std::vector<uint32_t> segment_num_rows;
+    for (auto& rs_reader : rs_readers) {
+        RETURN_NOT_OK(rs_reader->get_segment_num_rows(&segment_num_rows));
+        stats_output->rowid_conversion->init_segment_map(rs_reader->rowset()->rowset_id(),
+                                                         segment_num_rows);
+    }
+    return Status::OK();
+}
+
+Status add_rowid_conversion(const std::vector<RowLocation>& row_locations,
+                            RowsetWriter* dst_rowset_writer, Merger::Statistics* stats_output,
+                            RowIdConversion::KeyRangePosition* key_range_position) {
+    std::vector<uint32_t> segment_num_rows;
+    RETURN_IF_ERROR(dst_rowset_writer->get_segment_num_rows(&segment_num_rows));
+    if (stats_output->key_range_id >= 0) {
+        stats_output->rowid_conversion->add_key_range(stats_output->key_range_id, row_locations,
+                                                      segment_num_rows, key_range_position);
+    } else {
+        stats_output->rowid_conversion->add(row_locations, segment_num_rows);
+    }
+    return Status::OK();
+}
+
+} // namespace
+
 Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                               TabletSchemaSPtr cur_tablet_schema,
                               const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
-                              RowsetWriter* dst_rowset_writer, Statistics* stats_output) {
+                              RowsetWriter* dst_rowset_writer, Statistics* stats_output,
+                              const KeyRange* key_range) {
     TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
 
     vectorized::BlockReader reader;
@@ -41,6 +94,7 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     reader_params.reader_type = reader_type;
     reader_params.rs_readers = src_rowset_readers;
     reader_params.version = dst_rowset_writer->version();
+    set_key_range(key_range, &reader_params);
 
     TabletSchemaSPtr merge_tablet_schema = std::make_shared<TabletSchema>();
     merge_tablet_schema->copy_from(*cur_tablet_schema);
@@ -68,15 +122,10 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     RETURN_NOT_OK(reader.init(reader_params));
 
     if (reader_params.record_rowids) {
-        stats_output->rowid_conversion->set_dst_rowset_id(dst_rowset_writer->rowset_id());
-        // init segment rowid map for rowid conversion
-        std::vector<uint32_t> segment_num_rows;
-        for (auto& rs_reader : reader_params.rs_readers) {
-            RETURN_NOT_OK(rs_reader->get_segment_num_rows(&segment_num_rows));
-            stats_output->rowid_conversion->init_segment_map(rs_reader->rowset()->rowset_id(),
-                                                             segment_num_rows);
-        }
+        RETURN_NOT_OK(init_rowid_conversion(reader_params.rs_readers, dst_rowset_writer,
+                                            stats_output));
     }
+    RowIdConversion::KeyRangePosition key_range_position;
 
     vectorized::Block block = cur_tablet_schema->create_block(reader_params.return_columns);
     size_t output_rows = 0;
@@ -91,10 +140,9 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                 "failed to write block when merging rowsets of tablet " + tablet->full_name());
 
         if (reader_params.record_rowids && block.rows() > 0) {
-            std::vector<uint32_t> segment_num_rows;
-            RETURN_IF_ERROR(dst_rowset_writer->get_segment_num_rows(&segment_num_rows));
-            stats_output->rowid_conversion->add(reader.current_block_row_locations(),
-                                                segment_num_rows);
+            RETURN_IF_ERROR(add_rowid_conversion(reader.current_block_row_locations(),
+                                                 dst_rowset_writer, stats_output,
+                                                 &key_range_position));
         }
 
         output_rows += block.rows();
@@ -162,7 +210,8 @@ Status Merger::vertical_compact_one_group(
         TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema, bool is_key,
         const std::vector<uint32_t>& column_group, vectorized::RowSourcesBuffer* row_source_buf,
         const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
-        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment, Statistics* stats_output) {
+        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment, Statistics* stats_output,
+        const KeyRange* key_range) {
     // build tablet reader
     VLOG_NOTICE << "vertical compact one group, max_rows_per_segment=" << max_rows_per_segment;
     vectorized::VerticalBlockReader reader(row_source_buf);
@@ -172,6 +221,7 @@ Status Merger::vertical_compact_one_group(
     reader_params.reader_type = reader_type;
     reader_params.rs_readers = src_rowset_readers;
     reader_params.version = dst_rowset_writer->version();
+    set_key_range(key_range, &reader_params);
 
     TabletSchemaSPtr merge_tablet_schema = std::make_shared<TabletSchema>();
     merge_tablet_schema->copy_from(*tablet_schema);
@@ -198,15 +248,10 @@ Status Merger::vertical_compact_one_group(
     RETURN_NOT_OK(reader.init(reader_params));
 
     if (reader_params.record_rowids) {
-        stats_output->rowid_conversion->set_dst_rowset_id(dst_rowset_writer->rowset_id());
-        // init segment rowid map for rowid conversion
-        std::vector<uint32_t> segment_num_rows;
-        for (auto& rs_reader : reader_params.rs_readers) {
-            RETURN_NOT_OK(rs_reader->get_segment_num_rows(&segment_num_rows));
-            stats_output->rowid_conversion->init_segment_map(rs_reader->rowset()->rowset_id(),
-                                                             segment_num_rows);
-        }
+        RETURN_NOT_OK(init_rowid_conversion(reader_params.rs_readers, dst_rowset_writer,
+                                            stats_output));
     }
+    RowIdConversion::KeyRangePosition key_range_position;
 
     vectorized::Block block = tablet_schema->create_block(reader_params.return_columns);
     size_t output_rows = 0;
@@ -221,10 +266,9 @@ Status Merger::vertical_compact_one_group(
                 "failed to write block when merging rowsets of tablet " + tablet->full_name());
 
         if (is_key && reader_params.record_rowids && block.rows() > 0) {
-            std::vector<uint32_t> segment_num_rows;
-            RETURN_IF_ERROR(dst_rowset_writer->get_segment_num_rows(&segment_num_rows));
-            stats_output->rowid_conversion->add(reader.current_block_row_locations(),
-                                                segment_num_rows);
+            RETURN_IF_ERROR(add_rowid_conversion(reader.current_block_row_locations(),
+                                                 dst_rowset_writer, stats_output,
+                                                 &key_range_position));
         }
         output_rows += block.rows();
         block.clear_column_data();
@@ -309,7 +353,7 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
                                       TabletSchemaSPtr tablet_schema,
                                       const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                                       RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
-                                      Statistics* stats_output) {
+                                      Statistics* stats_output, const KeyRange* key_range) {
     LOG(INFO) << "Start to do vertical compaction, tablet_id: " << tablet->tablet_id();
     std::vector<std::vector<uint32_t>> column_groups;
     vertical_split_columns(tablet_schema, &column_groups);
@@ -322,7 +366,8 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
         bool is_key = (i == 0);
         RETURN_IF_ERROR(vertical_compact_one_group(
                 tablet, reader_type, tablet_schema, is_key, column_groups[i], &row_sources_buf,
-                src_rowset_readers, dst_rowset_writer, max_rows_per_segment, stats_output));
+                src_rowset_readers, dst_rowset_writer, max_rows_per_segment, stats_output,
+                key_range));
         if (is_key) {
             row_sources_buf.flush();
         }
@@ -336,4 +381,228 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
     return Status::OK();
 }
 
+void Merger::split_key_ranges(TabletSchemaSPtr tablet_schema,
+                              const std::vector<RowsetSharedPtr>& src_rowsets, int num_ranges,
+                              std::vector<KeyRange>* key_ranges) {
+    key_ranges->clear();
+    if (num_ranges <= 1 || tablet_schema->num_key_columns() == 0) {
+        return;
+    }
+    const TabletColumn& column = tablet_schema->column(0);
+    switch (column.type()) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_DATE:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_DATEV2:
+    case OLAP_FIELD_TYPE_DATETIMEV2:
+        break;
+    default:
+        return;
+    }
+    const KeyCoder* key_coder = get_key_coder(column.type());
+    const TypeInfo* type_info = get_scalar_type_info(column.type());
+
+    // A key of the short key index stands for the num_rows_per_block rows from it, the min
+    // and max keys of a segment without one for half of its rows. The encoded keys are in
+    // the same order as the values, so the samples are sorted by the encoded keys.
+    std::vector<std::pair<std::string, double>> samples;
+    double total_rows = 0;
+    auto add_sample = [&](const Slice& key, double rows) {
+        // the keys of null values stay in the first range
+        if (key.empty() || key[0] != KEY_NORMAL_MARKER) {
+            return true;
+        }
+        Slice slice(key.data + 1, key.size - 1);
+        alignas(16) uint8_t value[16];
+        if (!key_coder->decode_ascending(&slice, column.length(), value).ok()) {
+            return false;
+        }
+        samples.emplace_back(std::string(key.data + 1, slice.data - key.data - 1), rows);
+        total_rows += rows;
+        return true;
+    };
+    for (auto& rowset : src_rowsets) {
+        if (rowset->num_segments() == 0) {
+            continue;
+        }
+        std::vector<KeyBoundsPB> segments_key_bounds;
+        if (!rowset->get_segments_key_bounds(&segments_key_bounds).ok()) {
+            return;
+        }
+        SegmentCacheHandle segment_cache_handle;
+        std::vector<segment_v2::SegmentSharedPtr> segments;
+        if (SegmentLoader::instance()
+                    ->load_segments(std::static_pointer_cast<BetaRowset>(rowset),
+                                    &segment_cache_handle, true)
+                    .ok()) {
+            segments = segment_cache_handle.get_segments();
+        }
+        for (size_t i = 0; i < segments_key_bounds.size(); ++i) {
+            const ShortKeyIndexDecoder* short_key_index = nullptr;
+            int64_t segment_rows = rowset->num_rows() / rowset->num_segments();
+            if (i < segments.size()) {
+                segment_rows = segments[i]->num_rows();
+                // merge-on-write tables have a primary key index instead
+                if (segments[i]->load_index().ok()) {
+                    short_key_index = segments[i]->get_short_key_index();
+                }
+            }
+            if (short_key_index != nullptr && short_key_index->num_items() > 0) {
+                int64_t rows_per_block = short_key_index->num_rows_per_block();
+                for (uint32_t j = 0; j < short_key_index->num_items(); ++j) {
+                    int64_t rows = std::min(rows_per_block, segment_rows - j * rows_per_block);
+                    if (!add_sample(short_key_index->key(j), std::max<int64_t>(rows, 1))) {
+                        return;
+                    }
+                }
+                continue;
+            }
+            const auto& key_bounds = segments_key_bounds[i];
+            for (auto& key : {key_bounds.min_key(), key_bounds.max_key()}) {
+                if (!add_sample(Slice(key), segment_rows / 2.0)) {
+                    return;
+                }
+            }
+        }
+    }
+    if (samples.empty()) {
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    std::vector<std::string> split_keys;
+    double range_rows = total_rows / num_ranges;
+    double cur_rows = 0;
+    for (auto& [encoded_key, rows] : samples) {
+        if (split_keys.size() + 1 >= num_ranges) {
+            break;
+        }
+        if (cur_rows >= range_rows * (split_keys.size() + 1) &&
+            (split_keys.empty() || encoded_key > split_keys.back()) &&
+            encoded_key > samples.front().first) {
+            split_keys.push_back(encoded_key);
+        }
+        cur_rows += rows;
+    }
+    if (split_keys.empty()) {
+        return;
+    }
+
+    auto to_string = [&](const std::string& encoded_key) {
+        Slice slice(encoded_key);
+        alignas(16) uint8_t value[16];
+        static_cast<void>(key_coder->decode_ascending(&slice, column.length(), value));
+        return type_info->to_string(value);
+    };
+    alignas(16) uint8_t max_value[16];
+    type_info->set_to_max(max_value);
+
+    key_ranges->resize(split_keys.size() + 1);
+    key_ranges->front().start_key.add_null();
+    for (size_t i = 0; i < split_keys.size(); ++i) {
+        std::string split_key = to_string(split_keys[i]);
+        (*key_ranges)[i].end_key.add_value(split_key);
+        (*key_ranges)[i + 1].start_key.add_value(split_key);
+    }
+    key_ranges->back().end_key.add_value(type_info->to_string(max_value));
+    key_ranges->back().end_key_include = true;
+}
+
+// steps to do parallel merge:
+// 1. set up the rowid conversion of all ranges, with the segments of the source rowsets
+// 2. merge the ranges on the threads of the pool, each into a rowset of its own
+// 3. link the segments of the range rowsets into the output rowset, range by range
+Status Merger::parallel_merge_rowsets(
+        TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
+        const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+        const std::vector<KeyRange>& key_ranges, bool is_vertical, int64_t max_rows_per_segment,
+        ThreadPool* thread_pool, const RowsetWriterCreator& create_writer,
+        RowsetWriter* dst_rowset_writer, Statistics* stats_output) {
+    LOG(INFO) << "Start to do parallel compaction, tablet_id: " << tablet->tablet_id()
+              << ", key_ranges: " << key_ranges.size() << ", vertical: " << is_vertical;
+    RowIdConversion* rowid_conversion =
+            stats_output != nullptr ? stats_output->rowid_conversion : nullptr;
+    if (rowid_conversion != nullptr) {
+        rowid_conversion->set_dst_rowset_id(dst_rowset_writer->rowset_id());
+        for (auto& rs_reader : src_rowset_readers) {
+            SegmentCacheHandle segment_cache_handle;
+            RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(
+                    std::static_pointer_cast<BetaRowset>(rs_reader->rowset()),
+                    &segment_cache_handle, true));
+            std::vector<uint32_t> segment_num_rows;
+            for (auto& segment : segment_cache_handle.get_segments()) {
+                segment_num_rows.push_back(segment->num_rows());
+            }
+            rowid_conversion->init_segment_map(rs_reader->rowset()->rowset_id(),
+                                               segment_num_rows);
+        }
+    }
+
+    size_t num_ranges = key_ranges.size();
+    std::vector<std::unique_ptr<RowsetWriter>> range_writers(num_ranges);
+    std::vector<Statistics> range_stats(num_ranges);
+    std::vector<Status> range_status(num_ranges);
+    for (size_t i = 0; i < num_ranges; ++i) {
+        RETURN_IF_ERROR(create_writer(&range_writers[i]));
+        range_stats[i].rowid_conversion = rowid_conversion;
+        range_stats[i].key_range_id = i;
+    }
+
+    auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    Status submit_status = Status::OK();
+    for (size_t i = 0; i < num_ranges && submit_status.ok(); ++i) {
+        submit_status = token->submit_func([&, i]() {
+            // the readers keep the iterators of the range, so each range has its own
+            std::vector<RowsetReaderSharedPtr> rs_readers;
+            for (auto& rs_reader : src_rowset_readers) {
+                rs_readers.push_back(rs_reader->clone());
+            }
+            if (is_vertical) {
+                range_status[i] = vertical_merge_rowsets(
+                        tablet, reader_type, tablet_schema, rs_readers, range_writers[i].get(),
+                        max_rows_per_segment, &range_stats[i], &key_ranges[i]);
+            } else {
+                range_status[i] =
+                        vmerge_rowsets(tablet, reader_type, tablet_schema, rs_readers,
+                                       range_writers[i].get(), &range_stats[i], &key_ranges[i]);
+            }
+        });
+    }
+    token->wait();
+    RETURN_IF_ERROR(submit_status);
+    for (auto& status : range_status) {
+        RETURN_IF_ERROR(status);
+    }
+
+    std::vector<uint32_t> range_num_segments;
+    for (size_t i = 0; i < num_ranges; ++i) {
+        RowsetSharedPtr rowset = range_writers[i]->build();
+        if (rowset == nullptr) {
+            LOG(WARNING) << "rowset writer build failed. writer version:"
+                         << range_writers[i]->version() << ", key range: " << i;
+            return Status::Error<ROWSET_BUILDER_INIT>();
+        }
+        range_num_segments.push_back(rowset->num_segments());
+        Status st = dst_rowset_writer->add_rowset(rowset);
+        // only the links of its files in the output rowset are kept
+        StorageEngine::instance()->add_unused_rowset(rowset);
+        RETURN_IF_ERROR(st);
+
+        if (stats_output != nullptr) {
+            stats_output->output_rows += range_stats[i].output_rows;
+            stats_output->merged_rows += range_stats[i].merged_rows;
+            stats_output->filtered_rows += range_stats[i].filtered_rows;
+        }
+    }
+    if (rowid_conversion != nullptr) {
+        rowid_conversion->remap_key_range_segments(range_num_segments);
+    }
+
+    return Status::OK();
+}
+
 } // namespace doris
@@ -17,8 +17,11 @@
 
 #pragma once
 
+#include <functional>
+
 #include "io/io_common.h"
 #include "olap/olap_define.h"
+#include "olap/olap_tuple.h"
 #include "olap/rowid_conversion.h"
 #include "olap/rowset/rowset_writer.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
@@ -32,6 +35,8 @@ namespace vectorized {
 class RowSourcesBuffer;
 };
 
+class ThreadPool;
+
 class Merger {
 public:
     struct Statistics {
@@ -40,8 +45,20 @@ public:
         int64_t merged_rows = 0;
         int64_t filtered_rows = 0;
         RowIdConversion* rowid_conversion = nullptr;
+        // set when this merge is one of the key ranges of parallel_merge_rowsets()
+        int32_t key_range_id = -1;
     };
 
+    // A range of the values of the first key column, [start_key, end_key), or
+    // [start_key, end_key] if end_key_include is set.
+    struct KeyRange {
+        OlapTuple start_key;
+        OlapTuple end_key;
+        bool end_key_include = false;
+    };
+
+    using RowsetWriterCreator = std::function<Status(std::unique_ptr<RowsetWriter>*)>;
+
     // merge rows from `src_rowset_readers` and write into `dst_rowset_writer`.
     // return OK and set statistics into `*stats_output`.
     // return others on error
@@ -49,11 +66,32 @@ public:
     static Status vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                                  TabletSchemaSPtr cur_tablet_schema,
                                  const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
-                                 RowsetWriter* dst_rowset_writer, Statistics* stats_output);
+                                 RowsetWriter* dst_rowset_writer, Statistics* stats_output,
+                                 const KeyRange* key_range = nullptr);
     static Status vertical_merge_rowsets(
             TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
             const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
             RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
+            Statistics* stats_output, const KeyRange* key_range = nullptr);
+
+    // Splits the keys of `src_rowsets` into at most `num_ranges` ranges with about the same
+    // number of rows, sampled from the short key indexes of their segments, or from the key
+    // bounds of the segments without one. Only splits on the first key column if it is an
+    // integer or date column, `key_ranges` is left empty otherwise.
+    static void split_key_ranges(TabletSchemaSPtr tablet_schema,
+                                 const std::vector<RowsetSharedPtr>& src_rowsets, int num_ranges,
+                                 std::vector<KeyRange>* key_ranges);
+
+    // Merges the rows of each of `key_ranges` on a thread of `thread_pool`, into a rowset of
+    // its own created by `create_writer`, and then links the segments of these rowsets into
+    // `dst_rowset_writer` in the order of the ranges. The rowid conversion, if any, is done
+    // to the segments of `dst_rowset_writer`.
+    static Status parallel_merge_rowsets(
+            TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
+            const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+            const std::vector<KeyRange>& key_ranges, bool is_vertical,
+            int64_t max_rows_per_segment, ThreadPool* thread_pool,
+            const RowsetWriterCreator& create_writer, RowsetWriter* dst_rowset_writer,
             Statistics* stats_output);
 
 public:
@@ -66,7 +104,7 @@ public:
             vectorized::RowSourcesBuffer* row_source_buf,
             const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
             RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
-            Statistics* stats_output);
+            Statistics* stats_output, const KeyRange* key_range = nullptr);
 
     // for segcompaction
     static Status vertical_compact_one_group(TabletSharedPtr tablet, ReaderType reader_type,
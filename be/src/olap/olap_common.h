@@ -318,12 +318,20 @@ struct OlapReaderStatistics {
     int64_t rows_del_by_bitmap = 0;
     // the number of rows filtered by various column indexes.
     int64_t rows_conditions_filtered = 0;
+    // pages and rows skipped by the runtime filters arrived after the scan started
+    int64_t late_rf_pages_filtered = 0;
+    int64_t rows_late_rf_filtered = 0;
     int64_t block_conditions_filtered_ns = 0;
 
     int64_t index_load_ns = 0;
 
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
+    // data pages read ahead by PagePrefetcher, those of them never used, and the time the
+    // scan waited for the pages still being read
+    int64_t prefetched_pages_num = 0;
+    int64_t prefetch_wasted_pages_num = 0;
+    int64_t prefetch_wait_ns = 0;
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
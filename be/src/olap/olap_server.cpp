@@ -87,6 +87,11 @@ Status StorageEngine::start_bg_threads() {
                 .set_max_threads(config::seg_compaction_max_threads)
                 .build(&_seg_compaction_thread_pool);
     }
+    // key range parallel compaction is disabled by default, threads are created on demand
+    ThreadPoolBuilder("CompactionKeyRangeThreadPool")
+            .set_min_threads(0)
+            .set_max_threads(config::compaction_key_range_max_threads)
+            .build(&_compaction_key_range_thread_pool);
     ThreadPoolBuilder("ColdDataCompactionTaskThreadPool")
             .set_min_threads(config::cold_data_compaction_thread_num)
             .set_max_threads(config::cold_data_compaction_thread_num)
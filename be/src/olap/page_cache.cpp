@@ -24,28 +24,28 @@ namespace doris {
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
 void StoragePageCache::create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                           uint32_t num_shards) {
+                                           uint32_t num_shards, CacheAdmissionPolicy policy) {
     DCHECK(_s_instance == nullptr);
-    static StoragePageCache instance(capacity, index_cache_percentage, num_shards);
+    static StoragePageCache instance(capacity, index_cache_percentage, num_shards, policy);
     _s_instance = &instance;
 }
 
 StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percentage,
-                                   uint32_t num_shards)
+                                   uint32_t num_shards, CacheAdmissionPolicy policy)
         : _index_cache_percentage(index_cache_percentage) {
     if (index_cache_percentage == 0) {
         _data_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("DataPageCache", capacity, LRUCacheType::SIZE, num_shards));
+                new_lru_cache("DataPageCache", capacity, LRUCacheType::SIZE, num_shards, policy));
     } else if (index_cache_percentage == 100) {
         _index_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("IndexPageCache", capacity, LRUCacheType::SIZE, num_shards));
+                new_lru_cache("IndexPageCache", capacity, LRUCacheType::SIZE, num_shards, policy));
     } else if (index_cache_percentage > 0 && index_cache_percentage < 100) {
         _data_page_cache = std::unique_ptr<Cache>(
                 new_lru_cache("DataPageCache", capacity * (100 - index_cache_percentage) / 100,
-                              LRUCacheType::SIZE, num_shards));
+                              LRUCacheType::SIZE, num_shards, policy));
         _index_page_cache = std::unique_ptr<Cache>(
                 new_lru_cache("IndexPageCache", capacity * index_cache_percentage / 100,
-                              LRUCacheType::SIZE, num_shards));
+                              LRUCacheType::SIZE, num_shards, policy));
     } else {
         CHECK(false) << "invalid index page cache percentage";
     }
@@ -58,13 +58,15 @@ public:
 
     // Create global instance of this class
     static void create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                    uint32_t num_shards = kDefaultNumShards);
+                                    uint32_t num_shards = kDefaultNumShards,
+                                    CacheAdmissionPolicy policy = CacheAdmissionPolicy::LRU);
 
     // Return global instance.
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards);
+    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards,
+                     CacheAdmissionPolicy policy = CacheAdmissionPolicy::LRU);
 
     // Lookup the given page in the cache.
     //
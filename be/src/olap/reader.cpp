@@ -91,6 +91,9 @@ TabletReader::~TabletReader() {
     for (auto pred : _col_preds_except_leafnode_of_andnode) {
         delete pred;
     }
+    for (auto pred : _late_runtime_filter_predicates) {
+        delete pred;
+    }
 }
 
 Status TabletReader::init(const ReaderParams& read_params) {
@@ -209,6 +212,7 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params) {
     _reader_context.predicates = &_col_predicates;
     _reader_context.predicates_except_leafnode_of_andnode = &_col_preds_except_leafnode_of_andnode;
     _reader_context.value_predicates = &_value_col_predicates;
+    _reader_context.late_runtime_filter_predicates = &_late_runtime_filter_predicates;
     _reader_context.lower_bound_keys = &_keys_param.start_keys;
     _reader_context.is_lower_keys_included = &_is_lower_keys_included;
     _reader_context.upper_bound_keys = &_keys_param.end_keys;
@@ -226,6 +230,7 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params) {
     _reader_context.remaining_vconjunct_root = read_params.remaining_vconjunct_root;
     _reader_context.common_vexpr_ctxs_pushdown = read_params.common_vexpr_ctxs_pushdown;
     _reader_context.output_columns = &read_params.output_columns;
+    _reader_context.dict_code_columns = &read_params.dict_code_columns;
 
     return Status::OK();
 }
@@ -515,6 +520,41 @@ Status TabletReader::_init_conditions_param(const ReaderParams& read_params) {
     return Status::OK();
 }
 
+Status TabletReader::append_late_runtime_filters(
+        const std::vector<TCondition>& conditions,
+        const std::vector<std::pair<std::string, std::shared_ptr<BloomFilterFuncBase>>>&
+                bloom_filters,
+        const std::vector<std::pair<std::string, std::shared_ptr<HybridSetBase>>>& in_filters) {
+    for (auto& condition : conditions) {
+        TCondition tmp_cond = condition;
+        RETURN_IF_ERROR(_tablet_schema->have_column(tmp_cond.column_name));
+        const auto& column = _tablet_schema->column(tmp_cond.column_name);
+        // the pages of a value column may hold rows not aggregated yet
+        if (column.aggregation() != FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE) {
+            continue;
+        }
+        tmp_cond.__set_column_unique_id(column.unique_id());
+        ColumnPredicate* predicate =
+                parse_to_predicate(_tablet_schema, tmp_cond, _predicate_arena.get());
+        if (predicate != nullptr) {
+            _late_runtime_filter_predicates.push_back(predicate);
+        }
+    }
+    for (const auto& filter : bloom_filters) {
+        ColumnPredicate* predicate = _parse_to_predicate(filter);
+        if (predicate != nullptr) {
+            _late_runtime_filter_predicates.push_back(predicate);
+        }
+    }
+    for (const auto& filter : in_filters) {
+        ColumnPredicate* predicate = _parse_to_predicate(filter);
+        if (predicate != nullptr) {
+            _late_runtime_filter_predicates.push_back(predicate);
+        }
+    }
+    return Status::OK();
+}
+
 void TabletReader::_init_conditions_param_except_leafnode_of_andnode(
         const ReaderParams& read_params) {
     for (const auto& condition : read_params.conditions_except_leafnode_of_andnode) {
@@ -112,6 +112,8 @@ public:
         std::vector<uint32_t> return_columns;
         // output_columns only contain columns in OrderByExprs and outputExprs
         std::set<int32_t> output_columns;
+        // string columns which may be returned as dictionary codes to the aggregation
+        std::set<ColumnId> dict_code_columns;
         RuntimeProfile* profile = nullptr;
         RuntimeState* runtime_state = nullptr;
 
@@ -182,6 +184,16 @@ public:
     const OlapReaderStatistics& stats() const { return _stats; }
     OlapReaderStatistics* mutable_stats() { return &_stats; }
 
+    // Adds the predicates of the runtime filters arrived after init(). They are not evaluated
+    // on rows, which the scanner does with the filters, but let the segment iterators skip the
+    // unread pages by zone map and bloom filter. Must be called between two blocks.
+    Status append_late_runtime_filters(
+            const std::vector<TCondition>& conditions,
+            const std::vector<std::pair<std::string, std::shared_ptr<BloomFilterFuncBase>>>&
+                    bloom_filters,
+            const std::vector<std::pair<std::string, std::shared_ptr<HybridSetBase>>>&
+                    in_filters);
+
     virtual bool update_profile(RuntimeProfile* profile) { return false; }
     static Status init_reader_params_and_create_block(
             TabletSharedPtr tablet, ReaderType reader_type,
@@ -242,6 +254,7 @@ protected:
     std::vector<ColumnPredicate*> _col_predicates;
     std::vector<ColumnPredicate*> _col_preds_except_leafnode_of_andnode;
     std::vector<ColumnPredicate*> _value_col_predicates;
+    std::vector<ColumnPredicate*> _late_runtime_filter_predicates;
     DeleteHandler _delete_handler;
 
     bool _aggregation = false;
@@ -52,16 +52,40 @@ public:
     // add row id to the map
     void add(const std::vector<RowLocation>& rss_row_ids,
              const std::vector<uint32_t>& dst_segments_num_row) {
-        for (auto& item : rss_row_ids) {
-            uint32_t id = _segment_to_id_map.at(
-                    std::pair<RowsetId, uint32_t> {item.rowset_id, item.segment_id});
-            if (_cur_dst_segment_id < dst_segments_num_row.size() &&
-                _cur_dst_segment_rowid >= dst_segments_num_row[_cur_dst_segment_id]) {
-                _cur_dst_segment_id++;
-                _cur_dst_segment_rowid = 0;
+        _add(rss_row_ids, dst_segments_num_row, 0, &_cur_dst_segment_id, &_cur_dst_segment_rowid);
+    }
+
+    // When disjoint key ranges of the source rowsets are merged in parallel, each range into
+    // its own segments, the rows of each range are added by its own thread with its own
+    // position in the segments of the range. The destination segment ids are provisional
+    // until remap_key_range_segments() is called.
+    struct KeyRangePosition {
+        uint32_t segment_id = 0;
+        uint32_t rowid = 0;
+    };
+    void add_key_range(uint32_t range_id, const std::vector<RowLocation>& rss_row_ids,
+                       const std::vector<uint32_t>& dst_segments_num_row,
+                       KeyRangePosition* position) {
+        DCHECK_LT(range_id, 1U << (32 - KEY_RANGE_SEGMENT_BITS));
+        _add(rss_row_ids, dst_segments_num_row, range_id << KEY_RANGE_SEGMENT_BITS,
+             &position->segment_id, &position->rowid);
+    }
+
+    // Numbers the segments of the key ranges in the order of the ranges.
+    void remap_key_range_segments(const std::vector<uint32_t>& range_num_segments) {
+        std::vector<uint32_t> first_segment_ids(range_num_segments.size(), 0);
+        for (size_t i = 1; i < range_num_segments.size(); ++i) {
+            first_segment_ids[i] = first_segment_ids[i - 1] + range_num_segments[i - 1];
+        }
+        constexpr uint32_t segment_mask = (1U << KEY_RANGE_SEGMENT_BITS) - 1;
+        for (auto& rowid_map : _segments_rowid_map) {
+            for (auto& [dst_segment_id, dst_rowid] : rowid_map) {
+                if (dst_segment_id == UINT32_MAX && dst_rowid == UINT32_MAX) {
+                    continue;
+                }
+                dst_segment_id = first_segment_ids[dst_segment_id >> KEY_RANGE_SEGMENT_BITS] +
+                                 (dst_segment_id & segment_mask);
             }
-            _segments_rowid_map[id][item.row_id] =
-                    std::pair<uint32_t, uint32_t> {_cur_dst_segment_id, _cur_dst_segment_rowid++};
         }
     }
 
@@ -102,6 +126,28 @@ public:
     }
 
 private:
+    // the low bits of a provisional segment id of add_key_range() are the segment id in the
+    // range, and the high bits are the range id
+    static constexpr uint32_t KEY_RANGE_SEGMENT_BITS = 20;
+
+    // Called by the thread of a single key range or of the whole merge, different threads
+    // set the row ids of different source rows.
+    void _add(const std::vector<RowLocation>& rss_row_ids,
+              const std::vector<uint32_t>& dst_segments_num_row, uint32_t segment_id_base,
+              uint32_t* cur_dst_segment_id, uint32_t* cur_dst_segment_rowid) {
+        for (auto& item : rss_row_ids) {
+            uint32_t id = _segment_to_id_map.at(
+                    std::pair<RowsetId, uint32_t> {item.rowset_id, item.segment_id});
+            if (*cur_dst_segment_id < dst_segments_num_row.size() &&
+                *cur_dst_segment_rowid >= dst_segments_num_row[*cur_dst_segment_id]) {
+                (*cur_dst_segment_id)++;
+                *cur_dst_segment_rowid = 0;
+            }
+            _segments_rowid_map[id][item.row_id] = std::pair<uint32_t, uint32_t> {
+                    segment_id_base + *cur_dst_segment_id, (*cur_dst_segment_rowid)++};
+        }
+    }
+
     // the first level vector: index indicates src segment.
     // the second level vector: index indicates row id of source segment,
     // value indicates row id of destination segment.
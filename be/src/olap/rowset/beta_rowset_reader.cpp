@@ -166,11 +166,13 @@ Status BetaRowsetReader::get_segment_iterators(RowsetReaderContext* read_context
     _read_options.tablet_schema = read_context->tablet_schema;
     _read_options.record_rowids = read_context->record_rowids;
     _read_options.use_topn_opt = read_context->use_topn_opt;
+    _read_options.late_runtime_filter_predicates = read_context->late_runtime_filter_predicates;
     _read_options.read_orderby_key_reverse = read_context->read_orderby_key_reverse;
     _read_options.read_orderby_key_columns = read_context->read_orderby_key_columns;
     _read_options.io_ctx.reader_type = read_context->reader_type;
     _read_options.runtime_state = read_context->runtime_state;
     _read_options.output_columns = read_context->output_columns;
+    _read_options.dict_code_columns = read_context->dict_code_columns;
 
     // load segments
     // use cache is true when do vertica compaction
@@ -424,7 +424,8 @@ Status BetaRowsetWriter::_add_block(const vectorized::Block* block,
 
 Status BetaRowsetWriter::add_rowset(RowsetSharedPtr rowset) {
     assert(rowset->rowset_meta()->rowset_type() == BETA_ROWSET);
-    RETURN_NOT_OK(rowset->link_files_to(_context.rowset_dir, _context.rowset_id));
+    // the segments of the rowset follow the segments added before
+    RETURN_NOT_OK(rowset->link_files_to(_context.rowset_dir, _context.rowset_id, _num_segment));
     _num_rows_written += rowset->num_rows();
     _total_data_size += rowset->rowset_meta()->data_disk_size();
     _total_index_size += rowset->rowset_meta()->index_disk_size();
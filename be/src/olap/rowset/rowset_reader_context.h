@@ -57,6 +57,9 @@ struct RowsetReaderContext {
     const std::vector<ColumnPredicate*>* predicates_except_leafnode_of_andnode = nullptr;
     // value column predicate in UNIQUE table
     const std::vector<ColumnPredicate*>* value_predicates = nullptr;
+    // predicates of the runtime filters arrived after the scan started, appended to by the
+    // reader between two blocks
+    const std::vector<ColumnPredicate*>* late_runtime_filter_predicates = nullptr;
     const std::vector<RowCursor>* lower_bound_keys = nullptr;
     const std::vector<bool>* is_lower_keys_included = nullptr;
     const std::vector<RowCursor>* upper_bound_keys = nullptr;
@@ -79,6 +82,7 @@ struct RowsetReaderContext {
     bool is_vertical_compaction = false;
     bool is_key_column_group = false;
     const std::set<int32_t>* output_columns = nullptr;
+    const std::set<ColumnId>* dict_code_columns = nullptr;
 };
 
 } // namespace doris
@@ -24,6 +24,7 @@
 #include "olap/rowset/segment_v2/page_handle.h"   // for PageHandle
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/page_pointer.h" // for PagePointer
+#include "olap/rowset/segment_v2/page_prefetcher.h"
 #include "olap/types.h"                          // for TypeInfo
 #include "olap/wrapper_field.h"
 #include "util/block_compression.h"
@@ -203,29 +204,52 @@ Status ColumnReader::new_inverted_index_iterator(const TabletIndex* index_meta,
     return Status::OK();
 }
 
-Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
-                               PageHandle* handle, Slice* page_body, PageFooterPB* footer,
-                               BlockCompressionCodec* codec) const {
-    iter_opts.sanity_check();
+static PageReadOptions make_page_read_options(const ColumnIteratorOptions& iter_opts,
+                                              const ColumnReaderOptions& reader_opts,
+                                              const EncodingInfo* encoding_info,
+                                              const PagePointer& pp,
+                                              BlockCompressionCodec* codec) {
     PageReadOptions opts;
     opts.file_reader = iter_opts.file_reader;
     opts.page_pointer = pp;
     opts.codec = codec;
     opts.stats = iter_opts.stats;
-    opts.verify_checksum = _opts.verify_checksum;
+    opts.verify_checksum = reader_opts.verify_checksum;
     opts.use_page_cache = iter_opts.use_page_cache;
-    opts.kept_in_memory = _opts.kept_in_memory;
+    opts.kept_in_memory = reader_opts.kept_in_memory;
     opts.type = iter_opts.type;
-    opts.encoding_info = _encoding_info;
+    opts.encoding_info = encoding_info;
     opts.io_ctx = iter_opts.io_ctx;
     // index page should not pre decode
     if (iter_opts.type == INDEX_PAGE) {
         opts.pre_decode = false;
     }
+    return opts;
+}
 
+Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
+                               PageHandle* handle, Slice* page_body, PageFooterPB* footer,
+                               BlockCompressionCodec* codec) const {
+    iter_opts.sanity_check();
+    PageReadOptions opts = make_page_read_options(iter_opts, _opts, _encoding_info, pp, codec);
     return PageIO::read_and_decompress_page(opts, handle, page_body, footer);
 }
 
+Status ColumnReader::read_pages(const ColumnIteratorOptions& iter_opts,
+                                const std::vector<PagePointer>& pps,
+                                std::vector<PageHandle>* handles,
+                                std::vector<Slice>* page_bodies,
+                                std::vector<PageFooterPB>* footers,
+                                BlockCompressionCodec* codec) const {
+    iter_opts.sanity_check();
+    std::vector<PageReadOptions> opts;
+    opts.reserve(pps.size());
+    for (auto& pp : pps) {
+        opts.push_back(make_page_read_options(iter_opts, _opts, _encoding_info, pp, codec));
+    }
+    return PageIO::read_and_decompress_pages(opts, handles, page_bodies, footers);
+}
+
 Status ColumnReader::get_row_ranges_by_zone_map(
         const AndBlockColumnPredicate* col_predicates,
         std::vector<const ColumnPredicate*>* delete_predicates, RowRanges* row_ranges) {
@@ -378,20 +402,8 @@ Status ColumnReader::get_row_ranges_by_bloom_filter(const AndBlockColumnPredicat
     RowRanges bf_row_ranges;
     std::unique_ptr<BloomFilterIndexIterator> bf_iter;
     RETURN_IF_ERROR(_bloom_filter_index->new_iterator(&bf_iter));
-    size_t range_size = row_ranges->range_size();
-    // get covered page ids
     std::set<uint32_t> page_ids;
-    for (int i = 0; i < range_size; ++i) {
-        int64_t from = row_ranges->get_range_from(i);
-        int64_t idx = from;
-        int64_t to = row_ranges->get_range_to(i);
-        auto iter = _ordinal_index->seek_at_or_before(from);
-        while (idx < to && iter.valid()) {
-            page_ids.insert(iter.page_index());
-            idx = iter.last_ordinal() + 1;
-            iter.next();
-        }
-    }
+    _get_covered_pages(*row_ranges, &page_ids);
     for (auto& pid : page_ids) {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
@@ -404,6 +416,62 @@ Status ColumnReader::get_row_ranges_by_bloom_filter(const AndBlockColumnPredicat
     return Status::OK();
 }
 
+Status ColumnReader::prune_row_ranges(const AndBlockColumnPredicate* col_predicates,
+                                      bool use_zone_map, bool use_bloom_filter,
+                                      RowRanges* row_ranges, int64_t* num_pruned_pages) {
+    RETURN_IF_ERROR(_ensure_index_loaded());
+    std::set<uint32_t> page_ids;
+    _get_covered_pages(*row_ranges, &page_ids);
+
+    std::unique_ptr<BloomFilterIndexIterator> bf_iter;
+    if (use_bloom_filter) {
+        RETURN_IF_ERROR(_bloom_filter_index->new_iterator(&bf_iter));
+    }
+    FieldType type = _type_info->type();
+    std::unique_ptr<WrapperField> min_value(WrapperField::create_by_type(type, _meta.length()));
+    std::unique_ptr<WrapperField> max_value(WrapperField::create_by_type(type, _meta.length()));
+    RowRanges kept_row_ranges;
+    for (auto pid : page_ids) {
+        if (use_zone_map) {
+            const ZoneMapPB& zone_map = _zone_map_index->page_zone_maps()[pid];
+            if (!zone_map.pass_all()) {
+                _parse_zone_map(zone_map, min_value.get(), max_value.get());
+                if (!_zone_map_match_condition(zone_map, min_value.get(), max_value.get(),
+                                               col_predicates)) {
+                    ++*num_pruned_pages;
+                    continue;
+                }
+            }
+        }
+        if (use_bloom_filter) {
+            std::unique_ptr<BloomFilter> bf;
+            RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
+            if (!col_predicates->evaluate_and(bf.get())) {
+                ++*num_pruned_pages;
+                continue;
+            }
+        }
+        kept_row_ranges.add(RowRange(_ordinal_index->get_first_ordinal(pid),
+                                     _ordinal_index->get_last_ordinal(pid) + 1));
+    }
+    RowRanges::ranges_intersection(*row_ranges, kept_row_ranges, row_ranges);
+    return Status::OK();
+}
+
+void ColumnReader::_get_covered_pages(const RowRanges& row_ranges, std::set<uint32_t>* page_ids) {
+    for (size_t i = 0; i < row_ranges.range_size(); ++i) {
+        int64_t from = row_ranges.get_range_from(i);
+        int64_t idx = from;
+        int64_t to = row_ranges.get_range_to(i);
+        auto iter = _ordinal_index->seek_at_or_before(from);
+        while (idx < to && iter.valid()) {
+            page_ids->insert(iter.page_index());
+            idx = iter.last_ordinal() + 1;
+            iter.next();
+        }
+    }
+}
+
 Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memory) {
     DCHECK(_ordinal_index_meta != nullptr);
     _ordinal_index.reset(new OrdinalIndexReader(_file_reader, _ordinal_index_meta, _num_rows));
@@ -1081,13 +1149,28 @@ Status FileColumnIterator::_load_next_page(bool* eos) {
     return Status::OK();
 }
 
+Status FileColumnIterator::init_prefetcher(const RowRanges& row_ranges) {
+    if (!config::enable_segment_page_prefetch) {
+        return Status::OK();
+    }
+    _prefetcher = std::make_unique<PagePrefetcher>(_reader, _compress_codec);
+    return _prefetcher->init(_opts, row_ranges);
+}
+
 Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter) {
     PageHandle handle;
     Slice page_body;
     PageFooterPB footer;
     _opts.type = DATA_PAGE;
-    RETURN_IF_ERROR(
-            _reader->read_page(_opts, iter.page(), &handle, &page_body, &footer, _compress_codec));
+    bool prefetched = false;
+    if (_prefetcher != nullptr) {
+        RETURN_IF_ERROR(_prefetcher->get_page(_opts, iter.page_index(), &handle, &page_body,
+                                              &footer, &prefetched));
+    }
+    if (!prefetched) {
+        RETURN_IF_ERROR(_reader->read_page(_opts, iter.page(), &handle, &page_body, &footer,
+                                           _compress_codec));
+    }
     // parse data page
     RETURN_IF_ERROR(ParsedPage::create(std::move(handle), page_body, footer.data_page_footer(),
                                        _reader->encoding_info(), iter.page(), iter.page_index(),
@@ -1145,6 +1228,18 @@ Status FileColumnIterator::get_row_ranges_by_bloom_filter(
     return Status::OK();
 }
 
+Status FileColumnIterator::prune_row_ranges(const AndBlockColumnPredicate* col_predicates,
+                                            RowRanges* row_ranges, int64_t* num_pruned_pages) {
+    bool use_zone_map = _reader->has_zone_map();
+    bool use_bloom_filter =
+            col_predicates->can_do_bloom_filter() && _reader->has_bloom_filter_index();
+    if (use_zone_map || use_bloom_filter) {
+        RETURN_IF_ERROR(_reader->prune_row_ranges(col_predicates, use_zone_map, use_bloom_filter,
+                                                  row_ranges, num_pruned_pages));
+    }
+    return Status::OK();
+}
+
 Status DefaultValueColumnIterator::init(const ColumnIteratorOptions& opts) {
     _opts = opts;
     // be consistent with segment v1
@@ -20,6 +20,7 @@
 #include <cstddef> // for size_t
 #include <cstdint> // for uint32_t
 #include <memory>  // for unique_ptr
+#include <set>
 
 #include "bloom_filter_index_reader.h"
 #include "common/logging.h"
@@ -59,6 +60,7 @@ class PageHandle;
 struct PagePointer;
 class ColumnIterator;
 class BloomFilterIndexReader;
+class PagePrefetcher;
 
 struct ColumnReaderOptions {
     // whether verify checksum when read page
@@ -117,6 +119,11 @@ public:
                      PageHandle* handle, Slice* page_body, PageFooterPB* footer,
                      BlockCompressionCodec* codec) const;
 
+    // read several pages of this column from file with one batched read
+    Status read_pages(const ColumnIteratorOptions& iter_opts, const std::vector<PagePointer>& pps,
+                      std::vector<PageHandle>* handles, std::vector<Slice>* page_bodies,
+                      std::vector<PageFooterPB>* footers, BlockCompressionCodec* codec) const;
+
     bool is_nullable() const { return _meta.is_nullable(); }
 
     const EncodingInfo* encoding_info() const { return _encoding_info; }
@@ -143,6 +150,12 @@ public:
     Status get_row_ranges_by_bloom_filter(const AndBlockColumnPredicate* col_predicates,
                                           RowRanges* row_ranges);
 
+    // Removes from `row_ranges` the pages whose zone map or bloom filter rules out
+    // `col_predicates`, for the predicates that arrive after the row ranges are computed.
+    Status prune_row_ranges(const AndBlockColumnPredicate* col_predicates, bool use_zone_map,
+                            bool use_bloom_filter, RowRanges* row_ranges,
+                            int64_t* num_pruned_pages);
+
     PagePointer get_dict_page_pointer() const { return _meta.dict_page(); }
 
     bool is_empty() const { return _num_rows == 0; }
@@ -207,6 +220,8 @@ private:
 
     Status _calculate_row_ranges(const std::vector<uint32_t>& page_indexes, RowRanges* row_ranges);
 
+    void _get_covered_pages(const RowRanges& row_ranges, std::set<uint32_t>* page_ids);
+
 private:
     ColumnMetaPB _meta;
     ColumnReaderOptions _opts;
@@ -293,8 +308,19 @@ public:
         return Status::OK();
     }
 
+    // Called when predicates arrive in the middle of a scan, to drop the pages of the
+    // unread `row_ranges` that can not satisfy them.
+    virtual Status prune_row_ranges(const AndBlockColumnPredicate* col_predicates,
+                                    RowRanges* row_ranges, int64_t* num_pruned_pages) {
+        return Status::OK();
+    }
+
     virtual bool is_all_dict_encoding() const { return false; }
 
+    // The rows to read are limited to `row_ranges`, so the data pages covering them
+    // could be read ahead. Only called for scans in the ascending order of rows.
+    virtual Status init_prefetcher(const RowRanges& row_ranges) { return Status::OK(); }
+
 protected:
     ColumnIteratorOptions _opts;
 };
@@ -333,12 +359,17 @@ public:
     Status get_row_ranges_by_bloom_filter(const AndBlockColumnPredicate* col_predicates,
                                           RowRanges* row_ranges) override;
 
+    Status prune_row_ranges(const AndBlockColumnPredicate* col_predicates, RowRanges* row_ranges,
+                            int64_t* num_pruned_pages) override;
+
     ParsedPage* get_current_page() { return &_page; }
 
     bool is_nullable() { return _reader->is_nullable(); }
 
     bool is_all_dict_encoding() const override { return _is_all_dict_encoding; }
 
+    Status init_prefetcher(const RowRanges& row_ranges) override;
+
 private:
     void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page) const;
     Status _load_next_page(bool* eos);
@@ -371,6 +402,9 @@ private:
     bool _is_all_dict_encoding = false;
 
     std::unique_ptr<StringRef[]> _dict_word_info;
+
+    // read the data pages ahead, null if prefetching is disabled
+    std::unique_ptr<PagePrefetcher> _prefetcher;
 };
 
 class EmptyFileColumnIterator final : public ColumnIterator {
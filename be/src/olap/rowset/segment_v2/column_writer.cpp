@@ -17,6 +17,7 @@
 
 #include "olap/rowset/segment_v2/column_writer.h"
 
+#include <algorithm>
 #include <cstddef>
 
 #include "common/logging.h"
@@ -436,6 +437,8 @@ Status ScalarColumnWriter::init() {
 
     PageBuilder* page_builder = nullptr;
 
+    _need_choose_encoding =
+            _opts.choose_encoding_by_sample && _opts.meta->encoding() == DEFAULT_ENCODING;
     RETURN_IF_ERROR(
             EncodingInfo::get(get_field()->type_info(), _opts.meta->encoding(), &_encoding_info));
     _opts.meta->set_encoding(_encoding_info->encoding());
@@ -502,10 +505,32 @@ Status ScalarColumnWriter::append_nulls(size_t num_rows) {
     return Status::OK();
 }
 
+Status ScalarColumnWriter::append_nullable(const uint8_t* null_map, const uint8_t** ptr,
+                                           size_t num_rows) {
+    if (_need_choose_encoding) {
+        // sample the non-null values of the whole batch, not only of its first run
+        size_t value_size = get_field()->size();
+        std::vector<uint8_t> values;
+        for (size_t i = 0; i < num_rows && values.size() < ENCODING_SAMPLE_ROWS * value_size;
+             ++i) {
+            if (!null_map[i]) {
+                values.insert(values.end(), *ptr + i * value_size, *ptr + (i + 1) * value_size);
+            }
+        }
+        if (!values.empty()) {
+            RETURN_IF_ERROR(_choose_encoding(values.data(), values.size() / value_size));
+        }
+    }
+    return ColumnWriter::append_nullable(null_map, ptr, num_rows);
+}
+
 // append data to page builder. this function will make sure that
 // num_rows must be written before return. And ptr will be modified
 // to next data should be written
 Status ScalarColumnWriter::append_data(const uint8_t** ptr, size_t num_rows) {
+    if (_need_choose_encoding && num_rows > 0) {
+        RETURN_IF_ERROR(_choose_encoding(*ptr, num_rows));
+    }
     size_t remaining = num_rows;
     while (remaining > 0) {
         size_t num_written = remaining;
@@ -520,6 +545,53 @@ Status ScalarColumnWriter::append_data(const uint8_t** ptr, size_t num_rows) {
     return Status::OK();
 }
 
+// Monotonic columns like event timestamps and auto-increment ids are much smaller with
+// delta-of-delta encoding, but other integer columns are usually larger than with the default
+// encoding. Choose it only if the compressed sample is smaller.
+Status ScalarColumnWriter::_choose_encoding(const uint8_t* data, size_t num_rows) {
+    _need_choose_encoding = false;
+    // all the pages of a column have the same encoding
+    if (_pages.head != nullptr || _page_builder->count() > 0) {
+        return Status::OK();
+    }
+    const EncodingInfo* encoding_info = nullptr;
+    RETURN_IF_ERROR(
+            EncodingInfo::get(get_field()->type_info(), DELTA_OF_DELTA_ENCODING, &encoding_info));
+    num_rows = std::min(num_rows, ENCODING_SAMPLE_ROWS);
+    size_t default_size = 0;
+    size_t sample_size = 0;
+    RETURN_IF_ERROR(_encoded_size(_encoding_info, data, num_rows, &default_size));
+    RETURN_IF_ERROR(_encoded_size(encoding_info, data, num_rows, &sample_size));
+    if (sample_size >= default_size) {
+        return Status::OK();
+    }
+    PageBuilderOptions opts;
+    opts.data_page_size = _opts.data_page_size;
+    PageBuilder* page_builder = nullptr;
+    RETURN_IF_ERROR(encoding_info->create_page_builder(opts, &page_builder));
+    _page_builder.reset(page_builder);
+    _encoding_info = encoding_info;
+    _opts.meta->set_encoding(_encoding_info->encoding());
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::_encoded_size(const EncodingInfo* encoding_info, const uint8_t* data,
+                                         size_t num_rows, size_t* size) {
+    PageBuilderOptions opts;
+    opts.data_page_size = _opts.data_page_size;
+    PageBuilder* page_builder = nullptr;
+    RETURN_IF_ERROR(encoding_info->create_page_builder(opts, &page_builder));
+    std::unique_ptr<PageBuilder> page_builder_ptr(page_builder);
+    RETURN_IF_ERROR(page_builder->add(data, &num_rows));
+    OwnedSlice encoded_values = page_builder->finish();
+    OwnedSlice compressed_values;
+    RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving,
+                                               {encoded_values.slice()}, &compressed_values));
+    *size = compressed_values.slice().empty() ? encoded_values.slice().size
+                                              : compressed_values.slice().size;
+    return Status::OK();
+}
+
 Status ScalarColumnWriter::append_data_in_current_page(const uint8_t* data, size_t* num_written) {
     RETURN_IF_ERROR(_page_builder->add(data, num_written));
     if (_opts.need_zone_map) {
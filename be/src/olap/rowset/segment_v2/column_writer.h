@@ -50,6 +50,9 @@ struct ColumnWriterOptions {
     // space saving = 1 - compressed_size / uncompressed_size
     double compression_min_space_saving = 0.1;
     bool need_zone_map = false;
+    // If the encoding is DEFAULT_ENCODING, encode the first values appended with both the
+    // default and the delta-of-delta encoding, and write the column with the smaller one.
+    bool choose_encoding_by_sample = false;
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
     bool is_ngram_bf_index = false;
@@ -191,6 +194,7 @@ public:
     void register_flush_page_callback(FlushPageCallback* flush_page_callback) {
         _new_page_callback = flush_page_callback;
     }
+    Status append_nullable(const uint8_t* null_map, const uint8_t** ptr, size_t num_rows) override;
     Status append_data(const uint8_t** ptr, size_t num_rows) override;
 
     // used for append not null data. When page is full, will append data not reach num_rows.
@@ -207,6 +211,8 @@ private:
     ColumnWriterOptions _opts;
 
     const EncodingInfo* _encoding_info = nullptr;
+    // the encoding is chosen by the first values appended
+    bool _need_choose_encoding = false;
 
     ordinal_t _next_rowid = 0;
 
@@ -245,6 +251,12 @@ private:
 
     Status _write_data_page(Page* page);
 
+    // the max number of values encoded to choose the encoding
+    static constexpr size_t ENCODING_SAMPLE_ROWS = 1024;
+    Status _choose_encoding(const uint8_t* data, size_t num_rows);
+    Status _encoded_size(const EncodingInfo* encoding_info, const uint8_t* data, size_t num_rows,
+                         size_t* size);
+
 private:
     io::FileWriter* _file_writer = nullptr;
     // total size of data page list
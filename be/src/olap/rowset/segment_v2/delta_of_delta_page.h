@@ -0,0 +1,467 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include "olap/rowset/segment_v2/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "olap/rowset/segment_v2/page_builder.h" // for PageBuilder
+#include "olap/rowset/segment_v2/page_decoder.h" // for PageDecoder
+#include "olap/types.h"
+#include "util/bit_packing.inline.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "vec/columns/column.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// Delta-of-delta encoding for integer and date/datetime columns.
+//
+// Values are split into blocks of DELTA_OF_DELTA_BLOCK_SIZE. Each block stores its
+// first value and first delta, followed by the zigzag encoded delta-of-deltas of the
+// remaining values, bit-packed with the smallest bit width of the block. Monotonic
+// columns like event timestamps and auto-increment ids have nearly constant deltas,
+// so the delta-of-deltas need few bits (0 bits for a constant step).
+//
+// The layout of the page is:
+//
+//   NumElements(4 bytes) | BlockOffset(4 bytes) * NumBlocks | Block * NumBlocks
+//
+//   Block: FirstValue(8 bytes) | FirstDelta(zigzag varint, if count > 1) |
+//          BitWidth(1 byte) and BitPackedDeltaOfDeltas(if count > 2)
+//
+// All the arithmetic is done on uint64 and wraps around, so any value of the type
+// can be encoded. The block offsets let the decoder seek to an ordinal by decoding
+// only the block containing it.
+static constexpr size_t DELTA_OF_DELTA_BLOCK_SIZE = 128;
+
+struct DeltaOfDeltaCoding {
+    static uint64_t zigzag_encode(uint64_t v) {
+        return (v << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(v) >> 63);
+    }
+
+    static uint64_t zigzag_decode(uint64_t v) { return (v >> 1) ^ (~(v & 1) + 1); }
+
+    // Replaces `data` with its inclusive prefix sum starting from `carry`, with the
+    // elements zigzag decoded first if `ZIGZAG`.
+    template <bool ZIGZAG>
+    static void prefix_sum(uint64_t* data, size_t n, uint64_t carry) {
+        size_t i = 0;
+#ifdef __AVX2__
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi64x(1);
+        __m256i carry_vec = _mm256_set1_epi64x(carry);
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            if constexpr (ZIGZAG) {
+                x = _mm256_xor_si256(_mm256_srli_epi64(x, 1),
+                                     _mm256_sub_epi64(zero, _mm256_and_si256(x, one)));
+            }
+            // [a, b, c, d] + [0, a, b, c] + [0, 0, a, a + b]
+            x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90), zero,
+                                                       0x03));
+            x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x40), zero,
+                                                       0x0F));
+            x = _mm256_add_epi64(x, carry_vec);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), x);
+            carry_vec = _mm256_permute4x64_epi64(x, 0xFF);
+        }
+        if (i > 0) {
+            carry = data[i - 1];
+        }
+#endif
+        for (; i < n; ++i) {
+            if constexpr (ZIGZAG) {
+                carry += zigzag_decode(data[i]);
+            } else {
+                carry += data[i];
+            }
+            data[i] = carry;
+        }
+    }
+};
+
+template <FieldType Type>
+class DeltaOfDeltaPageBuilder : public PageBuilder {
+public:
+    explicit DeltaOfDeltaPageBuilder(const PageBuilderOptions& options)
+            : _options(options), _count(0), _finished(false) {
+        _block.reserve(DELTA_OF_DELTA_BLOCK_SIZE);
+    }
+
+    bool is_page_full() override { return size() >= _options.data_page_size; }
+
+    Status add(const uint8_t* vals, size_t* count) override {
+        DCHECK(!_finished);
+        if (*count == 0) {
+            return Status::OK();
+        }
+        auto new_vals = reinterpret_cast<const CppType*>(vals);
+        if (_count == 0) {
+            _first_val = *new_vals;
+        }
+        for (size_t i = 0; i < *count; ++i) {
+            _block.push_back(static_cast<uint64_t>(new_vals[i]));
+            if (_block.size() == DELTA_OF_DELTA_BLOCK_SIZE) {
+                _flush_block();
+            }
+        }
+        _count += *count;
+        _last_val = new_vals[*count - 1];
+        return Status::OK();
+    }
+
+    OwnedSlice finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        if (!_block.empty()) {
+            _flush_block();
+        }
+        faststring page;
+        page.reserve(_header_size() + _data.size());
+        put_fixed32_le(&page, _count);
+        for (uint32_t offset : _block_offsets) {
+            put_fixed32_le(&page, _header_size() + offset);
+        }
+        page.append(_data.data(), _data.size());
+        return page.build();
+    }
+
+    void reset() override {
+        _count = 0;
+        _finished = false;
+        _block.clear();
+        _block_offsets.clear();
+        _data.clear();
+    }
+
+    size_t count() const override { return _count; }
+
+    uint64_t size() const override {
+        return _header_size() + _data.size() + _block.size() * sizeof(CppType);
+    }
+
+    Status get_first_value(void* value) const override {
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_first_val, sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_last_val, sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    size_t _header_size() const {
+        size_t num_blocks = _block_offsets.size() + (_block.empty() ? 0 : 1);
+        return sizeof(uint32_t) * (1 + num_blocks);
+    }
+
+    void _flush_block() {
+        _block_offsets.push_back(_data.size());
+        size_t n = _block.size();
+        put_fixed64_le(&_data, _block[0]);
+        if (n > 1) {
+            uint64_t prev_delta = _block[1] - _block[0];
+            put_varint64(&_data, DeltaOfDeltaCoding::zigzag_encode(prev_delta));
+
+            // the zigzag delta-of-deltas replace the values in place
+            uint64_t max_value = 0;
+            for (size_t i = 2; i < n; ++i) {
+                uint64_t delta = _block[i] - _block[i - 1];
+                _block[i - 2] = DeltaOfDeltaCoding::zigzag_encode(delta - prev_delta);
+                max_value |= _block[i - 2];
+                prev_delta = delta;
+            }
+            if (n > 2) {
+                int bit_width = max_value == 0 ? 0 : 64 - __builtin_clzll(max_value);
+                _data.push_back(static_cast<uint8_t>(bit_width));
+                if (bit_width > 0) {
+                    BitWriter writer(&_packed);
+                    for (size_t i = 0; i < n - 2; ++i) {
+                        writer.PutValue(_block[i], bit_width);
+                    }
+                    writer.Flush();
+                    _data.append(_packed.data(), _packed.size());
+                }
+            }
+        }
+        _block.clear();
+    }
+
+    PageBuilderOptions _options;
+    size_t _count;
+    bool _finished;
+    // values of the block being built
+    std::vector<uint64_t> _block;
+    // offsets of the finished blocks in `_data`
+    std::vector<uint32_t> _block_offsets;
+    faststring _data;
+    faststring _packed;
+    CppType _first_val;
+    CppType _last_val;
+};
+
+template <FieldType Type>
+class DeltaOfDeltaPageDecoder : public PageDecoder {
+public:
+    DeltaOfDeltaPageDecoder(Slice slice, const PageDecoderOptions& options)
+            : _parsed(false),
+              _data(slice),
+              _num_elements(0),
+              _num_blocks(0),
+              _cur_index(0),
+              _decoded_block(-1) {}
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < sizeof(uint32_t)) {
+            return Status::Corruption("file corruption: not enough bytes for header in "
+                                      "DeltaOfDeltaPageDecoder. invalid data size:{}",
+                                      _data.size);
+        }
+        _num_elements = decode_fixed32_le((const uint8_t*)_data.data);
+        _num_blocks = (_num_elements + DELTA_OF_DELTA_BLOCK_SIZE - 1) / DELTA_OF_DELTA_BLOCK_SIZE;
+        size_t header_size = sizeof(uint32_t) * (1 + _num_blocks);
+        if (_data.size < header_size) {
+            return Status::Corruption("file corruption: not enough bytes for block offsets in "
+                                      "DeltaOfDeltaPageDecoder. num elements:{}, data size:{}",
+                                      _num_elements, _data.size);
+        }
+        for (size_t i = 0; i < _num_blocks; ++i) {
+            size_t offset = _block_offset(i);
+            if (offset < header_size || offset + sizeof(uint64_t) > _block_end(i)) {
+                return Status::Corruption("file corruption: invalid offset {} of block {} in "
+                                          "DeltaOfDeltaPageDecoder. data size:{}",
+                                          offset, i, _data.size);
+            }
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elements)
+                << "Tried to seek to " << pos << " which is > number of elements (" << _num_elements
+                << ") in the block!";
+        // If the block is empty (e.g. the column is filled with nulls), there is no data to seek.
+        if (PREDICT_FALSE(_num_elements == 0)) {
+            return Status::OK();
+        }
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (_num_elements == 0) {
+            return Status::NotFound("page is empty");
+        }
+        CppType target = *reinterpret_cast<const CppType*>(value);
+
+        // the last block whose first value < target, the values are in sorted order
+        size_t left = 0;
+        size_t right = _num_blocks;
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+            if (_block_first_value(mid) < target) {
+                left = mid + 1;
+            } else {
+                right = mid;
+            }
+        }
+        size_t block = left == 0 ? 0 : left - 1;
+        for (; block < _num_blocks; ++block) {
+            RETURN_IF_ERROR(_decode_block(block));
+            size_t block_size = _block_size(block);
+            CppType* pos = std::lower_bound(_values, _values + block_size, target);
+            if (pos != _values + block_size) {
+                *exact_match = *pos == target;
+                _cur_index = block * DELTA_OF_DELTA_BLOCK_SIZE + (pos - _values);
+                return Status::OK();
+            }
+        }
+        return Status::NotFound("all value small than the value");
+    }
+
+    template <bool forward_index = true>
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+
+        size_t max_fetch = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
+        size_t index = _cur_index;
+        size_t end = _cur_index + max_fetch;
+        while (index < end) {
+            size_t block = index / DELTA_OF_DELTA_BLOCK_SIZE;
+            RETURN_IF_ERROR(_decode_block(block));
+            size_t offset_in_block = index % DELTA_OF_DELTA_BLOCK_SIZE;
+            size_t to_copy = std::min(end - index, _block_size(block) - offset_in_block);
+            dst->insert_many_fix_len_data((const char*)(_values + offset_in_block), to_copy);
+            index += to_copy;
+        }
+        *n = max_fetch;
+        if constexpr (forward_index) {
+            _cur_index += max_fetch;
+        }
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
+        return next_batch<>(n, dst);
+    }
+
+    Status read_by_rowids(const rowid_t* rowids, ordinal_t page_first_ordinal, size_t* n,
+                          vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0)) {
+            *n = 0;
+            return Status::OK();
+        }
+
+        auto total = *n;
+        auto read_count = 0;
+        CppType data[total];
+        for (size_t i = 0; i < total; ++i) {
+            ordinal_t ord = rowids[i] - page_first_ordinal;
+            if (UNLIKELY(ord >= _num_elements)) {
+                break;
+            }
+            // rowids are in ascending order, so every block is decoded once
+            RETURN_IF_ERROR(_decode_block(ord / DELTA_OF_DELTA_BLOCK_SIZE));
+            data[read_count++] = _values[ord % DELTA_OF_DELTA_BLOCK_SIZE];
+        }
+
+        if (LIKELY(read_count > 0)) dst->insert_many_fix_len_data((const char*)data, read_count);
+
+        *n = read_count;
+        return Status::OK();
+    }
+
+    Status peek_next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
+        return next_batch<false>(n, dst);
+    }
+
+    size_t count() const override { return _num_elements; }
+
+    size_t current_index() const override { return _cur_index; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    size_t _block_offset(size_t block) const {
+        return decode_fixed32_le((const uint8_t*)_data.data + sizeof(uint32_t) * (1 + block));
+    }
+
+    size_t _block_end(size_t block) const {
+        return block + 1 == _num_blocks ? _data.size : _block_offset(block + 1);
+    }
+
+    size_t _block_size(size_t block) const {
+        return std::min(DELTA_OF_DELTA_BLOCK_SIZE,
+                        _num_elements - block * DELTA_OF_DELTA_BLOCK_SIZE);
+    }
+
+    CppType _block_first_value(size_t block) const {
+        return static_cast<CppType>(
+                decode_fixed64_le((const uint8_t*)_data.data + _block_offset(block)));
+    }
+
+    Status _decode_block(size_t block) {
+        if (_decoded_block == block) {
+            return Status::OK();
+        }
+        const uint8_t* ptr = (const uint8_t*)_data.data + _block_offset(block);
+        const uint8_t* limit = (const uint8_t*)_data.data + _block_end(block);
+        size_t n = _block_size(block);
+
+        // _buf = [first value, first delta, delta-of-deltas...]
+        _buf[0] = decode_fixed64_le(ptr);
+        ptr += sizeof(uint64_t);
+        if (n > 1) {
+            ptr = decode_varint64_ptr(ptr, limit, &_buf[1]);
+            if (ptr == nullptr) {
+                return Status::Corruption("file corruption: invalid first delta of block {} in "
+                                          "DeltaOfDeltaPageDecoder",
+                                          block);
+            }
+            _buf[1] = DeltaOfDeltaCoding::zigzag_decode(_buf[1]);
+        }
+        if (n > 2) {
+            if (ptr >= limit) {
+                return Status::Corruption("file corruption: no bit width of block {} in "
+                                          "DeltaOfDeltaPageDecoder",
+                                          block);
+            }
+            int bit_width = *ptr++;
+            if (bit_width > BitPacking::MAX_BITWIDTH) {
+                return Status::Corruption("file corruption: invalid bit width {} of block {} in "
+                                          "DeltaOfDeltaPageDecoder",
+                                          bit_width, block);
+            }
+            auto result = BitPacking::UnpackValues(bit_width, ptr, limit - ptr, n - 2, _buf + 2);
+            if (result.second != n - 2) {
+                return Status::Corruption("file corruption: not enough bytes for block {} in "
+                                          "DeltaOfDeltaPageDecoder",
+                                          block);
+            }
+            // delta-of-deltas to deltas
+            DeltaOfDeltaCoding::prefix_sum<true>(_buf + 2, n - 2, _buf[1]);
+        }
+        // deltas to values
+        DeltaOfDeltaCoding::prefix_sum<false>(_buf + 1, n - 1, _buf[0]);
+        for (size_t i = 0; i < n; ++i) {
+            _values[i] = static_cast<CppType>(_buf[i]);
+        }
+        _decoded_block = block;
+        return Status::OK();
+    }
+
+    bool _parsed;
+    Slice _data;
+    size_t _num_elements;
+    size_t _num_blocks;
+    size_t _cur_index;
+
+    // the block decoded in `_values`
+    size_t _decoded_block;
+    uint64_t _buf[DELTA_OF_DELTA_BLOCK_SIZE];
+    CppType _values[DELTA_OF_DELTA_BLOCK_SIZE];
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -100,48 +100,40 @@ Status PageIO::write_page(io::FileWriter* writer, const std::vector<Slice>& body
     return Status::OK();
 }
 
-Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
-                                        Slice* body, PageFooterPB* footer) {
-    opts.sanity_check();
-    opts.stats->total_pages_num++;
-
+// Looks up the page in the page cache, `*hit` is set to false if not found.
+static Status lookup_page_cache(const PageReadOptions& opts, PageHandle* handle, Slice* body,
+                                PageFooterPB* footer, bool* hit) {
+    *hit = false;
     auto cache = StoragePageCache::instance();
+    if (!opts.use_page_cache || !cache->is_cache_available(opts.type)) {
+        return Status::OK();
+    }
     PageCacheHandle cache_handle;
     StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
                                          opts.page_pointer.offset);
-    if (opts.use_page_cache && cache->is_cache_available(opts.type) &&
-        cache->lookup(cache_key, &cache_handle, opts.type)) {
-        // we find page in cache, use it
-        *handle = PageHandle(std::move(cache_handle));
-        opts.stats->cached_pages_num++;
-        // parse body and footer
-        Slice page_slice = handle->data();
-        uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
-        std::string footer_buf(page_slice.data + page_slice.size - 4 - footer_size, footer_size);
-        if (!footer->ParseFromString(footer_buf)) {
-            return Status::Corruption("Bad page: invalid footer");
-        }
-        *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
+    if (!cache->lookup(cache_key, &cache_handle, opts.type)) {
         return Status::OK();
     }
-
-    // every page contains 4 bytes footer length and 4 bytes checksum
-    const uint32_t page_size = opts.page_pointer.size;
-    if (page_size < 8) {
-        return Status::Corruption("Bad page: too small size ({})", page_size);
+    // we find page in cache, use it
+    *hit = true;
+    *handle = PageHandle(std::move(cache_handle));
+    opts.stats->cached_pages_num++;
+    // parse body and footer
+    Slice page_slice = handle->data();
+    uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
+    std::string footer_buf(page_slice.data + page_slice.size - 4 - footer_size, footer_size);
+    if (!footer->ParseFromString(footer_buf)) {
+        return Status::Corruption("Bad page: invalid footer");
     }
+    *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
+    return Status::OK();
+}
 
-    // hold compressed page at first, reset to decompressed page later
-    std::unique_ptr<char[]> page(new char[page_size]);
-    Slice page_slice(page.get(), page_size);
-    {
-        SCOPED_RAW_TIMER(&opts.stats->io_ns);
-        size_t bytes_read = 0;
-        RETURN_IF_ERROR(opts.file_reader->read_at(opts.page_pointer.offset, page_slice, &bytes_read,
-                                                  &opts.io_ctx));
-        DCHECK_EQ(bytes_read, page_size);
-        opts.stats->compressed_bytes_read += page_size;
-    }
+// Verifies, decompresses and pre-decodes the raw `page` read from file, then inserts it
+// into the page cache if needed.
+static Status decode_page(const PageReadOptions& opts, std::unique_ptr<char[]> page,
+                          PageHandle* handle, Slice* body, PageFooterPB* footer) {
+    Slice page_slice(page.get(), opts.page_pointer.size);
 
     if (opts.verify_checksum) {
         uint32_t expect = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
@@ -199,8 +191,12 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     }
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
+    auto cache = StoragePageCache::instance();
     if (opts.use_page_cache && cache->is_cache_available(opts.type)) {
         // insert this page into cache and return the cache handle
+        PageCacheHandle cache_handle;
+        StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
+                                             opts.page_pointer.offset);
         cache->insert(cache_key, page_slice, &cache_handle, opts.type, opts.kept_in_memory);
         *handle = PageHandle(std::move(cache_handle));
     } else {
@@ -210,5 +206,91 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     return Status::OK();
 }
 
+Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
+                                        Slice* body, PageFooterPB* footer) {
+    opts.sanity_check();
+    opts.stats->total_pages_num++;
+
+    bool hit = false;
+    RETURN_IF_ERROR(lookup_page_cache(opts, handle, body, footer, &hit));
+    if (hit) {
+        return Status::OK();
+    }
+
+    // every page contains 4 bytes footer length and 4 bytes checksum
+    const uint32_t page_size = opts.page_pointer.size;
+    if (page_size < 8) {
+        return Status::Corruption("Bad page: too small size ({})", page_size);
+    }
+
+    // hold compressed page at first, reset to decompressed page later
+    std::unique_ptr<char[]> page(new char[page_size]);
+    Slice page_slice(page.get(), page_size);
+    {
+        SCOPED_RAW_TIMER(&opts.stats->io_ns);
+        size_t bytes_read = 0;
+        RETURN_IF_ERROR(opts.file_reader->read_at(opts.page_pointer.offset, page_slice, &bytes_read,
+                                                  &opts.io_ctx));
+        DCHECK_EQ(bytes_read, page_size);
+        opts.stats->compressed_bytes_read += page_size;
+    }
+    return decode_page(opts, std::move(page), handle, body, footer);
+}
+
+Status PageIO::read_and_decompress_pages(const std::vector<PageReadOptions>& opts,
+                                         std::vector<PageHandle>* handles,
+                                         std::vector<Slice>* bodies,
+                                         std::vector<PageFooterPB>* footers) {
+    handles->resize(opts.size());
+    bodies->resize(opts.size());
+    footers->resize(opts.size());
+    if (opts.empty()) {
+        return Status::OK();
+    }
+
+    // pages missed in the page cache, read them with one batch
+    std::vector<size_t> missed;
+    std::vector<std::unique_ptr<char[]>> pages;
+    std::vector<io::ReadRequest> requests;
+    for (size_t i = 0; i < opts.size(); ++i) {
+        opts[i].sanity_check();
+        DCHECK_EQ(opts[i].file_reader, opts[0].file_reader);
+        opts[i].stats->total_pages_num++;
+
+        bool hit = false;
+        RETURN_IF_ERROR(
+                lookup_page_cache(opts[i], &(*handles)[i], &(*bodies)[i], &(*footers)[i], &hit));
+        if (hit) {
+            continue;
+        }
+        const uint32_t page_size = opts[i].page_pointer.size;
+        if (page_size < 8) {
+            return Status::Corruption("Bad page: too small size ({})", page_size);
+        }
+        missed.push_back(i);
+        pages.emplace_back(new char[page_size]);
+        io::ReadRequest request;
+        request.offset = opts[i].page_pointer.offset;
+        request.result = Slice(pages.back().get(), page_size);
+        requests.push_back(request);
+    }
+    if (missed.empty()) {
+        return Status::OK();
+    }
+
+    {
+        SCOPED_RAW_TIMER(&opts[0].stats->io_ns);
+        RETURN_IF_ERROR(opts[0].file_reader->read_batch_at(&requests, &opts[0].io_ctx));
+    }
+    for (size_t k = 0; k < missed.size(); ++k) {
+        size_t i = missed[k];
+        DCHECK_EQ(requests[k].bytes_read, opts[i].page_pointer.size);
+        opts[i].stats->compressed_bytes_read += opts[i].page_pointer.size;
+        RETURN_IF_ERROR(decode_page(opts[i], std::move(pages[k]), &(*handles)[i], &(*bodies)[i],
+                                    &(*footers)[i]));
+    }
+    return Status::OK();
+}
+
 } // namespace segment_v2
 } // namespace doris
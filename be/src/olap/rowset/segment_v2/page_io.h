@@ -121,6 +121,14 @@ public:
     //     `footer' stores the page footer.
     static Status read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
                                            Slice* body, PageFooterPB* footer);
+
+    // Same as read_and_decompress_page() for several pages of the same file. Pages
+    // missed in the page cache are read with one FileReader::read_batch_at(), so that
+    // the reads could be issued together.
+    static Status read_and_decompress_pages(const std::vector<PageReadOptions>& opts,
+                                            std::vector<PageHandle>* handles,
+                                            std::vector<Slice>* bodies,
+                                            std::vector<PageFooterPB>* footers);
 };
 
 } // namespace segment_v2
@@ -0,0 +1,202 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/page_prefetcher.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "runtime/thread_context.h"
+#include "util/stopwatch.hpp"
+#include "util/threadpool.h"
+
+namespace doris {
+namespace segment_v2 {
+
+PagePrefetcher::~PagePrefetcher() {
+    if (_token != nullptr) {
+        _token->shutdown();
+    }
+}
+
+Status PagePrefetcher::init(const ColumnIteratorOptions& opts, const RowRanges& row_ranges) {
+    if (_token != nullptr) {
+        _token->wait();
+    }
+    _page_indexes.clear();
+    _page_pointers.clear();
+    _prefetched_pages.clear();
+    _next_pos = 0;
+    _ready_pos = 0;
+    _wasted_pages = 0;
+    _depth = 1;
+
+    RowRanges ranges = row_ranges;
+    for (size_t i = 0; i < ranges.range_size(); ++i) {
+        OrdinalPageIndexIterator iter;
+        RETURN_IF_ERROR(_reader->seek_at_or_before(ranges.get_range_from(i), &iter));
+        for (; iter.valid() && iter.first_ordinal() < ranges.get_range_to(i); iter.next()) {
+            // adjacent ranges may share the same page
+            if (!_page_indexes.empty() && _page_indexes.back() >= iter.page_index()) {
+                continue;
+            }
+            _page_indexes.push_back(iter.page_index());
+            _page_pointers.push_back(iter.page());
+        }
+    }
+
+    _opts = opts;
+    _opts.type = DATA_PAGE;
+    // the statistics of the reads are collected by get_page() on the scanner thread
+    _opts.stats = nullptr;
+    _opts.io_ctx.file_cache_stats = nullptr;
+    _mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+    // a single page is read by the iterator, there is nothing to read ahead
+    ThreadPool* pool = ExecEnv::GetInstance()->segment_prefetch_thread_pool();
+    if (_page_indexes.size() > 1 && _token == nullptr && pool != nullptr) {
+        _token = pool->new_token(ThreadPool::ExecutionMode::SERIAL);
+    }
+    return Status::OK();
+}
+
+Status PagePrefetcher::get_page(const ColumnIteratorOptions& opts, int32_t page_index,
+                                PageHandle* handle, Slice* body, PageFooterPB* footer,
+                                bool* found) {
+    *found = false;
+    if (_token == nullptr) {
+        return Status::OK();
+    }
+    auto it = std::lower_bound(_page_indexes.begin(), _page_indexes.end(), page_index);
+    if (it == _page_indexes.end() || *it != page_index) {
+        // a page out of the row ranges
+        return Status::OK();
+    }
+    size_t pos = it - _page_indexes.begin();
+    if (pos >= _next_pos) {
+        // the first page, or the iterator seeks beyond the pages read ahead
+        _next_pos = pos;
+        _submit(pos);
+    }
+
+    bool waited = false;
+    {
+        std::unique_lock<std::mutex> l(_lock);
+        if (_ready_pos <= pos) {
+            waited = true;
+            SCOPED_RAW_TIMER(&opts.stats->prefetch_wait_ns);
+            _page_ready.wait(l, [&] { return _ready_pos > pos; });
+        }
+        // the iterator has skipped these pages
+        while (!_prefetched_pages.empty() && _prefetched_pages.front().page_index < page_index) {
+            _prefetched_pages.pop_front();
+            _wasted_pages++;
+            opts.stats->prefetch_wasted_pages_num++;
+        }
+        // not found if the read failed, or the iterator seeks backward
+        if (!_prefetched_pages.empty() && _prefetched_pages.front().page_index == page_index) {
+            auto& page = _prefetched_pages.front();
+            *handle = std::move(page.handle);
+            *body = page.body;
+            *footer = std::move(page.footer);
+            _prefetched_pages.pop_front();
+            *found = true;
+        }
+        _collect_statistics(opts.stats);
+    }
+
+    _adjust_depth(waited && pos > 0);
+    // keep at least half of the depth read ahead, so the reads are not submitted one by one
+    if (_next_pos <= pos + std::max<size_t>(_depth / 2, 1)) {
+        _submit(pos);
+    }
+    return Status::OK();
+}
+
+void PagePrefetcher::_submit(size_t pos) {
+    size_t begin = std::max(_next_pos, pos);
+    size_t end = std::min(pos + 1 + _depth, _page_indexes.size());
+    if (begin >= end) {
+        return;
+    }
+    Status st = _token->submit_func([this, begin, end] { _read_pages(begin, end); });
+    if (!st.ok()) {
+        // the iterator reads the pages by itself
+        LOG(WARNING) << "failed to submit the page prefetch, " << st;
+        std::lock_guard<std::mutex> l(_lock);
+        _ready_pos = std::max(_ready_pos, end);
+        _page_ready.notify_all();
+    }
+    _next_pos = end;
+}
+
+void PagePrefetcher::_read_pages(size_t begin, size_t end) {
+    SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(_mem_tracker);
+    OlapReaderStatistics stats;
+    ColumnIteratorOptions opts = _opts;
+    opts.stats = &stats;
+    std::vector<PagePointer> pointers(_page_pointers.begin() + begin,
+                                      _page_pointers.begin() + end);
+    std::vector<PageHandle> handles;
+    std::vector<Slice> bodies;
+    std::vector<PageFooterPB> footers;
+    // the iterator reads the pages by itself if this fails, and gets the error
+    Status st = _reader->read_pages(opts, pointers, &handles, &bodies, &footers, _codec);
+
+    std::lock_guard<std::mutex> l(_lock);
+    if (st.ok()) {
+        for (size_t i = 0; i < pointers.size(); ++i) {
+            _prefetched_pages.push_back({_page_indexes[begin + i], std::move(handles[i]),
+                                         bodies[i], std::move(footers[i])});
+        }
+        _read_stats.prefetched_pages_num += pointers.size();
+    }
+    _read_stats.total_pages_num += stats.total_pages_num;
+    _read_stats.cached_pages_num += stats.cached_pages_num;
+    _read_stats.io_ns += stats.io_ns;
+    _read_stats.compressed_bytes_read += stats.compressed_bytes_read;
+    _read_stats.decompress_ns += stats.decompress_ns;
+    _read_stats.uncompressed_bytes_read += stats.uncompressed_bytes_read;
+    _ready_pos = std::max(_ready_pos, end);
+    _page_ready.notify_all();
+}
+
+void PagePrefetcher::_collect_statistics(OlapReaderStatistics* stats) {
+    stats->prefetched_pages_num += _read_stats.prefetched_pages_num;
+    stats->total_pages_num += _read_stats.total_pages_num;
+    stats->cached_pages_num += _read_stats.cached_pages_num;
+    stats->io_ns += _read_stats.io_ns;
+    stats->compressed_bytes_read += _read_stats.compressed_bytes_read;
+    stats->decompress_ns += _read_stats.decompress_ns;
+    stats->uncompressed_bytes_read += _read_stats.uncompressed_bytes_read;
+    _read_stats = OlapReaderStatistics();
+}
+
+void PagePrefetcher::_adjust_depth(bool waited) {
+    size_t max_depth = std::max(config::segment_page_prefetch_max_depth, 1);
+    if (_wasted_pages > 0) {
+        // read ahead less if the pages are skipped
+        _depth = std::max<size_t>(_depth / 2, 1);
+        _wasted_pages = 0;
+    } else if (waited) {
+        // the reads are not far enough ahead of the iterator
+        _depth = std::min(_depth * 2, max_depth);
+    }
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/macros.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/column_reader.h"
+#include "olap/rowset/segment_v2/page_handle.h"
+#include "olap/rowset/segment_v2/page_pointer.h"
+#include "olap/rowset/segment_v2/row_ranges.h"
+#include "util/slice.h"
+
+namespace doris {
+
+class BlockCompressionCodec;
+class MemTrackerLimiter;
+class ThreadPoolToken;
+
+namespace segment_v2 {
+
+// Reads the data pages of one column ahead of the FileColumnIterator.
+//
+// The pages covering the row ranges of the scan are known after the indexes are
+// applied. When the iterator reads one of them, the prefetcher submits the reads of
+// the next `depth` pages to the SegmentPrefetchThreadPool, so the I/O of the following
+// pages overlaps with the decoding of the current ones. The pages are read by
+// PageIO::read_and_decompress_pages() as the iterator would read them, so they are put
+// into the StoragePageCache, and the reads of a batch are issued together by the readers
+// which can do that (see `FileReader::read_batch_at()`). This works for any file reader,
+// including the remote and the cached remote readers. The read pages are handed over to
+// the iterator, which waits for a page whose read is still in flight instead of reading it
+// a second time.
+//
+// The depth adapts to the scan: it doubles when the iterator had to wait for a page, so
+// the reads are not far enough ahead, and halves when the prefetched pages are skipped.
+class PagePrefetcher {
+public:
+    PagePrefetcher(ColumnReader* reader, BlockCompressionCodec* codec)
+            : _reader(reader), _codec(codec) {}
+
+    // Waits for the read in flight, if any.
+    ~PagePrefetcher();
+
+    DISALLOW_COPY_AND_ASSIGN(PagePrefetcher);
+
+    // Collects the pages to read from `row_ranges` by the ordinal index of the column.
+    Status init(const ColumnIteratorOptions& opts, const RowRanges& row_ranges);
+
+    // If the page at `page_index` is one of the pages to read, returns it in `handle`,
+    // `body` and `footer`, and submits the reads of the following pages if needed.
+    // Otherwise `*found` is set to false and the caller should read the page by itself.
+    Status get_page(const ColumnIteratorOptions& opts, int32_t page_index, PageHandle* handle,
+                    Slice* body, PageFooterPB* footer, bool* found);
+
+    size_t depth() const { return _depth; }
+
+private:
+    // Submits the reads of the pages from `_next_pos` on, until `depth` pages are read ahead
+    // of `pos`.
+    void _submit(size_t pos);
+
+    // Runs in the thread pool.
+    void _read_pages(size_t begin, size_t end);
+
+    void _adjust_depth(bool waited);
+
+    // Adds the statistics of the reads done in the thread pool to `stats`.
+    void _collect_statistics(OlapReaderStatistics* stats);
+
+    struct PrefetchedPage {
+        int32_t page_index;
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+    };
+
+    ColumnReader* _reader;
+    BlockCompressionCodec* _codec;
+    // options of the reads in the thread pool, with their own statistics
+    ColumnIteratorOptions _opts;
+    // the reads are counted in the memory of the query
+    std::shared_ptr<MemTrackerLimiter> _mem_tracker;
+    std::unique_ptr<ThreadPoolToken> _token;
+
+    // pages to read in the order of the scan
+    std::vector<int32_t> _page_indexes;
+    std::vector<PagePointer> _page_pointers;
+    // position in `_page_indexes` of the next page to submit
+    size_t _next_pos = 0;
+
+    // protects all the members below, which are shared with the reads in the thread pool
+    std::mutex _lock;
+    std::condition_variable _page_ready;
+    // the pages of the finished reads which are not taken by the iterator yet
+    std::deque<PrefetchedPage> _prefetched_pages;
+    // the reads of the pages before this position are finished
+    size_t _ready_pos = 0;
+    OlapReaderStatistics _read_stats;
+
+    // prefetched pages skipped by the iterator since the depth was adjusted
+    size_t _wasted_pages = 0;
+    size_t _depth = 1;
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -17,6 +17,7 @@
 
 #include "olap/rowset/segment_v2/segment_iterator.h"
 
+#include <limits>
 #include <memory>
 #include <set>
 #include <utility>
@@ -34,6 +35,7 @@
 #include "util/simd/bits.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
+#include "vec/columns/column_dict_codes.h"
 #include "vec/data_types/data_type_factory.hpp"
 #include "vec/data_types/data_type_number.h"
 #include "vec/exprs/vliteral.h"
@@ -240,11 +242,80 @@ Status SegmentIterator::_init() {
     if (_opts.read_orderby_key_reverse) {
         _range_iter.reset(new BackwardBitmapRangeIterator(_row_bitmap));
     } else {
+        RETURN_IF_ERROR(_init_page_prefetchers());
         _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
     }
     return Status::OK();
 }
 
+// The rows to read are known after all the indexes are applied, let the column
+// iterators read the data pages covering them ahead.
+Status SegmentIterator::_init_page_prefetchers() {
+    if (!config::enable_segment_page_prefetch || _row_bitmap.isEmpty()) {
+        return Status::OK();
+    }
+    RowRanges row_ranges;
+    BitmapRangeIterator range_iter(_row_bitmap);
+    uint32_t from = 0;
+    uint32_t to = 0;
+    while (range_iter.next_range(std::numeric_limits<uint32_t>::max(), &from, &to)) {
+        row_ranges.add(RowRange(from, to));
+    }
+    for (auto& [unique_id, iter] : _column_iterators) {
+        RETURN_IF_ERROR(iter->init_prefetcher(row_ranges));
+    }
+    return Status::OK();
+}
+
+// Runtime filters arriving after _init() are evaluated row by row by the scanner, here
+// their predicates also skip the unread pages that can not pass them.
+Status SegmentIterator::_apply_late_runtime_filters() {
+    const auto& predicates = *_opts.late_runtime_filter_predicates;
+    if (_opts.read_orderby_key_reverse) {
+        _num_late_runtime_filters = predicates.size();
+        return Status::OK();
+    }
+    std::vector<ColumnPredicate*> new_predicates(predicates.begin() + _num_late_runtime_filters,
+                                                 predicates.end());
+    _num_late_runtime_filters = predicates.size();
+
+    roaring::Roaring unread;
+    unread.addRange(_range_iter_rowid, num_rows());
+    unread &= _row_bitmap;
+    if (unread.isEmpty()) {
+        return Status::OK();
+    }
+    RowRanges row_ranges;
+    BitmapRangeIterator range_iter(unread);
+    uint32_t from = 0;
+    uint32_t to = 0;
+    while (range_iter.next_range(std::numeric_limits<uint32_t>::max(), &from, &to)) {
+        row_ranges.add(RowRange(from, to));
+    }
+    // one predicate at a time, a bloom filter predicate does not stop a min/max one of the same
+    // column from using the zone map
+    for (auto pred : new_predicates) {
+        auto iter = _column_iterators.find(_schema.unique_id(pred->column_id()));
+        if (iter == _column_iterators.end()) {
+            continue;
+        }
+        AndBlockColumnPredicate and_predicate;
+        and_predicate.add_column_predicate(new SingleColumnBlockPredicate(pred));
+        RETURN_IF_ERROR(iter->second->prune_row_ranges(&and_predicate, &row_ranges,
+                                                       &_opts.stats->late_rf_pages_filtered));
+    }
+    if (row_ranges.count() == unread.cardinality()) {
+        return Status::OK();
+    }
+
+    _opts.stats->rows_late_rf_filtered += unread.cardinality() - row_ranges.count();
+    // the rows buffered in `_range_iter` are all unread, so it restarts from the unread rows
+    _row_bitmap = RowRanges::ranges_to_roaring(row_ranges);
+    _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
+    RETURN_IF_ERROR(_init_page_prefetchers());
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_keys() {
     DorisMetrics::instance()->segment_row_total->increment(num_rows());
 
@@ -1357,6 +1428,25 @@ void SegmentIterator::_vec_init_char_column_id() {
     }
 }
 
+// Asked by the aggregation above the scan, the non-predicate string columns which are
+// dictionary encoded on all the pages of the segment are returned as the codes of the
+// dictionary. See ColumnDictCodes.
+void SegmentIterator::_init_dict_code_columns() {
+    _is_dict_code_column.resize(_schema.columns().size(), false);
+    if (_opts.dict_code_columns == nullptr || !config::enable_low_cardinality_optimize) {
+        return;
+    }
+    for (auto cid : _non_predicate_columns) {
+        auto type = _schema.column(cid)->type();
+        if (_is_pred_column[cid] || _opts.dict_code_columns->count(cid) == 0 ||
+            (type != OLAP_FIELD_TYPE_VARCHAR && type != OLAP_FIELD_TYPE_STRING)) {
+            continue;
+        }
+        _is_dict_code_column[cid] =
+                _column_iterators[_schema.unique_id(cid)]->is_all_dict_encoding();
+    }
+}
+
 bool SegmentIterator::_prune_column(ColumnId cid, vectorized::MutableColumnPtr& column,
                                     bool fill_defaults, size_t num_of_defaults) {
     if (_need_read_data(cid)) {
@@ -1408,6 +1498,33 @@ void SegmentIterator::_init_current_block(
         } else { // non-predicate column
             current_columns[cid] = std::move(*block->get_by_position(i).column).mutate();
 
+            // the block may be returned by other segments, with or without dictionary codes
+            auto* nested_column = current_columns[cid].get();
+            if (nested_column->is_nullable()) {
+                nested_column = &assert_cast<vectorized::ColumnNullable*>(nested_column)
+                                         ->get_nested_column();
+            }
+            bool is_dict_codes =
+                    vectorized::check_and_get_column<vectorized::ColumnDictCodes>(
+                            *nested_column) != nullptr;
+            if (is_dict_codes != _is_dict_code_column[cid]) {
+                vectorized::MutableColumnPtr column;
+                if (is_dict_codes) {
+                    column = Schema::get_data_type_ptr(*column_desc)->create_column();
+                } else {
+                    column = vectorized::ColumnDictCodes::create();
+                    if (current_columns[cid]->is_nullable()) {
+                        column = vectorized::ColumnNullable::create(
+                                std::move(column), vectorized::ColumnUInt8::create());
+                    }
+                }
+                current_columns[cid] = std::move(column);
+            }
+            if (_is_dict_code_column[cid]) {
+                current_columns[cid]->set_rowset_segment_id(
+                        {_segment->rowset_id(), _segment->id()});
+            }
+
             if (column_desc->type() == OLAP_FIELD_TYPE_DATE) {
                 current_columns[cid]->set_date_type();
             } else if (column_desc->type() == OLAP_FIELD_TYPE_DATETIME) {
@@ -1443,6 +1560,7 @@ Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32
         if (!has_next_range) {
             break;
         }
+        _range_iter_rowid = range_to;
         if (_cur_rowid == 0 || _cur_rowid != range_from) {
             _cur_rowid = range_from;
             _opts.stats->block_first_read_seek_num += 1;
@@ -1616,6 +1734,7 @@ Status SegmentIterator::_next_batch_internal(vectorized::Block* block) {
     SCOPED_RAW_TIMER(&_opts.stats->block_load_ns);
     if (UNLIKELY(!_inited)) {
         RETURN_IF_ERROR(_init());
+        _init_dict_code_columns();
         _inited = true;
         if (_lazy_materialization_read || _opts.record_rowids || _is_need_expr_eval) {
             _block_rowids.resize(_opts.block_row_max);
@@ -1643,6 +1762,10 @@ Status SegmentIterator::_next_batch_internal(vectorized::Block* block) {
             }
         }
     }
+    if (_opts.late_runtime_filter_predicates != nullptr &&
+        _num_late_runtime_filters < _opts.late_runtime_filter_predicates->size()) {
+        RETURN_IF_ERROR(_apply_late_runtime_filters());
+    }
 
     _init_current_block(block, _current_return_columns);
 
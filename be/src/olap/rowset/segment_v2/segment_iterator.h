@@ -134,6 +134,7 @@ private:
 
     [[nodiscard]] Status _init_return_column_iterators();
     [[nodiscard]] Status _init_bitmap_index_iterators();
+    [[nodiscard]] Status _init_page_prefetchers();
     [[nodiscard]] Status _init_inverted_index_iterators();
 
     // calculate row ranges that fall into requested key ranges using short key index
@@ -152,6 +153,8 @@ private:
     // calculate row ranges that satisfy requested column conditions using various column index
     [[nodiscard]] Status _get_row_ranges_by_column_conditions();
     [[nodiscard]] Status _get_row_ranges_from_conditions(RowRanges* condition_row_ranges);
+    // prune the unread rows by the runtime filters arrived after _init()
+    [[nodiscard]] Status _apply_late_runtime_filters();
     [[nodiscard]] Status _apply_bitmap_index();
     [[nodiscard]] Status _apply_inverted_index();
     [[nodiscard]] Status _apply_inverted_index_on_column_predicate(
@@ -178,6 +181,7 @@ private:
     // CHAR type in storage layer padding the 0 in length. But query engine need ignore the padding 0.
     // so segment iterator need to shrink char column before output it. only use in vec query engine.
     void _vec_init_char_column_id();
+    void _init_dict_code_columns();
 
     uint32_t segment_id() const { return _segment->id(); }
     uint32_t num_rows() const { return _segment->num_rows(); }
@@ -322,6 +326,10 @@ private:
     std::unique_ptr<BitmapRangeIterator> _range_iter;
     // the next rowid to read
     rowid_t _cur_rowid;
+    // the rows before it have been returned by `_range_iter`
+    rowid_t _range_iter_rowid = 0;
+    // the number of _opts.late_runtime_filter_predicates already applied
+    size_t _num_late_runtime_filters = 0;
     // members related to lazy materialization read
     // --------------------------------------------
     // whether lazy materialization read should be used.
@@ -342,6 +350,8 @@ private:
     std::vector<ColumnId>
             _short_cir_pred_column_ids; // keep columnId of columns for short circuit predicate evaluation
     std::vector<bool> _is_pred_column; // columns hold by segmentIter
+    // non-predicate columns returned as ColumnDictCodes
+    std::vector<bool> _is_dict_code_column;
     std::map<uint32_t, bool> _need_read_data_indices;
     std::vector<bool> _is_common_expr_column;
     vectorized::MutableColumns _current_return_columns;
@@ -89,6 +89,21 @@ void SegmentWriter::init_column_meta(ColumnMetaPB* meta, uint32_t column_id,
     }
 }
 
+bool SegmentWriter::_has_delta_of_delta_encoding(const TabletColumn& column) {
+    switch (column.type()) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_DATEV2:
+    case OLAP_FIELD_TYPE_DATETIMEV2:
+        return true;
+    default:
+        return false;
+    }
+}
+
 Status SegmentWriter::init(const vectorized::Block* block) {
     std::vector<uint32_t> column_ids;
     int column_cnt = _tablet_schema->num_columns();
@@ -123,6 +138,8 @@ Status SegmentWriter::init(const std::vector<uint32_t>& col_ids, bool has_key,
         opts.meta = _footer.add_columns();
 
         init_column_meta(opts.meta, cid, column, _tablet_schema);
+        opts.choose_encoding_by_sample =
+                config::enable_delta_of_delta_encoding && _has_delta_of_delta_encoding(column);
 
         // now we create zone map for key columns in AGG_KEYS or all column in UNIQUE_KEYS or DUP_KEYS
         // and not support zone map for array type and jsonb type.
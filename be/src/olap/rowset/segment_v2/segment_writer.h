@@ -144,6 +144,7 @@ private:
     void set_min_key(const Slice& key);
     void set_max_key(const Slice& key);
     bool _should_create_writers_with_dynamic_block(size_t num_columns_in_block);
+    static bool _has_delta_of_delta_encoding(const TabletColumn& column);
 
 private:
     uint32_t _segment_id;
@@ -25,15 +25,15 @@ namespace doris {
 
 SegmentLoader* SegmentLoader::_s_instance = nullptr;
 
-void SegmentLoader::create_global_instance(size_t capacity) {
+void SegmentLoader::create_global_instance(size_t capacity, CacheAdmissionPolicy policy) {
     DCHECK(_s_instance == nullptr);
-    static SegmentLoader instance(capacity);
+    static SegmentLoader instance(capacity, policy);
     _s_instance = &instance;
 }
 
-SegmentLoader::SegmentLoader(size_t capacity) {
-    _cache = std::unique_ptr<Cache>(
-            new_lru_cache("SegmentMetaCache", capacity, LRUCacheType::NUMBER));
+SegmentLoader::SegmentLoader(size_t capacity, CacheAdmissionPolicy policy) {
+    _cache = std::unique_ptr<Cache>(new_lru_cache("SegmentMetaCache", capacity,
+                                                  LRUCacheType::NUMBER, 16, policy));
 }
 
 bool SegmentLoader::_lookup(const SegmentLoader::CacheKey& key, SegmentCacheHandle* handle) {
@@ -72,13 +72,14 @@ public:
     // This is because currently we cannot accurately estimate the memory occupied by a segment.
     // After the estimation of segment memory usage is provided later, it is recommended
     // to use Memory as the capacity limit of the cache.
-    static void create_global_instance(size_t capacity);
+    static void create_global_instance(size_t capacity,
+                                       CacheAdmissionPolicy policy = CacheAdmissionPolicy::LRU);
 
     // Return global instance.
     // Client should call create_global_cache before.
     static SegmentLoader* instance() { return _s_instance; }
 
-    SegmentLoader(size_t capacity);
+    SegmentLoader(size_t capacity, CacheAdmissionPolicy policy = CacheAdmissionPolicy::LRU);
 
     // Load segments of "rowset", return the "cache_handle" which contains segments.
     // If use_cache is true, it will be loaded from _cache.
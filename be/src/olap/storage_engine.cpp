@@ -136,6 +136,9 @@ StorageEngine::~StorageEngine() {
     if (_seg_compaction_thread_pool) {
         _seg_compaction_thread_pool->shutdown();
     }
+    if (_compaction_key_range_thread_pool) {
+        _compaction_key_range_thread_pool->shutdown();
+    }
     if (_tablet_meta_checkpoint_thread_pool) {
         _tablet_meta_checkpoint_thread_pool->shutdown();
     }
@@ -191,6 +191,10 @@ public:
     }
     bool stopped() { return _stopped; }
     ThreadPool* get_bg_multiget_threadpool() { return _bg_multi_get_thread_pool.get(); }
+    // the pool to merge the key ranges of a compaction in parallel
+    ThreadPool* compaction_key_range_thread_pool() {
+        return _compaction_key_range_thread_pool.get();
+    }
 
 private:
     // Instance should be inited from `static open()`
@@ -371,6 +375,7 @@ private:
     std::unique_ptr<ThreadPool> _cumu_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _seg_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _cold_data_compaction_thread_pool;
+    std::unique_ptr<ThreadPool> _compaction_key_range_thread_pool;
 
     std::unique_ptr<ThreadPool> _tablet_publish_txn_thread_pool;
 
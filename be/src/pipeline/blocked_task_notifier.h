@@ -0,0 +1,29 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace doris::pipeline {
+
+// Tells the blocked task schedulers that some blocked pipeline tasks may be ready to run,
+// because the state behind can_read(), can_write() or is_pending_finish() of an operator
+// changed, e.g. an exchange received a block or an RPC of a sink buffer finished. It only
+// takes a lock when some scheduler waits for such a change, so it is cheap to call from the
+// RPC, scanner and spill I/O threads which change the state. Defined in task_scheduler.cpp.
+void notify_blocked_tasks();
+
+} // namespace doris::pipeline
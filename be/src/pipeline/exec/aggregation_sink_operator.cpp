@@ -23,4 +23,8 @@ namespace doris::pipeline {
 
 OPERATOR_CODE_GENERATOR(AggSinkOperator, StreamingOperator)
 
+bool AggSinkOperator::can_write() {
+    return _node->can_sink_write();
+}
+
 } // namespace doris::pipeline
\ No newline at end of file
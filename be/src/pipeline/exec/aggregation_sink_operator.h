@@ -39,7 +39,7 @@ public:
 class AggSinkOperator final : public StreamingOperator<AggSinkOperatorBuilder> {
 public:
     AggSinkOperator(OperatorBuilderBase* operator_builder, ExecNode* node);
-    bool can_write() override { return true; }
+    bool can_write() override;
 };
 
 } // namespace pipeline
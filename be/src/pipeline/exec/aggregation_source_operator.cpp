@@ -24,5 +24,17 @@ namespace pipeline {
 
 OPERATOR_CODE_GENERATOR(AggSourceOperator, SourceOperator)
 
+bool AggSourceOperator::can_read() {
+    return _node->can_read() && _node->can_read_spilled();
+}
+
+Status AggSourceOperator::try_close() {
+    return _node->try_close();
+}
+
+bool AggSourceOperator::is_pending_finish() const {
+    return _node->has_running_result_tasks();
+}
+
 } // namespace pipeline
 } // namespace doris
\ No newline at end of file
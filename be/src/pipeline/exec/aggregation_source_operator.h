@@ -41,6 +41,9 @@ public:
     // should skip `alloc_resource()` function call, only sink operator
     // call the function
     Status open(RuntimeState*) override { return Status::OK(); }
+    bool can_read() override;
+    Status try_close() override;
+    bool is_pending_finish() const override;
 };
 
 } // namespace pipeline
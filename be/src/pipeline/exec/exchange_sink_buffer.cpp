@@ -23,8 +23,10 @@
 #include <memory>
 
 #include "common/status.h"
+#include "pipeline/blocked_task_notifier.h"
 #include "pipeline/pipeline_fragment_context.h"
 #include "service/brpc.h"
+#include "util/defer_op.h"
 #include "util/proto_util.h"
 #include "vec/sink/vdata_stream_sender.h"
 
@@ -186,6 +188,9 @@ Status ExchangeSinkBuffer::add_block(BroadcastTransmitInfo&& request) {
 }
 
 Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
+    // popping the queue or ending the sending changes can_write() and is_pending_finish(),
+    // which take the lock as well, so notify after it is released
+    Defer notify {[] { notify_blocked_tasks(); }};
     std::unique_lock<std::mutex> lock(*_instance_to_package_queue_mutex[id]);
 
     std::queue<TransmitInfo, std::list<TransmitInfo>>& q = _instance_to_package_queue[id];
@@ -213,8 +218,12 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
         _closure->cntl.set_timeout_ms(request.channel->_brpc_timeout_ms);
         _closure->addFailedHandler(
                 [&](const InstanceLoId& id, const std::string& err) { _failed(id, err); });
-        _closure->addSuccessHandler([&](const InstanceLoId& id, const bool& eos,
-                                        const PTransmitDataResult& result) {
+        size_t bytes = request.block ? request.block->column_values().size() : 0;
+        _closure->addSuccessHandler([&, channel = request.channel, bytes, closure = _closure](
+                                            const InstanceLoId& id, const bool& eos,
+                                            const PTransmitDataResult& result) {
+            // the closure is deleted after its handler returns
+            channel->update_transfer(bytes, closure->cntl.latency_us());
             Status s = Status(result.status());
             if (!s.ok()) {
                 _failed(id,
@@ -256,8 +265,13 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
         _closure->cntl.set_timeout_ms(request.channel->_brpc_timeout_ms);
         _closure->addFailedHandler(
                 [&](const InstanceLoId& id, const std::string& err) { _failed(id, err); });
-        _closure->addSuccessHandler([&](const InstanceLoId& id, const bool& eos,
-                                        const PTransmitDataResult& result) {
+        size_t bytes = request.block_holder->get_block()
+                               ? request.block_holder->get_block()->column_values().size()
+                               : 0;
+        _closure->addSuccessHandler([&, channel = request.channel, bytes, closure = _closure](
+                                            const InstanceLoId& id, const bool& eos,
+                                            const PTransmitDataResult& result) {
+            channel->update_transfer(bytes, closure->cntl.latency_us());
             Status s = Status(result.status());
             if (!s.ok()) {
                 _failed(id,
@@ -301,8 +315,11 @@ void ExchangeSinkBuffer::_construct_request(InstanceLoId id) {
 }
 
 void ExchangeSinkBuffer::_ended(InstanceLoId id) {
-    std::unique_lock<std::mutex> lock(*_instance_to_package_queue_mutex[id]);
-    _instance_to_sending_by_pipeline[id] = true;
+    {
+        std::unique_lock<std::mutex> lock(*_instance_to_package_queue_mutex[id]);
+        _instance_to_sending_by_pipeline[id] = true;
+    }
+    notify_blocked_tasks();
 }
 
 void ExchangeSinkBuffer::_failed(InstanceLoId id, const std::string& err) {
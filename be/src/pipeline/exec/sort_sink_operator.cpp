@@ -23,4 +23,8 @@ namespace doris::pipeline {
 
 OPERATOR_CODE_GENERATOR(SortSinkOperator, StreamingOperator)
 
+bool SortSinkOperator::can_write() {
+    return _node->can_sink_write();
+}
+
 } // namespace doris::pipeline
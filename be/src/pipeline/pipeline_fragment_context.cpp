@@ -142,6 +142,8 @@ void PipelineFragmentContext::cancel(const PPlanFragmentCancelReason& reason,
         // TODO pipeline incomp
         // _exec_env->result_queue_mgr()->update_queue_status(id, Status::Aborted(msg));
     }
+    // the blocked tasks of the fragment are cancelled by the blocked task scheduler
+    notify_blocked_tasks();
 }
 
 PipelinePtr PipelineFragmentContext::add_pipeline() {
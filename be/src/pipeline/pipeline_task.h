@@ -146,10 +146,13 @@ public:
 
     Status finalize();
 
-    void finish_p_dependency() {
+    // Returns true if the tasks of some parent pipelines have no dependency any more.
+    bool finish_p_dependency() {
+        bool ready = false;
         for (const auto& p : _pipeline->_parents) {
-            p->finish_one_dependency(_previous_schedule_id);
+            ready |= p->finish_one_dependency(_previous_schedule_id);
         }
+        return ready;
     }
 
     PipelineFragmentContext* fragment_context() { return _fragment_context; }
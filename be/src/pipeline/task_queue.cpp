@@ -17,7 +17,10 @@
 
 #include "task_queue.h"
 
+#include "common/config.h"
 #include "runtime/task_group/task_group.h"
+#include "util/cpu_info.h"
+#include "util/time.h"
 
 namespace doris {
 namespace pipeline {
@@ -199,6 +202,221 @@ Status NormalTaskQueue::push_back(PipelineTask* task, size_t core_id) {
     return _async_queue[core_id].push(task);
 }
 
+////////////////////  WorkStealingTaskQueue ////////////////////
+
+namespace {
+// the queue and the executor the current thread works for, to tell the pushes of an executor
+// to its own deque from the pushes of the other threads
+thread_local const TaskQueue* tls_queue = nullptr;
+thread_local size_t tls_core_id = 0;
+} // namespace
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(size_t core_size) : TaskQueue(core_size) {
+    _workers.reset(new Worker[core_size]);
+    for (size_t i = 0; i < core_size; ++i) {
+        _workers[i].rng.seed(i);
+    }
+}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() = default;
+
+void WorkStealingTaskQueue::close() {
+    _closed = true;
+    for (size_t i = 0; i < _core_size; ++i) {
+        std::unique_lock<std::mutex> lock(_workers[i].mutex);
+        _workers[i].wait_task.notify_all();
+    }
+}
+
+PipelineTask* WorkStealingTaskQueue::take(size_t core_id) {
+    DCHECK(core_id < _core_size);
+    tls_queue = this;
+    tls_core_id = core_id;
+    auto& worker = _workers[core_id];
+    // the executors are not bound to cores, so the node is refreshed on every take
+    worker.numa_node.store(CpuInfo::get_numa_node_of_core(CpuInfo::get_current_core()),
+                           std::memory_order_relaxed);
+    PipelineTask* task = nullptr;
+    while (!_closed) {
+        task = _local_take(worker);
+        if (task) {
+            break;
+        }
+        task = _steal_take(core_id);
+        if (task) {
+            break;
+        }
+        _park(core_id);
+    }
+    if (task) {
+        task->pop_out_runnable_queue();
+    }
+    return task;
+}
+
+PipelineTask* WorkStealingTaskQueue::_local_take(Worker& worker) {
+    if (worker.has_inbox_tasks.load(std::memory_order_acquire)) {
+        std::vector<PipelineTask*> tasks;
+        {
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            tasks.swap(worker.inbox);
+            worker.has_inbox_tasks = false;
+        }
+        for (auto* task : tasks) {
+            if (task->can_steal()) {
+                worker.deque.push(task);
+            } else {
+                worker.local_tasks.push_back(task);
+            }
+        }
+    }
+    // take from the two queues in turn, so that neither starves the other
+    if (!worker.local_tasks.empty() && (worker.deque.empty() || (++worker.take_times & 1))) {
+        auto* task = worker.local_tasks.front();
+        worker.local_tasks.pop_front();
+        return task;
+    }
+    while (!worker.deque.empty()) {
+        if (auto* task = worker.deque.steal()) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+PipelineTask* WorkStealingTaskQueue::_steal_take(size_t core_id) {
+    if (_core_size == 1) {
+        return nullptr;
+    }
+    auto& worker = _workers[core_id];
+    int numa_node = worker.numa_node.load(std::memory_order_relaxed);
+    size_t start = worker.rng() % _core_size;
+    // the deques on the same NUMA node first, then the others, then the inboxes of the busy
+    // executors
+    for (int round = 0; round < 3; ++round) {
+        for (size_t i = 0; i < _core_size; ++i) {
+            size_t victim_id = (start + i) % _core_size;
+            if (victim_id == core_id) {
+                continue;
+            }
+            auto& victim = _workers[victim_id];
+            if (round == 2) {
+                if (auto* task = _steal_from_inbox(victim)) {
+                    return task;
+                }
+                continue;
+            }
+            bool same_node = victim.numa_node.load(std::memory_order_relaxed) == numa_node;
+            if (same_node != (round == 0)) {
+                continue;
+            }
+            while (!victim.deque.empty()) {
+                if (auto* task = victim.deque.steal()) {
+                    return task;
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
+PipelineTask* WorkStealingTaskQueue::_steal_from_inbox(Worker& victim) {
+    if (!victim.has_inbox_tasks.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return nullptr;
+    }
+    for (auto it = victim.inbox.begin(); it != victim.inbox.end(); ++it) {
+        auto* task = *it;
+        if (task->can_steal()) {
+            victim.inbox.erase(it);
+            victim.has_inbox_tasks = !victim.inbox.empty();
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void WorkStealingTaskQueue::_park(size_t core_id) {
+    auto& worker = _workers[core_id];
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    if (_closed || !worker.inbox.empty()) {
+        return;
+    }
+    worker.parked = true;
+    worker.notified = false;
+    _num_parked.fetch_add(1);
+    // a task pushed to a deque before `_num_parked` was increased did not wake anyone up
+    bool has_task = false;
+    for (size_t i = 0; i < _core_size && !has_task; ++i) {
+        has_task = !_workers[i].deque.empty();
+    }
+    if (!has_task) {
+        worker.wait_task.wait_for(lock, std::chrono::milliseconds(WAIT_CORE_TASK_TIMEOUT_MS), [&] {
+            return _closed || worker.notified || !worker.inbox.empty();
+        });
+    }
+    worker.parked = false;
+    _num_parked.fetch_sub(1);
+}
+
+void WorkStealingTaskQueue::_notify_parked() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_num_parked.load() == 0) {
+        return;
+    }
+    size_t start = _next_core.fetch_add(1);
+    for (size_t i = 0; i < _core_size; ++i) {
+        auto& worker = _workers[(start + i) % _core_size];
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        if (worker.parked && !worker.notified) {
+            worker.notified = true;
+            worker.wait_task.notify_one();
+            return;
+        }
+    }
+}
+
+Status WorkStealingTaskQueue::push_back(PipelineTask* task) {
+    int core_id = task->get_previous_core_id();
+    if (core_id < 0) {
+        core_id = _next_core.fetch_add(1) % _core_size;
+    }
+    return push_back(task, core_id);
+}
+
+Status WorkStealingTaskQueue::push_back(PipelineTask* task, size_t core_id) {
+    DCHECK(core_id < _core_size);
+    if (_closed) {
+        return Status::InternalError("WorkStealingTaskQueue closed");
+    }
+    task->put_in_runnable_queue();
+    auto& worker = _workers[core_id];
+    if (tls_queue == this && tls_core_id == core_id) {
+        if (!task->can_steal()) {
+            worker.local_tasks.push_back(task);
+            return Status::OK();
+        }
+        worker.deque.push(task);
+    } else {
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        worker.inbox.push_back(task);
+        worker.has_inbox_tasks = true;
+        if (worker.parked) {
+            worker.notified = true;
+            worker.wait_task.notify_one();
+            return Status::OK();
+        }
+        if (!task->can_steal()) {
+            return Status::OK();
+        }
+    }
+    _notify_parked();
+    return Status::OK();
+}
+
 bool TaskGroupTaskQueue::TaskGroupSchedEntityComparator::operator()(
         const taskgroup::TGEntityPtr& lhs_ptr, const taskgroup::TGEntityPtr& rhs_ptr) const {
     int64_t lhs_val = lhs_ptr->vruntime_ns();
@@ -257,9 +475,13 @@ PipelineTask* TaskGroupTaskQueue::take(size_t core_id) {
         if (_group_entities.empty()) {
             _wait_task.wait(lock);
         } else {
-            entity = _next_tg_entity();
+            auto now_ns = MonotonicNanos();
+            int64_t wake_up_ns = now_ns + WAIT_CORE_TASK_TIMEOUT_MS * NANOS_PER_MILLIS;
+            entity = _next_tg_entity(now_ns, &wake_up_ns);
             if (!entity) {
-                _wait_task.wait_for(lock, std::chrono::milliseconds(WAIT_CORE_TASK_TIMEOUT_MS));
+                // all the task groups with tasks are throttled, wait for the first of their
+                // quota windows to end
+                _wait_task.wait_for(lock, std::chrono::nanoseconds(wake_up_ns - now_ns));
             }
         }
     }
@@ -305,7 +527,7 @@ void TaskGroupTaskQueue::_dequeue_task_group(taskgroup::TGEntityPtr tg_entity) {
 }
 
 void TaskGroupTaskQueue::_update_min_tg() {
-    auto* min_entity = _next_tg_entity();
+    auto* min_entity = _group_entities.empty() ? nullptr : *_group_entities.begin();
     _min_tg_entity = min_entity;
     if (min_entity) {
         auto min_v_runtime = min_entity->vruntime_ns();
@@ -320,13 +542,23 @@ int64_t TaskGroupTaskQueue::_ideal_runtime_ns(taskgroup::TGEntityPtr tg_entity)
     return PipelineTask::THREAD_TIME_SLICE * _core_size * tg_entity->cpu_share() / _total_cpu_share;
 }
 
-taskgroup::TGEntityPtr TaskGroupTaskQueue::_next_tg_entity() {
-    taskgroup::TGEntityPtr res = nullptr;
+int64_t TaskGroupTaskQueue::_cpu_quota_ns(taskgroup::TGEntityPtr tg_entity,
+                                          int64_t window_ns) const {
+    return window_ns * _core_size * tg_entity->cpu_hard_limit() / 100;
+}
+
+// The task group with the min v runtime whose cpu quota is not used up, the tasks of the
+// throttled groups stay in the queue until their quota windows end.
+taskgroup::TGEntityPtr TaskGroupTaskQueue::_next_tg_entity(int64_t now_ns, int64_t* wake_up_ns) {
+    int64_t window_ns =
+            std::max(config::pipeline_task_group_cpu_quota_window_ms, 1) * NANOS_PER_MILLIS;
     for (auto* entity : _group_entities) {
-        res = entity;
-        break;
+        if (!entity->is_throttled(now_ns, window_ns, _cpu_quota_ns(entity, window_ns))) {
+            return entity;
+        }
+        *wake_up_ns = std::min(*wake_up_ns, entity->window_end_ns(window_ns));
     }
-    return res;
+    return nullptr;
 }
 
 void TaskGroupTaskQueue::update_statistics(PipelineTask* task, int64_t time_spent) {
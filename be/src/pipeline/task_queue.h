@@ -16,9 +16,12 @@
 // under the License.
 #pragma once
 
+#include <deque>
 #include <queue>
+#include <random>
 
 #include "pipeline_task.h"
+#include "util/work_stealing_deque.h"
 
 namespace doris {
 namespace taskgroup {
@@ -134,6 +137,57 @@ private:
     std::atomic<bool> _closed;
 };
 
+// Each executor owns a lock-free work-stealing deque. The tasks an executor puts back after
+// its time slice go to its own deque, and the tasks pushed by other threads go to the inbox of
+// the executor they ran on last. An idle executor steals from the others, starting from a
+// random one and trying those on its own NUMA node first, and parks when there is nothing to
+// steal until a task is pushed.
+class WorkStealingTaskQueue : public TaskQueue {
+public:
+    explicit WorkStealingTaskQueue(size_t core_size);
+
+    ~WorkStealingTaskQueue() override;
+
+    void close() override;
+
+    PipelineTask* take(size_t core_id) override;
+
+    Status push_back(PipelineTask* task) override;
+
+    Status push_back(PipelineTask* task, size_t core_id) override;
+
+private:
+    struct alignas(64) Worker {
+        // stealable tasks, only pushed by the executor itself, which takes them FIFO
+        WorkStealingDeque<PipelineTask*> deque;
+        // tasks that can not be stolen, only used by the executor itself
+        std::deque<PipelineTask*> local_tasks;
+        uint64_t take_times = 0;
+        std::mt19937 rng;
+        std::atomic<int> numa_node = 0;
+
+        std::mutex mutex;
+        std::condition_variable wait_task;
+        // tasks pushed by other threads
+        std::vector<PipelineTask*> inbox;
+        std::atomic<bool> has_inbox_tasks = false;
+        bool parked = false;
+        bool notified = false;
+    };
+
+    PipelineTask* _local_take(Worker& worker);
+    PipelineTask* _steal_take(size_t core_id);
+    PipelineTask* _steal_from_inbox(Worker& victim);
+    void _park(size_t core_id);
+    // wakes up a parked executor to steal a task just pushed
+    void _notify_parked();
+
+    std::unique_ptr<Worker[]> _workers;
+    std::atomic<size_t> _next_core = 0;
+    std::atomic<int> _num_parked = 0;
+    std::atomic<bool> _closed = false;
+};
+
 class TaskGroupTaskQueue : public TaskQueue {
 public:
     explicit TaskGroupTaskQueue(size_t);
@@ -157,8 +211,10 @@ private:
     template <bool from_worker>
     void _enqueue_task_group(taskgroup::TGEntityPtr);
     void _dequeue_task_group(taskgroup::TGEntityPtr);
-    taskgroup::TGEntityPtr _next_tg_entity();
+    taskgroup::TGEntityPtr _next_tg_entity(int64_t now_ns, int64_t* wake_up_ns);
     int64_t _ideal_runtime_ns(taskgroup::TGEntityPtr tg_entity) const;
+    // the cpu time the tasks of the group may use in a quota window, 0 means no limit
+    int64_t _cpu_quota_ns(taskgroup::TGEntityPtr tg_entity, int64_t window_ns) const;
     void _update_min_tg();
 
     // Like cfs rb tree in sched_entity
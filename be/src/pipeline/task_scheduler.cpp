@@ -17,12 +17,38 @@
 
 #include "task_scheduler.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "common/config.h"
 #include "common/signal_handler.h"
 #include "pipeline_fragment_context.h"
 #include "util/thread.h"
 
 namespace doris::pipeline {
 
+namespace {
+std::mutex s_schedulers_lock;
+std::vector<BlockedTaskScheduler*> s_schedulers;
+// the number of schedulers waiting for notify_blocked_tasks()
+std::atomic<int> s_num_waiting_schedulers = 0;
+} // namespace
+
+void notify_blocked_tasks() {
+    // Pairs with the fence in BlockedTaskScheduler::_set_waiting(). Either the scheduler
+    // checks its tasks after the state changed by the caller, or it is seen waiting here.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (s_num_waiting_schedulers.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> l(s_schedulers_lock);
+    for (auto* scheduler : s_schedulers) {
+        scheduler->wake_up();
+    }
+}
+
 BlockedTaskScheduler::BlockedTaskScheduler(std::shared_ptr<TaskQueue> task_queue)
         : _task_queue(std::move(task_queue)), _started(false), _shutdown(false) {}
 
@@ -34,6 +60,10 @@ Status BlockedTaskScheduler::start() {
     while (!this->_started.load()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
+    {
+        std::lock_guard<std::mutex> l(s_schedulers_lock);
+        s_schedulers.push_back(this);
+    }
     LOG(INFO) << "BlockedTaskScheduler started";
     return Status::OK();
 }
@@ -46,6 +76,9 @@ void BlockedTaskScheduler::shutdown() {
             _task_cond.notify_one();
             _thread->join();
         }
+        std::lock_guard<std::mutex> l(s_schedulers_lock);
+        s_schedulers.erase(std::remove(s_schedulers.begin(), s_schedulers.end(), this),
+                           s_schedulers.end());
     }
 }
 
@@ -59,6 +92,12 @@ Status BlockedTaskScheduler::add_blocked_task(PipelineTask* task) {
     return Status::OK();
 }
 
+void BlockedTaskScheduler::wake_up() {
+    std::unique_lock<std::mutex> lock(_task_mutex);
+    _has_event = true;
+    _task_cond.notify_one();
+}
+
 void BlockedTaskScheduler::_schedule() {
     _started.store(true);
     std::list<PipelineTask*> local_blocked_tasks;
@@ -68,8 +107,12 @@ void BlockedTaskScheduler::_schedule() {
     while (!_shutdown) {
         {
             std::unique_lock<std::mutex> lock(this->_task_mutex);
+            _has_event = false;
             local_blocked_tasks.splice(local_blocked_tasks.end(), _blocked_tasks);
             if (local_blocked_tasks.empty()) {
+                // only add_blocked_task() can make it ready
+                _set_waiting(false);
+                empty_times = 0;
                 while (!_shutdown.load() && _blocked_tasks.empty()) {
                     _task_cond.wait_for(lock, std::chrono::milliseconds(10));
                 }
@@ -158,21 +201,37 @@ void BlockedTaskScheduler::_schedule() {
             ready_tasks.clear();
         }
 
-        if (empty_times != 0 && (empty_times & (EMPTY_TIMES_TO_YIELD - 1)) == 0) {
-#ifdef __x86_64__
-            _mm_pause();
-#else
-            sched_yield();
-#endif
-        }
-        if (empty_times == EMPTY_TIMES_TO_YIELD * 10) {
-            empty_times = 0;
-            sched_yield();
+        if (empty_times == 0) {
+            _set_waiting(false);
+        } else if (empty_times == 1) {
+            // Checks the tasks once more after announcing the wait, so a state changed after
+            // the check above either gets checked or notifies the scheduler.
+            _set_waiting(true);
+        } else {
+            std::unique_lock<std::mutex> lock(_task_mutex);
+            _task_cond.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_TIME_MS), [this] {
+                return _shutdown.load() || _has_event || !_blocked_tasks.empty();
+            });
         }
     }
+    _set_waiting(false);
     LOG(INFO) << "BlockedTaskScheduler schedule thread stop";
 }
 
+void BlockedTaskScheduler::_set_waiting(bool waiting) {
+    if (_is_waiting == waiting) {
+        return;
+    }
+    _is_waiting = waiting;
+    if (waiting) {
+        s_num_waiting_schedulers.fetch_add(1);
+        // pairs with the fence in notify_blocked_tasks()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    } else {
+        s_num_waiting_schedulers.fetch_sub(1);
+    }
+}
+
 void BlockedTaskScheduler::_make_task_run(std::list<PipelineTask*>& local_tasks,
                                           std::list<PipelineTask*>::iterator& task_itr,
                                           std::vector<PipelineTask*>& ready_tasks,
@@ -247,6 +306,9 @@ void TaskScheduler::_do_work(size_t index) {
         // task exec
         bool eos = false;
         auto status = task->execute(&eos);
+        // the task may have changed the states which other blocked tasks are waiting for,
+        // e.g. the shared state of a local sink and source
+        notify_blocked_tasks();
         task->set_previous_core_id(index);
         if (!status.ok()) {
             LOG(WARNING) << fmt::format("Pipeline task [{}] failed: {}", task->debug_string(),
@@ -268,7 +330,9 @@ void TaskScheduler::_do_work(size_t index) {
                                      "finalize fail:" + status.to_string());
                 _try_close_task(task, PipelineTaskState::CANCELED);
             } else {
-                task->finish_p_dependency();
+                if (task->finish_p_dependency()) {
+                    _blocked_task_scheduler->wake_up();
+                }
                 _try_close_task(task, PipelineTaskState::FINISHED);
             }
             continue;
@@ -309,9 +373,10 @@ void TaskScheduler::_try_close_task(PipelineTask* task, PipelineTaskState state)
             return;
         }
         task->set_state(state);
+        notify_blocked_tasks();
         // TODO: rethink the logic
-        if (state == PipelineTaskState::CANCELED) {
-            task->finish_p_dependency();
+        if (state == PipelineTaskState::CANCELED && task->finish_p_dependency()) {
+            _blocked_task_scheduler->wake_up();
         }
         task->fragment_context()->close_a_pipeline();
     }
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "blocked_task_notifier.h"
 #include "common/status.h"
 #include "pipeline.h"
 #include "pipeline_task.h"
@@ -34,6 +35,8 @@ public:
     Status start();
     void shutdown();
     Status add_blocked_task(PipelineTask* task);
+    // Tells the scheduler that some blocked tasks may be ready, see notify_blocked_tasks().
+    void wake_up();
 
 private:
     std::shared_ptr<TaskQueue> _task_queue;
@@ -41,15 +44,23 @@ private:
     std::mutex _task_mutex;
     std::condition_variable _task_cond;
     std::list<PipelineTask*> _blocked_tasks;
+    bool _has_event = false;
 
     scoped_refptr<Thread> _thread;
     std::atomic<bool> _started;
     std::atomic<bool> _shutdown;
 
-    static constexpr auto EMPTY_TIMES_TO_YIELD = 64;
+    // only accessed by the schedule thread
+    bool _is_waiting = false;
+
+    // The scheduler waits for notify_blocked_tasks() when no blocked task is ready. The states
+    // which are not notified, like the timeouts of the runtime filters and of the queries,
+    // are checked again after IDLE_WAIT_TIME_MS.
+    static constexpr auto IDLE_WAIT_TIME_MS = 10;
 
 private:
     void _schedule();
+    void _set_waiting(bool waiting);
     void _make_task_run(std::list<PipelineTask*>& local_tasks,
                         std::list<PipelineTask*>::iterator& task_itr,
                         std::vector<PipelineTask*>& ready_tasks,
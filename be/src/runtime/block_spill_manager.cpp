@@ -19,9 +19,10 @@
 
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
-#include <random>
 
+#include "common/config.h"
 #include "io/fs/local_file_system.h"
+#include "util/string_util.h"
 #include "util/time.h"
 #include "vec/core/block_spill_reader.h"
 #include "vec/core/block_spill_writer.h"
@@ -52,9 +53,24 @@ Status BlockSpillManager::init() {
         }
     }
 
+    int io_thread_num = std::max<int>(
+            1, config::spill_io_thread_num_per_disk * static_cast<int>(_store_paths.size()));
+    RETURN_IF_ERROR(ThreadPoolBuilder("BlockSpillIOThreadPool")
+                            .set_min_threads(1)
+                            .set_max_threads(io_thread_num)
+                            .build(&_io_thread_pool));
     return Status::OK();
 }
 
+segment_v2::CompressionTypePB BlockSpillManager::_compression_type() {
+    if (iequal(config::spill_compression_type, "NONE")) {
+        return segment_v2::CompressionTypePB::NO_COMPRESSION;
+    } else if (iequal(config::spill_compression_type, "ZSTD")) {
+        return segment_v2::CompressionTypePB::ZSTD;
+    }
+    return segment_v2::CompressionTypePB::LZ4;
+}
+
 void BlockSpillManager::gc(int64_t max_file_count) {
     if (max_file_count < 1) {
         return;
@@ -100,11 +116,9 @@ void BlockSpillManager::gc(int64_t max_file_count) {
 Status BlockSpillManager::get_writer(int32_t batch_size, vectorized::BlockSpillWriterUPtr& writer,
                                      RuntimeProfile* profile) {
     int64_t id;
-    std::vector<int> indices(_store_paths.size());
-    std::iota(indices.begin(), indices.end(), 0);
-    std::shuffle(indices.begin(), indices.end(), std::mt19937 {std::random_device {}()});
+    size_t path_index = _next_path_index++ % _store_paths.size();
 
-    std::string path = _store_paths[indices[0]].path + "/" + BLOCK_SPILL_DIR;
+    std::string path = _store_paths[path_index].path + "/" + BLOCK_SPILL_DIR;
     std::string unique_name = boost::uuids::to_string(boost::uuids::random_generator()());
     path += "/" + unique_name;
     {
@@ -113,7 +127,12 @@ Status BlockSpillManager::get_writer(int32_t batch_size, vectorized::BlockSpillW
         id_to_file_paths_[id] = path;
     }
 
-    writer.reset(new vectorized::BlockSpillWriter(id, batch_size, path, profile));
+    std::unique_ptr<ThreadPoolToken> io_token;
+    if (_io_thread_pool) {
+        io_token = _io_thread_pool->new_token(ThreadPool::ExecutionMode::SERIAL);
+    }
+    writer.reset(new vectorized::BlockSpillWriter(id, batch_size, path, profile,
+                                                  std::move(io_token), _compression_type()));
     return writer->open();
 }
 
@@ -125,7 +144,12 @@ Status BlockSpillManager::get_reader(int64_t stream_id, vectorized::BlockSpillRe
         DCHECK(id_to_file_paths_.end() != id_to_file_paths_.find(stream_id));
         path = id_to_file_paths_[stream_id];
     }
-    reader.reset(new vectorized::BlockSpillReader(stream_id, path, profile, delete_after_read));
+    std::unique_ptr<ThreadPoolToken> io_token;
+    if (_io_thread_pool) {
+        io_token = _io_thread_pool->new_token(ThreadPool::ExecutionMode::SERIAL);
+    }
+    reader.reset(new vectorized::BlockSpillReader(stream_id, path, profile, delete_after_read,
+                                                  std::move(io_token)));
     return reader->open();
 }
 
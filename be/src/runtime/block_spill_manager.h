@@ -17,12 +17,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "gen_cpp/segment_v2.pb.h"
 #include "olap/options.h"
+#include "util/threadpool.h"
 
 namespace doris {
 class RuntimeProfile;
@@ -35,6 +38,9 @@ using BlockSpillReaderUPtr = std::unique_ptr<BlockSpillReader>;
 } // namespace vectorized
 
 class ExecEnv;
+// Spilled streams are placed on the store paths in turn, so that spilling of a
+// query uses all the disks. File I/O of the streams is done by a thread pool
+// sized by the number of disks.
 class BlockSpillManager {
 public:
     BlockSpillManager(const std::vector<StorePath>& paths);
@@ -52,7 +58,11 @@ public:
     void gc(int64_t max_file_count);
 
 private:
+    static segment_v2::CompressionTypePB _compression_type();
+
     std::vector<StorePath> _store_paths;
+    std::atomic<size_t> _next_path_index = 0;
+    std::unique_ptr<ThreadPool> _io_thread_pool;
     std::mutex lock_;
     int64_t id_ = 0;
     std::unordered_map<int64_t, std::string> id_to_file_paths_;
@@ -17,11 +17,16 @@
 
 #include "runtime/buffer_control_block.h"
 
+#include <arrow/record_batch.h>
+
 #include "gen_cpp/PaloInternalService_types.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "pipeline/blocked_task_notifier.h"
 #include "runtime/exec_env.h"
 #include "runtime/thread_context.h"
 #include "service/brpc.h"
+#include "util/arrow/row_batch.h"
+#include "util/defer_op.h"
 #include "util/thrift_util.h"
 
 namespace doris {
@@ -80,6 +85,25 @@ void GetResultBatchCtx::on_data(const std::unique_ptr<TFetchDataResult>& t_resul
     delete this;
 }
 
+void GetResultBatchCtx::on_data(const std::shared_ptr<arrow::RecordBatch>& arrow_batch,
+                                int64_t packet_seq, bool eos) {
+    std::string arrow_batch_str;
+    Status st = serialize_record_batch(*arrow_batch, &arrow_batch_str);
+    if (st.ok()) {
+        result->set_arrow_batch(std::move(arrow_batch_str));
+        result->set_packet_seq(packet_seq);
+        result->set_eos(eos);
+    } else {
+        LOG(WARNING) << "arrow batch serialize failed, errmsg=" << st;
+    }
+    st.to_protobuf(result->mutable_status());
+    {
+        SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(ExecEnv::GetInstance()->orphan_mem_tracker());
+        done->Run();
+    }
+    delete this;
+}
+
 BufferControlBlock::BufferControlBlock(const TUniqueId& id, int buffer_size)
         : _fragment_id(id),
           _is_close(false),
@@ -101,26 +125,52 @@ bool BufferControlBlock::can_sink() {
     return _get_batch_queue_empty() || _buffer_rows < _buffer_limit || _is_cancelled;
 }
 
+bool BufferControlBlock::_wait_for_room(std::unique_lock<std::mutex>& l) {
+    if (_is_cancelled) {
+        return false;
+    }
+    while (((!_batch_queue.empty() || !_arrow_batch_queue.empty()) &&
+            _buffer_rows > _buffer_limit) &&
+           !_is_cancelled) {
+        _data_removal.wait_for(l, std::chrono::seconds(1));
+    }
+    return !_is_cancelled;
+}
+
 Status BufferControlBlock::add_batch(std::unique_ptr<TFetchDataResult>& result) {
     std::unique_lock<std::mutex> l(_lock);
 
-    if (_is_cancelled) {
+    int num_rows = result->result_batch.rows.size();
+
+    if (!_wait_for_room(l)) {
         return Status::Cancelled("Cancelled");
     }
 
-    int num_rows = result->result_batch.rows.size();
-
-    while ((!_batch_queue.empty() && _buffer_rows > _buffer_limit) && !_is_cancelled) {
-        _data_removal.wait_for(l, std::chrono::seconds(1));
+    if (_waiting_rpc.empty()) {
+        _buffer_rows += num_rows;
+        _batch_queue.push_back(std::move(result));
+        _data_arrival.notify_one();
+    } else {
+        auto ctx = _waiting_rpc.front();
+        _waiting_rpc.pop_front();
+        ctx->on_data(result, _packet_num);
+        _packet_num++;
     }
+    return Status::OK();
+}
 
-    if (_is_cancelled) {
+Status BufferControlBlock::add_arrow_batch(const std::shared_ptr<arrow::RecordBatch>& result) {
+    std::unique_lock<std::mutex> l(_lock);
+
+    int num_rows = result->num_rows();
+
+    if (!_wait_for_room(l)) {
         return Status::Cancelled("Cancelled");
     }
 
     if (_waiting_rpc.empty()) {
         _buffer_rows += num_rows;
-        _batch_queue.push_back(std::move(result));
+        _arrow_batch_queue.push_back(result);
         _data_arrival.notify_one();
     } else {
         auto ctx = _waiting_rpc.front();
@@ -132,6 +182,8 @@ Status BufferControlBlock::add_batch(std::unique_ptr<TFetchDataResult>& result)
 }
 
 void BufferControlBlock::get_batch(GetResultBatchCtx* ctx) {
+    // taking a batch makes room for the result sink, can_sink() takes _lock as well
+    Defer notify {[] { pipeline::notify_blocked_tasks(); }};
     std::lock_guard<std::mutex> l(_lock);
     if (!_status.ok()) {
         ctx->on_failure(_status);
@@ -152,6 +204,16 @@ void BufferControlBlock::get_batch(GetResultBatchCtx* ctx) {
         _packet_num++;
         return;
     }
+    if (!_arrow_batch_queue.empty()) {
+        std::shared_ptr<arrow::RecordBatch> result = std::move(_arrow_batch_queue.front());
+        _arrow_batch_queue.pop_front();
+        _buffer_rows -= result->num_rows();
+        _data_removal.notify_one();
+
+        ctx->on_data(result, _packet_num);
+        _packet_num++;
+        return;
+    }
     if (_is_close) {
         ctx->on_close(_packet_num, _query_statistics.get());
         return;
@@ -183,6 +245,7 @@ Status BufferControlBlock::close(Status exec_status) {
 }
 
 Status BufferControlBlock::cancel() {
+    Defer notify {[] { pipeline::notify_blocked_tasks(); }};
     std::unique_lock<std::mutex> l(_lock);
     _is_cancelled = true;
     _data_removal.notify_all();
@@ -21,6 +21,7 @@
 #include <condition_variable>
 #include <deque>
 #include <list>
+#include <memory>
 #include <mutex>
 
 #include "common/status.h"
@@ -37,6 +38,10 @@ namespace brpc {
 class Controller;
 }
 
+namespace arrow {
+class RecordBatch;
+}
+
 namespace doris {
 
 class TFetchDataResult;
@@ -55,6 +60,8 @@ struct GetResultBatchCtx {
     void on_close(int64_t packet_seq, QueryStatistics* statistics = nullptr);
     void on_data(const std::unique_ptr<TFetchDataResult>& t_result, int64_t packet_seq,
                  bool eos = false);
+    void on_data(const std::shared_ptr<arrow::RecordBatch>& arrow_batch, int64_t packet_seq,
+                 bool eos = false);
 };
 
 // buffer used for result customer and producer
@@ -66,6 +73,9 @@ public:
     Status init();
     virtual bool can_sink(); // 只有一个fragment写入，因此can_sink返回true，则一定可以执行sink
     Status add_batch(std::unique_ptr<TFetchDataResult>& result);
+    // Used by the Arrow result writer, the batch is sent to the client as an Arrow IPC stream
+    // in PFetchDataResult.arrow_batch.
+    Status add_arrow_batch(const std::shared_ptr<arrow::RecordBatch>& result);
 
     void get_batch(GetResultBatchCtx* ctx);
 
@@ -100,10 +110,16 @@ public:
     }
 
 protected:
-    virtual bool _get_batch_queue_empty() { return _batch_queue.empty(); }
+    virtual bool _get_batch_queue_empty() {
+        return _batch_queue.empty() && _arrow_batch_queue.empty();
+    }
     virtual void _update_batch_queue_empty() {}
 
+    // Waits until there is room for more rows, returns false if cancelled.
+    bool _wait_for_room(std::unique_lock<std::mutex>& l);
+
     using ResultQueue = std::list<std::unique_ptr<TFetchDataResult>>;
+    using ArrowResultQueue = std::list<std::shared_ptr<arrow::RecordBatch>>;
 
     // result's query id
     TUniqueId _fragment_id;
@@ -116,6 +132,8 @@ protected:
 
     // blocking queue for batch
     ResultQueue _batch_queue;
+    // blocking queue for Arrow batch, only one of the queues is used by a result sink
+    ArrowResultQueue _arrow_batch_queue;
     // protects all subsequent data in this block
     std::mutex _lock;
     // signal arrival of new batch or the eos/cancelled condition
@@ -142,7 +160,9 @@ public:
 
 private:
     bool _get_batch_queue_empty() override { return _batch_queue_empty; }
-    void _update_batch_queue_empty() override { _batch_queue_empty = _batch_queue.empty(); }
+    void _update_batch_queue_empty() override {
+        _batch_queue_empty = _batch_queue.empty() && _arrow_batch_queue.empty();
+    }
 
     std::atomic_bool _batch_queue_empty = false;
 };
@@ -127,6 +127,9 @@ public:
     ThreadPool* download_cache_thread_pool() { return _download_cache_thread_pool.get(); }
     ThreadPool* send_report_thread_pool() { return _send_report_thread_pool.get(); }
     ThreadPool* join_node_thread_pool() { return _join_node_thread_pool.get(); }
+    ThreadPool* agg_result_thread_pool() { return _agg_result_thread_pool.get(); }
+    ThreadPool* merge_range_io_thread_pool() { return _merge_range_io_thread_pool.get(); }
+    ThreadPool* segment_prefetch_thread_pool() { return _segment_prefetch_thread_pool.get(); }
 
     void set_serial_download_cache_thread_token() {
         _serial_download_cache_thread_token =
@@ -221,6 +224,12 @@ private:
     std::unique_ptr<ThreadPool> _send_report_thread_pool;
     // Pool used by join node to build hash table
     std::unique_ptr<ThreadPool> _join_node_thread_pool;
+    // Pool used by agg node to emit the sub tables of a partitioned hash table
+    std::unique_ptr<ThreadPool> _agg_result_thread_pool;
+    // Pool used by MergeRangeFileReader to fetch the ranges of remote files
+    std::unique_ptr<ThreadPool> _merge_range_io_thread_pool;
+    // Pool used by PagePrefetcher to read the data pages of segments ahead of the scan
+    std::unique_ptr<ThreadPool> _segment_prefetch_thread_pool;
     // ThreadPoolToken -> buffer
     std::unordered_map<ThreadPoolToken*, std::unique_ptr<char[]>> _download_cache_buf_map;
     FragmentMgr* _fragment_mgr = nullptr;
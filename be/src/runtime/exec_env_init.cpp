@@ -115,6 +115,21 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             .set_max_queue_size(config::fragment_pool_queue_size)
             .build(&_join_node_thread_pool);
 
+    ThreadPoolBuilder("AggResultThreadPool")
+            .set_min_threads(config::agg_result_thread_pool_thread_num)
+            .set_max_threads(config::agg_result_thread_pool_thread_num)
+            .build(&_agg_result_thread_pool);
+
+    ThreadPoolBuilder("MergeRangeIOThreadPool")
+            .set_min_threads(config::merge_range_io_thread_num)
+            .set_max_threads(config::merge_range_io_thread_num)
+            .build(&_merge_range_io_thread_pool);
+
+    ThreadPoolBuilder("SegmentPrefetchThreadPool")
+            .set_min_threads(config::segment_page_prefetch_thread_num)
+            .set_max_threads(config::segment_page_prefetch_thread_num)
+            .build(&_segment_prefetch_thread_pool);
+
     RETURN_IF_ERROR(init_pipeline_task_scheduler());
     _scanner_scheduler = new doris::vectorized::ScannerScheduler();
     _fragment_mgr = new FragmentMgr(this);
@@ -162,7 +177,12 @@ Status ExecEnv::init_pipeline_task_scheduler() {
     }
 
     // TODO pipeline task group combie two blocked schedulers.
-    auto t_queue = std::make_shared<pipeline::NormalTaskQueue>(executors_size);
+    std::shared_ptr<pipeline::TaskQueue> t_queue;
+    if (config::enable_pipeline_work_stealing) {
+        t_queue = std::make_shared<pipeline::WorkStealingTaskQueue>(executors_size);
+    } else {
+        t_queue = std::make_shared<pipeline::NormalTaskQueue>(executors_size);
+    }
     auto b_scheduler = std::make_shared<pipeline::BlockedTaskScheduler>(t_queue);
     _pipeline_task_scheduler = new pipeline::TaskScheduler(this, b_scheduler, t_queue);
     RETURN_IF_ERROR(_pipeline_task_scheduler->start());
@@ -203,7 +223,9 @@ Status ExecEnv::_init_mem_env() {
     }
     int32_t index_percentage = config::index_page_cache_percentage;
     uint32_t num_shards = config::storage_page_cache_shard_size;
-    StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards);
+    StoragePageCache::create_global_cache(
+            storage_cache_limit, index_percentage, num_shards,
+            parse_cache_admission_policy(config::storage_page_cache_admission_policy));
     LOG(INFO) << "Storage page cache memory limit: "
               << PrettyPrinter::print(storage_cache_limit, TUnit::BYTES)
               << ", origin config value: " << config::storage_page_cache_limit;
@@ -216,7 +238,8 @@ Status ExecEnv::_init_mem_env() {
         // Reason same as buffer_pool_limit
         row_cache_mem_limit = row_cache_mem_limit / 2;
     }
-    RowCache::create_global_cache(row_cache_mem_limit);
+    RowCache::create_global_cache(row_cache_mem_limit,
+                                  parse_cache_admission_policy(config::row_cache_admission_policy));
     LOG(INFO) << "Row cache memory limit: "
               << PrettyPrinter::print(row_cache_mem_limit, TUnit::BYTES)
               << ", origin config value: " << config::row_cache_mem_limit;
@@ -235,7 +258,9 @@ Status ExecEnv::_init_mem_env() {
     uint64_t segment_cache_capacity = fd_number / 3 * 2;
     LOG(INFO) << "segment_cache_capacity = fd_number / 3 * 2, fd_number: " << fd_number
               << " segment_cache_capacity: " << segment_cache_capacity;
-    SegmentLoader::create_global_instance(segment_cache_capacity);
+    SegmentLoader::create_global_instance(
+            segment_cache_capacity,
+            parse_cache_admission_policy(config::segment_cache_admission_policy));
 
     // use memory limit
     int64_t inverted_index_cache_limit =
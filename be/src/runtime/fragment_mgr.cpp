@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <sstream>
+#include <type_traits>
 
 #include "common/object_pool.h"
 #include "gen_cpp/FrontendService.h"
@@ -655,11 +656,22 @@ Status FragmentMgr::_get_query_ctx(const Params& params, TUniqueId query_id, boo
         if (pipeline) {
             int ts = fragments_ctx->timeout_second;
             taskgroup::TaskGroupPtr tg;
-            auto ts_id = taskgroup::TaskGroupManager::DEFAULT_TG_ID;
-            if (ts > 0 && ts <= config::pipeline_short_query_timeout_s) {
-                ts_id = taskgroup::TaskGroupManager::SHORT_TG_ID;
+            if constexpr (std::is_same_v<Params, TPipelineFragmentParams>) {
+                if (params.__isset.task_group) {
+                    taskgroup::TaskGroupInfo task_group_info;
+                    RETURN_IF_ERROR(taskgroup::TaskGroupInfo::parse_group_info(params.task_group,
+                                                                               &task_group_info));
+                    tg = taskgroup::TaskGroupManager::instance()->get_or_create_task_group(
+                            task_group_info);
+                }
+            }
+            if (!tg) {
+                auto ts_id = taskgroup::TaskGroupManager::DEFAULT_TG_ID;
+                if (ts > 0 && ts <= config::pipeline_short_query_timeout_s) {
+                    ts_id = taskgroup::TaskGroupManager::SHORT_TG_ID;
+                }
+                tg = taskgroup::TaskGroupManager::instance()->get_task_group(ts_id);
             }
-            tg = taskgroup::TaskGroupManager::instance()->get_task_group(ts_id);
             fragments_ctx->set_task_group(tg);
             LOG(INFO) << "Query/load id: " << print_id(fragments_ctx->query_id)
                       << "use task group: " << tg->debug_string();
@@ -293,6 +293,12 @@ public:
         return segment_v2::CompressionTypePB::SNAPPY;
     }
 
+    // The codec is chosen by sampling the blocks, see AdaptiveExchangeCompression.
+    bool fragment_transmission_compression_adaptive() const {
+        return _query_options.__isset.fragment_transmission_compression_codec &&
+               _query_options.fragment_transmission_compression_codec == "adaptive";
+    }
+
     bool skip_storage_engine_merge() const {
         return _query_options.__isset.skip_storage_engine_merge &&
                _query_options.skip_storage_engine_merge;
@@ -373,6 +379,27 @@ public:
         return 0;
     }
 
+    int64_t external_agg_bytes_threshold() const {
+        if (_query_options.__isset.external_agg_bytes_threshold) {
+            return _query_options.external_agg_bytes_threshold;
+        }
+        return 0;
+    }
+
+    int64_t external_join_bytes_threshold() const {
+        if (_query_options.__isset.external_join_bytes_threshold) {
+            return _query_options.external_join_bytes_threshold;
+        }
+        return 0;
+    }
+
+    int64_t external_analytic_bytes_threshold() const {
+        if (_query_options.__isset.external_analytic_bytes_threshold) {
+            return _query_options.external_analytic_bytes_threshold;
+        }
+        return 0;
+    }
+
 private:
     Status create_error_log_file();
 
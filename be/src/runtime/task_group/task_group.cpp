@@ -17,23 +17,36 @@
 
 #include "task_group.h"
 
+#include <gen_cpp/PaloInternalService_types.h>
+
 #include "pipeline/pipeline_task.h"
+#include "util/doris_metrics.h"
+#include "util/time.h"
 
 namespace doris {
 namespace taskgroup {
 
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(task_group_cpu_time_ns, MetricUnit::NANOSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(task_group_queue_wait_us, MetricUnit::MICROSECONDS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(task_group_scheduled_tasks, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(task_group_throttled_count, MetricUnit::NOUNIT);
+
 pipeline::PipelineTask* TaskGroupEntity::take() {
     if (_queue.empty()) {
         return nullptr;
     }
-    auto task = _queue.front();
+    auto queued = _queue.front();
     _queue.pop();
-    return task;
+    _tg->task_group_queue_wait_us->add((MonotonicNanos() - queued.enqueue_time_ns) / 1000);
+    _tg->task_group_scheduled_tasks->increment(1);
+    return queued.task;
 }
 
 void TaskGroupEntity::incr_runtime_ns(uint64_t runtime_ns) {
     auto v_time = runtime_ns / _tg->share();
     _vruntime_ns += v_time;
+    _window_runtime_ns += runtime_ns;
+    _tg->task_group_cpu_time_ns->increment(runtime_ns);
 }
 
 void TaskGroupEntity::adjust_vruntime_ns(uint64_t vruntime_ns) {
@@ -41,24 +54,90 @@ void TaskGroupEntity::adjust_vruntime_ns(uint64_t vruntime_ns) {
     _vruntime_ns = vruntime_ns;
 }
 
+bool TaskGroupEntity::is_throttled(int64_t now_ns, int64_t window_ns, int64_t quota_ns) {
+    if (quota_ns <= 0) {
+        return false;
+    }
+    if (now_ns - _window_start_ns >= window_ns) {
+        int64_t windows = (now_ns - _window_start_ns) / window_ns;
+        _window_runtime_ns = windows > _window_runtime_ns / quota_ns
+                                     ? 0
+                                     : _window_runtime_ns - windows * quota_ns;
+        _window_start_ns = now_ns;
+        _throttled_in_window = false;
+    }
+    if (_window_runtime_ns < quota_ns) {
+        return false;
+    }
+    if (!_throttled_in_window) {
+        _throttled_in_window = true;
+        _tg->task_group_throttled_count->increment(1);
+    }
+    return true;
+}
+
 void TaskGroupEntity::push_back(pipeline::PipelineTask* task) {
-    _queue.emplace(task);
+    _queue.push({task, MonotonicNanos()});
 }
 
 uint64_t TaskGroupEntity::cpu_share() const {
     return _tg->share();
 }
 
+int TaskGroupEntity::cpu_hard_limit() const {
+    return _tg->cpu_hard_limit();
+}
+
 std::string TaskGroupEntity::debug_string() const {
-    return fmt::format("TGE[id = {}, cpu_share = {}, task size: {}, v_time:{}ns]", _tg->id(),
-                       cpu_share(), _queue.size(), _vruntime_ns);
+    return fmt::format(
+            "TGE[id = {}, cpu_share = {}, cpu_hard_limit = {}%, task size: {}, v_time:{}ns, "
+            "window_time:{}ns]",
+            _tg->id(), cpu_share(), cpu_hard_limit(), _queue.size(), _vruntime_ns,
+            _window_runtime_ns);
+}
+
+TaskGroup::TaskGroup(uint64_t id, std::string name, uint64_t share, int cpu_hard_limit)
+        : _id(id),
+          _name(name),
+          _share(share),
+          _cpu_hard_limit(cpu_hard_limit),
+          _task_entity(this) {
+    _metric_entity = DorisMetrics::instance()->metric_registry()->register_entity(
+            std::string("task_group.") + _name, {{"name", _name}});
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, task_group_cpu_time_ns);
+    HISTOGRAM_METRIC_REGISTER(_metric_entity, task_group_queue_wait_us);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, task_group_scheduled_tasks);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, task_group_throttled_count);
+}
+
+TaskGroup::~TaskGroup() {
+    DorisMetrics::instance()->metric_registry()->deregister_entity(_metric_entity);
 }
 
-TaskGroup::TaskGroup(uint64_t id, std::string name, uint64_t share)
-        : _id(id), _name(name), _share(share), _task_entity(this) {}
+Status TaskGroupInfo::parse_group_info(const TPipelineTaskGroup& resource_group,
+                                       TaskGroupInfo* task_group_info) {
+    if (!resource_group.__isset.id || !resource_group.__isset.name) {
+        return Status::InvalidArgument("task group without id or name");
+    }
+    task_group_info->id = resource_group.id;
+    task_group_info->name = resource_group.name;
+    task_group_info->cpu_share = resource_group.__isset.cpu_share ? resource_group.cpu_share : 0;
+    task_group_info->cpu_hard_limit =
+            resource_group.__isset.cpu_hard_limit ? resource_group.cpu_hard_limit : 0;
+    if (task_group_info->cpu_share == 0) {
+        return Status::InvalidArgument("invalid cpu share {} of task group {}",
+                                       task_group_info->cpu_share, task_group_info->name);
+    }
+    if (task_group_info->cpu_hard_limit < 0 || task_group_info->cpu_hard_limit > 100) {
+        return Status::InvalidArgument("invalid cpu hard limit {}% of task group {}",
+                                       task_group_info->cpu_hard_limit, task_group_info->name);
+    }
+    return Status::OK();
+}
 
 std::string TaskGroup::debug_string() const {
-    return fmt::format("TG[id = {}, name = {}, share = {}", _id, _name, share());
+    return fmt::format("TG[id = {}, name = {}, share = {}, cpu_hard_limit = {}%", _id, _name,
+                       share(), cpu_hard_limit());
 }
 
 } // namespace taskgroup
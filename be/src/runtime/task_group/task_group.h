@@ -15,12 +15,17 @@
 // specific language governing permissions and limitations
 // under the License.
 #pragma once
+#include <atomic>
 #include <queue>
 
+#include "common/status.h"
 #include "olap/olap_define.h"
+#include "util/metrics.h"
 
 namespace doris {
 
+class TPipelineTaskGroup;
+
 namespace pipeline {
 class PipelineTask;
 }
@@ -41,39 +46,87 @@ public:
 
     void incr_runtime_ns(uint64_t runtime_ns);
 
+    // Returns true if the group has used up its cpu quota `quota_ns` in the current window of
+    // `window_ns`, a quota_ns of 0 means no limit. The cpu time used over the quota is charged
+    // to the following windows, so the group may be throttled for more than one window.
+    bool is_throttled(int64_t now_ns, int64_t window_ns, int64_t quota_ns);
+
+    // The time the current quota window ends.
+    int64_t window_end_ns(int64_t window_ns) const { return _window_start_ns + window_ns; }
+
     void adjust_vruntime_ns(uint64_t vruntime_ns);
 
     size_t task_size() const { return _queue.size(); }
 
     uint64_t cpu_share() const;
 
+    int cpu_hard_limit() const;
+
     std::string debug_string() const;
 
 private:
+    struct QueuedTask {
+        pipeline::PipelineTask* task;
+        int64_t enqueue_time_ns;
+    };
+
     // TODO pipeline use MLFQ
-    std::queue<pipeline::PipelineTask*> _queue;
+    std::queue<QueuedTask> _queue;
     taskgroup::TaskGroup* _tg;
     uint64_t _vruntime_ns = 0;
+
+    // cpu time charged to the current quota window
+    int64_t _window_runtime_ns = 0;
+    int64_t _window_start_ns = 0;
+    bool _throttled_in_window = false;
 };
 
 using TGEntityPtr = TaskGroupEntity*;
 
+struct TaskGroupInfo {
+    uint64_t id;
+    std::string name;
+    uint64_t cpu_share;
+    int cpu_hard_limit;
+
+    static Status parse_group_info(const TPipelineTaskGroup& resource_group,
+                                   TaskGroupInfo* task_group_info);
+};
+
 class TaskGroup {
 public:
-    TaskGroup(uint64_t id, std::string name, uint64_t cpu_share);
+    TaskGroup(uint64_t id, std::string name, uint64_t cpu_share, int cpu_hard_limit = 0);
+    ~TaskGroup();
 
     TaskGroupEntity* task_entity() { return &_task_entity; }
 
     uint64_t share() const { return _share; }
     uint64_t id() const { return _id; }
 
+    // The max cpu the tasks of the group may use, in percent of the cpu of all pipeline
+    // executors, 0 means no limit.
+    int cpu_hard_limit() const { return _cpu_hard_limit; }
+
+    // The cpu share is fixed once the group is created, it is summed up by the task queue
+    // while the group has tasks.
+    void set_cpu_hard_limit(int cpu_hard_limit) { _cpu_hard_limit = cpu_hard_limit; }
+
     std::string debug_string() const;
 
 private:
+    friend class TaskGroupEntity;
+
     uint64_t _id;
     std::string _name;
     uint64_t _share;
+    std::atomic<int> _cpu_hard_limit;
     TaskGroupEntity _task_entity;
+
+    std::shared_ptr<MetricEntity> _metric_entity;
+    IntCounter* task_group_cpu_time_ns;
+    HistogramMetric* task_group_queue_wait_us;
+    IntCounter* task_group_scheduled_tasks;
+    IntCounter* task_group_throttled_count;
 };
 
 using TaskGroupPtr = std::shared_ptr<TaskGroup>;
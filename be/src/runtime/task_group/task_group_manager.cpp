@@ -17,6 +17,8 @@
 
 #include "task_group_manager.h"
 
+#include "common/config.h"
+
 namespace doris::taskgroup {
 
 TaskGroupManager::TaskGroupManager() {
@@ -39,14 +41,37 @@ TaskGroupPtr TaskGroupManager::get_task_group(uint64_t id) {
     }
 }
 
+TaskGroupPtr TaskGroupManager::get_or_create_task_group(const TaskGroupInfo& task_group_info) {
+    {
+        std::shared_lock<std::shared_mutex> r_lock(_group_mutex);
+        auto it = _task_groups.find(task_group_info.id);
+        if (it != _task_groups.end()) {
+            it->second->set_cpu_hard_limit(task_group_info.cpu_hard_limit);
+            return it->second;
+        }
+    }
+    std::lock_guard<std::shared_mutex> w_lock(_group_mutex);
+    auto& task_group = _task_groups[task_group_info.id];
+    if (task_group) {
+        task_group->set_cpu_hard_limit(task_group_info.cpu_hard_limit);
+    } else {
+        task_group = std::make_shared<TaskGroup>(task_group_info.id, task_group_info.name,
+                                                 task_group_info.cpu_share,
+                                                 task_group_info.cpu_hard_limit);
+    }
+    return task_group;
+}
+
 void TaskGroupManager::_create_default_task_group() {
     _task_groups[DEFAULT_TG_ID] =
-            std::make_shared<TaskGroup>(DEFAULT_TG_ID, "default_tg", DEFAULT_TG_CPU_SHARE);
+            std::make_shared<TaskGroup>(DEFAULT_TG_ID, "default_tg", DEFAULT_TG_CPU_SHARE,
+                                        config::pipeline_default_task_group_cpu_hard_limit);
 }
 
 void TaskGroupManager::_create_short_task_group() {
     _task_groups[SHORT_TG_ID] =
-            std::make_shared<TaskGroup>(SHORT_TG_ID, "short_tg", SHORT_TG_CPU_SHARE);
+            std::make_shared<TaskGroup>(SHORT_TG_ID, "short_tg", SHORT_TG_CPU_SHARE,
+                                        config::pipeline_short_task_group_cpu_hard_limit);
 }
 
 } // namespace doris::taskgroup
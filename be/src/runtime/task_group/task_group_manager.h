@@ -32,6 +32,10 @@ public:
     // TODO pipeline task group
     TaskGroupPtr get_task_group(uint64_t id);
 
+    // Returns the task group of `task_group_info`, it is created if it does not exist yet,
+    // otherwise its cpu hard limit is updated.
+    TaskGroupPtr get_or_create_task_group(const TaskGroupInfo& task_group_info);
+
     static constexpr uint64_t DEFAULT_TG_ID = 0;
     static constexpr uint64_t DEFAULT_TG_CPU_SHARE = 64;
 
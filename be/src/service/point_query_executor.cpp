@@ -79,16 +79,17 @@ void Reusable::return_block(std::unique_ptr<vectorized::Block>& block) {
 
 RowCache* RowCache::_s_instance = nullptr;
 
-RowCache::RowCache(int64_t capacity, int num_shards) {
+RowCache::RowCache(int64_t capacity, CacheAdmissionPolicy policy, int num_shards) {
     // Create Row Cache
     _cache = std::unique_ptr<Cache>(
-            new_lru_cache("RowCache", capacity, LRUCacheType::SIZE, num_shards));
+            new_lru_cache("RowCache", capacity, LRUCacheType::SIZE, num_shards, policy));
 }
 
 // Create global instance of this class
-void RowCache::create_global_cache(int64_t capacity, uint32_t num_shards) {
+void RowCache::create_global_cache(int64_t capacity, CacheAdmissionPolicy policy,
+                                   uint32_t num_shards) {
     DCHECK(_s_instance == nullptr);
-    static RowCache instance(capacity, num_shards);
+    static RowCache instance(capacity, policy, num_shards);
     _s_instance = &instance;
 }
 
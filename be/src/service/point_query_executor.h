@@ -23,6 +23,7 @@
 #include "common/status.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "gutil/int128.h"
+#include "olap/lru_cache.h"
 #include "olap/olap_common.h"
 #include "olap/rowset/rowset.h"
 #include "olap/tablet.h"
@@ -123,7 +124,9 @@ public:
     };
 
     // Create global instance of this class
-    static void create_global_cache(int64_t capacity, uint32_t num_shards = kDefaultNumShards);
+    static void create_global_cache(int64_t capacity,
+                                    CacheAdmissionPolicy policy = CacheAdmissionPolicy::LRU,
+                                    uint32_t num_shards = kDefaultNumShards);
 
     static RowCache* instance();
 
@@ -144,7 +147,8 @@ public:
 
 private:
     static constexpr uint32_t kDefaultNumShards = 128;
-    RowCache(int64_t capacity, int num_shards = kDefaultNumShards);
+    RowCache(int64_t capacity, CacheAdmissionPolicy policy = CacheAdmissionPolicy::LRU,
+             int num_shards = kDefaultNumShards);
     static RowCache* _s_instance;
     std::unique_ptr<Cache> _cache = nullptr;
 };
@@ -41,6 +41,8 @@
 #include "runtime/large_int_value.h"
 #include "util/arrow/utils.h"
 #include "util/types.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
 
 namespace doris {
 
@@ -147,6 +149,20 @@ Status convert_to_arrow_schema(const RowDescriptor& row_desc,
     return Status::OK();
 }
 
+Status convert_expr_ctxs_arrow_schema(
+        const std::vector<vectorized::VExprContext*>& output_vexpr_ctxs,
+        std::shared_ptr<arrow::Schema>* result) {
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    for (auto expr_ctx : output_vexpr_ctxs) {
+        std::shared_ptr<arrow::DataType> type;
+        RETURN_IF_ERROR(convert_to_arrow_type(expr_ctx->root()->type(), &type));
+        fields.push_back(
+                arrow::field(expr_ctx->root()->expr_name(), type, expr_ctx->root()->is_nullable()));
+    }
+    *result = arrow::schema(std::move(fields));
+    return Status::OK();
+}
+
 Status serialize_record_batch(const arrow::RecordBatch& record_batch, std::string* result) {
     // create sink memory buffer outputstream with the computed capacity
     int64_t capacity;
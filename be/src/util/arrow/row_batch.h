@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "common/status.h"
 
@@ -38,10 +39,19 @@ namespace doris {
 class ObjectPool;
 class RowDescriptor;
 
+namespace vectorized {
+class VExprContext;
+} // namespace vectorized
+
 // Convert Doris RowDescriptor to Arrow Schema.
 Status convert_to_arrow_schema(const RowDescriptor& row_desc,
                                std::shared_ptr<arrow::Schema>* result);
 
+// Convert the result types of the output exprs of a result sink to Arrow Schema.
+Status convert_expr_ctxs_arrow_schema(
+        const std::vector<vectorized::VExprContext*>& output_vexpr_ctxs,
+        std::shared_ptr<arrow::Schema>* result);
+
 Status serialize_record_batch(const arrow::RecordBatch& record_batch, std::string* result);
 
 } // namespace doris
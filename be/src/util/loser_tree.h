@@ -0,0 +1,157 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "common/compiler_util.h"
+#include "common/logging.h"
+
+namespace doris {
+
+// A tournament tree of losers for k-way merges. Each inner node keeps the loser of the
+// match played there and the winner goes up, so the overall winner is at the top. When
+// the top moves to its next element, only the matches on the path from its leaf to the
+// root are replayed, that is log2(k) comparisons, while a binary heap does up to 2*log2(k).
+//
+// `Less(a, b)` returns true if `a` should come out before `b`. Every comparison is between
+// two different children, so a Less with side effects (e.g. marking the loser of equal
+// keys) sees the same pairs a full merge would.
+//
+// Usage:
+//   LoserTree<Cursor*, CursorLess> tree(less);
+//   tree.init(cursors);
+//   while (!tree.empty()) {
+//       ... consume tree.top() ...
+//       advanced ? tree.update_top() : tree.remove_top();
+//   }
+template <typename T, typename Less>
+class LoserTree {
+public:
+    explicit LoserTree(const Less& less = Less()) : _less(less) {}
+
+    // Builds the tree with O(k) comparisons.
+    void init(std::vector<T> items) {
+        _items = std::move(items);
+        _num_items = _items.size();
+        _num_active = _num_items;
+        _active.assign(_num_items, true);
+        _losers.assign(_num_items, 0);
+        if (_num_items == 0) {
+            return;
+        }
+        // node n plays between the winners of nodes 2n and 2n + 1, the nodes
+        // [k, 2k) are the leaves
+        std::vector<size_t> winners(_num_items, 0);
+        for (size_t node = _num_items - 1; node >= 1; --node) {
+            size_t left = _winner_of(2 * node, winners);
+            size_t right = _winner_of(2 * node + 1, winners);
+            if (_beats(right, left)) {
+                std::swap(left, right);
+            }
+            winners[node] = left;
+            _losers[node] = right;
+        }
+        _losers[0] = _winner_of(1, winners);
+    }
+
+    bool empty() const { return _num_active == 0; }
+
+    size_t size() const { return _num_active; }
+
+    T& top() { return _items[_losers[0]]; }
+
+    const T& top() const { return _items[_losers[0]]; }
+
+    // The index in the vector of init() of the top.
+    size_t top_index() const { return _losers[0]; }
+
+    // Call after the top has moved to its next element.
+    void update_top() { _replay(_losers[0]); }
+
+    // Call after the top has been used up, it will never be the top again.
+    void remove_top() {
+        DCHECK(!empty());
+        _active[_losers[0]] = false;
+        --_num_active;
+        _replay(_losers[0]);
+    }
+
+    // The item that would be the top if the top were removed, nullptr if there is none.
+    // The winner played every other item on its way up directly or through one of the
+    // losers on its path, so this takes log2(k) comparisons.
+    T* runner_up() {
+        size_t top = _losers[0];
+        size_t best = top;
+        for (size_t node = (top + _num_items) / 2; node >= 1; node /= 2) {
+            size_t loser = _losers[node];
+            if (_active[loser] && (best == top || _beats(loser, best))) {
+                best = loser;
+            }
+        }
+        return best == top ? nullptr : &_items[best];
+    }
+
+    // Calls `f` on the items that have not been removed.
+    template <typename Func>
+    void for_each_active(Func&& f) {
+        for (size_t i = 0; i < _num_items; ++i) {
+            if (_active[i]) {
+                f(_items[i]);
+            }
+        }
+    }
+
+private:
+    size_t _winner_of(size_t node, const std::vector<size_t>& winners) const {
+        return node >= _num_items ? node - _num_items : winners[node];
+    }
+
+    // Removed items lose to every item.
+    bool _beats(size_t lhs, size_t rhs) {
+        if (UNLIKELY(!_active[lhs])) {
+            return false;
+        }
+        if (UNLIKELY(!_active[rhs])) {
+            return true;
+        }
+        return _less(_items[lhs], _items[rhs]);
+    }
+
+    void _replay(size_t leaf) {
+        size_t winner = leaf;
+        for (size_t node = (leaf + _num_items) / 2; node >= 1; node /= 2) {
+            if (_beats(_losers[node], winner)) {
+                std::swap(_losers[node], winner);
+            }
+        }
+        _losers[0] = winner;
+    }
+
+    Less _less;
+    std::vector<T> _items;
+    size_t _num_items = 0;
+    size_t _num_active = 0;
+    std::vector<bool> _active;
+    // _losers[0] is the overall winner, _losers[n] the loser of the match at node n
+    std::vector<size_t> _losers;
+};
+
+} // namespace doris
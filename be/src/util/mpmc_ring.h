@@ -0,0 +1,126 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace doris {
+
+// A bounded lock-free queue for many producers and many consumers, from Dmitry Vyukov's
+// "Bounded MPMC queue". Each cell has a sequence number that tells whether it is ready to
+// be written for the current lap or ready to be read, so a producer and a consumer only
+// contend on the cell they use after winning the CAS on the tail or the head.
+//
+// try_push() fails instead of blocking when the ring is full, so the caller decides how to
+// apply back pressure.
+template <typename T>
+class MPMCRing {
+public:
+    explicit MPMCRing(int64_t capacity) {
+        int64_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _capacity = size;
+        _mask = size - 1;
+        _cells.reset(new Cell[size]);
+        for (int64_t i = 0; i < size; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCRing(const MPMCRing&) = delete;
+    MPMCRing& operator=(const MPMCRing&) = delete;
+
+    // Returns false if the ring is full, `item` is left untouched then.
+    bool try_push(T&& item) {
+        int64_t pos = _tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[pos & _mask];
+            int64_t diff = cell->sequence.load(std::memory_order_acquire) - pos;
+            if (diff == 0) {
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the cell still holds the item of the previous lap
+                return false;
+            } else {
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->item = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns false if the ring is empty.
+    bool try_pop(T* item) {
+        int64_t pos = _head.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[pos & _mask];
+            int64_t diff = cell->sequence.load(std::memory_order_acquire) - (pos + 1);
+            if (diff == 0) {
+                if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _head.load(std::memory_order_relaxed);
+            }
+        }
+        *item = std::move(cell->item);
+        cell->item = T();
+        cell->sequence.store(pos + _capacity, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate while other threads push or pop.
+    int64_t size() const {
+        int64_t tail = _tail.load(std::memory_order_acquire);
+        int64_t head = _head.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    bool full() const { return size() >= _capacity; }
+
+    int64_t capacity() const { return _capacity; }
+
+private:
+    struct Cell {
+        std::atomic<int64_t> sequence;
+        T item;
+    };
+
+    int64_t _capacity;
+    int64_t _mask;
+    std::unique_ptr<Cell[]> _cells;
+    // producers only write the tail and consumers only write the head
+    alignas(64) std::atomic<int64_t> _tail {0};
+    alignas(64) std::atomic<int64_t> _head {0};
+};
+
+} // namespace doris
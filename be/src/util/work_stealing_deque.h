@@ -0,0 +1,150 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace doris {
+
+// A lock-free work-stealing deque of pointers, from "Dynamic Circular Work-Stealing Deque"
+// (Chase and Lev, 2005) with the memory orders of "Correct and Efficient Work-Stealing for
+// Weak Memory Models" (Le et al., 2013).
+//
+// Only the owner thread may call push() and pop(), which work on the bottom of the deque.
+// Any thread, including the owner, may call steal(), which takes from the top, so a deque
+// whose owner only steals is a FIFO queue with one producer and many consumers.
+//
+// The buffer grows when it is full and never shrinks. The replaced buffers are kept until
+// the deque is destroyed, since a thief may still be reading them.
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_pointer_v<T>, "WorkStealingDeque only holds pointers");
+
+public:
+    explicit WorkStealingDeque(int64_t capacity = 1024) {
+        int64_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _buffers.emplace_back(new Buffer(size));
+        _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only.
+    void push(T item) {
+        int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        int64_t top = _top.load(std::memory_order_acquire);
+        Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->capacity - 1) {
+            buffer = _grow(buffer, bottom, top);
+        }
+        buffer->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only, takes the item pushed last. Returns nullptr if the deque is empty.
+    T pop() {
+        int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = _top.load(std::memory_order_relaxed);
+        T item = nullptr;
+        if (top <= bottom) {
+            item = buffer->get(bottom);
+            if (top == bottom) {
+                // the last item, race with the thieves for it
+                if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+        } else {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Takes the item pushed first. Returns nullptr if the deque is empty or if another
+    // thread took the item at the same time, the caller may retry if size() > 0.
+    T steal() {
+        int64_t top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = _bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+        Buffer* buffer = _buffer.load(std::memory_order_acquire);
+        T item = buffer->get(top);
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    // Approximate when called by a thread other than the owner.
+    int64_t size() const {
+        int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        int64_t top = _top.load(std::memory_order_relaxed);
+        return bottom > top ? bottom - top : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    struct Buffer {
+        explicit Buffer(int64_t capacity_)
+                : capacity(capacity_), mask(capacity_ - 1), items(new std::atomic<T>[capacity_]) {}
+
+        T get(int64_t i) const { return items[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T item) { items[i & mask].store(item, std::memory_order_relaxed); }
+
+        const int64_t capacity;
+        const int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+    Buffer* _grow(Buffer* buffer, int64_t bottom, int64_t top) {
+        auto* new_buffer = new Buffer(buffer->capacity * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            new_buffer->put(i, buffer->get(i));
+        }
+        _buffers.emplace_back(new_buffer);
+        _buffer.store(new_buffer, std::memory_order_release);
+        return new_buffer;
+    }
+
+    // top and bottom are on their own cache lines, thieves only write the top
+    alignas(64) std::atomic<int64_t> _top {0};
+    alignas(64) std::atomic<int64_t> _bottom {0};
+    alignas(64) std::atomic<Buffer*> _buffer {nullptr};
+    // owner only
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+};
+
+} // namespace doris
@@ -101,6 +101,16 @@ public:
     virtual void add_many(AggregateDataPtr __restrict place, const IColumn** columns,
                           std::vector<int>& rows, Arena* arena) const {}
 
+    /// Whether retract() is implemented. Used by window functions, so that a sliding frame
+    /// is updated by the rows entering and leaving it instead of being aggregated again.
+    virtual bool supports_retract() const { return false; }
+
+    /// Removes a value which was added by add() from the aggregation data.
+    virtual void retract(AggregateDataPtr __restrict place, const IColumn** columns,
+                         size_t row_num, Arena* arena) const {
+        LOG(FATAL) << "retract is not supported by aggregate function " << get_name();
+    }
+
     /// Merges state (on which place points to) with other state of current aggregation function.
     virtual void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
                        Arena* arena) const = 0;
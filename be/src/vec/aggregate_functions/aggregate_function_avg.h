@@ -118,6 +118,19 @@ public:
         ++this->data(place).count;
     }
 
+    bool supports_retract() const override { return !std::is_floating_point_v<T>; }
+
+    void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                 Arena*) const override {
+        const auto& column = static_cast<const ColVecType&>(*columns[0]);
+        if constexpr (IsDecimalNumber<T>) {
+            this->data(place).sum -= column.get_data()[row_num].value;
+        } else {
+            this->data(place).sum -= column.get_data()[row_num];
+        }
+        --this->data(place).count;
+    }
+
     void reset(AggregateDataPtr place) const override {
         this->data(place).sum = 0;
         this->data(place).count = 0;
@@ -50,6 +50,13 @@ public:
         ++data(place).count;
     }
 
+    bool supports_retract() const override { return true; }
+
+    void retract(AggregateDataPtr __restrict place, const IColumn**, size_t,
+                 Arena*) const override {
+        --data(place).count;
+    }
+
     void reset(AggregateDataPtr place) const override {
         AggregateFunctionCount::data(place).count = 0;
     }
@@ -139,6 +146,13 @@ public:
         data(place).count += !assert_cast<const ColumnNullable&>(*columns[0]).is_null_at(row_num);
     }
 
+    bool supports_retract() const override { return true; }
+
+    void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                 Arena*) const override {
+        data(place).count -= !assert_cast<const ColumnNullable&>(*columns[0]).is_null_at(row_num);
+    }
+
     void reset(AggregateDataPtr place) const override { data(place).count = 0; }
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
@@ -112,6 +112,10 @@ public:
 
     size_t align_of_data() const override { return nested_function->align_of_data(); }
 
+    /// retract() leaves the flag set, the caller resets the state when no not-NULL value
+    /// is left.
+    bool supports_retract() const override { return nested_function->supports_retract(); }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
                Arena* arena) const override {
         if (result_is_nullable && get_flag(rhs)) {
@@ -213,6 +217,16 @@ public:
         }
     }
 
+    void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                 Arena* arena) const override {
+        const ColumnNullable* column = assert_cast<const ColumnNullable*>(columns[0]);
+        if (!column->is_null_at(row_num)) {
+            const IColumn* nested_column = &column->get_nested_column();
+            this->nested_function->retract(this->nested_place(place), &nested_column, row_num,
+                                           arena);
+        }
+    }
+
     void add_batch(size_t batch_size, AggregateDataPtr* places, size_t place_offset,
                    const IColumn** columns, Arena* arena, bool agg_many) const override {
         const ColumnNullable* column = assert_cast<const ColumnNullable*>(columns[0]);
@@ -316,6 +330,27 @@ public:
         this->nested_function->add(this->nested_place(place), nested_columns, row_num, arena);
     }
 
+    void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                 Arena* arena) const override {
+        const IColumn* nested_columns[number_of_arguments];
+
+        for (size_t i = 0; i < number_of_arguments; ++i) {
+            if (is_nullable[i]) {
+                const ColumnNullable& nullable_col =
+                        assert_cast<const ColumnNullable&>(*columns[i]);
+                if (nullable_col.is_null_at(row_num)) {
+                    return;
+                }
+                nested_columns[i] = &nullable_col.get_nested_column();
+            } else {
+                nested_columns[i] = columns[i];
+            }
+        }
+
+        this->nested_function->retract(this->nested_place(place), nested_columns, row_num,
+                                       arena);
+    }
+
     bool allocates_memory_in_arena() const override {
         return this->nested_function->allocates_memory_in_arena();
     }
@@ -34,6 +34,8 @@ struct AggregateFunctionSumData {
 
     void add(T value) { sum += value; }
 
+    void retract(T value) { sum -= value; }
+
     void merge(const AggregateFunctionSumData& rhs) { sum += rhs.sum; }
 
     void write(BufferWritable& buf) const { write_binary(sum, buf); }
@@ -75,6 +77,15 @@ public:
         this->data(place).add(column.get_data()[row_num]);
     }
 
+    // retracting floating point values would accumulate rounding errors
+    bool supports_retract() const override { return !std::is_floating_point_v<TResult>; }
+
+    void retract(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
+                 Arena*) const override {
+        const auto& column = static_cast<const ColVecType&>(*columns[0]);
+        this->data(place).retract(column.get_data()[row_num]);
+    }
+
     void reset(AggregateDataPtr place) const override { this->data(place).sum = {}; }
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
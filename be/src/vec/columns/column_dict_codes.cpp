@@ -0,0 +1,356 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/columns/column_dict_codes.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_common.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/memcmp_small.h"
+#include "vec/common/typeid_cast.h"
+#include "vec/common/unaligned.h"
+
+namespace doris::vectorized {
+
+Int32 ColumnDictCodes::Dictionary::find_or_insert(const StringRef& value) {
+    if (!_index_built) {
+        _index.reserve(_values.size());
+        for (size_t i = 0; i < _values.size(); ++i) {
+            _index.emplace(_values[i], i);
+        }
+        _index_built = true;
+    }
+    auto it = _index.find(value);
+    if (it != _index.end()) {
+        return it->second;
+    }
+    insert_value(value);
+    return _values.size() - 1;
+}
+
+std::shared_ptr<ColumnDictCodes::Dictionary> ColumnDictCodes::Dictionary::clone() const {
+    auto res = std::make_shared<Dictionary>();
+    res->_values.reserve(_values.size());
+    for (const auto& value : _values) {
+        res->insert_value(value);
+    }
+    return res;
+}
+
+const ColumnDictCodes* ColumnDictCodes::get_dict_codes(const IColumn& column) {
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(column)) {
+        return check_and_get_column<ColumnDictCodes>(nullable->get_nested_column());
+    }
+    return check_and_get_column<ColumnDictCodes>(column);
+}
+
+ColumnPtr ColumnDictCodes::convert_to_string_column_if_dict_codes(const ColumnPtr& column) {
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+        if (const auto* codes =
+                    check_and_get_column<ColumnDictCodes>(nullable->get_nested_column())) {
+            return ColumnNullable::create(codes->convert_to_string_column(),
+                                          nullable->get_null_map_column_ptr());
+        }
+        return column;
+    }
+    if (const auto* codes = check_and_get_column<ColumnDictCodes>(*column)) {
+        return codes->convert_to_string_column();
+    }
+    return column;
+}
+
+MutableColumnPtr ColumnDictCodes::convert_to_string_column() const {
+    auto res = ColumnString::create();
+    res->reserve(_codes.size());
+    for (auto code : _codes) {
+        auto value = get_value(code);
+        res->insert_data(value.data, value.size);
+    }
+    return res;
+}
+
+ColumnDictCodes::Dictionary& ColumnDictCodes::_mutable_dictionary() {
+    if (_dict == nullptr) {
+        _dict = std::make_shared<Dictionary>();
+    } else if (_dict.use_count() > 1) {
+        _dict = _dict->clone();
+    }
+    // appending keeps the codes of the words copied from `_source_dict` unchanged
+    return const_cast<Dictionary&>(*_dict);
+}
+
+void ColumnDictCodes::insert_many_dict_data(const int32_t* data_array, size_t start_index,
+                                            const StringRef* dict_array, size_t data_num,
+                                            uint32_t dict_num) {
+    if (_source_dict != dict_array || _dict == nullptr) {
+        if (_codes.empty()) {
+            auto dict = std::make_shared<Dictionary>();
+            for (uint32_t i = 0; i < dict_num; ++i) {
+                dict->insert_value(dict_array[i]);
+            }
+            _dict = std::move(dict);
+            _source_dict = dict_array;
+        } else {
+            // the rows already in the column are coded by another dictionary
+            auto& dict = _mutable_dictionary();
+            for (size_t i = start_index; i < start_index + data_num; ++i) {
+                _codes.push_back(dict.find_or_insert(dict_array[data_array[i]]));
+            }
+            return;
+        }
+    }
+
+    size_t old_size = _codes.size();
+    _codes.resize(old_size + data_num);
+    memcpy(_codes.data() + old_size, data_array + start_index, data_num * sizeof(Int32));
+}
+
+void ColumnDictCodes::insert_range_from(const IColumn& src, size_t start, size_t length) {
+    const auto* src_codes = check_and_get_column<ColumnDictCodes>(src);
+    if (src_codes == nullptr) {
+        for (size_t i = start; i < start + length; ++i) {
+            auto value = src.get_data_at(i);
+            insert_data(value.data, value.size);
+        }
+        return;
+    }
+
+    if (_codes.empty() && src_codes->_dict != _dict) {
+        _dict = src_codes->_dict;
+        _source_dict = src_codes->_source_dict;
+        _rowset_segment_id = src_codes->_rowset_segment_id;
+    }
+    const auto& src_data = src_codes->_codes;
+    if (src_codes->_dict == _dict) {
+        _codes.insert(src_data.begin() + start, src_data.begin() + start + length);
+        return;
+    }
+
+    // map every word of the source dictionary once
+    std::vector<Int32> code_map(src_codes->_dict->size(), DEFAULT_CODE);
+    auto& dict = _mutable_dictionary();
+    for (size_t i = start; i < start + length; ++i) {
+        auto code = src_data[i];
+        if (code != DEFAULT_CODE) {
+            if (code_map[code] == DEFAULT_CODE) {
+                code_map[code] = dict.find_or_insert(src_codes->_dict->get_value(code));
+            }
+            code = code_map[code];
+        }
+        _codes.push_back(code);
+    }
+}
+
+void ColumnDictCodes::insert_indices_from(const IColumn& src, const int* indices_begin,
+                                          const int* indices_end) {
+    for (const auto* x = indices_begin; x != indices_end; ++x) {
+        if (*x == -1) {
+            insert_default();
+        } else {
+            insert_from(src, *x);
+        }
+    }
+}
+
+MutableColumnPtr ColumnDictCodes::clone_resized(size_t size) const {
+    auto res = ColumnDictCodes::create();
+    res->_dict = _dict;
+    res->_source_dict = _source_dict;
+    res->_rowset_segment_id = _rowset_segment_id;
+    size_t count = std::min(size, _codes.size());
+    res->_codes.insert(_codes.begin(), _codes.begin() + count);
+    res->insert_many_defaults(size - count);
+    return res;
+}
+
+ColumnPtr ColumnDictCodes::filter(const IColumn::Filter& filt, ssize_t result_size_hint) const {
+    if (_codes.size() != filt.size()) {
+        LOG(FATAL) << "Size of filter doesn't match size of column. data size: " << _codes.size()
+                   << ", filter size: " << filt.size();
+    }
+    auto res = clone_resized(0);
+    auto& res_codes = assert_cast<ColumnDictCodes&>(*res)._codes;
+    res_codes.reserve(result_size_hint > 0 ? result_size_hint : _codes.size());
+    for (size_t i = 0; i < _codes.size(); ++i) {
+        if (filt[i]) {
+            res_codes.push_back(_codes[i]);
+        }
+    }
+    return res;
+}
+
+size_t ColumnDictCodes::filter(const IColumn::Filter& filter) {
+    if (_codes.size() != filter.size()) {
+        LOG(FATAL) << "Size of filter doesn't match size of column. data size: " << _codes.size()
+                   << ", filter size: " << filter.size();
+    }
+    size_t new_size = 0;
+    for (size_t i = 0; i < _codes.size(); ++i) {
+        _codes[new_size] = _codes[i];
+        new_size += filter[i] != 0;
+    }
+    _codes.resize(new_size);
+    return new_size;
+}
+
+ColumnPtr ColumnDictCodes::permute(const IColumn::Permutation& perm, size_t limit) const {
+    limit = limit ? std::min(limit, _codes.size()) : _codes.size();
+    auto res = clone_resized(0);
+    auto& res_codes = assert_cast<ColumnDictCodes&>(*res)._codes;
+    res_codes.resize(limit);
+    for (size_t i = 0; i < limit; ++i) {
+        res_codes[i] = _codes[perm[i]];
+    }
+    return res;
+}
+
+StringRef ColumnDictCodes::serialize_value_into_arena(size_t n, Arena& arena,
+                                                      char const*& begin) const {
+    auto value = get_data_at(n);
+    uint32_t string_size(value.size);
+
+    StringRef res;
+    res.size = sizeof(string_size) + string_size;
+    char* pos = arena.alloc_continue(res.size, begin);
+    memcpy(pos, &string_size, sizeof(string_size));
+    memcpy(pos + sizeof(string_size), value.data, string_size);
+    res.data = pos;
+    return res;
+}
+
+const char* ColumnDictCodes::deserialize_and_insert_from_arena(const char* pos) {
+    const uint32_t string_size = unaligned_load<uint32_t>(pos);
+    pos += sizeof(string_size);
+    insert_data(pos, string_size);
+    return pos + string_size;
+}
+
+int ColumnDictCodes::compare_at(size_t n, size_t m, const IColumn& rhs, int) const {
+    const auto* rhs_codes = check_and_get_column<ColumnDictCodes>(rhs);
+    if (rhs_codes != nullptr && rhs_codes->_dict == _dict && _codes[n] == rhs_codes->_codes[m]) {
+        return 0;
+    }
+    auto lhs_value = get_data_at(n);
+    auto rhs_value = rhs.get_data_at(m);
+    return memcmp_small_allow_overflow15(lhs_value.data, lhs_value.size, rhs_value.data,
+                                         rhs_value.size);
+}
+
+void ColumnDictCodes::get_permutation(bool reverse, size_t limit, int /*nan_direction_hint*/,
+                                      IColumn::Permutation& res) const {
+    size_t s = _codes.size();
+    res.resize(s);
+    for (size_t i = 0; i < s; ++i) {
+        res[i] = i;
+    }
+    if (limit >= s) {
+        limit = 0;
+    }
+
+    // the words are compared once to rank the codes, the rows are sorted by rank
+    size_t dict_size = _dict ? _dict->size() : 0;
+    std::vector<Int32> words(dict_size);
+    std::iota(words.begin(), words.end(), 0);
+    std::sort(words.begin(), words.end(),
+              [this](Int32 lhs, Int32 rhs) { return get_value(lhs) < get_value(rhs); });
+    // the default code, the empty string, ranks before all the words
+    std::vector<Int32> ranks(dict_size + 1, 0);
+    for (size_t i = 0; i < dict_size; ++i) {
+        // equal words share a rank, the dictionary may hold the empty string too
+        StringRef prev_value = i == 0 ? StringRef() : get_value(words[i - 1]);
+        Int32 prev_rank = i == 0 ? 0 : ranks[words[i - 1] + 1];
+        ranks[words[i] + 1] = get_value(words[i]) == prev_value ? prev_rank : i + 1;
+    }
+    auto rank = [&](size_t row) { return ranks[_codes[row] + 1]; };
+    auto less = [&](size_t lhs, size_t rhs) {
+        return reverse ? rank(lhs) > rank(rhs) : rank(lhs) < rank(rhs);
+    };
+    if (limit) {
+        std::partial_sort(res.begin(), res.begin() + limit, res.end(), less);
+    } else {
+        std::sort(res.begin(), res.end(), less);
+    }
+}
+
+ColumnPtr ColumnDictCodes::replicate(const IColumn::Offsets& replicate_offsets) const {
+    size_t col_size = size();
+    if (col_size != replicate_offsets.size()) {
+        LOG(FATAL) << "Size of offsets doesn't match size of column.";
+    }
+    auto res = clone_resized(0);
+    if (col_size == 0) {
+        return res;
+    }
+    auto& res_codes = assert_cast<ColumnDictCodes&>(*res)._codes;
+    res_codes.reserve(replicate_offsets.back());
+    IColumn::Offset prev_offset = 0;
+    for (size_t i = 0; i < col_size; ++i) {
+        res_codes.resize_fill(res_codes.size() + replicate_offsets[i] - prev_offset, _codes[i]);
+        prev_offset = replicate_offsets[i];
+    }
+    return res;
+}
+
+void ColumnDictCodes::get_extremes(Field& min, Field& max) const {
+    min = String();
+    max = String();
+    if (_codes.empty()) {
+        return;
+    }
+    size_t min_idx = 0;
+    size_t max_idx = 0;
+    for (size_t i = 1; i < _codes.size(); ++i) {
+        if (get_data_at(i) < get_data_at(min_idx)) {
+            min_idx = i;
+        } else if (get_data_at(max_idx) < get_data_at(i)) {
+            max_idx = i;
+        }
+    }
+    get(min_idx, min);
+    get(max_idx, max);
+}
+
+template <typename Type>
+ColumnPtr ColumnDictCodes::index_impl(const PaddedPODArray<Type>& indexes, size_t limit) const {
+    auto res = clone_resized(0);
+    auto& res_codes = assert_cast<ColumnDictCodes&>(*res)._codes;
+    res_codes.resize(limit);
+    for (size_t i = 0; i < limit; ++i) {
+        res_codes[i] = _codes[indexes[i]];
+    }
+    return res;
+}
+
+ColumnPtr ColumnDictCodes::index(const IColumn& indexes, size_t limit) const {
+    return select_index_impl(*this, indexes, limit);
+}
+
+void ColumnDictCodes::set_rowset_segment_id(std::pair<RowsetId, uint32_t> rowset_segment_id) {
+    if (_rowset_segment_id != rowset_segment_id) {
+        // the page dictionary of another segment may be allocated at the same address
+        _rowset_segment_id = rowset_segment_id;
+        _source_dict = nullptr;
+        if (_codes.empty()) {
+            _dict.reset();
+        }
+    }
+}
+
+} // namespace doris::vectorized
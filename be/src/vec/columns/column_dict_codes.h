@@ -0,0 +1,259 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+
+#include <memory>
+#include <vector>
+
+#include "olap/olap_common.h"
+#include "vec/columns/column.h"
+#include "vec/columns/column_impl.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/arena.h"
+#include "vec/common/pod_array.h"
+#include "vec/common/string_ref.h"
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+/**
+ * ColumnDictCodes carries a string column read from fully dictionary-encoded segments
+ * up from the storage layer as the codes of the segment dictionary, so that operators
+ * like AggregationNode can work on each word of the dictionary once instead of on every
+ * row, and decode the strings only at the end.
+ *
+ * Unlike ColumnDictionary, the dictionary is copied out of the page memory the first
+ * time codes are inserted, so the column stays valid after the segment is closed, and
+ * it is shared by the columns cut from this one. The code -1 stands for the default
+ * value, the empty string.
+ *
+ * The operations working on the codes are cheap. The others work on the strings the
+ * codes stand for, operators doing much of them should call `convert_to_string_column()`
+ * first.
+ */
+class ColumnDictCodes final : public COWHelper<IColumn, ColumnDictCodes> {
+private:
+    friend class COWHelper<IColumn, ColumnDictCodes>;
+
+    ColumnDictCodes() = default;
+    ColumnDictCodes(const ColumnDictCodes& src)
+            : _codes(src._codes.begin(), src._codes.end()),
+              _dict(src._dict),
+              _source_dict(src._source_dict),
+              _rowset_segment_id(src._rowset_segment_id) {}
+
+public:
+    using Codes = PaddedPODArray<Int32>;
+    static constexpr Int32 DEFAULT_CODE = -1;
+
+    // The words of a dictionary, immutable once shared by more than one column.
+    class Dictionary {
+    public:
+        size_t size() const { return _values.size(); }
+
+        const StringRef& get_value(Int32 code) const { return _values[code]; }
+
+        void insert_value(const StringRef& value) {
+            _values.emplace_back(_arena.insert(value.data, value.size), value.size);
+            if (_index_built) {
+                _index.emplace(_values.back(), _values.size() - 1);
+            }
+        }
+
+        // Returns the code of `value`, inserts it first if it is not in the dictionary.
+        Int32 find_or_insert(const StringRef& value);
+
+        size_t allocated_bytes() const {
+            return _arena.size() + _values.capacity() * sizeof(StringRef) +
+                   _index.capacity() * (sizeof(StringRef) + sizeof(Int32));
+        }
+
+        std::shared_ptr<Dictionary> clone() const;
+
+    private:
+        Arena _arena;
+        std::vector<StringRef> _values;
+        // built on the first lookup by value
+        phmap::flat_hash_map<StringRef, Int32, StringRefHash> _index;
+        bool _index_built = false;
+    };
+    using DictionaryPtr = std::shared_ptr<const Dictionary>;
+
+    // Returns the ColumnDictCodes of `column` or of its nested column, nullptr if there is none.
+    static const ColumnDictCodes* get_dict_codes(const IColumn& column);
+
+    // Decodes the codes of `column` (or of its nested column) into strings,
+    // other columns are returned as is.
+    static ColumnPtr convert_to_string_column_if_dict_codes(const ColumnPtr& column);
+
+    const char* get_family_name() const override { return "ColumnDictCodes"; }
+
+    size_t size() const override { return _codes.size(); }
+
+    Codes& get_data() { return _codes; }
+
+    const Codes& get_data() const { return _codes; }
+
+    const DictionaryPtr& get_dictionary() const { return _dict; }
+
+    StringRef get_value(Int32 code) const {
+        return code == DEFAULT_CODE ? StringRef() : _dict->get_value(code);
+    }
+
+    StringRef get_data_at(size_t n) const override { return get_value(_codes[n]); }
+
+    Field operator[](size_t n) const override {
+        auto value = get_data_at(n);
+        return Field(value.data, value.size);
+    }
+
+    void get(size_t n, Field& res) const override { res = (*this)[n]; }
+
+    MutableColumnPtr convert_to_string_column() const;
+
+    void insert_many_dict_data(const int32_t* data_array, size_t start_index,
+                               const StringRef* dict_array, size_t data_num,
+                               uint32_t dict_num) override;
+
+    void insert_default() override { _codes.push_back(DEFAULT_CODE); }
+
+    void insert_many_defaults(size_t length) override {
+        _codes.resize_fill(_codes.size() + length, DEFAULT_CODE);
+    }
+
+    void insert_data(const char* pos, size_t length) override {
+        _codes.push_back(_mutable_dictionary().find_or_insert(StringRef(pos, length)));
+    }
+
+    void insert_from(const IColumn& src, size_t n) override { insert_range_from(src, n, 1); }
+
+    void insert_range_from(const IColumn& src, size_t start, size_t length) override;
+
+    void insert_indices_from(const IColumn& src, const int* indices_begin,
+                             const int* indices_end) override;
+
+    void insert(const Field& x) override {
+        const String& value = doris::vectorized::get<const String&>(x);
+        insert_data(value.data(), value.size());
+    }
+
+    void pop_back(size_t n) override { _codes.resize_assume_reserved(_codes.size() - n); }
+
+    // The dictionary is kept, the codes inserted next are likely from the same segment.
+    void clear() override { _codes.clear(); }
+
+    void reserve(size_t n) override { _codes.reserve(n); }
+
+    size_t byte_size() const override { return _codes.size() * sizeof(Int32); }
+
+    size_t allocated_bytes() const override {
+        return _codes.allocated_bytes() + (_dict ? _dict->allocated_bytes() : 0);
+    }
+
+    void protect() override { _codes.protect(); }
+
+    MutableColumnPtr clone_resized(size_t size) const override;
+
+    ColumnPtr filter(const IColumn::Filter& filt, ssize_t result_size_hint) const override;
+
+    size_t filter(const IColumn::Filter& filter) override;
+
+    ColumnPtr permute(const IColumn::Permutation& perm, size_t limit) const override;
+
+    bool can_be_inside_nullable() const override { return true; }
+
+    void set_rowset_segment_id(std::pair<RowsetId, uint32_t> rowset_segment_id) override;
+
+    std::pair<RowsetId, uint32_t> get_rowset_segment_id() const override {
+        return _rowset_segment_id;
+    }
+
+    // The values are serialized and compared as the strings they stand for, in the same
+    // way as ColumnString, so the column works with the operators which do not look at
+    // the codes, only slower.
+    StringRef serialize_value_into_arena(size_t n, Arena& arena,
+                                         char const*& begin) const override;
+
+    const char* deserialize_and_insert_from_arena(const char* pos) override;
+
+    void update_hash_with_value(size_t n, SipHash& hash) const override {
+        auto value = get_data_at(n);
+        hash.update(reinterpret_cast<const char*>(&value.size), sizeof(value.size));
+        hash.update(value.data, value.size);
+    }
+
+    int compare_at(size_t n, size_t m, const IColumn& rhs, int nan_direction_hint) const override;
+
+    void get_permutation(bool reverse, size_t limit, int nan_direction_hint,
+                         IColumn::Permutation& res) const override;
+
+    ColumnPtr replicate(const IColumn::Offsets& replicate_offsets) const override;
+
+    MutableColumns scatter(IColumn::ColumnIndex num_columns,
+                           const IColumn::Selector& selector) const override {
+        return scatter_impl<ColumnDictCodes>(num_columns, selector);
+    }
+
+    void append_data_by_selector(MutableColumnPtr& res,
+                                 const IColumn::Selector& selector) const override {
+        append_data_by_selector_impl<ColumnDictCodes>(res, selector);
+    }
+
+    void get_extremes(Field& min, Field& max) const override;
+
+    bool is_default_at(size_t n) const override { return get_data_at(n).size == 0; }
+
+    void get_indices_of_non_default_rows(IColumn::Offsets64& indices, size_t from,
+                                         size_t limit) const override {
+        get_indices_of_non_default_rows_impl<ColumnDictCodes>(indices, from, limit);
+    }
+
+    ColumnPtr index(const IColumn& indexes, size_t limit) const override;
+
+    template <typename Type>
+    ColumnPtr index_impl(const PaddedPODArray<Type>& indexes, size_t limit) const;
+
+    bool structure_equals(const IColumn& rhs) const override {
+        return typeid(rhs) == typeid(ColumnDictCodes);
+    }
+
+    void replace_column_data(const IColumn& rhs, size_t row, size_t self_row = 0) override {
+        DCHECK(size() > self_row);
+        auto value = rhs.get_data_at(row);
+        _codes[self_row] = _mutable_dictionary().find_or_insert(value);
+    }
+
+    void replace_column_data_default(size_t self_row = 0) override {
+        DCHECK(size() > self_row);
+        _codes[self_row] = DEFAULT_CODE;
+    }
+
+private:
+    // Copies the dictionary before it is changed if it is shared with other columns.
+    Dictionary& _mutable_dictionary();
+
+    Codes _codes;
+    DictionaryPtr _dict;
+    // the dictionary of the page decoder `_dict` is copied from
+    const StringRef* _source_dict = nullptr;
+    std::pair<RowsetId, uint32_t> _rowset_segment_id;
+};
+
+} // namespace doris::vectorized
@@ -98,6 +98,26 @@ public:
         }
     }
 
+    bool is_partitioned() const { return _is_partitioned; }
+
+    static constexpr size_t get_sub_table_count() { return NUM_LEVEL1_SUB_TABLES; }
+
+    static size_t get_sub_table_index(size_t hash_value) {
+        return get_sub_table_from_hash(hash_value);
+    }
+
+    /// Calls func(key, mapped) for the cells of one level1 sub table until it returns false, so
+    /// that the sub tables of a partitioned table can be iterated by different threads.
+    template <typename Func>
+    void for_each_value_of_sub_table(size_t sub_table_idx, Func&& func) {
+        DCHECK(_is_partitioned);
+        for (auto& v : level1_sub_tables[sub_table_idx]) {
+            if (!func(v.get_first(), v.get_second())) {
+                return;
+            }
+        }
+    }
+
     template <typename Func>
     void ALWAYS_INLINE for_each_value(Func&& func) {
         if (_is_partitioned) {
@@ -52,16 +52,15 @@ Status MergeSorterState::add_sorted_block(Block& block) {
     if (is_spilled_ || (external_sort_bytes_threshold_ > 0 &&
                         total_bytes_used >= external_sort_bytes_threshold_)) {
         is_spilled_ = true;
-        BlockSpillWriterUPtr spill_block_writer;
+        RETURN_IF_ERROR(_close_spill_block_writer());
         RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
-                spill_block_batch_size_, spill_block_writer, block_spill_profile_));
+                spill_block_batch_size_, spill_block_writer_, block_spill_profile_));
 
-        RETURN_IF_ERROR(spill_block_writer->write(block));
-        spilled_sorted_block_streams_.emplace_back(spill_block_writer->get_id());
+        RETURN_IF_ERROR(spill_block_writer_->write(block));
+        spilled_sorted_block_streams_.emplace_back(spill_block_writer_->get_id());
 
         COUNTER_UPDATE(spilled_block_count_, 1);
-        COUNTER_UPDATE(spilled_original_block_size_, spill_block_writer->get_written_bytes());
-        RETURN_IF_ERROR(spill_block_writer->close());
+        COUNTER_UPDATE(spilled_original_block_size_, spill_block_writer_->get_written_bytes());
 
         if (init_merge_sorted_block_) {
             init_merge_sorted_block_ = false;
@@ -84,7 +83,17 @@ void MergeSorterState::_build_merge_tree_not_spilled(const SortDescription& sort
     }
 }
 
+Status MergeSorterState::_close_spill_block_writer() {
+    if (!spill_block_writer_) {
+        return Status::OK();
+    }
+    auto status = spill_block_writer_->close();
+    spill_block_writer_.reset();
+    return status;
+}
+
 Status MergeSorterState::build_merge_tree(const SortDescription& sort_description) {
+    RETURN_IF_ERROR(_close_spill_block_writer());
     _build_merge_tree_not_spilled(sort_description);
 
     if (spilled_sorted_block_streams_.size() > 0) {
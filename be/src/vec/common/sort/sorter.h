@@ -73,6 +73,12 @@ public:
 
     bool is_spilled() const { return is_spilled_; }
 
+    // The writer of the last spilled block is closed lazily, so that its I/O
+    // overlaps with sorting the following blocks.
+    bool can_add_sorted_block() const {
+        return !spill_block_writer_ || spill_block_writer_->can_write();
+    }
+
     const Block& last_sorted_block() const { return sorted_blocks_.back(); }
 
     std::unique_ptr<Block> unsorted_block_;
@@ -88,6 +94,8 @@ private:
 
     Status _create_intermediate_merger(int num_blocks, const SortDescription& sort_description);
 
+    Status _close_spill_block_writer();
+
     std::priority_queue<MergeSortCursor> priority_queue_;
     std::vector<MergeSortCursorImpl> cursors_;
     std::vector<Block> sorted_blocks_;
@@ -103,6 +111,7 @@ private:
     bool is_spilled_ = false;
     bool init_merge_sorted_block_ = true;
     std::deque<int64_t> spilled_sorted_block_streams_;
+    BlockSpillWriterUPtr spill_block_writer_;
     std::vector<BlockSpillReaderUPtr> spilled_block_readers_;
     Block merge_sorted_block_;
     std::unique_ptr<VSortedRunMerger> merger_;
@@ -142,6 +151,9 @@ public:
 
     virtual bool is_spilled() const { return false; }
 
+    // false if appending a block now would wait for spilled data to be written
+    virtual bool can_append_block() const { return true; }
+
     // for topn runtime predicate
     const SortDescription& get_sort_description() { return _sort_description; }
     virtual Field get_top_value() { return Field {Field::Types::Null}; }
@@ -182,6 +194,8 @@ public:
 
     bool is_spilled() const override { return _state->is_spilled(); }
 
+    bool can_append_block() const override { return _state->can_add_sorted_block(); }
+
 private:
     bool _reach_limit() {
         return _state->unsorted_block_->rows() > buffered_block_size_ ||
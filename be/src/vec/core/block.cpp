@@ -798,10 +798,14 @@ Status Block::serialize(int be_exec_version, PBlock* pblock,
     for (const auto& c : *this) {
         buf = c.type->serialize(*(c.column), buf, pblock->be_exec_version());
     }
+    // the encodings of be_exec_version 2 may write less than the estimated size
+    content_uncompressed_size = buf - column_values.data();
+    column_values.resize(content_uncompressed_size);
     *uncompressed_bytes = content_uncompressed_size;
 
     // compress
-    if (config::compress_rowbatches && content_uncompressed_size > 0) {
+    if (config::compress_rowbatches && content_uncompressed_size > 0 &&
+        compression_type != segment_v2::CompressionTypePB::NO_COMPRESSION) {
         SCOPED_RAW_TIMER(&_compress_time_ns);
         pblock->set_compression_type(compression_type);
         pblock->set_uncompressed_size(content_uncompressed_size);
@@ -21,6 +21,7 @@
 #include "io/fs/file_system.h"
 #include "io/fs/local_file_system.h"
 #include "olap/iterators.h"
+#include "pipeline/blocked_task_notifier.h"
 #include "runtime/block_spill_manager.h"
 
 namespace doris {
@@ -28,6 +29,7 @@ namespace vectorized {
 void BlockSpillReader::_init_profile() {
     read_time_ = ADD_TIMER(profile_, "ReadTime");
     deserialize_time_ = ADD_TIMER(profile_, "DeserializeTime");
+    wait_io_timer_ = ADD_TIMER(profile_, "WaitIOTime");
 }
 
 Status BlockSpillReader::open() {
@@ -73,9 +75,62 @@ Status BlockSpillReader::open() {
     }
     block_start_offsets_[block_count_] = file_size - (block_count_ + 2) * sizeof(size_t);
 
+    if (io_token_ && block_count_ > 0) {
+        prefetch_buff_.reset(new char[max_sub_block_size_]);
+        _submit_prefetch(0);
+    }
     return Status::OK();
 }
 
+void BlockSpillReader::_submit_prefetch(size_t block_index) {
+    {
+        std::lock_guard<std::mutex> l(io_lock_);
+        prefetching_ = true;
+    }
+    auto st = io_token_->submit_func([this, block_index]() {
+        size_t bytes_to_read =
+                block_start_offsets_[block_index + 1] - block_start_offsets_[block_index];
+        size_t bytes_read = 0;
+        Status status;
+        {
+            SCOPED_TIMER(read_time_);
+            status = file_reader_->read_at(block_start_offsets_[block_index],
+                                           Slice(prefetch_buff_.get(), bytes_to_read), &bytes_read);
+        }
+        if (status.ok() && bytes_read != bytes_to_read) {
+            status = Status::InternalError("Failed to read spilled block, expect {} bytes, got {}",
+                                           bytes_to_read, bytes_read);
+        }
+        {
+            std::lock_guard<std::mutex> l(io_lock_);
+            if (!status.ok() && io_status_.ok()) {
+                io_status_ = status;
+            }
+            prefetching_ = false;
+            io_cv_.notify_all();
+        }
+        // can_read() changed, it takes io_lock_ as well
+        pipeline::notify_blocked_tasks();
+    });
+    if (!st.ok()) {
+        std::lock_guard<std::mutex> l(io_lock_);
+        io_status_ = st;
+        prefetching_ = false;
+    }
+}
+
+Status BlockSpillReader::_wait_for_prefetch() {
+    SCOPED_TIMER(wait_io_timer_);
+    std::unique_lock<std::mutex> l(io_lock_);
+    io_cv_.wait(l, [this] { return !prefetching_; });
+    return io_status_;
+}
+
+bool BlockSpillReader::can_read() const {
+    std::lock_guard<std::mutex> l(io_lock_);
+    return !prefetching_;
+}
+
 // The returned block is owned by BlockSpillReader and is
 // destroyed when reading next block.
 Status BlockSpillReader::read(Block* block, bool* eos) {
@@ -89,16 +144,22 @@ Status BlockSpillReader::read(Block* block, bool* eos) {
 
     size_t bytes_to_read =
             block_start_offsets_[read_block_index_ + 1] - block_start_offsets_[read_block_index_];
-    Slice result(read_buff_.get(), bytes_to_read);
-
-    size_t bytes_read = 0;
 
-    {
+    if (io_token_) {
+        // the sub block has been read into prefetch_buff_, start reading the next one
+        RETURN_IF_ERROR(_wait_for_prefetch());
+        read_buff_.swap(prefetch_buff_);
+        if (read_block_index_ + 1 < block_count_) {
+            _submit_prefetch(read_block_index_ + 1);
+        }
+    } else {
+        size_t bytes_read = 0;
         SCOPED_TIMER(read_time_);
-        RETURN_IF_ERROR(file_reader_->read_at(block_start_offsets_[read_block_index_], result,
-                                              &bytes_read));
+        RETURN_IF_ERROR(file_reader_->read_at(block_start_offsets_[read_block_index_],
+                                              Slice(read_buff_.get(), bytes_to_read), &bytes_read));
+        DCHECK(bytes_read == bytes_to_read);
     }
-    DCHECK(bytes_read == bytes_to_read);
+    Slice result(read_buff_.get(), bytes_to_read);
 
     PBlock pb_block;
     BlockUPtr new_block = nullptr;
@@ -120,6 +181,9 @@ Status BlockSpillReader::close() {
     if (!file_reader_) {
         return Status::OK();
     }
+    if (io_token_) {
+        io_token_->wait();
+    }
     ExecEnv::GetInstance()->block_spill_mgr()->remove(stream_id_);
     file_reader_.reset();
     if (delete_after_read_) {
@@ -17,20 +17,29 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+
 #include "io/fs/file_reader.h"
+#include "util/threadpool.h"
 #include "vec/core/block.h"
 
 namespace doris {
 namespace vectorized {
 // Read data spilled to local file.
+//
+// If an I/O token is given, the next sub block is read ahead by the I/O thread
+// pool while the current one is deserialized and consumed.
 class BlockSpillReader {
 public:
     BlockSpillReader(int64_t stream_id, const std::string& file_path, RuntimeProfile* profile,
-                     bool delete_after_read = true)
+                     bool delete_after_read = true,
+                     std::unique_ptr<ThreadPoolToken> io_token = nullptr)
             : stream_id_(stream_id),
               file_path_(file_path),
               delete_after_read_(delete_after_read),
-              profile_(profile) {
+              profile_(profile),
+              io_token_(std::move(io_token)) {
         _init_profile();
     }
 
@@ -46,9 +55,16 @@ public:
 
     std::string get_path() const { return file_path_; }
 
+    // Returns false if the next read would have to wait for the read ahead.
+    bool can_read() const;
+
 private:
     void _init_profile();
 
+    void _submit_prefetch(size_t block_index);
+
+    Status _wait_for_prefetch();
+
     int64_t stream_id_;
     std::string file_path_;
     bool delete_after_read_;
@@ -58,11 +74,20 @@ private:
     size_t read_block_index_ = 0;
     size_t max_sub_block_size_ = 0;
     std::unique_ptr<char[]> read_buff_;
+    std::unique_ptr<char[]> prefetch_buff_;
     std::vector<size_t> block_start_offsets_;
 
     RuntimeProfile* profile_ = nullptr;
     RuntimeProfile::Counter* read_time_;
     RuntimeProfile::Counter* deserialize_time_;
+    RuntimeProfile::Counter* wait_io_timer_;
+
+    mutable std::mutex io_lock_;
+    std::condition_variable io_cv_;
+    bool prefetching_ = false;
+    Status io_status_;
+    // destroyed first, so that no task still running refers to the buffers
+    std::unique_ptr<ThreadPoolToken> io_token_;
 };
 
 using BlockSpillReaderUPtr = std::unique_ptr<BlockSpillReader>;
@@ -18,7 +18,9 @@
 #include "vec/core/block_spill_writer.h"
 
 #include "agent/be_exec_version_manager.h"
+#include "common/config.h"
 #include "io/file_factory.h"
+#include "pipeline/blocked_task_notifier.h"
 #include "runtime/runtime_state.h"
 
 namespace doris {
@@ -27,6 +29,7 @@ void BlockSpillWriter::_init_profile() {
     write_bytes_counter_ = ADD_COUNTER(profile_, "WriteBytes", TUnit::BYTES);
     write_timer_ = ADD_TIMER(profile_, "WriteTime");
     serialize_timer_ = ADD_TIMER(profile_, "SerializeTime");
+    wait_io_timer_ = ADD_TIMER(profile_, "WaitIOTime");
 }
 
 Status BlockSpillWriter::open() {
@@ -48,9 +51,9 @@ Status BlockSpillWriter::close() {
     meta_.append((const char*)&max_sub_block_size_, sizeof(max_sub_block_size_));
     meta_.append((const char*)&written_blocks_, sizeof(written_blocks_));
 
-    Status status;
+    Status status = _wait_for_pending_writes();
     // meta: block1 offset, block2 offset, ..., blockn offset, n
-    {
+    if (status.ok()) {
         SCOPED_TIMER(write_timer_);
         status = file_writer_->append(meta_);
     }
@@ -114,8 +117,7 @@ Status BlockSpillWriter::_write_internal(const Block& block) {
     {
         SCOPED_TIMER(serialize_timer_);
         status = block.serialize(BeExecVersionManager::get_newest_version(), &pblock,
-                                 &uncompressed_bytes, &compressed_bytes,
-                                 segment_v2::CompressionTypePB::LZ4);
+                                 &uncompressed_bytes, &compressed_bytes, compression_type_);
         if (!status.ok()) {
             unlink(file_path_.c_str());
             return status;
@@ -123,11 +125,8 @@ Status BlockSpillWriter::_write_internal(const Block& block) {
         pblock.SerializeToString(&buff);
     }
 
-    {
-        SCOPED_TIMER(write_timer_);
-        status = file_writer_->append(buff);
-        written_bytes = buff.size();
-    }
+    written_bytes = buff.size();
+    status = _append(std::move(buff));
     if (!status.ok()) {
         unlink(file_path_.c_str());
         return status;
@@ -143,5 +142,65 @@ Status BlockSpillWriter::_write_internal(const Block& block) {
     return Status::OK();
 }
 
+Status BlockSpillWriter::_append(std::string&& buff) {
+    if (!io_token_) {
+        SCOPED_TIMER(write_timer_);
+        return file_writer_->append(buff);
+    }
+
+    RETURN_IF_ERROR(_wait_for_pending_writes(_max_pending_writes() - 1));
+    {
+        std::lock_guard<std::mutex> l(io_lock_);
+        RETURN_IF_ERROR(io_status_);
+        ++pending_writes_;
+    }
+
+    auto data = std::make_shared<std::string>(std::move(buff));
+    auto st = io_token_->submit_func([this, data]() {
+        Status status;
+        {
+            SCOPED_TIMER(write_timer_);
+            status = file_writer_->append(*data);
+        }
+        {
+            std::lock_guard<std::mutex> l(io_lock_);
+            if (!status.ok() && io_status_.ok()) {
+                io_status_ = status;
+            }
+            --pending_writes_;
+            io_cv_.notify_all();
+        }
+        // can_write() changed, it takes io_lock_ as well
+        pipeline::notify_blocked_tasks();
+    });
+    if (!st.ok()) {
+        std::lock_guard<std::mutex> l(io_lock_);
+        --pending_writes_;
+    }
+    return st;
+}
+
+Status BlockSpillWriter::_wait_for_pending_writes(size_t max_pending_writes) {
+    if (!io_token_) {
+        return Status::OK();
+    }
+    std::unique_lock<std::mutex> l(io_lock_);
+    if (pending_writes_ > max_pending_writes) {
+        SCOPED_TIMER(wait_io_timer_);
+        io_cv_.wait(l, [&] { return pending_writes_ <= max_pending_writes || !io_status_.ok(); });
+    }
+    return io_status_;
+}
+
+bool BlockSpillWriter::can_write() const {
+    std::lock_guard<std::mutex> l(io_lock_);
+    // a failed write is returned by the next call instead of blocking the caller
+    return pending_writes_ < _max_pending_writes() || !io_status_.ok();
+}
+
+size_t BlockSpillWriter::_max_pending_writes() {
+    return std::max(config::spill_max_pending_sub_blocks, 1);
+}
+
 } // namespace vectorized
 } // namespace doris
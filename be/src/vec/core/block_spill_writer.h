@@ -17,7 +17,11 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+
 #include "io/fs/local_file_writer.h"
+#include "util/threadpool.h"
 #include "vec/core/block.h"
 namespace doris {
 namespace vectorized {
@@ -30,11 +34,24 @@ namespace vectorized {
 // Split to small blocks is necessary for Sort node, which need to merge multiple
 // spilled big sorted blocks into a bigger sorted block. A small block is read from each
 // spilled block file each time.
+//
+// If an I/O token is given, sub blocks are serialized on the calling thread and
+// appended to the file by the I/O thread pool. Each sub block is queued as soon as it
+// is serialized, and write waits for the disk only when
+// config::spill_max_pending_sub_blocks sub blocks are queued, which bounds the memory
+// of the serialized sub blocks.
 class BlockSpillWriter {
 public:
     BlockSpillWriter(int64_t id, size_t batch_size, const std::string& file_path,
-                     RuntimeProfile* profile)
-            : stream_id_(id), batch_size_(batch_size), file_path_(file_path), profile_(profile) {
+                     RuntimeProfile* profile, std::unique_ptr<ThreadPoolToken> io_token = nullptr,
+                     segment_v2::CompressionTypePB compression_type =
+                             segment_v2::CompressionTypePB::LZ4)
+            : stream_id_(id),
+              batch_size_(batch_size),
+              file_path_(file_path),
+              compression_type_(compression_type),
+              profile_(profile),
+              io_token_(std::move(io_token)) {
         _init_profile();
     }
 
@@ -50,17 +67,29 @@ public:
 
     size_t get_written_bytes() const { return total_written_bytes_; }
 
+    // Returns false if as many sub blocks as allowed are waiting for the disk, the next
+    // write would wait for them. Callers running in pipeline tasks could yield instead.
+    bool can_write() const;
+
 private:
     void _init_profile();
 
     Status _write_internal(const Block& block);
 
+    Status _append(std::string&& buff);
+
+    // Waits until at most `max_pending_writes` sub blocks are waiting for the disk.
+    Status _wait_for_pending_writes(size_t max_pending_writes = 0);
+
+    static size_t _max_pending_writes();
+
 private:
     bool is_open_ = false;
     int64_t stream_id_;
     size_t batch_size_;
     size_t max_sub_block_size_ = 0;
     std::string file_path_;
+    segment_v2::CompressionTypePB compression_type_;
     std::unique_ptr<doris::io::FileWriter> file_writer_;
 
     size_t written_blocks_ = 0;
@@ -74,6 +103,14 @@ private:
     RuntimeProfile::Counter* write_bytes_counter_;
     RuntimeProfile::Counter* serialize_timer_;
     RuntimeProfile::Counter* write_timer_;
+    RuntimeProfile::Counter* wait_io_timer_;
+
+    mutable std::mutex io_lock_;
+    std::condition_variable io_cv_;
+    size_t pending_writes_ = 0;
+    Status io_status_;
+    // destroyed first, so that no task still running refers to the file writer
+    std::unique_ptr<ThreadPoolToken> io_token_;
 };
 
 using BlockSpillWriterUPtr = std::unique_ptr<BlockSpillWriter>;
@@ -88,6 +88,19 @@ Status IDataType::from_string(ReadBuffer& rb, IColumn* column) const {
     return Status::OK();
 }
 
+void IDataType::from_string_batch(const StringRef* values, size_t num_values, IColumn* column,
+                                  PaddedPODArray<UInt8>* parse_failures) const {
+    parse_failures->resize(num_values);
+    for (size_t i = 0; i < num_values; ++i) {
+        ReadBuffer rb(const_cast<char*>(values[i].data), values[i].size);
+        bool success = from_string(rb, column).ok();
+        if (!success) {
+            column->insert_default();
+        }
+        (*parse_failures)[i] = !success;
+    }
+}
+
 void IDataType::insert_default_into(IColumn& column) const {
     column.insert_default();
 }
@@ -26,7 +26,9 @@
 #include "gen_cpp/data.pb.h"
 #include "runtime/define_primitive_type.h"
 #include "vec/common/cow.h"
+#include "vec/common/pod_array.h"
 #include "vec/common/string_buffer.hpp"
+#include "vec/common/string_ref.h"
 #include "vec/core/types.h"
 #include "vec/io/reader_buffer.h"
 
@@ -47,6 +49,23 @@ class Field;
 using DataTypePtr = std::shared_ptr<const IDataType>;
 using DataTypes = std::vector<DataTypePtr>;
 
+/// Appends the texts parsed by `parse(value, rb)` to `data`, see IDataType::from_string_batch().
+template <typename Container, typename Parse>
+void parse_text_batch(const StringRef* values, size_t num_values, Container& data,
+                      PaddedPODArray<UInt8>* parse_failures, Parse&& parse) {
+    using ValueType = typename Container::value_type;
+    size_t old_size = data.size();
+    data.resize(old_size + num_values);
+    parse_failures->resize(num_values);
+    for (size_t i = 0; i < num_values; ++i) {
+        ReadBuffer rb(const_cast<char*>(values[i].data), values[i].size);
+        ValueType value {};
+        bool success = parse(value, rb);
+        data[old_size + i] = success ? value : ValueType {};
+        (*parse_failures)[i] = !success;
+    }
+}
+
 /** Properties of data type.
   * Contains methods for serialization/deserialization.
   * Implementations of this interface represent a data type (example: UInt8)
@@ -74,6 +93,11 @@ public:
     virtual void to_string(const IColumn& column, size_t row_num, BufferWritable& ostr) const;
     virtual std::string to_string(const IColumn& column, size_t row_num) const;
     virtual Status from_string(ReadBuffer& rb, IColumn* column) const;
+    /// Parses `num_values` texts and appends them to `column` in a typed loop, which is the
+    /// batched from_string(). A text which can not be parsed is appended as the default value
+    /// and its flag in `parse_failures` is set to 1. `parse_failures` is resized to num_values.
+    virtual void from_string_batch(const StringRef* values, size_t num_values, IColumn* column,
+                                   PaddedPODArray<UInt8>* parse_failures) const;
 
 protected:
     virtual String do_get_name() const;
@@ -72,6 +72,14 @@ Status DataTypeDate::from_string(ReadBuffer& rb, IColumn* column) const {
     return Status::OK();
 }
 
+void DataTypeDate::from_string_batch(const StringRef* values, size_t num_values, IColumn* column,
+                                     PaddedPODArray<UInt8>* parse_failures) const {
+    parse_text_batch(values, num_values, static_cast<ColumnInt64*>(column)->get_data(),
+                     parse_failures, [](Int64& val, ReadBuffer& rb) {
+                         return read_date_text_impl<Int64>(val, rb);
+                     });
+}
+
 void DataTypeDate::cast_to_date(Int64& x) {
     auto value = binary_cast<Int64, VecDateTimeValue>(x);
     value.cast_to_date();
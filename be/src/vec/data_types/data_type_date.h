@@ -41,6 +41,8 @@ public:
     std::string to_string(const IColumn& column, size_t row_num) const override;
     void to_string(const IColumn& column, size_t row_num, BufferWritable& ostr) const override;
     Status from_string(ReadBuffer& rb, IColumn* column) const override;
+    void from_string_batch(const StringRef* values, size_t num_values, IColumn* column,
+                           PaddedPODArray<UInt8>* parse_failures) const override;
 
     static void cast_to_date(Int64& x);
 
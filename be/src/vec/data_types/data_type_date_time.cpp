@@ -75,6 +75,15 @@ Status DataTypeDateTime::from_string(ReadBuffer& rb, IColumn* column) const {
     return Status::OK();
 }
 
+void DataTypeDateTime::from_string_batch(const StringRef* values, size_t num_values,
+                                         IColumn* column,
+                                         PaddedPODArray<UInt8>* parse_failures) const {
+    parse_text_batch(values, num_values, static_cast<ColumnInt64*>(column)->get_data(),
+                     parse_failures, [](Int64& val, ReadBuffer& rb) {
+                         return read_datetime_text_impl<Int64>(val, rb);
+                     });
+}
+
 void DataTypeDateTime::cast_to_date_time(Int64& x) {
     auto value = binary_cast<Int64, doris::vectorized::VecDateTimeValue>(x);
     value.to_datetime();
@@ -90,6 +90,16 @@ Status DataTypeDecimal<T>::from_string(ReadBuffer& rb, IColumn* column) const {
     return Status::OK();
 }
 
+template <typename T>
+void DataTypeDecimal<T>::from_string_batch(const StringRef* values, size_t num_values,
+                                           IColumn* column,
+                                           PaddedPODArray<UInt8>* parse_failures) const {
+    parse_text_batch(values, num_values, static_cast<ColumnType&>(*column).get_data(),
+                     parse_failures, [this](T& val, ReadBuffer& rb) {
+                         return read_decimal_text_impl<T>(val, rb, precision, scale);
+                     });
+}
+
 // binary: row_num | value1 | value2 | ...
 template <typename T>
 int64_t DataTypeDecimal<T>::get_uncompressed_serialized_bytes(const IColumn& column,
@@ -22,6 +22,8 @@
 
 #include <gen_cpp/Opcodes_types.h>
 
+#include <cstring>
+
 #include "gen_cpp/data.pb.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
@@ -90,12 +92,42 @@ Status DataTypeNullable::from_string(ReadBuffer& rb, IColumn* column) const {
     return Status::OK();
 }
 
+void DataTypeNullable::from_string_batch(const StringRef* values, size_t num_values,
+                                         IColumn* column,
+                                         PaddedPODArray<UInt8>* parse_failures) const {
+    auto* null_column = assert_cast<ColumnNullable*>(column);
+    auto& null_map = null_column->get_null_map_data();
+    size_t old_size = null_map.size();
+    null_map.resize(old_size + num_values);
+    std::vector<StringRef> nested_values(values, values + num_values);
+    for (size_t i = 0; i < num_values; ++i) {
+        bool is_null = values[i].size == 2 && values[i].data[0] == '\\' &&
+                       values[i].data[1] == 'N';
+        null_map[old_size + i] = is_null;
+        if (is_null) {
+            // the nested value of null is the default value or ignored
+            nested_values[i] = StringRef();
+        }
+    }
+    nested_data_type->from_string_batch(nested_values.data(), num_values,
+                                        &null_column->get_nested_column(), parse_failures);
+    for (size_t i = 0; i < num_values; ++i) {
+        (*parse_failures)[i] &= !null_map[old_size + i];
+        null_map[old_size + i] |= (*parse_failures)[i];
+    }
+}
+
 // binary: row num | <null array> | <values array>
 //  <null array>: is_null1 | is_null2 | ...
 //  <values array>: value1 | value2 | ...>
+// since be_exec_version 2, the null array is left out if there is no null:
+// binary: row num | has null | <null array if has null> | <values array>
 int64_t DataTypeNullable::get_uncompressed_serialized_bytes(const IColumn& column,
                                                             int be_exec_version) const {
     int64_t size = sizeof(uint32_t);
+    if (be_exec_version >= 2) {
+        size += sizeof(bool);
+    }
     size += sizeof(bool) * column.size();
     size += nested_data_type->get_uncompressed_serialized_bytes(
             assert_cast<const ColumnNullable&>(*column.convert_to_full_column_if_const())
@@ -112,8 +144,18 @@ char* DataTypeNullable::serialize(const IColumn& column, char* buf, int be_exec_
     *reinterpret_cast<uint32_t*>(buf) = column.size();
     buf += sizeof(uint32_t);
     // null flags
-    memcpy(buf, col.get_null_map_data().data(), column.size() * sizeof(bool));
-    buf += column.size() * sizeof(bool);
+    const auto* null_map = col.get_null_map_data().data();
+    bool has_null = true;
+    if (be_exec_version >= 2) {
+        // not ColumnNullable::has_null(), which updates its cache in this const method
+        has_null = memchr(null_map, 1, column.size()) != nullptr;
+        *reinterpret_cast<bool*>(buf) = has_null;
+        buf += sizeof(bool);
+    }
+    if (has_null) {
+        memcpy(buf, null_map, column.size() * sizeof(bool));
+        buf += column.size() * sizeof(bool);
+    }
     // data values
     return nested_data_type->serialize(col.get_nested_column(), buf, be_exec_version);
 }
@@ -125,9 +167,18 @@ const char* DataTypeNullable::deserialize(const char* buf, IColumn* column,
     uint32_t row_num = *reinterpret_cast<const uint32_t*>(buf);
     buf += sizeof(uint32_t);
     // null flags
-    col->get_null_map_data().resize(row_num);
-    memcpy(col->get_null_map_data().data(), buf, row_num * sizeof(bool));
-    buf += row_num * sizeof(bool);
+    bool has_null = true;
+    if (be_exec_version >= 2) {
+        has_null = *reinterpret_cast<const bool*>(buf);
+        buf += sizeof(bool);
+    }
+    if (has_null) {
+        col->get_null_map_data().resize(row_num);
+        memcpy(col->get_null_map_data().data(), buf, row_num * sizeof(bool));
+        buf += row_num * sizeof(bool);
+    } else {
+        col->get_null_map_data().resize_fill(row_num, 0);
+    }
     // data values
     IColumn& nested = col->get_nested_column();
     return nested_data_type->deserialize(buf, &nested, be_exec_version);
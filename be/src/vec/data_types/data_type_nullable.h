@@ -94,6 +94,10 @@ public:
     std::string to_string(const IColumn& column, size_t row_num) const override;
     void to_string(const IColumn& column, size_t row_num, BufferWritable& ostr) const override;
     Status from_string(ReadBuffer& rb, IColumn* column) const override;
+    /// `\N` is null as in the text files, and the texts which can not be parsed by the nested
+    /// type are null too.
+    void from_string_batch(const StringRef* values, size_t num_values, IColumn* column,
+                           PaddedPODArray<UInt8>* parse_failures) const override;
 
     const DataTypePtr& get_nested_type() const { return nested_data_type; }
     bool is_null_literal() const override { return nested_data_type->is_null_literal(); }
@@ -24,10 +24,12 @@
 
 #include "gutil/strings/numbers.h"
 #include "util/mysql_global.h"
+#include "util/string_parser.hpp"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_vector.h"
 #include "vec/common/assert_cast.h"
+#include "vec/data_types/serialize_bit_packing.h"
 #include "vec/io/io_helper.h"
 
 namespace doris::vectorized {
@@ -88,6 +90,31 @@ Status DataTypeNumberBase<T>::from_string(ReadBuffer& rb, IColumn* column) const
     return Status::OK();
 }
 
+template <typename T>
+void DataTypeNumberBase<T>::from_string_batch(const StringRef* values, size_t num_values,
+                                              IColumn* column,
+                                              PaddedPODArray<UInt8>* parse_failures) const {
+    auto& data = static_cast<ColumnVector<T>*>(column)->get_data();
+    if constexpr (std::is_same<T, UInt128>::value) {
+        IDataType::from_string_batch(values, num_values, column, parse_failures);
+    } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        // The same rules as TextConverter, "nan", "inf" and the values out of range are accepted.
+        parse_text_batch(values, num_values, data, parse_failures, [](T& val, ReadBuffer& rb) {
+            StringParser::ParseResult result;
+            val = StringParser::string_to_float<T>(rb.position(), rb.count(), &result);
+            return result != StringParser::PARSE_FAILURE;
+        });
+    } else if constexpr (std::is_same_v<T, uint8_t>) {
+        parse_text_batch(values, num_values, data, parse_failures,
+                         [](T& val, ReadBuffer& rb) { return try_read_bool_text(val, rb); });
+    } else if constexpr (std::is_integral<T>::value) {
+        parse_text_batch(values, num_values, data, parse_failures,
+                         [](T& val, ReadBuffer& rb) { return read_int_text_impl(val, rb); });
+    } else {
+        DCHECK(false);
+    }
+}
+
 template <typename T>
 Field DataTypeNumberBase<T>::get_default() const {
     return NearestFieldType<FieldType>();
@@ -112,10 +139,20 @@ std::string DataTypeNumberBase<T>::to_string(const IColumn& column, size_t row_n
 }
 
 // binary: row num | value1 | value2 | ...
+// Integers are bit packed since be_exec_version 2 if that is smaller:
+// binary: row num | bit width | <values>
+//  <values>: value1 | value2 | ... if bit width is the width of the type
+//            min | <bit packed (value - min) array> otherwise
+template <typename T>
+static constexpr bool is_bit_packed(int be_exec_version) {
+    return std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t) && be_exec_version >= 2;
+}
+
 template <typename T>
 int64_t DataTypeNumberBase<T>::get_uncompressed_serialized_bytes(const IColumn& column,
                                                                  int be_exec_version) const {
-    return sizeof(uint32_t) + column.size() * sizeof(FieldType);
+    return sizeof(uint32_t) + is_bit_packed<T>(be_exec_version) +
+           column.size() * sizeof(FieldType);
 }
 
 template <typename T>
@@ -128,6 +165,24 @@ char* DataTypeNumberBase<T>::serialize(const IColumn& column, char* buf,
     // column data
     auto ptr = column.convert_to_full_column_if_const();
     const auto* origin_data = assert_cast<const ColumnVector<T>&>(*ptr.get()).get_data().data();
+    if constexpr (is_bit_packed<T>(2)) {
+        if (is_bit_packed<T>(be_exec_version)) {
+            constexpr int type_bit_width = sizeof(FieldType) * 8;
+            FieldType min = 0;
+            int bit_width = frame_of_reference_bit_width(origin_data, row_num, &min);
+            if (sizeof(FieldType) + packed_bytes(row_num, bit_width) >=
+                row_num * sizeof(FieldType)) {
+                bit_width = type_bit_width;
+            }
+            *reinterpret_cast<uint8_t*>(buf) = bit_width;
+            buf += sizeof(uint8_t);
+            if (bit_width < type_bit_width) {
+                memcpy(buf, &min, sizeof(FieldType));
+                buf += sizeof(FieldType);
+                return frame_of_reference_encode(origin_data, row_num, min, bit_width, buf);
+            }
+        }
+    }
     memcpy(buf, origin_data, row_num * sizeof(FieldType));
     buf += row_num * sizeof(FieldType);
 
@@ -143,6 +198,18 @@ const char* DataTypeNumberBase<T>::deserialize(const char* buf, IColumn* column,
     // column data
     auto& container = assert_cast<ColumnVector<T>*>(column)->get_data();
     container.resize(row_num);
+    if constexpr (is_bit_packed<T>(2)) {
+        if (is_bit_packed<T>(be_exec_version)) {
+            int bit_width = *reinterpret_cast<const uint8_t*>(buf);
+            buf += sizeof(uint8_t);
+            if (bit_width < sizeof(FieldType) * 8) {
+                FieldType min;
+                memcpy(&min, buf, sizeof(FieldType));
+                buf += sizeof(FieldType);
+                return frame_of_reference_decode(buf, row_num, min, bit_width, container.data());
+            }
+        }
+    }
     memcpy(container.data(), buf, row_num * sizeof(FieldType));
     buf += row_num * sizeof(FieldType);
 
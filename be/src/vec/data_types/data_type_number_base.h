@@ -117,6 +117,8 @@ public:
     void to_string(const IColumn& column, size_t row_num, BufferWritable& ostr) const override;
     std::string to_string(const IColumn& column, size_t row_num) const override;
     Status from_string(ReadBuffer& rb, IColumn* column) const override;
+    void from_string_batch(const StringRef* values, size_t num_values, IColumn* column,
+                           PaddedPODArray<UInt8>* parse_failures) const override;
     bool is_null_literal() const override { return _is_null_literal; }
     void set_null_literal(bool flag) { _is_null_literal = flag; }
 
@@ -20,13 +20,17 @@
 
 #include "vec/data_types/data_type_string.h"
 
+#include <parallel_hashmap/phmap.h>
+
 #include <string_view>
 
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_string.h"
 #include "vec/common/assert_cast.h"
+#include "vec/common/string_ref.h"
 #include "vec/core/field.h"
+#include "vec/data_types/serialize_bit_packing.h"
 
 #ifdef __SSE2__
 #include <emmintrin.h>
@@ -59,6 +63,13 @@ Status DataTypeString::from_string(ReadBuffer& rb, IColumn* column) const {
     return Status::OK();
 }
 
+void DataTypeString::from_string_batch(const StringRef* values, size_t num_values,
+                                       IColumn* column,
+                                       PaddedPODArray<UInt8>* parse_failures) const {
+    static_cast<ColumnString*>(column)->insert_many_strings(values, num_values);
+    parse_failures->assign(num_values, static_cast<UInt8>(0));
+}
+
 Field DataTypeString::get_default() const {
     return String();
 }
@@ -71,9 +82,72 @@ bool DataTypeString::equals(const IDataType& rhs) const {
     return typeid(rhs) == typeid(*this);
 }
 
+namespace {
+
+enum StringEncoding : uint8_t { PLAIN = 0, DICTIONARY = 1 };
+
+// The number of rows looked at before the values of a whole column are hashed.
+constexpr size_t DICTIONARY_SAMPLE_ROWS = 256;
+
+// Returns false if more than half of the values of evenly spaced sample rows are distinct,
+// which is the case for most columns that are not worth a dictionary. Such columns are sent
+// plain without hashing every value, even if a few of them would be a bit smaller in a
+// dictionary.
+bool sample_distinct_values(const ColumnString& column) {
+    size_t rows = column.size();
+    if (rows <= DICTIONARY_SAMPLE_ROWS * 2) {
+        return true;
+    }
+    size_t step = rows / DICTIONARY_SAMPLE_ROWS;
+    phmap::flat_hash_set<StringRef, StringRefHash> values;
+    for (size_t i = 0; i < DICTIONARY_SAMPLE_ROWS; ++i) {
+        values.insert(column.get_data_at(i * step));
+        if (values.size() > DICTIONARY_SAMPLE_ROWS / 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Fails if more than a quarter of the values are distinct.
+bool build_dictionary(const ColumnString& column, ColumnString* dict,
+                      PaddedPODArray<UInt32>* codes) {
+    size_t rows = column.size();
+    size_t max_dict_size = rows / 4;
+    if (max_dict_size == 0 || !sample_distinct_values(column)) {
+        return false;
+    }
+    phmap::flat_hash_map<StringRef, UInt32, StringRefHash> index;
+    codes->resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        auto value = column.get_data_at(i);
+        auto [it, inserted] = index.try_emplace(value, index.size());
+        if (inserted) {
+            if (index.size() > max_dict_size) {
+                return false;
+            }
+            dict->insert_data(value.data, value.size);
+        }
+        (*codes)[i] = it->second;
+    }
+    return true;
+}
+
+int64_t plain_serialized_bytes(const ColumnString& column) {
+    return sizeof(IColumn::Offset) * (column.size() + 1) + sizeof(uint64_t) +
+           column.get_chars().size();
+}
+
+} // namespace
+
 // binary: <size array> | total length | <value array>
 //  <size array> : row num | offset1 |offset2 | ...
 //  <value array> : <value1> | <value2 | ...
+// since be_exec_version 2, values are sent as codes of a dictionary if that is smaller:
+// binary: encoding | <plain values> or <dictionary values>
+//  <plain values>: the binary of be_exec_version 1
+//  <dictionary values>: row num | <dictionary> | bit width | <bit packed code array>
+//  <dictionary>: the distinct values in the binary of be_exec_version 1
 int64_t DataTypeString::get_uncompressed_serialized_bytes(const IColumn& column,
                                                           int be_exec_version) const {
     auto ptr = column.convert_to_full_column_if_const();
@@ -83,15 +157,42 @@ int64_t DataTypeString::get_uncompressed_serialized_bytes(const IColumn& column,
         return sizeof(IColumn::Offset) * (column.size() + 1) + sizeof(uint64_t) +
                data_column.get_chars().size() + column.size();
     }
+    if (be_exec_version >= 2) {
+        return sizeof(uint8_t) + plain_serialized_bytes(data_column);
+    }
 
-    return sizeof(IColumn::Offset) * (column.size() + 1) + sizeof(uint64_t) +
-           data_column.get_chars().size();
+    return plain_serialized_bytes(data_column);
 }
 
 char* DataTypeString::serialize(const IColumn& column, char* buf, int be_exec_version) const {
     auto ptr = column.convert_to_full_column_if_const();
     const auto& data_column = assert_cast<const ColumnString&>(*ptr.get());
 
+    if (be_exec_version >= 2) {
+        auto dict = ColumnString::create();
+        PaddedPODArray<UInt32> codes;
+        if (build_dictionary(data_column, dict.get(), &codes)) {
+            int bit_width = packed_bit_width(dict->size() - 1);
+            if (sizeof(IColumn::Offset) + plain_serialized_bytes(*dict) + sizeof(uint8_t) +
+                        packed_bytes(codes.size(), bit_width) <
+                plain_serialized_bytes(data_column)) {
+                *reinterpret_cast<uint8_t*>(buf) = DICTIONARY;
+                buf += sizeof(uint8_t);
+                // row num
+                *reinterpret_cast<IColumn::Offset*>(buf) = column.size();
+                buf += sizeof(IColumn::Offset);
+                buf = serialize(*dict, buf, 1);
+                *reinterpret_cast<uint8_t*>(buf) = bit_width;
+                buf += sizeof(uint8_t);
+                return frame_of_reference_encode(codes.data(), codes.size(), UInt32(0),
+                                                 bit_width, buf);
+            }
+        }
+        *reinterpret_cast<uint8_t*>(buf) = PLAIN;
+        buf += sizeof(uint8_t);
+        return serialize(data_column, buf, 1);
+    }
+
     if (be_exec_version == 0) {
         // row num
         *reinterpret_cast<IColumn::Offset*>(buf) = column.size();
@@ -138,6 +239,38 @@ const char* DataTypeString::deserialize(const char* buf, IColumn* column,
     ColumnString::Chars& data = column_string->get_chars();
     ColumnString::Offsets& offsets = column_string->get_offsets();
 
+    if (be_exec_version >= 2) {
+        auto encoding = *reinterpret_cast<const uint8_t*>(buf);
+        buf += sizeof(uint8_t);
+        if (encoding == PLAIN) {
+            return deserialize(buf, column, 1);
+        }
+        DCHECK_EQ(encoding, DICTIONARY);
+        // row num
+        IColumn::Offset row_num = *reinterpret_cast<const IColumn::Offset*>(buf);
+        buf += sizeof(IColumn::Offset);
+        auto dict = ColumnString::create();
+        buf = deserialize(buf, dict.get(), 1);
+        int bit_width = *reinterpret_cast<const uint8_t*>(buf);
+        buf += sizeof(uint8_t);
+        PaddedPODArray<UInt32> codes(row_num);
+        buf = frame_of_reference_decode(buf, row_num, UInt32(0), bit_width, codes.data());
+        // offsets
+        offsets.resize(row_num);
+        IColumn::Offset offset = 0;
+        for (size_t i = 0; i < row_num; ++i) {
+            offset += dict->get_data_at(codes[i]).size;
+            offsets[i] = offset;
+        }
+        // values
+        data.resize(offset);
+        for (size_t i = 0; i < row_num; ++i) {
+            auto value = dict->get_data_at(codes[i]);
+            memcpy(data.data() + offsets[i - 1], value.data, value.size);
+        }
+        return buf;
+    }
+
     if (be_exec_version == 0) {
         // row num
         IColumn::Offset row_num = *reinterpret_cast<const IColumn::Offset*>(buf);
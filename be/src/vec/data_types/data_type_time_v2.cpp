@@ -69,6 +69,15 @@ Status DataTypeDateV2::from_string(ReadBuffer& rb, IColumn* column) const {
     return Status::OK();
 }
 
+void DataTypeDateV2::from_string_batch(const StringRef* values, size_t num_values,
+                                       IColumn* column,
+                                       PaddedPODArray<UInt8>* parse_failures) const {
+    parse_text_batch(values, num_values, static_cast<ColumnUInt32*>(column)->get_data(),
+                     parse_failures, [](UInt32& val, ReadBuffer& rb) {
+                         return read_date_v2_text_impl<UInt32>(val, rb);
+                     });
+}
+
 MutableColumnPtr DataTypeDateV2::create_column() const {
     return DataTypeNumberBase<UInt32>::create_column();
 }
@@ -145,6 +154,15 @@ Status DataTypeDateTimeV2::from_string(ReadBuffer& rb, IColumn* column) const {
     return Status::OK();
 }
 
+void DataTypeDateTimeV2::from_string_batch(const StringRef* values, size_t num_values,
+                                           IColumn* column,
+                                           PaddedPODArray<UInt8>* parse_failures) const {
+    parse_text_batch(values, num_values, static_cast<ColumnUInt64*>(column)->get_data(),
+                     parse_failures, [](UInt64& val, ReadBuffer& rb) {
+                         return read_datetime_v2_text_impl<UInt64>(val, rb);
+                     });
+}
+
 MutableColumnPtr DataTypeDateTimeV2::create_column() const {
     return DataTypeNumberBase<UInt64>::create_column();
 }
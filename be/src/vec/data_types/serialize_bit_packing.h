@@ -0,0 +1,99 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "util/bit_packing.inline.h"
+
+namespace doris::vectorized {
+
+// Frame of reference and bit packing of integers for IDataType::serialize() since
+// be_exec_version 2. The values are stored as the lower `bit_width` bits of `value - min`,
+// in the layout of BitPacking, so they are unpacked with BitPacking::UnpackValues().
+
+inline int packed_bit_width(uint64_t range) {
+    return range == 0 ? 0 : 64 - __builtin_clzll(range);
+}
+
+inline size_t packed_bytes(size_t num_values, int bit_width) {
+    return (num_values * bit_width + 7) / 8;
+}
+
+// Returns the bit width of `values - *min`.
+template <typename T>
+int frame_of_reference_bit_width(const T* values, size_t num_values, T* min) {
+    using U = std::make_unsigned_t<T>;
+    if (num_values == 0) {
+        *min = 0;
+        return 0;
+    }
+    T min_value = values[0];
+    T max_value = values[0];
+    for (size_t i = 1; i < num_values; ++i) {
+        min_value = values[i] < min_value ? values[i] : min_value;
+        max_value = values[i] > max_value ? values[i] : max_value;
+    }
+    *min = min_value;
+    return packed_bit_width(static_cast<U>(static_cast<U>(max_value) - static_cast<U>(min_value)));
+}
+
+// Writes packed_bytes(num_values, bit_width) bytes to `buf`.
+template <typename T>
+char* frame_of_reference_encode(const T* values, size_t num_values, T min, int bit_width,
+                                char* buf) {
+    using U = std::make_unsigned_t<T>;
+    if (bit_width == 0) {
+        return buf;
+    }
+    uint64_t buffered = 0;
+    int bit_offset = 0;
+    for (size_t i = 0; i < num_values; ++i) {
+        uint64_t delta = static_cast<U>(static_cast<U>(values[i]) - static_cast<U>(min));
+        buffered |= delta << bit_offset;
+        bit_offset += bit_width;
+        if (bit_offset >= 64) {
+            memcpy(buf, &buffered, sizeof(buffered));
+            buf += sizeof(buffered);
+            bit_offset -= 64;
+            // the upper bits of delta that did not fit
+            buffered = bit_offset == 0 ? 0 : delta >> (bit_width - bit_offset);
+        }
+    }
+    size_t tail_bytes = (bit_offset + 7) / 8;
+    memcpy(buf, &buffered, tail_bytes);
+    return buf + tail_bytes;
+}
+
+template <typename T>
+const char* frame_of_reference_decode(const char* buf, size_t num_values, T min, int bit_width,
+                                      T* values) {
+    using U = std::make_unsigned_t<T>;
+    size_t num_bytes = packed_bytes(num_values, bit_width);
+    U* deltas = reinterpret_cast<U*>(values);
+    BitPacking::UnpackValues(bit_width, reinterpret_cast<const uint8_t*>(buf), num_bytes,
+                             num_values, deltas);
+    for (size_t i = 0; i < num_values; ++i) {
+        values[i] = static_cast<T>(static_cast<U>(deltas[i] + static_cast<U>(min)));
+    }
+    return buf + num_bytes;
+}
+
+} // namespace doris::vectorized
@@ -106,6 +106,12 @@ void CsvReader::_init_file_description() {
 }
 
 Status CsvReader::init_reader(bool is_load) {
+    // get column_separator and line_delimiter
+    _value_separator = _params.file_attributes.text_params.column_separator;
+    _value_separator_length = _value_separator.size();
+    _line_delimiter = _params.file_attributes.text_params.line_delimiter;
+    _line_delimiter_length = _line_delimiter.size();
+
     // set the skip lines and start offset
     int64_t start_offset = _range.start_offset;
     if (start_offset == 0) {
@@ -127,8 +133,12 @@ Status CsvReader::init_reader(bool is_load) {
              _file_compress_type != TFileCompressType::PLAIN)) {
             return Status::InternalError("For now we do not support split compressed file");
         }
-        start_offset -= 1;
-        _size += 1;
+        // Start from the last bytes of the previous range, so the first line skipped ends at the
+        // first line delimiter which ends at or after the start offset, even if the delimiter
+        // has several bytes. The previous range reads the lines which start before it.
+        int64_t resync_bytes = std::min<int64_t>(start_offset, _line_delimiter_length);
+        start_offset -= resync_bytes;
+        _size += resync_bytes;
         // not first range will always skip one line
         _skip_lines = 1;
     }
@@ -146,12 +156,6 @@ Status CsvReader::init_reader(bool is_load) {
         return Status::EndOfFile("init reader failed, empty csv file: " + _range.path);
     }
 
-    // get column_separator and line_delimiter
-    _value_separator = _params.file_attributes.text_params.column_separator;
-    _value_separator_length = _value_separator.size();
-    _line_delimiter = _params.file_attributes.text_params.line_delimiter;
-    _line_delimiter_length = _line_delimiter.size();
-
     if (_params.file_attributes.__isset.trim_double_quotes) {
         _trim_double_quotes = _params.file_attributes.trim_double_quotes;
     }
@@ -171,12 +175,18 @@ Status CsvReader::init_reader(bool is_load) {
         [[fallthrough]];
     case TFileFormatType::FORMAT_CSV_LZOP:
         [[fallthrough]];
-    case TFileFormatType::FORMAT_CSV_DEFLATE:
-        _line_reader.reset(new NewPlainTextLineReader(_profile, _file_reader, _decompressor.get(),
-                                                      _size, _line_delimiter,
-                                                      _line_delimiter_length, start_offset));
-
+    case TFileFormatType::FORMAT_CSV_DEFLATE: {
+        auto* text_line_reader =
+                new NewPlainTextLineReader(_profile, _file_reader, _decompressor.get(), _size,
+                                           _line_delimiter, _line_delimiter_length, start_offset);
+        _line_reader.reset(text_line_reader);
+        if (_value_separator_length == 1 && _line_delimiter_length == 1) {
+            // find the column separators and the line delimiter in one pass
+            text_line_reader->set_column_separator(_value_separator[0]);
+            _text_line_reader = text_line_reader;
+        }
         break;
+    }
     case TFileFormatType::FORMAT_PROTO:
         _line_reader.reset(new NewPlainBinaryLineReader(_file_reader));
         break;
@@ -186,6 +196,10 @@ Status CsvReader::init_reader(bool is_load) {
                 _file_format_type);
     }
 
+    if (_value_separator_length == 1) {
+        _separator_scanner = CsvStructuralScanner(_value_separator[0]);
+    }
+
     _is_load = is_load;
     if (!_is_load) {
         // For query task, there are 2 slot mapping.
@@ -212,6 +226,12 @@ Status CsvReader::init_reader(bool is_load) {
             _col_idxs.push_back(i++);
         }
     }
+    // For load task, all the columns are nullable string, which are written straight from the
+    // line, so only the converted columns of a query task are parsed in batch.
+    for (const auto* slot_desc : _file_slot_descs) {
+        _is_batch_column.push_back(!_is_load && _is_batch_parsed_type(slot_desc->type()));
+    }
+    _column_values.resize(_file_slot_descs.size());
 
     _line_reader_eof = false;
     return Status::OK();
@@ -226,6 +246,10 @@ Status CsvReader::get_next_block(Block* block, size_t* read_rows, bool* eof) {
     const int batch_size = std::max(_state->batch_size(), (int)_MIN_BATCH_SIZE);
     size_t rows = 0;
     auto columns = block->mutate_columns();
+    _values_arena = std::make_unique<Arena>();
+    for (auto& values : _column_values) {
+        values.clear();
+    }
     while (rows < batch_size && !_line_reader_eof) {
         const uint8_t* ptr = nullptr;
         size_t size = 0;
@@ -241,6 +265,7 @@ Status CsvReader::get_next_block(Block* block, size_t* read_rows, bool* eof) {
 
         RETURN_IF_ERROR(_fill_dest_columns(Slice(ptr, size), block, columns, &rows));
     }
+    _parse_column_values(block, columns);
 
     *eof = (rows == 0);
     *read_rows = rows;
@@ -350,38 +375,80 @@ Status CsvReader::_fill_dest_columns(const Slice& line, Block* block,
         return Status::OK();
     }
 
-    if (_is_load) {
-        for (int i = 0; i < _file_slot_descs.size(); ++i) {
-            auto src_slot_desc = _file_slot_descs[i];
-            int col_idx = _col_idxs[i];
-            // col idx is out of range, fill with null.
-            const Slice& value =
-                    col_idx < _split_values.size() ? _split_values[col_idx] : _s_null_slice;
+    // if _split_values.size > _file_slot_descs.size()
+    // we only take the first few columns
+    for (int i = 0; i < _file_slot_descs.size(); ++i) {
+        auto src_slot_desc = _file_slot_descs[i];
+        int col_idx = _col_idxs[i];
+        // col idx is out of range, fill with null.
+        const Slice& value =
+                col_idx < _split_values.size() ? _split_values[col_idx] : _s_null_slice;
+        if (_is_load) {
             // For load task, we always read "string" from file, so use "write_string_column"
             _text_converter->write_string_column(src_slot_desc, &columns[i], value.data,
                                                  value.size);
+            continue;
         }
-    } else {
-        // if _split_values.size > _file_slot_descs.size()
-        // we only take the first few columns
-        for (int i = 0; i < _file_slot_descs.size(); ++i) {
-            auto src_slot_desc = _file_slot_descs[i];
-            int col_idx = _col_idxs[i];
-            // col idx is out of range, fill with null.
-            const Slice& value =
-                    col_idx < _split_values.size() ? _split_values[col_idx] : _s_null_slice;
-            IColumn* col_ptr = const_cast<IColumn*>(
-                    block->get_by_position(_file_slot_idx_map[i]).column.get());
-            // For query task, we will convert values to final column type, so use "write_vec_column"
-            _text_converter->write_vec_column(src_slot_desc, col_ptr, value.data, value.size, true,
-                                              false);
+        if (_is_batch_column[i]) {
+            // parsed by _parse_column_values after the whole block is read
+            char* data = _values_arena->alloc(value.size);
+            memcpy(data, value.data, value.size);
+            _column_values[i].emplace_back(data, value.size);
+            continue;
         }
+        IColumn* col_ptr = const_cast<IColumn*>(
+                block->get_by_position(_file_slot_idx_map[i]).column.get());
+        // For query task, we will convert values to final column type, so use "write_vec_column"
+        _text_converter->write_vec_column(src_slot_desc, col_ptr, value.data, value.size, true,
+                                          false);
     }
     ++(*rows);
 
     return Status::OK();
 }
 
+void CsvReader::_parse_column_values(Block* block, std::vector<MutableColumnPtr>& columns) {
+    for (int i = 0; i < _file_slot_descs.size(); ++i) {
+        if (!_is_batch_column[i]) {
+            continue;
+        }
+        // The values are converted to the final column type, and the values can not be parsed
+        // are null as "write_vec_column" does.
+        int pos = _file_slot_idx_map[i];
+        const auto& values = _column_values[i];
+        block->get_by_position(pos).type->from_string_batch(values.data(), values.size(),
+                                                            columns[pos].get(), &_parse_failures);
+        _column_values[i].clear();
+    }
+}
+
+bool CsvReader::_is_batch_parsed_type(const TypeDescriptor& type) {
+    switch (type.type) {
+    case TYPE_STRING:
+    case TYPE_VARCHAR:
+    case TYPE_CHAR:
+    case TYPE_BOOLEAN:
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_DATEV2:
+    case TYPE_DATETIMEV2:
+    case TYPE_DECIMALV2:
+    case TYPE_DECIMAL32:
+    case TYPE_DECIMAL64:
+    case TYPE_DECIMAL128I:
+        return true;
+    default:
+        return false;
+    }
+}
+
 Status CsvReader::_line_split_to_values(const Slice& line, bool* success) {
     if (!_is_proto_format && !validate_utf8(line.data, line.size)) {
         if (!_is_load) {
@@ -452,42 +519,35 @@ void CsvReader::_split_line_for_single_char_delimiter(const Slice& line) {
     if (_file_format_type == TFileFormatType::FORMAT_PROTO) {
         _split_line_for_proto_format(line);
     } else {
-        const char* value = line.data;
-        size_t cur_pos = 0;
+        const std::vector<size_t>* field_pos =
+                _text_line_reader == nullptr ? nullptr : _text_line_reader->field_pos();
+        if (field_pos == nullptr) {
+            _separator_pos.clear();
+            _separator_scanner.find_line_delimiter(line.data, 0, line.size, &_separator_pos);
+            field_pos = &_separator_pos;
+        }
         size_t start_field = 0;
-        const size_t size = line.size;
-        for (; cur_pos < size; ++cur_pos) {
-            if (*(value + cur_pos) == _value_separator[0]) {
-                size_t non_space = cur_pos;
-                if (_state != nullptr && _state->trim_tailing_spaces_for_external_table_query()) {
-                    while (non_space > start_field && *(value + non_space - 1) == ' ') {
-                        non_space--;
-                    }
-                }
-                if (_trim_double_quotes && non_space > (start_field + 1) &&
-                    *(value + start_field) == '\"' && *(value + non_space - 1) == '\"') {
-                    start_field++;
-                    non_space--;
-                }
-                _split_values.emplace_back(value + start_field, non_space - start_field);
-                start_field = cur_pos + 1;
-            }
+        for (size_t pos : *field_pos) {
+            DCHECK_LT(pos, line.size);
+            _add_split_value(line.data, start_field, pos);
+            start_field = pos + 1;
         }
+        _add_split_value(line.data, start_field, line.size);
+    }
+}
 
-        CHECK(cur_pos == line.size) << cur_pos << " vs " << line.size;
-        size_t non_space = cur_pos;
-        if (_state != nullptr && _state->trim_tailing_spaces_for_external_table_query()) {
-            while (non_space > start_field && *(value + non_space - 1) == ' ') {
-                non_space--;
-            }
+void CsvReader::_add_split_value(const char* value, size_t start, size_t end) {
+    if (_state != nullptr && _state->trim_tailing_spaces_for_external_table_query()) {
+        while (end > start && *(value + end - 1) == ' ') {
+            end--;
         }
-        if (_trim_double_quotes && non_space > (start_field + 1) &&
-            *(value + start_field) == '\"' && *(value + non_space - 1) == '\"') {
-            start_field++;
-            non_space--;
-        }
-        _split_values.emplace_back(value + start_field, non_space - start_field);
     }
+    if (_trim_double_quotes && end > (start + 1) && *(value + start) == '\"' &&
+        *(value + end - 1) == '\"') {
+        start++;
+        end--;
+    }
+    _split_values.emplace_back(value + start, end - start);
 }
 
 void CsvReader::_split_line(const Slice& line) {
@@ -20,11 +20,16 @@
 #include "io/file_factory.h"
 #include "io/fs/file_reader.h"
 #include "olap/iterators.h"
+#include "vec/common/arena.h"
+#include "vec/common/pod_array.h"
+#include "vec/common/string_ref.h"
+#include "vec/exec/format/csv/csv_structural_scanner.h"
 #include "vec/exec/format/generic_reader.h"
 
 namespace doris {
 
 class LineReader;
+class NewPlainTextLineReader;
 class TextConverter;
 class Decompressor;
 class SlotDescriptor;
@@ -61,10 +66,16 @@ private:
     Status _create_decompressor();
     Status _fill_dest_columns(const Slice& line, Block* block,
                               std::vector<MutableColumnPtr>& columns, size_t* rows);
+    // Parses the values saved by _fill_dest_columns into the columns of block, column by column.
+    void _parse_column_values(Block* block, std::vector<MutableColumnPtr>& columns);
+    // Whether the values of the slot can be parsed by IDataType::from_string_batch.
+    static bool _is_batch_parsed_type(const TypeDescriptor& type);
     Status _line_split_to_values(const Slice& line, bool* success);
     void _split_line(const Slice& line);
     void _split_line_for_single_char_delimiter(const Slice& line);
     void _split_line_for_proto_format(const Slice& line);
+    // Adds value[start, end) to _split_values, trimming the tailing spaces and double quotes.
+    void _add_split_value(const char* value, size_t start, size_t end);
     Status _check_array_format(std::vector<Slice>& split_values, bool* is_success);
     bool _is_null(const Slice& slice);
     bool _is_array(const Slice& slice);
@@ -103,6 +114,8 @@ private:
     std::shared_ptr<io::FileSystem> _file_system;
     io::FileReaderSPtr _file_reader;
     std::unique_ptr<LineReader> _line_reader;
+    // _line_reader if it saves the positions of the single char column separator
+    NewPlainTextLineReader* _text_line_reader = nullptr;
     bool _line_reader_eof;
     std::unique_ptr<TextConverter> _text_converter;
     std::unique_ptr<Decompressor> _decompressor;
@@ -126,6 +139,18 @@ private:
 
     // save source text which have been splitted.
     std::vector<Slice> _split_values;
+    // find the single char column separator if _text_line_reader does not save them
+    CsvStructuralScanner _separator_scanner;
+    std::vector<size_t> _separator_pos;
+
+    // For each file slot, whether its values are parsed in batch by _parse_column_values.
+    // The other slots are still written value by value by _text_converter.
+    std::vector<bool> _is_batch_column;
+    // The values of the batch parsed slots in the current block. They are copied to
+    // _values_arena since the line reader reuses its buffer.
+    std::vector<std::vector<StringRef>> _column_values;
+    std::unique_ptr<Arena> _values_arena;
+    PaddedPODArray<UInt8> _parse_failures;
 };
 } // namespace vectorized
 } // namespace doris
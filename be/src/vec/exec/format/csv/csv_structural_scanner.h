@@ -0,0 +1,109 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif __SSE2__
+#include <emmintrin.h>
+#elif __aarch64__
+#include <sse2neon.h>
+#endif
+
+namespace doris::vectorized {
+
+// Finds the structural chars of csv text, which are the single char column separator and
+// optionally the single char line delimiter, 32 bytes a time. The double quotes are not
+// structural since CsvReader only trims them from the split values.
+class CsvStructuralScanner {
+public:
+    CsvStructuralScanner() = default;
+
+    explicit CsvStructuralScanner(char column_separator)
+            : _column_separator(column_separator), _has_line_delimiter(false) {}
+
+    CsvStructuralScanner(char column_separator, char line_delimiter)
+            : _column_separator(column_separator),
+              _line_delimiter(line_delimiter),
+              _has_line_delimiter(true) {}
+
+    // Scans line[from, to) until the first line delimiter, and appends the offsets in `line`
+    // of the column separators before it to `separator_pos`.
+    // Returns the position of the line delimiter, or nullptr if not found.
+    const char* find_line_delimiter(const char* line, size_t from, size_t to,
+                                    std::vector<size_t>* separator_pos) const {
+        size_t pos = from;
+#if defined(__AVX2__) || defined(__SSE2__) || defined(__aarch64__)
+        for (; pos + 32 <= to; pos += 32) {
+            uint32_t separator_mask = _match32(line + pos, _column_separator);
+            uint32_t line_mask = _has_line_delimiter ? _match32(line + pos, _line_delimiter) : 0;
+            if (line_mask != 0) {
+                // only the separators before the first line delimiter
+                _append_positions(separator_mask & (line_mask - 1) & ~line_mask, pos,
+                                  separator_pos);
+                return line + pos + __builtin_ctz(line_mask);
+            }
+            _append_positions(separator_mask, pos, separator_pos);
+        }
+#endif
+        for (; pos < to; ++pos) {
+            if (_has_line_delimiter && line[pos] == _line_delimiter) {
+                return line + pos;
+            }
+            if (line[pos] == _column_separator) {
+                separator_pos->push_back(pos);
+            }
+        }
+        return nullptr;
+    }
+
+private:
+#if defined(__AVX2__) || defined(__SSE2__) || defined(__aarch64__)
+    // Returns the mask of the 32 bytes at `data` which are equal to `c`.
+    static uint32_t _match32(const char* data, char c) {
+#ifdef __AVX2__
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), _mm256_set1_epi8(c))));
+#else
+        auto target = _mm_set1_epi8(c);
+        uint32_t low = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), target)));
+        uint32_t high = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), target)));
+        return low | (high << 16);
+#endif
+    }
+
+    static void _append_positions(uint32_t mask, size_t offset, std::vector<size_t>* pos) {
+        while (mask != 0) {
+            pos->push_back(offset + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    char _column_separator = '\t';
+    char _line_delimiter = '\n';
+    bool _has_line_delimiter = false;
+};
+
+} // namespace doris::vectorized
@@ -94,10 +94,27 @@ inline bool NewPlainTextLineReader::update_eof() {
     return _eof;
 }
 
+void NewPlainTextLineReader::set_column_separator(char column_separator) {
+    if (_line_delimiter_length == 1) {
+        _save_field_pos = true;
+        _structural_scanner =
+                vectorized::CsvStructuralScanner(column_separator, _line_delimiter[0]);
+    }
+}
+
 uint8_t* NewPlainTextLineReader::update_field_pos_and_find_line_delimiter(const uint8_t* start,
                                                                           size_t len) {
-    // TODO: meanwhile find and save field pos
-    return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
+    if (!_save_field_pos) {
+        return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
+    }
+    if (_scanned_bytes == 0) {
+        _field_pos.clear();
+    }
+    // only scan the data appended since the last call for the same line
+    const char* pos = _structural_scanner.find_line_delimiter((const char*)start, _scanned_bytes,
+                                                              len, &_field_pos);
+    _scanned_bytes = len;
+    return (uint8_t*)pos;
 }
 
 // extend input buf if necessary only when _more_input_bytes > 0
@@ -328,6 +345,7 @@ Status NewPlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool
 
     // Skip offset and _line_delimiter size;
     _output_buf_pos += offset + found_line_delimiter;
+    _scanned_bytes = 0;
     if (offset == 0 && found_line_delimiter == 0) {
         *eof = true;
     } else {
@@ -17,9 +17,12 @@
 
 #pragma once
 
+#include <vector>
+
 #include "exec/line_reader.h"
 #include "io/fs/file_reader.h"
 #include "util/runtime_profile.h"
+#include "vec/exec/format/csv/csv_structural_scanner.h"
 
 namespace doris {
 namespace io {
@@ -43,6 +46,16 @@ public:
 
     void close() override;
 
+    // Saves the positions of `column_separator` in each line while finding the line delimiter.
+    // Only works if the line delimiter is a single char.
+    void set_column_separator(char column_separator);
+
+    // The positions of the column separators in the line returned by the last read_line(),
+    // or nullptr if they are not saved.
+    const std::vector<size_t>* field_pos() const {
+        return _save_field_pos ? &_field_pos : nullptr;
+    }
+
 private:
     bool update_eof();
 
@@ -54,8 +67,7 @@ private:
 
     // find line delimiter from 'start' to 'start' + len,
     // return line delimiter pos if found, otherwise return nullptr.
-    // TODO:
-    //  save to positions of field separator
+    // the positions of field separator are saved to _field_pos if _save_field_pos.
     uint8_t* update_field_pos_and_find_line_delimiter(const uint8_t* start, size_t len);
 
     void extend_input_buf();
@@ -92,6 +104,12 @@ private:
 
     size_t _current_offset;
 
+    bool _save_field_pos = false;
+    vectorized::CsvStructuralScanner _structural_scanner;
+    std::vector<size_t> _field_pos;
+    // the bytes of the current line which have been scanned by _structural_scanner
+    size_t _scanned_bytes = 0;
+
     // Profile counters
     RuntimeProfile::Counter* _bytes_read_counter;
     RuntimeProfile::Counter* _read_timer;
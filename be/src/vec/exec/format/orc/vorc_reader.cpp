@@ -17,6 +17,7 @@
 
 #include "vorc_reader.h"
 
+#include <algorithm>
 #include <tuple>
 
 #include "cctz/civil_time.h"
@@ -24,6 +25,7 @@
 #include "gutil/strings/substitute.h"
 #include "io/fs/file_reader.h"
 #include "olap/iterators.h"
+#include "runtime/exec_env.h"
 #include "util/slice.h"
 #include "vec/columns/column_array.h"
 #include "vec/columns/column_map.h"
@@ -51,12 +53,13 @@ void ORCFileInputStream::read(void* buf, uint64_t length, uint64_t offset) {
     _statistics->fs_read_calls++;
     _statistics->fs_read_bytes += length;
     SCOPED_RAW_TIMER(&_statistics->fs_read_time);
+    io::FileReaderSPtr file_reader = _get_file_reader(offset);
     uint64_t has_read = 0;
     char* out = reinterpret_cast<char*>(buf);
     while (has_read < length) {
         size_t loop_read;
         Slice result(out + has_read, length - has_read);
-        Status st = _file_reader->read_at(offset + has_read, result, &loop_read, _io_ctx);
+        Status st = file_reader->read_at(offset + has_read, result, &loop_read, _io_ctx);
         if (!st.ok()) {
             throw orc::ParseError(
                     strings::Substitute("Failed to read $0: $1", _file_name, st.to_string()));
@@ -72,6 +75,43 @@ void ORCFileInputStream::read(void* buf, uint64_t length, uint64_t offset) {
     }
 }
 
+io::FileReaderSPtr ORCFileInputStream::_get_file_reader(uint64_t offset) {
+    if (_stripe_reader != nullptr && offset >= _stripe_ranges[_stripe_index].start_offset &&
+        offset < _stripe_ranges[_stripe_index].end_offset) {
+        return _stripe_reader;
+    }
+    auto it = std::upper_bound(
+            _stripe_ranges.begin(), _stripe_ranges.end(), offset,
+            [](uint64_t value, const StripeRanges& stripe) { return value < stripe.end_offset; });
+    if (it == _stripe_ranges.end() || offset < it->start_offset) {
+        // the file footer, or the stripes out of the scan range
+        return _file_reader;
+    }
+    collect_merge_range_statistics();
+    _stripe_index = it - _stripe_ranges.begin();
+    _stripe_reader = std::make_shared<io::MergeRangeFileReader>(
+            _file_reader, it->ranges, ExecEnv::GetInstance()->merge_range_io_thread_pool(),
+            int64_t(config::merge_range_io_max_gap_kb) << 10,
+            int64_t(config::merge_range_io_max_buffer_mb) << 20,
+            config::merge_range_io_parallelism, _io_ctx);
+    Status st = _stripe_reader->prefetch();
+    if (!st.ok()) {
+        LOG(WARNING) << "Failed to prefetch the stripe of " << _file_name << ": " << st;
+    }
+    return _stripe_reader;
+}
+
+void ORCFileInputStream::collect_merge_range_statistics() {
+    if (_stripe_reader == nullptr) {
+        return;
+    }
+    auto& merge_range_statistics = _stripe_reader->statistics();
+    _statistics->merged_io_ranges += merge_range_statistics.merged_ranges;
+    _statistics->merged_io_bytes += merge_range_statistics.merged_bytes;
+    _statistics->merged_io_wait_time += merge_range_statistics.wait_time;
+    _stripe_reader.reset();
+}
+
 OrcReader::OrcReader(RuntimeProfile* profile, const TFileScanRangeParams& params,
                      const TFileRangeDesc& range, const std::vector<std::string>& column_names,
                      size_t batch_size, const std::string& ctz, io::IOContext* io_ctx)
@@ -112,6 +152,9 @@ OrcReader::~OrcReader() {
 
 void OrcReader::close() {
     if (!_closed) {
+        if (_input_stream != nullptr) {
+            _input_stream->collect_merge_range_statistics();
+        }
         _collect_profile_on_close();
         _closed = true;
     }
@@ -127,6 +170,9 @@ void OrcReader::_collect_profile_on_close() {
         COUNTER_UPDATE(_orc_profile.parse_meta_time, _statistics.parse_meta_time);
         COUNTER_UPDATE(_orc_profile.decode_value_time, _statistics.decode_value_time);
         COUNTER_UPDATE(_orc_profile.decode_null_map_time, _statistics.decode_null_map_time);
+        COUNTER_UPDATE(_orc_profile.merged_io_ranges, _statistics.merged_io_ranges);
+        COUNTER_UPDATE(_orc_profile.merged_io_bytes, _statistics.merged_io_bytes);
+        COUNTER_UPDATE(_orc_profile.merged_io_wait_time, _statistics.merged_io_wait_time);
     }
 }
 
@@ -147,6 +193,12 @@ void OrcReader::_init_profile() {
         _orc_profile.decode_value_time = ADD_CHILD_TIMER(_profile, "DecodeValueTime", orc_profile);
         _orc_profile.decode_null_map_time =
                 ADD_CHILD_TIMER(_profile, "DecodeNullMapTime", orc_profile);
+        _orc_profile.merged_io_ranges =
+                ADD_CHILD_COUNTER(_profile, "MergedIORanges", TUnit::UNIT, orc_profile);
+        _orc_profile.merged_io_bytes =
+                ADD_CHILD_COUNTER(_profile, "MergedIOBytes", TUnit::BYTES, orc_profile);
+        _orc_profile.merged_io_wait_time =
+                ADD_CHILD_TIMER(_profile, "MergedIOWaitTime", orc_profile);
     }
 }
 
@@ -164,14 +216,51 @@ Status OrcReader::_create_file_reader() {
     // create orc reader
     try {
         orc::ReaderOptions options;
+        // the reader owns the stream, which is freed if createReader throws
+        ORCFileInputStream* input_stream = _file_input_stream.get();
         _reader = orc::createReader(
                 std::unique_ptr<ORCFileInputStream>(_file_input_stream.release()), options);
+        _input_stream = input_stream;
     } catch (std::exception& e) {
         return Status::InternalError("Init OrcReader failed. reason = {}", e.what());
     }
     return Status::OK();
 }
 
+void OrcReader::_init_stripe_prefetch() {
+    if (_system_properties.system_type == TFileType::FILE_LOCAL ||
+        ExecEnv::GetInstance()->merge_range_io_thread_pool() == nullptr ||
+        config::merge_range_io_parallelism <= 0) {
+        return;
+    }
+    const std::vector<bool>& selected_columns = _row_reader->getSelectedColumns();
+    std::vector<ORCFileInputStream::StripeRanges> stripe_ranges;
+    for (uint64_t i = 0; i < _reader->getNumberOfStripes(); ++i) {
+        std::unique_ptr<orc::StripeInformation> stripe = _reader->getStripe(i);
+        // the same stripes as the row reader reads
+        if (stripe->getOffset() < _range_start_offset ||
+            stripe->getOffset() >= _range_start_offset + _range_size) {
+            continue;
+        }
+        ORCFileInputStream::StripeRanges ranges;
+        ranges.start_offset = stripe->getOffset();
+        ranges.end_offset = stripe->getOffset() + stripe->getLength();
+        for (uint64_t j = 0; j < stripe->getNumberOfStreams(); ++j) {
+            std::unique_ptr<orc::StreamInformation> stream = stripe->getStreamInformation(j);
+            if (stream->getColumnId() < selected_columns.size() &&
+                selected_columns[stream->getColumnId()]) {
+                ranges.ranges.emplace_back(stream->getOffset(),
+                                           stream->getOffset() + stream->getLength());
+            }
+        }
+        // the stripe footer is read again by the row reader
+        uint64_t footer_offset = ranges.end_offset - stripe->getFooterLength();
+        ranges.ranges.emplace_back(footer_offset, ranges.end_offset);
+        stripe_ranges.emplace_back(std::move(ranges));
+    }
+    _input_stream->set_stripe_ranges(std::move(stripe_ranges));
+}
+
 Status OrcReader::init_reader(
         std::unordered_map<std::string, ColumnValueRangeType>* colname_to_value_range) {
     SCOPED_RAW_TIMER(&_statistics.parse_meta_time);
@@ -187,6 +276,7 @@ Status OrcReader::init_reader(
     try {
         _row_reader = _reader->createRowReader(_row_reader_options);
         _batch = _row_reader->createRowBatch(_batch_size);
+        _init_stripe_prefetch();
     } catch (std::exception& e) {
         return Status::InternalError("Failed to create orc row reader. reason = {}", e.what());
     }
@@ -22,6 +22,7 @@
 #include "common/config.h"
 #include "exec/olap_common.h"
 #include "io/file_factory.h"
+#include "io/fs/buffered_reader.h"
 #include "io/fs/file_reader.h"
 #include "vec/columns/column_array.h"
 #include "vec/core/block.h"
@@ -43,6 +44,9 @@ public:
         int64_t parse_meta_time = 0;
         int64_t decode_value_time = 0;
         int64_t decode_null_map_time = 0;
+        int64_t merged_io_ranges = 0;
+        int64_t merged_io_bytes = 0;
+        int64_t merged_io_wait_time = 0;
     };
 
     OrcReader(RuntimeProfile* profile, const TFileScanRangeParams& params,
@@ -81,12 +85,18 @@ private:
         RuntimeProfile::Counter* parse_meta_time;
         RuntimeProfile::Counter* decode_value_time;
         RuntimeProfile::Counter* decode_null_map_time;
+        RuntimeProfile::Counter* merged_io_ranges;
+        RuntimeProfile::Counter* merged_io_bytes;
+        RuntimeProfile::Counter* merged_io_wait_time;
     };
 
     // Create inner orc file,
     // return EOF if file is empty
     // return EROOR if encounter error.
     Status _create_file_reader();
+    // Plans the streams of the selected columns in the stripes of the scan range, which are
+    // prefetched by ORCFileInputStream when reading remote files.
+    void _init_stripe_prefetch();
 
     void _init_profile();
     Status _init_read_columns();
@@ -265,6 +275,8 @@ private:
     bool _is_hive = false;
     std::vector<const orc::Type*> _col_orc_type;
     std::unique_ptr<ORCFileInputStream> _file_input_stream;
+    // _file_input_stream after it is moved into _reader
+    ORCFileInputStream* _input_stream = nullptr;
     Statistics _statistics;
     OrcProfile _orc_profile;
     bool _closed = false;
@@ -285,6 +297,13 @@ private:
 
 class ORCFileInputStream : public orc::InputStream {
 public:
+    // The ranges to prefetch when the reads enter [start_offset, end_offset) of a stripe.
+    struct StripeRanges {
+        uint64_t start_offset;
+        uint64_t end_offset;
+        std::vector<io::PrefetchRange> ranges;
+    };
+
     ORCFileInputStream(const std::string& file_name, io::FileReaderSPtr file_reader,
                        OrcReader::Statistics* statistics, const io::IOContext* io_ctx)
             : _file_name(file_name),
@@ -302,9 +321,25 @@ public:
 
     const std::string& getName() const override { return _file_name; }
 
+    // `stripe_ranges` is sorted by offset.
+    void set_stripe_ranges(std::vector<StripeRanges> stripe_ranges) {
+        _stripe_ranges = std::move(stripe_ranges);
+    }
+
+    // Adds the statistics of the current stripe reader to OrcReader::Statistics and drops it.
+    void collect_merge_range_statistics();
+
 private:
+    // Returns the reader of the stripe containing `offset`, prefetching the stripe when the
+    // reads enter it.
+    io::FileReaderSPtr _get_file_reader(uint64_t offset);
+
     const std::string& _file_name;
     io::FileReaderSPtr _file_reader;
+    std::vector<StripeRanges> _stripe_ranges;
+    // the index in _stripe_ranges of _stripe_reader
+    size_t _stripe_index = 0;
+    std::shared_ptr<io::MergeRangeFileReader> _stripe_reader = nullptr;
     // Owned by OrcReader
     OrcReader::Statistics* _statistics;
     const io::IOContext* _io_ctx;
@@ -0,0 +1,74 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vparquet_bloom_filter.h"
+
+#include <xxhash.h>
+
+#include <cstring>
+
+namespace doris::vectorized {
+
+static constexpr uint32_t SALT[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                     0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+Status ParquetBloomFilter::init(size_t num_bytes) {
+    if (num_bytes == 0 || num_bytes % BYTES_PER_BLOCK != 0) {
+        return Status::InvalidArgument("Invalid size of parquet bloom filter: {}", num_bytes);
+    }
+    _num_blocks = num_bytes / BYTES_PER_BLOCK;
+    _bitset.reset(new uint32_t[num_bytes / sizeof(uint32_t)]);
+    memset(_bitset.get(), 0, num_bytes);
+    return Status::OK();
+}
+
+Status ParquetBloomFilter::init(const uint8_t* bitset, size_t num_bytes) {
+    RETURN_IF_ERROR(init(num_bytes));
+    memcpy(_bitset.get(), bitset, num_bytes);
+    return Status::OK();
+}
+
+uint64_t ParquetBloomFilter::hash(const void* data, size_t length) {
+    return XXH64(data, length, 0);
+}
+
+uint32_t* ParquetBloomFilter::_block(uint64_t hash) const {
+    // the upper 32 bits select the block, the lower 32 bits select the bits in the block
+    uint64_t block_index = ((hash >> 32) * _num_blocks) >> 32;
+    return _bitset.get() + block_index * WORDS_PER_BLOCK;
+}
+
+void ParquetBloomFilter::insert_hash(uint64_t hash) {
+    uint32_t* block = _block(hash);
+    uint32_t key = static_cast<uint32_t>(hash);
+    for (int i = 0; i < WORDS_PER_BLOCK; ++i) {
+        block[i] |= 1U << ((key * SALT[i]) >> 27);
+    }
+}
+
+bool ParquetBloomFilter::find_hash(uint64_t hash) const {
+    const uint32_t* block = _block(hash);
+    uint32_t key = static_cast<uint32_t>(hash);
+    for (int i = 0; i < WORDS_PER_BLOCK; ++i) {
+        if ((block[i] & (1U << ((key * SALT[i]) >> 27))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace doris::vectorized
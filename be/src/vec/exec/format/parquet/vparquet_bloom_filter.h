@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "common/status.h"
+
+namespace doris::vectorized {
+
+/**
+ * The split block bloom filter of a parquet column chunk, which is stored at
+ * ColumnMetaData.bloom_filter_offset as a BloomFilterHeader followed by the bitset.
+ * The values are hashed by the 64 bits xxHash of their plain encoding.
+ * refer: https://github.com/apache/parquet-format/blob/master/BloomFilter.md
+ */
+class ParquetBloomFilter {
+public:
+    static constexpr size_t BYTES_PER_BLOCK = 32;
+
+    ParquetBloomFilter() = default;
+    ~ParquetBloomFilter() = default;
+
+    // Init with an empty bitset of num_bytes, which should be a multiple of BYTES_PER_BLOCK.
+    Status init(size_t num_bytes);
+    // Init with the bitset read from a parquet file.
+    Status init(const uint8_t* bitset, size_t num_bytes);
+
+    static uint64_t hash(const void* data, size_t length);
+
+    void insert_hash(uint64_t hash);
+
+    bool find_hash(uint64_t hash) const;
+
+    bool find(const void* data, size_t length) const { return find_hash(hash(data, length)); }
+
+private:
+    // every word of a block has one bit set by a value
+    static constexpr int WORDS_PER_BLOCK = BYTES_PER_BLOCK / sizeof(uint32_t);
+
+    uint32_t* _block(uint64_t hash) const;
+
+    std::unique_ptr<uint32_t[]> _bitset;
+    size_t _num_blocks = 0;
+};
+
+} // namespace doris::vectorized
@@ -17,14 +17,10 @@
 
 #include "vparquet_group_reader.h"
 
-#include "exprs/create_predicate_function.h"
 #include "schema_desc.h"
 #include "util/simd/bits.h"
 #include "vec/columns/column_const.h"
-#include "vec/exprs/vdirect_in_predicate.h"
-#include "vec/exprs/vectorized_fn_call.h"
-#include "vec/exprs/vliteral.h"
-#include "vec/exprs/vslot_ref.h"
+#include "vec/columns/column_dict_codes.h"
 #include "vparquet_column_reader.h"
 
 namespace doris::vectorized {
@@ -50,11 +46,6 @@ RowGroupReader::RowGroupReader(io::FileReaderSPtr file_reader,
 
 RowGroupReader::~RowGroupReader() {
     _column_readers.clear();
-    for (auto* ctx : _dict_filter_conjuncts) {
-        if (ctx) {
-            ctx->close(_state);
-        }
-    }
     _obj_pool->clear();
 }
 
@@ -88,8 +79,7 @@ Status RowGroupReader::init(
                                                     _read_ranges, _ctz, reader, max_buf_size));
         auto col_iter = col_offsets.find(read_col._parquet_col_id);
         if (col_iter != col_offsets.end()) {
-            tparquet::OffsetIndex oi = col_iter->second;
-            reader->add_offset_index(&oi);
+            reader->add_offset_index(&col_iter->second);
         }
         if (reader == nullptr) {
             VLOG_DEBUG << "Init row group(" << _row_group_id << ") reader failed";
@@ -97,6 +87,7 @@ Status RowGroupReader::init(
         }
         _column_readers[read_col._file_slot_name] = std::move(reader);
     }
+    RETURN_IF_ERROR(_init_dict_code_cols(schema));
     // Check if single slot can be filtered by dict.
     if (!_slot_id_to_filter_conjuncts) {
         return Status::OK();
@@ -123,6 +114,49 @@ Status RowGroupReader::init(
     return Status::OK();
 }
 
+Status RowGroupReader::_init_dict_code_cols(const FieldDescriptor& schema) {
+    _dict_code_cols.clear();
+    if (_dict_code_col_names == nullptr || _dict_code_col_names->empty()) {
+        return Status::OK();
+    }
+    const std::vector<std::string>& predicate_col_names = _lazy_read_ctx.predicate_columns.first;
+    for (auto& read_col : _read_columns) {
+        const std::string& col_name = read_col._file_slot_name;
+        if (_dict_code_col_names->find(col_name) == _dict_code_col_names->end() ||
+            std::find(predicate_col_names.begin(), predicate_col_names.end(), col_name) !=
+                    predicate_col_names.end()) {
+            continue;
+        }
+        auto field = schema.get_column(col_name);
+        if (!field->children.empty()) {
+            continue;
+        }
+        const auto& column_metadata =
+                _row_group_meta.columns[field->physical_column_index].meta_data;
+        if (column_metadata.type != tparquet::Type::BYTE_ARRAY ||
+            !is_dictionary_encoded(column_metadata)) {
+            continue;
+        }
+        MutableColumnPtr dict_value_column = ColumnString::create();
+        bool has_dict = false;
+        RETURN_IF_ERROR(_column_readers[col_name]->read_dict_values_to_column(dict_value_column,
+                                                                             &has_dict));
+        if (!has_dict) {
+            continue;
+        }
+        const auto& dict_values = assert_cast<const ColumnString&>(*dict_value_column);
+        std::vector<StringRef> words(dict_values.size());
+        for (size_t i = 0; i < words.size(); ++i) {
+            words[i] = dict_values.get_data_at(i);
+        }
+        // an empty column holding the dictionary, the codes of each batch are cut from it
+        auto dict_codes = ColumnDictCodes::create();
+        dict_codes->insert_many_dict_data(nullptr, 0, words.data(), 0, words.size());
+        _dict_code_cols.emplace_back(col_name, std::move(dict_codes));
+    }
+    return Status::OK();
+}
+
 bool RowGroupReader::_can_filter_by_dict(int slot_id,
                                          const tparquet::ColumnMetaData& column_metadata) {
     SlotDescriptor* slot = nullptr;
@@ -253,6 +287,7 @@ Status RowGroupReader::next_batch(Block* block, size_t batch_size, size_t* read_
         RETURN_IF_ERROR(_fill_missing_columns(block, *read_rows, _lazy_read_ctx.missing_columns));
 
         if (block->rows() == 0) {
+            _convert_dict_code_cols(block);
             *read_rows = block->rows();
             return Status::OK();
         }
@@ -270,12 +305,17 @@ Status RowGroupReader::next_batch(Block* block, size_t batch_size, size_t* read_
             if (_position_delete_ctx.has_filter) {
                 filters.push_back(_pos_delete_filter_ptr.get());
             }
+            if (!_dict_code_filters.empty()) {
+                _build_dict_code_filter(block, *read_rows);
+                filters.push_back(&_dict_code_filter_result);
+            }
             RETURN_IF_ERROR(_execute_conjuncts_and_filter_block(_filter_conjuncts, filters, block,
                                                                 columns_to_filter, column_to_keep));
             _convert_dict_cols_to_string_cols(block);
         } else {
             RETURN_IF_ERROR(_filter_block(block, column_to_keep, columns_to_filter));
         }
+        _convert_dict_code_cols(block);
 
         *read_rows = block->rows();
         return Status::OK();
@@ -295,25 +335,30 @@ Status RowGroupReader::_read_column_data(Block* block, const std::vector<std::st
         auto& column_with_type_and_name = block->get_by_name(read_col_name);
         auto& column_ptr = column_with_type_and_name.column;
         auto& column_type = column_with_type_and_name.type;
-        bool is_dict_filter = false;
-        for (auto& _dict_filter_col : _dict_filter_cols) {
-            if (_dict_filter_col.first == read_col_name) {
-                MutableColumnPtr dict_column = ColumnVector<Int32>::create();
-                size_t pos = block->get_position_by_name(read_col_name);
-                if (column_type->is_nullable()) {
-                    block->get_by_position(pos).type =
-                            std::make_shared<DataTypeNullable>(std::make_shared<DataTypeInt32>());
-                    block->replace_by_position(
-                            pos,
-                            ColumnNullable::create(std::move(dict_column),
-                                                   ColumnUInt8::create(dict_column->size(), 0)));
-                } else {
-                    block->get_by_position(pos).type = std::make_shared<DataTypeInt32>();
-                    block->replace_by_position(pos, std::move(dict_column));
-                }
-                is_dict_filter = true;
-                break;
+        // the dict code columns are read as codes like the dict filter columns
+        bool is_dict_code = std::any_of(_dict_code_cols.begin(), _dict_code_cols.end(),
+                                        [&](auto& col) { return col.first == read_col_name; });
+        bool is_dict_filter =
+                is_dict_code ||
+                std::any_of(_dict_filter_cols.begin(), _dict_filter_cols.end(),
+                            [&](auto& col) { return col.first == read_col_name; });
+        if (is_dict_filter) {
+            MutableColumnPtr dict_column = ColumnVector<Int32>::create();
+            size_t pos = block->get_position_by_name(read_col_name);
+            if (column_type->is_nullable()) {
+                block->get_by_position(pos).type =
+                        std::make_shared<DataTypeNullable>(std::make_shared<DataTypeInt32>());
+                block->replace_by_position(
+                        pos, ColumnNullable::create(std::move(dict_column),
+                                                    ColumnUInt8::create(dict_column->size(), 0)));
+            } else {
+                block->get_by_position(pos).type = std::make_shared<DataTypeInt32>();
+                block->replace_by_position(pos, std::move(dict_column));
             }
+        } else if (ColumnDictCodes::get_dict_codes(*column_ptr) != nullptr) {
+            // the column of a reused block was read as codes from the last row group
+            size_t pos = block->get_position_by_name(read_col_name);
+            block->replace_by_position(pos, column_type->create_column());
         }
 
         size_t col_read_rows = 0;
@@ -377,6 +422,10 @@ Status RowGroupReader::_do_lazy_read(Block* block, size_t batch_size, size_t* re
         if (_position_delete_ctx.has_filter) {
             filters.push_back(_pos_delete_filter_ptr.get());
         }
+        if (!_dict_code_filters.empty()) {
+            _build_dict_code_filter(block, pre_read_rows);
+            filters.push_back(&_dict_code_filter_result);
+        }
         RETURN_IF_ERROR(_execute_conjuncts(_filter_conjuncts, filters, block, &result_filter,
                                            &can_filter_all));
 
@@ -447,6 +496,7 @@ Status RowGroupReader::_do_lazy_read(Block* block, size_t batch_size, size_t* re
     }
 
     _convert_dict_cols_to_string_cols(block);
+    _convert_dict_code_cols(block);
 
     size_t column_num = block->columns();
     size_t column_size = 0;
@@ -671,9 +721,7 @@ Status RowGroupReader::_filter_block_internal(Block* block,
 }
 
 Status RowGroupReader::_rewrite_dict_predicates() {
-    for (auto it = _dict_filter_cols.begin(); it != _dict_filter_cols.end();) {
-        std::string& dict_filter_col_name = it->first;
-        int slot_id = it->second;
+    for (auto& [dict_filter_col_name, slot_id] : _dict_filter_cols) {
         // 1. Get dictionary values to a string column.
         MutableColumnPtr dict_value_column = ColumnString::create();
         bool has_dict = false;
@@ -724,151 +772,60 @@ Status RowGroupReader::_rewrite_dict_predicates() {
             return Status::NotFound(msg.str());
         }
 
-        std::vector<uint32_t> columns_to_filter(1, dict_pos);
-        int column_to_keep = temp_block.columns();
         if (dict_pos != 0) {
             // VExprContext.execute has an optimization, the filtering is executed when block->rows() > 0
             // The following process may be tricky and time-consuming, but we have no other way.
             temp_block.get_by_position(0).column->assume_mutable()->resize(dict_value_column_size);
         }
-        std::vector<IColumn::Filter*> filters;
-        RETURN_IF_ERROR(_execute_conjuncts_and_filter_block(*ctxs, filters, &temp_block,
-                                                            columns_to_filter, column_to_keep));
-        if (dict_pos != 0) {
-            // We have to clean the first column to insert right data.
-            temp_block.get_by_position(0).column->assume_mutable()->clear();
-        }
+        // The result of the conjuncts on the i-th value of the dictionary is the filter of
+        // the rows whose dictionary code is i.
+        DictCodeFilter dict_code_filter;
+        dict_code_filter.col_name = dict_filter_col_name;
+        dict_code_filter.code_filter.assign(dict_value_column_size, static_cast<UInt8>(1));
+        bool can_filter_all = false;
+        RETURN_IF_ERROR(_execute_conjuncts(*ctxs, {}, &temp_block, &dict_code_filter.code_filter,
+                                           &can_filter_all));
 
-        // Check some conditions.
-        ColumnPtr& dict_column = temp_block.get_by_position(dict_pos).column;
-        // If dict_column->size() == 0, can filter this row group.
-        if (dict_column->size() == 0) {
+        size_t filtered_values = simd::count_zero_num(
+                reinterpret_cast<const int8_t*>(dict_code_filter.code_filter.data()),
+                dict_value_column_size);
+        // If no value of the dictionary is selected, can filter this row group.
+        if (can_filter_all || filtered_values == dict_value_column_size) {
             _is_row_group_filtered = true;
             return Status::OK();
         }
-
-        // About Performance: if dict_column size is too large, it will generate a large IN filter.
-        if (dict_column->size() > MAX_DICT_CODE_PREDICATE_TO_REWRITE) {
-            for (auto& ctx : (*ctxs)) {
-                _filter_conjuncts.push_back(ctx);
-            }
-            it = _dict_filter_cols.erase(it);
-            continue;
-        }
-
-        // 3. Get dict codes.
-        std::vector<int32_t> dict_codes;
-        if (dict_column->is_nullable()) {
-            const ColumnNullable* nullable_column =
-                    static_cast<const ColumnNullable*>(dict_column.get());
-            const ColumnString* nested_column = static_cast<const ColumnString*>(
-                    nullable_column->get_nested_column_ptr().get());
-            RETURN_IF_ERROR(_column_readers[dict_filter_col_name]->get_dict_codes(
-                    assert_cast<const ColumnString*>(nested_column), &dict_codes));
-        } else {
-            RETURN_IF_ERROR(_column_readers[dict_filter_col_name]->get_dict_codes(
-                    assert_cast<const ColumnString*>(dict_column.get()), &dict_codes));
-        }
-
-        // 4. Rewrite conjuncts.
-        _rewrite_dict_conjuncts(dict_codes, slot_id, dict_column->is_nullable());
-        ++it;
+        // Only the null values are filtered if all the values of the dictionary are selected.
+        dict_code_filter.select_all_values = filtered_values == 0;
+        _dict_code_filters.emplace_back(std::move(dict_code_filter));
     }
     return Status::OK();
 }
 
-Status RowGroupReader::_rewrite_dict_conjuncts(std::vector<int32_t>& dict_codes, int slot_id,
-                                               bool is_nullable) {
-    VExpr* root;
-    if (dict_codes.size() == 1) {
-        {
-            TFunction fn;
-            TFunctionName fn_name;
-            fn_name.__set_db_name("");
-            fn_name.__set_function_name("eq");
-            fn.__set_name(fn_name);
-            fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
-            std::vector<TTypeDesc> arg_types;
-            arg_types.push_back(create_type_desc(PrimitiveType::TYPE_INT));
-            arg_types.push_back(create_type_desc(PrimitiveType::TYPE_INT));
-            fn.__set_arg_types(arg_types);
-            fn.__set_ret_type(create_type_desc(PrimitiveType::TYPE_BOOLEAN));
-            fn.__set_has_var_args(false);
-
-            TExprNode texpr_node;
-            texpr_node.__set_type(create_type_desc(PrimitiveType::TYPE_BOOLEAN));
-            texpr_node.__set_node_type(TExprNodeType::BINARY_PRED);
-            texpr_node.__set_opcode(TExprOpcode::EQ);
-            texpr_node.__set_vector_opcode(TExprOpcode::EQ);
-            texpr_node.__set_fn(fn);
-            texpr_node.__set_child_type(TPrimitiveType::INT);
-            texpr_node.__set_num_children(2);
-            texpr_node.__set_is_nullable(is_nullable);
-            root = _obj_pool->add(new VectorizedFnCall(texpr_node));
-        }
-        {
-            SlotDescriptor* slot = nullptr;
-            const std::vector<SlotDescriptor*>& slots = _tuple_descriptor->slots();
-            for (auto each : slots) {
-                if (each->id() == slot_id) {
-                    slot = each;
-                    break;
-                }
+void RowGroupReader::_build_dict_code_filter(Block* block, size_t rows) {
+    _dict_code_filter_result.assign(rows, static_cast<UInt8>(1));
+    auto* __restrict result_data = _dict_code_filter_result.data();
+    for (auto& dict_code_filter : _dict_code_filters) {
+        const ColumnPtr& column = block->get_by_name(dict_code_filter.col_name).column;
+        const ColumnInt32* code_column = nullptr;
+        if (auto* nullable_column = check_and_get_column<ColumnNullable>(*column)) {
+            const auto* __restrict null_map_data = nullable_column->get_null_map_data().data();
+            for (size_t i = 0; i < rows; ++i) {
+                result_data[i] &= !null_map_data[i];
             }
-            VExpr* slot_ref_expr = _obj_pool->add(new VSlotRef(slot));
-            root->add_child(slot_ref_expr);
-        }
-        {
-            TExprNode texpr_node;
-            texpr_node.__set_node_type(TExprNodeType::INT_LITERAL);
-            texpr_node.__set_type(create_type_desc(TYPE_INT));
-            TIntLiteral int_literal;
-            int_literal.__set_value(dict_codes[0]);
-            texpr_node.__set_int_literal(int_literal);
-            texpr_node.__set_is_nullable(is_nullable);
-            VExpr* literal_expr = _obj_pool->add(new VLiteral(texpr_node));
-            root->add_child(literal_expr);
+            code_column = assert_cast<const ColumnInt32*>(
+                    nullable_column->get_nested_column_ptr().get());
+        } else {
+            code_column = assert_cast<const ColumnInt32*>(column.get());
         }
-    } else {
-        {
-            TTypeDesc type_desc = create_type_desc(PrimitiveType::TYPE_BOOLEAN);
-            TExprNode node;
-            node.__set_type(type_desc);
-            node.__set_node_type(TExprNodeType::IN_PRED);
-            node.in_predicate.__set_is_not_in(false);
-            node.__set_opcode(TExprOpcode::FILTER_IN);
-            node.__isset.vector_opcode = true;
-            node.__set_vector_opcode(TExprOpcode::FILTER_IN);
-            // VdirectInPredicate assume is_nullable = false.
-            node.__set_is_nullable(false);
-
-            root = _obj_pool->add(new vectorized::VDirectInPredicate(node));
-            std::shared_ptr<HybridSetBase> hybrid_set(
-                    create_set(PrimitiveType::TYPE_INT, dict_codes.size()));
-            for (int j = 0; j < dict_codes.size(); ++j) {
-                hybrid_set->insert(&dict_codes[j]);
-            }
-            static_cast<vectorized::VDirectInPredicate*>(root)->set_filter(hybrid_set);
-        }
-        {
-            SlotDescriptor* slot = nullptr;
-            const std::vector<SlotDescriptor*>& slots = _tuple_descriptor->slots();
-            for (auto each : slots) {
-                if (each->id() == slot_id) {
-                    slot = each;
-                    break;
-                }
-            }
-            VExpr* slot_ref_expr = _obj_pool->add(new VSlotRef(slot));
-            root->add_child(slot_ref_expr);
+        if (dict_code_filter.select_all_values) {
+            continue;
+        }
+        const auto* __restrict codes = code_column->get_data().data();
+        const auto* __restrict code_filter = dict_code_filter.code_filter.data();
+        for (size_t i = 0; i < rows; ++i) {
+            result_data[i] &= code_filter[codes[i]];
         }
     }
-    VExprContext* rewritten_conjunct_ctx = _obj_pool->add(new VExprContext(root));
-    RETURN_IF_ERROR(rewritten_conjunct_ctx->prepare(_state, *_row_descriptor));
-    RETURN_IF_ERROR(rewritten_conjunct_ctx->open(_state));
-    _dict_filter_conjuncts.push_back(rewritten_conjunct_ctx);
-    _filter_conjuncts.push_back(rewritten_conjunct_ctx);
-    return Status::OK();
 }
 
 void RowGroupReader::_convert_dict_cols_to_string_cols(Block* block) {
@@ -902,6 +859,40 @@ void RowGroupReader::_convert_dict_cols_to_string_cols(Block* block) {
     }
 }
 
+void RowGroupReader::_convert_dict_code_cols(Block* block) {
+    for (auto& [col_name, dict_column] : _dict_code_cols) {
+        size_t pos = block->get_position_by_name(col_name);
+        ColumnWithTypeAndName& column_with_type_and_name = block->get_by_position(pos);
+        // hold the column, it is replaced in the block below
+        ColumnPtr column = column_with_type_and_name.column;
+        const auto* nullable_column = check_and_get_column<ColumnNullable>(*column);
+        const auto& codes =
+                assert_cast<const ColumnInt32&>(
+                        nullable_column ? nullable_column->get_nested_column() : *column)
+                        .get_data();
+        MutableColumnPtr dict_codes = dict_column->clone_resized(0);
+        auto& dict_codes_data = assert_cast<ColumnDictCodes&>(*dict_codes).get_data();
+        dict_codes_data.assign(codes.begin(), codes.end());
+
+        if (nullable_column) {
+            const auto& null_map = nullable_column->get_null_map_data();
+            for (size_t i = 0; i < dict_codes_data.size(); ++i) {
+                if (null_map[i]) {
+                    dict_codes_data[i] = ColumnDictCodes::DEFAULT_CODE;
+                }
+            }
+            column_with_type_and_name.type =
+                    std::make_shared<DataTypeNullable>(std::make_shared<DataTypeString>());
+            block->replace_by_position(
+                    pos, ColumnNullable::create(std::move(dict_codes),
+                                                nullable_column->get_null_map_column_ptr()));
+        } else {
+            column_with_type_and_name.type = std::make_shared<DataTypeString>();
+            block->replace_by_position(pos, std::move(dict_codes));
+        }
+    }
+}
+
 ParquetColumnReader::Statistics RowGroupReader::statistics() {
     ParquetColumnReader::Statistics st;
     for (auto& reader : _column_readers) {
@@ -25,9 +25,6 @@
 
 namespace doris::vectorized {
 
-// TODO: we need to determine it by test.
-static constexpr uint32_t MAX_DICT_CODE_PREDICATE_TO_REWRITE = std::numeric_limits<uint32_t>::max();
-
 class RowGroupReader {
 public:
     static const std::vector<int64_t> NO_DELETE;
@@ -120,6 +117,11 @@ public:
             const std::vector<VExprContext*>* not_single_slot_filter_conjuncts,
             const std::unordered_map<int, std::vector<VExprContext*>>* slot_id_to_filter_conjuncts);
     Status next_batch(Block* block, size_t batch_size, size_t* read_rows, bool* batch_eof);
+    // The non-predicate columns in dict_code_col_names are returned as ColumnDictCodes if the
+    // column chunks are fully dictionary encoded, should be called before init().
+    void set_dict_code_col_names(const std::unordered_set<std::string>* dict_code_col_names) {
+        _dict_code_col_names = dict_code_col_names;
+    }
     int64_t lazy_read_filtered_rows() const { return _lazy_read_filtered_rows; }
 
     ParquetColumnReader::Statistics statistics();
@@ -148,9 +150,17 @@ private:
 
     bool _can_filter_by_dict(int slot_id, const tparquet::ColumnMetaData& column_metadata);
     bool is_dictionary_encoded(const tparquet::ColumnMetaData& column_metadata);
+    // Evaluate the conjuncts of the dict filter columns on their dictionaries, the rows of these
+    // columns are filtered by their dictionary codes.
     Status _rewrite_dict_predicates();
-    Status _rewrite_dict_conjuncts(std::vector<int32_t>& dict_codes, int slot_id, bool is_nullable);
+    void _build_dict_code_filter(Block* block, size_t rows);
+    // The codes of the dict filter columns are turned back into strings before the block leaves
+    // the reader, their conjuncts are evaluated on the strings by the scan node.
     void _convert_dict_cols_to_string_cols(Block* block);
+    Status _init_dict_code_cols(const FieldDescriptor& schema);
+    // The codes of the dict code columns leave the reader as ColumnDictCodes sharing the
+    // dictionary of the column chunk.
+    void _convert_dict_code_cols(Block* block);
     Status _execute_conjuncts(const std::vector<VExprContext*>& ctxs,
                               const std::vector<IColumn::Filter*>& filters, Block* block,
                               IColumn::Filter* result_filter, bool* can_filter_all);
@@ -182,10 +192,21 @@ private:
     const RowDescriptor* _row_descriptor;
     const std::unordered_map<std::string, int>* _col_name_to_slot_id;
     const std::unordered_map<int, std::vector<VExprContext*>>* _slot_id_to_filter_conjuncts;
-    std::vector<VExprContext*> _dict_filter_conjuncts;
     std::vector<VExprContext*> _filter_conjuncts;
     // std::pair<col_name, slot_id>
     std::vector<std::pair<std::string, int>> _dict_filter_cols;
+    struct DictCodeFilter {
+        std::string col_name;
+        // whether the rows with the dictionary code are selected by the conjuncts
+        IColumn::Filter code_filter;
+        bool select_all_values = false;
+    };
+    std::vector<DictCodeFilter> _dict_code_filters;
+    // the filter of the current batch built from _dict_code_filters
+    IColumn::Filter _dict_code_filter_result;
+    const std::unordered_set<std::string>* _dict_code_col_names = nullptr;
+    // std::pair<col_name, empty ColumnDictCodes holding the dictionary of the column chunk>
+    std::vector<std::pair<std::string, ColumnPtr>> _dict_code_cols;
     RuntimeState* _state;
     std::shared_ptr<ObjectPool> _obj_pool;
     bool _is_row_group_filtered = false;
@@ -18,13 +18,19 @@
 #include "vparquet_reader.h"
 
 #include <algorithm>
+#include <functional>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "io/file_factory.h"
 #include "olap/iterators.h"
 #include "parquet_pred_cmp.h"
 #include "parquet_thrift_util.h"
 #include "rapidjson/document.h"
+#include "runtime/exec_env.h"
+#include "util/block_compression.h"
+#include "util/coding.h"
+#include "util/thrift_util.h"
 #include "vec/exprs/vbloom_predicate.h"
 #include "vec/exprs/vin_predicate.h"
 #include "vec/exprs/vruntimefilter_wrapper.h"
@@ -72,6 +78,10 @@ void ParquetReader::_init_profile() {
 
         _parquet_profile.filtered_row_groups =
                 ADD_CHILD_COUNTER(_profile, "FilteredGroups", TUnit::UNIT, parquet_profile);
+        _parquet_profile.dict_filtered_row_groups =
+                ADD_CHILD_COUNTER(_profile, "FilteredGroupsByDict", TUnit::UNIT, parquet_profile);
+        _parquet_profile.bloom_filtered_row_groups = ADD_CHILD_COUNTER(
+                _profile, "FilteredGroupsByBloomFilter", TUnit::UNIT, parquet_profile);
         _parquet_profile.to_read_row_groups =
                 ADD_CHILD_COUNTER(_profile, "ReadGroups", TUnit::UNIT, parquet_profile);
         _parquet_profile.filtered_group_rows =
@@ -82,6 +92,10 @@ void ParquetReader::_init_profile() {
                 ADD_CHILD_COUNTER(_profile, "FilteredRowsByLazyRead", TUnit::UNIT, parquet_profile);
         _parquet_profile.filtered_bytes =
                 ADD_CHILD_COUNTER(_profile, "FilteredBytes", TUnit::BYTES, parquet_profile);
+        _parquet_profile.dict_filtered_bytes =
+                ADD_CHILD_COUNTER(_profile, "FilteredBytesByDict", TUnit::BYTES, parquet_profile);
+        _parquet_profile.bloom_filtered_bytes = ADD_CHILD_COUNTER(
+                _profile, "FilteredBytesByBloomFilter", TUnit::BYTES, parquet_profile);
         _parquet_profile.raw_rows_read =
                 ADD_CHILD_COUNTER(_profile, "RawRowsRead", TUnit::UNIT, parquet_profile);
         _parquet_profile.to_read_bytes =
@@ -100,6 +114,12 @@ void ParquetReader::_init_profile() {
                 ADD_CHILD_TIMER(_profile, "PageIndexFilterTime", parquet_profile);
         _parquet_profile.row_group_filter_time =
                 ADD_CHILD_TIMER(_profile, "RowGroupFilterTime", parquet_profile);
+        _parquet_profile.merged_io_ranges =
+                ADD_CHILD_COUNTER(_profile, "MergedIORanges", TUnit::UNIT, parquet_profile);
+        _parquet_profile.merged_io_bytes =
+                ADD_CHILD_COUNTER(_profile, "MergedIOBytes", TUnit::BYTES, parquet_profile);
+        _parquet_profile.merged_io_wait_time =
+                ADD_CHILD_TIMER(_profile, "MergedIOWaitTime", parquet_profile);
 
         _parquet_profile.file_read_time = ADD_TIMER(_profile, "FileReadTime");
         _parquet_profile.file_read_calls = ADD_COUNTER(_profile, "FileReadCalls", TUnit::UNIT);
@@ -123,14 +143,22 @@ void ParquetReader::_init_profile() {
 
 void ParquetReader::close() {
     if (!_closed) {
+        _collect_merge_range_statistics();
         if (_profile != nullptr) {
             COUNTER_UPDATE(_parquet_profile.filtered_row_groups, _statistics.filtered_row_groups);
+            COUNTER_UPDATE(_parquet_profile.dict_filtered_row_groups,
+                           _statistics.dict_filtered_row_groups);
+            COUNTER_UPDATE(_parquet_profile.bloom_filtered_row_groups,
+                           _statistics.bloom_filtered_row_groups);
             COUNTER_UPDATE(_parquet_profile.to_read_row_groups, _statistics.read_row_groups);
             COUNTER_UPDATE(_parquet_profile.filtered_group_rows, _statistics.filtered_group_rows);
             COUNTER_UPDATE(_parquet_profile.filtered_page_rows, _statistics.filtered_page_rows);
             COUNTER_UPDATE(_parquet_profile.lazy_read_filtered_rows,
                            _statistics.lazy_read_filtered_rows);
             COUNTER_UPDATE(_parquet_profile.filtered_bytes, _statistics.filtered_bytes);
+            COUNTER_UPDATE(_parquet_profile.dict_filtered_bytes, _statistics.dict_filtered_bytes);
+            COUNTER_UPDATE(_parquet_profile.bloom_filtered_bytes,
+                           _statistics.bloom_filtered_bytes);
             COUNTER_UPDATE(_parquet_profile.raw_rows_read, _statistics.read_rows);
             COUNTER_UPDATE(_parquet_profile.to_read_bytes, _statistics.read_bytes);
             COUNTER_UPDATE(_parquet_profile.column_read_time, _statistics.column_read_time);
@@ -142,6 +170,9 @@ void ParquetReader::close() {
                            _statistics.page_index_filter_time);
             COUNTER_UPDATE(_parquet_profile.row_group_filter_time,
                            _statistics.row_group_filter_time);
+            COUNTER_UPDATE(_parquet_profile.merged_io_ranges, _statistics.merged_io_ranges);
+            COUNTER_UPDATE(_parquet_profile.merged_io_bytes, _statistics.merged_io_bytes);
+            COUNTER_UPDATE(_parquet_profile.merged_io_wait_time, _statistics.merged_io_wait_time);
 
             COUNTER_UPDATE(_parquet_profile.file_read_time, _column_statistics.read_time);
             COUNTER_UPDATE(_parquet_profile.file_read_calls, _column_statistics.read_calls);
@@ -283,6 +314,21 @@ Status ParquetReader::init_reader(
     return Status::OK();
 }
 
+void ParquetReader::set_dict_code_slot_ids(const std::set<SlotId>& dict_code_slot_ids) {
+    _dict_code_col_names.clear();
+    if (dict_code_slot_ids.empty() || _colname_to_slot_id == nullptr) {
+        return;
+    }
+    for (auto& [col_name, slot_id] : *_colname_to_slot_id) {
+        if (dict_code_slot_ids.find(slot_id) == dict_code_slot_ids.end()) {
+            continue;
+        }
+        auto iter = _table_col_to_file_col.find(col_name);
+        _dict_code_col_names.insert(iter == _table_col_to_file_col.end() ? col_name
+                                                                         : iter->second);
+    }
+}
+
 Status ParquetReader::set_fill_columns(
         const std::unordered_map<std::string, std::tuple<std::string, const SlotDescriptor*>>&
                 partition_columns,
@@ -519,9 +565,11 @@ Status ParquetReader::_next_row_group_reader() {
 
     RowGroupReader::PositionDeleteContext position_delete_ctx =
             _get_position_delete_ctx(row_group, row_group_index);
-    _current_group_reader.reset(new RowGroupReader(_file_reader, _read_columns,
-                                                   row_group_index.row_group_id, row_group, _ctz,
-                                                   position_delete_ctx, _lazy_read_ctx, _state));
+    _current_group_reader.reset(new RowGroupReader(
+            _get_row_group_file_reader(row_group, candidate_row_ranges), _read_columns,
+            row_group_index.row_group_id, row_group, _ctz, position_delete_ctx, _lazy_read_ctx,
+            _state));
+    _current_group_reader->set_dict_code_col_names(&_dict_code_col_names);
     _row_group_eof = false;
     return _current_group_reader->init(_file_metadata->schema(), candidate_row_ranges, _col_offsets,
                                        _tuple_descriptor, _row_descriptor, _colname_to_slot_id,
@@ -529,6 +577,96 @@ Status ParquetReader::_next_row_group_reader() {
                                        _slot_id_to_filter_conjuncts);
 }
 
+io::FileReaderSPtr ParquetReader::_get_row_group_file_reader(
+        const tparquet::RowGroup& row_group, const std::vector<RowRange>& candidate_row_ranges) {
+    _collect_merge_range_statistics();
+    ThreadPool* thread_pool = ExecEnv::GetInstance()->merge_range_io_thread_pool();
+    if (_system_properties.system_type == TFileType::FILE_LOCAL || thread_pool == nullptr ||
+        config::merge_range_io_parallelism <= 0 || _read_columns.empty()) {
+        return _file_reader;
+    }
+    std::vector<io::PrefetchRange> ranges;
+    // the ranges of the column chunks to read, one for each leaf of the read columns
+    std::function<void(const FieldSchema*)> add_chunk_ranges = [&](const FieldSchema* field) {
+        if (!field->children.empty()) {
+            for (auto& child : field->children) {
+                add_chunk_ranges(&child);
+            }
+            return;
+        }
+        auto& chunk = row_group.columns[field->physical_column_index];
+        if (chunk.__isset.meta_data) {
+            int64_t start_offset = _get_column_start_offset(chunk.meta_data);
+            ranges.emplace_back(start_offset,
+                                start_offset + chunk.meta_data.total_compressed_size);
+        }
+    };
+    // the ranges of the dictionary page and the data pages with candidate rows
+    auto add_page_ranges = [&](const tparquet::ColumnChunk& chunk,
+                               const tparquet::OffsetIndex& offset_index) {
+        auto& page_locations = offset_index.page_locations;
+        ranges.emplace_back(_get_column_start_offset(chunk.meta_data), page_locations[0].offset);
+        for (size_t i = 0; i < page_locations.size(); ++i) {
+            int64_t first_row = page_locations[i].first_row_index;
+            int64_t last_row = i + 1 < page_locations.size()
+                                       ? page_locations[i + 1].first_row_index
+                                       : row_group.num_rows;
+            if (std::any_of(candidate_row_ranges.begin(), candidate_row_ranges.end(),
+                            [&](const RowRange& range) {
+                                return range.first_row < last_row && range.last_row > first_row;
+                            })) {
+                ranges.emplace_back(page_locations[i].offset,
+                                    page_locations[i].offset +
+                                            page_locations[i].compressed_page_size);
+            }
+        }
+    };
+    auto& predicate_columns = _lazy_read_ctx.predicate_columns.first;
+    for (auto& read_col : _read_columns) {
+        // The lazy read columns are only read for the rows selected by the predicate columns,
+        // and skip the pages without any of them, so they are read on demand.
+        if (_lazy_read_ctx.can_lazy_read &&
+            std::find(predicate_columns.begin(), predicate_columns.end(),
+                      read_col._file_slot_name) == predicate_columns.end()) {
+            continue;
+        }
+        // The offset index is only kept for the columns with pages skipped by the page index,
+        // the other columns are read whole.
+        auto offset_iter = _col_offsets.find(read_col._parquet_col_id);
+        auto& chunk = row_group.columns[read_col._parquet_col_id];
+        if (offset_iter != _col_offsets.end() && chunk.__isset.meta_data &&
+            !offset_iter->second.page_locations.empty()) {
+            add_page_ranges(chunk, offset_iter->second);
+        } else {
+            add_chunk_ranges(_file_metadata->schema().get_column(read_col._parquet_col_id));
+        }
+    }
+    if (ranges.empty()) {
+        return _file_reader;
+    }
+    _merge_range_reader = std::make_shared<io::MergeRangeFileReader>(
+            _file_reader, std::move(ranges), thread_pool,
+            int64_t(config::merge_range_io_max_gap_kb) << 10,
+            int64_t(config::merge_range_io_max_buffer_mb) << 20,
+            config::merge_range_io_parallelism, _io_ctx);
+    Status st = _merge_range_reader->prefetch();
+    if (!st.ok()) {
+        LOG(WARNING) << "Failed to prefetch the row group of " << _scan_range.path << ": " << st;
+    }
+    return _merge_range_reader;
+}
+
+void ParquetReader::_collect_merge_range_statistics() {
+    if (_merge_range_reader == nullptr) {
+        return;
+    }
+    auto& merge_range_statistics = _merge_range_reader->statistics();
+    _statistics.merged_io_ranges += merge_range_statistics.merged_ranges;
+    _statistics.merged_io_bytes += merge_range_statistics.merged_bytes;
+    _statistics.merged_io_wait_time += merge_range_statistics.wait_time;
+    _merge_range_reader.reset();
+}
+
 Status ParquetReader::_init_row_groups(const bool& is_filter_groups) {
     SCOPED_RAW_TIMER(&_statistics.row_group_filter_time);
     if (is_filter_groups && (_total_groups == 0 || _t_metadata->num_rows == 0 || _range_size < 0)) {
@@ -541,10 +679,6 @@ Status ParquetReader::_init_row_groups(const bool& is_filter_groups) {
             row_index += row_group.num_rows;
             continue;
         }
-        bool filter_group = false;
-        if (is_filter_groups) {
-            RETURN_IF_ERROR(_process_row_group_filter(row_group, &filter_group));
-        }
         int64_t group_size = 0; // only calculate the needed columns
         for (auto& read_col : _read_columns) {
             auto& parquet_col_id = read_col._parquet_col_id;
@@ -552,6 +686,10 @@ Status ParquetReader::_init_row_groups(const bool& is_filter_groups) {
                 group_size += row_group.columns[parquet_col_id].meta_data.total_compressed_size;
             }
         }
+        bool filter_group = false;
+        if (is_filter_groups) {
+            RETURN_IF_ERROR(_process_row_group_filter(row_group, group_size, &filter_group));
+        }
         if (!filter_group) {
             _read_row_groups.emplace_back(row_group_idx, row_index, row_index + row_group.num_rows);
             if (_statistics.read_row_groups == 0) {
@@ -596,6 +734,8 @@ bool ParquetReader::_has_page_index(const std::vector<tparquet::ColumnChunk>& co
 Status ParquetReader::_process_page_index(const tparquet::RowGroup& row_group,
                                           std::vector<RowRange>& candidate_row_ranges) {
     SCOPED_RAW_TIMER(&_statistics.page_index_filter_time);
+    // the offset indexes of the previous row group, whose readers are done with them
+    _col_offsets.clear();
 
     std::function<void()> read_whole_row_group = [&]() {
         candidate_row_ranges.emplace_back(0, row_group.num_rows);
@@ -692,12 +832,26 @@ Status ParquetReader::_process_page_index(const tparquet::RowGroup& row_group,
 }
 
 Status ParquetReader::_process_row_group_filter(const tparquet::RowGroup& row_group,
-                                                bool* filter_group) {
-    _process_column_stat_filter(row_group.columns, filter_group);
-    _init_chunk_dicts();
-    RETURN_IF_ERROR(_process_dict_filter(filter_group));
-    _init_bloom_filter();
-    RETURN_IF_ERROR(_process_bloom_filter(filter_group));
+                                                int64_t group_size, bool* filter_group) {
+    RETURN_IF_ERROR(_process_column_stat_filter(row_group.columns, filter_group));
+    if (*filter_group) {
+        return Status::OK();
+    }
+    if (config::enable_parquet_dict_filter) {
+        RETURN_IF_ERROR(_process_dict_filter(row_group, filter_group));
+    }
+    if (*filter_group) {
+        _statistics.dict_filtered_row_groups++;
+        _statistics.dict_filtered_bytes += group_size;
+        return Status::OK();
+    }
+    if (config::enable_parquet_bloom_filter) {
+        RETURN_IF_ERROR(_process_bloom_filter(row_group, filter_group));
+    }
+    if (*filter_group) {
+        _statistics.bloom_filtered_row_groups++;
+        _statistics.bloom_filtered_bytes += group_size;
+    }
     return Status::OK();
 }
 
@@ -732,15 +886,294 @@ Status ParquetReader::_process_column_stat_filter(const std::vector<tparquet::Co
     return Status::OK();
 }
 
-void ParquetReader::_init_chunk_dicts() {}
+std::vector<std::pair<const ParquetReadColumn*, const ColumnValueRangeType*>>
+ParquetReader::_get_value_filter_columns() {
+    std::vector<std::pair<const ParquetReadColumn*, const ColumnValueRangeType*>> columns;
+    if (_colname_to_value_range == nullptr || _colname_to_value_range->empty()) {
+        return columns;
+    }
+    auto& schema_desc = _file_metadata->schema();
+    for (auto& read_col : _read_columns) {
+        auto iter = _colname_to_value_range->find(read_col._file_slot_name);
+        if (iter == _colname_to_value_range->end()) {
+            continue;
+        }
+        if (!schema_desc.get_column(read_col._file_slot_name)->children.empty()) {
+            continue;
+        }
+        bool has_predicate = std::visit(
+                [](auto&& range) {
+                    if (range.contain_null() || range.is_empty_value_range()) {
+                        return false;
+                    }
+                    return range.is_fixed_value_range() || !range.is_low_value_mininum() ||
+                           !range.is_high_value_maximum();
+                },
+                iter->second);
+        if (has_predicate) {
+            columns.emplace_back(&read_col, &iter->second);
+        }
+    }
+    return columns;
+}
+
+Status ParquetReader::_init_chunk_dict(const tparquet::ColumnChunk& chunk,
+                                       const FieldSchema* col_schema,
+                                       std::vector<std::string>* dict_values, bool* has_dict) {
+    *has_dict = false;
+    const tparquet::ColumnMetaData& meta = chunk.meta_data;
+    if (!chunk.__isset.meta_data || !meta.__isset.dictionary_page_offset ||
+        !meta.__isset.encoding_stats || meta.type == tparquet::Type::BOOLEAN) {
+        return Status::OK();
+    }
+    // the writer falls back to plain encoding when the dictionary grows too large, so
+    // the values of the dictionary are the values of the chunk only if no data page is plain
+    for (auto& encoding_stat : meta.encoding_stats) {
+        if (encoding_stat.page_type != tparquet::PageType::DATA_PAGE &&
+            encoding_stat.page_type != tparquet::PageType::DATA_PAGE_V2) {
+            continue;
+        }
+        if (encoding_stat.count > 0 &&
+            encoding_stat.encoding != tparquet::Encoding::PLAIN_DICTIONARY &&
+            encoding_stat.encoding != tparquet::Encoding::RLE_DICTIONARY) {
+            return Status::OK();
+        }
+    }
+    int64_t dict_offset = meta.dictionary_page_offset;
+    int64_t dict_length = meta.data_page_offset - dict_offset;
+    int64_t file_size = _file_reader->size();
+    if (dict_length <= 0 || dict_offset + dict_length > file_size) {
+        return Status::OK();
+    }
+
+    std::unique_ptr<uint8_t[]> dict_buf(new uint8_t[dict_length]);
+    Slice dict_slice(dict_buf.get(), dict_length);
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(_file_reader->read_at(dict_offset, dict_slice, &bytes_read, _io_ctx));
+    tparquet::PageHeader header;
+    uint32_t header_size = dict_length;
+    RETURN_IF_ERROR(deserialize_thrift_msg(dict_buf.get(), &header_size, true, &header));
+    if (header.type != tparquet::PageType::DICTIONARY_PAGE ||
+        !header.__isset.dictionary_page_header) {
+        return Status::OK();
+    }
+    tparquet::Encoding::type dict_encoding = header.dictionary_page_header.encoding;
+    if (dict_encoding != tparquet::Encoding::PLAIN_DICTIONARY &&
+        dict_encoding != tparquet::Encoding::PLAIN) {
+        return Status::OK();
+    }
+    if (header.compressed_page_size < 0 ||
+        int64_t(header_size) + header.compressed_page_size > dict_length) {
+        return Status::Corruption("Invalid dictionary page of column {} in {}", col_schema->name,
+                                  _scan_range.path);
+    }
 
-Status ParquetReader::_process_dict_filter(bool* filter_group) {
+    Slice page_data(dict_buf.get() + header_size, header.compressed_page_size);
+    std::unique_ptr<uint8_t[]> decompressed_buf;
+    BlockCompressionCodec* codec = nullptr;
+    RETURN_IF_ERROR(get_block_compression_codec(meta.codec, &codec));
+    if (codec != nullptr) {
+        decompressed_buf.reset(new uint8_t[header.uncompressed_page_size]);
+        Slice decompressed(decompressed_buf.get(), header.uncompressed_page_size);
+        RETURN_IF_ERROR(codec->decompress(page_data, &decompressed));
+        page_data = decompressed;
+    }
+
+    // the length of a plain encoded value, -1 for BYTE_ARRAY which is prefixed by its length
+    int64_t type_length;
+    switch (meta.type) {
+    case tparquet::Type::INT32:
+    case tparquet::Type::FLOAT:
+        type_length = 4;
+        break;
+    case tparquet::Type::INT64:
+    case tparquet::Type::DOUBLE:
+        type_length = 8;
+        break;
+    case tparquet::Type::INT96:
+        type_length = 12;
+        break;
+    case tparquet::Type::FIXED_LEN_BYTE_ARRAY:
+        type_length = col_schema->parquet_schema.type_length;
+        break;
+    case tparquet::Type::BYTE_ARRAY:
+        type_length = -1;
+        break;
+    default:
+        return Status::OK();
+    }
+    const char* data = page_data.data;
+    const char* data_end = page_data.data + page_data.size;
+    int32_t num_values = header.dictionary_page_header.num_values;
+    dict_values->reserve(num_values);
+    for (int32_t i = 0; i < num_values; ++i) {
+        int64_t length = type_length;
+        if (type_length < 0) {
+            if (data_end - data < int64_t(sizeof(uint32_t))) {
+                return Status::Corruption("Invalid dictionary page of column {} in {}",
+                                          col_schema->name, _scan_range.path);
+            }
+            length = decode_fixed32_le(reinterpret_cast<const uint8_t*>(data));
+            data += sizeof(uint32_t);
+        }
+        if (data_end - data < length) {
+            return Status::Corruption("Invalid dictionary page of column {} in {}",
+                                      col_schema->name, _scan_range.path);
+        }
+        dict_values->emplace_back(data, length);
+        data += length;
+    }
+    *has_dict = true;
+    return Status::OK();
+}
+
+Status ParquetReader::_process_dict_filter(const tparquet::RowGroup& row_group,
+                                          bool* filter_group) {
+    auto& schema_desc = _file_metadata->schema();
+    for (auto& [read_col, col_val_range] : _get_value_filter_columns()) {
+        const FieldSchema* col_schema = schema_desc.get_column(read_col->_file_slot_name);
+        std::vector<std::string> dict_values;
+        bool has_dict = false;
+        RETURN_IF_ERROR(_init_chunk_dict(row_group.columns[col_schema->physical_column_index],
+                                         col_schema, &dict_values, &has_dict));
+        if (!has_dict) {
+            continue;
+        }
+        // The predicates can not be satisfied by null, so the row group is filtered
+        // if they are not satisfied by any value of the dictionary.
+        *filter_group = std::all_of(
+                dict_values.begin(), dict_values.end(), [&](const std::string& value) {
+                    return ParquetPredicate::filter_by_min_max(*col_val_range, col_schema, value,
+                                                               value, *_ctz);
+                });
+        if (*filter_group) {
+            break;
+        }
+    }
     return Status::OK();
 }
 
-void ParquetReader::_init_bloom_filter() {}
+// Hashes the IN / EQ values of `col_val_range` like the bloom filter of the column chunk.
+// Returns false if the values can not be checked by the bloom filter. Floating point columns
+// are not checked, the writers hash the raw bits, so 0.0 and -0.0 or NaNs of different bits
+// hash differently although they are equal as SQL values.
+static bool get_bloom_filter_hashes(const ColumnValueRangeType& col_val_range,
+                                    const FieldSchema* col_schema,
+                                    std::vector<uint64_t>* hashes) {
+    return std::visit(
+            [&](auto&& range) -> bool {
+                using CppType = typename std::decay_t<decltype(range)>::CppType;
+                if (!range.is_fixed_value_range()) {
+                    return false;
+                }
+                tparquet::Type::type physical_type = col_schema->physical_type;
+                for (const CppType& value : range.get_fixed_value_set()) {
+                    switch (range.type()) {
+                    case TYPE_TINYINT:
+                    case TYPE_SMALLINT:
+                    case TYPE_INT:
+                        if constexpr (std::is_integral_v<CppType> && sizeof(CppType) <= 4) {
+                            if (physical_type != tparquet::Type::INT32) {
+                                return false;
+                            }
+                            int32_t plain_value = value;
+                            hashes->emplace_back(
+                                    ParquetBloomFilter::hash(&plain_value, sizeof(plain_value)));
+                            break;
+                        }
+                        return false;
+                    case TYPE_BIGINT:
+                        if constexpr (std::is_same_v<CppType, int64_t>) {
+                            if (physical_type != tparquet::Type::INT64) {
+                                return false;
+                            }
+                            hashes->emplace_back(ParquetBloomFilter::hash(&value, sizeof(value)));
+                            break;
+                        }
+                        return false;
+                    case TYPE_VARCHAR:
+                    case TYPE_STRING:
+                        if constexpr (std::is_same_v<CppType, StringRef>) {
+                            if (physical_type != tparquet::Type::BYTE_ARRAY) {
+                                return false;
+                            }
+                            hashes->emplace_back(ParquetBloomFilter::hash(value.data, value.size));
+                            break;
+                        }
+                        return false;
+                    default:
+                        return false;
+                    }
+                }
+                return true;
+            },
+            col_val_range);
+}
 
-Status ParquetReader::_process_bloom_filter(bool* filter_group) {
+Status ParquetReader::_init_bloom_filter(const tparquet::ColumnChunk& chunk,
+                                         ParquetBloomFilter* bloom_filter,
+                                         bool* has_bloom_filter) {
+    *has_bloom_filter = false;
+    if (!chunk.__isset.meta_data || !chunk.meta_data.__isset.bloom_filter_offset) {
+        return Status::OK();
+    }
+    // The length of the bloom filter is not in the metadata, but the thrift header is small.
+    static constexpr int64_t MAX_BLOOM_FILTER_HEADER_SIZE = 64;
+    int64_t offset = chunk.meta_data.bloom_filter_offset;
+    int64_t file_size = _file_reader->size();
+    int64_t header_length = std::min(MAX_BLOOM_FILTER_HEADER_SIZE, file_size - offset);
+    if (offset < 0 || header_length <= 0) {
+        return Status::OK();
+    }
+    uint8_t header_buf[MAX_BLOOM_FILTER_HEADER_SIZE];
+    Slice header_slice(header_buf, header_length);
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(_file_reader->read_at(offset, header_slice, &bytes_read, _io_ctx));
+    tparquet::BloomFilterHeader header;
+    uint32_t header_size = header_length;
+    RETURN_IF_ERROR(deserialize_thrift_msg(header_buf, &header_size, true, &header));
+    if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+        !header.compression.__isset.UNCOMPRESSED) {
+        return Status::OK();
+    }
+    int64_t num_bytes = header.numBytes;
+    if (num_bytes <= 0 || num_bytes % ParquetBloomFilter::BYTES_PER_BLOCK != 0 ||
+        num_bytes > (int64_t(config::parquet_column_max_buffer_mb) << 20) ||
+        offset + header_size + num_bytes > file_size) {
+        return Status::OK();
+    }
+    std::unique_ptr<uint8_t[]> bitset(new uint8_t[num_bytes]);
+    Slice bitset_slice(bitset.get(), num_bytes);
+    RETURN_IF_ERROR(
+            _file_reader->read_at(offset + header_size, bitset_slice, &bytes_read, _io_ctx));
+    RETURN_IF_ERROR(bloom_filter->init(bitset.get(), num_bytes));
+    *has_bloom_filter = true;
+    return Status::OK();
+}
+
+Status ParquetReader::_process_bloom_filter(const tparquet::RowGroup& row_group,
+                                           bool* filter_group) {
+    auto& schema_desc = _file_metadata->schema();
+    for (auto& [read_col, col_val_range] : _get_value_filter_columns()) {
+        const FieldSchema* col_schema = schema_desc.get_column(read_col->_file_slot_name);
+        std::vector<uint64_t> hashes;
+        if (!get_bloom_filter_hashes(*col_val_range, col_schema, &hashes) || hashes.empty()) {
+            continue;
+        }
+        ParquetBloomFilter bloom_filter;
+        bool has_bloom_filter = false;
+        RETURN_IF_ERROR(_init_bloom_filter(row_group.columns[col_schema->physical_column_index],
+                                           &bloom_filter, &has_bloom_filter));
+        if (!has_bloom_filter) {
+            continue;
+        }
+        *filter_group = std::none_of(hashes.begin(), hashes.end(), [&](uint64_t hash) {
+            return bloom_filter.find_hash(hash);
+        });
+        if (*filter_group) {
+            break;
+        }
+    }
     return Status::OK();
 }
 
@@ -20,6 +20,7 @@
 #include <stdint.h>
 
 #include <queue>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -27,11 +28,13 @@
 #include "exec/olap_common.h"
 #include "gen_cpp/parquet_types.h"
 #include "io/file_factory.h"
+#include "io/fs/buffered_reader.h"
 #include "io/fs/file_reader.h"
 #include "io/fs/file_system.h"
 #include "vec/core/block.h"
 #include "vec/exec/format/generic_reader.h"
 #include "vec/exprs/vexpr_context.h"
+#include "vparquet_bloom_filter.h"
 #include "vparquet_column_reader.h"
 #include "vparquet_file_metadata.h"
 #include "vparquet_group_reader.h"
@@ -43,12 +46,18 @@ class ParquetReader : public GenericReader {
 public:
     struct Statistics {
         int32_t filtered_row_groups = 0;
+        // the row groups filtered by dictionary pages and bloom filters, which are also
+        // counted in filtered_row_groups
+        int32_t dict_filtered_row_groups = 0;
+        int32_t bloom_filtered_row_groups = 0;
         int32_t read_row_groups = 0;
         int64_t filtered_group_rows = 0;
         int64_t filtered_page_rows = 0;
         int64_t lazy_read_filtered_rows = 0;
         int64_t read_rows = 0;
         int64_t filtered_bytes = 0;
+        int64_t dict_filtered_bytes = 0;
+        int64_t bloom_filtered_bytes = 0;
         int64_t read_bytes = 0;
         int64_t column_read_time = 0;
         int64_t parse_meta_time = 0;
@@ -57,6 +66,9 @@ public:
         int64_t open_file_num = 0;
         int64_t row_group_filter_time = 0;
         int64_t page_index_filter_time = 0;
+        int64_t merged_io_ranges = 0;
+        int64_t merged_io_bytes = 0;
+        int64_t merged_io_wait_time = 0;
     };
 
     ParquetReader(RuntimeProfile* profile, const TFileScanRangeParams& params,
@@ -114,15 +126,22 @@ public:
     void set_table_to_file_col_map(std::unordered_map<std::string, std::string>& map) {
         _table_col_to_file_col = map;
     }
+    // Return the fully dictionary encoded string columns of these slots as ColumnDictCodes,
+    // should be called after init_reader().
+    void set_dict_code_slot_ids(const std::set<SlotId>& dict_code_slot_ids);
 
 private:
     struct ParquetProfile {
         RuntimeProfile::Counter* filtered_row_groups;
+        RuntimeProfile::Counter* dict_filtered_row_groups;
+        RuntimeProfile::Counter* bloom_filtered_row_groups;
         RuntimeProfile::Counter* to_read_row_groups;
         RuntimeProfile::Counter* filtered_group_rows;
         RuntimeProfile::Counter* filtered_page_rows;
         RuntimeProfile::Counter* lazy_read_filtered_rows;
         RuntimeProfile::Counter* filtered_bytes;
+        RuntimeProfile::Counter* dict_filtered_bytes;
+        RuntimeProfile::Counter* bloom_filtered_bytes;
         RuntimeProfile::Counter* raw_rows_read;
         RuntimeProfile::Counter* to_read_bytes;
         RuntimeProfile::Counter* column_read_time;
@@ -132,6 +151,9 @@ private:
         RuntimeProfile::Counter* open_file_num;
         RuntimeProfile::Counter* row_group_filter_time;
         RuntimeProfile::Counter* page_index_filter_time;
+        RuntimeProfile::Counter* merged_io_ranges;
+        RuntimeProfile::Counter* merged_io_bytes;
+        RuntimeProfile::Counter* merged_io_wait_time;
 
         RuntimeProfile::Counter* file_read_time;
         RuntimeProfile::Counter* file_read_calls;
@@ -153,6 +175,12 @@ private:
             const RowGroupReader::RowGroupIndex& row_group_index);
     Status _init_read_columns();
     Status _init_row_groups(const bool& is_filter_groups);
+    // Returns a MergeRangeFileReader which prefetches the column chunks of the row group if
+    // the file is remote, otherwise the file reader. The lazy read columns are not prefetched,
+    // and only the pages with candidate rows are prefetched for the columns with an offset index.
+    io::FileReaderSPtr _get_row_group_file_reader(
+            const tparquet::RowGroup& row_group, const std::vector<RowRange>& candidate_row_ranges);
+    void _collect_merge_range_statistics();
     void _init_system_properties();
     void _init_file_description();
     // Page Index Filter
@@ -164,11 +192,20 @@ private:
     bool _is_misaligned_range_group(const tparquet::RowGroup& row_group);
     Status _process_column_stat_filter(const std::vector<tparquet::ColumnChunk>& column_meta,
                                        bool* filter_group);
-    Status _process_row_group_filter(const tparquet::RowGroup& row_group, bool* filter_group);
-    void _init_chunk_dicts();
-    Status _process_dict_filter(bool* filter_group);
-    void _init_bloom_filter();
-    Status _process_bloom_filter(bool* filter_group);
+    Status _process_row_group_filter(const tparquet::RowGroup& row_group, int64_t group_size,
+                                     bool* filter_group);
+    // The columns whose chunks can be filtered by dictionary pages and bloom filters.
+    // The predicates of these columns can not be satisfied by a null value.
+    std::vector<std::pair<const ParquetReadColumn*, const ColumnValueRangeType*>>
+    _get_value_filter_columns();
+    // Read the plain encoded values of the dictionary page of a column chunk whose data pages
+    // are all dictionary encoded. *has_dict is false if it is not the case.
+    Status _init_chunk_dict(const tparquet::ColumnChunk& chunk, const FieldSchema* col_schema,
+                            std::vector<std::string>* dict_values, bool* has_dict);
+    Status _process_dict_filter(const tparquet::RowGroup& row_group, bool* filter_group);
+    Status _init_bloom_filter(const tparquet::ColumnChunk& chunk,
+                              ParquetBloomFilter* bloom_filter, bool* has_bloom_filter);
+    Status _process_bloom_filter(const tparquet::RowGroup& row_group, bool* filter_group);
     int64_t _get_column_start_offset(const tparquet::ColumnMetaData& column_init_column_readers);
     std::string _meta_cache_key(const std::string& path) { return "meta_" + path; }
 
@@ -179,6 +216,8 @@ private:
     FileDescription _file_description;
     std::shared_ptr<io::FileSystem> _file_system = nullptr;
     io::FileReaderSPtr _file_reader = nullptr;
+    // the reader of the current row group, see _get_row_group_file_reader()
+    std::shared_ptr<io::MergeRangeFileReader> _merge_range_reader = nullptr;
     FileMetaData* _file_metadata = nullptr;
     // set to true if _file_metadata is owned by this reader.
     // otherwise, it is owned by someone else, such as _kv_cache
@@ -191,6 +230,8 @@ private:
     std::map<std::string, int> _map_column; // column-name <---> column-index
     // table column name to file column name map. For iceberg schema evolution.
     std::unordered_map<std::string, std::string> _table_col_to_file_col;
+    // the file column names of the slots set by set_dict_code_slot_ids()
+    std::unordered_set<std::string> _dict_code_col_names;
     std::unordered_map<std::string, ColumnValueRangeType>* _colname_to_value_range;
     std::vector<ParquetReadColumn> _read_columns;
     RowRange _whole_range = RowRange(0, 0);
@@ -222,7 +263,7 @@ private:
     RuntimeState* _state;
     const TupleDescriptor* _tuple_descriptor;
     const RowDescriptor* _row_descriptor;
-    const std::unordered_map<std::string, int>* _colname_to_slot_id;
+    const std::unordered_map<std::string, int>* _colname_to_slot_id = nullptr;
     const std::vector<VExprContext*>* _not_single_slot_filter_conjuncts;
     const std::unordered_map<int, std::vector<VExprContext*>>* _slot_id_to_filter_conjuncts;
     // Cache to save some common part such as file footer.
@@ -17,10 +17,16 @@
 
 #include "vec/exec/join/vhash_join_node.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "exprs/bloom_filter_func.h"
 #include "exprs/runtime_filter_slots.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/block_spill_manager.h"
+#include "runtime/exec_env.h"
+#include "runtime/memory/mem_tracker_limiter.h"
 #include "util/defer_op.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/exprs/vexpr.h"
@@ -33,6 +39,9 @@ namespace doris::vectorized {
 
 static constexpr int PREFETCH_STEP = HashJoinNode::PREFETCH_STEP;
 
+// make one block for each 4 gigabytes
+static constexpr auto BUILD_BLOCK_MAX_SIZE = 4 * 1024UL * 1024UL * 1024UL;
+
 template Status HashJoinNode::_extract_join_column<true>(
         Block&, COW<IColumn>::mutable_ptr<ColumnVector<unsigned char>>&,
         std::vector<IColumn const*, std::allocator<IColumn const*>>&,
@@ -111,7 +120,9 @@ struct ProcessHashTableBuild {
         }
 
         vector<int>& inserted_rows = _join_node->_inserted_rows[&_acquired_block];
-        bool has_runtime_filter = !_join_node->_runtime_filter_descs.empty();
+        // the runtime filters of a spilled join are filled when the build side is partitioned
+        bool has_runtime_filter =
+                !_join_node->_runtime_filter_descs.empty() && !_join_node->_is_build_spilled;
         if (has_runtime_filter) {
             inserted_rows.reserve(_batch_size);
         }
@@ -418,6 +429,24 @@ Status HashJoinNode::prepare(RuntimeState* state) {
         }
     }
 
+    // Grace hash join rebuilds the hash table for every spilled partition, so it can not
+    // work with a shared hash table, the null short circuit or mark join, which all need
+    // the whole build side at once.
+    if (state->external_join_bytes_threshold() > 0 && !_shared_hashtable_controller &&
+        !_short_circuit_for_null_in_build_side && !_is_mark_join) {
+        // Capped by the size of one build block, so the build side is switched to
+        // spill mode before any build block has been inserted into the hash table.
+        _external_join_bytes_threshold = std::min<int64_t>(state->external_join_bytes_threshold(),
+                                                           BUILD_BLOCK_MAX_SIZE);
+        _block_spill_profile = runtime_profile()->create_child("BlockSpill", true, true);
+        runtime_profile()->add_child(_block_spill_profile, false, nullptr);
+        _spill_build_rows = ADD_COUNTER(_block_spill_profile, "SpilledBuildRows", TUnit::UNIT);
+        _spill_probe_rows = ADD_COUNTER(_block_spill_profile, "SpilledProbeRows", TUnit::UNIT);
+        _spill_partition_count = ADD_COUNTER(_block_spill_profile, "PartitionCount", TUnit::UNIT);
+        _spill_repartition_count =
+                ADD_COUNTER(_block_spill_profile, "RepartitionCount", TUnit::UNIT);
+    }
+
     RETURN_IF_ERROR(VExpr::prepare(_build_expr_ctxs, state, child(1)->row_desc()));
     RETURN_IF_ERROR(VExpr::prepare(_probe_expr_ctxs, state, child(0)->row_desc()));
 
@@ -454,6 +483,9 @@ Status HashJoinNode::close(RuntimeState* state) {
 }
 
 bool HashJoinNode::need_more_input_data() const {
+    if (_is_probe_spilled) {
+        return false;
+    }
     return (_probe_block.rows() == 0 || _probe_index == _probe_block.rows()) && !_probe_eos &&
            !_short_circuit_for_null_in_probe_side;
 }
@@ -464,6 +496,13 @@ void HashJoinNode::prepare_for_next() {
 }
 
 Status HashJoinNode::pull(doris::RuntimeState* state, vectorized::Block* output_block, bool* eos) {
+    if (_is_build_spilled) {
+        return _pull_spilled_partitions(state, output_block, eos);
+    }
+    return _probe_hash_table(state, output_block, eos);
+}
+
+Status HashJoinNode::_probe_hash_table(RuntimeState* state, Block* output_block, bool* eos) {
     SCOPED_TIMER(_probe_timer);
     if (_short_circuit_for_null_in_probe_side) {
         // If we use a short-circuit strategy for null value in build side (e.g. if join operator is
@@ -563,7 +602,31 @@ Status HashJoinNode::pull(doris::RuntimeState* state, vectorized::Block* output_
     return Status::OK();
 }
 
-Status HashJoinNode::push(RuntimeState* /*state*/, vectorized::Block* input_block, bool eos) {
+Status HashJoinNode::push(RuntimeState* state, vectorized::Block* input_block, bool eos) {
+    if (_is_build_spilled) {
+        // The probe operator is not polled by the pipeline scheduler, so rather than
+        // waiting for a busy writer the rows are kept and spilled with the next blocks.
+        if (input_block->rows() > 0) {
+            RETURN_IF_ERROR(_spill_probe_pending_block.merge(*input_block));
+            input_block->clear_column_data();
+        }
+        if (!_spill_probe_pending_block.empty() &&
+            (eos || _can_write_partitions(_probe_partition_writers) ||
+             _spill_probe_pending_block.rows() >= state->batch_size() * SPILL_PARTITION_COUNT)) {
+            Block block = _spill_probe_pending_block.to_block();
+            _spill_probe_pending_block = MutableBlock();
+            RETURN_IF_ERROR(_spill_partitioned_block(state, block, false, 0,
+                                                     _probe_partition_writers, nullptr));
+        }
+        if (eos) {
+            RETURN_IF_ERROR(_finish_spill_probe());
+        }
+        return Status::OK();
+    }
+    return _push_probe_block(input_block, eos);
+}
+
+Status HashJoinNode::_push_probe_block(Block* input_block, bool eos) {
     _probe_eos = eos;
     if (input_block->rows() > 0) {
         COUNTER_UPDATE(_probe_rows_counter, input_block->rows());
@@ -609,7 +672,7 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
         return Status::OK();
     }
 
-    if (_join_op == TJoinOp::RIGHT_OUTER_JOIN) {
+    if (_join_op == TJoinOp::RIGHT_OUTER_JOIN && !_is_build_spilled) {
         const auto hash_table_empty = std::visit(
                 Overload {[&](std::monostate&) -> bool {
                               LOG(FATAL) << "FATAL: uninited hash table";
@@ -759,9 +822,6 @@ Status HashJoinNode::_materialize_build_side(RuntimeState* state) {
 Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_block, bool eos) {
     SCOPED_TIMER(_build_timer);
 
-    // make one block for each 4 gigabytes
-    constexpr static auto BUILD_BLOCK_MAX_SIZE = 4 * 1024UL * 1024UL * 1024UL;
-
     if (_short_circuit_for_null_in_probe_side) {
         // TODO: if _short_circuit_for_null_in_probe_side is true we should finish current pipeline task.
         DCHECK(state->enable_pipeline_exec());
@@ -770,47 +830,24 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
     if (_should_build_hash_table) {
         // If eos or have already met a null value using short-circuit strategy, we do not need to pull
         // data from probe side.
-        _build_side_mem_used += in_block->allocated_bytes();
-
-        if (in_block->rows() != 0) {
-            SCOPED_TIMER(_build_side_merge_block_timer);
-            RETURN_IF_CATCH_BAD_ALLOC(_build_side_mutable_block.merge(*in_block));
-        }
-
-        if (UNLIKELY(_build_side_mem_used - _build_side_last_mem_used > BUILD_BLOCK_MAX_SIZE)) {
-            if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
-                return Status::NotSupported(
-                        strings::Substitute("data size of right table in hash join > $0",
-                                            BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
-            }
-            _build_blocks->emplace_back(_build_side_mutable_block.to_block());
-
-            COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[_build_block_idx].bytes());
-
-            // TODO:: Rethink may we should do the process after we receive all build blocks ?
-            // which is better.
-            RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
-                                                 _build_block_idx));
-
-            _build_side_mutable_block = MutableBlock();
-            ++_build_block_idx;
-            _build_side_last_mem_used = _build_side_mem_used;
+        if (_is_build_spilled) {
+            RETURN_IF_ERROR(_spill_partitioned_block(state, *in_block, true, 0,
+                                                     _build_partition_writers,
+                                                     &_build_partition_bytes));
+        } else if (_external_join_bytes_threshold > 0 &&
+                   _build_side_mem_used + static_cast<int64_t>(in_block->allocated_bytes()) >=
+                           _external_join_bytes_threshold) {
+            RETURN_IF_ERROR(_switch_to_spill_build(state, in_block));
+        } else {
+            RETURN_IF_ERROR(_append_build_block(state, in_block));
         }
     }
 
-    if (_should_build_hash_table && eos) {
+    if (_should_build_hash_table && eos && _is_build_spilled) {
+        RETURN_IF_ERROR(_finish_spill_build(state));
+    } else if (_should_build_hash_table && eos) {
         // For pipeline engine, children should be closed once this pipeline task is finished.
-        if (!_build_side_mutable_block.empty()) {
-            if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
-                return Status::NotSupported(
-                        strings::Substitute("data size of right table in hash join > $0",
-                                            BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
-            }
-            _build_blocks->emplace_back(_build_side_mutable_block.to_block());
-            COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[_build_block_idx].bytes());
-            RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
-                                                 _build_block_idx));
-        }
+        RETURN_IF_ERROR(_flush_build_blocks(state));
         auto ret = std::visit(Overload {[&](std::monostate&) -> Status {
                                             LOG(FATAL) << "FATAL: uninited hash table";
                                             __builtin_unreachable();
@@ -897,6 +934,352 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
     return Status::OK();
 }
 
+Status HashJoinNode::_append_build_block(RuntimeState* state, Block* block) {
+    _build_side_mem_used += block->allocated_bytes();
+
+    if (block->rows() != 0) {
+        SCOPED_TIMER(_build_side_merge_block_timer);
+        RETURN_IF_CATCH_BAD_ALLOC(_build_side_mutable_block.merge(*block));
+    }
+
+    if (UNLIKELY(_build_side_mem_used - _build_side_last_mem_used > BUILD_BLOCK_MAX_SIZE)) {
+        if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
+            return Status::NotSupported(
+                    strings::Substitute("data size of right table in hash join > $0",
+                                        BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
+        }
+        _build_blocks->emplace_back(_build_side_mutable_block.to_block());
+
+        COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[_build_block_idx].bytes());
+
+        // TODO:: Rethink may we should do the process after we receive all build blocks ?
+        // which is better.
+        RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
+                                             _build_block_idx));
+
+        _build_side_mutable_block = MutableBlock();
+        ++_build_block_idx;
+        _build_side_last_mem_used = _build_side_mem_used;
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_flush_build_blocks(RuntimeState* state) {
+    if (!_build_side_mutable_block.empty()) {
+        if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
+            return Status::NotSupported(
+                    strings::Substitute("data size of right table in hash join > $0",
+                                        BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
+        }
+        _build_blocks->emplace_back(_build_side_mutable_block.to_block());
+        COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[_build_block_idx].bytes());
+        RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
+                                             _build_block_idx));
+    }
+    return Status::OK();
+}
+
+// Called once the build side no longer fits in memory. Nothing has been inserted into the
+// hash table yet, so the buffered rows are spilled together with all the following ones.
+// `in_block` is spilled with the buffered rows, so that every writer is written once.
+Status HashJoinNode::_switch_to_spill_build(RuntimeState* state, Block* in_block) {
+    DCHECK(_build_blocks->empty());
+    RETURN_IF_ERROR(_build_side_mutable_block.merge(*in_block));
+    _is_build_spilled = true;
+    _build_partition_writers.resize(SPILL_PARTITION_COUNT);
+    _build_partition_bytes.assign(SPILL_PARTITION_COUNT, 0);
+    runtime_profile()->add_info_string("GraceHashJoin", "true");
+
+    if (!_runtime_filter_descs.empty()) {
+        // The filters are created before the size of the whole build side is known. A build
+        // side which does not fit in memory is too large for IN filters anyway, so they are
+        // dropped and IN_OR_BLOOM filters are built as bloom filters.
+        _runtime_filter_slots = _pool->add(
+                new VRuntimeFilterSlots(_probe_expr_ctxs, _build_expr_ctxs, _runtime_filter_descs));
+        RETURN_IF_ERROR(_runtime_filter_slots->init(
+                state, std::max<int64_t>(_build_side_mutable_block.rows(),
+                                         state->runtime_filter_max_in_num())));
+    }
+
+    if (!_build_side_mutable_block.empty()) {
+        Block block = _build_side_mutable_block.to_block();
+        _build_side_mutable_block = MutableBlock();
+        RETURN_IF_ERROR(_spill_partitioned_block(state, block, true, 0, _build_partition_writers,
+                                                 &_build_partition_bytes));
+    }
+    _build_side_mem_used = 0;
+    _build_side_last_mem_used = 0;
+    return Status::OK();
+}
+
+// Evaluates the join keys of `block` and appends every row to the partition picked by
+// the hash of its keys. The hash is seeded with `level`, so rows of one partition are
+// spread evenly again when the partition has to be split.
+Status HashJoinNode::_spill_partitioned_block(RuntimeState* state, Block& block, bool is_build,
+                                              int level,
+                                              std::vector<BlockSpillWriterUPtr>& writers,
+                                              std::vector<size_t>* partition_bytes) {
+    const size_t rows = block.rows();
+    if (rows == 0) {
+        return Status::OK();
+    }
+    auto& exprs = is_build ? _build_expr_ctxs : _probe_expr_ctxs;
+    auto* expr_call_timer = is_build ? _build_expr_call_timer : _probe_expr_call_timer;
+
+    const size_t column_to_keep = block.columns();
+    std::vector<int> res_col_ids(exprs.size());
+    RETURN_IF_ERROR(_do_evaluate(block, exprs, *expr_call_timer, res_col_ids));
+
+    // The runtime filters are filled while partitioning the build side, as the
+    // whole build side never stays in memory at the same time.
+    if (is_build && level == 0 && _runtime_filter_slots && !_runtime_filter_slots->empty()) {
+        SCOPED_TIMER(_push_compute_timer);
+        std::unordered_map<const Block*, std::vector<int>> rows_to_insert;
+        auto& row_ids = rows_to_insert[&block];
+        row_ids.resize(rows);
+        std::iota(row_ids.begin(), row_ids.end(), 0);
+        _runtime_filter_slots->insert(rows_to_insert);
+    }
+
+    std::vector<uint64_t> hash_vals(rows, level);
+    for (auto res_col_id : res_col_ids) {
+        block.get_by_position(res_col_id).column->update_hashes_with_value(hash_vals.data());
+    }
+    Block::erase_useless_column(&block, column_to_keep);
+
+    IColumn::Selector selector(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        selector[i] = hash_vals[i] % SPILL_PARTITION_COUNT;
+    }
+
+    std::vector<MutableColumns> partition_columns(SPILL_PARTITION_COUNT);
+    for (size_t i = 0; i < block.columns(); ++i) {
+        auto scattered_columns =
+                block.get_by_position(i).column->convert_to_full_column_if_const()->scatter(
+                        SPILL_PARTITION_COUNT, selector);
+        for (size_t j = 0; j < SPILL_PARTITION_COUNT; ++j) {
+            partition_columns[j].emplace_back(std::move(scattered_columns[j]));
+        }
+    }
+
+    for (size_t i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+        if (partition_columns[i].empty() || partition_columns[i][0]->empty()) {
+            continue;
+        }
+        auto& writer = writers[i];
+        if (!writer) {
+            RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
+                    state->batch_size(), writer, _block_spill_profile));
+        }
+        Block partition_block = block.clone_with_columns(std::move(partition_columns[i]));
+        if (partition_bytes) {
+            (*partition_bytes)[i] += partition_block.allocated_bytes();
+        }
+        RETURN_IF_ERROR(writer->write(partition_block));
+    }
+    COUNTER_UPDATE(is_build ? _spill_build_rows : _spill_probe_rows, rows);
+    return Status::OK();
+}
+
+Status HashJoinNode::_close_partition_writers(std::vector<BlockSpillWriterUPtr>& writers,
+                                              std::vector<int64_t>* streams) {
+    streams->assign(writers.size(), -1);
+    for (size_t i = 0; i < writers.size(); ++i) {
+        if (writers[i]) {
+            (*streams)[i] = writers[i]->get_id();
+            RETURN_IF_ERROR(writers[i]->close());
+        }
+    }
+    writers.clear();
+    return Status::OK();
+}
+
+bool HashJoinNode::_can_write_partitions(const std::vector<BlockSpillWriterUPtr>& writers) {
+    return std::all_of(writers.begin(), writers.end(),
+                       [](const auto& writer) { return !writer || writer->can_write(); });
+}
+
+Status HashJoinNode::_finish_spill_build(RuntimeState* state) {
+    std::vector<int64_t> streams;
+    RETURN_IF_ERROR(_close_partition_writers(_build_partition_writers, &streams));
+    _spilled_partitions.resize(SPILL_PARTITION_COUNT);
+    for (size_t i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+        _spilled_partitions[i].build_stream = streams[i];
+        _spilled_partitions[i].build_bytes = _build_partition_bytes[i];
+    }
+    _build_partition_bytes.clear();
+    _probe_partition_writers.resize(SPILL_PARTITION_COUNT);
+
+    if (_runtime_filter_slots) {
+        SCOPED_TIMER(_push_down_timer);
+        _runtime_filter_slots->publish();
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_finish_spill_probe() {
+    std::vector<int64_t> streams;
+    RETURN_IF_ERROR(_close_partition_writers(_probe_partition_writers, &streams));
+    for (size_t i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+        _spilled_partitions[i].probe_stream = streams[i];
+    }
+    _is_probe_spilled = true;
+    _spill_partition_loaded = false;
+    return Status::OK();
+}
+
+// Splits a partition whose build side is still too large to be joined in memory.
+// The sub partitions are joined before the remaining ones of the upper level.
+Status HashJoinNode::_repartition_spilled_partition(RuntimeState* state,
+                                                    const SpilledPartition& partition) {
+    COUNTER_UPDATE(_spill_repartition_count, 1);
+    const int level = partition.level + 1;
+    std::vector<int64_t> build_streams(SPILL_PARTITION_COUNT, -1);
+    std::vector<int64_t> probe_streams(SPILL_PARTITION_COUNT, -1);
+    std::vector<size_t> build_bytes(SPILL_PARTITION_COUNT, 0);
+
+    auto repartition_stream = [&](int64_t stream_id, bool is_build,
+                                  std::vector<int64_t>* streams) -> Status {
+        if (stream_id == -1) {
+            return Status::OK();
+        }
+        BlockSpillReaderUPtr reader;
+        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
+                stream_id, reader, _block_spill_profile));
+        std::vector<BlockSpillWriterUPtr> writers(SPILL_PARTITION_COUNT);
+        bool eos = false;
+        Block block;
+        while (!eos) {
+            RETURN_IF_CANCELLED(state);
+            RETURN_IF_ERROR(reader->read(&block, &eos));
+            RETURN_IF_ERROR(_spill_partitioned_block(state, block, is_build, level, writers,
+                                                     is_build ? &build_bytes : nullptr));
+        }
+        RETURN_IF_ERROR(reader->close());
+        return _close_partition_writers(writers, streams);
+    };
+    RETURN_IF_ERROR(repartition_stream(partition.build_stream, true, &build_streams));
+    RETURN_IF_ERROR(repartition_stream(partition.probe_stream, false, &probe_streams));
+
+    // All the build rows still in one sub partition share the hash of their keys, splitting
+    // it again with another seed would not make it smaller.
+    const bool is_skewed = std::count_if(build_bytes.begin(), build_bytes.end(),
+                                         [](size_t bytes) { return bytes > 0; }) <= 1;
+    for (int i = SPILL_PARTITION_COUNT - 1; i >= 0; --i) {
+        _spilled_partitions.push_front({build_streams[i], probe_streams[i], build_bytes[i],
+                                        is_skewed ? MAX_SPILL_LEVEL : level});
+    }
+    return Status::OK();
+}
+
+void HashJoinNode::_reset_hash_table(RuntimeState* state) {
+    // `_build_blocks` is cleared in place, `ProcessHashTableProbe` keeps a reference to it.
+    _hash_table_variants = std::make_shared<HashTableVariants>();
+    _hash_table_init(state);
+    _arena = std::make_shared<Arena>();
+    _build_blocks->clear();
+    _inserted_rows.clear();
+    _build_block_idx = 0;
+    _build_side_mem_used = 0;
+    _build_side_last_mem_used = 0;
+    _build_side_mutable_block = MutableBlock();
+    _is_any_probe_match_row_output = false;
+}
+
+Status HashJoinNode::_load_spilled_partition(RuntimeState* state,
+                                             const SpilledPartition& partition) {
+    const auto build_bytes = static_cast<int64_t>(partition.build_bytes);
+    if (build_bytes > _external_join_bytes_threshold) {
+        if (partition.level < MAX_SPILL_LEVEL) {
+            return _repartition_spilled_partition(state, partition);
+        }
+        auto query_mem_tracker = state->query_mem_tracker();
+        if (query_mem_tracker && query_mem_tracker->has_limit() &&
+            build_bytes > query_mem_tracker->spare_capacity()) {
+            return Status::MemoryLimitExceeded(
+                    "Grace hash join can not split a spilled partition of {} build bytes any "
+                    "further (most build rows may share a key), and it exceeds the {} bytes "
+                    "left in the memory limit of the query",
+                    build_bytes, query_mem_tracker->spare_capacity());
+        }
+    }
+    COUNTER_UPDATE(_spill_partition_count, 1);
+
+    _reset_hash_table(state);
+    if (partition.build_stream != -1) {
+        BlockSpillReaderUPtr reader;
+        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
+                partition.build_stream, reader, _block_spill_profile));
+        bool eos = false;
+        Block block;
+        while (!eos) {
+            RETURN_IF_CANCELLED(state);
+            RETURN_IF_ERROR(reader->read(&block, &eos));
+            RETURN_IF_ERROR(_append_build_block(state, &block));
+        }
+        RETURN_IF_ERROR(reader->close());
+        SCOPED_TIMER(_build_timer);
+        RETURN_IF_ERROR(_flush_build_blocks(state));
+    }
+    _process_hashtable_ctx_variants_init(state);
+
+    _spill_probe_reader.reset();
+    if (partition.probe_stream != -1) {
+        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
+                partition.probe_stream, _spill_probe_reader, _block_spill_profile));
+    }
+    _probe_eos = false;
+    _spill_partition_loaded = true;
+    return Status::OK();
+}
+
+// Joins the spilled partitions one by one, every partition goes through the same
+// build and probe code as a join which fits in memory.
+Status HashJoinNode::_pull_spilled_partitions(RuntimeState* state, Block* output_block,
+                                              bool* eos) {
+    while (true) {
+        RETURN_IF_CANCELLED(state);
+        if (!_spill_partition_loaded) {
+            if (_spilled_partitions.empty()) {
+                *eos = true;
+                return Status::OK();
+            }
+            auto partition = _spilled_partitions.front();
+            _spilled_partitions.pop_front();
+            RETURN_IF_ERROR(_load_spilled_partition(state, partition));
+            continue;
+        }
+
+        if ((_probe_block.rows() == 0 || _probe_index == _probe_block.rows()) && !_probe_eos) {
+            prepare_for_next();
+            Block block;
+            bool probe_eos = true;
+            if (_spill_probe_reader) {
+                RETURN_IF_ERROR(_spill_probe_reader->read(&block, &probe_eos));
+            }
+            RETURN_IF_ERROR(_push_probe_block(&block, probe_eos));
+            continue;
+        }
+
+        bool partition_eos = false;
+        RETURN_IF_ERROR(_probe_hash_table(state, output_block, &partition_eos));
+        if (partition_eos) {
+            if (reached_limit()) {
+                *eos = true;
+                return Status::OK();
+            }
+            if (_spill_probe_reader) {
+                RETURN_IF_ERROR(_spill_probe_reader->close());
+                _spill_probe_reader.reset();
+            }
+            _spill_partition_loaded = false;
+        }
+        if (output_block->rows() > 0) {
+            return Status::OK();
+        }
+    }
+}
+
 void HashJoinNode::debug_string(int indentation_level, std::stringstream* out) const {
     *out << string(indentation_level * 2, ' ');
     *out << "HashJoin(need_more_input_data=" << (need_more_input_data() ? "true" : "false")
@@ -1222,6 +1605,11 @@ void HashJoinNode::_release_mem() {
     _tuple_is_null_right_flag_column = nullptr;
     _shared_hash_table_context = nullptr;
     _probe_block.clear();
+    _build_partition_writers.clear();
+    _probe_partition_writers.clear();
+    _spill_probe_reader.reset();
+    _spill_probe_pending_block = MutableBlock();
+    _spilled_partitions.clear();
 }
 
 } // namespace doris::vectorized
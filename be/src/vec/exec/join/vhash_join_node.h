@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <deque>
 #include <future>
 #include <variant>
 
@@ -26,6 +27,8 @@
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/hash_map.h"
 #include "vec/common/hash_table/partitioned_hash_map.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/runtime/shared_hash_table_controller.h"
 #include "vjoin_node_base.h"
 
@@ -191,6 +194,11 @@ using HashTableIteratorVariants =
         std::variant<std::monostate, ForwardIterator<RowRefList>,
                      ForwardIterator<RowRefListWithFlag>, ForwardIterator<RowRefListWithFlags>>;
 
+// When `external_join_bytes_threshold` is set and the build side grows past it,
+// the join falls back to a grace hash join: both sides are partitioned to disk
+// by the hash of the join keys and every pair of partitions is joined in memory
+// one after another. A build partition that is still too large is partitioned
+// again with a different hash seed.
 class HashJoinNode final : public VJoinNodeBase {
 public:
     // TODO: Best prefetch step is decided by machine. We should also provide a
@@ -220,7 +228,8 @@ public:
 
     bool can_sink_write() const {
         if (_should_build_hash_table) {
-            return true;
+            // a spilled build side waits for the previous block to be written to disk
+            return _can_write_partitions(_build_partition_writers);
         }
         return _shared_hash_table_context && _shared_hash_table_context->signaled;
     }
@@ -317,8 +326,62 @@ private:
 
     SharedHashTableContextPtr _shared_hash_table_context = nullptr;
 
+    struct SpilledPartition {
+        int64_t build_stream = -1;
+        int64_t probe_stream = -1;
+        // memory used by the build rows of this partition before they were spilled
+        size_t build_bytes = 0;
+        int level = 0;
+    };
+
+    static constexpr size_t SPILL_PARTITION_COUNT = 16;
+    // A partition too large to be joined in memory is split again with the hash seeded by
+    // its level, up to MAX_SPILL_LEVEL times. A partition which can not be split further,
+    // e.g. when most rows share a key, is joined in memory if the query has the memory for
+    // it, and fails the query with a clear error otherwise.
+    static constexpr int MAX_SPILL_LEVEL = 4;
+
+    int64_t _external_join_bytes_threshold = 0;
+    bool _is_build_spilled = false;
+    // all probe rows have been written to disk, the rest is read back in `pull`
+    bool _is_probe_spilled = false;
+    std::vector<BlockSpillWriterUPtr> _build_partition_writers;
+    std::vector<BlockSpillWriterUPtr> _probe_partition_writers;
+    // probe rows kept in memory while a probe partition writer is busy
+    MutableBlock _spill_probe_pending_block;
+    std::vector<size_t> _build_partition_bytes;
+    std::deque<SpilledPartition> _spilled_partitions;
+    bool _spill_partition_loaded = false;
+    BlockSpillReaderUPtr _spill_probe_reader;
+
+    RuntimeProfile* _block_spill_profile = nullptr;
+    RuntimeProfile::Counter* _spill_build_rows = nullptr;
+    RuntimeProfile::Counter* _spill_probe_rows = nullptr;
+    RuntimeProfile::Counter* _spill_partition_count = nullptr;
+    RuntimeProfile::Counter* _spill_repartition_count = nullptr;
+
     Status _materialize_build_side(RuntimeState* state) override;
 
+    Status _append_build_block(RuntimeState* state, Block* block);
+    Status _flush_build_blocks(RuntimeState* state);
+
+    Status _probe_hash_table(RuntimeState* state, Block* output_block, bool* eos);
+    Status _push_probe_block(Block* input_block, bool eos);
+
+    Status _switch_to_spill_build(RuntimeState* state, Block* in_block);
+    Status _spill_partitioned_block(RuntimeState* state, Block& block, bool is_build, int level,
+                                    std::vector<BlockSpillWriterUPtr>& writers,
+                                    std::vector<size_t>* partition_bytes);
+    static bool _can_write_partitions(const std::vector<BlockSpillWriterUPtr>& writers);
+    Status _close_partition_writers(std::vector<BlockSpillWriterUPtr>& writers,
+                                    std::vector<int64_t>* streams);
+    Status _finish_spill_build(RuntimeState* state);
+    Status _finish_spill_probe();
+    Status _repartition_spilled_partition(RuntimeState* state, const SpilledPartition& partition);
+    Status _load_spilled_partition(RuntimeState* state, const SpilledPartition& partition);
+    void _reset_hash_table(RuntimeState* state);
+    Status _pull_spilled_partitions(RuntimeState* state, Block* output_block, bool* eos);
+
     Status _process_build_block(RuntimeState* state, Block& block, uint8_t offset);
 
     Status _do_evaluate(Block& block, std::vector<VExprContext*>& exprs,
@@ -37,7 +37,49 @@ Status NewFileScanNode::prepare(RuntimeState* state) {
     return Status::OK();
 }
 
-void NewFileScanNode::set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges) {
+std::vector<TScanRangeParams> NewFileScanNode::_split_csv_scan_ranges(
+        const std::vector<TScanRangeParams>& scan_ranges) {
+    int64_t split_size = int64_t(config::csv_scan_range_split_size_mb) << 20;
+    std::vector<TScanRangeParams> split_ranges;
+    for (auto& scan_range : scan_ranges) {
+        auto& file_scan_range = scan_range.scan_range.ext_scan_range.file_scan_range;
+        auto& params = file_scan_range.params;
+        // CsvReader resyncs to the record boundary by skipping the first line of a range which
+        // does not start from 0, so only the plain csv files can be split.
+        if (split_size <= 0 || params.format_type != TFileFormatType::FORMAT_CSV_PLAIN ||
+            (params.compress_type != TFileCompressType::UNKNOWN &&
+             params.compress_type != TFileCompressType::PLAIN) ||
+            params.file_type == TFileType::FILE_STREAM || file_scan_range.ranges.empty()) {
+            split_ranges.push_back(scan_range);
+            continue;
+        }
+        TScanRangeParams empty_range = scan_range;
+        empty_range.scan_range.ext_scan_range.file_scan_range.ranges.clear();
+        // the ranges which are not split
+        TScanRangeParams small_ranges = empty_range;
+        for (auto& range : file_scan_range.ranges) {
+            if (range.size <= split_size) {
+                small_ranges.scan_range.ext_scan_range.file_scan_range.ranges.push_back(range);
+                continue;
+            }
+            for (int64_t offset = 0; offset < range.size; offset += split_size) {
+                TFileRangeDesc split_range = range;
+                split_range.__set_start_offset(range.start_offset + offset);
+                split_range.__set_size(std::min(split_size, range.size - offset));
+                auto& split_scan_range = split_ranges.emplace_back(empty_range);
+                split_scan_range.scan_range.ext_scan_range.file_scan_range.ranges.push_back(
+                        std::move(split_range));
+            }
+        }
+        if (!small_ranges.scan_range.ext_scan_range.file_scan_range.ranges.empty()) {
+            split_ranges.push_back(std::move(small_ranges));
+        }
+    }
+    return split_ranges;
+}
+
+void NewFileScanNode::set_scan_ranges(const std::vector<TScanRangeParams>& origin_scan_ranges) {
+    std::vector<TScanRangeParams> scan_ranges = _split_csv_scan_ranges(origin_scan_ranges);
     int max_scanners = config::doris_scanner_thread_pool_thread_num;
     if (scan_ranges.size() <= max_scanners) {
         _scan_ranges = scan_ranges;
@@ -91,6 +133,7 @@ Status NewFileScanNode::_init_scanners(std::list<VScanner*>* scanners) {
     size_t shard_num =
             std::min<size_t>(config::doris_scanner_thread_pool_thread_num, _scan_ranges.size());
     _kv_cache.reset(new ShardedKVCache(shard_num));
+    _init_dict_code_slot_ids();
     for (auto& scan_range : _scan_ranges) {
         VScanner* scanner = new VFileScanner(_state, this, _limit_per_scanner,
                                              scan_range.scan_range.ext_scan_range.file_scan_range,
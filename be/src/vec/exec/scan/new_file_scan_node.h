@@ -38,6 +38,11 @@ protected:
     Status _init_scanners(std::list<VScanner*>* scanners) override;
 
 private:
+    // Splits the uncompressed csv ranges larger than csv_scan_range_split_size_mb, so that they
+    // are read by several scanners in parallel.
+    static std::vector<TScanRangeParams> _split_csv_scan_ranges(
+            const std::vector<TScanRangeParams>& scan_ranges);
+
     std::vector<TScanRangeParams> _scan_ranges;
     // A in memory cache to save some common components
     // of the this scan node. eg:
@@ -19,6 +19,7 @@
 
 #include <charconv>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
@@ -27,6 +28,7 @@
 #include "util/to_string.h"
 #include "vec/columns/column_const.h"
 #include "vec/exec/scan/new_olap_scanner.h"
+#include "vec/exprs/vslot_ref.h"
 
 namespace doris::vectorized {
 
@@ -107,12 +109,21 @@ Status NewOlapScanNode::_init_profile() {
             ADD_COUNTER(_segment_profile, "RowsConditionsFiltered", TUnit::UNIT);
     _key_range_filtered_counter =
             ADD_COUNTER(_segment_profile, "RowsKeyRangeFiltered", TUnit::UNIT);
+    _late_rf_pages_filtered_counter =
+            ADD_COUNTER(_segment_profile, "PagesLateRuntimeFilterFiltered", TUnit::UNIT);
+    _late_rf_rows_filtered_counter =
+            ADD_COUNTER(_segment_profile, "RowsLateRuntimeFilterFiltered", TUnit::UNIT);
 
     _io_timer = ADD_TIMER(_segment_profile, "IOTimer");
     _decompressor_timer = ADD_TIMER(_segment_profile, "DecompressorTimer");
 
     _total_pages_num_counter = ADD_COUNTER(_segment_profile, "TotalPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_segment_profile, "CachedPagesNum", TUnit::UNIT);
+    _prefetched_pages_num_counter =
+            ADD_COUNTER(_segment_profile, "PrefetchedPagesNum", TUnit::UNIT);
+    _prefetch_wasted_pages_num_counter =
+            ADD_COUNTER(_segment_profile, "PrefetchWastedPagesNum", TUnit::UNIT);
+    _prefetch_wait_timer = ADD_TIMER(_segment_profile, "PrefetchWaitTime");
 
     _bitmap_index_filter_counter =
             ADD_COUNTER(_segment_profile, "RowsBitmapIndexFiltered", TUnit::UNIT);
@@ -381,6 +392,16 @@ std::string NewOlapScanNode::get_name() {
     return fmt::format("VNewOlapScanNode({0})", _olap_scan_node.table_name);
 }
 
+// The dictionary codes can not be sorted by the scanners either.
+void NewOlapScanNode::_init_dict_code_slot_ids() {
+    if (_olap_scan_node.__isset.sort_info ||
+        (_olap_scan_node.__isset.use_topn_opt && _olap_scan_node.use_topn_opt)) {
+        _dict_code_slot_ids.clear();
+        return;
+    }
+    VScanNode::_init_dict_code_slot_ids();
+}
+
 Status NewOlapScanNode::_init_scanners(std::list<VScanner*>* scanners) {
     if (_scan_ranges.empty()) {
         _eos = true;
@@ -402,6 +423,7 @@ Status NewOlapScanNode::_init_scanners(std::list<VScanner*>* scanners) {
             _maybe_read_column_ids.emplace(uid);
         }
     }
+    _init_dict_code_slot_ids();
 
     // ranges constructed from scan keys
     RETURN_IF_ERROR(_scan_keys.get_key_range(&_cond_ranges));
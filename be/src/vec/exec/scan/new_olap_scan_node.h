@@ -57,8 +57,12 @@ protected:
 
     bool _should_push_down_common_expr() override;
 
+    bool _should_push_down_late_runtime_filters() override { return true; }
+
     Status _init_scanners(std::list<VScanner*>* scanners) override;
 
+    void _init_dict_code_slot_ids() override;
+
 private:
     Status _build_key_ranges_and_filters();
 
@@ -105,6 +109,9 @@ private:
     RuntimeProfile::Counter* _del_filtered_counter = nullptr;
     RuntimeProfile::Counter* _conditions_filtered_counter = nullptr;
     RuntimeProfile::Counter* _key_range_filtered_counter = nullptr;
+    // pages and rows skipped by the runtime filters arrived after the scan started
+    RuntimeProfile::Counter* _late_rf_pages_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _late_rf_rows_filtered_counter = nullptr;
 
     RuntimeProfile::Counter* _block_fetch_timer = nullptr;
     RuntimeProfile::Counter* _block_load_timer = nullptr;
@@ -131,6 +138,11 @@ private:
     // page read from cache
     // used by segment v2
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    // page read ahead by the page prefetcher, those of them never used, and the time waited
+    // for them
+    RuntimeProfile::Counter* _prefetched_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _prefetch_wasted_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _prefetch_wait_timer = nullptr;
 
     // row count filtered by bitmap inverted index
     RuntimeProfile::Counter* _bitmap_index_filter_counter = nullptr;
@@ -390,6 +390,10 @@ Status NewOlapScanner::_init_return_columns() {
         _return_columns.push_back(index);
         if (slot->is_nullable() && !_tablet_schema->column(index).is_nullable()) {
             _tablet_columns_convert_to_null_set.emplace(index);
+        } else if (_tablet_schema->keys_type() == DUP_KEYS &&
+                   ((NewOlapScanNode*)_parent)->_dict_code_slot_ids.count(slot->id()) > 0) {
+            // rows of duplicate key tables are not merged by the reader
+            _tablet_reader_params.dict_code_columns.insert(index);
         }
     }
 
@@ -429,6 +433,31 @@ Status NewOlapScanner::_get_block_impl(RuntimeState* state, Block* block, bool*
     return Status::OK();
 }
 
+Status NewOlapScanner::_push_down_late_runtime_filters() {
+    std::vector<LateRuntimeFilterPredicates> late_predicates;
+    _parent->get_late_runtime_filter_predicates(_num_late_rf_predicates, &late_predicates);
+    _num_late_rf_predicates += late_predicates.size();
+
+    std::vector<TCondition> conditions;
+    std::vector<std::pair<std::string, std::shared_ptr<BloomFilterFuncBase>>> bloom_filters;
+    std::vector<std::pair<std::string, std::shared_ptr<HybridSetBase>>> in_filters;
+    for (auto& predicates : late_predicates) {
+        for (auto& range : predicates.value_ranges) {
+            std::visit([&](auto&& value_range) { value_range.to_olap_filter(conditions); },
+                       range);
+        }
+        const auto& filter_predicates = predicates.filter_predicates;
+        bloom_filters.insert(bloom_filters.end(), filter_predicates.bloom_filters.begin(),
+                             filter_predicates.bloom_filters.end());
+        in_filters.insert(in_filters.end(), filter_predicates.in_filters.begin(),
+                          filter_predicates.in_filters.end());
+    }
+    if (conditions.empty() && bloom_filters.empty() && in_filters.empty()) {
+        return Status::OK();
+    }
+    return _tablet_reader->append_late_runtime_filters(conditions, bloom_filters, in_filters);
+}
+
 Status NewOlapScanner::close(RuntimeState* state) {
     if (_is_closed) {
         return Status::OK();
@@ -518,9 +547,15 @@ void NewOlapScanner::_update_counters_before_close() {
 
     COUNTER_UPDATE(olap_parent->_conditions_filtered_counter, stats.rows_conditions_filtered);
     COUNTER_UPDATE(olap_parent->_key_range_filtered_counter, stats.rows_key_range_filtered);
+    COUNTER_UPDATE(olap_parent->_late_rf_pages_filtered_counter, stats.late_rf_pages_filtered);
+    COUNTER_UPDATE(olap_parent->_late_rf_rows_filtered_counter, stats.rows_late_rf_filtered);
 
     COUNTER_UPDATE(olap_parent->_total_pages_num_counter, stats.total_pages_num);
     COUNTER_UPDATE(olap_parent->_cached_pages_num_counter, stats.cached_pages_num);
+    COUNTER_UPDATE(olap_parent->_prefetched_pages_num_counter, stats.prefetched_pages_num);
+    COUNTER_UPDATE(olap_parent->_prefetch_wasted_pages_num_counter,
+                   stats.prefetch_wasted_pages_num);
+    COUNTER_UPDATE(olap_parent->_prefetch_wait_timer, stats.prefetch_wait_ns);
 
     COUNTER_UPDATE(olap_parent->_bitmap_index_filter_counter, stats.rows_bitmap_index_filtered);
     COUNTER_UPDATE(olap_parent->_bitmap_index_filter_timer, stats.bitmap_index_filter_timer);
@@ -55,6 +55,7 @@ public:
 protected:
     Status _get_block_impl(RuntimeState* state, Block* block, bool* eos) override;
     void _update_counters_before_close() override;
+    Status _push_down_late_runtime_filters() override;
 
 private:
     void _update_realtime_counters();
@@ -81,6 +82,8 @@ private:
     std::vector<uint32_t> _return_columns;
     std::unordered_set<uint32_t> _tablet_columns_convert_to_null_set;
     std::vector<TCondition> _compound_filters;
+    // the number of the node's late runtime filter predicates pushed to _tablet_reader
+    size_t _num_late_rf_predicates = 0;
 
     // ========= profiles ==========
     int64_t _compressed_bytes_read = 0;
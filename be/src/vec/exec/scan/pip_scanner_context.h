@@ -82,6 +82,7 @@ public:
             _next_queue_to_feed = queue + 1 < queue_size ? queue + 1 : 0;
         }
         _current_used_bytes += local_bytes;
+        pipeline::notify_blocked_tasks();
     }
 
     bool empty_in_queue(int id) override {
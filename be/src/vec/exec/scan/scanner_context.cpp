@@ -21,6 +21,7 @@
 
 #include "common/config.h"
 #include "runtime/runtime_state.h"
+#include "util/defer_op.h"
 #include "util/threadpool.h"
 #include "vec/core/block.h"
 #include "vec/exec/scan/vscan_node.h"
@@ -139,6 +140,8 @@ void ScannerContext::return_free_block(std::unique_ptr<vectorized::Block> block)
 }
 
 void ScannerContext::append_blocks_to_queue(std::vector<vectorized::BlockUPtr>& blocks) {
+    // after _transfer_lock is released, the scan source checks the queue with it
+    Defer notify {[] { pipeline::notify_blocked_tasks(); }};
     std::lock_guard l(_transfer_lock);
     auto old_bytes_in_queue = _cur_bytes_in_queue;
     for (auto& b : blocks) {
@@ -199,6 +202,7 @@ Status ScannerContext::get_block_from_queue(RuntimeState* state, vectorized::Blo
 }
 
 bool ScannerContext::set_status_on_error(const Status& status) {
+    Defer notify {[] { pipeline::notify_blocked_tasks(); }};
     std::lock_guard l(_transfer_lock);
     if (_process_status.ok()) {
         _process_status = status;
@@ -298,6 +302,8 @@ void ScannerContext::reschedule_scanner_ctx() {
 }
 
 void ScannerContext::push_back_scanner_and_reschedule(VScanner* scanner) {
+    // the scan source may wait for the queue, the end of the scanners or no running scanner
+    Defer notify {[] { pipeline::notify_blocked_tasks(); }};
     {
         std::unique_lock l(_scanners_lock);
         _scanners.push_front(scanner);
@@ -22,6 +22,7 @@
 #include <mutex>
 
 #include "common/status.h"
+#include "pipeline/blocked_task_notifier.h"
 #include "runtime/descriptors.h"
 #include "util/lock.h"
 #include "util/uid_util.h"
@@ -80,9 +81,12 @@ public:
     // Called by ScanNode.
     // Used to notify the scheduler that this ScannerContext can stop working.
     void set_should_stop() {
-        std::lock_guard l(_transfer_lock);
-        _should_stop = true;
-        _blocks_queue_added_cv.notify_one();
+        {
+            std::lock_guard l(_transfer_lock);
+            _should_stop = true;
+            _blocks_queue_added_cv.notify_one();
+        }
+        pipeline::notify_blocked_tasks();
     }
 
     // Return true if this ScannerContext need no more process
@@ -93,11 +97,14 @@ public:
 
     // Update the running num of scanners and contexts
     void update_num_running(int32_t scanner_inc, int32_t sched_inc) {
-        std::lock_guard l(_transfer_lock);
-        _num_running_scanners += scanner_inc;
-        _num_scheduling_ctx += sched_inc;
-        _blocks_queue_added_cv.notify_one();
-        _ctx_finish_cv.notify_one();
+        {
+            std::lock_guard l(_transfer_lock);
+            _num_running_scanners += scanner_inc;
+            _num_scheduling_ctx += sched_inc;
+            _blocks_queue_added_cv.notify_one();
+            _ctx_finish_cv.notify_one();
+        }
+        pipeline::notify_blocked_tasks();
     }
 
     int get_num_running_scanners() const { return _num_running_scanners; }
@@ -24,6 +24,7 @@
 #include "util/telemetry/telemetry.h"
 #include "util/thread.h"
 #include "util/threadpool.h"
+#include "vec/columns/column_dict_codes.h"
 #include "vec/core/block.h"
 #include "vec/exec/scan/new_olap_scanner.h"
 #include "vec/exec/scan/vscanner.h"
@@ -241,6 +242,18 @@ void ScannerScheduler::_schedule_scanners(ScannerContext* ctx) {
 #endif
 }
 
+// Columns read as dictionary codes can not be appended to the string columns
+// read from the segments which are not fully dictionary encoded.
+static bool can_merge_block(const Block& dst, const Block& src) {
+    for (size_t i = 0; i < src.columns(); ++i) {
+        if (ColumnDictCodes::get_dict_codes(*src.get_by_position(i).column) != nullptr &&
+            ColumnDictCodes::get_dict_codes(*dst.get_by_position(i).column) == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void ScannerScheduler::_scanner_scan(ScannerScheduler* scheduler, ScannerContext* ctx,
                                      VScanner* scanner) {
     auto tracker_config = [&] {
@@ -276,7 +289,9 @@ void ScannerScheduler::_scanner_scan(ScannerScheduler* scheduler, ScannerContext
         scanner->set_opened();
     }
 
-    scanner->try_append_late_arrival_runtime_filter();
+    if (!eos) {
+        scanner->try_append_late_arrival_runtime_filter();
+    }
 
     // Because we use thread pool to scan data from storage. One scanner can't
     // use this thread too long, this can starve other query's scanner. So, we
@@ -334,7 +349,8 @@ void ScannerScheduler::_scanner_scan(ScannerScheduler* scheduler, ScannerContext
         if (UNLIKELY(block->rows() == 0)) {
             ctx->return_free_block(std::move(block));
         } else {
-            if (!blocks.empty() && blocks.back()->rows() + block->rows() <= state->batch_size()) {
+            if (!blocks.empty() && blocks.back()->rows() + block->rows() <= state->batch_size() &&
+                can_merge_block(*blocks.back(), *block)) {
                 vectorized::MutableBlock(blocks.back().get()).merge(*block);
                 ctx->return_free_block(std::move(block));
             } else {
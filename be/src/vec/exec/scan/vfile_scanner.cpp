@@ -563,6 +563,9 @@ Status VFileScanner::_get_next_reader() {
                         &_not_single_slot_filter_conjuncts, &_slot_id_to_filter_conjuncts);
                 _cur_reader.reset((GenericReader*)parquet_reader);
             }
+            if (!_is_load) {
+                parquet_reader->set_dict_code_slot_ids(_parent->_dict_code_slot_ids);
+            }
             break;
         }
         case TFileFormatType::FORMAT_ORC: {
@@ -1291,6 +1291,9 @@ Status VScanNode::try_append_late_arrival_runtime_filter(int* arrived_rf_num) {
     // 2. Append unapplied runtime filters to vconjunct_ctx_ptr
     if (!vexprs.empty()) {
         RETURN_IF_ERROR(_append_rf_into_conjuncts(vexprs));
+        if (_should_push_down_late_runtime_filters()) {
+            RETURN_IF_ERROR(_normalize_late_arrival_runtime_filters(vexprs));
+        }
     }
     if (current_arrived_rf_num == _runtime_filter_descs.size()) {
         _is_all_rf_applied = true;
@@ -1300,6 +1303,77 @@ Status VScanNode::try_append_late_arrival_runtime_filter(int* arrived_rf_num) {
     return Status::OK();
 }
 
+// Only the filters on key columns are converted, min/max filters to value ranges and in/bloom
+// filters to filter predicates. The value ranges are built from scratch instead of being
+// merged into _slot_id_to_value_range, which the scanners have already consumed.
+Status VScanNode::_normalize_late_arrival_runtime_filters(const std::vector<VExpr*>& vexprs) {
+    auto slot_checker = [](const std::vector<VExpr*>& children, const VSlotRef** slot,
+                           VExpr** child_contains_slot) {
+        if (children.empty() ||
+            VExpr::expr_without_cast(children[0])->node_type() != TExprNodeType::SLOT_REF) {
+            return false;
+        }
+        *slot = reinterpret_cast<const VSlotRef*>(VExpr::expr_without_cast(children[0]));
+        *child_contains_slot = children[0];
+        return true;
+    };
+
+    LateRuntimeFilterPredicates predicates;
+    for (auto vexpr : vexprs) {
+        auto impl = vexpr->get_impl();
+        VExpr* cur_expr = impl ? const_cast<VExpr*>(impl) : vexpr;
+        SlotDescriptor* slot = nullptr;
+        ColumnValueRangeType* range = nullptr;
+        if (!_is_predicate_acting_on_slot(cur_expr, slot_checker, &slot, &range) ||
+            !_is_key_column(slot->col_name())) {
+            continue;
+        }
+        switch (cur_expr->node_type()) {
+        case TExprNodeType::BLOOM_PRED:
+            predicates.filter_predicates.bloom_filters.emplace_back(
+                    slot->col_name(), cur_expr->get_bloom_filter_func());
+            break;
+        case TExprNodeType::IN_PRED:
+            if (cur_expr->get_set_func() != nullptr) {
+                predicates.filter_predicates.in_filters.emplace_back(slot->col_name(),
+                                                                     cur_expr->get_set_func());
+            }
+            break;
+        case TExprNodeType::BINARY_PRED: {
+            Status st = std::visit(
+                    [&](auto& slot_range) {
+                        using RangeType = std::decay_t<decltype(slot_range)>;
+                        RangeType value_range(slot->col_name(), slot->is_nullable(),
+                                              slot->type().precision, slot->type().scale);
+                        value_range.mark_runtime_filter_predicate(true);
+                        PushDownType pdt = PushDownType::UNACCEPTABLE;
+                        RETURN_IF_ERROR(_normalize_noneq_binary_predicate(
+                                cur_expr, *_vconjunct_ctx_ptr, slot, value_range, &pdt));
+                        if (pdt == PushDownType::ACCEPTABLE) {
+                            predicates.value_ranges.emplace_back(std::move(value_range));
+                        }
+                        return Status::OK();
+                    },
+                    *range);
+            RETURN_IF_ERROR(st);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    _late_rf_predicates.push_back(std::move(predicates));
+    return Status::OK();
+}
+
+void VScanNode::get_late_runtime_filter_predicates(
+        size_t from, std::vector<LateRuntimeFilterPredicates>* predicates) {
+    std::unique_lock l(_rf_locks);
+    for (size_t i = from; i < _late_rf_predicates.size(); ++i) {
+        predicates->push_back(_late_rf_predicates[i]);
+    }
+}
+
 Status VScanNode::clone_vconjunct_ctx(VExprContext** _vconjunct_ctx) {
     if (_vconjunct_ctx_ptr) {
         std::unique_lock l(_rf_locks);
@@ -1354,6 +1428,46 @@ VScanNode::PushDownType VScanNode::_should_push_down_in_predicate(VInPredicate*
     return PushDownType::ACCEPTABLE;
 }
 
+static void collect_slot_ids(const VExpr* expr, std::set<SlotId>* slot_ids) {
+    if (expr->is_slot_ref()) {
+        slot_ids->insert(static_cast<const VSlotRef*>(expr)->slot_id());
+    }
+    for (auto* child : expr->children()) {
+        collect_slot_ids(child, slot_ids);
+    }
+}
+
+// The dictionary codes are only understood by the aggregation, so the slots filtered in
+// the scanner, by the remaining conjuncts or by runtime filters which may arrive late,
+// are read as strings. The scan must not project the rows either.
+void VScanNode::_init_dict_code_slot_ids() {
+    _dict_code_slot_ids.clear();
+    if (_requested_dict_code_slot_ids.empty() || !config::enable_low_cardinality_optimize ||
+        !_projections.empty()) {
+        return;
+    }
+
+    std::set<SlotId> filtered_slot_ids;
+    if (_vconjunct_ctx_ptr && (*_vconjunct_ctx_ptr)->root()) {
+        collect_slot_ids((*_vconjunct_ctx_ptr)->root(), &filtered_slot_ids);
+    }
+    for (auto& filter_desc : _runtime_filter_descs) {
+        for (auto& it : filter_desc.planId_to_target_expr) {
+            for (auto& node : it.second.nodes) {
+                if (node.node_type == TExprNodeType::SLOT_REF) {
+                    filtered_slot_ids.insert(node.slot_ref.slot_id);
+                }
+            }
+        }
+    }
+
+    for (auto slot_id : _requested_dict_code_slot_ids) {
+        if (filtered_slot_ids.count(slot_id) == 0) {
+            _dict_code_slot_ids.insert(slot_id);
+        }
+    }
+}
+
 Status VScanNode::_prepare_scanners() {
     std::list<VScanner*> scanners;
     RETURN_IF_ERROR(_init_scanners(&scanners));
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <set>
+
 #include "exec/exec_node.h"
 #include "exec/olap_common.h"
 #include "exprs/function_filter.h"
@@ -46,6 +48,14 @@ struct FilterPredicates {
     std::vector<std::pair<std::string, std::shared_ptr<HybridSetBase>>> in_filters;
 };
 
+// The runtime filters arrived after the scanners are created, converted like the conjuncts
+// in VScanNode::_normalize_conjuncts(). The data source can use them to skip data, the rows
+// are always filtered by the conjuncts.
+struct LateRuntimeFilterPredicates {
+    std::vector<ColumnValueRangeType> value_ranges;
+    FilterPredicates filter_predicates;
+};
+
 class VScanNode : public ExecNode {
 public:
     VScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
@@ -86,6 +96,10 @@ public:
     // Return num of filters which are applied already.
     Status try_append_late_arrival_runtime_filter(int* arrived_rf_num);
 
+    // Append the late-arrival runtime filters converted since the `from`th one to `predicates`.
+    void get_late_runtime_filter_predicates(
+            size_t from, std::vector<LateRuntimeFilterPredicates>* predicates);
+
     // Clone current vconjunct_ctx to _vconjunct_ctx, if exists.
     Status clone_vconjunct_ctx(VExprContext** _vconjunct_ctx);
 
@@ -102,6 +116,12 @@ public:
 
     Status try_close();
 
+    // Asks the scanners to return the string column of the slot as dictionary codes if
+    // possible (see ColumnDictCodes). Called by the aggregation which groups by the slot,
+    // before the scan node is opened. Only the olap scan and the parquet files of the file
+    // scan honor it.
+    void request_dict_codes(SlotId slot_id) { _requested_dict_code_slot_ids.insert(slot_id); }
+
     bool should_run_serial() const { return _should_run_serial; }
     bool ready_to_open() { return _shared_scanner_controller->scanner_context_is_ready(id()); }
     bool ready_to_read() { return !_scanner_ctx->empty_in_queue(_context_queue_id); }
@@ -176,10 +196,17 @@ protected:
         return PushDownType::UNACCEPTABLE;
     }
 
+    // Whether the data source uses the predicates of the late-arrival runtime filters.
+    virtual bool _should_push_down_late_runtime_filters() { return false; }
+
     // Return true if it is a key column.
     // Only predicate on key column can be pushed down.
     virtual bool _is_key_column(const std::string& col_name) { return false; }
 
+    // Chooses the requested slots which are read as dictionary codes, called by the scan
+    // nodes honoring request_dict_codes() before their scanners are created.
+    virtual void _init_dict_code_slot_ids();
+
     Status _prepare_scanners();
 
 protected:
@@ -215,6 +242,8 @@ protected:
     phmap::flat_hash_set<VExpr*> _rf_vexpr_set;
     // True means all runtime filters are applied to scanners
     bool _is_all_rf_applied = true;
+    // Guarded by _rf_locks, see _should_push_down_late_runtime_filters()
+    std::vector<LateRuntimeFilterPredicates> _late_rf_predicates;
 
     // Each scan node will generates a ScannerContext to manage all Scanners.
     // See comments of ScannerContext for more details
@@ -313,6 +342,10 @@ protected:
 
     std::unordered_map<std::string, int> _colname_to_slot_id;
 
+    std::set<SlotId> _requested_dict_code_slot_ids;
+    // slots which are read as dictionary codes, no expr is evaluated on them in the scan
+    std::set<SlotId> _dict_code_slot_ids;
+
 private:
     // Register and get all runtime filters at Init phase.
     Status _register_runtime_filter();
@@ -320,6 +353,7 @@ private:
     Status _acquire_runtime_filter(bool wait = true);
     // Append late-arrival runtime filters to the vconjunct_ctx.
     Status _append_rf_into_conjuncts(std::vector<VExpr*>& vexprs);
+    Status _normalize_late_arrival_runtime_filters(const std::vector<VExpr*>& vexprs);
 
     Status _normalize_conjuncts();
     Status _normalize_predicate(VExpr* conjunct_expr_root, VExpr** output_expr);
@@ -128,7 +128,7 @@ Status VScanner::try_append_late_arrival_runtime_filter() {
     // But it is ok because it will be updated at next time.
     RETURN_IF_ERROR(_parent->clone_vconjunct_ctx(&_vconjunct_ctx));
     _applied_rf_num = arrived_rf_num;
-    return Status::OK();
+    return _push_down_late_runtime_filters();
 }
 
 Status VScanner::close(RuntimeState* state) {
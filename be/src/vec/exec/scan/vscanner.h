@@ -56,6 +56,10 @@ protected:
     // Update the counters before closing this scanner
     virtual void _update_counters_before_close();
 
+    // Called after new runtime filters are appended to the conjuncts, a subclass can push
+    // their predicates (VScanNode::get_late_runtime_filter_predicates) down to the data source.
+    virtual Status _push_down_late_runtime_filters() { return Status::OK(); }
+
     // Filter the output block finally.
     Status _filter_output_block(Block* block);
 
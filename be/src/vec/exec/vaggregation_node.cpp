@@ -17,12 +17,20 @@
 
 #include "vec/exec/vaggregation_node.h"
 
+#include <chrono>
 #include <memory>
 
+#include "common/config.h"
 #include "exec/exec_node.h"
+#include "pipeline/blocked_task_notifier.h"
+#include "runtime/block_spill_manager.h"
+#include "runtime/exec_env.h"
+#include "util/defer_op.h"
 #include "vec/core/block.h"
+#include "vec/core/block_spill_reader.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_string.h"
+#include "vec/exec/scan/vscan_node.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
 #include "vec/utils/util.hpp"
@@ -32,6 +40,11 @@ namespace doris::vectorized {
 // Here is an empirical value.
 static constexpr size_t HASH_MAP_PREFETCH_DIST = 16;
 
+// Number of partitions the spilled hash table is split into. Each partition is
+// merged back into memory on its own, so the memory needed to merge a spilled
+// aggregation is about 1/SPILL_PARTITION_COUNT of the whole hash table.
+static constexpr size_t SPILL_PARTITION_COUNT = 16;
+
 /// The minimum reduction factor (input rows divided by output rows) to grow hash tables
 /// in a streaming preaggregation, given that the hash tables are currently the given
 /// size or above. The sizes roughly correspond to hash table sizes where the bucket
@@ -310,6 +323,8 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
     _hash_table_compute_timer = ADD_TIMER(runtime_profile(), "HashTableComputeTime");
     _hash_table_iterate_timer = ADD_TIMER(runtime_profile(), "HashTableIterateTime");
     _insert_keys_to_column_timer = ADD_TIMER(runtime_profile(), "InsertKeysToColumnTime");
+    _result_task_timer = ADD_TIMER(runtime_profile(), "ParallelResultTaskTime");
+    _parallel_merge_timer = ADD_TIMER(runtime_profile(), "ParallelMergeTaskTime");
     _streaming_agg_timer = ADD_TIMER(runtime_profile(), "StreamingAggTime");
     _hash_table_size_counter = ADD_COUNTER(runtime_profile(), "HashTableSize", TUnit::UNIT);
     _hash_table_input_counter = ADD_COUNTER(runtime_profile(), "HashTableInputCount", TUnit::UNIT);
@@ -401,24 +416,7 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
         _executor.close = std::bind<void>(&AggregationNode::_close_without_key, this);
     } else {
         _init_hash_method(_probe_expr_ctxs);
-
-        std::visit(
-                [&](auto&& agg_method) {
-                    using HashTableType = std::decay_t<decltype(agg_method.data)>;
-                    using KeyType = typename HashTableType::key_type;
-
-                    /// some aggregate functions (like AVG for decimal) have align issues.
-                    _aggregate_data_container.reset(new AggregateDataContainer(
-                            sizeof(KeyType),
-                            ((_total_size_of_aggregate_states + _align_aggregate_states - 1) /
-                             _align_aggregate_states) *
-                                    _align_aggregate_states));
-                    if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
-                        agg_method.data.set_partitioned_threshold(
-                                state->partitioned_hash_agg_rows_threshold());
-                    }
-                },
-                _agg_data->_aggregated_method_variant);
+        _init_aggregate_data_container(state);
         if (_is_merge) {
             _executor.execute = std::bind<Status>(&AggregationNode::_merge_with_serialized_key,
                                                   this, std::placeholders::_1);
@@ -450,19 +448,94 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
         _should_limit_output = _limit != -1 &&        // has limit
                                !_vconjunct_ctx_ptr && // no having conjunct
                                _needs_finalize;       // agg's finalize step
+
+        if (!_is_streaming_preagg) {
+            _external_agg_bytes_threshold = state->external_agg_bytes_threshold();
+        }
+        if (_external_agg_bytes_threshold > 0) {
+            _block_spill_profile = runtime_profile()->create_child("BlockSpill", true, true);
+            runtime_profile()->add_child(_block_spill_profile, false, nullptr);
+            _spill_count = ADD_COUNTER(_block_spill_profile, "SpillCount", TUnit::UNIT);
+            _spill_rows = ADD_COUNTER(_block_spill_profile, "SpilledRows", TUnit::UNIT);
+            _spill_partition_count =
+                    ADD_COUNTER(_block_spill_profile, "PartitionCount", TUnit::UNIT);
+        }
+
+        // a spilled or limited node emits its result from _aggregate_data_container
+        if (_needs_finalize && config::agg_result_parallelism > 1 &&
+            _external_agg_bytes_threshold <= 0 && !_should_limit_output &&
+            std::all_of(_aggregate_evaluators.begin(), _aggregate_evaluators.end(),
+                        [](const auto* evaluator) { return evaluator->is_merge(); })) {
+            _merge_token = state->exec_env()->agg_result_thread_pool()->new_token(
+                    ThreadPool::ExecutionMode::CONCURRENT, config::agg_result_parallelism);
+        }
     }
 
     return Status::OK();
 }
 
+void AggregationNode::_init_aggregate_data_container(RuntimeState* state) {
+    std::visit(
+            [&](auto&& agg_method) {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                using KeyType = typename HashTableType::key_type;
+
+                /// some aggregate functions (like AVG for decimal) have align issues.
+                _aggregate_data_container.reset(new AggregateDataContainer(
+                        sizeof(KeyType),
+                        ((_total_size_of_aggregate_states + _align_aggregate_states - 1) /
+                         _align_aggregate_states) *
+                                _align_aggregate_states));
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
+                    agg_method.data.set_partitioned_threshold(
+                            state->partitioned_hash_agg_rows_threshold());
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+}
+
 Status AggregationNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
     RETURN_IF_ERROR(ExecNode::prepare(state));
     RETURN_IF_ERROR(prepare_profile(state));
+    _request_dict_code_key();
     return Status::OK();
 }
 
+static bool expr_has_slot(const VExpr* expr, SlotId slot_id) {
+    if (expr->is_slot_ref() && static_cast<const VSlotRef*>(expr)->slot_id() == slot_id) {
+        return true;
+    }
+    return std::any_of(expr->children().begin(), expr->children().end(),
+                       [&](const VExpr* child) { return expr_has_slot(child, slot_id); });
+}
+
+// Grouping by a single string column, the aggregation only needs the distinct values of
+// the column, so the scan is asked to carry it as dictionary codes when the segments or
+// the parquet column chunks are fully dictionary encoded. See `_find_places_by_dict_codes`.
+void AggregationNode::_request_dict_code_key() {
+    if (_is_merge || _probe_expr_ctxs.size() != 1 || !config::enable_low_cardinality_optimize) {
+        return;
+    }
+    auto* key_expr = _probe_expr_ctxs[0]->root();
+    if (!key_expr->is_slot_ref() ||
+        !WhichDataType(remove_nullable(key_expr->data_type())).is_string()) {
+        return;
+    }
+    auto slot_id = static_cast<VSlotRef*>(key_expr)->slot_id();
+    for (auto* evaluator : _aggregate_evaluators) {
+        for (auto* ctx : evaluator->input_exprs_ctxs()) {
+            if (expr_has_slot(ctx->root(), slot_id)) {
+                return;
+            }
+        }
+    }
+    if (auto* scan_node = dynamic_cast<VScanNode*>(child(0))) {
+        scan_node->request_dict_codes(slot_id);
+    }
+}
+
 Status AggregationNode::alloc_resource(doris::RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::alloc_resource(state));
 
@@ -555,11 +628,21 @@ Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
 }
 
 Status AggregationNode::pull(doris::RuntimeState* state, vectorized::Block* block, bool* eos) {
-    RETURN_IF_ERROR(_executor.get_result(state, block, eos));
+    if (_is_spilled) {
+        RETURN_IF_ERROR(_get_spilled_result(state, block, eos));
+    } else {
+        RETURN_IF_ERROR(_executor.get_result(state, block, eos));
+    }
     _make_nullable_output_key(block);
     // dispose the having clause, should not be execute in prestreaming agg
     RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
     reached_limit(block, eos);
+    if (*eos && _parallel_result > 0) {
+        // the rest of the sub tables are not needed when the limit is reached
+        std::lock_guard<std::mutex> l(_result_lock);
+        _stop_result_tasks = true;
+        _result_cv.notify_all();
+    }
 
     return Status::OK();
 }
@@ -568,12 +651,42 @@ Status AggregationNode::sink(doris::RuntimeState* state, vectorized::Block* in_b
     if (in_block->rows() > 0) {
         RETURN_IF_ERROR(_executor.execute(in_block));
         _executor.update_memusage();
+        if (_should_spill()) {
+            RETURN_IF_ERROR(_spill_hash_table(state));
+        }
+    }
+    if (eos) {
+        if (_is_spilled) {
+            RETURN_IF_ERROR(_finish_spill(state));
+        }
+        if (_use_parallel_result()) {
+            std::lock_guard<std::mutex> l(_result_lock);
+            _schedule_result_tasks(state);
+        } else {
+            _can_read = true;
+        }
     }
-    if (eos) _can_read = true;
     return Status::OK();
 }
 
+Status AggregationNode::try_close() {
+    std::lock_guard<std::mutex> l(_result_lock);
+    _stop_result_tasks = true;
+    // wakes up the tasks waiting for the queued blocks to be pulled
+    _result_cv.notify_all();
+    return Status::OK();
+}
+
+bool AggregationNode::has_running_result_tasks() {
+    std::lock_guard<std::mutex> l(_result_lock);
+    return _running_result_tasks > 0;
+}
+
 void AggregationNode::release_resource(RuntimeState* state) {
+    _wait_for_result_tasks();
+    if (_merge_token) {
+        _merge_token->shutdown();
+    }
     for (auto* aggregate_evaluator : _aggregate_evaluators) aggregate_evaluator->close(state);
     VExpr::close(_probe_expr_ctxs, state);
     if (_executor.close) _executor.close();
@@ -852,8 +965,85 @@ size_t AggregationNode::_get_hash_table_size() {
                       _agg_data->_aggregated_method_variant);
 }
 
+// Rows whose key is read as dictionary codes look up each word of the dictionary
+// in the hash table only once, and then take the place of their code.
+bool AggregationNode::_find_places_by_dict_codes(AggregateDataPtr* places,
+                                                 ColumnRawPtrs& key_columns, size_t num_rows,
+                                                 bool emplace) {
+    if (key_columns.size() != 1) {
+        return false;
+    }
+    const auto* dict_codes = ColumnDictCodes::get_dict_codes(*key_columns[0]);
+    if (dict_codes == nullptr) {
+        return false;
+    }
+    const UInt8* null_map = nullptr;
+    if (key_columns[0]->is_nullable()) {
+        null_map = assert_cast<const ColumnNullable*>(key_columns[0])->get_null_map_data().data();
+    }
+
+    auto& cache = _dict_code_places;
+    const auto& dict = dict_codes->get_dictionary();
+    if (cache.places.empty() || cache.dict != dict) {
+        cache.dict = dict;
+        cache.places.assign((dict ? dict->size() : 0) + 2, nullptr);
+        cache.pending.assign(cache.places.size(), 0);
+    }
+    const uint32_t null_slot = cache.places.size() - 1;
+
+    // the words of this block which are not in the cache yet
+    auto words = ColumnString::create();
+    auto words_null_map = ColumnUInt8::create();
+    std::vector<uint32_t> word_slots;
+    const auto& codes = dict_codes->get_data();
+    cache.row_slots.resize(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        uint32_t slot = null_map && null_map[i] ? null_slot : codes[i] + 1;
+        cache.row_slots[i] = slot;
+        if (cache.places[slot] != nullptr || cache.pending[slot]) {
+            continue;
+        }
+        cache.pending[slot] = 1;
+        word_slots.push_back(slot);
+        if (slot == null_slot) {
+            words->insert_default();
+            words_null_map->insert_value(1);
+        } else {
+            auto word = dict_codes->get_value(codes[i]);
+            words->insert_data(word.data, word.size);
+            words_null_map->insert_value(0);
+        }
+    }
+
+    if (!word_slots.empty()) {
+        ColumnPtr word_column = std::move(words);
+        if (null_map != nullptr) {
+            word_column = ColumnNullable::create(word_column, std::move(words_null_map));
+        }
+        ColumnRawPtrs word_key_columns {word_column.get()};
+        std::vector<AggregateDataPtr> word_places(word_slots.size());
+        if (emplace) {
+            _emplace_into_hash_table(word_places.data(), word_key_columns, word_slots.size());
+        } else {
+            _find_in_hash_table(word_places.data(), word_key_columns, word_slots.size());
+        }
+        for (size_t i = 0; i < word_slots.size(); ++i) {
+            cache.places[word_slots[i]] = word_places[i];
+            cache.pending[word_slots[i]] = 0;
+        }
+    }
+
+    for (size_t i = 0; i < num_rows; ++i) {
+        places[i] = cache.places[cache.row_slots[i]];
+    }
+    return true;
+}
+
 void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
                                                const size_t num_rows) {
+    if (_find_places_by_dict_codes(places, key_columns, num_rows, true)) {
+        return;
+    }
     std::visit(
             [&](auto&& agg_method) -> void {
                 SCOPED_TIMER(_hash_table_compute_timer);
@@ -941,6 +1131,9 @@ void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places, ColumnR
 
 void AggregationNode::_find_in_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
                                           size_t num_rows) {
+    if (_find_places_by_dict_codes(places, key_columns, num_rows, false)) {
+        return;
+    }
     std::visit(
             [&](auto&& agg_method) -> void {
                 using HashMethodType = std::decay_t<decltype(agg_method)>;
@@ -1029,6 +1222,15 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
                         SCOPED_TIMER(_streaming_agg_timer);
                         ret_flag = true;
 
+                        // keys read as dictionary codes leave the node as strings
+                        Columns decoded_keys(key_size);
+                        for (int i = 0; i < key_size; ++i) {
+                            decoded_keys[i] =
+                                    ColumnDictCodes::convert_to_string_column_if_dict_codes(
+                                            key_columns[i]->get_ptr());
+                            key_columns[i] = decoded_keys[i].get();
+                        }
+
                         // will serialize value data to string column.
                         // non-nullable column(id in `_make_nullable_keys`)
                         // will be converted to nullable.
@@ -1137,6 +1339,10 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
 
 Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Block* block,
                                                         bool* eos) {
+    if (_parallel_result > 0) {
+        return _get_parallel_result(state, block, eos);
+    }
+
     // non-nullable column(id in `_make_nullable_keys`) will be converted to nullable.
     bool mem_reuse = _make_nullable_keys.empty() && block->mem_reuse();
     auto column_withschema = VectorizedUtils::create_columns_with_type_and_name(_row_descriptor);
@@ -1235,6 +1441,411 @@ Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Blo
     return Status::OK();
 }
 
+bool AggregationNode::_use_parallel_merge() {
+    if (!_merge_token) {
+        return false;
+    }
+    return std::visit(
+            [&](auto&& agg_method) -> bool {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table &&
+                              HashTableTraits<HashTableType>::is_phmap) {
+                    return agg_method.data.is_partitioned();
+                } else {
+                    return false;
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+}
+
+// The rows are grouped by the sub table of their hash, and the task i emplaces and merges
+// the rows of the sub tables whose index is i modulo the number of tasks, so no two tasks
+// touch the same sub table. The null key is in no sub table, its rows are merged by the
+// calling thread, which also runs the task 0.
+Status AggregationNode::_merge_into_sub_tables(Block* block, ColumnRawPtrs& key_columns,
+                                               size_t num_rows) {
+    const size_t agg_size = _aggregate_evaluators.size();
+    _merge_buffers.resize(agg_size);
+    for (size_t i = 0; i < agg_size; ++i) {
+        int col_id = _get_slot_column_id(_aggregate_evaluators[i]);
+        auto column = block->get_by_position(col_id).column;
+        if (column->is_nullable()) {
+            column = ((ColumnNullable*)column.get())->get_nested_column_ptr();
+        }
+        auto* function = _aggregate_evaluators[i]->function();
+        _merge_buffers[i].resize(function->size_of_data() * num_rows);
+
+        SCOPED_TIMER(_deserialize_data_timer);
+        if (_use_fixed_length_serialization_opt) {
+            function->deserialize_from_column(_merge_buffers[i].data(), *column,
+                                              _agg_arena_pool.get(), num_rows);
+        } else {
+            function->deserialize_vec(_merge_buffers[i].data(), (ColumnString*)(column.get()),
+                                      _agg_arena_pool.get(), num_rows);
+        }
+    }
+    Defer destroy_buffers {[&]() {
+        for (size_t i = 0; i < agg_size; ++i) {
+            _aggregate_evaluators[i]->function()->destroy_vec(_merge_buffers[i].data(),
+                                                              num_rows);
+        }
+    }};
+
+    auto merge_row = [&](AggregateDataPtr place, size_t row, Arena* arena) {
+        for (size_t i = 0; i < agg_size; ++i) {
+            auto* function = _aggregate_evaluators[i]->function();
+            function->merge(place + _offsets_of_aggregate_states[i],
+                            _merge_buffers[i].data() + function->size_of_data() * row, arena);
+        }
+    };
+
+    Status status;
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                using HashMethodType = std::decay_t<decltype(agg_method)>;
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                using AggState = typename HashMethodType::State;
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table &&
+                              HashTableTraits<HashTableType>::is_phmap) {
+                    AggState state(key_columns, _probe_key_sz, nullptr);
+                    _pre_serialize_key_if_need(state, agg_method, key_columns, num_rows);
+
+                    const size_t num_tasks = std::min<size_t>(
+                            _merge_arenas.empty() ? config::agg_result_parallelism
+                                                  : _merge_arenas.size(),
+                            HashTableType::get_sub_table_count());
+                    while (_merge_arenas.size() < num_tasks) {
+                        _merge_arenas.emplace_back(std::make_unique<Arena>());
+                    }
+                    _merge_rows.resize(num_tasks);
+                    for (auto& rows : _merge_rows) {
+                        rows.clear();
+                    }
+                    if (_hash_values.size() < num_rows) {
+                        _hash_values.resize(num_rows);
+                    }
+                    std::vector<uint32_t> null_rows;
+                    {
+                        SCOPED_TIMER(_hash_table_compute_timer);
+                        for (size_t i = 0; i < num_rows; ++i) {
+                            if constexpr (ColumnsHashing::IsSingleNullableColumnMethod<
+                                                  AggState>::value) {
+                                if (key_columns[0]->is_null_at(i)) {
+                                    null_rows.push_back(i);
+                                    continue;
+                                }
+                            }
+                            if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<
+                                                  AggState>::value) {
+                                _hash_values[i] = agg_method.data.hash(agg_method.keys[i]);
+                            } else {
+                                _hash_values[i] = agg_method.data.hash(
+                                        state.get_key_holder(i, *_agg_arena_pool));
+                            }
+                            auto sub_table = HashTableType::get_sub_table_index(_hash_values[i]);
+                            _merge_rows[sub_table % num_tasks].push_back(i);
+                        }
+                    }
+                    COUNTER_UPDATE(_hash_table_input_counter, num_rows);
+
+                    auto emplace_row = [&](AggState& row_state, size_t row, Arena* arena) {
+                        auto creator = [&](const auto& ctor, const auto& key) {
+                            auto mapped = arena->aligned_alloc(_total_size_of_aggregate_states,
+                                                               _align_aggregate_states);
+                            _create_agg_status(mapped);
+                            ctor(key, mapped);
+                        };
+                        auto creator_for_null_key = [&](auto& mapped) {
+                            mapped = arena->aligned_alloc(_total_size_of_aggregate_states,
+                                                          _align_aggregate_states);
+                            _create_agg_status(mapped);
+                        };
+                        if constexpr (ColumnsHashing::IsSingleNullableColumnMethod<
+                                              AggState>::value) {
+                            return row_state.lazy_emplace_key(agg_method.data, row, *arena,
+                                                              _hash_values[row], creator,
+                                                              creator_for_null_key);
+                        } else {
+                            return row_state.lazy_emplace_key(agg_method.data, _hash_values[row],
+                                                              row, *arena, creator);
+                        }
+                    };
+
+                    auto merge_task = [&](size_t task_idx) -> Status {
+                        Arena* arena = _merge_arenas[task_idx].get();
+                        AggState task_state(key_columns, _probe_key_sz, nullptr);
+                        if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<
+                                              AggState>::value) {
+                            task_state.set_serialized_keys(agg_method.keys.data());
+                        }
+                        const auto& rows = _merge_rows[task_idx];
+                        RETURN_IF_CATCH_BAD_ALLOC({
+                            for (size_t j = 0; j < rows.size(); ++j) {
+                                if (LIKELY(j + HASH_MAP_PREFETCH_DIST < rows.size())) {
+                                    agg_method.data.prefetch_by_hash(
+                                            _hash_values[rows[j + HASH_MAP_PREFETCH_DIST]]);
+                                }
+                                merge_row(emplace_row(task_state, rows[j], arena), rows[j],
+                                          arena);
+                            }
+                        });
+                        return Status::OK();
+                    };
+
+                    SCOPED_TIMER(_parallel_merge_timer);
+                    std::vector<Status> task_status(num_tasks);
+                    auto* tracker_mgr = thread_context()->thread_mem_tracker_mgr.get();
+                    auto mem_tracker = tracker_mgr->limiter_mem_tracker();
+                    for (size_t task_idx = 1; task_idx < num_tasks; ++task_idx) {
+                        if (_merge_rows[task_idx].empty()) {
+                            continue;
+                        }
+                        auto st = _merge_token->submit_func([&, task_idx, mem_tracker] {
+                            SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(mem_tracker);
+                            task_status[task_idx] = merge_task(task_idx);
+                        });
+                        if (!st.ok()) {
+                            // the pool is shutting down, merges the rows in this thread
+                            task_status[task_idx] = merge_task(task_idx);
+                        }
+                    }
+                    task_status[0] = merge_task(0);
+                    auto merge_null_rows = [&]() -> Status {
+                        RETURN_IF_CATCH_BAD_ALLOC({
+                            for (auto row : null_rows) {
+                                merge_row(emplace_row(state, row, _agg_arena_pool.get()), row,
+                                          _agg_arena_pool.get());
+                            }
+                        });
+                        return Status::OK();
+                    };
+                    status = merge_null_rows();
+                    _merge_token->wait();
+                    for (auto& st : task_status) {
+                        if (status.ok() && !st.ok()) {
+                            status = st;
+                        }
+                    }
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+    return status;
+}
+
+bool AggregationNode::_use_parallel_result() {
+    if (_parallel_result >= 0) {
+        return _parallel_result;
+    }
+    _parallel_result = 0;
+    if (!_merge_arenas.empty()) {
+        // the keys merged by the tasks are only in the sub tables
+        _parallel_result = 1;
+        _max_result_blocks = _merge_arenas.size() * 2;
+        return true;
+    }
+    if (config::agg_result_parallelism <= 1 || !_needs_finalize || _probe_expr_ctxs.empty() ||
+        _is_spilled) {
+        return false;
+    }
+    _parallel_result = std::visit(
+            [&](auto&& agg_method) -> bool {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
+                    return agg_method.data.is_partitioned();
+                } else {
+                    return false;
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+    // bounds the memory of the blocks waiting for pull()
+    _max_result_blocks = config::agg_result_parallelism * 2;
+    return _parallel_result;
+}
+
+// Called with _result_lock held.
+void AggregationNode::_schedule_result_tasks(RuntimeState* state) {
+    const size_t sub_table_count = std::visit(
+            [&](auto&& agg_method) -> size_t {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
+                    return HashTableType::get_sub_table_count();
+                } else {
+                    return 0;
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+    const int parallelism = std::max(config::agg_result_parallelism, 1);
+    while (_result_status.ok() && _running_result_tasks < parallelism &&
+           _next_result_sub_table < sub_table_count &&
+           _result_blocks.size() < _max_result_blocks) {
+        size_t sub_table_idx = _next_result_sub_table++;
+        auto st = state->exec_env()->agg_result_thread_pool()->submit_func(
+                [this, state, sub_table_idx] { _emit_sub_table(state, sub_table_idx); });
+        if (!st.ok()) {
+            _result_status = st;
+            break;
+        }
+        ++_running_result_tasks;
+    }
+    _can_read = !_result_blocks.empty() || _running_result_tasks == 0 || !_result_status.ok();
+}
+
+void AggregationNode::_emit_sub_table(RuntimeState* state, size_t sub_table_idx) {
+    SCOPED_ATTACH_TASK(state);
+    SCOPED_TIMER(_result_task_timer);
+    auto column_withschema = VectorizedUtils::create_columns_with_type_and_name(_row_descriptor);
+    int key_size = _probe_expr_ctxs.size();
+    const size_t batch_size = state->batch_size();
+
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
+                    using KeyType = std::decay_t<decltype(agg_method.iterator->get_first())>;
+                    std::vector<KeyType> keys;
+                    std::vector<AggregateDataPtr> values;
+                    keys.reserve(batch_size);
+                    values.reserve(batch_size);
+
+                    auto flush = [&]() {
+                        MutableColumns columns;
+                        for (const auto& column : column_withschema) {
+                            columns.emplace_back(column.type->create_column());
+                        }
+                        MutableColumns key_columns(key_size);
+                        for (int i = 0; i < key_size; ++i) {
+                            key_columns[i] = std::move(columns[i]);
+                        }
+                        agg_method.insert_keys_into_columns(keys, key_columns, keys.size(),
+                                                            _probe_key_sz);
+                        for (int i = 0; i < key_size; ++i) {
+                            columns[i] = std::move(key_columns[i]);
+                        }
+                        for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+                            _aggregate_evaluators[i]->insert_result_info_vec(
+                                    values, _offsets_of_aggregate_states[i],
+                                    columns[key_size + i].get(), keys.size());
+                        }
+                        Block block = column_withschema;
+                        block.set_columns(std::move(columns));
+                        keys.clear();
+                        values.clear();
+
+                        std::unique_lock<std::mutex> l(_result_lock);
+                        // waits for pull() while the queue is full, a cancelled query wakes
+                        // up nobody, so the wait is polled
+                        while (_result_blocks.size() >= _max_result_blocks &&
+                               !_stop_result_tasks && !state->is_cancelled()) {
+                            _result_cv.wait_for(l, std::chrono::milliseconds(100));
+                        }
+                        if (_stop_result_tasks || state->is_cancelled()) {
+                            return;
+                        }
+                        _result_blocks.emplace_back(std::move(block));
+                        _can_read = true;
+                        _result_cv.notify_all();
+                        l.unlock();
+                        pipeline::notify_blocked_tasks();
+                    };
+
+                    agg_method.data.for_each_value_of_sub_table(
+                            sub_table_idx, [&](const auto& key, auto& mapped) {
+                                if (_stop_result_tasks || state->is_cancelled()) {
+                                    return false;
+                                }
+                                keys.emplace_back(key);
+                                values.emplace_back(mapped);
+                                if (keys.size() == batch_size) {
+                                    flush();
+                                }
+                                return true;
+                            });
+                    if (!keys.empty() && !_stop_result_tasks && !state->is_cancelled()) {
+                        flush();
+                    }
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+
+    {
+        std::lock_guard<std::mutex> l(_result_lock);
+        --_running_result_tasks;
+        if (state->is_cancelled() && _result_status.ok()) {
+            // the sub table is incomplete
+            _result_status = Status::Cancelled("Cancelled");
+        }
+        if (!_stop_result_tasks) {
+            _schedule_result_tasks(state);
+        }
+        _result_cv.notify_all();
+    }
+    // the source may wait for the end of the tasks in can_read() or is_pending_finish()
+    pipeline::notify_blocked_tasks();
+}
+
+Status AggregationNode::_get_parallel_result(RuntimeState* state, Block* block, bool* eos) {
+    std::unique_lock<std::mutex> l(_result_lock);
+    if (!state->enable_pipeline_exec()) {
+        // a pipeline task must not block its worker, it is only scheduled when can_read()
+        _result_cv.wait(l, [&] {
+            return !_result_blocks.empty() || _running_result_tasks == 0 || !_result_status.ok();
+        });
+    }
+    RETURN_IF_ERROR(_result_status);
+
+    if (!_result_blocks.empty()) {
+        *block = std::move(_result_blocks.front());
+        _result_blocks.pop_front();
+        _schedule_result_tasks(state);
+        // wakes up the tasks waiting for a free slot in the queue
+        _result_cv.notify_all();
+        return Status::OK();
+    }
+    if (_running_result_tasks > 0) {
+        _can_read = false;
+        return Status::OK();
+    }
+    // all the sub tables are emitted, the null key is not in any of them
+    *eos = true;
+    return _emit_null_key(block);
+}
+
+Status AggregationNode::_emit_null_key(Block* block) {
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                if (!agg_method.data.has_null_key_data()) {
+                    return;
+                }
+                auto column_withschema =
+                        VectorizedUtils::create_columns_with_type_and_name(_row_descriptor);
+                MutableColumns columns;
+                for (const auto& column : column_withschema) {
+                    columns.emplace_back(column.type->create_column());
+                }
+                // only one key of group by support wrap null key
+                DCHECK(_probe_expr_ctxs.size() == 1);
+                DCHECK(columns[0]->is_nullable());
+                columns[0]->insert_data(nullptr, 0);
+                auto mapped = agg_method.data.get_null_key_data();
+                for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+                    _aggregate_evaluators[i]->insert_result_info(
+                            mapped + _offsets_of_aggregate_states[i], columns[1 + i].get());
+                }
+                *block = column_withschema;
+                block->set_columns(std::move(columns));
+            },
+            _agg_data->_aggregated_method_variant);
+    return Status::OK();
+}
+
+void AggregationNode::_wait_for_result_tasks() {
+    std::unique_lock<std::mutex> l(_result_lock);
+    _stop_result_tasks = true;
+    _result_cv.notify_all();
+    _result_cv.wait(l, [&] { return _running_result_tasks == 0; });
+    _result_blocks.clear();
+}
+
 Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* state, Block* block,
                                                               bool* eos) {
     SCOPED_TIMER(_serialize_result_timer);
@@ -1374,9 +1985,12 @@ void AggregationNode::_update_memusage_with_serialized_key() {
     std::visit(
             [&](auto&& agg_method) -> void {
                 auto& data = agg_method.data;
-                auto arena_memory_usage = _agg_arena_pool->size() +
-                                          _aggregate_data_container->memory_usage() -
-                                          _mem_usage_record.used_in_arena;
+                size_t arena_size =
+                        _agg_arena_pool->size() + _aggregate_data_container->memory_usage();
+                for (const auto& arena : _merge_arenas) {
+                    arena_size += arena->size();
+                }
+                auto arena_memory_usage = arena_size - _mem_usage_record.used_in_arena;
                 mem_tracker()->consume(arena_memory_usage);
                 mem_tracker()->consume(data.get_buffer_size_in_bytes() -
                                        _mem_usage_record.used_in_state);
@@ -1384,8 +1998,7 @@ void AggregationNode::_update_memusage_with_serialized_key() {
                 COUNTER_UPDATE(_hash_table_memory_usage,
                                data.get_buffer_size_in_bytes() - _mem_usage_record.used_in_state);
                 _mem_usage_record.used_in_state = data.get_buffer_size_in_bytes();
-                _mem_usage_record.used_in_arena =
-                        _agg_arena_pool->size() + _aggregate_data_container->memory_usage();
+                _mem_usage_record.used_in_arena = arena_size;
             },
             _agg_data->_aggregated_method_variant);
 }
@@ -1405,16 +2018,268 @@ void AggregationNode::_close_with_serialized_key() {
     release_tracker();
 }
 
+// Once the limit is reached, the rows of new groups are dropped instead of being inserted.
+// Spilling then would start an empty hash table which accepts new groups again, whose rows
+// before the spill have been dropped, so the hash table is kept in memory from then on.
+bool AggregationNode::_should_spill() const {
+    return _external_agg_bytes_threshold > 0 && !_reach_limit &&
+           _mem_usage_record.used_in_arena + _mem_usage_record.used_in_state >=
+                   _external_agg_bytes_threshold;
+}
+
+// Serialize the whole hash table into the intermediate format (keys followed by
+// the serialized aggregate states), write it to the partition spill files and
+// start over with an empty hash table.
+//
+// The rows of a partition are written as soon as a batch of them is collected, so only
+// a batch per partition is kept besides the serialized blocks waiting for the disk,
+// whose number the writers bound.
+Status AggregationNode::_spill_hash_table(RuntimeState* state) {
+    if (_spill_partition_writers.empty()) {
+        _spill_partition_writers.resize(SPILL_PARTITION_COUNT);
+    }
+    _is_spilled = true;
+    // A group may have rows both on disk and in the following hash tables, so no group can
+    // be dropped any more. The limit is still applied to the output.
+    _should_limit_output = false;
+    COUNTER_UPDATE(_spill_count, 1);
+
+    std::vector<MutableBlock> partition_blocks(SPILL_PARTITION_COUNT);
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        RETURN_IF_ERROR(_serialize_with_serialized_key_result(state, &block, &eos));
+        RETURN_IF_ERROR(_spill_partitioned_block(block, partition_blocks));
+        for (size_t i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+            if (partition_blocks[i].rows() >= state->batch_size()) {
+                RETURN_IF_ERROR(_write_spill_partition(state, i, partition_blocks[i]));
+            }
+        }
+    }
+    for (size_t i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+        if (!partition_blocks[i].empty()) {
+            RETURN_IF_ERROR(_write_spill_partition(state, i, partition_blocks[i]));
+        }
+    }
+    return _reset_hash_table(state);
+}
+
+Status AggregationNode::_write_spill_partition(RuntimeState* state, size_t partition,
+                                               MutableBlock& partition_block) {
+    auto& writer = _spill_partition_writers[partition];
+    if (!writer) {
+        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
+                state->batch_size(), writer, _block_spill_profile));
+        COUNTER_UPDATE(_spill_partition_count, 1);
+    }
+    RETURN_IF_ERROR(writer->write(partition_block.to_block()));
+    partition_block = MutableBlock();
+    return Status::OK();
+}
+
+Status AggregationNode::_spill_partitioned_block(Block& block,
+                                                 std::vector<MutableBlock>& partition_blocks) {
+    const size_t rows = block.rows();
+    if (rows == 0) {
+        return Status::OK();
+    }
+
+    // the same key always goes to the same partition, no matter in which round
+    // of spilling it is written.
+    size_t key_size = _probe_expr_ctxs.size();
+    std::vector<uint64_t> hash_vals(rows);
+    for (size_t i = 0; i < key_size; ++i) {
+        block.get_by_position(i).column->update_hashes_with_value(hash_vals.data());
+    }
+    IColumn::Selector selector(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        selector[i] = hash_vals[i] % SPILL_PARTITION_COUNT;
+    }
+
+    std::vector<MutableColumns> partition_columns(SPILL_PARTITION_COUNT);
+    for (size_t i = 0; i < block.columns(); ++i) {
+        auto scattered_columns =
+                block.get_by_position(i).column->scatter(SPILL_PARTITION_COUNT, selector);
+        for (size_t j = 0; j < SPILL_PARTITION_COUNT; ++j) {
+            partition_columns[j].emplace_back(std::move(scattered_columns[j]));
+        }
+    }
+
+    for (size_t i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+        if (partition_columns[i][0]->empty()) {
+            continue;
+        }
+        Block partition_block = block.clone_with_columns(std::move(partition_columns[i]));
+        RETURN_IF_ERROR(partition_blocks[i].merge(std::move(partition_block)));
+    }
+    COUNTER_UPDATE(_spill_rows, rows);
+    return Status::OK();
+}
+
+// Called when all the input has been consumed. The data still in memory is spilled
+// too, so that every partition can be merged from disk in one pass. The writers are
+// closed by the first pull, once their last writes are on disk.
+Status AggregationNode::_finish_spill(RuntimeState* state) {
+    RETURN_IF_ERROR(_spill_hash_table(state));
+    _read_spill_partition_index = 0;
+    _spill_partition_loaded = false;
+    return Status::OK();
+}
+
+Status AggregationNode::_close_spill_writers() {
+    for (auto& writer : _spill_partition_writers) {
+        if (writer) {
+            _spill_partition_streams.emplace_back(writer->get_id());
+            RETURN_IF_ERROR(writer->close());
+        }
+    }
+    _spill_partition_writers.clear();
+    return Status::OK();
+}
+
+bool AggregationNode::can_sink_write() const {
+    return std::all_of(_spill_partition_writers.begin(), _spill_partition_writers.end(),
+                       [](const auto& writer) { return !writer || writer->can_write(); });
+}
+
+bool AggregationNode::can_read_spilled() const {
+    return can_sink_write() && (!_spill_reader || _spill_reader->can_read());
+}
+
+Status AggregationNode::_reset_hash_table(RuntimeState* state) {
+    _close_with_serialized_key();
+    COUNTER_UPDATE(_hash_table_memory_usage, -_mem_usage_record.used_in_state);
+    _mem_usage_record = MemoryRecord();
+
+    _agg_data = std::make_unique<AggregatedDataVariants>();
+    _agg_data->set_enable_partitioned_hash_table(_partitioned_hash_table_enabled);
+    _init_hash_method(_probe_expr_ctxs);
+    _init_aggregate_data_container(state);
+    _agg_arena_pool = std::make_unique<Arena>();
+    _merge_arenas.clear();
+    _dict_code_places.reset();
+    return Status::OK();
+}
+
+// Merges the blocks of `_spill_reader` into the hash table. In a pipeline task it stops
+// once the next block is still being read from disk, and `*finished` is false, the
+// task is descheduled until `can_read_spilled` and merges the rest in the next pull.
+Status AggregationNode::_merge_spilled_partition(RuntimeState* state, bool* finished) {
+    *finished = false;
+    Block block;
+    while (true) {
+        RETURN_IF_CANCELLED(state);
+        if (state->enable_pipeline_exec() && !_spill_reader->can_read()) {
+            return Status::OK();
+        }
+        bool eos = false;
+        RETURN_IF_ERROR(_spill_reader->read(&block, &eos));
+        if (eos) {
+            break;
+        }
+        if (block.rows() > 0) {
+            RETURN_IF_ERROR(_merge_spilled_block(&block));
+            _executor.update_memusage();
+        }
+    }
+    RETURN_IF_ERROR(_spill_reader->close());
+    _spill_reader.reset();
+    *finished = true;
+    return Status::OK();
+}
+
+// The spilled block is laid out as the output of `_serialize_with_serialized_key_result`,
+// so the keys are the first columns and every aggregate state is always merged.
+Status AggregationNode::_merge_spilled_block(Block* block) {
+    SCOPED_TIMER(_merge_timer);
+
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    for (size_t i = 0; i < key_size; ++i) {
+        key_columns[i] = block->get_by_position(i).column.get();
+    }
+
+    int rows = block->rows();
+    if (_places.size() < rows) {
+        _places.resize(rows);
+    }
+    RETURN_IF_CATCH_BAD_ALLOC(_emplace_into_hash_table(_places.data(), key_columns, rows));
+
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        auto column = block->get_by_position(key_size + i).column;
+        size_t buffer_size = _aggregate_evaluators[i]->function()->size_of_data() * rows;
+        if (_deserialize_buffer.size() < buffer_size) {
+            _deserialize_buffer.resize(buffer_size);
+        }
+
+        {
+            SCOPED_TIMER(_deserialize_data_timer);
+            if (_use_fixed_length_serialization_opt) {
+                _aggregate_evaluators[i]->function()->deserialize_from_column(
+                        _deserialize_buffer.data(), *column, _agg_arena_pool.get(), rows);
+            } else {
+                _aggregate_evaluators[i]->function()->deserialize_vec(
+                        _deserialize_buffer.data(), (ColumnString*)(column.get()),
+                        _agg_arena_pool.get(), rows);
+            }
+        }
+        _aggregate_evaluators[i]->function()->merge_vec(_places.data(),
+                                                        _offsets_of_aggregate_states[i],
+                                                        _deserialize_buffer.data(),
+                                                        _agg_arena_pool.get(), rows);
+        _aggregate_evaluators[i]->function()->destroy_vec(_deserialize_buffer.data(), rows);
+    }
+    return Status::OK();
+}
+
+// Merge the spilled partitions back one at a time, and output the result of
+// a partition before the next one is loaded.
+Status AggregationNode::_get_spilled_result(RuntimeState* state, Block* block, bool* eos) {
+    if (!_spill_partition_writers.empty()) {
+        RETURN_IF_ERROR(_close_spill_writers());
+    }
+    while (true) {
+        if (!_spill_partition_loaded) {
+            if (!_spill_reader) {
+                if (_read_spill_partition_index == _spill_partition_streams.size()) {
+                    *eos = true;
+                    return Status::OK();
+                }
+                RETURN_IF_ERROR(_reset_hash_table(state));
+                RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
+                        _spill_partition_streams[_read_spill_partition_index++], _spill_reader,
+                        _block_spill_profile));
+            }
+            RETURN_IF_ERROR(_merge_spilled_partition(state, &_spill_partition_loaded));
+            if (!_spill_partition_loaded) {
+                return Status::OK();
+            }
+        }
+
+        bool partition_eos = false;
+        RETURN_IF_ERROR(_executor.get_result(state, block, &partition_eos));
+        if (partition_eos) {
+            _spill_partition_loaded = false;
+        }
+        if (block->rows() > 0) {
+            return Status::OK();
+        }
+    }
+}
+
 void AggregationNode::release_tracker() {
     mem_tracker()->release(_mem_usage_record.used_in_state + _mem_usage_record.used_in_arena);
 }
 
 void AggregationNode::_release_mem() {
+    _dict_code_places.reset();
     _agg_data = nullptr;
     _aggregate_data_container = nullptr;
     _agg_profile_arena = nullptr;
     _agg_arena_pool = nullptr;
     _preagg_block.clear();
+    _spill_partition_writers.clear();
+    _spill_reader.reset();
 
     PODArray<AggregateDataPtr> tmp_places;
     _places.swap(tmp_places);
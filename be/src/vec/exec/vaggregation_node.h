@@ -17,16 +17,23 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
 #include <variant>
 
 #include "common/object_pool.h"
 #include "exec/exec_node.h"
+#include "util/threadpool.h"
 #include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/columns/column_dict_codes.h"
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/fixed_hash_map.h"
 #include "vec/common/hash_table/partitioned_hash_map.h"
 #include "vec/common/hash_table/string_hash_map.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/exprs/vectorized_agg_fn.h"
 #include "vec/exprs/vslot_ref.h"
 
@@ -974,7 +981,11 @@ private:
     bool _inited = false;
 };
 
-// not support spill
+// When `external_agg_bytes_threshold` is set, the hash table of a non-streaming
+// aggregation with group by keys is spilled to disk once its memory usage
+// passes the threshold. Spilled rows are serialized into the intermediate
+// (key, serialized state) format and partitioned by the hash of the keys, so
+// each partition can be merged back and output independently.
 class AggregationNode final : public ::doris::ExecNode {
 public:
     using Sizes = std::vector<size_t>;
@@ -994,6 +1005,17 @@ public:
     Status do_pre_agg(vectorized::Block* input_block, vectorized::Block* output_block);
     bool is_streaming_preagg() { return _is_streaming_preagg; }
 
+    // False while a spill of the hash table is still being written to disk.
+    bool can_sink_write() const;
+    // False while the spilled data is still being written, or the next spilled block
+    // to merge is still being read from disk.
+    bool can_read_spilled() const;
+
+    // Stops the tasks emitting the result in parallel, the pipeline task of the source is
+    // pending finish until they have exited, so that its close does not block a worker.
+    Status try_close();
+    bool has_running_result_tasks();
+
 private:
     friend class pipeline::AggSinkOperator;
     friend class pipeline::StreamingAggSinkOperator;
@@ -1006,6 +1028,23 @@ private:
     std::vector<size_t> _make_nullable_keys;
     std::vector<size_t> _probe_key_sz;
 
+    // The places of the words in the dictionary of the last key column read as
+    // ColumnDictCodes, by code + 1. The code -1 of the empty string takes the first
+    // one and null keys take the last one.
+    struct DictCodePlaces {
+        ColumnDictCodes::DictionaryPtr dict;
+        std::vector<AggregateDataPtr> places;
+        std::vector<uint8_t> pending;
+        std::vector<uint32_t> row_slots;
+
+        void reset() {
+            dict.reset();
+            places.clear();
+            pending.clear();
+        }
+    };
+    DictCodePlaces _dict_code_places;
+
     std::vector<AggFnEvaluator*> _aggregate_evaluators;
 
     // may be we don't have to know the tuple id
@@ -1068,6 +1107,50 @@ private:
     std::vector<AggregateDataPtr> _values;
     std::unique_ptr<AggregateDataContainer> _aggregate_data_container;
 
+    int64_t _external_agg_bytes_threshold = 0;
+    bool _is_spilled = false;
+    // one spill writer per partition, kept open until the input is exhausted
+    std::vector<BlockSpillWriterUPtr> _spill_partition_writers;
+    std::vector<int64_t> _spill_partition_streams;
+    size_t _read_spill_partition_index = 0;
+    // the partition being merged back into the hash table
+    BlockSpillReaderUPtr _spill_reader;
+    bool _spill_partition_loaded = false;
+
+    RuntimeProfile* _block_spill_profile = nullptr;
+    RuntimeProfile::Counter* _spill_count = nullptr;
+    RuntimeProfile::Counter* _spill_rows = nullptr;
+    RuntimeProfile::Counter* _spill_partition_count = nullptr;
+
+    // When the hash table of a finalizing aggregation has been partitioned, the final result
+    // is emitted by up to agg_result_parallelism tasks of the AggResultThreadPool, each
+    // converting one sub table into blocks, and pull() returns the blocks in the order they
+    // are ready. The tasks are scheduled at the eos of sink(), and a task waits while
+    // _max_result_blocks blocks are queued. The serialization of a non-finalizing
+    // aggregation stays serial.
+    // _can_read is true iff a block is queued or all the tasks are done.
+    int _parallel_result = -1; // -1: not decided yet
+    size_t _max_result_blocks = 0;
+    std::mutex _result_lock;
+    std::condition_variable _result_cv;
+    std::deque<Block> _result_blocks;
+    size_t _next_result_sub_table = 0;
+    int _running_result_tasks = 0;
+    std::atomic<bool> _stop_result_tasks = false;
+    Status _result_status;
+    RuntimeProfile::Counter* _result_task_timer = nullptr;
+
+    // A finalizing merge whose hash table has been partitioned merges each input block in
+    // up to agg_result_parallelism tasks of _merge_token, every task owning the rows of a
+    // disjoint set of sub tables. The states created by task i are allocated in
+    // _merge_arenas[i] and are not added to _aggregate_data_container, so such a node always
+    // emits its result from the sub tables.
+    std::unique_ptr<ThreadPoolToken> _merge_token;
+    std::vector<ArenaUPtr> _merge_arenas;
+    std::vector<std::vector<uint32_t>> _merge_rows;
+    std::vector<std::vector<char>> _merge_buffers;
+    RuntimeProfile::Counter* _parallel_merge_timer = nullptr;
+
 private:
     void _release_self_resource(RuntimeState* state);
     /// Return true if we should keep expanding hash tables in the preagg. If false,
@@ -1096,6 +1179,28 @@ private:
     void _update_memusage_with_serialized_key();
     void _close_with_serialized_key();
     void _init_hash_method(std::vector<VExprContext*>& probe_exprs);
+    void _init_aggregate_data_container(RuntimeState* state);
+
+    bool _should_spill() const;
+    Status _spill_hash_table(RuntimeState* state);
+    Status _spill_partitioned_block(Block& block, std::vector<MutableBlock>& partition_blocks);
+    Status _write_spill_partition(RuntimeState* state, size_t partition,
+                                  MutableBlock& partition_block);
+    Status _finish_spill(RuntimeState* state);
+    Status _close_spill_writers();
+    Status _reset_hash_table(RuntimeState* state);
+    Status _merge_spilled_partition(RuntimeState* state, bool* finished);
+    Status _merge_spilled_block(Block* block);
+    Status _get_spilled_result(RuntimeState* state, Block* block, bool* eos);
+
+    bool _use_parallel_merge();
+    Status _merge_into_sub_tables(Block* block, ColumnRawPtrs& key_columns, size_t num_rows);
+    bool _use_parallel_result();
+    Status _get_parallel_result(RuntimeState* state, Block* block, bool* eos);
+    void _schedule_result_tasks(RuntimeState* state);
+    void _emit_sub_table(RuntimeState* state, size_t sub_table_idx);
+    Status _emit_null_key(Block* block);
+    void _wait_for_result_tasks();
 
     template <typename AggState, typename AggMethod>
     void _pre_serialize_key_if_need(AggState& state, AggMethod& agg_method,
@@ -1231,6 +1336,9 @@ private:
                 }
             }
         } else {
+            if (_use_parallel_merge()) {
+                return _merge_into_sub_tables(block, key_columns, rows);
+            }
             _emplace_into_hash_table(_places.data(), key_columns, rows);
 
             for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
@@ -1284,6 +1392,11 @@ private:
 
     void _find_in_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns, size_t num_rows);
 
+    bool _find_places_by_dict_codes(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
+                                    size_t num_rows, bool emplace);
+
+    void _request_dict_code_key();
+
     void release_tracker();
 
     void _release_mem();
@@ -17,8 +17,12 @@
 
 #include "vec/exec/vanalytic_eval_node.h"
 
+#include "runtime/block_spill_manager.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "vec/columns/column_const.h"
+#include "vec/core/block_spill_reader.h"
 #include "vec/exprs/vexpr.h"
 
 namespace doris::vectorized {
@@ -147,6 +151,8 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     auto* memory_usage = runtime_profile()->create_child("MemoryUsage", true, true);
     runtime_profile()->add_child(memory_usage, false, nullptr);
     _blocks_memory_usage = memory_usage->AddHighWaterMarkCounter("Blocks", TUnit::BYTES);
+    _segment_tree_memory_usage =
+            memory_usage->AddHighWaterMarkCounter("SegmentTree", TUnit::BYTES);
     _evaluation_timer = ADD_TIMER(runtime_profile(), "EvaluationTime");
     SCOPED_TIMER(_evaluation_timer);
 
@@ -184,6 +190,15 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     _fn_place_ptr = _agg_arena_pool->aligned_alloc(_total_size_of_aggregate_states,
                                                    _align_aggregate_states);
     _create_agg_status();
+    _init_sliding_strategies();
+
+    _external_analytic_bytes_threshold = state->external_analytic_bytes_threshold();
+    if (_external_analytic_bytes_threshold > 0) {
+        _block_spill_profile = runtime_profile()->create_child("BlockSpill", true, true);
+        runtime_profile()->add_child(_block_spill_profile, false, nullptr);
+        _spill_block_count = ADD_COUNTER(_block_spill_profile, "SpillBlockCount", TUnit::UNIT);
+        _spill_rows = ADD_COUNTER(_block_spill_profile, "SpilledRows", TUnit::UNIT);
+    }
     _executor.insert_result =
             std::bind<void>(&VAnalyticEvalNode::_insert_result_info, this, std::placeholders::_1);
     _executor.execute =
@@ -254,6 +269,7 @@ Status VAnalyticEvalNode::pull(doris::RuntimeState* /*state*/, vectorized::Block
             return Status::OK();
         }
         _next_partition = _init_next_partition(_found_partition_end);
+        RETURN_IF_ERROR(_restore_agg_inputs(_partition_by_end.pos));
         _init_result_columns();
         size_t current_block_rows = _input_blocks[_output_block_index].rows();
         _executor.get_next(current_block_rows);
@@ -283,6 +299,8 @@ void VAnalyticEvalNode::release_resource(RuntimeState* state) {
         agg_function->close(state);
     }
 
+    _reset_sliding_frame();
+    _remove_spilled_blocks();
     _destroy_agg_status();
     _release_mem();
     return ExecNode::release_resource(state);
@@ -291,7 +309,11 @@ void VAnalyticEvalNode::release_resource(RuntimeState* state) {
 //TODO: maybe could have better strategy, not noly when need data to sink data
 //even could get some resources in advance as soon as possible
 bool VAnalyticEvalNode::can_write() {
-    return _need_more_input;
+    auto can_spill = [](const SpillQueue& queue) {
+        return !queue.writer || queue.writer->can_write();
+    };
+    return _need_more_input && can_spill(_payload_spill_queue) &&
+           can_spill(_agg_input_spill_queue);
 }
 
 bool VAnalyticEvalNode::can_read() {
@@ -362,8 +384,9 @@ Status VAnalyticEvalNode::_get_next_for_rows(size_t current_block_rows) {
             range_start = _current_row_position;
             range_end = _current_row_position +
                         1; //going on calculate,add up data, no need to reset state
+            _executor.execute(_partition_by_start.pos, _partition_by_end.pos, range_start,
+                              range_end);
         } else {
-            _reset_agg_status();
             if (!_window.__isset
                          .window_start) { //[preceding, offset]        --unbound: [preceding, following]
                 range_start = _partition_by_start.pos;
@@ -371,8 +394,8 @@ Status VAnalyticEvalNode::_get_next_for_rows(size_t current_block_rows) {
                 range_start = _current_row_position + _rows_start_offset;
             }
             range_end = _current_row_position + _rows_end_offset + 1;
+            _execute_for_sliding_frame(range_start, range_end);
         }
-        _executor.execute(_partition_by_start.pos, _partition_by_end.pos, range_start, range_end);
         _executor.insert_result(current_block_rows);
     }
     return Status::OK();
@@ -393,6 +416,7 @@ Status VAnalyticEvalNode::_consumed_block_and_init_partition(RuntimeState* state
     }
     SCOPED_TIMER(_evaluation_timer);
     *next_partition = _init_next_partition(found_partition_end);
+    RETURN_IF_ERROR(_restore_agg_inputs(_partition_by_end.pos));
     RETURN_IF_ERROR(_init_result_columns());
     return Status::OK();
 }
@@ -528,7 +552,7 @@ Status VAnalyticEvalNode::_fetch_next_block_data(RuntimeState* state) {
     return Status::OK();
 }
 
-Status VAnalyticEvalNode::sink(doris::RuntimeState* /*state*/, vectorized::Block* input_block,
+Status VAnalyticEvalNode::sink(doris::RuntimeState* state, vectorized::Block* input_block,
                                bool eos) {
     _input_eos = eos;
     if (_input_eos && input_block->rows() == 0) {
@@ -550,11 +574,14 @@ Status VAnalyticEvalNode::sink(doris::RuntimeState* /*state*/, vectorized::Block
         }
     }
 
-    for (size_t i = 0; i < _agg_functions_size;
-         ++i) { //insert _agg_intput_columns, execute calculate for its
+    // the arguments of the aggregates, appended to _agg_intput_columns or spilled below
+    std::vector<int> agg_input_column_ids;
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
         for (size_t j = 0; j < _agg_expr_ctxs[i].size(); ++j) {
-            RETURN_IF_ERROR(_insert_range_column(input_block, _agg_expr_ctxs[i][j],
-                                                 _agg_intput_columns[i][j].get(), block_rows));
+            int result_col_id = -1;
+            RETURN_IF_ERROR(_agg_expr_ctxs[i][j]->execute(input_block, &result_col_id));
+            DCHECK_GE(result_col_id, 0);
+            agg_input_column_ids.emplace_back(result_col_id);
         }
     }
     //record column idx in block
@@ -572,6 +599,21 @@ Status VAnalyticEvalNode::sink(doris::RuntimeState* /*state*/, vectorized::Block
         _ordey_by_column_idxs[i] = result_col_id;
     }
 
+    bool spill = _external_analytic_bytes_threshold > 0 &&
+                 _blocks_memory_usage->current_value() + input_block->allocated_bytes() >
+                         _external_analytic_bytes_threshold;
+    // the rows of _agg_intput_columns are in input order, so once the arguments of a block
+    // are spilled, those of the next blocks are spilled as well until they are read back
+    if (!agg_input_column_ids.empty() && (spill || !_agg_input_spill_queue.blocks.empty())) {
+        RETURN_IF_ERROR(_spill_agg_inputs(state, *input_block, agg_input_column_ids));
+    } else {
+        _append_agg_inputs(*input_block, agg_input_column_ids);
+    }
+    _spilled_payloads.emplace_back(spill);
+    if (spill) {
+        RETURN_IF_ERROR(_spill_block_payload(state, input_block));
+    }
+
     mem_tracker()->consume(input_block->allocated_bytes());
     _blocks_memory_usage->add(input_block->allocated_bytes());
 
@@ -583,14 +625,16 @@ Status VAnalyticEvalNode::sink(doris::RuntimeState* /*state*/, vectorized::Block
     return Status::OK();
 }
 
-Status VAnalyticEvalNode::_insert_range_column(vectorized::Block* block, VExprContext* expr,
-                                               IColumn* dst_column, size_t length) {
-    int result_col_id = -1;
-    RETURN_IF_ERROR(expr->execute(block, &result_col_id));
-    DCHECK_GE(result_col_id, 0);
-    auto column = block->get_by_position(result_col_id).column->convert_to_full_column_if_const();
-    dst_column->insert_range_from(*column, 0, length);
-    return Status::OK();
+void VAnalyticEvalNode::_append_agg_inputs(const Block& block,
+                                           const std::vector<int>& column_ids) {
+    size_t idx = 0;
+    for (auto& columns : _agg_intput_columns) {
+        for (auto& column : columns) {
+            auto src = block.get_by_position(column_ids[idx++]).column;
+            column->insert_range_from(*src->convert_to_full_column_if_const(), 0, block.rows());
+        }
+    }
+    _agg_input_end_row += block.rows();
 }
 
 //calculate pos have arrive partition end, so it's needed to init next partition, and update the boundary of partition
@@ -601,6 +645,8 @@ bool VAnalyticEvalNode::_init_next_partition(BlockRowPos found_partition_end) {
         _partition_by_end = found_partition_end;
         _current_row_position = _partition_by_start.pos;
         _reset_agg_status();
+        _reset_sliding_frame();
+        _trim_agg_inputs();
         return true;
     }
     return false;
@@ -636,6 +682,7 @@ Status VAnalyticEvalNode::_output_current_block(Block* block) {
     block->swap(std::move(_input_blocks[_output_block_index]));
     _blocks_memory_usage->add(-block->allocated_bytes());
     mem_tracker()->consume(-block->allocated_bytes());
+    RETURN_IF_ERROR(_restore_block_payload(_output_block_index, block));
     if (_origin_cols.size() < block->columns()) {
         block->erase_not_in(_origin_cols);
     }
@@ -667,11 +714,396 @@ void VAnalyticEvalNode::_execute_for_win_func(int64_t partition_start, int64_t p
             _agg_columns.push_back(_agg_intput_columns[i][j].get());
         }
         _agg_functions[i]->function()->add_range_single_place(
-                partition_start, partition_end, frame_start, frame_end,
+                partition_start - _agg_input_first_row, partition_end - _agg_input_first_row,
+                frame_start - _agg_input_first_row, frame_end - _agg_input_first_row,
                 _fn_place_ptr + _offsets_of_aggregate_states[i], _agg_columns.data(), nullptr);
     }
 }
 
+void VAnalyticEvalNode::_init_sliding_strategies() {
+    _sliding_strategies.assign(_agg_functions_size, SlidingStrategy::RECOMPUTE);
+    _frame_not_null_rows.assign(_agg_functions_size, 0);
+    _segment_trees.resize(_agg_functions_size);
+    _segment_tree_arena = std::make_unique<Arena>();
+    if (_fn_scope != AnalyticFnScope::ROWS) {
+        return;
+    }
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        const auto& function = _agg_functions[i]->function();
+        if (function->supports_retract()) {
+            _sliding_strategies[i] = SlidingStrategy::INCREMENTAL;
+            continue;
+        }
+        auto name = function->get_name();
+        if (name != "min" && name != "max") {
+            continue;
+        }
+        if (!_window.__isset.window_start) {
+            // the start of the frame never moves, so nothing is retracted
+            _sliding_strategies[i] = SlidingStrategy::INCREMENTAL;
+        } else if (_rows_end_offset - _rows_start_offset + 1 >= SEGMENT_TREE_MIN_FRAME_ROWS) {
+            _sliding_strategies[i] = SlidingStrategy::SEGMENT_TREE;
+        }
+    }
+}
+
+// The frames of consecutive rows only move forward, so the INCREMENTAL aggregates add
+// [_frame_end, frame_end) and retract [_frame_start, frame_start) when the frames overlap.
+void VAnalyticEvalNode::_execute_for_sliding_frame(int64_t frame_start, int64_t frame_end) {
+    int64_t start = std::max<int64_t>(frame_start, _partition_by_start.pos);
+    int64_t end = std::max<int64_t>(std::min<int64_t>(frame_end, _partition_by_end.pos), start);
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        switch (_sliding_strategies[i]) {
+        case SlidingStrategy::INCREMENTAL:
+            _execute_incremental(i, start, end);
+            break;
+        case SlidingStrategy::SEGMENT_TREE:
+            _execute_by_segment_tree(i, start, end);
+            break;
+        case SlidingStrategy::RECOMPUTE: {
+            std::vector<const IColumn*> agg_columns;
+            for (int j = 0; j < _agg_intput_columns[i].size(); ++j) {
+                agg_columns.push_back(_agg_intput_columns[i][j].get());
+            }
+            // window functions like lead/lag need the frame before clamping
+            auto place = _fn_place_ptr + _offsets_of_aggregate_states[i];
+            _agg_functions[i]->reset(place);
+            _agg_functions[i]->function()->add_range_single_place(
+                    _partition_by_start.pos - _agg_input_first_row,
+                    _partition_by_end.pos - _agg_input_first_row,
+                    frame_start - _agg_input_first_row, frame_end - _agg_input_first_row, place,
+                    agg_columns.data(), nullptr);
+            break;
+        }
+        }
+    }
+    _frame_start = start;
+    _frame_end = end;
+}
+
+void VAnalyticEvalNode::_execute_incremental(size_t agg_idx, int64_t frame_start,
+                                             int64_t frame_end) {
+    DCHECK_GE(frame_start, _frame_start);
+    DCHECK_GE(frame_end, _frame_end);
+    std::vector<const IColumn*> agg_columns;
+    for (int j = 0; j < _agg_intput_columns[agg_idx].size(); ++j) {
+        agg_columns.push_back(_agg_intput_columns[agg_idx][j].get());
+    }
+    const auto& function = _agg_functions[agg_idx]->function();
+    auto place = _fn_place_ptr + _offsets_of_aggregate_states[agg_idx];
+    auto& not_null_rows = _frame_not_null_rows[agg_idx];
+
+    int64_t add_start = _frame_end;
+    if (_frame_start >= _frame_end || frame_start >= _frame_end) {
+        // the previous frame is empty or disjoint with this one
+        _agg_functions[agg_idx]->reset(place);
+        not_null_rows = 0;
+        add_start = frame_start;
+    } else {
+        for (int64_t row = _frame_start; row < frame_start; ++row) {
+            function->retract(place, agg_columns.data(), row - _agg_input_first_row, nullptr);
+            not_null_rows -= _is_not_null_row(agg_idx, row);
+        }
+        if (not_null_rows == 0) {
+            // so that a nullable result is NULL again
+            _agg_functions[agg_idx]->reset(place);
+        }
+    }
+    for (int64_t row = add_start; row < frame_end; ++row) {
+        function->add(place, agg_columns.data(), row - _agg_input_first_row, nullptr);
+        not_null_rows += _is_not_null_row(agg_idx, row);
+    }
+}
+
+bool VAnalyticEvalNode::_is_not_null_row(size_t agg_idx, int64_t row) const {
+    for (const auto& column : _agg_intput_columns[agg_idx]) {
+        if (column->is_nullable() && column->is_null_at(row - _agg_input_first_row)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VAnalyticEvalNode::_build_segment_tree(size_t agg_idx) {
+    std::vector<const IColumn*> agg_columns;
+    for (int j = 0; j < _agg_intput_columns[agg_idx].size(); ++j) {
+        agg_columns.push_back(_agg_intput_columns[agg_idx][j].get());
+    }
+    const auto& function = _agg_functions[agg_idx]->function();
+    size_t align = function->align_of_data();
+    size_t stride = (function->size_of_data() + align - 1) / align * align;
+    int64_t rows = _partition_by_end.pos - _partition_by_start.pos;
+    auto data = _segment_tree_arena->aligned_alloc(stride * 2 * rows, align);
+
+    auto& tree = _segment_trees[agg_idx];
+    tree.assign(2 * rows, nullptr);
+    for (int64_t i = 0; i < rows; ++i) {
+        tree[rows + i] = data + stride * (rows + i);
+        function->create(tree[rows + i]);
+        function->add(tree[rows + i], agg_columns.data(),
+                      _partition_by_start.pos - _agg_input_first_row + i, nullptr);
+    }
+    for (int64_t i = rows - 1; i > 0; --i) {
+        tree[i] = data + stride * i;
+        function->create(tree[i]);
+        function->merge(tree[i], tree[2 * i], _segment_tree_arena.get());
+        function->merge(tree[i], tree[2 * i + 1], _segment_tree_arena.get());
+    }
+    // the states may allocate from the arena too, so charge its whole size
+    int64_t arena_bytes = _segment_tree_arena->size();
+    mem_tracker()->consume(arena_bytes - _segment_tree_memory_usage->current_value());
+    _segment_tree_memory_usage->set(arena_bytes);
+}
+
+void VAnalyticEvalNode::_execute_by_segment_tree(size_t agg_idx, int64_t frame_start,
+                                                 int64_t frame_end) {
+    auto& tree = _segment_trees[agg_idx];
+    if (tree.empty() && frame_start < frame_end) {
+        _build_segment_tree(agg_idx);
+    }
+    const auto& function = _agg_functions[agg_idx]->function();
+    auto place = _fn_place_ptr + _offsets_of_aggregate_states[agg_idx];
+    _agg_functions[agg_idx]->reset(place);
+    int64_t rows = tree.size() / 2;
+    int64_t left = frame_start - _partition_by_start.pos + rows;
+    int64_t right = frame_end - _partition_by_start.pos + rows;
+    // min and max are commutative, so the nodes are merged in any order
+    for (; left < right; left >>= 1, right >>= 1) {
+        if (left & 1) {
+            function->merge(place, tree[left++], _agg_arena_pool.get());
+        }
+        if (right & 1) {
+            function->merge(place, tree[--right], _agg_arena_pool.get());
+        }
+    }
+}
+
+void VAnalyticEvalNode::_reset_sliding_frame() {
+    _frame_start = _partition_by_start.pos;
+    _frame_end = _partition_by_start.pos;
+    std::fill(_frame_not_null_rows.begin(), _frame_not_null_rows.end(), 0);
+    bool has_tree = false;
+    for (size_t i = 0; i < _segment_trees.size(); ++i) {
+        auto& tree = _segment_trees[i];
+        if (tree.empty()) {
+            continue;
+        }
+        has_tree = true;
+        const auto& function = _agg_functions[i]->function();
+        if (!function->has_trivial_destructor()) {
+            for (size_t j = 1; j < tree.size(); ++j) {
+                function->destroy(tree[j]);
+            }
+        }
+        tree.clear();
+    }
+    if (has_tree) {
+        _segment_tree_arena = std::make_unique<Arena>();
+        mem_tracker()->consume(-_segment_tree_memory_usage->current_value());
+        _segment_tree_memory_usage->set(int64_t(0));
+    }
+}
+
+Status VAnalyticEvalNode::_spill_to_queue(RuntimeState* state, SpillQueue& queue,
+                                          const Block& block) {
+    if (queue.writer && queue.writer_blocks >= MAX_SPILL_BLOCKS_PER_STREAM) {
+        RETURN_IF_ERROR(queue.writer->close());
+        queue.writer.reset();
+    }
+    if (!queue.writer) {
+        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
+                state->batch_size(), queue.writer, _block_spill_profile));
+        queue.writer_blocks = 0;
+    }
+    // the sub blocks are appended to the file by the spill I/O pool
+    RETURN_IF_ERROR(queue.writer->write(block));
+    queue.blocks.emplace_back(queue.writer->get_id(), block.rows());
+    ++queue.writer_blocks;
+    return Status::OK();
+}
+
+// Reads back the oldest block of the queue, which may be split into several sub blocks.
+Status VAnalyticEvalNode::_read_from_queue(SpillQueue& queue, MutableBlock* block) {
+    DCHECK(!queue.blocks.empty());
+    auto [stream_id, rows] = queue.blocks.front();
+    queue.blocks.pop_front();
+    if (queue.writer && queue.writer->get_id() == stream_id) {
+        // the next blocks go to a new stream
+        RETURN_IF_ERROR(queue.writer->close());
+        queue.writer.reset();
+    }
+    if (!queue.reader) {
+        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
+                stream_id, queue.reader, _block_spill_profile));
+    }
+    DCHECK_EQ(queue.reader->get_id(), stream_id);
+    while (block->rows() < rows) {
+        Block sub_block;
+        bool eos = false;
+        RETURN_IF_ERROR(queue.reader->read(&sub_block, &eos));
+        if (eos) {
+            return Status::InternalError("spilled analytic stream {} ended before {} rows",
+                                         stream_id, rows);
+        }
+        RETURN_IF_ERROR(block->merge(sub_block));
+    }
+    if (queue.blocks.empty() || queue.blocks.front().first != stream_id) {
+        // closing the reader removes the stream
+        RETURN_IF_ERROR(queue.reader->close());
+        queue.reader.reset();
+    }
+    return Status::OK();
+}
+
+// The blocks never read back, e.g. on cancel or limit, are left on disk otherwise.
+// Closing a reader of the stream deletes its file, BlockSpillManager::remove only forgets it.
+void VAnalyticEvalNode::_remove_spill_queue(SpillQueue& queue) {
+    auto* spill_mgr = ExecEnv::GetInstance()->block_spill_mgr();
+    Status st;
+    if (queue.writer) {
+        st = queue.writer->close();
+        queue.writer.reset();
+    }
+    int64_t last_stream_id = -1;
+    if (queue.reader) {
+        last_stream_id = queue.reader->get_id();
+        st = queue.reader->close();
+        queue.reader.reset();
+    }
+    for (const auto& [stream_id, rows] : queue.blocks) {
+        if (stream_id == last_stream_id) {
+            continue;
+        }
+        last_stream_id = stream_id;
+        BlockSpillReaderUPtr reader;
+        st = spill_mgr->get_reader(stream_id, reader, _block_spill_profile);
+        if (st.ok()) {
+            st = reader->close();
+        } else {
+            spill_mgr->remove(stream_id);
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to remove spilled analytic stream " << stream_id << ": "
+                         << st;
+        }
+    }
+    queue.blocks.clear();
+}
+
+void VAnalyticEvalNode::_remove_spilled_blocks() {
+    _remove_spill_queue(_payload_spill_queue);
+    _remove_spill_queue(_agg_input_spill_queue);
+}
+
+// Only the partition and order by keys are needed to find the boundaries of partitions and
+// peer groups. The other columns of the child are spilled and replaced by const columns
+// until the block is output, the results of the other expressions are not output and are
+// just replaced.
+Status VAnalyticEvalNode::_spill_block_payload(RuntimeState* state, Block* block) {
+    size_t rows = block->rows();
+    auto is_key = [&](int64_t c) {
+        return std::find(_partition_by_column_idxs.begin(), _partition_by_column_idxs.end(),
+                         c) != _partition_by_column_idxs.end() ||
+               std::find(_ordey_by_column_idxs.begin(), _ordey_by_column_idxs.end(), c) !=
+                       _ordey_by_column_idxs.end();
+    };
+    if (_spilled_column_idxs.empty()) {
+        for (auto c : _origin_cols) {
+            if (!is_key(c)) {
+                _spilled_column_idxs.emplace_back(c);
+            }
+        }
+    }
+    if (rows == 0) {
+        return Status::OK();
+    }
+    for (size_t c = _origin_cols.size(); c < block->columns(); ++c) {
+        auto& column = block->get_by_position(c).column;
+        if (!is_key(c) && !is_column_const(*column)) {
+            column = ColumnConst::create(column->clone_resized(1), rows);
+        }
+    }
+    if (_spilled_column_idxs.empty()) {
+        _spilled_payloads.back() = false;
+        return Status::OK();
+    }
+
+    Block payload;
+    for (auto idx : _spilled_column_idxs) {
+        auto& column = block->get_by_position(idx);
+        column.column = column.column->convert_to_full_column_if_const();
+        payload.insert(column);
+        column.column = ColumnConst::create(column.column->clone_resized(1), rows);
+    }
+    RETURN_IF_ERROR(_spill_to_queue(state, _payload_spill_queue, payload));
+    COUNTER_UPDATE(_spill_block_count, 1);
+    COUNTER_UPDATE(_spill_rows, rows);
+    return Status::OK();
+}
+
+Status VAnalyticEvalNode::_restore_block_payload(size_t block_idx, Block* block) {
+    if (!_spilled_payloads[block_idx]) {
+        return Status::OK();
+    }
+    MutableBlock payload;
+    RETURN_IF_ERROR(_read_from_queue(_payload_spill_queue, &payload));
+    DCHECK_EQ(payload.rows(), block->rows());
+    auto& columns = payload.mutable_columns();
+    for (size_t i = 0; i < _spilled_column_idxs.size(); ++i) {
+        block->get_by_position(_spilled_column_idxs[i]).column = std::move(columns[i]);
+    }
+    return Status::OK();
+}
+
+Status VAnalyticEvalNode::_spill_agg_inputs(RuntimeState* state, const Block& block,
+                                           const std::vector<int>& column_ids) {
+    Block agg_inputs;
+    for (auto id : column_ids) {
+        const auto& column = block.get_by_position(id);
+        agg_inputs.insert(
+                {column.column->convert_to_full_column_if_const(), column.type, column.name});
+    }
+    return _spill_to_queue(state, _agg_input_spill_queue, agg_inputs);
+}
+
+// Reads back the spilled arguments of the aggregates until the rows before `end` are in
+// _agg_intput_columns.
+Status VAnalyticEvalNode::_restore_agg_inputs(int64_t end) {
+    while (_agg_input_end_row < end && !_agg_input_spill_queue.blocks.empty()) {
+        MutableBlock agg_inputs;
+        RETURN_IF_ERROR(_read_from_queue(_agg_input_spill_queue, &agg_inputs));
+        auto rows = agg_inputs.rows();
+        auto& src_columns = agg_inputs.mutable_columns();
+        size_t idx = 0;
+        for (auto& columns : _agg_intput_columns) {
+            for (auto& column : columns) {
+                column->insert_range_from(*src_columns[idx++], 0, rows);
+            }
+        }
+        _agg_input_end_row += rows;
+    }
+    return Status::OK();
+}
+
+// The rows before the current partition are never aggregated again. Trimming copies the
+// rows left, so it waits until at least half of the rows can be dropped.
+void VAnalyticEvalNode::_trim_agg_inputs() {
+    int64_t rows = _agg_input_end_row - _agg_input_first_row;
+    int64_t dropped_rows =
+            std::min(_partition_by_start.pos, _agg_input_end_row) - _agg_input_first_row;
+    if (dropped_rows <= 0 || dropped_rows * 2 < rows) {
+        return;
+    }
+    for (auto& columns : _agg_intput_columns) {
+        for (auto& column : columns) {
+            auto trimmed = column->clone_empty();
+            trimmed->insert_range_from(*column, dropped_rows, rows - dropped_rows);
+            column = std::move(trimmed);
+        }
+    }
+    _agg_input_first_row += dropped_rows;
+}
+
 //binary search for range to calculate peer group
 void VAnalyticEvalNode::_update_order_by_range() {
     _order_by_start = _order_by_end;
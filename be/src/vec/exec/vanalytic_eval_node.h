@@ -20,11 +20,14 @@
 #include <thrift/protocol/TDebugProtocol.h>
 
 #include <atomic>
+#include <deque>
 #include <string>
 
 #include "exec/exec_node.h"
 #include "vec/common/arena.h"
 #include "vec/core/block.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/exprs/vectorized_agg_fn.h"
 #include "vec/exprs/vexpr_context.h"
 namespace doris::vectorized {
@@ -75,12 +78,54 @@ private:
     void _execute_for_win_func(int64_t partition_start, int64_t partition_end, int64_t frame_start,
                                int64_t frame_end);
 
+    // How an aggregate is updated when a ROWS frame with a bounded side moves to the next row.
+    enum class SlidingStrategy {
+        // reset the state and aggregate the whole frame again
+        RECOMPUTE,
+        // add the rows entering the frame and retract the rows leaving it
+        INCREMENTAL,
+        // merge the states of O(log n) nodes of a segment tree built over the partition
+        SEGMENT_TREE,
+    };
+    // the minimum frame size for which min/max use a segment tree instead of RECOMPUTE
+    static constexpr int64_t SEGMENT_TREE_MIN_FRAME_ROWS = 32;
+
+    void _init_sliding_strategies();
+    void _execute_for_sliding_frame(int64_t frame_start, int64_t frame_end);
+    void _execute_incremental(size_t agg_idx, int64_t frame_start, int64_t frame_end);
+    void _execute_by_segment_tree(size_t agg_idx, int64_t frame_start, int64_t frame_end);
+    void _build_segment_tree(size_t agg_idx);
+    void _reset_sliding_frame();
+    bool _is_not_null_row(size_t agg_idx, int64_t row) const;
+
+    // Blocks spilled one after another, up to MAX_SPILL_BLOCKS_PER_STREAM to a stream, and
+    // read back in the same order.
+    struct SpillQueue {
+        BlockSpillWriterUPtr writer;
+        size_t writer_blocks = 0;
+        BlockSpillReaderUPtr reader;
+        // stream id and rows of the blocks not read back yet
+        std::deque<std::pair<int64_t, size_t>> blocks;
+    };
+    static constexpr size_t MAX_SPILL_BLOCKS_PER_STREAM = 16;
+
+    Status _spill_to_queue(RuntimeState* state, SpillQueue& queue, const Block& block);
+    Status _read_from_queue(SpillQueue& queue, MutableBlock* block);
+    void _remove_spill_queue(SpillQueue& queue);
+
+    Status _spill_block_payload(RuntimeState* state, Block* block);
+    Status _restore_block_payload(size_t block_idx, Block* block);
+    void _append_agg_inputs(const Block& block, const std::vector<int>& column_ids);
+    Status _spill_agg_inputs(RuntimeState* state, const Block& block,
+                             const std::vector<int>& column_ids);
+    Status _restore_agg_inputs(int64_t end);
+    void _trim_agg_inputs();
+    void _remove_spilled_blocks();
+
     Status _reset_agg_status();
     Status _init_result_columns();
     Status _create_agg_status();
     Status _destroy_agg_status();
-    Status _insert_range_column(vectorized::Block* block, VExprContext* expr, IColumn* dst_column,
-                                size_t length);
 
     void _update_order_by_range();
     bool _init_next_partition(BlockRowPos found_partition_end);
@@ -120,7 +165,11 @@ private:
     std::vector<std::vector<VExprContext*>> _agg_expr_ctxs;
     std::vector<VExprContext*> _partition_by_eq_expr_ctxs;
     std::vector<VExprContext*> _order_by_eq_expr_ctxs;
+    // the arguments of the aggregates for the rows [_agg_input_first_row, _agg_input_end_row)
+    // of the input, the rows of the finished partitions are trimmed
     std::vector<std::vector<MutableColumnPtr>> _agg_intput_columns;
+    int64_t _agg_input_first_row = 0;
+    int64_t _agg_input_end_row = 0;
     std::vector<MutableColumnPtr> _result_window_columns;
 
     BlockRowPos _order_by_start;
@@ -161,6 +210,31 @@ private:
     TupleDescriptor* _output_tuple_desc;
     std::vector<int64_t> _origin_cols;
 
+    std::vector<SlidingStrategy> _sliding_strategies;
+    // the frame [start, end) currently aggregated by the INCREMENTAL aggregates
+    int64_t _frame_start = 0;
+    int64_t _frame_end = 0;
+    // number of rows of the frame whose arguments are all not NULL, per aggregate
+    std::vector<int64_t> _frame_not_null_rows;
+    // Bottom-up segment trees over the current partition, per SEGMENT_TREE aggregate.
+    // Node i has the children 2i and 2i+1, leaf n + i holds row i of the partition.
+    std::vector<std::vector<AggregateDataPtr>> _segment_trees;
+    std::unique_ptr<Arena> _segment_tree_arena;
+    RuntimeProfile::HighWaterMarkCounter* _segment_tree_memory_usage = nullptr;
+
+    // When the buffered blocks exceed external_analytic_bytes_threshold, the columns of new
+    // blocks which are not partition or order by keys are spilled until the block is output,
+    // and the arguments of their aggregates until their partition is evaluated.
+    int64_t _external_analytic_bytes_threshold = 0;
+    // whether the payload of an input block is spilled
+    std::vector<bool> _spilled_payloads;
+    std::vector<int> _spilled_column_idxs;
+    SpillQueue _payload_spill_queue;
+    SpillQueue _agg_input_spill_queue;
+    RuntimeProfile* _block_spill_profile = nullptr;
+    RuntimeProfile::Counter* _spill_block_count = nullptr;
+    RuntimeProfile::Counter* _spill_rows = nullptr;
+
     RuntimeProfile::Counter* _evaluation_timer;
     RuntimeProfile::HighWaterMarkCounter* _blocks_memory_usage;
 
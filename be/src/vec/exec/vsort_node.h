@@ -57,6 +57,8 @@ public:
 
     Status sink(RuntimeState* state, vectorized::Block* input_block, bool eos) override;
 
+    bool can_sink_write() const { return _sorter->can_append_block(); }
+
 protected:
     void debug_string(int indentation_level, std::stringstream* out) const override;
 
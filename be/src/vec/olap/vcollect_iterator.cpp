@@ -176,7 +176,7 @@ bool VCollectIterator::LevelIteratorComparator::operator()(LevelIterator* lhs, L
                           ? lhs_ref.compare(rhs_ref, lhs->compare_columns())
                           : lhs_ref.compare(rhs_ref, lhs->tablet_schema().num_key_columns());
     if (cmp_res != 0) {
-        return UNLIKELY(_is_reverse) ? cmp_res < 0 : cmp_res > 0;
+        return UNLIKELY(_is_reverse) ? cmp_res > 0 : cmp_res < 0;
     }
 
     if (_sequence != -1) {
@@ -189,10 +189,10 @@ bool VCollectIterator::LevelIteratorComparator::operator()(LevelIterator* lhs, L
     // read data from higher version to lower version.
     // for UNIQUE_KEYS just read the highest version and no need agg_update.
     // for AGG_KEYS if a version is deleted, the lower version no need to agg_update
-    bool lower = (cmp_res != 0) ? (cmp_res < 0) : (lhs->version() < rhs->version());
-    lower ? lhs->set_same(true) : rhs->set_same(true);
+    bool before = (cmp_res != 0) ? (cmp_res > 0) : (lhs->version() > rhs->version());
+    before ? rhs->set_same(true) : lhs->set_same(true);
 
-    return lower;
+    return before;
 }
 
 Status VCollectIterator::current_row(IteratorRowRef* ref) const {
@@ -544,14 +544,8 @@ VCollectIterator::Level1Iterator::~Level1Iterator() {
         }
     }
 
-    if (_heap) {
-        while (!_heap->empty()) {
-            auto child = _heap->top();
-            _heap->pop();
-            if (child) {
-                delete child;
-            }
-        }
+    if (_merge_tree) {
+        _merge_tree->for_each_active([](LevelIterator* child) { delete child; });
     }
 }
 
@@ -609,18 +603,14 @@ Status VCollectIterator::Level1Iterator::init(bool get_data_by_ref) {
                 break;
             }
         }
-        _heap.reset(new MergeHeap {LevelIteratorComparator(sequence_loc, _is_reverse)});
-        for (auto child : _children) {
-            DCHECK(child != nullptr);
-            //DCHECK(child->current_row().ok());
-            _heap->push(child);
-        }
-        _cur_child = _heap->top();
+        _merge_tree.reset(new MergeTree(LevelIteratorComparator(sequence_loc, _is_reverse)));
+        _merge_tree->init(std::vector<LevelIterator*>(_children.begin(), _children.end()));
+        _cur_child = _merge_tree->top();
         // Clear _children earlier to release any related references
         _children.clear();
     } else {
         _merge = false;
-        _heap.reset(nullptr);
+        _merge_tree.reset(nullptr);
         _cur_child = *_children.begin();
     }
     _ref = *_cur_child->current_row_ref();
@@ -649,16 +639,17 @@ Status VCollectIterator::Level1Iterator::init_level0_iterators_for_union() {
 }
 
 Status VCollectIterator::Level1Iterator::_merge_next(IteratorRowRef* ref) {
-    _heap->pop();
     auto res = _cur_child->next(ref);
     if (LIKELY(res.ok())) {
-        _heap->push(_cur_child);
-        _cur_child = _heap->top();
+        // only the matches on the path of the current child are replayed
+        _merge_tree->update_top();
+        _cur_child = _merge_tree->top();
     } else if (res.is<END_OF_FILE>()) {
         // current child has been read, to read next
+        _merge_tree->remove_top();
         delete _cur_child;
-        if (!_heap->empty()) {
-            _cur_child = _heap->top();
+        if (!_merge_tree->empty()) {
+            _cur_child = _merge_tree->top();
         } else {
             _ref.reset();
             _cur_child = nullptr;
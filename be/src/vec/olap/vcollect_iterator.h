@@ -18,14 +18,9 @@
 #pragma once
 
 #include "common/status.h"
-#ifdef USE_LIBCPP
-#include <queue>
-#else
-#include <ext/pb_ds/priority_queue.hpp>
-#endif
-
 #include "olap/reader.h"
 #include "olap/rowset/rowset_reader.h"
+#include "util/loser_tree.h"
 #include "vec/core/block.h"
 
 namespace doris {
@@ -97,7 +92,7 @@ private:
     // This interface is the actual implementation of the new version of iterator.
     // It currently contains two implementations, one is Level0Iterator,
     // which only reads data from the rowset reader, and the other is Level1Iterator,
-    // which can read merged data from multiple LevelIterators through MergeHeap.
+    // which can read merged data from multiple LevelIterators through MergeTree.
     // By using Level1Iterator, some rowset readers can be merged in advance and
     // then merged with other rowset readers.
     class LevelIterator {
@@ -143,6 +138,7 @@ private:
 
     // Compare row cursors between multiple merge elements,
     // if row cursors equal, compare data version.
+    // Returns true if the row of lhs should be read before the row of rhs.
     class LevelIteratorComparator {
     public:
         LevelIteratorComparator(int sequence, bool is_reverse)
@@ -156,13 +152,7 @@ private:
         bool _is_reverse = false;
     };
 
-#ifdef USE_LIBCPP
-    using MergeHeap = std::priority_queue<LevelIterator*, std::vector<LevelIterator*>,
-                                          LevelIteratorComparator>;
-#else
-    using MergeHeap = __gnu_pbds::priority_queue<LevelIterator*, LevelIteratorComparator,
-                                                 __gnu_pbds::pairing_heap_tag>;
-#endif
+    using MergeTree = LoserTree<LevelIterator*, LevelIteratorComparator>;
 
     // Iterate from rowset reader. This Iterator usually like a leaf node
     class Level0Iterator : public LevelIterator {
@@ -280,14 +270,14 @@ private:
         Status _merge_next(Block* block);
 
         // Each LevelIterator corresponds to a rowset reader,
-        // it will be cleared after '_heap' has been initialized when '_merge == true'.
+        // it will be cleared after '_merge_tree' has been initialized when '_merge == true'.
         std::list<LevelIterator*> _children;
         // point to the Level0Iterator containing the next output row.
         // null when VCollectIterator hasn't been initialized or reaches EOF.
         LevelIterator* _cur_child = nullptr;
         TabletReader* _reader = nullptr;
 
-        // when `_merge == true`, rowset reader returns ordered rows and VCollectIterator uses a priority queue to merge
+        // when `_merge == true`, rowset reader returns ordered rows and VCollectIterator uses a loser tree to merge
         // sort them. The output of VCollectIterator is also ordered.
         // When `_merge == false`, rowset reader returns *partial* ordered rows. VCollectIterator simply returns all rows
         // from the first rowset, the second rowset, .., the last rowset. The output of CollectorIterator is also
@@ -298,7 +288,7 @@ private:
 
         bool _skip_same;
         // used when `_merge == true`
-        std::unique_ptr<MergeHeap> _heap;
+        std::unique_ptr<MergeTree> _merge_tree;
 
         std::vector<RowLocation> _block_row_locations;
     };
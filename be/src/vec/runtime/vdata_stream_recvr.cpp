@@ -18,8 +18,10 @@
 #include "vec/runtime/vdata_stream_recvr.h"
 
 #include "gen_cpp/data.pb.h"
+#include "pipeline/blocked_task_notifier.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/thread_context.h"
+#include "util/defer_op.h"
 #include "util/uid_util.h"
 #include "vec/core/block.h"
 #include "vec/core/materialize_block.h"
@@ -95,11 +97,35 @@ Status VDataStreamRecvr::SenderQueue::_inner_get_batch(Block* block, bool* eos)
         closure_pair.second.stop();
         _recvr->_buffer_full_total_timer->update(closure_pair.second.elapsed_time());
     }
-    block->swap(*next_block);
+    _take_block(std::move(next_block), block);
     *eos = false;
     return Status::OK();
 }
 
+bool SharedBlock::take(Block* block) {
+    // the other holders release their holds only after they are done with the columns, so
+    // once the count is down to 1 nobody else reads them
+    if (_num_holders.load(std::memory_order_acquire) == 1) {
+        block->swap(_block);
+        return false;
+    }
+    auto columns = _block.get_columns_with_type_and_name();
+    auto rows = _block.rows();
+    for (auto& column : columns) {
+        column.column = column.column->clone_resized(rows);
+    }
+    Block copy(columns);
+    block->swap(copy);
+    release();
+    return true;
+}
+
+void VDataStreamRecvr::SenderQueue::_take_block(SharedBlockSPtr shared, Block* block) {
+    if (shared->take(block)) {
+        COUNTER_UPDATE(_recvr->_local_blocks_copied_counter, 1);
+    }
+}
+
 void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_number,
                                               int64_t packet_seq,
                                               ::google::protobuf::Closure** done) {
@@ -146,6 +172,8 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
     auto block_byte_size = block->allocated_bytes();
     VLOG_ROW << "added #rows=" << block->rows() << " batch_size=" << block_byte_size << "\n";
 
+    // after _lock is released, the exchange source may be blocked in the pipeline
+    Defer notify {[] { pipeline::notify_blocked_tasks(); }};
     std::lock_guard<std::mutex> l(_lock);
     if (_is_cancelled) {
         return;
@@ -155,7 +183,7 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
     COUNTER_UPDATE(_recvr->_decompress_timer, block->get_decompress_time());
     COUNTER_UPDATE(_recvr->_decompress_bytes, block->get_decompressed_bytes());
 
-    _block_queue.emplace_back(std::move(block), block_byte_size);
+    _block_queue.emplace_back(std::make_shared<SharedBlock>(std::move(*block)), block_byte_size);
     _update_block_queue_empty();
     // if done is nullptr, this function can't delay this response
     if (done != nullptr && _recvr->exceeds_limit(block_byte_size)) {
@@ -169,41 +197,28 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
     _data_arrival_cv.notify_one();
 }
 
-void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
+void VDataStreamRecvr::SenderQueue::add_block(SharedBlockSPtr block) {
     // Avoid deadlock when calling SenderQueue::cancel() in tcmalloc hook,
     // limit memory via DataStreamRecvr::exceeds_limit.
     STOP_CHECK_THREAD_MEM_TRACKER_LIMIT();
     {
         std::unique_lock<std::mutex> l(_lock);
-        if (_is_cancelled || !block->rows()) {
+        if (_is_cancelled || !block->block().rows()) {
+            block->release();
             return;
         }
     }
 
-    auto block_bytes_received = block->bytes();
-    // Has to use unique ptr here, because clone column may failed if allocate memory failed.
-    BlockUPtr nblock = std::make_unique<Block>(block->get_columns_with_type_and_name());
-
-    // local exchange should copy the block contented if use move == false
-    if (use_move) {
-        block->clear();
-    } else {
-        auto rows = block->rows();
-        for (int i = 0; i < nblock->columns(); ++i) {
-            nblock->get_by_position(i).column =
-                    nblock->get_by_position(i).column->clone_resized(rows);
-        }
-    }
-    materialize_block_inplace(*nblock);
-
-    size_t block_mem_size = nblock->allocated_bytes();
+    auto block_bytes_received = block->block().bytes();
+    size_t block_mem_size = block->block().allocated_bytes();
     std::unique_lock<std::mutex> l(_lock);
     if (_is_cancelled) {
+        block->release();
         return;
     }
     COUNTER_UPDATE(_recvr->_local_bytes_received_counter, block_bytes_received);
 
-    _block_queue.emplace_back(std::move(nblock), block_mem_size);
+    _block_queue.emplace_back(std::move(block), block_mem_size);
     _update_block_queue_empty();
     _data_arrival_cv.notify_one();
 
@@ -226,6 +241,7 @@ void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
 }
 
 void VDataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
+    Defer notify {[] { pipeline::notify_blocked_tasks(); }};
     std::lock_guard<std::mutex> l(_lock);
     if (_sender_eos_set.end() != _sender_eos_set.find(be_number)) {
         return;
@@ -253,6 +269,7 @@ void VDataStreamRecvr::SenderQueue::cancel() {
     // Wake up all threads waiting to produce/consume batches.  They will all
     // notice that the stream is cancelled and handle it.
     _data_arrival_cv.notify_all();
+    pipeline::notify_blocked_tasks();
     // _data_removal_cv.notify_all();
     // PeriodicCounterUpdater::StopTimeSeriesCounter(
     //         _recvr->_bytes_received_time_series_counter);
@@ -281,6 +298,9 @@ void VDataStreamRecvr::SenderQueue::close() {
     }
 
     // Delete any batches queued in _block_queue
+    for (auto& queued_block : _block_queue) {
+        queued_block.first->release();
+    }
     _block_queue.clear();
 }
 
@@ -328,6 +348,7 @@ VDataStreamRecvr::VDataStreamRecvr(
     _blocks_memory_usage = memory_usage->AddHighWaterMarkCounter("Blocks", TUnit::BYTES);
     _bytes_received_counter = ADD_COUNTER(_profile, "BytesReceived", TUnit::BYTES);
     _local_bytes_received_counter = ADD_COUNTER(_profile, "LocalBytesReceived", TUnit::BYTES);
+    _local_blocks_copied_counter = ADD_COUNTER(_profile, "LocalBlocksCopied", TUnit::UNIT);
 
     _deserialize_row_batch_timer = ADD_TIMER(_profile, "DeserializeRowBatchTimer");
     _data_arrival_timer = ADD_TIMER(_profile, "DataArrivalWaitTime");
@@ -368,14 +389,14 @@ void VDataStreamRecvr::add_block(const PBlock& pblock, int sender_id, int be_num
     _sender_queues[use_sender_id]->add_block(pblock, be_number, packet_seq, done);
 }
 
-void VDataStreamRecvr::add_block(Block* block, int sender_id, bool use_move) {
+void VDataStreamRecvr::add_block(SharedBlockSPtr block, int sender_id) {
     int use_sender_id = _is_merging ? sender_id : 0;
-    _sender_queues[use_sender_id]->add_block(block, use_move);
+    _sender_queues[use_sender_id]->add_block(std::move(block));
 }
 
-bool VDataStreamRecvr::sender_queue_empty(int sender_id) {
+bool VDataStreamRecvr::sender_queue_full(int sender_id) {
     int use_sender_id = _is_merging ? sender_id : 0;
-    return _sender_queues[use_sender_id]->queue_empty();
+    return _sender_queues[use_sender_id]->queue_full();
 }
 
 bool VDataStreamRecvr::ready_to_read() {
@@ -27,8 +27,10 @@
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "gen_cpp/Types_types.h"
+#include "pipeline/blocked_task_notifier.h"
 #include "runtime/descriptors.h"
 #include "runtime/query_statistics.h"
+#include "util/mpmc_ring.h"
 #include "util/runtime_profile.h"
 #include "vec/core/materialize_block.h"
 
@@ -49,6 +51,32 @@ class VDataStreamMgr;
 class VSortedRunMerger;
 class VExprContext;
 
+// A block queued in a receiver. The block a local sender broadcasts is not copied for every
+// local receiver: `num_holders` counts the receivers that may still read it, each of them
+// releases its hold once it is done with the block and the last one moves the columns out
+// instead of copying them.
+class SharedBlock {
+public:
+    explicit SharedBlock(Block&& block, int num_holders = 1) : _num_holders(num_holders) {
+        _block.swap(block);
+    }
+
+    const Block& block() const { return _block; }
+
+    // Moves the columns to `block` if the caller is the last holder, copies them otherwise.
+    // Returns true if the columns were copied.
+    bool take(Block* block);
+
+    // Gives up the hold of a receiver which drops the block without taking it.
+    void release() { _num_holders.fetch_sub(1, std::memory_order_release); }
+
+private:
+    Block _block;
+    std::atomic_int _num_holders;
+};
+
+using SharedBlockSPtr = std::shared_ptr<SharedBlock>;
+
 class VDataStreamRecvr {
 public:
     VDataStreamRecvr(VDataStreamMgr* stream_mgr, RuntimeState* state, const RowDescriptor& row_desc,
@@ -66,9 +94,13 @@ public:
     void add_block(const PBlock& pblock, int sender_id, int be_number, int64_t packet_seq,
                    ::google::protobuf::Closure** done);
 
-    void add_block(Block* block, int sender_id, bool use_move);
+    // Adds a block from a sender on this BE. The block is not copied and may be shared by
+    // the receivers of a broadcast, the columns are copied only when a receiver takes it
+    // while the others still hold it.
+    void add_block(SharedBlockSPtr block, int sender_id);
 
-    bool sender_queue_empty(int sender_id);
+    // True if a local sender should wait before adding more blocks.
+    bool sender_queue_full(int sender_id);
 
     bool ready_to_read();
 
@@ -133,6 +165,7 @@ private:
 
     RuntimeProfile::Counter* _bytes_received_counter;
     RuntimeProfile::Counter* _local_bytes_received_counter;
+    RuntimeProfile::Counter* _local_blocks_copied_counter;
     RuntimeProfile::Counter* _deserialize_row_batch_timer;
     RuntimeProfile::Counter* _first_batch_wait_total_timer;
     RuntimeProfile::Counter* _buffer_full_total_timer;
@@ -168,19 +201,23 @@ public:
     void add_block(const PBlock& pblock, int be_number, int64_t packet_seq,
                    ::google::protobuf::Closure** done);
 
-    virtual void add_block(Block* block, bool use_move);
+    virtual void add_block(SharedBlockSPtr block);
 
     void decrement_senders(int sender_id);
 
     void cancel();
 
-    void close();
+    virtual void close();
 
-    bool queue_empty() { return _block_queue_empty; }
+    // Senders are blocked in add_block() instead.
+    virtual bool queue_full() { return false; }
 
 protected:
     virtual void _update_block_queue_empty() {}
     Status _inner_get_batch(Block* block, bool* eos);
+    // Moves the columns of `shared` to `block` if no other receiver holds it, copies them
+    // otherwise.
+    void _take_block(SharedBlockSPtr shared, Block* block);
 
     // Not managed by this class
     VDataStreamRecvr* _recvr;
@@ -189,7 +226,7 @@ protected:
     std::atomic_int _num_remaining_senders;
     std::condition_variable _data_arrival_cv;
     std::condition_variable _data_removal_cv;
-    std::list<std::pair<BlockUPtr, size_t>> _block_queue;
+    std::list<std::pair<SharedBlockSPtr, size_t>> _block_queue;
     std::atomic_bool _block_queue_empty = true;
 
     bool _received_first_batch;
@@ -204,10 +241,12 @@ protected:
 class VDataStreamRecvr::PipSenderQueue : public SenderQueue {
 public:
     PipSenderQueue(VDataStreamRecvr* parent_recvr, int num_senders, RuntimeProfile* profile)
-            : SenderQueue(parent_recvr, num_senders, profile) {}
+            : SenderQueue(parent_recvr, num_senders, profile),
+              _local_ring(config::exchg_node_local_queue_capacity) {}
 
     bool should_wait() override {
-        return !_is_cancelled && _block_queue_empty && _num_remaining_senders > 0;
+        return !_is_cancelled && _block_queue_empty && _local_ring.empty() &&
+               _num_remaining_senders > 0;
     }
 
     void _update_block_queue_empty() override { _block_queue_empty = _block_queue.empty(); }
@@ -216,42 +255,66 @@ public:
         CHECK(!should_wait()) << " _is_cancelled: " << _is_cancelled
                               << ", _block_queue_empty: " << _block_queue_empty
                               << ", _num_remaining_senders: " << _num_remaining_senders;
+        if (_is_cancelled) {
+            return Status::Cancelled("Cancelled");
+        }
+        // the local senders add their blocks before they are removed, so the ring can not
+        // get new blocks once should_wait() has seen no remaining senders. The blocks in the
+        // ring are older than those in _block_queue, see add_block().
+        std::pair<SharedBlockSPtr, size_t> local_block;
+        if (_local_ring.try_pop(&local_block)) {
+            _received_first_batch = true;
+            _recvr->_blocks_memory_usage->add(-local_block.second);
+            _take_block(std::move(local_block.first), block);
+            // the local senders blocked on queue_full() may go on
+            pipeline::notify_blocked_tasks();
+            *eos = false;
+            return Status::OK();
+        }
         std::lock_guard<std::mutex> l(_lock); // protect _block_queue
         return _inner_get_batch(block, eos);
     }
 
-    void add_block(Block* block, bool use_move) override {
+    // The local senders wait for queue_full() to turn false in the pipeline instead of
+    // blocking here, so a block only goes to _block_queue when several senders raced for
+    // the last free slot.
+    // get_batch() reads the ring first, so once a block went to _block_queue the later
+    // blocks go there as well until it is drained, which keeps the blocks of a sender in
+    // order.
+    void add_block(SharedBlockSPtr block) override {
         // Avoid deadlock when calling SenderQueue::cancel() in tcmalloc hook,
         // limit memory via DataStreamRecvr::exceeds_limit.
         STOP_CHECK_THREAD_MEM_TRACKER_LIMIT();
 
-        if (_is_cancelled || !block->rows()) {
+        if (_is_cancelled || !block->block().rows()) {
+            block->release();
             return;
         }
-        BlockUPtr nblock = std::make_unique<Block>(block->get_columns_with_type_and_name());
-
-        // local exchange should copy the block contented if use move == false
-        if (use_move) {
-            block->clear();
-        } else {
-            auto rows = block->rows();
-            for (int i = 0; i < nblock->columns(); ++i) {
-                nblock->get_by_position(i).column =
-                        nblock->get_by_position(i).column->clone_resized(rows);
-            }
-        }
-        materialize_block_inplace(*nblock);
-
-        auto block_mem_size = nblock->allocated_bytes();
-        {
-            std::unique_lock<std::mutex> l(_lock);
-            _block_queue.emplace_back(std::move(nblock), block_mem_size);
-        }
+        auto block_mem_size = block->block().allocated_bytes();
         COUNTER_UPDATE(_recvr->_local_bytes_received_counter, block_mem_size);
         _recvr->_blocks_memory_usage->add(block_mem_size);
-        _update_block_queue_empty();
+        std::pair<SharedBlockSPtr, size_t> local_block(std::move(block), block_mem_size);
+        if (!_block_queue_empty || !_local_ring.try_push(std::move(local_block))) {
+            std::unique_lock<std::mutex> l(_lock);
+            _block_queue.emplace_back(std::move(local_block));
+            _update_block_queue_empty();
+        }
         _data_arrival_cv.notify_one();
+        pipeline::notify_blocked_tasks();
     }
+
+    void close() override {
+        SenderQueue::close();
+        std::pair<SharedBlockSPtr, size_t> local_block;
+        while (_local_ring.try_pop(&local_block)) {
+            local_block.first->release();
+        }
+    }
+
+    bool queue_full() override { return _local_ring.full(); }
+
+private:
+    MPMCRing<std::pair<SharedBlockSPtr, size_t>> _local_ring;
 };
 } // namespace vectorized
 } // namespace doris
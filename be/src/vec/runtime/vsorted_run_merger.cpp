@@ -67,11 +67,13 @@ Status VSortedRunMerger::prepare(const vector<BlockSupplier>& input_runs) {
         }
     }
 
+    std::vector<MergeSortCursor> runs;
     for (auto& _cursor : _cursors) {
         if (!_cursor._is_eof) {
-            _priority_queue.push(MergeSortCursor(&_cursor));
+            runs.emplace_back(&_cursor);
         }
     }
+    _merge_tree.init(std::move(runs));
 
     for (const auto& cursor : _cursors) {
         if (!cursor._is_eof) {
@@ -88,8 +90,8 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
     // Only have one receive data queue of data, no need to do merge and
     // copy the data of block.
     // return the data in receive data directly
-    if (_priority_queue.size() == 1) {
-        auto current = _priority_queue.top();
+    if (_merge_tree.size() == 1) {
+        auto current = _merge_tree.top();
         while (_offset != 0 && current->block_ptr() != nullptr) {
             if (_offset >= current->rows - current->pos) {
                 _offset -= (current->rows - current->pos);
@@ -126,21 +128,30 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
         MutableColumns merged_columns =
                 mem_reuse ? output_block->mutate_columns() : _empty_block.clone_empty_columns();
 
-        /// Take rows from queue in right order and push to 'merged'.
+        /// Take rows from tree in right order and push to 'merged'.
         size_t merged_rows = 0;
-        while (!_priority_queue.empty()) {
-            auto current = _priority_queue.top();
-            _priority_queue.pop();
-
-            if (_offset > 0) {
-                _offset--;
-            } else {
-                for (size_t i = 0; i < num_columns; ++i)
-                    merged_columns[i]->insert_from(*current->all_columns[i], current->pos);
-                ++merged_rows;
+        while (!_merge_tree.empty() && merged_rows < _batch_size) {
+            auto current = _merge_tree.top();
+            // look for more rows only when the run seems to win for a while, as it costs
+            // log2(k) comparisons to find the runner up
+            size_t run_rows = 1;
+            if (current.impl == _last_run) {
+                run_rows = rows_before_runner_up(current, _batch_size - merged_rows);
             }
+            _last_run = current.impl;
+
+            size_t skip_rows = std::min(_offset, run_rows);
+            _offset -= skip_rows;
+            if (run_rows > skip_rows) {
+                for (size_t i = 0; i < num_columns; ++i) {
+                    merged_columns[i]->insert_range_from(*current->all_columns[i],
+                                                         current->pos + skip_rows,
+                                                         run_rows - skip_rows);
+                }
+                merged_rows += run_rows - skip_rows;
+            }
+            current->pos += run_rows - 1;
             next_heap(current);
-            if (merged_rows == _batch_size) break;
         }
 
         if (merged_rows == 0) {
@@ -165,10 +176,25 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
 void VSortedRunMerger::next_heap(MergeSortCursor& current) {
     if (!current->isLast()) {
         current->next();
-        _priority_queue.push(current);
+        _merge_tree.update_top();
     } else if (has_next_block(current)) {
-        _priority_queue.push(current);
+        _merge_tree.update_top();
+    } else {
+        _merge_tree.remove_top();
+    }
+}
+
+size_t VSortedRunMerger::rows_before_runner_up(MergeSortCursor& current, size_t max_rows) {
+    size_t end = std::min(current->rows, current->pos + max_rows);
+    MergeSortCursor* runner_up = _merge_tree.runner_up();
+    if (runner_up == nullptr) {
+        return end - current->pos;
+    }
+    size_t pos = current->pos + 1;
+    while (pos < end && current.greater_at(*runner_up, pos, (*runner_up)->pos) <= 0) {
+        ++pos;
     }
+    return pos - current->pos;
 }
 
 inline bool VSortedRunMerger::has_next_block(doris::vectorized::MergeSortCursor& current) {
@@ -17,8 +17,7 @@
 
 #pragma once
 
-#include <queue>
-
+#include "util/loser_tree.h"
 #include "vec/core/sort_cursor.h"
 
 namespace doris {
@@ -29,8 +28,9 @@ namespace vectorized {
 class Block;
 // VSortedRunMerger is used to merge multiple sorted runs of blocks. A run is a sorted
 // sequence of blocks, which are fetched from a BlockSupplier function object.
-// Merging is implemented using a binary min-heap that maintains the run with the next
-// rows in sorted order at the top of the heap.
+// Merging is implemented using a loser tree that maintains the run with the next
+// rows in sorted order at the top of the tree. When the same run wins twice in a row,
+// its rows up to the next row of the other runs are copied at once.
 //
 // Merged block of rows are retrieved from VSortedRunMerger via calls to get_next().
 class VSortedRunMerger {
@@ -49,8 +49,7 @@ public:
     virtual ~VSortedRunMerger() = default;
 
     // Prepare this merger to merge and return rows from the sorted runs in 'input_runs'.
-    // Retrieves the first batch from each run and sets up the binary heap implementing
-    // the priority queue.
+    // Retrieves the first batch from each run and sets up the loser tree.
     Status prepare(const std::vector<BlockSupplier>& input_runs);
 
     // Return the next block of sorted rows from this merger.
@@ -68,8 +67,16 @@ protected:
     int64_t _limit = -1;
     size_t _offset = 0;
 
+    struct MergeSortCursorLess {
+        bool operator()(const MergeSortCursor& lhs, const MergeSortCursor& rhs) const {
+            return rhs.greater(lhs);
+        }
+    };
+
     std::vector<BlockSupplierSortCursorImpl> _cursors;
-    std::priority_queue<MergeSortCursor> _priority_queue;
+    LoserTree<MergeSortCursor, MergeSortCursorLess> _merge_tree;
+    // the run of the last row taken from the tree
+    MergeSortCursorImpl* _last_run = nullptr;
 
     Block _empty_block;
 
@@ -83,6 +90,9 @@ private:
     void init_timers(RuntimeProfile* profile);
     void next_heap(MergeSortCursor& current);
     bool has_next_block(MergeSortCursor& current);
+    // The number of rows of `current` from its position on, at most `max_rows`, that are
+    // not greater than the next row of the other runs.
+    size_t rows_before_runner_up(MergeSortCursor& current, size_t max_rows);
 };
 
 } // namespace vectorized
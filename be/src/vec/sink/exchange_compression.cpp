@@ -0,0 +1,148 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/exchange_compression.h"
+
+#include <algorithm>
+#include <string>
+
+#include "common/config.h"
+#include "gen_cpp/data.pb.h"
+#include "util/block_compression.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+#include "util/stopwatch.hpp"
+
+namespace doris::vectorized {
+
+AdaptiveExchangeCompression::AdaptiveExchangeCompression()
+        : _codecs({segment_v2::CompressionTypePB::NO_COMPRESSION,
+                   segment_v2::CompressionTypePB::LZ4, segment_v2::CompressionTypePB::ZSTD}),
+          _transfer_ns_per_byte(1e9 / (std::max(config::adaptive_exchange_compression_bandwidth_mb,
+                                                int32_t(1)) *
+                                       1024.0 * 1024.0)) {}
+
+bool AdaptiveExchangeCompression::need_sample() const {
+    return _num_blocks % std::max(config::adaptive_exchange_compression_sample_interval,
+                                  int32_t(1)) ==
+           0;
+}
+
+Status AdaptiveExchangeCompression::sample(PBlock* pblock, size_t* compressed_bytes,
+                                           int64_t* compress_time_ns) {
+    ++_num_blocks;
+    const std::string& uncompressed = pblock->column_values();
+    *compressed_bytes = uncompressed.size();
+    *compress_time_ns = 0;
+    if (uncompressed.empty()) {
+        return Status::OK();
+    }
+    std::array<faststring, NUM_CODECS> outputs;
+    std::string decompressed(uncompressed.size(), '\0');
+    for (size_t i = 0; i < NUM_CODECS; ++i) {
+        if (_codecs[i] == segment_v2::CompressionTypePB::NO_COMPRESSION) {
+            continue;
+        }
+        BlockCompressionCodec* codec;
+        RETURN_IF_ERROR(get_block_compression_codec(_codecs[i], &codec));
+        MonotonicStopWatch watch;
+        watch.start();
+        RETURN_IF_ERROR(codec->compress(Slice(uncompressed), &outputs[i]));
+        int64_t compress_ns = watch.elapsed_time();
+        *compress_time_ns += compress_ns;
+
+        watch.start();
+        Slice decompressed_slice(decompressed);
+        RETURN_IF_ERROR(codec->decompress(Slice(outputs[i].data(), outputs[i].size()),
+                                          &decompressed_slice));
+        int64_t decompress_ns = watch.elapsed_time();
+
+        Estimate estimate;
+        estimate.compress_ns_per_byte = double(compress_ns) / uncompressed.size();
+        estimate.decompress_ns_per_byte = double(decompress_ns) / uncompressed.size();
+        estimate.ratio =
+                std::min(1.0, double(outputs[i].size()) / double(uncompressed.size()));
+        auto& current = _estimates[i];
+        if (!_sampled) {
+            current = estimate;
+        } else {
+            current.compress_ns_per_byte += NEW_WEIGHT * (estimate.compress_ns_per_byte -
+                                                          current.compress_ns_per_byte);
+            current.decompress_ns_per_byte += NEW_WEIGHT * (estimate.decompress_ns_per_byte -
+                                                            current.decompress_ns_per_byte);
+            current.ratio += NEW_WEIGHT * (estimate.ratio - current.ratio);
+        }
+    }
+    _sampled = true;
+    _choose();
+
+    const auto& output = outputs[_current];
+    if (codec() != segment_v2::CompressionTypePB::NO_COMPRESSION &&
+        output.size() < uncompressed.size()) {
+        pblock->set_compression_type(codec());
+        pblock->set_uncompressed_size(uncompressed.size());
+        pblock->set_compressed(true);
+        pblock->set_column_values(output.data(), output.size());
+        *compressed_bytes = output.size();
+    }
+    return Status::OK();
+}
+
+void AdaptiveExchangeCompression::update(size_t uncompressed_bytes, size_t compressed_bytes,
+                                         int64_t compress_time_ns) {
+    ++_num_blocks;
+    if (uncompressed_bytes > 0 && codec() != segment_v2::CompressionTypePB::NO_COMPRESSION) {
+        auto& current = _estimates[_current];
+        current.compress_ns_per_byte +=
+                NEW_WEIGHT * (double(compress_time_ns) / uncompressed_bytes -
+                              current.compress_ns_per_byte);
+        current.ratio +=
+                NEW_WEIGHT * (double(compressed_bytes) / uncompressed_bytes - current.ratio);
+    }
+    // the throughput may have changed since the last sample
+    if (_sampled) {
+        _choose();
+    }
+}
+
+void AdaptiveExchangeCompression::update_transfer(size_t bytes, int64_t transfer_time_ns) {
+    if (bytes < MIN_TRANSFER_BYTES || transfer_time_ns <= 0) {
+        return;
+    }
+    double ns_per_byte = double(transfer_time_ns) / bytes;
+    double current = _transfer_ns_per_byte.load(std::memory_order_relaxed);
+    while (!_transfer_ns_per_byte.compare_exchange_weak(
+            current, current + NEW_WEIGHT * (ns_per_byte - current), std::memory_order_relaxed)) {
+    }
+}
+
+double AdaptiveExchangeCompression::_cost(const Estimate& estimate) const {
+    return estimate.compress_ns_per_byte + estimate.decompress_ns_per_byte +
+           estimate.ratio * _transfer_ns_per_byte.load(std::memory_order_relaxed);
+}
+
+void AdaptiveExchangeCompression::_choose() {
+    size_t best = 0;
+    for (size_t i = 1; i < NUM_CODECS; ++i) {
+        if (_cost(_estimates[i]) < _cost(_estimates[best])) {
+            best = i;
+        }
+    }
+    _current = best;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+
+namespace doris {
+class PBlock;
+
+namespace vectorized {
+
+// Chooses the codec of the blocks sent to a channel of a VDataStreamSender when the session
+// variable fragment_transmission_compression_codec is "adaptive".
+//
+// Every adaptive_exchange_compression_sample_interval blocks, a block is compressed and
+// decompressed with each codec to measure the time per byte and the compress ratio. The
+// codec with the lowest estimated cost per byte is used until the next sample, where
+//   cost = compress time + decompress time + compressed size / network throughput
+// so a fast network favors no compression and a slow one favors ZSTD.
+//
+// The throughput is estimated from the time and the size of the RPCs sent to the channel,
+// starting from adaptive_exchange_compression_bandwidth_mb until the first one is measured.
+// The RPC time includes the time the receiver takes to accept the block, so a slow
+// receiver is treated like a slow network.
+class AdaptiveExchangeCompression {
+public:
+    AdaptiveExchangeCompression();
+
+    // Returns true if the next block should be serialized without compression and passed
+    // to sample(), otherwise it should be serialized with codec() and passed to update().
+    bool need_sample() const;
+
+    segment_v2::CompressionTypePB codec() const { return _codecs[_current]; }
+
+    // Compresses the uncompressed `pblock` with every codec and keeps the cheapest result
+    // in `pblock`.
+    Status sample(PBlock* pblock, size_t* compressed_bytes, int64_t* compress_time_ns);
+
+    // Updates the estimate of codec() with a block it compressed.
+    void update(size_t uncompressed_bytes, size_t compressed_bytes, int64_t compress_time_ns);
+
+    // Updates the throughput estimate with an RPC which sent `bytes` bytes of blocks in
+    // `transfer_time_ns`. Thread safe, it may be called by the RPC callbacks.
+    void update_transfer(size_t bytes, int64_t transfer_time_ns);
+
+private:
+    struct Estimate {
+        double compress_ns_per_byte = 0;
+        double decompress_ns_per_byte = 0;
+        double ratio = 1;
+    };
+
+    static constexpr size_t NUM_CODECS = 3;
+    // weight of a new measurement in the moving average of an estimate
+    static constexpr double NEW_WEIGHT = 0.25;
+    // the time of a smaller RPC is mostly the round trip, which says little of the throughput
+    static constexpr size_t MIN_TRANSFER_BYTES = 64 * 1024;
+
+    double _cost(const Estimate& estimate) const;
+    void _choose();
+
+    const std::array<segment_v2::CompressionTypePB, NUM_CODECS> _codecs;
+    std::array<Estimate, NUM_CODECS> _estimates;
+    size_t _current = 0;
+    int64_t _num_blocks = 0;
+    bool _sampled = false;
+    std::atomic<double> _transfer_ns_per_byte;
+};
+
+} // namespace vectorized
+} // namespace doris
@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/varrow_result_writer.h"
+
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+
+#include "runtime/buffer_control_block.h"
+#include "runtime/runtime_state.h"
+#include "util/arrow/block_convertor.h"
+#include "util/arrow/row_batch.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris {
+namespace vectorized {
+
+VArrowResultWriter::VArrowResultWriter(
+        BufferControlBlock* sinker, const std::vector<vectorized::VExprContext*>& output_vexpr_ctxs,
+        RuntimeProfile* parent_profile)
+        : VResultWriter(),
+          _sinker(sinker),
+          _output_vexpr_ctxs(output_vexpr_ctxs),
+          _parent_profile(parent_profile) {}
+
+Status VArrowResultWriter::init(RuntimeState* state) {
+    _init_profile();
+    if (nullptr == _sinker) {
+        return Status::InternalError("sinker is NULL pointer.");
+    }
+    RETURN_IF_ERROR(convert_expr_ctxs_arrow_schema(_output_vexpr_ctxs, &_arrow_schema));
+    _is_dry_run = state->query_options().dry_run_query;
+    return Status::OK();
+}
+
+void VArrowResultWriter::_init_profile() {
+    _append_row_batch_timer = ADD_TIMER(_parent_profile, "AppendBatchTime");
+    _convert_arrow_timer = ADD_CHILD_TIMER(_parent_profile, "ArrowConvertTime", "AppendBatchTime");
+    _result_send_timer = ADD_CHILD_TIMER(_parent_profile, "ResultSendTime", "AppendBatchTime");
+    _sent_rows_counter = ADD_COUNTER(_parent_profile, "NumSentRows", TUnit::UNIT);
+}
+
+Status VArrowResultWriter::append_block(Block& input_block) {
+    SCOPED_TIMER(_append_row_batch_timer);
+    Status status = Status::OK();
+    if (UNLIKELY(input_block.rows() == 0)) {
+        return status;
+    }
+
+    // Exec vectorized expr here to speed up, block.rows() == 0 means expr exec
+    // failed, just return the error status
+    auto block = VExprContext::get_output_block_after_execute_exprs(_output_vexpr_ctxs, input_block,
+                                                                    status);
+    auto num_rows = block.rows();
+    if (UNLIKELY(num_rows == 0)) {
+        return status;
+    }
+
+    std::shared_ptr<arrow::RecordBatch> result;
+    {
+        SCOPED_TIMER(_convert_arrow_timer);
+        for (auto& column : block) {
+            column.column = column.column->convert_to_full_column_if_const();
+        }
+        RETURN_IF_ERROR(convert_to_arrow_batch(block, _arrow_schema, arrow::default_memory_pool(),
+                                               &result));
+    }
+
+    {
+        SCOPED_TIMER(_result_send_timer);
+        // If this is a dry run task, no need to send data block
+        if (!_is_dry_run) {
+            RETURN_IF_ERROR(_sinker->add_arrow_batch(result));
+        }
+    }
+    _written_rows += num_rows;
+    return Status::OK();
+}
+
+bool VArrowResultWriter::can_sink() {
+    return _sinker->can_sink();
+}
+
+Status VArrowResultWriter::close() {
+    COUNTER_SET(_sent_rows_counter, _written_rows);
+    return Status::OK();
+}
+
+} // namespace vectorized
+} // namespace doris
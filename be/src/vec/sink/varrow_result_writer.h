@@ -0,0 +1,77 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "util/runtime_profile.h"
+#include "vec/core/block.h"
+#include "vec/sink/vresult_writer.h"
+
+namespace arrow {
+class Schema;
+}
+
+namespace doris {
+class BufferControlBlock;
+
+namespace vectorized {
+class VExprContext;
+
+// Converts the result blocks to Arrow record batches, which are fetched by the client through
+// PBackendService::fetch_data as Arrow IPC streams, without the cell by cell conversion to the
+// MySQL protocol of VMysqlResultWriter. Each fragment instance with a result sink has its own
+// buffer, so the results of several instances can be fetched in parallel.
+class VArrowResultWriter final : public VResultWriter {
+public:
+    VArrowResultWriter(BufferControlBlock* sinker,
+                       const std::vector<vectorized::VExprContext*>& output_vexpr_ctxs,
+                       RuntimeProfile* parent_profile);
+
+    Status init(RuntimeState* state) override;
+
+    Status append_block(Block& block) override;
+
+    bool can_sink() override;
+
+    Status close() override;
+
+private:
+    void _init_profile();
+
+    BufferControlBlock* _sinker;
+
+    const std::vector<vectorized::VExprContext*>& _output_vexpr_ctxs;
+
+    std::shared_ptr<arrow::Schema> _arrow_schema;
+
+    RuntimeProfile* _parent_profile; // parent profile from result sink. not owned
+    // total time cost on append batch operation
+    RuntimeProfile::Counter* _append_row_batch_timer = nullptr;
+    // arrow convert timer, child timer of _append_row_batch_timer
+    RuntimeProfile::Counter* _convert_arrow_timer = nullptr;
+    // result send timer, child timer of _append_row_batch_timer
+    RuntimeProfile::Counter* _result_send_timer = nullptr;
+    // number of sent rows
+    RuntimeProfile::Counter* _sent_rows_counter = nullptr;
+    // If true, no block will be sent
+    bool _is_dry_run = false;
+};
+
+} // namespace vectorized
+} // namespace doris
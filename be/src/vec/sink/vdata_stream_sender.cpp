@@ -20,6 +20,7 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
+#include <algorithm>
 #include <random>
 
 #include "common/status.h"
@@ -30,6 +31,7 @@
 #include "util/brpc_client_cache.h"
 #include "util/proto_util.h"
 #include "vec/common/sip_hash.h"
+#include "vec/core/materialize_block.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 #include "vec/runtime/vdata_stream_recvr.h"
 
@@ -98,7 +100,7 @@ Status Channel::send_current_block(bool eos) {
     }
     SCOPED_CONSUME_MEM_TRACKER(_parent->_mem_tracker.get());
     auto block = _mutable_block->to_block();
-    RETURN_IF_ERROR(_parent->serialize_block(&block, _ch_cur_pb_block));
+    RETURN_IF_ERROR(_parent->serialize_block(&block, _ch_cur_pb_block, 1, this));
     block.clear_column_data();
     _mutable_block->set_muatable_columns(block.mutate_columns());
     RETURN_IF_ERROR(send_block(_ch_cur_pb_block, eos));
@@ -108,13 +110,13 @@ Status Channel::send_current_block(bool eos) {
 
 Status Channel::send_local_block(bool eos) {
     SCOPED_TIMER(_parent->_local_send_timer);
-    Block block = _mutable_block->to_block();
-    _mutable_block->set_muatable_columns(block.clone_empty_columns());
+    auto block = std::make_shared<SharedBlock>(_mutable_block->to_block());
+    _mutable_block->set_muatable_columns(block->block().clone_empty_columns());
     if (_recvr_is_valid()) {
-        COUNTER_UPDATE(_parent->_local_bytes_send_counter, block.bytes());
-        COUNTER_UPDATE(_parent->_local_sent_rows, block.rows());
+        COUNTER_UPDATE(_parent->_local_bytes_send_counter, block->block().bytes());
+        COUNTER_UPDATE(_parent->_local_sent_rows, block->block().rows());
         COUNTER_UPDATE(_parent->_blocks_sent_counter, 1);
-        _local_recvr->add_block(&block, _parent->_sender_id, true);
+        _local_recvr->add_block(std::move(block), _parent->_sender_id);
         if (eos) {
             _local_recvr->remove_sender(_parent->_sender_id, _be_number);
         }
@@ -122,13 +124,15 @@ Status Channel::send_local_block(bool eos) {
     return Status::OK();
 }
 
-Status Channel::send_local_block(Block* block) {
+Status Channel::send_local_block(SharedBlockSPtr block) {
     SCOPED_TIMER(_parent->_local_send_timer);
     if (_recvr_is_valid()) {
-        COUNTER_UPDATE(_parent->_local_bytes_send_counter, block->bytes());
-        COUNTER_UPDATE(_parent->_local_sent_rows, block->rows());
+        COUNTER_UPDATE(_parent->_local_bytes_send_counter, block->block().bytes());
+        COUNTER_UPDATE(_parent->_local_sent_rows, block->block().rows());
         COUNTER_UPDATE(_parent->_blocks_sent_counter, 1);
-        _local_recvr->add_block(block, _parent->_sender_id, false);
+        _local_recvr->add_block(std::move(block), _parent->_sender_id);
+    } else {
+        block->release();
     }
     return Status::OK();
 }
@@ -155,6 +159,7 @@ Status Channel::send_block(PBlock* block, bool eos) {
     _brpc_request.set_eos(eos);
     if (block != nullptr) {
         _brpc_request.set_allocated_block(block);
+        _last_sent_bytes = block->column_values().size();
     }
     _brpc_request.set_packet_seq(_packet_seq++);
 
@@ -176,6 +181,15 @@ Status Channel::send_block(PBlock* block, bool eos) {
     return Status::OK();
 }
 
+void Channel::update_transfer(size_t bytes, int64_t latency_us) {
+    if (_adaptive_compression) {
+        _adaptive_compression->update_transfer(bytes, latency_us * 1000);
+    }
+    if (_parent->_adaptive_compression) {
+        _parent->_adaptive_compression->update_transfer(bytes, latency_us * 1000);
+    }
+}
+
 Status Channel::add_rows(Block* block, const std::vector<int>& rows) {
     if (_fragment_instance_id.lo == -1) {
         return Status::OK();
@@ -475,6 +489,14 @@ Status VDataStreamSender::open(RuntimeState* state) {
     RETURN_IF_ERROR(VExpr::open(_partition_expr_ctxs, state));
 
     _compression_type = state->fragement_transmission_compression_type();
+    if (config::compress_rowbatches && state->fragment_transmission_compression_adaptive()) {
+        _adaptive_compression = std::make_unique<AdaptiveExchangeCompression>();
+        for (auto* channel : _channels) {
+            if (!channel->is_local()) {
+                channel->_adaptive_compression = std::make_unique<AdaptiveExchangeCompression>();
+            }
+        }
+    }
     return Status::OK();
 }
 
@@ -486,8 +508,9 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
         // 2. send block
         // 3. rollover block
         if (_only_local_exchange) {
+            auto local_block = _share_local_block(block, _channels.size());
             for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_local_block(block));
+                RETURN_IF_ERROR(channel->send_local_block(local_block));
             }
         } else if (_enable_pipeline_exec) {
             BroadcastPBlockHolder* block_holder = nullptr;
@@ -498,9 +521,13 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
                         serialize_block(block, block_holder->get_block(), _channels.size()));
             }
 
+            SharedBlockSPtr local_block;
             for (auto channel : _channels) {
                 if (channel->is_local()) {
-                    RETURN_IF_ERROR(channel->send_local_block(block));
+                    if (!local_block) {
+                        local_block = _share_local_block(block, _num_local_channels());
+                    }
+                    RETURN_IF_ERROR(channel->send_local_block(local_block));
                 } else {
                     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
                     RETURN_IF_ERROR(channel->send_block(block_holder, eos));
@@ -512,9 +539,13 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
                 RETURN_IF_ERROR(serialize_block(block, _cur_pb_block, _channels.size()));
             }
 
+            SharedBlockSPtr local_block;
             for (auto channel : _channels) {
                 if (channel->is_local()) {
-                    RETURN_IF_ERROR(channel->send_local_block(block));
+                    if (!local_block) {
+                        local_block = _share_local_block(block, _num_local_channels());
+                    }
+                    RETURN_IF_ERROR(channel->send_local_block(local_block));
                 } else {
                     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
                     RETURN_IF_ERROR(channel->send_block(_cur_pb_block, eos));
@@ -528,10 +559,11 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
         Channel* current_channel = _channels[_current_channel_idx];
         // 2. serialize, send and rollover block
         if (current_channel->is_local()) {
-            RETURN_IF_ERROR(current_channel->send_local_block(block));
+            RETURN_IF_ERROR(current_channel->send_local_block(_share_local_block(block, 1)));
         } else {
             SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
-            RETURN_IF_ERROR(serialize_block(block, current_channel->ch_cur_pb_block()));
+            RETURN_IF_ERROR(serialize_block(block, current_channel->ch_cur_pb_block(), 1,
+                                            current_channel));
             RETURN_IF_ERROR(current_channel->send_block(current_channel->ch_cur_pb_block(), eos));
             current_channel->ch_roll_pb_block();
         }
@@ -636,17 +668,37 @@ Status VDataStreamSender::close(RuntimeState* state, Status exec_status) {
     return final_st;
 }
 
-Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_receivers) {
+Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_receivers,
+                                          Channel* channel) {
     {
         SCOPED_TIMER(_serialize_batch_timer);
         dest->Clear();
         size_t uncompressed_bytes = 0, compressed_bytes = 0;
-        RETURN_IF_ERROR(src->serialize(_state->be_exec_version(), dest, &uncompressed_bytes,
-                                       &compressed_bytes, _compression_type,
-                                       _transfer_large_data_by_brpc));
+        int64_t compress_time_ns = src->get_compress_time();
+        AdaptiveExchangeCompression* adaptive_compression =
+                channel ? channel->_adaptive_compression.get() : _adaptive_compression.get();
+        if (adaptive_compression && adaptive_compression->need_sample()) {
+            RETURN_IF_ERROR(src->serialize(_state->be_exec_version(), dest, &uncompressed_bytes,
+                                           &compressed_bytes,
+                                           segment_v2::CompressionTypePB::NO_COMPRESSION,
+                                           _transfer_large_data_by_brpc));
+            RETURN_IF_ERROR(
+                    adaptive_compression->sample(dest, &compressed_bytes, &compress_time_ns));
+        } else {
+            auto compression_type =
+                    adaptive_compression ? adaptive_compression->codec() : _compression_type;
+            RETURN_IF_ERROR(src->serialize(_state->be_exec_version(), dest, &uncompressed_bytes,
+                                           &compressed_bytes, compression_type,
+                                           _transfer_large_data_by_brpc));
+            compress_time_ns = src->get_compress_time() - compress_time_ns;
+            if (adaptive_compression) {
+                adaptive_compression->update(uncompressed_bytes, compressed_bytes,
+                                             compress_time_ns);
+            }
+        }
         COUNTER_UPDATE(_bytes_sent_counter, compressed_bytes * num_receivers);
         COUNTER_UPDATE(_uncompressed_bytes_counter, uncompressed_bytes * num_receivers);
-        COUNTER_UPDATE(_compress_timer, src->get_compress_time());
+        COUNTER_UPDATE(_compress_timer, compress_time_ns);
     }
 
     return Status::OK();
@@ -663,6 +715,21 @@ Status VDataStreamSender::_get_next_available_buffer(BroadcastPBlockHolder** hol
     return Status::OK();
 }
 
+SharedBlockSPtr VDataStreamSender::_share_local_block(Block* block, int num_local_channels) {
+    // the receivers read the shared columns concurrently, so they must not be changed in
+    // place after this
+    materialize_block_inplace(*block);
+    auto local_block = std::make_shared<SharedBlock>(
+            Block(block->get_columns_with_type_and_name()), num_local_channels);
+    block->set_columns(block->clone_empty_columns());
+    return local_block;
+}
+
+int VDataStreamSender::_num_local_channels() const {
+    return std::count_if(_channels.begin(), _channels.end(),
+                         [](Channel* channel) { return channel->is_local(); });
+}
+
 void VDataStreamSender::registe_channels(pipeline::ExchangeSinkBuffer* buffer) {
     for (auto channel : _channels) {
         ((PipChannel*)channel)->registe(buffer);
@@ -674,6 +741,11 @@ bool VDataStreamSender::channel_all_can_write() {
         !_only_local_exchange) {
         // This condition means we need use broadcast buffer, so we should make sure
         // there are available buffer before running pipeline
+        for (auto channel : _channels) {
+            if (!channel->can_write()) {
+                return false;
+            }
+        }
         if (_broadcast_pb_block_idx == _broadcast_pb_blocks.size()) {
             _broadcast_pb_block_idx = 0;
         }
@@ -33,6 +33,7 @@
 #include "vec/exprs/vexpr_context.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 #include "vec/runtime/vdata_stream_recvr.h"
+#include "vec/sink/exchange_compression.h"
 
 namespace doris {
 class ObjectPool;
@@ -115,7 +116,10 @@ public:
 
     RuntimeState* state() { return _state; }
 
-    Status serialize_block(Block* src, PBlock* dest, int num_receivers = 1);
+    // A block sent to a single channel is compressed with the codec chosen for `channel`,
+    // a block shared by all the channels with the codec chosen for the sender.
+    Status serialize_block(Block* src, PBlock* dest, int num_receivers = 1,
+                           Channel* channel = nullptr);
 
     void registe_channels(pipeline::ExchangeSinkBuffer* buffer);
 
@@ -130,6 +134,12 @@ protected:
     void _roll_pb_block();
     Status _get_next_available_buffer(BroadcastPBlockHolder** holder);
 
+    // Takes the columns of `block` for `num_local_channels` local channels and leaves it with
+    // empty columns, the caller does not read the block after send().
+    static SharedBlockSPtr _share_local_block(Block* block, int num_local_channels);
+
+    int _num_local_channels() const;
+
     Status get_partition_column_result(Block* block, int* result) const {
         int counter = 0;
         for (auto ctx : _partition_expr_ctxs) {
@@ -206,6 +216,9 @@ protected:
     bool _transfer_large_data_by_brpc = false;
 
     segment_v2::CompressionTypePB _compression_type;
+    // set if the session chooses the codec by sampling, overrides _compression_type. It
+    // measures the RPCs of all the channels, each channel has its own one as well.
+    std::unique_ptr<AdaptiveExchangeCompression> _adaptive_compression;
 
     bool _new_shuffle_hash_method = false;
     bool _only_local_exchange = false;
@@ -272,7 +285,9 @@ public:
 
     Status send_local_block(bool eos = false);
 
-    Status send_local_block(Block* block);
+    // `block` may be shared with the other local channels of a broadcast, each of them
+    // holds it.
+    Status send_local_block(SharedBlockSPtr block);
     // Flush buffered rows and close channel. This function don't wait the response
     // of close operation, client should call close_wait() to finish channel's close.
     // We split one close operation into two phases in order to make multiple channels
@@ -286,6 +301,10 @@ public:
 
     PBlock* ch_cur_pb_block() { return _ch_cur_pb_block; }
 
+    // Feeds the time of an RPC which sent `bytes` bytes of blocks to the adaptive codec
+    // choice of this channel and of the sender.
+    void update_transfer(size_t bytes, int64_t latency_us);
+
     std::string get_fragment_instance_id_str() {
         UniqueId uid(_fragment_instance_id);
         return uid.to_string();
@@ -300,10 +319,10 @@ public:
             return true;
         }
 
-        // if local recvr queue mem over the exchange node mem limit, we must ensure each queue
-        // has one block to do merge sort in exchange node to prevent the logic dead lock
-        return !_local_recvr || _local_recvr->is_closed() || !_local_recvr->exceeds_limit(0) ||
-               _local_recvr->sender_queue_empty(_parent->_sender_id);
+        // each sender queue has its own capacity, so a merging exchange node always gets
+        // one block from every queue and can not dead lock
+        return !_local_recvr || _local_recvr->is_closed() ||
+               !_local_recvr->sender_queue_full(_parent->_sender_id);
     }
 
 protected:
@@ -326,6 +345,8 @@ protected:
             LOG(WARNING) << err;
             return Status::RpcError(err);
         }
+        update_transfer(_last_sent_bytes, cntl->latency_us());
+        _last_sent_bytes = 0;
         return Status::OK();
     }
 
@@ -366,6 +387,10 @@ protected:
 
     bool _is_local;
     std::shared_ptr<VDataStreamRecvr> _local_recvr;
+    // set if the parent chooses the codec adaptively
+    std::unique_ptr<AdaptiveExchangeCompression> _adaptive_compression;
+    // the bytes of the block sent by the RPC in flight
+    size_t _last_sent_bytes = 0;
     // serialized blocks for broadcasting; we need two so we can write
     // one while the other one is still being sent.
     // Which is for same reason as `_cur_pb_block`, `_pb_block1` and `_pb_block2`
@@ -464,7 +489,7 @@ public:
         if (_mutable_block) {
             block_ptr = new PBlock(); // TODO: need a pool of PBlock()
             auto block = _mutable_block->to_block();
-            RETURN_IF_ERROR(_parent->serialize_block(&block, block_ptr));
+            RETURN_IF_ERROR(_parent->serialize_block(&block, block_ptr, 1, this));
             block.clear_column_data();
             _mutable_block->set_muatable_columns(block.mutate_columns());
         }
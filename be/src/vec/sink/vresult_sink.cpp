@@ -22,6 +22,7 @@
 #include "runtime/result_buffer_mgr.h"
 #include "runtime/runtime_state.h"
 #include "vec/exprs/vexpr.h"
+#include "vec/sink/varrow_result_writer.h"
 #include "vec/sink/vmysql_result_writer.h"
 
 namespace doris {
@@ -71,6 +72,10 @@ Status VResultSink::prepare(RuntimeState* state) {
         _writer.reset(new (std::nothrow)
                               VMysqlResultWriter(_sender.get(), _output_vexpr_ctxs, _profile));
         break;
+    case TResultSinkType::ARROW_PROTOCAL:
+        _writer.reset(new (std::nothrow)
+                              VArrowResultWriter(_sender.get(), _output_vexpr_ctxs, _profile));
+        break;
     default:
         return Status::InternalError("Unknown result sink type");
     }
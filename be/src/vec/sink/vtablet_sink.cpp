@@ -18,6 +18,7 @@
 #include "vec/sink/vtablet_sink.h"
 
 #include <fmt/format.h>
+#include <parallel_hashmap/phmap.h>
 
 #include <mutex>
 #include <sstream>
@@ -516,8 +517,10 @@ Status VNodeChannel::add_block(vectorized::Block* block, const Payload* payload,
         _cur_add_block_request.set_is_single_tablet_block(true);
     } else {
         block->append_block_by_selector(_cur_mutable_block.get(), *(payload->first));
+        auto* tablet_ids = _cur_add_block_request.mutable_tablet_ids();
+        tablet_ids->Reserve(tablet_ids->size() + payload->second.size());
         for (auto tablet_id : payload->second) {
-            _cur_add_block_request.add_tablet_ids(tablet_id);
+            tablet_ids->AddAlreadyReserved(tablet_id);
         }
     }
 
@@ -1045,71 +1048,130 @@ size_t VOlapTableSink::get_pending_bytes() const {
     return mem_consumption;
 }
 
-Status VOlapTableSink::find_tablet(RuntimeState* state, vectorized::Block* block, int row_index,
-                                   const VOlapTablePartition** partition, uint32_t& tablet_index,
-                                   bool& stop_processing, bool& is_continue) {
-    Status status = Status::OK();
-    *partition = nullptr;
-    tablet_index = 0;
-    BlockRow block_row;
-    block_row = {block, row_index};
-    if (!_vpartition->find_partition(&block_row, partition)) {
-        RETURN_IF_ERROR(state->append_error_msg_to_file(
-                []() -> std::string { return ""; },
-                [&]() -> std::string {
-                    fmt::memory_buffer buf;
-                    fmt::format_to(buf, "no partition for this tuple. tuple={}",
-                                   block->dump_data(row_index, 1));
-                    return fmt::to_string(buf);
-                },
-                &stop_processing));
-        _number_filtered_rows++;
-        if (stop_processing) {
-            return Status::EndOfFile("Encountered unqualified data, stop processing");
+Status VOlapTableSink::_find_tablets(RuntimeState* state, vectorized::Block* block,
+                                     int filtered_rows, bool* stop_processing) {
+    size_t num_rows = block->rows();
+    _skip_rows.assign(num_rows, 0);
+    if (filtered_rows > 0) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            _skip_rows[i] = _filter_bitmap.Get(i);
         }
-        is_continue = true;
-        return status;
-    }
-    if (!(*partition)->is_mutable) {
-        _number_immutable_partition_filtered_rows++;
-        is_continue = true;
-        return status;
     }
-    _partition_ids.emplace((*partition)->id);
-    if (findTabletMode != FindTabletMode::FIND_TABLET_EVERY_ROW) {
-        if (_partition_to_tablet_map.find((*partition)->id) == _partition_to_tablet_map.end()) {
-            tablet_index = _vpartition->find_tablet(&block_row, **partition);
-            _partition_to_tablet_map.emplace((*partition)->id, tablet_index);
-        } else {
-            tablet_index = _partition_to_tablet_map[(*partition)->id];
+    _vpartition->find_partitions(block, _skip_rows.data(), &_row_partitions);
+
+    const VOlapTablePartition* last_partition = nullptr;
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (_skip_rows[i]) {
+            continue;
+        }
+        const auto* partition = _row_partitions[i];
+        if (partition == nullptr) {
+            RETURN_IF_ERROR(state->append_error_msg_to_file(
+                    []() -> std::string { return ""; },
+                    [&]() -> std::string {
+                        fmt::memory_buffer buf;
+                        fmt::format_to(buf, "no partition for this tuple. tuple={}",
+                                       block->dump_data(i, 1));
+                        return fmt::to_string(buf);
+                    },
+                    stop_processing));
+            _number_filtered_rows++;
+            if (*stop_processing) {
+                return Status::EndOfFile("Encountered unqualified data, stop processing");
+            }
+            continue;
+        }
+        if (!partition->is_mutable) {
+            _number_immutable_partition_filtered_rows++;
+            _row_partitions[i] = nullptr;
+            continue;
+        }
+        if (partition != last_partition) {
+            _partition_ids.emplace(partition->id);
+            last_partition = partition;
         }
-    } else {
-        tablet_index = _vpartition->find_tablet(&block_row, **partition);
     }
 
-    return status;
+    if (findTabletMode == FindTabletMode::FIND_TABLET_EVERY_ROW) {
+        _vpartition->find_tablets(block, _row_partitions, &_row_tablet_indexes);
+        return Status::OK();
+    }
+    // random distribution, all rows of a partition go to the same tablet
+    _row_tablet_indexes.resize(num_rows);
+    last_partition = nullptr;
+    uint32_t tablet_index = 0;
+    for (size_t i = 0; i < num_rows; ++i) {
+        const auto* partition = _row_partitions[i];
+        if (partition == nullptr) {
+            continue;
+        }
+        if (partition != last_partition) {
+            auto it = _partition_to_tablet_map.find(partition->id);
+            if (it == _partition_to_tablet_map.end()) {
+                BlockRow block_row {block, (int32_t)i};
+                tablet_index = _vpartition->find_tablet(&block_row, *partition);
+                _partition_to_tablet_map.emplace(partition->id, tablet_index);
+            } else {
+                tablet_index = it->second;
+            }
+            last_partition = partition;
+        }
+        _row_tablet_indexes[i] = tablet_index;
+    }
+    return Status::OK();
 }
 
-void VOlapTableSink::_generate_row_distribution_payload(
-        ChannelDistributionPayload& channel_to_payload, const VOlapTablePartition* partition,
-        uint32_t tablet_index, int row_idx, size_t row_cnt) {
+void VOlapTableSink::_generate_rows_distribution_payload(
+        ChannelDistributionPayload& channel_to_payload, size_t num_rows) {
+    // group the rows by (partition, tablet index), with a counting sort on the group ids
+    phmap::flat_hash_map<std::pair<const VOlapTablePartition*, uint32_t>, uint32_t> group_ids;
+    std::vector<std::pair<const VOlapTablePartition*, uint32_t>> groups;
+    std::vector<uint32_t> row_groups(num_rows);
+    std::vector<uint32_t> group_offsets(1, 0);
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (_row_partitions[i] == nullptr) {
+            continue;
+        }
+        auto key = std::make_pair(_row_partitions[i], _row_tablet_indexes[i]);
+        auto [it, inserted] = group_ids.emplace(key, groups.size());
+        if (inserted) {
+            groups.push_back(key);
+            group_offsets.push_back(0);
+        }
+        row_groups[i] = it->second;
+        group_offsets[it->second + 1]++;
+    }
+    for (size_t group = 1; group < group_offsets.size(); ++group) {
+        group_offsets[group] += group_offsets[group - 1];
+    }
+    std::vector<vectorized::IColumn::ColumnIndex> sorted_rows(group_offsets.back());
+    std::vector<uint32_t> group_cursors(group_offsets.begin(), group_offsets.end() - 1);
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (_row_partitions[i] != nullptr) {
+            sorted_rows[group_cursors[row_groups[i]]++] = i;
+        }
+    }
+
     // Generate channel payload for sinking data to differenct node channel
-    for (int j = 0; j < partition->indexes.size(); ++j) {
-        auto tid = partition->indexes[j].tablets[tablet_index];
-        auto it = _channels[j]->_channels_by_tablet.find(tid);
-        DCHECK(it != _channels[j]->_channels_by_tablet.end())
-                << "unknown tablet, tablet_id=" << tablet_index;
-        for (const auto& channel : it->second) {
-            if (channel_to_payload[j].count(channel.get()) < 1) {
-                channel_to_payload[j].insert(
-                        {channel.get(), Payload {std::unique_ptr<vectorized::IColumn::Selector>(
-                                                         new vectorized::IColumn::Selector()),
-                                                 std::vector<int64_t>()}});
+    for (size_t group = 0; group < groups.size(); ++group) {
+        const auto& [partition, tablet_index] = groups[group];
+        const auto* rows_begin = sorted_rows.data() + group_offsets[group];
+        const auto* rows_end = sorted_rows.data() + group_offsets[group + 1];
+        for (int j = 0; j < partition->indexes.size(); ++j) {
+            auto tid = partition->indexes[j].tablets[tablet_index];
+            auto it = _channels[j]->_channels_by_tablet.find(tid);
+            DCHECK(it != _channels[j]->_channels_by_tablet.end())
+                    << "unknown tablet, tablet_id=" << tablet_index;
+            for (const auto& channel : it->second) {
+                auto& payload = channel_to_payload[j][channel.get()];
+                if (payload.first == nullptr) {
+                    payload.first.reset(new vectorized::IColumn::Selector());
+                }
+                payload.first->insert(rows_begin, rows_end);
+                payload.second.resize(payload.second.size() + (rows_end - rows_begin), tid);
             }
-            channel_to_payload[j][channel.get()].first->push_back(row_idx);
-            channel_to_payload[j][channel.get()].second.push_back(tid);
+            _number_output_rows += rows_end - rows_begin;
         }
-        _number_output_rows += row_cnt;
     }
 }
 
@@ -1168,21 +1230,8 @@ Status VOlapTableSink::send(RuntimeState* state, vectorized::Block* input_block,
         // Recaculate is needed
         _partition_to_tablet_map.clear();
     }
-    for (int i = 0; i < num_rows; ++i) {
-        if (UNLIKELY(filtered_rows) > 0 && _filter_bitmap.Get(i)) {
-            continue;
-        }
-        const VOlapTablePartition* partition = nullptr;
-        bool is_continue = false;
-        uint32_t tablet_index = 0;
-        RETURN_IF_ERROR(find_tablet(state, &block, i, &partition, tablet_index, stop_processing,
-                                    is_continue));
-        if (is_continue) {
-            continue;
-        }
-        // each row
-        _generate_row_distribution_payload(channel_to_payload, partition, tablet_index, i, 1);
-    }
+    RETURN_IF_ERROR(_find_tablets(state, &block, filtered_rows, &stop_processing));
+    _generate_rows_distribution_payload(channel_to_payload, num_rows);
     // Random distribution and the block belongs to a single tablet, we could optimize to append the whole
     // block into node channel.
     bool load_block_to_single_tablet =
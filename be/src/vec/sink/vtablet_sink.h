@@ -430,10 +430,10 @@ private:
 
     using ChannelDistributionPayload = std::vector<std::unordered_map<VNodeChannel*, Payload>>;
 
-    // payload for each row
-    void _generate_row_distribution_payload(ChannelDistributionPayload& payload,
-                                            const VOlapTablePartition* partition,
-                                            uint32_t tablet_index, int row_idx, size_t row_cnt);
+    // Payload of the rows whose partition is found by _find_tablets(), the rows are grouped
+    // by tablet first so the node channels of each tablet are looked up once per block.
+    void _generate_rows_distribution_payload(ChannelDistributionPayload& payload,
+                                             size_t num_rows);
 
     // make input data valid for OLAP table
     // return number of invalid/filtered rows.
@@ -454,9 +454,11 @@ private:
     // so here need to do the convert operation
     void _convert_to_dest_desc_block(vectorized::Block* block);
 
-    Status find_tablet(RuntimeState* state, vectorized::Block* block, int row_index,
-                       const VOlapTablePartition** partition, uint32_t& tablet_index,
-                       bool& stop_processing, bool& is_continue);
+    // Finds the partition and the tablet index of all rows of `block` into _row_partitions and
+    // _row_tablet_indexes. The partition of a row is left nullptr if the row is filtered,
+    // in no partition, or in an immutable partition.
+    Status _find_tablets(RuntimeState* state, vectorized::Block* block, int filtered_rows,
+                         bool* stop_processing);
 
     std::shared_ptr<MemTracker> _mem_tracker;
 
@@ -494,6 +496,10 @@ private:
     std::map<int64_t, int64_t> _partition_to_tablet_map;
 
     Bitmap _filter_bitmap;
+    // the rows of the block being sent that are filtered or skipped
+    std::vector<uint8_t> _skip_rows;
+    std::vector<const VOlapTablePartition*> _row_partitions;
+    std::vector<uint32_t> _row_tablet_indexes;
 
     // index_channel
     std::vector<std::shared_ptr<IndexChannel>> _channels;
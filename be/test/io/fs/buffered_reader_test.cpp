@@ -0,0 +1,197 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/buffered_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "common/config.h"
+#include "util/threadpool.h"
+
+namespace doris {
+namespace io {
+
+// A file in memory which sleeps on each read, like the round trips of remote storage.
+class LatencyFileReader : public FileReader {
+public:
+    LatencyFileReader(std::string data, int latency_ms)
+            : _data(std::move(data)), _latency_ms(latency_ms) {}
+
+    Status close() override {
+        _closed = true;
+        return Status::OK();
+    }
+
+    const Path& path() const override { return _path; }
+
+    size_t size() const override { return _data.size(); }
+
+    bool closed() const override { return _closed; }
+
+    std::shared_ptr<FileSystem> fs() const override { return nullptr; }
+
+    int64_t read_calls() const { return _read_calls; }
+
+protected:
+    Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                        const IOContext* io_ctx) override {
+        ++_read_calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(_latency_ms));
+        size_t bytes = std::min(result.size, _data.size() - std::min(offset, _data.size()));
+        memcpy(result.data, _data.data() + offset, bytes);
+        *bytes_read = bytes;
+        return Status::OK();
+    }
+
+private:
+    std::string _data;
+    int _latency_ms;
+    Path _path = "latency_file";
+    std::atomic<int64_t> _read_calls = 0;
+    bool _closed = false;
+};
+
+class MergeRangeFileReaderTest : public testing::Test {
+public:
+    void SetUp() override {
+        EXPECT_TRUE(ThreadPoolBuilder("MergeRangeIOTestPool")
+                            .set_min_threads(4)
+                            .set_max_threads(4)
+                            .build(&_thread_pool)
+                            .ok());
+        for (int i = 0; i < 64 * 1024; ++i) {
+            _data.push_back('a' + i % 26);
+        }
+    }
+
+    void TearDown() override { _thread_pool->shutdown(); }
+
+    void check_read(FileReader* reader, size_t offset, size_t length) {
+        std::string buf(length, '\0');
+        size_t bytes_read = 0;
+        EXPECT_TRUE(reader->read_at(offset, Slice(buf.data(), length), &bytes_read).ok());
+        EXPECT_EQ(length, bytes_read);
+        EXPECT_EQ(_data.substr(offset, length), buf);
+    }
+
+protected:
+    std::unique_ptr<ThreadPool> _thread_pool;
+    std::string _data;
+};
+
+TEST_F(MergeRangeFileReaderTest, merge_ranges) {
+    auto inner_reader = std::make_shared<LatencyFileReader>(_data, 10);
+    // the ranges in [1000, 8000) are merged, the gap before 20000 is too large
+    std::vector<PrefetchRange> ranges {
+            {1000, 2000}, {2100, 3000}, {2500, 4000}, {20000, 24000}, {4096, 8000}};
+    MergeRangeFileReader reader(inner_reader, ranges, _thread_pool.get(), 1024, 1 << 20, 2);
+    EXPECT_TRUE(reader.prefetch().ok());
+    EXPECT_EQ(5, reader.statistics().request_ranges);
+    EXPECT_EQ(2, reader.statistics().merged_ranges);
+    EXPECT_EQ(7000 + 4000, reader.statistics().merged_bytes);
+
+    check_read(&reader, 1000, 1000);
+    check_read(&reader, 2100, 1900);
+    check_read(&reader, 5000, 3000);
+    check_read(&reader, 20000, 4000);
+    EXPECT_EQ(2, inner_reader->read_calls());
+    EXPECT_EQ(0, reader.statistics().read_through_bytes);
+
+    // out of the ranges
+    check_read(&reader, 30000, 100);
+    // across the end of a merged range
+    check_read(&reader, 7000, 2000);
+    EXPECT_EQ(4, inner_reader->read_calls());
+    EXPECT_EQ(2100, reader.statistics().read_through_bytes);
+    EXPECT_TRUE(reader.close().ok());
+}
+
+TEST_F(MergeRangeFileReaderTest, parallel_fetch) {
+    auto inner_reader = std::make_shared<LatencyFileReader>(_data, 100);
+    std::vector<PrefetchRange> ranges;
+    for (size_t offset = 0; offset < 8 * 8192; offset += 8192) {
+        ranges.emplace_back(offset, offset + 4096);
+    }
+    MergeRangeFileReader reader(inner_reader, ranges, _thread_pool.get(), 0, 1 << 20, 4);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(reader.prefetch().ok());
+    EXPECT_EQ(8, reader.statistics().merged_ranges);
+    for (auto& range : ranges) {
+        check_read(&reader, range.start_offset, range.end_offset - range.start_offset);
+    }
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+    // 8 requests by 4 tasks take 2 round trips rather than 8
+    EXPECT_LT(elapsed_ms, 600);
+    EXPECT_EQ(8, inner_reader->read_calls());
+}
+
+TEST_F(MergeRangeFileReaderTest, max_buffer_bytes) {
+    auto inner_reader = std::make_shared<LatencyFileReader>(_data, 1);
+    std::vector<PrefetchRange> ranges {{0, 4096}, {16384, 20480}, {32768, 36864}};
+    MergeRangeFileReader reader(inner_reader, ranges, _thread_pool.get(), 0, 8192, 2);
+    EXPECT_TRUE(reader.prefetch().ok());
+    EXPECT_EQ(2, reader.statistics().merged_ranges);
+    EXPECT_EQ(8192, reader.statistics().merged_bytes);
+    check_read(&reader, 0, 4096);
+    check_read(&reader, 16384, 4096);
+    check_read(&reader, 32768, 4096);
+    EXPECT_EQ(4096, reader.statistics().read_through_bytes);
+    // close without reading all the ranges
+    MergeRangeFileReader reader2(inner_reader, ranges, _thread_pool.get(), 0, 1 << 20, 2);
+    EXPECT_TRUE(reader2.prefetch().ok());
+    EXPECT_TRUE(reader2.close().ok());
+}
+
+TEST_F(MergeRangeFileReaderTest, max_total_buffer_bytes) {
+    int32_t origin_max_total_buffer_mb = config::merge_range_io_max_total_buffer_mb;
+    config::merge_range_io_max_total_buffer_mb = 1;
+    auto inner_reader = std::make_shared<LatencyFileReader>(std::string(2 << 20, 'a'), 1);
+    std::vector<PrefetchRange> ranges {{0, 512 << 10}, {1 << 20, (1 << 20) + (256 << 10)}};
+    MergeRangeFileReader reader(inner_reader, ranges, _thread_pool.get(), 0, 8 << 20, 2);
+    EXPECT_TRUE(reader.prefetch().ok());
+    EXPECT_EQ(2, reader.statistics().merged_ranges);
+    EXPECT_EQ(768 << 10, MergeRangeFileReader::total_buffer_bytes());
+
+    // only the first range fits in the buffers left by the other reader
+    std::vector<PrefetchRange> ranges2 {{0, 256 << 10}, {1 << 20, (1 << 20) + (256 << 10)}};
+    MergeRangeFileReader reader2(inner_reader, ranges2, _thread_pool.get(), 0, 8 << 20, 2);
+    EXPECT_TRUE(reader2.prefetch().ok());
+    EXPECT_EQ(1, reader2.statistics().merged_ranges);
+    EXPECT_EQ(256 << 10, reader2.statistics().merged_bytes);
+    EXPECT_EQ(1 << 20, MergeRangeFileReader::total_buffer_bytes());
+    std::string buf(256 << 10, '\0');
+    size_t bytes_read = 0;
+    EXPECT_TRUE(reader2.read_at(1 << 20, Slice(buf.data(), buf.size()), &bytes_read).ok());
+    EXPECT_EQ(256 << 10, reader2.statistics().read_through_bytes);
+
+    EXPECT_TRUE(reader.close().ok());
+    EXPECT_EQ(256 << 10, MergeRangeFileReader::total_buffer_bytes());
+    EXPECT_TRUE(reader2.close().ok());
+    EXPECT_EQ(0, MergeRangeFileReader::total_buffer_bytes());
+    config::merge_range_io_max_total_buffer_mb = origin_max_total_buffer_mb;
+}
+
+} // namespace io
+} // namespace doris
@@ -17,17 +17,22 @@
 
 #include "io/fs/local_file_system.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <set>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "io/fs/file_reader.h"
 #include "io/fs/file_writer.h"
+#include "io/fs/io_uring.h"
 
 namespace doris {
 
@@ -559,6 +564,83 @@ TEST_F(LocalFileSystemTest, TestRandomAccess) {
     }
 }
 
+TEST_F(LocalFileSystemTest, TestBatchRead) {
+    std::string fname = "./ut_dir/local_filesystem/batch_read";
+    EXPECT_TRUE(io::global_local_filesystem()->create_directory("./ut_dir/local_filesystem/").ok());
+    std::string content;
+    for (int i = 0; i < 100000; ++i) {
+        content.push_back((char)(i % 127));
+    }
+    EXPECT_TRUE(save_string_file(fname, content).ok());
+
+    bool enable_io_uring = config::enable_io_uring;
+    // io_uring falls back to pread if it is not supported
+    for (bool use_io_uring : {false, true}) {
+        config::enable_io_uring = use_io_uring;
+        io::FileReaderSPtr file_reader;
+        EXPECT_TRUE(io::global_local_filesystem()->open_file(fname, &file_reader).ok());
+
+        // more ranges than the queue depth, and the last range exceeds the file size
+        std::vector<size_t> offsets;
+        for (size_t offset = 0; offset < content.size(); offset += 997) {
+            offsets.push_back(offset);
+        }
+        std::vector<char> mem(offsets.size() * 1000);
+        std::vector<io::ReadRequest> requests(offsets.size());
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            requests[i].offset = offsets[i];
+            requests[i].result = Slice(mem.data() + i * 1000, 1000);
+        }
+        EXPECT_TRUE(file_reader->read_batch_at(&requests).ok());
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            size_t expected = std::min<size_t>(1000, content.size() - offsets[i]);
+            EXPECT_EQ(expected, requests[i].bytes_read);
+            EXPECT_EQ(content.substr(offsets[i], expected),
+                      std::string(requests[i].result.data, requests[i].bytes_read));
+        }
+
+        std::vector<io::ReadRequest> bad_requests(1);
+        bad_requests[0].offset = content.size() + 1;
+        bad_requests[0].result = Slice(mem.data(), 10);
+        EXPECT_FALSE(file_reader->read_batch_at(&bad_requests).ok());
+        EXPECT_TRUE(file_reader->close().ok());
+    }
+    config::enable_io_uring = enable_io_uring;
+}
+
+TEST_F(LocalFileSystemTest, TestIOUringFailedBatch) {
+    auto* ring = io::IOUring::get_thread_local();
+    if (ring == nullptr) {
+        return;
+    }
+    std::string fname = "./ut_dir/local_filesystem/io_uring_read";
+    EXPECT_TRUE(io::global_local_filesystem()->create_directory("./ut_dir/local_filesystem/").ok());
+    std::string content((ring->depth() + 3) * 100, 'a');
+    EXPECT_TRUE(save_string_file(fname, content).ok());
+
+    // every read of the first batch fails on a bad fd, all of their completions must be
+    // reaped before the error is returned
+    std::vector<char> mem((ring->depth() + 3) * 100);
+    std::vector<io::ReadRequest> requests(ring->depth() + 3);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        requests[i].offset = i * 100;
+        requests[i].result = Slice(mem.data() + i * 100, 100);
+    }
+    EXPECT_FALSE(ring->read_batch(-1, &requests).ok());
+
+    // no completion of the failed batch is left in the ring for the next one
+    int fd = open(fname.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    for (auto& request : requests) {
+        request.bytes_read = 0;
+    }
+    EXPECT_TRUE(ring->read_batch(fd, &requests).ok());
+    for (const auto& request : requests) {
+        EXPECT_EQ(100, request.bytes_read);
+    }
+    close(fd);
+}
+
 TEST_F(LocalFileSystemTest, TestRandomWrite) {
     std::string fname = "./ut_dir/env_posix/random_rw";
     EXPECT_TRUE(io::global_local_filesystem()->create_directory("./ut_dir/env_posix").ok());
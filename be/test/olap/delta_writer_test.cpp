@@ -37,6 +37,7 @@
 #include "olap/utils.h"
 #include "runtime/descriptor_helper.h"
 #include "runtime/exec_env.h"
+#include "util/defer_op.h"
 
 namespace doris {
 
@@ -549,10 +550,11 @@ TEST_F(TestDeltaWriter, vec_write) {
     delete delta_writer;
 }
 
-TEST_F(TestDeltaWriter, vec_sequence_col) {
+// Writes two rows of the same key, the one written first has the larger sequence value.
+static void write_and_check_sequence_col(int64_t tablet_id, int32_t schema_hash, int64_t txn_id,
+                                         int64_t partition_id) {
     TCreateTabletReq request;
-    sleep(20);
-    create_tablet_request_with_sequence_col(10005, 270068377, &request);
+    create_tablet_request_with_sequence_col(tablet_id, schema_hash, &request);
     Status res = k_engine->create_tablet(request);
     ASSERT_TRUE(res.ok());
 
@@ -566,8 +568,9 @@ TEST_F(TestDeltaWriter, vec_sequence_col) {
     PUniqueId load_id;
     load_id.set_hi(0);
     load_id.set_lo(0);
-    WriteRequest write_req = {10005,   270068377,  WriteType::LOAD,        20003, 30003,
-                              load_id, tuple_desc, &(tuple_desc->slots()), false, &param};
+    WriteRequest write_req = {tablet_id,    schema_hash, WriteType::LOAD,        txn_id,
+                              partition_id, load_id,     tuple_desc, &(tuple_desc->slots()),
+                              false,        &param};
     DeltaWriter* delta_writer = nullptr;
     DeltaWriter::open(&write_req, &delta_writer, TUniqueId());
     ASSERT_NE(delta_writer, nullptr);
@@ -683,4 +686,151 @@ TEST_F(TestDeltaWriter, vec_sequence_col) {
     delete delta_writer;
 }
 
+TEST_F(TestDeltaWriter, vec_sequence_col) {
+    sleep(20);
+    write_and_check_sequence_col(10005, 270068377, 20003, 30003);
+}
+
+// Writes rows of k1, k2, v1 out of key order, (3, 1) twice, and returns the rows of the
+// flushed segment.
+static std::vector<std::tuple<int64_t, int64_t, int64_t>> write_unsorted_rows(
+        TKeysType::type keys_type, int64_t tablet_id, int32_t schema_hash, int64_t txn_id,
+        int64_t partition_id) {
+    std::vector<std::tuple<int64_t, int64_t, int64_t>> rows;
+    TCreateTabletReq request;
+    request.tablet_id = tablet_id;
+    request.__set_version(1);
+    request.tablet_schema.schema_hash = schema_hash;
+    request.tablet_schema.short_key_column_count = 2;
+    request.tablet_schema.keys_type = keys_type;
+    request.tablet_schema.storage_type = TStorageType::COLUMN;
+    request.__set_storage_format(TStorageFormat::V2);
+    TDescriptorTableBuilder dtb;
+    TTupleDescriptorBuilder tuple_builder;
+    for (auto [name, type, is_key] : {std::make_tuple("k1", TYPE_TINYINT, true),
+                                      std::make_tuple("k2", TYPE_SMALLINT, true),
+                                      std::make_tuple("v1", TYPE_INT, false)}) {
+        TColumn column;
+        column.column_name = name;
+        column.__set_is_key(is_key);
+        column.column_type.type = type == TYPE_TINYINT    ? TPrimitiveType::TINYINT
+                                  : type == TYPE_SMALLINT ? TPrimitiveType::SMALLINT
+                                                          : TPrimitiveType::INT;
+        if (!is_key) {
+            column.__set_aggregation_type(keys_type == TKeysType::AGG_KEYS
+                                                  ? TAggregationType::SUM
+                                                  : TAggregationType::NONE);
+        }
+        request.tablet_schema.columns.push_back(column);
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .type(type)
+                                       .nullable(false)
+                                       .column_name(name)
+                                       .column_pos(request.tablet_schema.columns.size() - 1)
+                                       .build());
+    }
+    tuple_builder.build(&dtb);
+    Status res = k_engine->create_tablet(request);
+    EXPECT_TRUE(res.ok());
+
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, dtb.desc_tbl(), &desc_tbl);
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    OlapTableSchemaParam param;
+
+    PUniqueId load_id;
+    load_id.set_hi(0);
+    load_id.set_lo(0);
+    WriteRequest write_req = {tablet_id,    schema_hash, WriteType::LOAD,        txn_id,
+                              partition_id, load_id,     tuple_desc, &(tuple_desc->slots()),
+                              false,        &param};
+    DeltaWriter* delta_writer = nullptr;
+    DeltaWriter::open(&write_req, &delta_writer, TUniqueId());
+    EXPECT_NE(delta_writer, nullptr);
+    Defer delete_writer {[&]() { delete delta_writer; }};
+
+    vectorized::Block block;
+    for (const auto& slot_desc : tuple_desc->slots()) {
+        block.insert(vectorized::ColumnWithTypeAndName(slot_desc->get_empty_mutable_column(),
+                                                       slot_desc->get_data_type_ptr(),
+                                                       slot_desc->col_name()));
+    }
+    auto columns = block.mutate_columns();
+    for (auto [k1, k2, v1] : {std::make_tuple(3, 1, 10), std::make_tuple(1, 2, 20),
+                              std::make_tuple(3, 1, 5), std::make_tuple(1, 1, 7)}) {
+        int8_t c1 = k1;
+        columns[0]->insert_data((const char*)&c1, sizeof(c1));
+        int16_t c2 = k2;
+        columns[1]->insert_data((const char*)&c2, sizeof(c2));
+        int32_t c3 = v1;
+        columns[2]->insert_data((const char*)&c3, sizeof(c3));
+    }
+    res = delta_writer->write(&block, {0, 1, 2, 3});
+    EXPECT_TRUE(res.ok());
+    res = delta_writer->close();
+    EXPECT_TRUE(res.ok());
+    res = delta_writer->close_wait(PSlaveTabletNodes(), false);
+    EXPECT_TRUE(res.ok());
+
+    std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+    StorageEngine::instance()->txn_manager()->get_txn_related_tablets(
+            write_req.txn_id, write_req.partition_id, &tablet_related_rs);
+    EXPECT_EQ(1, tablet_related_rs.size());
+    if (tablet_related_rs.size() != 1) {
+        return rows;
+    }
+    RowsetSharedPtr rowset = tablet_related_rs.begin()->second;
+    std::vector<segment_v2::SegmentSharedPtr> segments;
+    res = ((BetaRowset*)rowset.get())->load_segments(&segments);
+    EXPECT_TRUE(res.ok());
+    EXPECT_EQ(1, segments.size());
+
+    OlapReaderStatistics stats;
+    StorageReadOptions opts;
+    opts.stats = &stats;
+    opts.tablet_schema = rowset->tablet_schema();
+    std::unique_ptr<RowwiseIterator> iter;
+    Schema schema(rowset->tablet_schema());
+    segments[0]->new_iterator(schema, opts, &iter);
+    auto read_block = rowset->tablet_schema()->create_block();
+    res = iter->next_batch(&read_block);
+    EXPECT_TRUE(res.ok());
+    for (size_t i = 0; i < read_block.rows(); ++i) {
+        rows.emplace_back(read_block.get_by_position(0).column->get_int(i),
+                          read_block.get_by_position(1).column->get_int(i),
+                          read_block.get_by_position(2).column->get_int(i));
+    }
+
+    res = k_engine->tablet_manager()->drop_tablet(request.tablet_id, request.replica_id, false);
+    EXPECT_TRUE(res.ok());
+    return rows;
+}
+
+TEST_F(TestDeltaWriter, vec_sequence_col_sort_on_flush) {
+    auto sort_on_flush = config::enable_memtable_sort_on_flush;
+    config::enable_memtable_sort_on_flush = true;
+    Defer defer {[&]() { config::enable_memtable_sort_on_flush = sort_on_flush; }};
+    write_and_check_sequence_col(10006, 270068378, 20004, 30004);
+}
+
+TEST_F(TestDeltaWriter, vec_dup_keys_sort_on_flush) {
+    auto sort_on_flush = config::enable_memtable_sort_on_flush;
+    config::enable_memtable_sort_on_flush = true;
+    Defer defer {[&]() { config::enable_memtable_sort_on_flush = sort_on_flush; }};
+    // the rows of the same key keep their insertion order
+    std::vector<std::tuple<int64_t, int64_t, int64_t>> expected = {
+            {1, 1, 7}, {1, 2, 20}, {3, 1, 10}, {3, 1, 5}};
+    EXPECT_EQ(expected, write_unsorted_rows(TKeysType::DUP_KEYS, 10007, 270068379, 20005, 30005));
+}
+
+TEST_F(TestDeltaWriter, vec_agg_keys_sort_on_flush) {
+    auto sort_on_flush = config::enable_memtable_sort_on_flush;
+    config::enable_memtable_sort_on_flush = true;
+    Defer defer {[&]() { config::enable_memtable_sort_on_flush = sort_on_flush; }};
+    std::vector<std::tuple<int64_t, int64_t, int64_t>> expected = {
+            {1, 1, 7}, {1, 2, 20}, {3, 1, 15}};
+    EXPECT_EQ(expected, write_unsorted_rows(TKeysType::AGG_KEYS, 10008, 270068380, 20006, 30006));
+}
+
 } // namespace doris
@@ -227,6 +227,73 @@ static void insert_LRUCache(LRUCache& cache, const CacheKey& key, int value,
                                lru_cache_tracker.get(), priority, value));
 }
 
+TEST_F(CacheTest, FrequencySketch) {
+    FrequencySketch sketch(64);
+    EXPECT_EQ(0, sketch.frequency(1));
+    for (int i = 0; i < 5; ++i) {
+        sketch.increment(1);
+    }
+    EXPECT_GE(sketch.frequency(1), 5);
+
+    // counters saturate at 15
+    for (int i = 0; i < 20; ++i) {
+        sketch.increment(2);
+    }
+    EXPECT_EQ(15, sketch.frequency(2));
+
+    // all counters are halved
+    sketch._reset();
+    EXPECT_EQ(7, sketch.frequency(2));
+}
+
+static bool lookup_LRUCache(LRUCache& cache, const CacheKey& key) {
+    uint32_t hash = key.hash(key.data(), key.size(), 0);
+    auto handle = cache.lookup(key, hash);
+    cache.release(handle);
+    return handle != nullptr;
+}
+
+TEST_F(CacheTest, TinyLFUAdmission) {
+    for (auto policy : {CacheAdmissionPolicy::LRU, CacheAdmissionPolicy::TINY_LFU}) {
+        LRUCache cache(LRUCacheType::NUMBER);
+        cache.set_capacity(10);
+        cache.set_admission_policy(policy);
+
+        // hot entries
+        std::vector<std::string> keys(10);
+        for (int i = 0; i < 10; ++i) {
+            CacheKey key = EncodeKey(&keys[i], i);
+            for (int j = 0; j < 10; ++j) {
+                if (!lookup_LRUCache(cache, key)) {
+                    insert_LRUCache(cache, key, 1, CachePriority::NORMAL);
+                }
+            }
+        }
+
+        // a scan reads each entry once
+        for (int i = 100; i < 200; ++i) {
+            std::string buf;
+            CacheKey key = EncodeKey(&buf, i);
+            EXPECT_FALSE(lookup_LRUCache(cache, key));
+            insert_LRUCache(cache, key, 1, CachePriority::NORMAL);
+        }
+        EXPECT_EQ(10, cache.get_usage());
+
+        int hot_entries = 0;
+        for (int i = 0; i < 10; ++i) {
+            std::string buf;
+            hot_entries += lookup_LRUCache(cache, EncodeKey(&buf, i));
+        }
+        if (policy == CacheAdmissionPolicy::LRU) {
+            EXPECT_EQ(0, hot_entries);
+            EXPECT_EQ(0, cache.get_admission_reject_count());
+        } else {
+            EXPECT_EQ(10, hot_entries);
+            EXPECT_EQ(100, cache.get_admission_reject_count());
+        }
+    }
+}
+
 TEST_F(CacheTest, Usage) {
     LRUCache cache(LRUCacheType::SIZE);
     cache.set_capacity(1040);
@@ -32,6 +32,7 @@
 #include "olap/rowset/rowset_writer_context.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet_schema.h"
+#include "util/threadpool.h"
 
 namespace doris {
 using namespace ErrorCode;
@@ -282,7 +283,8 @@ protected:
     void check_rowid_conversion(KeysType keys_type, bool enable_unique_key_merge_on_write,
                                 uint32_t num_input_rowset, uint32_t num_segments,
                                 uint32_t rows_per_segment, const SegmentsOverlapPB& overlap,
-                                bool has_delete_handler, bool is_vertical_merger) {
+                                bool has_delete_handler, bool is_vertical_merger,
+                                int num_key_ranges = 1) {
         // generate input data
         std::vector<std::vector<std::vector<std::tuple<int64_t, int64_t>>>> input_data;
         generate_input_data(num_input_rowset, num_segments, rows_per_segment, overlap, input_data);
@@ -308,7 +310,18 @@ protected:
         create_rowset_writer_context(tablet_schema, NONOVERLAPPING, 3456, &writer_context);
         std::unique_ptr<RowsetWriter> output_rs_writer;
         Status s;
-        if (is_vertical_merger) {
+        std::vector<Merger::KeyRange> key_ranges;
+        Merger::split_key_ranges(tablet_schema, input_rowsets, num_key_ranges, &key_ranges);
+        if (num_key_ranges > 1 && enable_unique_key_merge_on_write) {
+            // only sampled from the key bounds of the segments
+            EXPECT_GT(key_ranges.size(), 1);
+            EXPECT_LE(key_ranges.size(), num_key_ranges);
+        } else if (num_key_ranges > 1) {
+            // sampled from the short key indexes, every 1024 rows
+            EXPECT_EQ(key_ranges.size(), num_key_ranges);
+        }
+        // the output rowset of key ranges only links the segments of the range rowsets
+        if (is_vertical_merger && key_ranges.empty()) {
             s = RowsetFactory::create_rowset_writer(writer_context, true, &output_rs_writer);
         } else {
             s = RowsetFactory::create_rowset_writer(writer_context, false, &output_rs_writer);
@@ -331,7 +344,27 @@ protected:
         Merger::Statistics stats;
         RowIdConversion rowid_conversion;
         stats.rowid_conversion = &rowid_conversion;
-        if (is_vertical_merger) {
+        if (!key_ranges.empty()) {
+            std::unique_ptr<ThreadPool> thread_pool;
+            EXPECT_TRUE(ThreadPoolBuilder("CompactionKeyRangeThreadPool")
+                                .set_min_threads(num_key_ranges)
+                                .set_max_threads(num_key_ranges)
+                                .build(&thread_pool)
+                                .ok());
+            auto create_writer = [&](std::unique_ptr<RowsetWriter>* rowset_writer) {
+                RowsetWriterContext range_writer_context;
+                create_rowset_writer_context(tablet_schema, NONOVERLAPPING, 3456,
+                                             &range_writer_context);
+                range_writer_context.version = output_rs_writer->version();
+                return RowsetFactory::create_rowset_writer(range_writer_context,
+                                                           is_vertical_merger, rowset_writer);
+            };
+            s = Merger::parallel_merge_rowsets(tablet, READER_BASE_COMPACTION, tablet_schema,
+                                               input_rs_readers, key_ranges, is_vertical_merger,
+                                               10000000, thread_pool.get(), create_writer,
+                                               output_rs_writer.get(), &stats);
+            thread_pool->shutdown();
+        } else if (is_vertical_merger) {
             s = Merger::vertical_merge_rowsets(tablet, READER_BASE_COMPACTION, tablet_schema,
                                                input_rs_readers, output_rs_writer.get(), 10000000,
                                                &stats);
@@ -341,6 +374,9 @@ protected:
         }
         EXPECT_TRUE(s.ok());
         RowsetSharedPtr out_rowset = output_rs_writer->build();
+        if (!key_ranges.empty()) {
+            EXPECT_GE(out_rowset->num_segments(), key_ranges.size());
+        }
 
         // create output rowset reader
         RowsetReaderContext reader_context;
@@ -583,6 +619,14 @@ TEST_P(TestRowIdConversion, Conversion) {
                                    num_segments, rows_per_segment, overlap, has_delete_handler,
                                    is_vertical_merger);
         }
+        // Key ranges merged in parallel
+        {
+            uint32_t num_segments = 2;
+            SegmentsOverlapPB overlap = OVERLAP_UNKNOWN;
+            check_rowid_conversion(keys_type, enable_unique_key_merge_on_write, num_input_rowset,
+                                   num_segments, rows_per_segment, overlap, has_delete_handler,
+                                   is_vertical_merger, 4);
+        }
     }
 }
 
@@ -22,7 +22,9 @@
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
 #include "io/fs/local_file_system.h"
+#include "olap/block_column_predicate.h"
 #include "olap/column_block.h"
+#include "olap/comparison_predicate.h"
 #include "olap/decimal12.h"
 #include "olap/olap_common.h"
 #include "olap/rowset/segment_v2/column_reader.h"
@@ -660,6 +662,125 @@ TEST_F(ColumnReaderWriterTest, test_nullable) {
     delete[] double_vals;
 }
 
+// A predicate arriving in the middle of a scan drops the unread pages its zone map rules out.
+TEST_F(ColumnReaderWriterTest, test_prune_row_ranges) {
+    const int num_rows = 64 * 1024;
+    std::vector<int32_t> values(num_rows);
+    for (int i = 0; i < num_rows; ++i) {
+        values[i] = i;
+    }
+
+    ColumnMetaPB meta;
+    std::string fname = TEST_DIR + "/prune_row_ranges";
+    auto fs = io::global_local_filesystem();
+    {
+        io::FileWriterPtr file_writer;
+        EXPECT_TRUE(fs->create_file(fname, &file_writer).ok());
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = &meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(OLAP_FIELD_TYPE_INT);
+        writer_opts.meta->set_length(0);
+        writer_opts.meta->set_encoding(BIT_SHUFFLE);
+        writer_opts.meta->set_compression(segment_v2::CompressionTypePB::LZ4F);
+        writer_opts.meta->set_is_nullable(true);
+        writer_opts.need_zone_map = true;
+        writer_opts.data_page_size = 4096;
+
+        TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_INT);
+        std::unique_ptr<ColumnWriter> writer;
+        ColumnWriter::create(writer_opts, &column, file_writer.get(), &writer);
+        EXPECT_TRUE(writer->init().ok());
+        for (int i = 0; i < num_rows; ++i) {
+            EXPECT_TRUE(writer->append(false, &values[i]).ok());
+        }
+        EXPECT_TRUE(writer->finish().ok());
+        EXPECT_TRUE(writer->write_data().ok());
+        EXPECT_TRUE(writer->write_ordinal_index().ok());
+        EXPECT_TRUE(writer->write_zone_map().ok());
+        EXPECT_TRUE(file_writer->close().ok());
+    }
+
+    io::FileReaderSPtr file_reader;
+    ASSERT_EQ(fs->open_file(fname, &file_reader), Status::OK());
+    ColumnReaderOptions reader_opts;
+    std::unique_ptr<ColumnReader> reader;
+    ASSERT_TRUE(ColumnReader::create(reader_opts, meta, num_rows, file_reader, &reader).ok());
+
+    // the first half is read, the predicate passes the last quarter
+    const int threshold = num_rows / 4 * 3;
+    std::unique_ptr<ColumnPredicate> pred(
+            new ComparisonPredicateBase<TYPE_INT, PredicateType::GE>(0, threshold));
+    AndBlockColumnPredicate and_predicate;
+    and_predicate.add_column_predicate(new SingleColumnBlockPredicate(pred.get()));
+    RowRanges row_ranges = RowRanges::create_single(num_rows / 2, num_rows);
+    int64_t num_pruned_pages = 0;
+    ASSERT_TRUE(reader->prune_row_ranges(&and_predicate, true, false, &row_ranges,
+                                         &num_pruned_pages)
+                        .ok());
+
+    EXPECT_GT(num_pruned_pages, 0);
+    EXPECT_LT(row_ranges.count(), num_rows / 2);
+    EXPECT_GE(row_ranges.count(), num_rows - threshold);
+    EXPECT_GE(row_ranges.from(), num_rows / 2);
+    EXPECT_LE(row_ranges.from(), threshold);
+    EXPECT_EQ(num_rows, row_ranges.to());
+}
+
+// Writes `values` to a BIGINT column with the encoding chosen by the first values, and returns
+// the encoding of the column.
+static EncodingTypePB write_with_sampled_encoding(const std::vector<int64_t>& values,
+                                                  const uint8_t* null_map,
+                                                  const std::string& test_name) {
+    ColumnMetaPB meta;
+    std::string fname = TEST_DIR + "/" + test_name;
+    io::FileWriterPtr file_writer;
+    EXPECT_TRUE(io::global_local_filesystem()->create_file(fname, &file_writer).ok());
+    ColumnWriterOptions writer_opts;
+    writer_opts.meta = &meta;
+    writer_opts.meta->set_column_id(0);
+    writer_opts.meta->set_unique_id(0);
+    writer_opts.meta->set_type(OLAP_FIELD_TYPE_BIGINT);
+    writer_opts.meta->set_length(0);
+    writer_opts.meta->set_encoding(DEFAULT_ENCODING);
+    writer_opts.meta->set_compression(segment_v2::CompressionTypePB::LZ4F);
+    writer_opts.meta->set_is_nullable(null_map != nullptr);
+    writer_opts.choose_encoding_by_sample = true;
+
+    TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_BIGINT);
+    std::unique_ptr<ColumnWriter> writer;
+    ColumnWriter::create(writer_opts, &column, file_writer.get(), &writer);
+    EXPECT_TRUE(writer->init().ok());
+    EXPECT_TRUE(writer->append(null_map, values.data(), values.size()).ok());
+    EXPECT_TRUE(writer->finish().ok());
+    EXPECT_TRUE(writer->write_data().ok());
+    EXPECT_TRUE(writer->write_ordinal_index().ok());
+    EXPECT_TRUE(file_writer->close().ok());
+    return meta.encoding();
+}
+
+TEST_F(ColumnReaderWriterTest, test_choose_encoding_by_sample) {
+    const int num_rows = 4096;
+    std::vector<int64_t> timestamps(num_rows);
+    std::vector<int64_t> random_values(num_rows);
+    uint64_t seed = 42;
+    for (int i = 0; i < num_rows; ++i) {
+        timestamps[i] = 1690000000000L + i * 1000L;
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        random_values[i] = static_cast<int64_t>(seed);
+    }
+    EXPECT_EQ(DELTA_OF_DELTA_ENCODING,
+              write_with_sampled_encoding(timestamps, nullptr, "sampled_timestamps"));
+    EXPECT_EQ(BIT_SHUFFLE, write_with_sampled_encoding(random_values, nullptr, "sampled_random"));
+
+    // the nulls of the first rows do not hide the values after them
+    std::vector<uint8_t> null_map(num_rows);
+    std::fill(null_map.begin(), null_map.begin() + 100, 1);
+    EXPECT_EQ(DELTA_OF_DELTA_ENCODING,
+              write_with_sampled_encoding(timestamps, null_map.data(), "sampled_nullable"));
+}
+
 TEST_F(ColumnReaderWriterTest, test_types) {
     size_t num_uint8_rows = LOOP_LESS_OR_MORE(1024, 1024 * 1024);
     uint8_t* is_null = new uint8_t[num_uint8_rows];
@@ -0,0 +1,236 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/delta_of_delta_page.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/options.h"
+#include "vec/columns/column_vector.h"
+
+using doris::segment_v2::PageBuilderOptions;
+using doris::segment_v2::PageDecoderOptions;
+
+namespace doris {
+class DeltaOfDeltaPageTest : public testing::Test {
+public:
+    template <FieldType Type>
+    void test_encode_decode_page_template(
+            const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        using ColumnType = vectorized::ColumnVector<CppType>;
+        size_t size = src.size();
+
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        segment_v2::DeltaOfDeltaPageBuilder<Type> page_builder(builder_options);
+        // add in several batches which do not end at the block boundaries
+        for (size_t added = 0; added < size;) {
+            size_t num = std::min<size_t>(size - added, 100);
+            page_builder.add(reinterpret_cast<const uint8_t*>(src.data() + added), &num);
+            added += num;
+        }
+        EXPECT_EQ(size, page_builder.count());
+        if (size > 0) {
+            CppType first_value;
+            CppType last_value;
+            EXPECT_TRUE(page_builder.get_first_value(&first_value).ok());
+            EXPECT_TRUE(page_builder.get_last_value(&last_value).ok());
+            EXPECT_EQ(src[0], first_value);
+            EXPECT_EQ(src[size - 1], last_value);
+        }
+        OwnedSlice s = page_builder.finish();
+        LOG(INFO) << "DeltaOfDelta Encoded size for " << size << " values: " << s.slice().size
+                  << ", original size:" << size * sizeof(CppType);
+
+        PageDecoderOptions decoder_options;
+        segment_v2::DeltaOfDeltaPageDecoder<Type> page_decoder(s.slice(), decoder_options);
+        EXPECT_TRUE(page_decoder.init().ok());
+        EXPECT_EQ(0, page_decoder.current_index());
+        EXPECT_EQ(size, page_decoder.count());
+
+        // next_batch in batches of different sizes
+        vectorized::MutableColumnPtr dst = ColumnType::create();
+        size_t batch_size = 1;
+        while (page_decoder.has_remaining()) {
+            size_t n = batch_size;
+            EXPECT_TRUE(page_decoder.next_batch(&n, dst).ok());
+            batch_size = batch_size * 3 + 1;
+        }
+        auto& values = assert_cast<ColumnType&>(*dst).get_data();
+        ASSERT_EQ(size, values.size());
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_EQ(src[i], values[i]) << "Fail at index " << i;
+        }
+        if (size == 0) {
+            return;
+        }
+
+        // seek within the page by ordinal
+        for (int i = 0; i < 100; i++) {
+            size_t seek_off = random() % size;
+            EXPECT_TRUE(page_decoder.seek_to_position_in_page(seek_off).ok());
+            EXPECT_EQ(seek_off, page_decoder.current_index());
+            vectorized::MutableColumnPtr one = ColumnType::create();
+            size_t n = 1;
+            EXPECT_TRUE(page_decoder.peek_next_batch(&n, one).ok());
+            EXPECT_EQ(1, n);
+            EXPECT_EQ(seek_off, page_decoder.current_index());
+            EXPECT_EQ(src[seek_off], assert_cast<ColumnType&>(*one).get_data()[0]);
+        }
+
+        // read by rowids of a page starting from ordinal 1000
+        std::vector<rowid_t> rowids;
+        for (size_t i = 0; i < size; i += 1 + random() % 200) {
+            rowids.push_back(1000 + i);
+        }
+        vectorized::MutableColumnPtr selected = ColumnType::create();
+        size_t n = rowids.size();
+        EXPECT_TRUE(page_decoder.read_by_rowids(rowids.data(), 1000, &n, selected).ok());
+        EXPECT_EQ(rowids.size(), n);
+        auto& selected_values = assert_cast<ColumnType&>(*selected).get_data();
+        for (size_t i = 0; i < rowids.size(); i++) {
+            EXPECT_EQ(src[rowids[i] - 1000], selected_values[i]);
+        }
+    }
+};
+
+TEST_F(DeltaOfDeltaPageTest, TestInt32Random) {
+    std::vector<int32_t> ints(10000);
+    for (auto& v : ints) {
+        v = random();
+    }
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_INT>(ints);
+}
+
+TEST_F(DeltaOfDeltaPageTest, TestInt64Extremes) {
+    std::vector<int64_t> ints(1000);
+    for (size_t i = 0; i < ints.size(); i++) {
+        ints[i] = i % 2 == 0 ? std::numeric_limits<int64_t>::min()
+                             : std::numeric_limits<int64_t>::max();
+    }
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_BIGINT>(ints);
+}
+
+TEST_F(DeltaOfDeltaPageTest, TestInt8Negative) {
+    std::vector<int8_t> ints(1000);
+    for (size_t i = 0; i < ints.size(); i++) {
+        ints[i] = -static_cast<int8_t>(i % 128);
+    }
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_TINYINT>(ints);
+}
+
+TEST_F(DeltaOfDeltaPageTest, TestSmallPages) {
+    for (size_t size : {0, 1, 2, 3, 127, 128, 129, 130}) {
+        std::vector<int16_t> ints(size);
+        for (size_t i = 0; i < size; i++) {
+            ints[i] = i * i;
+        }
+        test_encode_decode_page_template<OLAP_FIELD_TYPE_SMALLINT>(ints);
+    }
+}
+
+TEST_F(DeltaOfDeltaPageTest, TestSequenceIsSmall) {
+    const size_t size = 10000;
+    std::vector<int64_t> ints(size);
+    for (size_t i = 0; i < size; i++) {
+        ints[i] = 1000000 + i * 7;
+    }
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_BIGINT>(ints);
+
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    segment_v2::DeltaOfDeltaPageBuilder<OLAP_FIELD_TYPE_BIGINT> page_builder(builder_options);
+    size_t n = size;
+    page_builder.add(reinterpret_cast<const uint8_t*>(ints.data()), &n);
+    OwnedSlice s = page_builder.finish();
+    // a constant step needs no bit for the delta-of-deltas
+    size_t num_blocks = (size + 127) / 128;
+    EXPECT_GE(4 + num_blocks * 15, s.slice().size);
+}
+
+TEST_F(DeltaOfDeltaPageTest, TestDateTimeV2Timestamps) {
+    // timestamps of events arriving about every second, with jitter
+    std::vector<uint64_t> datetimes(10000);
+    uint64_t ts = 1672531200000000L;
+    for (auto& v : datetimes) {
+        ts += 1000000 + random() % 1000;
+        v = ts;
+    }
+    test_encode_decode_page_template<OLAP_FIELD_TYPE_DATETIMEV2>(datetimes);
+}
+
+TEST_F(DeltaOfDeltaPageTest, TestSeekAtOrAfterValue) {
+    std::vector<int32_t> ints(1000);
+    for (size_t i = 0; i < ints.size(); i++) {
+        ints[i] = i * 2;
+    }
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    segment_v2::DeltaOfDeltaPageBuilder<OLAP_FIELD_TYPE_INT> page_builder(builder_options);
+    size_t n = ints.size();
+    page_builder.add(reinterpret_cast<const uint8_t*>(ints.data()), &n);
+    OwnedSlice s = page_builder.finish();
+
+    PageDecoderOptions decoder_options;
+    segment_v2::DeltaOfDeltaPageDecoder<OLAP_FIELD_TYPE_INT> page_decoder(s.slice(),
+                                                                          decoder_options);
+    EXPECT_TRUE(page_decoder.init().ok());
+
+    bool exact_match = false;
+    int32_t value = 300;
+    EXPECT_TRUE(page_decoder.seek_at_or_after_value(&value, &exact_match).ok());
+    EXPECT_TRUE(exact_match);
+    EXPECT_EQ(150, page_decoder.current_index());
+
+    value = 257;
+    EXPECT_TRUE(page_decoder.seek_at_or_after_value(&value, &exact_match).ok());
+    EXPECT_FALSE(exact_match);
+    EXPECT_EQ(129, page_decoder.current_index());
+
+    value = -1;
+    EXPECT_TRUE(page_decoder.seek_at_or_after_value(&value, &exact_match).ok());
+    EXPECT_FALSE(exact_match);
+    EXPECT_EQ(0, page_decoder.current_index());
+
+    value = 2000;
+    EXPECT_TRUE(page_decoder.seek_at_or_after_value(&value, &exact_match).is<ErrorCode::NOT_FOUND>());
+}
+
+TEST_F(DeltaOfDeltaPageTest, TestEncodingInfo) {
+    for (auto type : {OLAP_FIELD_TYPE_TINYINT, OLAP_FIELD_TYPE_SMALLINT, OLAP_FIELD_TYPE_INT,
+                      OLAP_FIELD_TYPE_BIGINT, OLAP_FIELD_TYPE_DATETIME, OLAP_FIELD_TYPE_DATEV2,
+                      OLAP_FIELD_TYPE_DATETIMEV2}) {
+        const segment_v2::EncodingInfo* encoding_info = nullptr;
+        EXPECT_TRUE(segment_v2::EncodingInfo::get(get_scalar_type_info(type),
+                                                  segment_v2::DELTA_OF_DELTA_ENCODING,
+                                                  &encoding_info)
+                            .ok());
+        EXPECT_EQ(segment_v2::DELTA_OF_DELTA_ENCODING, encoding_info->encoding());
+        // never chosen by default
+        EXPECT_NE(segment_v2::DELTA_OF_DELTA_ENCODING,
+                  segment_v2::EncodingInfo::get_default_encoding(get_scalar_type_info(type),
+                                                                 false));
+    }
+}
+
+} // namespace doris
@@ -0,0 +1,182 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/page_prefetcher.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/rowset/segment_v2/column_writer.h"
+#include "olap/tablet_schema.h"
+#include "runtime/exec_env.h"
+#include "util/threadpool.h"
+#include "vec/columns/column_vector.h"
+
+namespace doris {
+namespace segment_v2 {
+
+static const std::string TEST_DIR = "./ut_dir/page_prefetcher_test";
+
+class PagePrefetcherTest : public testing::Test {
+public:
+    void SetUp() override {
+        _enable_prefetch = config::enable_segment_page_prefetch;
+        _max_depth = config::segment_page_prefetch_max_depth;
+        config::enable_segment_page_prefetch = true;
+        config::segment_page_prefetch_max_depth = 16;
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(TEST_DIR).ok());
+
+        auto* exec_env = ExecEnv::GetInstance();
+        _origin_thread_pool = std::move(exec_env->_segment_prefetch_thread_pool);
+        static_cast<void>(ThreadPoolBuilder("SegmentPrefetchThreadPool")
+                                  .set_min_threads(2)
+                                  .set_max_threads(2)
+                                  .build(&exec_env->_segment_prefetch_thread_pool));
+    }
+
+    void TearDown() override {
+        auto* exec_env = ExecEnv::GetInstance();
+        exec_env->_segment_prefetch_thread_pool->shutdown();
+        exec_env->_segment_prefetch_thread_pool = std::move(_origin_thread_pool);
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(TEST_DIR).ok());
+        config::enable_segment_page_prefetch = _enable_prefetch;
+        config::segment_page_prefetch_max_depth = _max_depth;
+    }
+
+    // Writes an int column of `num_rows` rows valued by their ordinals, in pages of 4KB.
+    static void write_column(const std::string& fname, int num_rows, ColumnMetaPB* meta) {
+        io::FileWriterPtr file_writer;
+        EXPECT_TRUE(io::global_local_filesystem()->create_file(fname, &file_writer).ok());
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(OLAP_FIELD_TYPE_INT);
+        writer_opts.meta->set_length(0);
+        writer_opts.meta->set_encoding(BIT_SHUFFLE);
+        writer_opts.meta->set_compression(segment_v2::CompressionTypePB::LZ4F);
+        writer_opts.meta->set_is_nullable(false);
+        writer_opts.data_page_size = 4096;
+
+        TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_INT);
+        std::unique_ptr<ColumnWriter> writer;
+        ColumnWriter::create(writer_opts, &column, file_writer.get(), &writer);
+        EXPECT_TRUE(writer->init().ok());
+        for (int32_t i = 0; i < num_rows; ++i) {
+            EXPECT_TRUE(writer->append(false, &i).ok());
+        }
+        EXPECT_TRUE(writer->finish().ok());
+        EXPECT_TRUE(writer->write_data().ok());
+        EXPECT_TRUE(writer->write_ordinal_index().ok());
+        EXPECT_TRUE(file_writer->close().ok());
+    }
+
+private:
+    bool _enable_prefetch;
+    int32_t _max_depth;
+    std::unique_ptr<ThreadPool> _origin_thread_pool;
+};
+
+TEST_F(PagePrefetcherTest, GrowWhileWaiting) {
+    PagePrefetcher prefetcher(nullptr, nullptr);
+    for (int i = 0; i < 10; ++i) {
+        prefetcher._adjust_depth(true);
+    }
+    EXPECT_EQ(16, prefetcher.depth());
+}
+
+TEST_F(PagePrefetcherTest, KeepWhenAhead) {
+    PagePrefetcher prefetcher(nullptr, nullptr);
+    prefetcher._adjust_depth(true);
+    prefetcher._adjust_depth(true);
+    ASSERT_EQ(4, prefetcher.depth());
+    // the pages are read before the iterator needs them
+    for (int i = 0; i < 10; ++i) {
+        prefetcher._adjust_depth(false);
+    }
+    EXPECT_EQ(4, prefetcher.depth());
+}
+
+TEST_F(PagePrefetcherTest, ShrinkOnWaste) {
+    PagePrefetcher prefetcher(nullptr, nullptr);
+    for (int i = 0; i < 10; ++i) {
+        prefetcher._adjust_depth(true);
+    }
+    ASSERT_EQ(16, prefetcher.depth());
+
+    // the iterator skipped prefetched pages
+    prefetcher._wasted_pages = 3;
+    prefetcher._adjust_depth(true);
+    EXPECT_EQ(8, prefetcher.depth());
+    EXPECT_EQ(0, prefetcher._wasted_pages);
+}
+
+// The pages of two row ranges are read in the thread pool and handed over to the iterator,
+// none of them is read twice.
+TEST_F(PagePrefetcherTest, ReadAheadInRowRanges) {
+    const int num_rows = 64 * 1024;
+    const std::string fname = TEST_DIR + "/read_ahead";
+    ColumnMetaPB meta;
+    write_column(fname, num_rows, &meta);
+
+    io::FileReaderSPtr file_reader;
+    ASSERT_TRUE(io::global_local_filesystem()->open_file(fname, &file_reader).ok());
+    ColumnReaderOptions reader_opts;
+    std::unique_ptr<ColumnReader> reader;
+    ASSERT_TRUE(ColumnReader::create(reader_opts, meta, num_rows, file_reader, &reader).ok());
+    ColumnIterator* iter_ptr = nullptr;
+    ASSERT_TRUE(reader->new_iterator(&iter_ptr).ok());
+    std::unique_ptr<ColumnIterator> iter(iter_ptr);
+
+    ColumnIteratorOptions iter_opts;
+    OlapReaderStatistics stats;
+    iter_opts.stats = &stats;
+    iter_opts.file_reader = file_reader.get();
+    ASSERT_TRUE(iter->init(iter_opts).ok());
+
+    RowRanges row_ranges;
+    row_ranges.add(RowRange(1000, 20000));
+    row_ranges.add(RowRange(40000, 50000));
+    ASSERT_TRUE(iter->init_prefetcher(row_ranges).ok());
+
+    for (size_t i = 0; i < row_ranges.range_size(); ++i) {
+        int64_t from = row_ranges.get_range_from(i);
+        int64_t to = row_ranges.get_range_to(i);
+        ASSERT_TRUE(iter->seek_to_ordinal(from).ok());
+        for (int64_t rowid = from; rowid < to;) {
+            size_t rows_read = std::min<int64_t>(1000, to - rowid);
+            vectorized::MutableColumnPtr dst = vectorized::ColumnInt32::create();
+            bool has_null = false;
+            ASSERT_TRUE(iter->next_batch(&rows_read, dst, &has_null).ok());
+            ASSERT_GT(rows_read, 0);
+            const auto& data = assert_cast<vectorized::ColumnInt32&>(*dst).get_data();
+            for (size_t j = 0; j < rows_read; ++j) {
+                ASSERT_EQ(rowid + j, data[j]);
+            }
+            rowid += rows_read;
+        }
+    }
+
+    EXPECT_GT(stats.prefetched_pages_num, 0);
+    EXPECT_EQ(stats.prefetched_pages_num, stats.total_pages_num);
+    EXPECT_EQ(0, stats.prefetch_wasted_pages_num);
+}
+
+} // namespace segment_v2
+} // namespace doris
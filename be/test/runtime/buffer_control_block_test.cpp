@@ -0,0 +1,184 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/buffer_control_block.h"
+
+#include <arrow/array.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gen_cpp/internal_service.pb.h"
+#include "runtime/result_buffer_mgr.h"
+#include "util/arrow/block_convertor.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris {
+
+class BufferControlBlockTest : public testing::Test {
+protected:
+    class FetchDoneClosure : public google::protobuf::Closure {
+    public:
+        void Run() override {
+            std::lock_guard<std::mutex> l(_lock);
+            _done = true;
+            _cv.notify_all();
+        }
+
+        void wait() {
+            std::unique_lock<std::mutex> l(_lock);
+            _cv.wait(l, [this] { return _done; });
+        }
+
+    private:
+        std::mutex _lock;
+        std::condition_variable _cv;
+        bool _done = false;
+    };
+
+    static std::shared_ptr<arrow::Schema> make_schema() {
+        return arrow::schema({arrow::field("k1", arrow::int32(), false),
+                              arrow::field("v1", arrow::utf8(), true)});
+    }
+
+    // Rows [begin, begin + num_rows), where v1 of every third row is null.
+    static std::shared_ptr<arrow::RecordBatch> make_batch(int begin, int num_rows) {
+        auto k1 = vectorized::ColumnInt32::create();
+        auto v1 = vectorized::ColumnNullable::create(vectorized::ColumnString::create(),
+                                                     vectorized::ColumnUInt8::create());
+        for (int i = begin; i < begin + num_rows; ++i) {
+            k1->insert_value(i);
+            if (i % 3 == 0) {
+                v1->insert_default();
+            } else {
+                std::string value = "value_" + std::to_string(i);
+                v1->insert_data(value.data(), value.size());
+            }
+        }
+        vectorized::Block block(
+                {{k1->get_ptr(), std::make_shared<vectorized::DataTypeInt32>(), "k1"},
+                 {v1->get_ptr(),
+                  vectorized::make_nullable(std::make_shared<vectorized::DataTypeString>()),
+                  "v1"}});
+        std::shared_ptr<arrow::RecordBatch> batch;
+        EXPECT_TRUE(
+                convert_to_arrow_batch(block, make_schema(), arrow::default_memory_pool(), &batch)
+                        .ok());
+        return batch;
+    }
+
+    // Fetches all results of a fragment instance the way a client of
+    // PBackendService::fetch_data does, decoding each Arrow IPC stream.
+    static void fetch_all(ResultBufferMgr* mgr, const TUniqueId& finst_id,
+                          std::vector<std::shared_ptr<arrow::RecordBatch>>* batches) {
+        PUniqueId pfinst_id;
+        pfinst_id.set_hi(finst_id.hi);
+        pfinst_id.set_lo(finst_id.lo);
+        for (int64_t packet_seq = 0;; ++packet_seq) {
+            PFetchDataResult result;
+            FetchDoneClosure done;
+            mgr->fetch_data(pfinst_id, new GetResultBatchCtx(nullptr, &result, &done));
+            done.wait();
+            ASSERT_TRUE(Status(result.status()).ok());
+            ASSERT_EQ(packet_seq, result.packet_seq());
+            if (result.eos()) {
+                return;
+            }
+            ASSERT_TRUE(result.has_arrow_batch());
+            ASSERT_FALSE(result.has_row_batch());
+            auto buffer = std::make_shared<arrow::io::BufferReader>(
+                    arrow::Buffer::FromString(result.arrow_batch()));
+            auto reader = arrow::ipc::RecordBatchStreamReader::Open(buffer);
+            ASSERT_TRUE(reader.ok());
+            std::shared_ptr<arrow::RecordBatch> batch;
+            ASSERT_TRUE(reader.ValueOrDie()->ReadNext(&batch).ok());
+            ASSERT_NE(nullptr, batch);
+            batches->push_back(batch);
+        }
+    }
+};
+
+// Two fragment instances produce Arrow batches while a client fetches both in parallel.
+TEST_F(BufferControlBlockTest, FetchArrowBatchesInParallel) {
+    constexpr int num_instances = 2;
+    constexpr int num_batches = 20;
+    constexpr int batch_rows = 1000;
+    ResultBufferMgr mgr;
+    std::vector<TUniqueId> finst_ids(num_instances);
+    std::vector<std::shared_ptr<BufferControlBlock>> senders(num_instances);
+    for (int i = 0; i < num_instances; ++i) {
+        finst_ids[i].hi = 100;
+        finst_ids[i].lo = i;
+        // a small buffer, so that the producers wait for the client
+        ASSERT_TRUE(mgr.create_sender(finst_ids[i], 2 * batch_rows, &senders[i], false, 300)
+                            .ok());
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_instances; ++i) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < num_batches; ++j) {
+                EXPECT_TRUE(senders[i]->add_arrow_batch(make_batch(j * batch_rows, batch_rows))
+                                    .ok());
+            }
+            EXPECT_TRUE(senders[i]->close(Status::OK()).ok());
+        });
+    }
+    std::vector<std::vector<std::shared_ptr<arrow::RecordBatch>>> fetched(num_instances);
+    for (int i = 0; i < num_instances; ++i) {
+        threads.emplace_back([&, i] { fetch_all(&mgr, finst_ids[i], &fetched[i]); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < num_instances; ++i) {
+        ASSERT_EQ(num_batches, fetched[i].size());
+        for (int j = 0; j < num_batches; ++j) {
+            EXPECT_TRUE(fetched[i][j]->schema()->Equals(*make_schema()));
+            EXPECT_TRUE(fetched[i][j]->Equals(*make_batch(j * batch_rows, batch_rows)));
+        }
+    }
+}
+
+TEST_F(BufferControlBlockTest, CancelWakesUpArrowProducer) {
+    BufferControlBlock sender(TUniqueId(), 1);
+    ASSERT_TRUE(sender.add_arrow_batch(make_batch(0, 10)).ok());
+    std::thread producer([&] {
+        // the buffer is full, so this waits until cancelled
+        EXPECT_EQ(ErrorCode::CANCELLED, sender.add_arrow_batch(make_batch(10, 10)).code());
+    });
+    ASSERT_TRUE(sender.cancel().ok());
+    producer.join();
+}
+
+} // namespace doris
@@ -0,0 +1,130 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/task_group/task_group.h"
+
+#include <gen_cpp/PaloInternalService_types.h>
+#include <gtest/gtest.h>
+
+#include "pipeline/task_queue.h"
+#include "runtime/task_group/task_group_manager.h"
+#include "util/time.h"
+
+namespace doris::taskgroup {
+
+static constexpr int64_t WINDOW_NS = 100 * NANOS_PER_MILLIS;
+
+TEST(TaskGroupTest, IsThrottled) {
+    TaskGroup tg(100, "throttled_tg", 64, 50);
+    auto* entity = tg.task_entity();
+    const int64_t quota_ns = 50 * NANOS_PER_MILLIS;
+
+    EXPECT_FALSE(entity->is_throttled(10 * NANOS_PER_MILLIS, WINDOW_NS, 0));
+    entity->incr_runtime_ns(30 * NANOS_PER_MILLIS);
+    EXPECT_FALSE(entity->is_throttled(10 * NANOS_PER_MILLIS, WINDOW_NS, quota_ns));
+    entity->incr_runtime_ns(40 * NANOS_PER_MILLIS);
+    EXPECT_TRUE(entity->is_throttled(20 * NANOS_PER_MILLIS, WINDOW_NS, quota_ns));
+    EXPECT_TRUE(entity->is_throttled(50 * NANOS_PER_MILLIS, WINDOW_NS, quota_ns));
+    // counted once per window
+    EXPECT_EQ(1, tg.task_group_throttled_count->value());
+    // no limit
+    EXPECT_FALSE(entity->is_throttled(50 * NANOS_PER_MILLIS, WINDOW_NS, 0));
+
+    // the 20ms over the quota are charged to the next window
+    EXPECT_FALSE(entity->is_throttled(100 * NANOS_PER_MILLIS, WINDOW_NS, quota_ns));
+    EXPECT_EQ(20 * NANOS_PER_MILLIS, entity->_window_runtime_ns);
+
+    // a task overruns its time slice: 220ms in a window of 50ms quota, after two windows
+    // 120ms are still to be charged
+    entity->incr_runtime_ns(200 * NANOS_PER_MILLIS);
+    EXPECT_TRUE(entity->is_throttled(150 * NANOS_PER_MILLIS, WINDOW_NS, quota_ns));
+    EXPECT_TRUE(entity->is_throttled(300 * NANOS_PER_MILLIS, WINDOW_NS, quota_ns));
+    EXPECT_EQ(120 * NANOS_PER_MILLIS, entity->_window_runtime_ns);
+    EXPECT_EQ(400 * NANOS_PER_MILLIS, entity->window_end_ns(WINDOW_NS));
+    EXPECT_EQ(3, tg.task_group_throttled_count->value());
+
+    // nothing is carried over when the idle windows cover the overrun
+    EXPECT_FALSE(entity->is_throttled(1000 * NANOS_PER_MILLIS, WINDOW_NS, quota_ns));
+    EXPECT_EQ(0, entity->_window_runtime_ns);
+}
+
+TEST(TaskGroupTest, CpuQuotaOfTaskQueue) {
+    pipeline::TaskGroupTaskQueue queue(8);
+    TaskGroup limited(101, "limited_tg", 64, 25);
+    TaskGroup unlimited(102, "unlimited_tg", 64, 0);
+    // 25% of 8 cores for 100ms
+    EXPECT_EQ(200 * NANOS_PER_MILLIS, queue._cpu_quota_ns(limited.task_entity(), WINDOW_NS));
+    EXPECT_EQ(0, queue._cpu_quota_ns(unlimited.task_entity(), WINDOW_NS));
+
+    // the limited group has the min vruntime but has used up its quota
+    limited.task_entity()->incr_runtime_ns(250 * NANOS_PER_MILLIS);
+    unlimited.task_entity()->incr_runtime_ns(300 * NANOS_PER_MILLIS);
+    queue._enqueue_task_group<true>(limited.task_entity());
+    queue._enqueue_task_group<true>(unlimited.task_entity());
+    int64_t now_ns = limited.task_entity()->window_end_ns(WINDOW_NS) - 1;
+    int64_t wake_up_ns = now_ns + WINDOW_NS * 10;
+    EXPECT_EQ(unlimited.task_entity(), queue._next_tg_entity(now_ns, &wake_up_ns));
+    EXPECT_EQ(limited.task_entity()->window_end_ns(WINDOW_NS), wake_up_ns);
+
+    // the executors wait until the first window ends if all the groups are throttled
+    unlimited.set_cpu_hard_limit(10);
+    wake_up_ns = now_ns + WINDOW_NS * 10;
+    EXPECT_EQ(nullptr, queue._next_tg_entity(now_ns, &wake_up_ns));
+    EXPECT_EQ(limited.task_entity()->window_end_ns(WINDOW_NS), wake_up_ns);
+
+    queue._dequeue_task_group(limited.task_entity());
+    queue._dequeue_task_group(unlimited.task_entity());
+}
+
+TEST(TaskGroupTest, QueueWaitHistogram) {
+    TaskGroup tg(103, "wait_tg", 64);
+    auto* entity = tg.task_entity();
+    entity->push_back(nullptr);
+    entity->push_back(nullptr);
+    EXPECT_EQ(nullptr, entity->take());
+    EXPECT_EQ(nullptr, entity->take());
+    EXPECT_EQ(nullptr, entity->take());
+    EXPECT_EQ(2, tg.task_group_queue_wait_us->num());
+    EXPECT_EQ(2, tg.task_group_scheduled_tasks->value());
+}
+
+TEST(TaskGroupTest, TaskGroupFromFragmentParams) {
+    TPipelineTaskGroup resource_group;
+    TaskGroupInfo info;
+    EXPECT_FALSE(TaskGroupInfo::parse_group_info(resource_group, &info).ok());
+    resource_group.__set_id(104);
+    resource_group.__set_name("fe_tg");
+    resource_group.__set_cpu_share(32);
+    resource_group.__set_cpu_hard_limit(101);
+    EXPECT_FALSE(TaskGroupInfo::parse_group_info(resource_group, &info).ok());
+    resource_group.__set_cpu_hard_limit(30);
+    ASSERT_TRUE(TaskGroupInfo::parse_group_info(resource_group, &info).ok());
+
+    auto* manager = TaskGroupManager::instance();
+    auto tg = manager->get_or_create_task_group(info);
+    EXPECT_EQ(104, tg->id());
+    EXPECT_EQ(32, tg->share());
+    EXPECT_EQ(30, tg->cpu_hard_limit());
+    EXPECT_EQ(tg, manager->get_task_group(104));
+
+    // the limit of an existing group follows the latest params
+    info.cpu_hard_limit = 60;
+    EXPECT_EQ(tg, manager->get_or_create_task_group(info));
+    EXPECT_EQ(60, tg->cpu_hard_limit());
+}
+
+} // namespace doris::taskgroup
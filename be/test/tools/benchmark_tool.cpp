@@ -23,14 +23,22 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <queue>
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "common/compiler_util.h"
+#include "common/config.h"
 #include "common/logging.h"
+#include "common/object_pool.h"
+#include "exec/text_converter.h"
+#include "exec/text_converter.hpp"
 #include "gutil/strings/split.h"
 #include "gutil/strings/substitute.h"
 #include "io/fs/file_system.h"
@@ -39,27 +47,43 @@
 #include "olap/comparison_predicate.h"
 #include "olap/data_dir.h"
 #include "olap/in_list_predicate.h"
+#include "olap/memtable.h"
 #include "olap/olap_common.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/rowset_writer.h"
 #include "olap/rowset/segment_v2/binary_dict_page.h"
 #include "olap/rowset/segment_v2/binary_plain_page.h"
+#include "olap/rowset/segment_v2/encoding_info.h"
 #include "olap/rowset/segment_v2/page_builder.h"
 #include "olap/rowset/segment_v2/page_decoder.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/tablet.h"
 #include "olap/tablet_schema.h"
 #include "olap/tablet_schema_helper.h"
 #include "olap/types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
 #include "testutil/test_util.h"
 #include "util/debug_util.h"
+#include "util/runtime_profile.h"
+#include "util/work_stealing_deque.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/arena.h"
+#include "vec/core/sort_cursor.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/runtime/vsorted_run_merger.h"
 
 DEFINE_string(operation, "Custom",
               "valid operation: Custom, BinaryDictPageEncode, BinaryDictPageDecode, SegmentScan, "
               "SegmentWrite, "
-              "SegmentScanByFile, SegmentWriteByFile");
+              "SegmentScanByFile, SegmentWriteByFile, LocalFileBatchRead, RunQueue, MemTableLoad, "
+              "SortedRunMerge, CsvColumnParse");
 DEFINE_string(input_file, "./sample.dat", "input file directory");
 DEFINE_string(column_type, "int,varchar", "valid type: int, char, varchar, string");
 DEFINE_string(rows_number, "10000", "rows number");
+DEFINE_string(batch_size, "32", "number of reads in one batch of LocalFileBatchRead");
+DEFINE_string(threads, "16", "number of executor threads of RunQueue");
 DEFINE_string(iterations, "10",
               "run times, this is set to 0 means the number of iterations is automatically set ");
 
@@ -84,6 +108,15 @@ std::string get_usage(const std::string& progname) {
           "--iterations=10\n";
     ss << "./benchmark_tool --operation=SegmentWriteByFile --input_file=./sample.dat "
           "--iterations=10\n";
+    ss << "./benchmark_tool --operation=TimestampPageDecode --rows_number=1000000 "
+          "--iterations=10\n";
+    ss << "./benchmark_tool --operation=LocalFileBatchRead --input_file=/path/on/nvme/big.dat "
+          "--batch_size=32 --iterations=100\n";
+    ss << "./benchmark_tool --operation=RunQueue --rows_number=10000 --threads=16 "
+          "--iterations=10\n";
+    ss << "./benchmark_tool --operation=MemTableLoad --rows_number=1000000 --iterations=10\n";
+    ss << "./benchmark_tool --operation=SortedRunMerge --rows_number=1000000 --iterations=10\n";
+    ss << "./benchmark_tool --operation=CsvColumnParse --rows_number=1000000 --iterations=10\n";
 
     ss << "Sampe data file format: \n"
        << "The first line defines Shcema\n"
@@ -495,6 +528,395 @@ private:
     OlapReaderStatistics stats;
 };
 
+// Decodes the data pages of a column of event timestamps, encoded with
+// BIT_SHUFFLE (bitshuffle + lz4) or DELTA_OF_DELTA_ENCODING.
+class TimestampPageDecodeBenchmark : public BaseBenchmark {
+public:
+    TimestampPageDecodeBenchmark(const std::string& name, int iterations, int rows_number,
+                                 EncodingTypePB encoding)
+            : BaseBenchmark(name, iterations) {
+        add_name(std::string(encoding == BIT_SHUFFLE ? "/bitshuffle" : "/delta_of_delta") +
+                 "/rows_number:" + std::to_string(rows_number));
+        auto st = EncodingInfo::get(get_scalar_type_info<OLAP_FIELD_TYPE_BIGINT>(), encoding,
+                                    &_encoding_info);
+        assert(st.ok());
+
+        // about one event per millisecond, with jitter
+        std::mt19937_64 rng(0);
+        std::vector<int64_t> values(rows_number);
+        int64_t ts = 1672531200000;
+        for (auto& v : values) {
+            ts += rng() % 2;
+            v = ts;
+        }
+
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 64 * 1024;
+        PageBuilder* builder_ptr = nullptr;
+        st = _encoding_info->create_page_builder(builder_options, &builder_ptr);
+        assert(st.ok());
+        std::unique_ptr<PageBuilder> builder(builder_ptr);
+        size_t total_size = 0;
+        for (size_t i = 0; i < values.size();) {
+            size_t num = std::min<size_t>(values.size() - i, 1024);
+            builder->add(reinterpret_cast<const uint8_t*>(values.data() + i), &num);
+            i += num;
+            if (builder->is_page_full() || i == values.size()) {
+                OwnedSlice page = builder->finish();
+                total_size += page.slice().size;
+                _pages.emplace_back(std::move(page));
+                builder->reset();
+            }
+        }
+        std::cout << EncodingTypePB_Name(_encoding_info->encoding()) << " encoded " << rows_number
+                  << " rows into " << _pages.size() << " pages of " << total_size << " bytes"
+                  << std::endl;
+    }
+    virtual ~TimestampPageDecodeBenchmark() override {}
+
+    virtual void run() override {
+        auto column = vectorized::ColumnInt64::create();
+        vectorized::MutableColumnPtr dst = std::move(column);
+        for (auto& page : _pages) {
+            // like PageIO, the pre-decoder works on a copy of the page read from the file
+            Slice page_slice = page.slice();
+            std::unique_ptr<char[]> page_data(new char[page_slice.size]);
+            memcpy(page_data.get(), page_slice.data, page_slice.size);
+            page_slice.data = page_data.get();
+            if (auto pre_decoder = _encoding_info->get_data_page_pre_decoder()) {
+                auto st = pre_decoder->decode(&page_data, &page_slice, 0);
+                assert(st.ok());
+            }
+
+            PageDecoder* decoder_ptr = nullptr;
+            auto st = _encoding_info->create_page_decoder(page_slice, PageDecoderOptions(),
+                                                          &decoder_ptr);
+            assert(st.ok());
+            std::unique_ptr<PageDecoder> decoder(decoder_ptr);
+            st = decoder->init();
+            assert(st.ok());
+            while (decoder->has_remaining()) {
+                size_t n = 4096;
+                st = decoder->next_batch(&n, dst);
+                assert(st.ok());
+            }
+        }
+    }
+
+private:
+    const EncodingInfo* _encoding_info = nullptr;
+    std::vector<OwnedSlice> _pages;
+};
+
+// Random 64KB reads of a local file in batches, with pread or io_uring.
+// The file should be much larger than the page cache of the OS.
+class LocalFileBatchReadBenchmark : public BaseBenchmark {
+public:
+    LocalFileBatchReadBenchmark(const std::string& name, int iterations,
+                                const std::string& file_str, int batch_size, bool use_io_uring)
+            : BaseBenchmark(name, iterations), _batch_size(batch_size),
+              _use_io_uring(use_io_uring) {
+        auto st = io::global_local_filesystem()->open_file(file_str, &_file_reader);
+        assert(st.ok());
+        assert(_file_reader->size() > kReadSize);
+        _buffer.reset(new char[kReadSize * _batch_size]);
+        add_name(std::string(use_io_uring ? "/io_uring" : "/pread") +
+                 "/batch_size:" + std::to_string(batch_size));
+    }
+    virtual ~LocalFileBatchReadBenchmark() override {}
+
+    virtual void init() override {
+        _requests.resize(_batch_size);
+        std::uniform_int_distribution<size_t> dist(0, _file_reader->size() / kReadSize - 1);
+        for (int i = 0; i < _batch_size; ++i) {
+            _requests[i].offset = dist(_rng) * kReadSize;
+            _requests[i].result = Slice(_buffer.get() + i * kReadSize, kReadSize);
+            _requests[i].bytes_read = 0;
+        }
+    }
+    virtual void run() override {
+        config::enable_io_uring = _use_io_uring;
+        auto st = _file_reader->read_batch_at(&_requests);
+        assert(st.ok());
+    }
+
+private:
+    static constexpr size_t kReadSize = 64 * 1024;
+
+    int _batch_size;
+    bool _use_io_uring;
+    io::FileReaderSPtr _file_reader;
+    std::unique_ptr<char[]> _buffer;
+    std::vector<io::ReadRequest> _requests;
+    std::mt19937_64 _rng {0};
+};
+
+// Runs short tasks on the run queues of the pipeline executors: every task is put back to the
+// queue of the executor that ran it until it has run `kSlicesPerTask` times, like a pipeline
+// task yielding after its time slice. All the tasks are first pushed to the queue of the first
+// executor, so the others have to steal them.
+// The "mutex" queues are locked queues stolen round robin like NormalTaskQueue, the
+// "work_stealing" queues are the lock-free deques with random stealing of
+// WorkStealingTaskQueue.
+class RunQueueBenchmark : public BaseBenchmark {
+public:
+    RunQueueBenchmark(const std::string& name, int iterations, int num_tasks, int num_threads,
+                      bool work_stealing)
+            : BaseBenchmark(name, iterations),
+              _num_tasks(num_tasks),
+              _num_threads(num_threads),
+              _work_stealing(work_stealing) {
+        add_name(std::string(work_stealing ? "/work_stealing" : "/mutex") +
+                 "/threads:" + std::to_string(num_threads) +
+                 "/tasks:" + std::to_string(num_tasks));
+    }
+    virtual ~RunQueueBenchmark() override {}
+
+    virtual void init() override {
+        _tasks.assign(_num_tasks, kSlicesPerTask);
+        _finished = 0;
+        _mutex_queues.clear();
+        _deques.clear();
+        for (int i = 0; i < _num_threads; ++i) {
+            _mutex_queues.emplace_back(new MutexQueue());
+            _deques.emplace_back(new WorkStealingDeque<int*>());
+        }
+        for (auto& task : _tasks) {
+            _push(0, &task);
+        }
+    }
+
+    virtual void run() override {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < _num_threads; ++i) {
+            threads.emplace_back([this, i] { _work(i); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    static constexpr int kSlicesPerTask = 8;
+
+    struct MutexQueue {
+        std::mutex mutex;
+        std::queue<int*> queue;
+    };
+
+    void _push(int id, int* task) {
+        if (_work_stealing) {
+            _deques[id]->push(task);
+        } else {
+            std::lock_guard<std::mutex> l(_mutex_queues[id]->mutex);
+            _mutex_queues[id]->queue.push(task);
+        }
+    }
+
+    int* _take(int id, std::mt19937& rng) {
+        if (_work_stealing) {
+            if (auto* task = _deques[id]->steal()) {
+                return task;
+            }
+            int start = rng() % _num_threads;
+            for (int i = 0; i < _num_threads; ++i) {
+                if (auto* task = _deques[(start + i) % _num_threads]->steal()) {
+                    return task;
+                }
+            }
+            return nullptr;
+        }
+        for (int i = 0; i < _num_threads; ++i) {
+            auto& queue = *_mutex_queues[(id + i) % _num_threads];
+            std::lock_guard<std::mutex> l(queue.mutex);
+            if (!queue.queue.empty()) {
+                auto* task = queue.queue.front();
+                queue.queue.pop();
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void _work(int id) {
+        std::mt19937 rng(id);
+        while (_finished.load(std::memory_order_relaxed) < _num_tasks) {
+            auto* task = _take(id, rng);
+            if (!task) {
+                continue;
+            }
+            // a slice of work
+            uint64_t x = id;
+            for (int i = 0; i < 1000; ++i) {
+                x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            }
+            benchmark::DoNotOptimize(x);
+            if (--*task > 0) {
+                _push(id, task);
+            } else {
+                _finished.fetch_add(1);
+            }
+        }
+    }
+
+    int _num_tasks;
+    int _num_threads;
+    bool _work_stealing;
+    std::vector<int> _tasks;
+    std::atomic<int> _finished = 0;
+    std::vector<std::unique_ptr<MutexQueue>> _mutex_queues;
+    std::vector<std::unique_ptr<WorkStealingDeque<int*>>> _deques;
+};
+
+// Loads rows of (k1 INT, k2 BIGINT, v1 BIGINT) into a memtable in blocks of 4096 rows, like a
+// stream load, and flushes it, with the skiplist or with sort-on-flush. For the unique key
+// model, every key is loaded 4 times on average.
+class MemTableLoadBenchmark : public BaseBenchmark {
+public:
+    MemTableLoadBenchmark(const std::string& name, int iterations, int rows_number,
+                          KeysType keys_type, bool sort_on_flush)
+            : BaseBenchmark(name, iterations),
+              _keys_type(keys_type),
+              _sort_on_flush(sort_on_flush) {
+        add_name(std::string(keys_type == DUP_KEYS ? "/dup_keys" : "/unique_keys") +
+                 (sort_on_flush ? "/sort_on_flush" : "/skiplist") +
+                 "/rows_number:" + std::to_string(rows_number));
+        _create_tablet();
+
+        std::mt19937_64 rng(0);
+        std::uniform_int_distribution<int32_t> key_dist(0, std::max(rows_number / 4, 1));
+        for (int rows = 0; rows < rows_number; rows += kBlockRows) {
+            vectorized::Block block;
+            for (auto* slot_desc : _tuple_desc->slots()) {
+                block.insert({slot_desc->get_empty_mutable_column(),
+                              slot_desc->get_data_type_ptr(), slot_desc->col_name()});
+            }
+            auto columns = block.mutate_columns();
+            int n = std::min(kBlockRows, rows_number - rows);
+            for (int i = 0; i < n; ++i) {
+                int32_t k1 = key_dist(rng);
+                int64_t k2 = k1 % 1000;
+                int64_t v1 = rng();
+                columns[0]->insert_data((const char*)&k1, sizeof(k1));
+                columns[1]->insert_data((const char*)&k2, sizeof(k2));
+                columns[2]->insert_data((const char*)&v1, sizeof(v1));
+            }
+            _blocks.emplace_back(std::move(block));
+        }
+        _row_idxs.resize(kBlockRows);
+        std::iota(_row_idxs.begin(), _row_idxs.end(), 0);
+    }
+    virtual ~MemTableLoadBenchmark() override {}
+
+    virtual void init() override {
+        config::enable_memtable_sort_on_flush = _sort_on_flush;
+        _memtable.reset();
+        _memtable = std::make_unique<MemTable>(
+                _tablet, _schema.get(), _tablet->tablet_schema().get(), &_tuple_desc->slots(),
+                _tuple_desc, &_rowset_writer, nullptr, RowsetIdUnorderedSet(), 0,
+                std::make_shared<MemTracker>("MemTableLoadBenchmark:insert"),
+                std::make_shared<MemTracker>("MemTableLoadBenchmark:flush"));
+    }
+
+    virtual void run() override {
+        for (auto& block : _blocks) {
+            std::vector<int> row_idxs(_row_idxs.begin(), _row_idxs.begin() + block.rows());
+            _memtable->insert(&block, row_idxs);
+        }
+        auto st = _memtable->flush();
+        assert(st.ok());
+    }
+
+private:
+    static constexpr int kBlockRows = 4096;
+
+    // only counts the flushed rows
+    class NullRowsetWriter : public RowsetWriter {
+    public:
+        Status init(const RowsetWriterContext&) override { return Status::OK(); }
+        Status add_rowset(RowsetSharedPtr) override { return Status::OK(); }
+        Status add_rowset_for_linked_schema_change(RowsetSharedPtr) override {
+            return Status::OK();
+        }
+        Status flush() override { return Status::OK(); }
+        Status flush_single_memtable(const vectorized::Block* block, int64_t* flush_size) override {
+            _num_rows += block->rows();
+            *flush_size = block->bytes();
+            return Status::OK();
+        }
+        RowsetSharedPtr build() override { return nullptr; }
+        RowsetSharedPtr build_tmp() override { return nullptr; }
+        RowsetSharedPtr manual_build(const RowsetMetaSharedPtr&) override { return nullptr; }
+        Version version() override { return Version(); }
+        int64_t num_rows() const override { return _num_rows; }
+        RowsetId rowset_id() override { return RowsetId(); }
+        RowsetTypePB type() const override { return BETA_ROWSET; }
+        int32_t get_atomic_num_segment() const override { return 0; }
+        bool is_doing_segcompaction() const override { return false; }
+        Status wait_flying_segcompaction() override { return Status::OK(); }
+
+    private:
+        int64_t _num_rows = 0;
+    };
+
+    void _create_tablet() {
+        std::vector<TColumn> cols;
+        std::unordered_map<uint32_t, uint32_t> col_ordinal_to_unique_id;
+        TTupleDescriptorBuilder tuple_builder;
+        for (auto [name, type, is_key] : {std::make_tuple("k1", TYPE_INT, true),
+                                          std::make_tuple("k2", TYPE_BIGINT, true),
+                                          std::make_tuple("v1", TYPE_BIGINT, false)}) {
+            TColumn col;
+            col.column_type.type = type == TYPE_INT ? TPrimitiveType::INT : TPrimitiveType::BIGINT;
+            col.__set_column_name(name);
+            col.__set_is_key(is_key);
+            col.__set_is_allow_null(false);
+            if (!is_key) {
+                col.__set_aggregation_type(_keys_type == UNIQUE_KEYS ? TAggregationType::REPLACE
+                                                                     : TAggregationType::NONE);
+            }
+            col_ordinal_to_unique_id[cols.size()] = cols.size();
+            tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                           .type(type)
+                                           .nullable(false)
+                                           .column_name(name)
+                                           .column_pos(cols.size())
+                                           .build());
+            cols.push_back(col);
+        }
+        TTabletSchema t_tablet_schema;
+        t_tablet_schema.__set_short_key_column_count(2);
+        t_tablet_schema.__set_schema_hash(3333);
+        t_tablet_schema.__set_keys_type(_keys_type == UNIQUE_KEYS ? TKeysType::UNIQUE_KEYS
+                                                                  : TKeysType::DUP_KEYS);
+        t_tablet_schema.__set_storage_type(TStorageType::COLUMN);
+        t_tablet_schema.__set_columns(cols);
+        TabletMetaSharedPtr tablet_meta(new TabletMeta(
+                1, 1, 1, 1, 1, 1, t_tablet_schema, cols.size(), col_ordinal_to_unique_id,
+                UniqueId(1, 2), TTabletType::TABLET_TYPE_DISK, TCompressionType::LZ4F));
+        _tablet.reset(new Tablet(tablet_meta, nullptr));
+        _schema = std::make_unique<Schema>(_tablet->tablet_schema());
+
+        TDescriptorTableBuilder dtb;
+        tuple_builder.build(&dtb);
+        auto st = DescriptorTbl::create(&_pool, dtb.desc_tbl(), &_desc_tbl);
+        assert(st.ok());
+        _tuple_desc = _desc_tbl->get_tuple_descriptor(0);
+    }
+
+    KeysType _keys_type;
+    bool _sort_on_flush;
+    TabletSharedPtr _tablet;
+    std::unique_ptr<Schema> _schema;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    TupleDescriptor* _tuple_desc = nullptr;
+    NullRowsetWriter _rowset_writer;
+    std::vector<vectorized::Block> _blocks;
+    std::vector<int> _row_idxs;
+    std::unique_ptr<MemTable> _memtable;
+};
+
 // This is sample custom test. User can write custom test code at custom_init()&custom_run().
 // Call method: ./benchmark_tool --operation=Custom
 class CustomBenchmark : public BaseBenchmark {
@@ -529,6 +951,223 @@ void custom_run_mod() {
     }
 }
 
+// Merges k sorted runs of BIGINT, in blocks of 4096 rows, with the loser tree of
+// VSortedRunMerger or with a binary heap of the cursors copying row by row, which is how
+// VSortedRunMerger merged before. The values of the runs are either interleaved at random or
+// in disjoint ranges, so that the rows of a run mostly come out together.
+class SortedRunMergeBenchmark : public BaseBenchmark {
+public:
+    SortedRunMergeBenchmark(const std::string& name, int iterations, int rows_number,
+                            int num_runs, bool disjoint, bool loser_tree)
+            : BaseBenchmark(name, iterations), _loser_tree(loser_tree) {
+        add_name(std::string(loser_tree ? "/loser_tree" : "/heap") +
+                 (disjoint ? "/disjoint" : "/interleaved") + "/k:" + std::to_string(num_runs));
+        std::mt19937_64 rng(num_runs);
+        int rows_per_run = rows_number / num_runs;
+        for (int i = 0; i < num_runs; ++i) {
+            std::vector<int64_t> values(rows_per_run);
+            for (int j = 0; j < rows_per_run; ++j) {
+                values[j] = disjoint ? int64_t(i) * rows_per_run + j : int64_t(rng() >> 1);
+            }
+            std::sort(values.begin(), values.end());
+            std::vector<vectorized::Block> blocks;
+            for (int j = 0; j < rows_per_run; j += kBlockRows) {
+                auto column = vectorized::ColumnInt64::create();
+                column->get_data().assign(values.begin() + j,
+                                          values.begin() + std::min(j + kBlockRows, rows_per_run));
+                blocks.emplace_back(vectorized::ColumnsWithTypeAndName {
+                        {std::move(column), std::make_shared<vectorized::DataTypeInt64>(), "k"}});
+            }
+            _runs.push_back(std::move(blocks));
+        }
+        _desc.emplace_back(0, 1, 1);
+    }
+    virtual ~SortedRunMergeBenchmark() override {}
+
+    virtual void init() override {
+        _suppliers.clear();
+        _run_positions.assign(_runs.size(), 0);
+        for (size_t i = 0; i < _runs.size(); ++i) {
+            _suppliers.emplace_back([this, i](vectorized::Block* block, bool* eos) {
+                if (_run_positions[i] == _runs[i].size()) {
+                    *eos = true;
+                    return Status::OK();
+                }
+                *block = _runs[i][_run_positions[i]++];
+                *eos = false;
+                return Status::OK();
+            });
+        }
+    }
+
+    virtual void run() override {
+        RuntimeProfile profile("SortedRunMergeBenchmark");
+        size_t rows = 0;
+        if (_loser_tree) {
+            vectorized::VSortedRunMerger merger(_desc, kBlockRows, -1, 0, &profile);
+            static_cast<void>(merger.prepare(_suppliers));
+            bool eos = false;
+            while (!eos) {
+                vectorized::Block block;
+                static_cast<void>(merger.get_next(&block, &eos));
+                rows += block.rows();
+            }
+        } else {
+            std::vector<vectorized::BlockSupplierSortCursorImpl> cursors;
+            cursors.reserve(_suppliers.size());
+            std::priority_queue<vectorized::MergeSortCursor> queue;
+            for (auto& supplier : _suppliers) {
+                cursors.emplace_back(supplier, _desc);
+                queue.push(vectorized::MergeSortCursor(&cursors.back()));
+            }
+            auto column = vectorized::ColumnInt64::create();
+            while (!queue.empty()) {
+                auto current = queue.top();
+                queue.pop();
+                column->insert_from(*current->all_columns[0], current->pos);
+                if (column->size() == kBlockRows) {
+                    rows += column->size();
+                    column->clear();
+                }
+                if (!current->isLast()) {
+                    current->next();
+                    queue.push(current);
+                } else if (current->has_next_block()) {
+                    queue.push(current);
+                }
+            }
+            rows += column->size();
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+
+private:
+    static constexpr int kBlockRows = 4096;
+
+    bool _loser_tree;
+    vectorized::SortDescription _desc;
+    std::vector<std::vector<vectorized::Block>> _runs;
+    std::vector<size_t> _run_positions;
+    std::vector<vectorized::BlockSupplier> _suppliers;
+};
+
+// Parses the values of csv rows into nullable columns of int, bigint, double, datev2 and string,
+// in blocks of 4064 rows like CsvReader. "text_converter" writes the values cell by cell with
+// TextConverter, which is how CsvReader parsed them before. "batch_copy" copies the values of a
+// block into an arena and then parses each column with from_string_batch(), which is what
+// CsvReader does now for a query since the line reader reuses its buffer. "batch_in_place"
+// parses the same values without the copy, so the difference of the two is the cost of the copy.
+// A load writes its string columns straight from the line as before, so it has no copy.
+class CsvColumnParseBenchmark : public BaseBenchmark {
+public:
+    enum class Mode { TEXT_CONVERTER, BATCH_COPY, BATCH_IN_PLACE };
+
+    CsvColumnParseBenchmark(const std::string& name, int iterations, int rows_number, Mode mode)
+            : BaseBenchmark(name, iterations), _mode(mode), _text_converter('\\') {
+        static const std::map<Mode, std::string> MODE_NAMES = {
+                {Mode::TEXT_CONVERTER, "text_converter"},
+                {Mode::BATCH_COPY, "batch_copy"},
+                {Mode::BATCH_IN_PLACE, "batch_in_place"}};
+        add_name("/" + MODE_NAMES.at(mode));
+
+        TDescriptorTableBuilder builder;
+        TTupleDescriptorBuilder tuple_builder;
+        const std::vector<PrimitiveType> types = {TYPE_INT, TYPE_BIGINT, TYPE_DOUBLE, TYPE_DATEV2,
+                                                  TYPE_STRING};
+        for (size_t i = 0; i < types.size(); ++i) {
+            tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                           .type(types[i])
+                                           .nullable(true)
+                                           .column_name("c" + std::to_string(i))
+                                           .build());
+        }
+        tuple_builder.build(&builder);
+        auto st = DescriptorTbl::create(&_pool, builder.desc_tbl(), &_desc_tbl);
+        assert(st.ok());
+        _slots = _desc_tbl->get_tuple_descriptor(0)->slots();
+        for (const auto* slot : _slots) {
+            _data_types.push_back(slot->get_data_type_ptr());
+        }
+
+        std::mt19937_64 rng(0);
+        _texts.resize(_slots.size());
+        for (int row = 0; row < rows_number; ++row) {
+            _texts[0].push_back(std::to_string(int32_t(rng())));
+            _texts[1].push_back(std::to_string(int64_t(rng())));
+            _texts[2].push_back(std::to_string(double(rng() % 1000000) / 1000));
+            _texts[3].push_back(fmt::format("2023-{:02}-{:02}", rng() % 12 + 1, rng() % 28 + 1));
+            _texts[4].push_back(std::string(rng() % 32, 'a' + row % 26));
+        }
+        _values.resize(_slots.size());
+        for (size_t col = 0; col < _slots.size(); ++col) {
+            for (const auto& text : _texts[col]) {
+                _values[col].emplace_back(text.data(), text.size());
+            }
+        }
+    }
+    virtual ~CsvColumnParseBenchmark() override {}
+
+    virtual void init() override {
+        _columns.clear();
+        for (const auto* slot : _slots) {
+            _columns.push_back(slot->get_empty_mutable_column());
+        }
+    }
+
+    virtual void run() override {
+        size_t rows_number = _values[0].size();
+        for (size_t begin = 0; begin < rows_number; begin += kBlockRows) {
+            size_t rows = std::min(kBlockRows, rows_number - begin);
+            if (_mode == Mode::TEXT_CONVERTER) {
+                for (size_t row = begin; row < begin + rows; ++row) {
+                    for (size_t col = 0; col < _slots.size(); ++col) {
+                        const auto& value = _values[col][row];
+                        _text_converter.write_vec_column(_slots[col], _columns[col].get(),
+                                                         value.data, value.size, true, false);
+                    }
+                }
+                continue;
+            }
+            vectorized::Arena arena;
+            std::vector<std::vector<StringRef>> block_values(_slots.size());
+            if (_mode == Mode::BATCH_COPY) {
+                for (size_t row = begin; row < begin + rows; ++row) {
+                    for (size_t col = 0; col < _slots.size(); ++col) {
+                        const auto& value = _values[col][row];
+                        char* data = arena.alloc(value.size);
+                        memcpy(data, value.data, value.size);
+                        block_values[col].emplace_back(data, value.size);
+                    }
+                }
+            } else {
+                for (size_t col = 0; col < _slots.size(); ++col) {
+                    block_values[col].assign(_values[col].begin() + begin,
+                                             _values[col].begin() + begin + rows);
+                }
+            }
+            for (size_t col = 0; col < _slots.size(); ++col) {
+                _data_types[col]->from_string_batch(block_values[col].data(), rows,
+                                                    _columns[col].get(), &_parse_failures);
+            }
+        }
+        benchmark::DoNotOptimize(_columns[0]->size());
+    }
+
+private:
+    static constexpr size_t kBlockRows = 4064;
+
+    Mode _mode;
+    TextConverter _text_converter;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::vector<SlotDescriptor*> _slots;
+    vectorized::DataTypes _data_types;
+    std::vector<std::vector<std::string>> _texts;
+    std::vector<std::vector<StringRef>> _values;
+    std::vector<vectorized::MutableColumnPtr> _columns;
+    vectorized::PaddedPODArray<vectorized::UInt8> _parse_failures;
+};
+
 class MultiBenchmark {
 public:
     MultiBenchmark() {}
@@ -566,6 +1205,50 @@ public:
         } else if (equal_ignore_case(FLAGS_operation, "SegmentWriteByFile")) {
             benchmarks.emplace_back(new doris::SegmentWriteByFileBenchmark(
                     FLAGS_operation, std::stoi(FLAGS_iterations), FLAGS_input_file));
+        } else if (equal_ignore_case(FLAGS_operation, "TimestampPageDecode")) {
+            for (auto encoding : {BIT_SHUFFLE, DELTA_OF_DELTA_ENCODING}) {
+                benchmarks.emplace_back(new doris::TimestampPageDecodeBenchmark(
+                        FLAGS_operation, std::stoi(FLAGS_iterations),
+                        std::stoi(FLAGS_rows_number), encoding));
+            }
+        } else if (equal_ignore_case(FLAGS_operation, "LocalFileBatchRead")) {
+            for (bool use_io_uring : {false, true}) {
+                benchmarks.emplace_back(new doris::LocalFileBatchReadBenchmark(
+                        FLAGS_operation, std::stoi(FLAGS_iterations), FLAGS_input_file,
+                        std::stoi(FLAGS_batch_size), use_io_uring));
+            }
+        } else if (equal_ignore_case(FLAGS_operation, "RunQueue")) {
+            for (bool work_stealing : {false, true}) {
+                benchmarks.emplace_back(new doris::RunQueueBenchmark(
+                        FLAGS_operation, std::stoi(FLAGS_iterations),
+                        std::stoi(FLAGS_rows_number), std::stoi(FLAGS_threads), work_stealing));
+            }
+        } else if (equal_ignore_case(FLAGS_operation, "MemTableLoad")) {
+            for (auto keys_type : {DUP_KEYS, UNIQUE_KEYS}) {
+                for (bool sort_on_flush : {false, true}) {
+                    benchmarks.emplace_back(new doris::MemTableLoadBenchmark(
+                            FLAGS_operation, std::stoi(FLAGS_iterations),
+                            std::stoi(FLAGS_rows_number), keys_type, sort_on_flush));
+                }
+            }
+        } else if (equal_ignore_case(FLAGS_operation, "SortedRunMerge")) {
+            for (int num_runs : {16, 64, 256}) {
+                for (bool disjoint : {false, true}) {
+                    for (bool loser_tree : {false, true}) {
+                        benchmarks.emplace_back(new doris::SortedRunMergeBenchmark(
+                                FLAGS_operation, std::stoi(FLAGS_iterations),
+                                std::stoi(FLAGS_rows_number), num_runs, disjoint, loser_tree));
+                    }
+                }
+            }
+        } else if (equal_ignore_case(FLAGS_operation, "CsvColumnParse")) {
+            for (auto mode : {doris::CsvColumnParseBenchmark::Mode::TEXT_CONVERTER,
+                              doris::CsvColumnParseBenchmark::Mode::BATCH_COPY,
+                              doris::CsvColumnParseBenchmark::Mode::BATCH_IN_PLACE}) {
+                benchmarks.emplace_back(new doris::CsvColumnParseBenchmark(
+                        FLAGS_operation, std::stoi(FLAGS_iterations),
+                        std::stoi(FLAGS_rows_number), mode));
+            }
         } else {
             std::cout << "operation invalid!" << std::endl;
         }
@@ -0,0 +1,150 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/loser_tree.h"
+
+#include <algorithm>
+#include <climits>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace doris {
+
+struct SortedRun {
+    std::vector<int> values;
+    size_t pos = 0;
+    int value() const { return values[pos]; }
+};
+
+struct SortedRunLess {
+    size_t* num_compares;
+    bool operator()(const SortedRun* lhs, const SortedRun* rhs) const {
+        ++*num_compares;
+        return lhs->value() < rhs->value();
+    }
+};
+
+class LoserTreeTest : public testing::Test {
+protected:
+    std::vector<SortedRun> generate_runs(size_t num_runs, size_t max_run_size) {
+        std::vector<SortedRun> runs(num_runs);
+        for (auto& run : runs) {
+            size_t size = _re() % (max_run_size + 1);
+            for (size_t i = 0; i < size; ++i) {
+                run.values.push_back(_re() % 1000);
+            }
+            std::sort(run.values.begin(), run.values.end());
+        }
+        return runs;
+    }
+
+    std::vector<int> merge(std::vector<SortedRun>& runs, size_t* num_compares) {
+        LoserTree<SortedRun*, SortedRunLess> tree(SortedRunLess {num_compares});
+        std::vector<SortedRun*> items;
+        for (auto& run : runs) {
+            if (!run.values.empty()) {
+                items.push_back(&run);
+            }
+        }
+        tree.init(items);
+        std::vector<int> result;
+        while (!tree.empty()) {
+            SortedRun* top = tree.top();
+            result.push_back(top->value());
+            if (++top->pos < top->values.size()) {
+                tree.update_top();
+            } else {
+                tree.remove_top();
+            }
+        }
+        return result;
+    }
+
+    std::default_random_engine _re;
+};
+
+TEST_F(LoserTreeTest, Merge) {
+    for (size_t num_runs : {1, 2, 3, 5, 16, 17, 64, 100}) {
+        std::vector<SortedRun> runs = generate_runs(num_runs, 50);
+        std::vector<int> expected;
+        for (auto& run : runs) {
+            expected.insert(expected.end(), run.values.begin(), run.values.end());
+        }
+        std::sort(expected.begin(), expected.end());
+
+        size_t num_compares = 0;
+        EXPECT_EQ(expected, merge(runs, &num_compares));
+    }
+}
+
+TEST_F(LoserTreeTest, NumCompares) {
+    // 64 runs of 100 values, at most log2(64) comparisons for each value
+    std::vector<SortedRun> runs = generate_runs(64, 100);
+    for (auto& run : runs) {
+        while (run.values.size() < 100) {
+            run.values.push_back(1000);
+        }
+    }
+    size_t num_compares = 0;
+    std::vector<int> result = merge(runs, &num_compares);
+    EXPECT_EQ(64 * 100, result.size());
+    EXPECT_LE(num_compares, 64 + 64 * 100 * 6);
+}
+
+TEST_F(LoserTreeTest, RunnerUp) {
+    size_t num_compares = 0;
+    for (size_t num_runs : {1, 2, 7, 32}) {
+        std::vector<SortedRun> runs = generate_runs(num_runs, 20);
+        LoserTree<SortedRun*, SortedRunLess> tree(SortedRunLess {&num_compares});
+        std::vector<SortedRun*> items;
+        for (auto& run : runs) {
+            if (!run.values.empty()) {
+                items.push_back(&run);
+            }
+        }
+        tree.init(items);
+        while (!tree.empty()) {
+            SortedRun* top = tree.top();
+            // the runner up is the least of the other runs
+            int expected = INT_MAX;
+            for (auto* item : items) {
+                if (item != top && item->pos < item->values.size()) {
+                    expected = std::min(expected, item->value());
+                }
+            }
+            SortedRun** runner_up = tree.runner_up();
+            if (expected == INT_MAX) {
+                EXPECT_EQ(nullptr, runner_up);
+            } else {
+                ASSERT_NE(nullptr, runner_up);
+                EXPECT_EQ(expected, (*runner_up)->value());
+            }
+            EXPECT_EQ(top, items[tree.top_index()]);
+            if (++top->pos < top->values.size()) {
+                tree.update_top();
+            } else {
+                tree.remove_top();
+            }
+        }
+        size_t num_active = 0;
+        tree.for_each_active([&](SortedRun*) { ++num_active; });
+        EXPECT_EQ(0, num_active);
+    }
+}
+
+} // namespace doris
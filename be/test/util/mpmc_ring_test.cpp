@@ -0,0 +1,99 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "util/mpmc_ring.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace doris {
+
+TEST(MPMCRingTest, SingleThread) {
+    MPMCRing<std::unique_ptr<int>> ring(3);
+    EXPECT_EQ(4, ring.capacity());
+    std::unique_ptr<int> item;
+    EXPECT_FALSE(ring.try_pop(&item));
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(std::make_unique<int>(i)));
+    }
+    EXPECT_TRUE(ring.full());
+    // a failed push leaves the item to the caller
+    auto extra = std::make_unique<int>(4);
+    EXPECT_FALSE(ring.try_push(std::move(extra)));
+    ASSERT_NE(nullptr, extra);
+
+    // FIFO, also across laps
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(ring.try_pop(&item));
+            EXPECT_EQ(lap * 4 + i, *item);
+            EXPECT_TRUE(ring.try_push(std::make_unique<int>((lap + 1) * 4 + i)));
+        }
+    }
+    EXPECT_EQ(4, ring.size());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(&item));
+    }
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.try_pop(&item));
+}
+
+// Each item must be popped exactly once.
+TEST(MPMCRingTest, Concurrent) {
+    constexpr int num_producers = 4;
+    constexpr int num_consumers = 4;
+    constexpr int items_per_producer = 50000;
+    std::vector<std::atomic<int>> taken(num_producers * items_per_producer);
+    MPMCRing<int> ring(64);
+    std::atomic<int> num_popped = 0;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < num_producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < items_per_producer; ++i) {
+                int item = p * items_per_producer + i;
+                while (!ring.try_push(std::move(item))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&] {
+            int item;
+            while (num_popped < num_producers * items_per_producer) {
+                if (ring.try_pop(&item)) {
+                    taken[item].fetch_add(1);
+                    num_popped.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_TRUE(ring.empty());
+    for (auto& count : taken) {
+        EXPECT_EQ(1, count);
+    }
+}
+
+} // namespace doris
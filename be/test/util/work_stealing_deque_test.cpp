@@ -0,0 +1,92 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "util/work_stealing_deque.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace doris {
+
+TEST(WorkStealingDequeTest, OwnerOnly) {
+    std::vector<int> values(10);
+    WorkStealingDeque<int*> deque(4);
+    EXPECT_EQ(nullptr, deque.pop());
+    EXPECT_EQ(nullptr, deque.steal());
+
+    // grows past the initial capacity
+    for (auto& v : values) {
+        deque.push(&v);
+    }
+    EXPECT_EQ(10, deque.size());
+    // pop is LIFO, steal is FIFO
+    EXPECT_EQ(&values[9], deque.pop());
+    EXPECT_EQ(&values[0], deque.steal());
+    EXPECT_EQ(&values[1], deque.steal());
+    EXPECT_EQ(&values[8], deque.pop());
+    EXPECT_EQ(6, deque.size());
+    for (int i = 2; i < 8; ++i) {
+        EXPECT_EQ(&values[i], deque.steal());
+    }
+    EXPECT_TRUE(deque.empty());
+    EXPECT_EQ(nullptr, deque.pop());
+    EXPECT_EQ(nullptr, deque.steal());
+}
+
+// Each item must be taken exactly once by the owner or one of the thieves.
+TEST(WorkStealingDequeTest, ConcurrentSteal) {
+    constexpr int num_items = 100000;
+    constexpr int num_thieves = 4;
+    std::vector<int> items(num_items);
+    std::vector<std::atomic<int>> taken(num_items);
+    WorkStealingDeque<int*> deque(16);
+    std::atomic<bool> done = false;
+
+    auto take = [&](int* item) { taken[item - items.data()].fetch_add(1); };
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < num_thieves; ++i) {
+        thieves.emplace_back([&] {
+            while (!done || !deque.empty()) {
+                if (auto* item = deque.steal()) {
+                    take(item);
+                }
+            }
+        });
+    }
+    for (int i = 0; i < num_items; ++i) {
+        deque.push(&items[i]);
+        if (i % 3 == 0) {
+            if (auto* item = deque.pop()) {
+                take(item);
+            }
+        }
+    }
+    while (auto* item = deque.pop()) {
+        take(item);
+    }
+    done = true;
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+    for (int i = 0; i < num_items; ++i) {
+        EXPECT_EQ(1, taken[i].load()) << "item " << i;
+    }
+}
+
+} // namespace doris
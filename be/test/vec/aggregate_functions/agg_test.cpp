@@ -60,6 +60,45 @@ TEST(AggTest, basic_test) {
     agg_function->destroy(place);
 }
 
+// Slides a frame of 16 rows and compares the retracted sum with the sum of the whole frame.
+TEST(AggTest, retract_test) {
+    auto column_vector_int32 = ColumnVector<Int32>::create();
+    for (int i = 0; i < agg_test_batch_size; i++) {
+        column_vector_int32->insert(cast_to_nearest_field_type(i * (i % 3 - 1)));
+    }
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_sum(factory);
+    DataTypes data_types = {std::make_shared<DataTypeInt32>()};
+    auto agg_function = factory.get("sum", data_types);
+    EXPECT_TRUE(agg_function->supports_retract());
+    EXPECT_FALSE(factory.get("sum", {std::make_shared<DataTypeFloat64>()})->supports_retract());
+
+    std::unique_ptr<char[]> memory(new char[agg_function->size_of_data() * 2]);
+    AggregateDataPtr place = memory.get();
+    AggregateDataPtr expect_place = memory.get() + agg_function->size_of_data();
+    agg_function->create(place);
+    agg_function->create(expect_place);
+    auto result = agg_function->get_return_type()->create_column();
+    auto expect_result = agg_function->get_return_type()->create_column();
+    const IColumn* column[1] = {column_vector_int32.get()};
+    const int frame_rows = 16;
+    for (int i = 0; i < agg_test_batch_size; i++) {
+        agg_function->add(place, column, i, nullptr);
+        if (i >= frame_rows) {
+            agg_function->retract(place, column, i - frame_rows, nullptr);
+        }
+        agg_function->insert_result_into(place, *result);
+
+        agg_function->reset(expect_place);
+        agg_function->add_range_single_place(0, agg_test_batch_size, i - frame_rows + 1, i + 1,
+                                             expect_place, column, nullptr);
+        agg_function->insert_result_into(expect_place, *expect_result);
+        EXPECT_EQ(expect_result->get_int(i), result->get_int(i));
+    }
+    agg_function->destroy(place);
+    agg_function->destroy(expect_place);
+}
+
 TEST(AggTest, topn_test) {
     MutableColumns datas(2);
     datas[0] = ColumnString::create();
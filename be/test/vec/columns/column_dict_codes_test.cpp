@@ -0,0 +1,240 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/columns/column_dict_codes.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/arena.h"
+#include "vec/common/sip_hash.h"
+
+namespace doris::vectorized {
+
+static void check_values(const IColumn& column, const std::vector<std::string>& values) {
+    ASSERT_EQ(values.size(), column.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], column.get_data_at(i).to_string()) << "row " << i;
+    }
+}
+
+TEST(ColumnDictCodesTest, InsertDictData) {
+    // the page dictionary is released after the column is filled
+    auto page_dict = std::make_unique<StringRef[]>(3);
+    std::vector<std::string> words {"apple", "banana", "cherry"};
+    for (size_t i = 0; i < words.size(); ++i) {
+        page_dict[i] = StringRef(words[i]);
+    }
+    int32_t codes[] = {2, 0, 0, 1, 2};
+
+    auto column = ColumnDictCodes::create();
+    column->insert_many_dict_data(codes, 1, page_dict.get(), 4, 3);
+    column->insert_default();
+    column->insert_many_dict_data(codes, 0, page_dict.get(), 1, 3);
+    auto dict = column->get_dictionary();
+    words.clear();
+    page_dict.reset();
+
+    check_values(*column, {"apple", "apple", "banana", "cherry", "", "cherry"});
+    EXPECT_EQ(3, dict->size());
+
+    IColumn::Filter filter {1, 0, 1, 1, 1, 0};
+    auto filtered = column->filter(filter, -1);
+    check_values(*filtered, {"apple", "banana", "cherry", ""});
+    EXPECT_EQ(dict, assert_cast<const ColumnDictCodes&>(*filtered).get_dictionary());
+
+    IColumn::Permutation perm {5, 4, 3, 2, 1, 0};
+    check_values(*column->permute(perm, 0), {"cherry", "", "cherry", "banana", "apple", "apple"});
+
+    check_values(*column->convert_to_string_column(),
+                 {"apple", "apple", "banana", "cherry", "", "cherry"});
+}
+
+TEST(ColumnDictCodesTest, InsertRangeFromOtherDictionary) {
+    StringRef dict1[] = {StringRef("a"), StringRef("b")};
+    StringRef dict2[] = {StringRef("c"), StringRef("a")};
+    int32_t codes[] = {0, 1, 1, 0};
+
+    auto column1 = ColumnDictCodes::create();
+    column1->insert_many_dict_data(codes, 0, dict1, 4, 2);
+    auto shared = column1->clone_resized(4);
+
+    auto column2 = ColumnDictCodes::create();
+    column2->insert_many_dict_data(codes, 0, dict2, 4, 2);
+
+    // the words of the other dictionary are appended, the shared one is not changed
+    column1->insert_range_from(*column2, 1, 3);
+    check_values(*column1, {"a", "b", "b", "a", "a", "a", "c"});
+    EXPECT_EQ(3, column1->get_dictionary()->size());
+    EXPECT_EQ(2, assert_cast<const ColumnDictCodes&>(*shared).get_dictionary()->size());
+    check_values(*shared, {"a", "b", "b", "a"});
+
+    auto strings = ColumnString::create();
+    strings->insert_data("d", 1);
+    strings->insert_data("b", 1);
+    column1->insert_range_from(*strings, 0, 2);
+    check_values(*column1, {"a", "b", "b", "a", "a", "a", "c", "d", "b"});
+    EXPECT_EQ(4, column1->get_dictionary()->size());
+}
+
+TEST(ColumnDictCodesTest, Nullable) {
+    StringRef dict[] = {StringRef("x"), StringRef("y")};
+    int32_t codes[] = {1, 0};
+
+    auto column = ColumnNullable::create(ColumnDictCodes::create(), ColumnUInt8::create());
+    column->insert_many_dict_data(codes, 0, dict, 2, 2);
+    column->insert_null_elements(2);
+    column->insert_many_dict_data(codes, 1, dict, 1, 2);
+
+    EXPECT_NE(nullptr, ColumnDictCodes::get_dict_codes(*column));
+    ColumnPtr decoded =
+            ColumnDictCodes::convert_to_string_column_if_dict_codes(std::move(column));
+    const auto& nullable = assert_cast<const ColumnNullable&>(*decoded);
+    EXPECT_EQ(nullptr, ColumnDictCodes::get_dict_codes(nullable));
+    ASSERT_EQ(5, nullable.size());
+    EXPECT_EQ("y", nullable.get_data_at(0).to_string());
+    EXPECT_EQ("x", nullable.get_data_at(1).to_string());
+    EXPECT_TRUE(nullable.is_null_at(2));
+    EXPECT_TRUE(nullable.is_null_at(3));
+    EXPECT_EQ("x", nullable.get_data_at(4).to_string());
+}
+
+// The operations working on the values must give the same results as on a ColumnString.
+TEST(ColumnDictCodesTest, SameAsColumnString) {
+    StringRef dict1[] = {StringRef("pear"), StringRef(""), StringRef("fig"), StringRef("kiwi")};
+    StringRef dict2[] = {StringRef("kiwi"), StringRef("apple")};
+    int32_t codes1[] = {0, 2, 1, 3, 2};
+    int32_t codes2[] = {1, 0, 1};
+
+    auto column = ColumnDictCodes::create();
+    column->insert_many_dict_data(codes1, 0, dict1, 5, 4);
+    column->insert_default();
+    auto other = ColumnDictCodes::create();
+    other->insert_many_dict_data(codes2, 0, dict2, 3, 2);
+    auto strings = column->convert_to_string_column();
+    std::vector<std::string> values {"pear", "fig", "", "kiwi", "fig", ""};
+    check_values(*strings, values);
+
+    for (size_t i = 0; i < column->size(); ++i) {
+        SipHash codes_hash;
+        SipHash strings_hash;
+        column->update_hash_with_value(i, codes_hash);
+        strings->update_hash_with_value(i, strings_hash);
+        EXPECT_EQ(strings_hash.get64(), codes_hash.get64()) << "row " << i;
+        EXPECT_EQ(values[i].empty(), column->is_default_at(i));
+        for (size_t j = 0; j < other->size(); ++j) {
+            auto expected = strings->compare_at(i, j, *other->convert_to_string_column(), 1);
+            EXPECT_EQ(expected > 0, column->compare_at(i, j, *other, 1) > 0);
+            EXPECT_EQ(expected == 0, column->compare_at(i, j, *other, 1) == 0);
+        }
+        for (size_t j = 0; j < column->size(); ++j) {
+            auto expected = strings->compare_at(i, j, *strings, 1);
+            EXPECT_EQ(expected > 0, column->compare_at(i, j, *column, 1) > 0);
+            EXPECT_EQ(expected == 0, column->compare_at(i, j, *strings, 1) == 0);
+        }
+    }
+
+    // sorted by value, the empty word of the dictionary and the default code are equal
+    for (bool reverse : {false, true}) {
+        for (size_t limit : {0, 3}) {
+            IColumn::Permutation perm;
+            column->get_permutation(reverse, limit, 1, perm);
+            ASSERT_EQ(column->size(), perm.size());
+            std::vector<std::string> sorted = values;
+            if (reverse) {
+                std::sort(sorted.rbegin(), sorted.rend());
+            } else {
+                std::sort(sorted.begin(), sorted.end());
+            }
+            size_t rows = limit ? limit : perm.size();
+            for (size_t i = 0; i < rows; ++i) {
+                EXPECT_EQ(sorted[i], column->get_data_at(perm[i]).to_string()) << "row " << i;
+            }
+        }
+    }
+
+    Field min;
+    Field max;
+    column->get_extremes(min, max);
+    EXPECT_EQ("", min.get<String>());
+    EXPECT_EQ("pear", max.get<String>());
+}
+
+TEST(ColumnDictCodesTest, SerializeIntoArena) {
+    StringRef dict[] = {StringRef("a"), StringRef("bcd")};
+    int32_t codes[] = {1, 0, 1};
+    auto column = ColumnDictCodes::create();
+    column->insert_many_dict_data(codes, 0, dict, 3, 2);
+    column->insert_default();
+
+    // serialized as a ColumnString, so the keys can be read back into either column
+    Arena arena;
+    auto strings = column->convert_to_string_column();
+    auto restored = ColumnDictCodes::create();
+    for (size_t i = 0; i < column->size(); ++i) {
+        const char* begin = nullptr;
+        auto value = column->serialize_value_into_arena(i, arena, begin);
+        const char* string_begin = nullptr;
+        EXPECT_EQ(strings->serialize_value_into_arena(i, arena, string_begin), value);
+        EXPECT_EQ(value.data + value.size, restored->deserialize_and_insert_from_arena(value.data));
+    }
+    check_values(*restored, {"bcd", "a", "bcd", ""});
+}
+
+TEST(ColumnDictCodesTest, ReplicateScatterIndex) {
+    StringRef dict[] = {StringRef("x"), StringRef("y"), StringRef("z")};
+    int32_t codes[] = {0, 1, 2, 1};
+    auto column = ColumnDictCodes::create();
+    column->insert_many_dict_data(codes, 0, dict, 4, 3);
+    auto dict_ptr = column->get_dictionary();
+
+    IColumn::Offsets offsets {2, 2, 5, 6};
+    auto replicated = column->replicate(offsets);
+    check_values(*replicated, {"x", "x", "z", "z", "z", "y"});
+    EXPECT_EQ(dict_ptr, assert_cast<const ColumnDictCodes&>(*replicated).get_dictionary());
+
+    IColumn::Selector selector {1, 0, 1, 1};
+    auto scattered = column->scatter(2, selector);
+    ASSERT_EQ(2, scattered.size());
+    check_values(*scattered[0], {"y"});
+    check_values(*scattered[1], {"x", "z", "y"});
+
+    auto indexes = ColumnUInt32::create();
+    for (uint32_t i : {3, 3, 0}) {
+        indexes->insert_value(i);
+    }
+    check_values(*column->index(*indexes, 3), {"y", "y", "x"});
+
+    EXPECT_TRUE(column->structure_equals(*replicated));
+    EXPECT_FALSE(column->structure_equals(*column->convert_to_string_column()));
+
+    // the new word is added to a copy of the shared dictionary
+    auto strings = ColumnString::create();
+    strings->insert_data("w", 1);
+    column->replace_column_data(*strings, 0, 1);
+    column->replace_column_data_default(2);
+    check_values(*column, {"x", "w", "", "y"});
+    EXPECT_EQ(3, dict_ptr->size());
+    check_values(*replicated, {"x", "x", "z", "z", "z", "y"});
+}
+
+} // namespace doris::vectorized
@@ -17,9 +17,16 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "common/config.h"
 #include "io/fs/local_file_system.h"
 #include "runtime/block_spill_manager.h"
 #include "runtime/runtime_state.h"
+#include "util/defer_op.h"
+#include "util/threadpool.h"
 #include "vec/columns/column_array.h"
 #include "vec/columns/column_decimal.h"
 #include "vec/columns/column_nullable.h"
@@ -474,4 +481,215 @@ TEST_F(TestBlockSpill, TestBitmap) {
     auto bitmap_str = convert_bitmap_to_string(real_column->get_element(0));
     EXPECT_EQ(bitmap_str, expected_bitmap_str[3 * batch_size]);
 }
+
+TEST_F(TestBlockSpill, TestCompressionType) {
+    int batch_size = 1024; // rows in a block
+    int batch_num = 16;
+    int total_rows = batch_size * batch_num;
+    auto origin_compression_type = config::spill_compression_type;
+
+    for (const auto& compression_type : {"NONE", "LZ4", "ZSTD"}) {
+        config::spill_compression_type = compression_type;
+
+        auto col = vectorized::ColumnVector<int>::create();
+        auto& data = col->get_data();
+        for (int i = 0; i < total_rows; ++i) {
+            data.push_back(i % 7);
+        }
+        vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+        vectorized::ColumnWithTypeAndName type_and_name(col->get_ptr(), data_type,
+                                                        "spill_block_test_compression");
+        vectorized::Block block({type_and_name});
+
+        vectorized::BlockSpillWriterUPtr spill_block_writer;
+        EXPECT_TRUE(block_spill_manager->get_writer(batch_size, spill_block_writer, profile_).ok());
+        EXPECT_TRUE(spill_block_writer->write(block).ok());
+        EXPECT_TRUE(spill_block_writer->close().ok());
+
+        vectorized::BlockSpillReaderUPtr spill_block_reader;
+        EXPECT_TRUE(block_spill_manager
+                            ->get_reader(spill_block_writer->get_id(), spill_block_reader, profile_)
+                            .ok());
+
+        // sub blocks are read ahead by the I/O thread pool
+        vectorized::Block block_read;
+        bool eos = false;
+        for (int i = 0; i < batch_num; ++i) {
+            EXPECT_TRUE(spill_block_reader->read(&block_read, &eos).ok());
+            EXPECT_FALSE(eos);
+            EXPECT_EQ(block_read.rows(), batch_size);
+            auto column = block_read.get_by_position(0).column;
+            auto* real_column = (vectorized::ColumnVector<int>*)column.get();
+            for (size_t j = 0; j < batch_size; ++j) {
+                EXPECT_EQ(real_column->get_int(j), (j + i * batch_size) % 7);
+            }
+        }
+        EXPECT_TRUE(spill_block_reader->read(&block_read, &eos).ok());
+        EXPECT_TRUE(eos);
+        EXPECT_TRUE(spill_block_reader->close().ok());
+    }
+    config::spill_compression_type = origin_compression_type;
+}
+
+static vectorized::Block create_int_block(int rows) {
+    auto col = vectorized::ColumnVector<int>::create();
+    for (int i = 0; i < rows; ++i) {
+        col->insert_value(i);
+    }
+    vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::ColumnWithTypeAndName type_and_name(col->get_ptr(), data_type,
+                                                    "spill_block_test_io");
+    return vectorized::Block({type_and_name});
+}
+
+// A single thread pool whose thread is kept busy until `release` is called, so the
+// spill I/O submitted meanwhile stays pending.
+class BlockedIOPool {
+public:
+    BlockedIOPool() {
+        EXPECT_TRUE(ThreadPoolBuilder("BlockSpillTestIO")
+                            .set_min_threads(1)
+                            .set_max_threads(1)
+                            .build(&_pool)
+                            .ok());
+        auto blocked = _release.get_future().share();
+        EXPECT_TRUE(_pool->submit_func([blocked]() { blocked.wait(); }).ok());
+    }
+
+    ~BlockedIOPool() { release(); }
+
+    std::unique_ptr<ThreadPoolToken> new_token() {
+        return _pool->new_token(ThreadPool::ExecutionMode::SERIAL);
+    }
+
+    void release() {
+        if (!_released) {
+            _released = true;
+            _release.set_value();
+        }
+    }
+
+    void wait() { _pool->wait(); }
+
+private:
+    std::promise<void> _release;
+    bool _released = false;
+    std::unique_ptr<ThreadPool> _pool;
+};
+
+TEST_F(TestBlockSpill, TestWriteBoundsPendingSubBlocks) {
+    int batch_size = 100;
+    int batch_num = 10;
+    int max_pending = 4;
+    auto old_max_pending = config::spill_max_pending_sub_blocks;
+    config::spill_max_pending_sub_blocks = max_pending;
+    Defer defer {[&]() { config::spill_max_pending_sub_blocks = old_max_pending; }};
+    BlockedIOPool io_pool;
+
+    vectorized::BlockSpillWriterUPtr spill_block_writer;
+    EXPECT_TRUE(block_spill_manager->get_writer(batch_size, spill_block_writer, profile_).ok());
+    spill_block_writer->io_token_ = io_pool.new_token();
+    auto pending_writes = [&]() {
+        std::lock_guard<std::mutex> l(spill_block_writer->io_lock_);
+        return spill_block_writer->pending_writes_;
+    };
+
+    // the I/O thread is busy, the sub blocks below the limit are queued without waiting
+    int first_sub_blocks = max_pending - 1;
+    EXPECT_TRUE(spill_block_writer->write(create_int_block(batch_size * first_sub_blocks)).ok());
+    EXPECT_EQ(first_sub_blocks, pending_writes());
+    EXPECT_TRUE(spill_block_writer->can_write());
+
+    // a larger block waits for the disk once the limit is reached
+    auto write_done = std::async(std::launch::async, [&]() {
+        return spill_block_writer->write(create_int_block(batch_size * batch_num));
+    });
+    while (pending_writes() < max_pending) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_FALSE(spill_block_writer->can_write());
+    EXPECT_EQ(std::future_status::timeout, write_done.wait_for(std::chrono::milliseconds(50)));
+    EXPECT_EQ(max_pending, pending_writes());
+
+    io_pool.release();
+    EXPECT_TRUE(write_done.get().ok());
+    io_pool.wait();
+    EXPECT_TRUE(spill_block_writer->can_write());
+    EXPECT_TRUE(spill_block_writer->close().ok());
+
+    vectorized::BlockSpillReaderUPtr spill_block_reader;
+    EXPECT_TRUE(block_spill_manager
+                        ->get_reader(spill_block_writer->get_id(), spill_block_reader, profile_)
+                        .ok());
+    vectorized::Block block_read;
+    bool eos = false;
+    for (int i = 0; i < first_sub_blocks + batch_num; ++i) {
+        EXPECT_TRUE(spill_block_reader->read(&block_read, &eos).ok());
+        EXPECT_FALSE(eos);
+        EXPECT_EQ(block_read.rows(), batch_size);
+        auto* real_column =
+                (vectorized::ColumnVector<int>*)block_read.get_by_position(0).column.get();
+        int first = (i < first_sub_blocks ? i : i - first_sub_blocks) * batch_size;
+        EXPECT_EQ(real_column->get_int(0), first);
+        EXPECT_EQ(real_column->get_int(block_read.rows() - 1), first + block_read.rows() - 1);
+    }
+    EXPECT_TRUE(spill_block_reader->read(&block_read, &eos).ok());
+    EXPECT_TRUE(eos);
+    EXPECT_TRUE(spill_block_reader->close().ok());
+}
+
+TEST_F(TestBlockSpill, TestReadAhead) {
+    int batch_size = 100;
+    int batch_num = 5;
+
+    vectorized::BlockSpillWriterUPtr spill_block_writer;
+    EXPECT_TRUE(block_spill_manager->get_writer(batch_size, spill_block_writer, profile_).ok());
+    EXPECT_TRUE(spill_block_writer->write(create_int_block(batch_size * batch_num)).ok());
+    EXPECT_TRUE(spill_block_writer->close().ok());
+
+    BlockedIOPool io_pool;
+    vectorized::BlockSpillReader spill_block_reader(spill_block_writer->get_id(),
+                                                    spill_block_writer->file_path_, profile_,
+                                                    true, io_pool.new_token());
+    EXPECT_TRUE(spill_block_reader.open().ok());
+    // the first sub block is being read ahead
+    EXPECT_FALSE(spill_block_reader.can_read());
+    io_pool.release();
+    io_pool.wait();
+    EXPECT_TRUE(spill_block_reader.can_read());
+
+    vectorized::Block block_read;
+    bool eos = false;
+    int rows = 0;
+    while (true) {
+        EXPECT_TRUE(spill_block_reader.read(&block_read, &eos).ok());
+        if (eos) {
+            break;
+        }
+        auto* real_column =
+                (vectorized::ColumnVector<int>*)block_read.get_by_position(0).column.get();
+        for (size_t j = 0; j < block_read.rows(); ++j) {
+            EXPECT_EQ(real_column->get_int(j), rows++);
+        }
+    }
+    EXPECT_EQ(batch_size * batch_num, rows);
+    EXPECT_TRUE(spill_block_reader.can_read());
+    EXPECT_TRUE(spill_block_reader.close().ok());
+}
+
+TEST_F(TestBlockSpill, TestWriteError) {
+    vectorized::BlockSpillWriterUPtr spill_block_writer;
+    EXPECT_TRUE(block_spill_manager->get_writer(100, spill_block_writer, profile_).ok());
+    EXPECT_TRUE(spill_block_writer->write(create_int_block(250)).ok());
+
+    // a failed append of the I/O thread is returned by the next write and by close
+    {
+        std::lock_guard<std::mutex> l(spill_block_writer->io_lock_);
+        spill_block_writer->io_status_ = Status::IOError("injected spill write error");
+    }
+    EXPECT_TRUE(spill_block_writer->can_write());
+    EXPECT_FALSE(spill_block_writer->write(create_int_block(10)).ok());
+    EXPECT_FALSE(spill_block_writer->close().ok());
+}
+
 } // namespace doris
@@ -287,6 +287,71 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
     serialize_and_deserialize_test(segment_v2::CompressionTypePB::LZ4);
 }
 
+// The encodings of be_exec_version 2 must round trip and make the block smaller.
+TEST(BlockTest, SerializeWithColumnEncodings) {
+    auto int_column = vectorized::ColumnVector<vectorized::Int64>::create();
+    auto str_column = vectorized::ColumnString::create();
+    auto nullable_column = vectorized::make_nullable(vectorized::ColumnVector<Int32>::create());
+    auto mutable_nullable_column = std::move(*nullable_column).mutate();
+    for (int i = 0; i < 4096; ++i) {
+        int_column->insert_value(1000000000000 + i % 100);
+        std::string value = "value_" + std::to_string(i % 10);
+        str_column->insert_data(value.data(), value.size());
+        mutable_nullable_column->insert(vectorized::cast_to_nearest_field_type(i));
+    }
+    vectorized::Block block({{int_column->get_ptr(),
+                              std::make_shared<vectorized::DataTypeInt64>(), "test_int"},
+                             {str_column->get_ptr(),
+                              std::make_shared<vectorized::DataTypeString>(), "test_string"},
+                             {mutable_nullable_column->get_ptr(),
+                              vectorized::make_nullable(
+                                      std::make_shared<vectorized::DataTypeInt32>()),
+                              "test_nullable_int32"}});
+
+    size_t uncompressed_bytes[2];
+    size_t compressed_bytes = 0;
+    for (int be_exec_version : {1, 2}) {
+        PBlock pblock;
+        EXPECT_TRUE(block.serialize(be_exec_version, &pblock,
+                                    &uncompressed_bytes[be_exec_version - 1], &compressed_bytes,
+                                    segment_v2::CompressionTypePB::NO_COMPRESSION)
+                            .ok());
+        vectorized::Block block2(pblock);
+        EXPECT_EQ(block.dump_data(), block2.dump_data());
+    }
+    EXPECT_LT(uncompressed_bytes[1] * 4, uncompressed_bytes[0]);
+}
+
+// Columns whose sampled values are mostly distinct are sent plain without building a dictionary.
+TEST(BlockTest, SerializeStringDictionarySampling) {
+    vectorized::DataTypeString data_type;
+    auto check_encoding = [&](int distinct_values, uint8_t expected_encoding) {
+        auto column = vectorized::ColumnString::create();
+        for (int i = 0; i < 4096; ++i) {
+            std::string value = "value_" + std::to_string(i % distinct_values);
+            column->insert_data(value.data(), value.size());
+        }
+        std::string buf(data_type.get_uncompressed_serialized_bytes(*column, 2), '\0');
+        char* end = data_type.serialize(*column, buf.data(), 2);
+        EXPECT_LE(end - buf.data(), buf.size());
+        EXPECT_EQ(expected_encoding, static_cast<uint8_t>(buf[0])) << distinct_values;
+
+        auto column2 = vectorized::ColumnString::create();
+        data_type.deserialize(buf.data(), column2.get(), 2);
+        ASSERT_EQ(column->size(), column2->size());
+        for (size_t i = 0; i < column->size(); ++i) {
+            EXPECT_EQ(column->get_data_at(i), column2->get_data_at(i));
+        }
+    };
+    // dictionary
+    check_encoding(10, 1);
+    check_encoding(100, 1);
+    // plain, every value is distinct
+    check_encoding(4096, 0);
+    // plain, 900 values would fit in a dictionary, but 225 of the 256 sampled rows are distinct
+    check_encoding(900, 0);
+}
+
 TEST(BlockTest, dump_data) {
     auto vec = vectorized::ColumnVector<Int32>::create();
     auto& int32_data = vec->get_data();
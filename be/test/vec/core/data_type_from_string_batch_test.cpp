@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/pod_array.h"
+#include "vec/data_types/data_type_decimal.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_type_time_v2.h"
+#include "vec/io/reader_buffer.h"
+
+namespace doris::vectorized {
+
+static std::vector<StringRef> to_string_refs(const std::vector<std::string>& values) {
+    std::vector<StringRef> refs;
+    for (const auto& value : values) {
+        refs.emplace_back(value.data(), value.size());
+    }
+    return refs;
+}
+
+// from_string_batch must parse the values as from_string does value by value.
+static void check_same_as_from_string(const DataTypePtr& type,
+                                      const std::vector<std::string>& values) {
+    auto refs = to_string_refs(values);
+    auto batch_column = type->create_column();
+    PaddedPODArray<UInt8> parse_failures;
+    type->from_string_batch(refs.data(), refs.size(), batch_column.get(), &parse_failures);
+    ASSERT_EQ(values.size(), batch_column->size());
+    ASSERT_EQ(values.size(), parse_failures.size());
+
+    auto column = type->create_column();
+    for (size_t i = 0; i < values.size(); ++i) {
+        ReadBuffer rb(const_cast<char*>(values[i].data()), values[i].size());
+        if (type->from_string(rb, column.get()).ok()) {
+            EXPECT_EQ(0, parse_failures[i]) << values[i];
+            EXPECT_EQ(type->to_string(*column, column->size() - 1),
+                      type->to_string(*batch_column, i));
+        } else {
+            EXPECT_EQ(1, parse_failures[i]) << values[i];
+            column->insert_default();
+        }
+    }
+}
+
+TEST(DataTypeFromStringBatchTest, numbers) {
+    check_same_as_from_string(std::make_shared<DataTypeInt32>(),
+                              {"1", "-2147483648", "2147483647", "2147483648", "abc", "", "+7"});
+    check_same_as_from_string(std::make_shared<DataTypeInt64>(),
+                              {"9223372036854775807", "-1", "1.5", "12a"});
+    check_same_as_from_string(std::make_shared<DataTypeFloat64>(),
+                              {"1.5", "-3e10", "0", "nan", "x"});
+    check_same_as_from_string(std::make_shared<DataTypeUInt8>(),
+                              {"true", "false", "1", "0", "2", "yes"});
+}
+
+TEST(DataTypeFromStringBatchTest, dates_and_decimals) {
+    check_same_as_from_string(std::make_shared<DataTypeDateV2>(),
+                              {"2022-01-01", "2022-02-30", "20220301", "not a date"});
+    check_same_as_from_string(std::make_shared<DataTypeDateTimeV2>(3),
+                              {"2022-01-01 12:00:00.123", "2022-01-01", "2022-13-01 00:00:00"});
+    check_same_as_from_string(std::make_shared<DataTypeDecimal<Decimal64>>(10, 2),
+                              {"1.23", "-0.5", "12345678.99", "1.2.3", ""});
+}
+
+TEST(DataTypeFromStringBatchTest, nullable) {
+    auto type = make_nullable(std::make_shared<DataTypeInt32>());
+    std::vector<std::string> values {"1", "\\N", "abc", "4"};
+    auto refs = to_string_refs(values);
+    auto column = type->create_column();
+    column->insert_default();
+    PaddedPODArray<UInt8> parse_failures;
+    type->from_string_batch(refs.data(), refs.size(), column.get(), &parse_failures);
+
+    ASSERT_EQ(5, column->size());
+    EXPECT_EQ(std::vector<UInt8>({0, 0, 1, 0}),
+              std::vector<UInt8>(parse_failures.begin(), parse_failures.end()));
+    const auto& nullable_column = assert_cast<const ColumnNullable&>(*column);
+    EXPECT_TRUE(nullable_column.is_null_at(0));
+    EXPECT_FALSE(nullable_column.is_null_at(1));
+    EXPECT_TRUE(nullable_column.is_null_at(2));
+    EXPECT_TRUE(nullable_column.is_null_at(3));
+    EXPECT_FALSE(nullable_column.is_null_at(4));
+    EXPECT_EQ(1, (*column)[1].get<Int64>());
+    EXPECT_EQ(4, (*column)[4].get<Int64>());
+
+    auto string_type = make_nullable(std::make_shared<DataTypeString>());
+    auto string_column = string_type->create_column();
+    string_type->from_string_batch(refs.data(), refs.size(), string_column.get(),
+                                   &parse_failures);
+    ASSERT_EQ(4, string_column->size());
+    EXPECT_EQ(std::vector<UInt8>({0, 0, 0, 0}),
+              std::vector<UInt8>(parse_failures.begin(), parse_failures.end()));
+    EXPECT_TRUE(string_column->is_null_at(1));
+    EXPECT_EQ("abc", (*string_column)[2].get<String>());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,215 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "runtime/descriptor_helper.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_dict_codes.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exec/exec_node_test_util.h"
+#include "vec/exec/vaggregation_node.h"
+
+namespace doris::vectorized {
+
+// select k, sum(v) from t group by k, where k is a low cardinality nullable string column
+// read from two segments with different dictionaries, as the olap scan node carries it
+// when the aggregation asks for dictionary codes.
+class AggDictCodesTest : public testing::Test {
+protected:
+    using Result = std::map<std::optional<std::string>, int64_t>;
+
+    void SetUp() override {
+        TDescriptorTableBuilder builder;
+        TTupleDescriptorBuilder()
+                .add_slot(create_slot_desc(TYPE_STRING, "k", true))
+                .add_slot(create_slot_desc(TYPE_INT, "v"))
+                .build(&builder);
+        for (int i = 0; i < 2; ++i) {
+            TTupleDescriptorBuilder()
+                    .add_slot(create_slot_desc(TYPE_STRING, "k", true))
+                    .add_slot(create_slot_desc(TYPE_BIGINT, "sum_v"))
+                    .build(&builder);
+        }
+        _desc_tbl = builder.desc_tbl();
+    }
+
+    std::vector<TPlanNode> agg_plan(bool streaming_preagg) {
+        const auto& slots = _desc_tbl.slotDescriptors;
+        auto agg_node = create_plan_node(TPlanNodeType::AGGREGATION_NODE, 0, {2}, 1);
+        TAggregationNode agg;
+        agg.__set_grouping_exprs({create_slot_ref(slots[0])});
+        agg.__set_aggregate_functions({create_agg_fn_expr("sum", {slots[1]}, TYPE_BIGINT)});
+        agg.__set_intermediate_tuple_id(1);
+        agg.__set_output_tuple_id(2);
+        agg.__set_need_finalize(!streaming_preagg);
+        agg.__set_use_streaming_preaggregation(streaming_preagg);
+        agg_node.__set_agg_node(agg);
+        return {agg_node, create_empty_set_node(1, 0)};
+    }
+
+    // The key of row i is null every 7 rows, otherwise the word `(i + segment) % 5` of the
+    // segment dictionary, whose words are in a different order in every segment.
+    static std::optional<std::string> key_of(int segment, int row) {
+        if (row % 7 == 0) {
+            return std::nullopt;
+        }
+        return "word_" + std::to_string((row + segment) % 5);
+    }
+
+    Block input_block(int segment, int begin, int end, bool dict_codes) {
+        auto& dict = _dicts[segment];
+        if (dict.empty()) {
+            for (int i = 4; i >= 0; --i) {
+                dict.push_back("word_" + std::to_string((i * (segment + 2)) % 5));
+            }
+            for (const auto& word : dict) {
+                _dict_refs[segment].emplace_back(word);
+            }
+        }
+        MutableColumnPtr keys;
+        if (dict_codes) {
+            keys = ColumnDictCodes::create();
+        } else {
+            keys = ColumnString::create();
+        }
+        auto null_map = ColumnUInt8::create();
+        auto values = ColumnInt32::create();
+        for (int row = begin; row < end; ++row) {
+            auto key = key_of(segment, row);
+            null_map->insert_value(!key.has_value());
+            values->insert_value(row);
+            if (!key.has_value()) {
+                keys->insert_default();
+                continue;
+            }
+            int32_t code = std::find(dict.begin(), dict.end(), *key) - dict.begin();
+            if (dict_codes) {
+                keys->insert_many_dict_data(&code, 0, _dict_refs[segment].data(), 1, dict.size());
+            } else {
+                keys->insert_data(key->data(), key->size());
+            }
+        }
+        Block block;
+        block.insert({ColumnNullable::create(std::move(keys), std::move(null_map)),
+                      make_nullable(std::make_shared<DataTypeString>()), "k"});
+        block.insert({std::move(values), std::make_shared<DataTypeInt32>(), "v"});
+        return block;
+    }
+
+    Result aggregate(bool dict_codes, bool streaming_preagg, int64_t spill_threshold) {
+        TQueryOptions query_options;
+        query_options.__set_batch_size(1024);
+        query_options.__set_external_agg_bytes_threshold(spill_threshold);
+        ExecNodeTestEnv env(query_options, _desc_tbl);
+        ExecNode* node = nullptr;
+        auto st = env.create_exec_node(agg_plan(streaming_preagg), &node);
+        EXPECT_TRUE(st.ok()) << st;
+        auto* agg_node = static_cast<AggregationNode*>(node);
+
+        Result result;
+        auto collect = [&](const Block& block) {
+            const auto& key_column = *block.get_by_position(0).column;
+            // the keys leave the node as strings
+            EXPECT_EQ(nullptr, ColumnDictCodes::get_dict_codes(key_column));
+            for (size_t i = 0; i < block.rows(); ++i) {
+                std::optional<std::string> key;
+                if (!key_column.is_null_at(i)) {
+                    key = key_column.get_data_at(i).to_string();
+                }
+                auto sum = assert_cast<const ColumnInt64&>(*block.get_by_position(1).column)
+                                   .get_element(i);
+                result[key] += sum;
+            }
+        };
+
+        for (int segment = 0; segment < 2; ++segment) {
+            for (int begin = 0; begin < ROWS; begin += 1000) {
+                auto block = input_block(segment, begin, std::min(begin + 1000, ROWS), dict_codes);
+                if (streaming_preagg) {
+                    Block out_block;
+                    st = agg_node->do_pre_agg(&block, &out_block);
+                    EXPECT_TRUE(st.ok()) << st;
+                    collect(out_block);
+                } else {
+                    st = node->sink(env.state(), &block, false);
+                    EXPECT_TRUE(st.ok()) << st;
+                }
+            }
+        }
+        Block empty_block;
+        st = node->sink(env.state(), &empty_block, true);
+        EXPECT_TRUE(st.ok()) << st;
+
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            st = node->pull(env.state(), &block, &eos);
+            EXPECT_TRUE(st.ok()) << st;
+            if (!st.ok()) {
+                break;
+            }
+            collect(block);
+        }
+        return result;
+    }
+
+    static Result expected_result() {
+        Result result;
+        for (int segment = 0; segment < 2; ++segment) {
+            for (int row = 0; row < ROWS; ++row) {
+                result[key_of(segment, row)] += row;
+            }
+        }
+        return result;
+    }
+
+    static constexpr int ROWS = 5000;
+    TDescriptorTable _desc_tbl;
+    std::vector<std::string> _dicts[2];
+    std::vector<StringRef> _dict_refs[2];
+};
+
+TEST_F(AggDictCodesTest, group_by_dict_codes) {
+    auto expected = expected_result();
+    ASSERT_EQ(6, expected.size());
+    EXPECT_EQ(expected, aggregate(false, false, 0));
+    EXPECT_EQ(expected, aggregate(true, false, 0));
+}
+
+TEST_F(AggDictCodesTest, streaming_preagg_with_dict_codes) {
+    EXPECT_EQ(expected_result(), aggregate(true, true, 0));
+}
+
+TEST_F(AggDictCodesTest, spill_with_dict_codes) {
+    // a threshold of 1 byte spills the hash table after every block
+    EXPECT_EQ(expected_result(), aggregate(true, false, 1));
+}
+
+} // namespace doris::vectorized
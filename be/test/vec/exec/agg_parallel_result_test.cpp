@@ -0,0 +1,283 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "common/config.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "util/threadpool.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exec/exec_node_test_util.h"
+#include "vec/exec/vaggregation_node.h"
+
+namespace doris::vectorized {
+
+// select k, sum(v) from t group by k, with a hash table partitioned after 1000 keys, whose
+// sub tables are emitted by the tasks of the AggResultThreadPool. As the merge phase, v is
+// the partial sum and the blocks are merged into the sub tables by the tasks as well.
+class AggParallelResultTest : public testing::Test {
+protected:
+    using Result = std::map<std::optional<int32_t>, int64_t>;
+
+    void SetUp() override {
+        TDescriptorTableBuilder builder;
+        TTupleDescriptorBuilder()
+                .add_slot(create_slot_desc(TYPE_INT, "k", true))
+                .add_slot(create_slot_desc(TYPE_BIGINT, "v"))
+                .build(&builder);
+        for (int i = 0; i < 2; ++i) {
+            TTupleDescriptorBuilder()
+                    .add_slot(create_slot_desc(TYPE_INT, "k", true))
+                    .add_slot(create_slot_desc(TYPE_BIGINT, "sum_v"))
+                    .build(&builder);
+        }
+        _desc_tbl = builder.desc_tbl();
+
+        _origin_parallelism = config::agg_result_parallelism;
+        config::agg_result_parallelism = 4;
+        auto* exec_env = ExecEnv::GetInstance();
+        _origin_thread_pool = std::move(exec_env->_agg_result_thread_pool);
+        static_cast<void>(ThreadPoolBuilder("AggResultThreadPool")
+                                  .set_min_threads(4)
+                                  .set_max_threads(4)
+                                  .build(&exec_env->_agg_result_thread_pool));
+    }
+
+    void TearDown() override {
+        auto* exec_env = ExecEnv::GetInstance();
+        exec_env->_agg_result_thread_pool->shutdown();
+        exec_env->_agg_result_thread_pool = std::move(_origin_thread_pool);
+        config::agg_result_parallelism = _origin_parallelism;
+    }
+
+    TQueryOptions query_options(bool pipeline) {
+        TQueryOptions query_options;
+        query_options.__set_batch_size(128);
+        query_options.__set_partitioned_hash_agg_rows_threshold(1000);
+        query_options.__set_enable_pipeline_engine(pipeline);
+        return query_options;
+    }
+
+    std::vector<TPlanNode> agg_plan(int64_t limit, bool merge = false) {
+        const auto& slots = _desc_tbl.slotDescriptors;
+        auto agg_node = create_plan_node(TPlanNodeType::AGGREGATION_NODE, 0, {2}, 1);
+        agg_node.__set_limit(limit);
+        TAggregationNode agg;
+        agg.__set_grouping_exprs({create_slot_ref(slots[0])});
+        auto sum = create_agg_fn_expr("sum", {slots[1]}, TYPE_BIGINT);
+        sum.nodes[0].agg_expr.__set_is_merge_agg(merge);
+        agg.__set_aggregate_functions({sum});
+        agg.__set_use_fixed_length_serialization_opt(merge);
+        agg.__set_intermediate_tuple_id(1);
+        agg.__set_output_tuple_id(2);
+        agg.__set_need_finalize(true);
+        agg.__set_use_streaming_preaggregation(false);
+        agg_node.__set_agg_node(agg);
+        return {agg_node, create_empty_set_node(1, 0)};
+    }
+
+    static std::optional<int32_t> key_of(int row) {
+        if (row % 13 == 0) {
+            return std::nullopt;
+        }
+        return row % KEYS;
+    }
+
+    static Block input_block(int begin, int end) {
+        auto keys = ColumnInt32::create();
+        auto null_map = ColumnUInt8::create();
+        auto values = ColumnInt64::create();
+        for (int row = begin; row < end; ++row) {
+            auto key = key_of(row);
+            keys->insert_value(key.value_or(0));
+            null_map->insert_value(!key.has_value());
+            values->insert_value(row);
+        }
+        Block block;
+        block.insert({ColumnNullable::create(std::move(keys), std::move(null_map)),
+                      make_nullable(std::make_shared<DataTypeInt32>()), "k"});
+        block.insert({std::move(values), std::make_shared<DataTypeInt64>(), "v"});
+        return block;
+    }
+
+    static Result expected_result() {
+        Result result;
+        for (int row = 0; row < ROWS; ++row) {
+            result[key_of(row)] += row;
+        }
+        return result;
+    }
+
+    static void sink_all(RuntimeState* state, ExecNode* node) {
+        for (int begin = 0; begin < ROWS; begin += 4096) {
+            auto block = input_block(begin, std::min(begin + 4096, ROWS));
+            ASSERT_TRUE(node->sink(state, &block, false).ok());
+        }
+        Block empty_block;
+        ASSERT_TRUE(node->sink(state, &empty_block, true).ok());
+    }
+
+    // As the pipeline task of the source, which is only scheduled when can_read().
+    static bool wait_for_can_read(AggregationNode* node) {
+        for (int i = 0; i < 10000 && !node->can_read(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return node->can_read();
+    }
+
+    static bool wait_for_result_tasks(AggregationNode* node) {
+        for (int i = 0; i < 10000 && node->has_running_result_tasks(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return !node->has_running_result_tasks();
+    }
+
+    static void collect(const Block& block, Result* result) {
+        const auto& key_column =
+                assert_cast<const ColumnNullable&>(*block.get_by_position(0).column);
+        const auto& nested_keys = assert_cast<const ColumnInt32&>(key_column.get_nested_column());
+        const auto& sum_column = assert_cast<const ColumnInt64&>(*block.get_by_position(1).column);
+        for (size_t i = 0; i < block.rows(); ++i) {
+            std::optional<int32_t> key;
+            if (!key_column.is_null_at(i)) {
+                key = nested_keys.get_element(i);
+            }
+            // every key is in exactly one sub table
+            EXPECT_EQ(0, result->count(key));
+            (*result)[key] = sum_column.get_element(i);
+        }
+    }
+
+    static size_t queued_blocks(AggregationNode* node) {
+        std::lock_guard<std::mutex> l(node->_result_lock);
+        return node->_result_blocks.size();
+    }
+
+    // The tasks stop converting their sub tables while the queue is full.
+    static bool wait_for_full_queue(AggregationNode* node) {
+        for (int i = 0; i < 10000 && queued_blocks(node) < node->_max_result_blocks; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return queued_blocks(node) == node->_max_result_blocks;
+    }
+
+    Result aggregate(bool pipeline, int64_t limit, bool merge = false) {
+        ExecNodeTestEnv env(query_options(pipeline), _desc_tbl);
+        ExecNode* node = nullptr;
+        auto st = env.create_exec_node(agg_plan(limit, merge), &node);
+        EXPECT_TRUE(st.ok()) << st;
+        auto* agg_node = static_cast<AggregationNode*>(node);
+        sink_all(env.state(), node);
+        EXPECT_EQ(1, agg_node->_parallel_result);
+        // the blocks after the one partitioning the hash table are merged by the tasks
+        EXPECT_EQ(merge && limit < 0, !agg_node->_merge_arenas.empty());
+
+        Result result;
+        bool eos = false;
+        while (!eos) {
+            if (pipeline) {
+                EXPECT_TRUE(wait_for_can_read(agg_node));
+            }
+            Block block;
+            st = node->pull(env.state(), &block, &eos);
+            EXPECT_TRUE(st.ok()) << st;
+            if (!st.ok()) {
+                break;
+            }
+            collect(block, &result);
+        }
+        // the tasks stop walking the sub tables once the limit is reached
+        EXPECT_TRUE(wait_for_result_tasks(agg_node));
+        return result;
+    }
+
+    static constexpr int ROWS = 60000;
+    static constexpr int KEYS = 20000;
+    TDescriptorTable _desc_tbl;
+    int32_t _origin_parallelism = 1;
+    std::unique_ptr<ThreadPool> _origin_thread_pool;
+};
+
+TEST_F(AggParallelResultTest, parallel_emit) {
+    auto expected = expected_result();
+    EXPECT_EQ(expected, aggregate(true, -1));
+    EXPECT_EQ(expected, aggregate(false, -1));
+}
+
+TEST_F(AggParallelResultTest, parallel_merge) {
+    auto expected = expected_result();
+    EXPECT_EQ(expected, aggregate(true, -1, true));
+    EXPECT_EQ(expected, aggregate(false, -1, true));
+}
+
+TEST_F(AggParallelResultTest, limit) {
+    constexpr int64_t LIMIT = 2000;
+    auto expected = expected_result();
+    auto result = aggregate(true, LIMIT);
+    EXPECT_EQ(LIMIT, result.size());
+    for (const auto& [key, sum] : result) {
+        EXPECT_EQ(expected[key], sum);
+    }
+}
+
+TEST_F(AggParallelResultTest, cancel) {
+    ExecNodeTestEnv env(query_options(true), _desc_tbl);
+    ExecNode* node = nullptr;
+    auto st = env.create_exec_node(agg_plan(-1), &node);
+    ASSERT_TRUE(st.ok()) << st;
+    auto* agg_node = static_cast<AggregationNode*>(node);
+    sink_all(env.state(), node);
+    ASSERT_EQ(1, agg_node->_parallel_result);
+
+    // the tasks wait for the queued blocks to be pulled, and the rest of the sub tables are
+    // not scheduled
+    ASSERT_TRUE(wait_for_full_queue(agg_node));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(agg_node->_max_result_blocks, queued_blocks(agg_node));
+    EXPECT_TRUE(agg_node->has_running_result_tasks());
+    ASSERT_TRUE(agg_node->can_read());
+    ASSERT_LT(agg_node->_next_result_sub_table, 16);
+    env.state()->set_is_cancelled(true);
+
+    bool eos = false;
+    while (st.ok() && !eos) {
+        ASSERT_TRUE(wait_for_can_read(agg_node));
+        Block block;
+        st = node->pull(env.state(), &block, &eos);
+    }
+    EXPECT_TRUE(st.is<ErrorCode::CANCELLED>()) << st;
+    EXPECT_TRUE(wait_for_result_tasks(agg_node));
+
+    // closing the source does not wait for the tasks on the worker
+    ASSERT_TRUE(agg_node->try_close().ok());
+    EXPECT_FALSE(agg_node->has_running_result_tasks());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,180 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "runtime/descriptor_helper.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exec/exec_node_test_util.h"
+#include "vec/exec/vaggregation_node.h"
+
+namespace doris::vectorized {
+
+// select k, sum(v) from t group by k, where the rows are pushed in blocks of `block_rows`
+// with k = row % key_count and v = row.
+class AggSpillTest : public testing::Test {
+protected:
+    void SetUp() override {
+        TDescriptorTableBuilder builder;
+        // input tuple 0: (k, v), intermediate tuple 1 and output tuple 2: (k, sum(v))
+        TTupleDescriptorBuilder()
+                .add_slot(create_slot_desc(TYPE_INT, "k"))
+                .add_slot(create_slot_desc(TYPE_INT, "v"))
+                .build(&builder);
+        for (int i = 0; i < 2; ++i) {
+            TTupleDescriptorBuilder()
+                    .add_slot(create_slot_desc(TYPE_INT, "k"))
+                    .add_slot(create_slot_desc(TYPE_BIGINT, "sum_v"))
+                    .build(&builder);
+        }
+        _desc_tbl = builder.desc_tbl();
+    }
+
+    std::vector<TPlanNode> agg_plan(int64_t limit) {
+        const auto& slots = _desc_tbl.slotDescriptors;
+        auto agg_node = create_plan_node(TPlanNodeType::AGGREGATION_NODE, 0, {2}, 1);
+        agg_node.__set_limit(limit);
+        TAggregationNode agg;
+        agg.__set_grouping_exprs({create_slot_ref(slots[0])});
+        agg.__set_aggregate_functions({create_agg_fn_expr("sum", {slots[1]}, TYPE_BIGINT)});
+        agg.__set_intermediate_tuple_id(1);
+        agg.__set_output_tuple_id(2);
+        agg.__set_need_finalize(true);
+        agg.__set_use_streaming_preaggregation(false);
+        agg_node.__set_agg_node(agg);
+        return {agg_node, create_empty_set_node(1, 0)};
+    }
+
+    static Block input_block(int begin, int end, int key_count) {
+        auto k = ColumnInt32::create();
+        auto v = ColumnInt32::create();
+        for (int row = begin; row < end; ++row) {
+            k->insert_value(row % key_count);
+            v->insert_value(row);
+        }
+        auto type = std::make_shared<DataTypeInt32>();
+        Block block;
+        block.insert(ColumnWithTypeAndName(std::move(k), type, "k"));
+        block.insert(ColumnWithTypeAndName(std::move(v), type, "v"));
+        return block;
+    }
+
+    // Returns sum(v) by k, and whether the aggregation spilled.
+    std::map<int32_t, int64_t> aggregate(int rows, int block_rows, int key_count,
+                                         int64_t spill_threshold, int64_t limit,
+                                         bool* spilled) {
+        TQueryOptions query_options;
+        query_options.__set_batch_size(1024);
+        query_options.__set_external_agg_bytes_threshold(spill_threshold);
+        ExecNodeTestEnv env(query_options, _desc_tbl);
+        ExecNode* node = nullptr;
+        auto st = env.create_exec_node(agg_plan(limit), &node);
+        EXPECT_TRUE(st.ok()) << st;
+
+        for (int begin = 0; begin < rows; begin += block_rows) {
+            auto block = input_block(begin, std::min(begin + block_rows, rows), key_count);
+            st = node->sink(env.state(), &block, false);
+            EXPECT_TRUE(st.ok()) << st;
+        }
+        Block empty_block;
+        st = node->sink(env.state(), &empty_block, true);
+        EXPECT_TRUE(st.ok()) << st;
+        *spilled = static_cast<AggregationNode*>(node)->_is_spilled;
+
+        std::map<int32_t, int64_t> result;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            st = node->pull(env.state(), &block, &eos);
+            EXPECT_TRUE(st.ok()) << st;
+            if (!st.ok()) {
+                break;
+            }
+            for (size_t i = 0; i < block.rows(); ++i) {
+                auto k = assert_cast<const ColumnInt32&>(*block.get_by_position(0).column)
+                                 .get_element(i);
+                auto sum = assert_cast<const ColumnInt64&>(*block.get_by_position(1).column)
+                                   .get_element(i);
+                EXPECT_TRUE(result.emplace(k, sum).second) << "duplicated group " << k;
+            }
+        }
+        return result;
+    }
+
+    static int64_t expected_sum(int rows, int key_count, int32_t key) {
+        int64_t sum = 0;
+        for (int row = key; row < rows; row += key_count) {
+            sum += row;
+        }
+        return sum;
+    }
+
+    TDescriptorTable _desc_tbl;
+};
+
+TEST_F(AggSpillTest, spill_and_restore) {
+    const int rows = 20000;
+    const int key_count = 3000;
+    bool spilled = false;
+    auto in_memory = aggregate(rows, 1024, key_count, 0, -1, &spilled);
+    EXPECT_FALSE(spilled);
+    // a threshold of 1 byte spills the hash table after every block
+    auto restored = aggregate(rows, 1024, key_count, 1, -1, &spilled);
+    EXPECT_TRUE(spilled);
+
+    ASSERT_EQ(key_count, in_memory.size());
+    EXPECT_EQ(in_memory, restored);
+    for (const auto& [key, sum] : restored) {
+        EXPECT_EQ(expected_sum(rows, key_count, key), sum) << key;
+    }
+}
+
+TEST_F(AggSpillTest, partial_spill_with_limit) {
+    // The hash table is spilled before it holds 100 groups, so no group is dropped and the
+    // limit is only applied to the restored output.
+    const int rows = 5000;
+    const int key_count = 500;
+    bool spilled = false;
+    auto result = aggregate(rows, 50, key_count, 1, 100, &spilled);
+    EXPECT_TRUE(spilled);
+    ASSERT_EQ(100, result.size());
+    for (const auto& [key, sum] : result) {
+        EXPECT_EQ(expected_sum(rows, key_count, key), sum) << key;
+    }
+}
+
+TEST_F(AggSpillTest, no_spill_after_limit_reached) {
+    // The first block has more groups than the limit, from then on the rows of new groups
+    // (keys 1000 ~ 1999) are dropped and the hash table is not spilled.
+    const int rows = 5000;
+    const int key_count = 2000;
+    bool spilled = false;
+    auto result = aggregate(rows, 1000, key_count, 1, 100, &spilled);
+    EXPECT_FALSE(spilled);
+    ASSERT_EQ(100, result.size());
+    for (const auto& [key, sum] : result) {
+        EXPECT_EQ(expected_sum(rows, key_count, key), sum) << key;
+    }
+}
+
+} // namespace doris::vectorized
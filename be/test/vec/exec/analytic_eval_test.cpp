@@ -0,0 +1,326 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "io/fs/local_file_system.h"
+#include "runtime/block_spill_manager.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exec/exec_node_test_util.h"
+#include "vec/exec/vanalytic_eval_node.h"
+
+namespace doris::vectorized {
+
+// select sum(v), min(v), max(v), sum(d) over (partition by p rows between ...) from t,
+// evaluated by the analytic node and naively row by row. sum(v) slides incrementally,
+// min(v) and max(v) by a segment tree if the frame is large enough and sum(d) is recomputed
+// for every row as doubles are not retracted.
+class AnalyticEvalTest : public testing::Test {
+protected:
+    struct Frame {
+        // offsets from the current row, no start is UNBOUNDED PRECEDING
+        std::optional<int64_t> start;
+        int64_t end;
+    };
+
+    struct Result {
+        int64_t sum = 0;
+        int64_t min = 0;
+        int64_t max = 0;
+        double sum_d = 0;
+
+        bool operator==(const Result& other) const {
+            return sum == other.sum && min == other.min && max == other.max &&
+                   sum_d == other.sum_d;
+        }
+    };
+
+    void SetUp() override {
+        TDescriptorTableBuilder builder;
+        TTupleDescriptorBuilder()
+                .add_slot(create_slot_desc(TYPE_INT, "p"))
+                .add_slot(create_slot_desc(TYPE_INT, "id"))
+                .add_slot(create_slot_desc(TYPE_BIGINT, "v"))
+                .add_slot(create_slot_desc(TYPE_DOUBLE, "d"))
+                .add_slot(create_slot_desc(TYPE_STRING, "payload"))
+                .build(&builder);
+        for (int i = 0; i < 2; ++i) {
+            TTupleDescriptorBuilder()
+                    .add_slot(create_slot_desc(TYPE_BIGINT, "sum_v"))
+                    .add_slot(create_slot_desc(TYPE_BIGINT, "min_v"))
+                    .add_slot(create_slot_desc(TYPE_BIGINT, "max_v"))
+                    .add_slot(create_slot_desc(TYPE_DOUBLE, "sum_d"))
+                    .build(&builder);
+        }
+        _desc_tbl = builder.desc_tbl();
+
+        // partitions of 1 to 151 rows and one spanning several blocks
+        int start = 0;
+        for (int k = 0; start < ROWS; ++k) {
+            int end = std::min(start + (k == 3 ? 1200 : (k * 37) % 151 + 1), ROWS);
+            _partition_starts.push_back(start);
+            _partition_of_rows.resize(end, k);
+            start = end;
+        }
+        _partition_starts.push_back(ROWS);
+    }
+
+    static TAnalyticWindowBoundary boundary(int64_t offset) {
+        TAnalyticWindowBoundary boundary;
+        if (offset == 0) {
+            boundary.__set_type(TAnalyticWindowBoundaryType::CURRENT_ROW);
+            return boundary;
+        }
+        boundary.__set_type(offset < 0 ? TAnalyticWindowBoundaryType::PRECEDING
+                                       : TAnalyticWindowBoundaryType::FOLLOWING);
+        boundary.__set_rows_offset_value(std::abs(offset));
+        return boundary;
+    }
+
+    std::vector<TPlanNode> analytic_plan(const Frame& frame) {
+        const auto& slots = _desc_tbl.slotDescriptors;
+        TAnalyticWindow window;
+        window.__set_type(TAnalyticWindowType::ROWS);
+        if (frame.start.has_value()) {
+            window.__set_window_start(boundary(*frame.start));
+        }
+        window.__set_window_end(boundary(frame.end));
+
+        auto analytic_node = create_plan_node(TPlanNodeType::ANALYTIC_EVAL_NODE, 0, {0, 2}, 1);
+        TAnalyticNode analytic;
+        analytic.__set_partition_exprs({create_slot_ref(slots[0])});
+        analytic.__set_order_by_exprs({});
+        analytic.__set_analytic_functions({create_agg_fn_expr("sum", {slots[2]}, TYPE_BIGINT),
+                                           create_agg_fn_expr("min", {slots[2]}, TYPE_BIGINT),
+                                           create_agg_fn_expr("max", {slots[2]}, TYPE_BIGINT),
+                                           create_agg_fn_expr("sum", {slots[3]}, TYPE_DOUBLE)});
+        analytic.__set_window(window);
+        analytic.__set_intermediate_tuple_id(1);
+        analytic.__set_output_tuple_id(2);
+        analytic_node.__set_analytic_node(analytic);
+        return {analytic_node, create_empty_set_node(1, 0)};
+    }
+
+    static int64_t value_of(int row) { return (row * 7919) % 1000 - 500; }
+
+    Block input_block(int begin, int end) {
+        auto partitions = ColumnInt32::create();
+        auto ids = ColumnInt32::create();
+        auto values = ColumnInt64::create();
+        auto doubles = ColumnFloat64::create();
+        auto payloads = ColumnString::create();
+        for (int row = begin; row < end; ++row) {
+            partitions->insert_value(_partition_of_rows[row]);
+            ids->insert_value(row);
+            values->insert_value(value_of(row));
+            doubles->insert_value(value_of(row) * 0.25);
+            auto payload = "payload_" + std::to_string(row);
+            payloads->insert_data(payload.data(), payload.size());
+        }
+        Block block;
+        block.insert({std::move(partitions), std::make_shared<DataTypeInt32>(), "p"});
+        block.insert({std::move(ids), std::make_shared<DataTypeInt32>(), "id"});
+        block.insert({std::move(values), std::make_shared<DataTypeInt64>(), "v"});
+        block.insert({std::move(doubles), std::make_shared<DataTypeFloat64>(), "d"});
+        block.insert({std::move(payloads), std::make_shared<DataTypeString>(), "payload"});
+        return block;
+    }
+
+    // Pulls the output blocks while the node has some, returns true at eos.
+    static bool drain(RuntimeState* state, VAnalyticEvalNode* node, std::vector<Result>* results,
+                      std::vector<int>* seen) {
+        while (node->can_read()) {
+            Block block;
+            bool eos = false;
+            auto st = node->pull(state, &block, &eos);
+            EXPECT_TRUE(st.ok()) << st;
+            if (!st.ok()) {
+                return true;
+            }
+            for (size_t i = 0; i < block.rows(); ++i) {
+                auto id = assert_cast<const ColumnInt32&>(*block.get_by_position(1).column)
+                                  .get_element(i);
+                // the payload comes back from the spilled stream with its row
+                EXPECT_EQ("payload_" + std::to_string(id),
+                          block.get_by_position(4).column->get_data_at(i).to_string());
+                auto int64_at = [&](size_t position) {
+                    return assert_cast<const ColumnInt64&>(*block.get_by_position(position).column)
+                            .get_element(i);
+                };
+                Result& result = (*results)[id];
+                result.sum = int64_at(5);
+                result.min = int64_at(6);
+                result.max = int64_at(7);
+                result.sum_d = assert_cast<const ColumnFloat64&>(*block.get_by_position(8).column)
+                                       .get_element(i);
+                ++(*seen)[id];
+            }
+            if (eos) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Evaluates the frame by the node and checks that the segment trees and the spilled
+    // streams are released on close.
+    std::vector<Result> evaluate(const Frame& frame, int64_t spill_threshold,
+                                 int64_t* segment_tree_peak_bytes) {
+        TQueryOptions query_options;
+        query_options.__set_batch_size(1024);
+        query_options.__set_external_analytic_bytes_threshold(spill_threshold);
+        ExecNodeTestEnv env(query_options, _desc_tbl);
+        ExecNode* node = nullptr;
+        auto st = env.create_exec_node(analytic_plan(frame), &node);
+        EXPECT_TRUE(st.ok()) << st;
+        auto* analytic_node = static_cast<VAnalyticEvalNode*>(node);
+
+        std::vector<Result> results(ROWS);
+        std::vector<int> seen(ROWS, 0);
+        for (int begin = 0; begin < ROWS; begin += BLOCK_ROWS) {
+            auto block = input_block(begin, std::min(begin + BLOCK_ROWS, ROWS));
+            st = node->sink(env.state(), &block, false);
+            EXPECT_TRUE(st.ok()) << st;
+            drain(env.state(), analytic_node, &results, &seen);
+        }
+        Block empty_block;
+        st = node->sink(env.state(), &empty_block, true);
+        EXPECT_TRUE(st.ok()) << st;
+        EXPECT_TRUE(drain(env.state(), analytic_node, &results, &seen));
+        EXPECT_EQ(std::vector<int>(ROWS, 1), seen);
+
+        // the arguments of the aggregates of the finished partitions are dropped
+        EXPECT_GT(analytic_node->_agg_input_first_row, 0);
+        EXPECT_EQ(ROWS, analytic_node->_agg_input_end_row);
+        *segment_tree_peak_bytes = analytic_node->_segment_tree_memory_usage->value();
+        EXPECT_TRUE(node->close(env.state()).ok());
+        EXPECT_EQ(0, analytic_node->_segment_tree_memory_usage->current_value());
+        EXPECT_TRUE(ExecEnv::GetInstance()->block_spill_mgr()->id_to_file_paths_.empty());
+        return results;
+    }
+
+    std::vector<Result> naive_evaluate(const Frame& frame) {
+        std::vector<Result> results(ROWS);
+        for (size_t k = 0; k + 1 < _partition_starts.size(); ++k) {
+            int64_t partition_start = _partition_starts[k];
+            int64_t partition_end = _partition_starts[k + 1];
+            for (int64_t row = partition_start; row < partition_end; ++row) {
+                int64_t start = frame.start.has_value() ? row + *frame.start : partition_start;
+                start = std::max(start, partition_start);
+                int64_t end = std::min(row + frame.end + 1, partition_end);
+                if (start >= end) {
+                    continue;
+                }
+                Result& result = results[row];
+                result.min = value_of(start);
+                result.max = value_of(start);
+                for (int64_t i = start; i < end; ++i) {
+                    result.sum += value_of(i);
+                    result.min = std::min(result.min, value_of(i));
+                    result.max = std::max(result.max, value_of(i));
+                    result.sum_d += value_of(i) * 0.25;
+                }
+            }
+        }
+        return results;
+    }
+
+    void check_frame(const Frame& frame, bool uses_segment_tree) {
+        auto expected = naive_evaluate(frame);
+        for (int64_t spill_threshold : {0, 1}) {
+            int64_t segment_tree_peak_bytes = 0;
+            auto results = evaluate(frame, spill_threshold, &segment_tree_peak_bytes);
+            for (int row = 0; row < ROWS; ++row) {
+                EXPECT_TRUE(expected[row] == results[row])
+                        << "row " << row << ", spill threshold " << spill_threshold;
+            }
+            // the segment tree states are charged to the node
+            EXPECT_EQ(uses_segment_tree, segment_tree_peak_bytes > 0);
+        }
+    }
+
+    static constexpr int ROWS = 3000;
+    static constexpr int BLOCK_ROWS = 700;
+    TDescriptorTable _desc_tbl;
+    std::vector<int> _partition_of_rows;
+    std::vector<int64_t> _partition_starts;
+};
+
+TEST_F(AnalyticEvalTest, segment_tree_frame) {
+    check_frame({-40, 3}, true);
+    check_frame({3, 50}, true);
+}
+
+TEST_F(AnalyticEvalTest, small_sliding_frame) {
+    // min and max are recomputed for frames smaller than SEGMENT_TREE_MIN_FRAME_ROWS
+    check_frame({-2, 1}, false);
+    check_frame({-5, -2}, false);
+}
+
+TEST_F(AnalyticEvalTest, unbounded_preceding_frame) {
+    // the start of the frame never moves, so min and max are incremental as well
+    check_frame({std::nullopt, 5}, false);
+}
+
+TEST_F(AnalyticEvalTest, release_unread_spilled_payloads) {
+    TQueryOptions query_options;
+    query_options.__set_batch_size(1024);
+    query_options.__set_external_analytic_bytes_threshold(1);
+    ExecNodeTestEnv env(query_options, _desc_tbl);
+    ExecNode* node = nullptr;
+    auto st = env.create_exec_node(analytic_plan({-40, 3}), &node);
+    ASSERT_TRUE(st.ok()) << st;
+
+    // the node is closed, e.g. by a cancel, before the blocks are output
+    for (int begin = 0; begin < ROWS; begin += BLOCK_ROWS) {
+        auto block = input_block(begin, std::min(begin + BLOCK_ROWS, ROWS));
+        ASSERT_TRUE(node->sink(env.state(), &block, false).ok());
+    }
+    auto* spill_mgr = ExecEnv::GetInstance()->block_spill_mgr();
+    std::vector<std::string> paths;
+    for (const auto& [stream_id, path] : spill_mgr->id_to_file_paths_) {
+        paths.push_back(path);
+    }
+    // the payloads and the arguments of the aggregates of all the blocks are in one stream
+    // each, still being written
+    ASSERT_EQ(2, paths.size());
+    auto* analytic_node = static_cast<VAnalyticEvalNode*>(node);
+    EXPECT_EQ(0, analytic_node->_agg_input_end_row);
+
+    ASSERT_TRUE(node->close(env.state()).ok());
+    EXPECT_TRUE(spill_mgr->id_to_file_paths_.empty());
+    for (const auto& path : paths) {
+        bool exists = true;
+        ASSERT_TRUE(io::global_local_filesystem()->exists(path, &exists).ok());
+        EXPECT_FALSE(exists) << path;
+    }
+}
+
+} // namespace doris::vectorized
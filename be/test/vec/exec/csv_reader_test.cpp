@@ -0,0 +1,396 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/csv/csv_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "gen_cpp/PaloInternalService_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "io/fs/local_file_system.h"
+#include "olap/hll.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_complex.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/core/block.h"
+#include "vec/exec/exec_node_test_util.h"
+#include "vec/exec/scan/new_file_scan_node.h"
+#include "vec/exec/scan/vscanner.h"
+
+namespace doris::vectorized {
+
+// Reads csv files with CsvReader. The split tests read a file in the ranges split at byte
+// offsets, as NewFileScanNode::_split_csv_scan_ranges splits a large file. Each range skips the
+// line which starts before it, so every row must be read by exactly one range.
+class CsvReaderTest : public testing::Test {
+public:
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+        TDescriptorTableBuilder builder;
+        // select k, v of the split tests
+        TTupleDescriptorBuilder()
+                .add_slot(create_slot_desc(TYPE_INT, "k", true))
+                .add_slot(create_slot_desc(TYPE_STRING, "v", true))
+                .build(&builder);
+        // select p, k, h, d, s of the parse tests, where p is a partition column
+        TTupleDescriptorBuilder()
+                .add_slot(create_slot_desc(TYPE_STRING, "p", true))
+                .add_slot(create_slot_desc(TYPE_INT, "k", true))
+                .add_slot(create_slot_desc(TYPE_HLL, "h", true))
+                .add_slot(create_slot_desc(TYPE_DOUBLE, "d", true))
+                .add_slot(create_slot_desc(TYPE_STRING, "s", true))
+                .build(&builder);
+        // the source slots of a load of the file of the parse tests
+        TTupleDescriptorBuilder load_tuple_builder;
+        for (int i = 0; i < 5; ++i) {
+            load_tuple_builder.add_slot(
+                    create_slot_desc(TYPE_STRING, "c" + std::to_string(i), true));
+        }
+        load_tuple_builder.build(&builder);
+        _t_desc_tbl = builder.desc_tbl();
+        EXPECT_TRUE(DescriptorTbl::create(&_pool, _t_desc_tbl, &_desc_tbl).ok());
+        _state.reset(new RuntimeState(TQueryGlobals()));
+        _state->init_mem_trackers();
+        _state->set_desc_tbl(_desc_tbl);
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+    }
+
+protected:
+    static constexpr TTupleId SPLIT_TUPLE = 0;
+    static constexpr TTupleId QUERY_TUPLE = 1;
+    static constexpr TTupleId LOAD_TUPLE = 2;
+
+    // The lines "k,v" of the split tests, where v is empty in some of them.
+    static std::vector<std::string> _lines() {
+        std::vector<std::string> lines;
+        for (int i = 0; i < 30; ++i) {
+            lines.push_back(std::to_string(i) + "," + std::string(i % 5, 'a' + i % 26));
+        }
+        return lines;
+    }
+
+    void _write_file(const std::vector<std::string>& lines, const std::string& line_delimiter,
+                     bool trailing_delimiter) {
+        std::string data;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            data += lines[i];
+            if (i + 1 < lines.size() || trailing_delimiter) {
+                data += line_delimiter;
+            }
+        }
+        std::ofstream file(_file_path, std::ios::binary | std::ios::trunc);
+        file << data;
+        file.close();
+        _file_size = data.size();
+    }
+
+    const std::vector<SlotDescriptor*>& _slots(TTupleId tuple_id) const {
+        return _desc_tbl->get_tuple_descriptor(tuple_id)->slots();
+    }
+
+    // The slots read from the file, which are all the slots except the partition column p.
+    std::vector<SlotDescriptor*> _file_slots(TTupleId tuple_id) const {
+        std::vector<SlotDescriptor*> file_slots;
+        for (auto* slot : _slots(tuple_id)) {
+            if (slot->col_name() != "p") {
+                file_slots.push_back(slot);
+            }
+        }
+        return file_slots;
+    }
+
+    TFileScanRangeParams _scan_params(const std::string& line_delimiter, TTupleId tuple_id,
+                                      const std::vector<int>& column_idxs) const {
+        TFileScanRangeParams params;
+        params.__set_format_type(TFileFormatType::FORMAT_CSV_PLAIN);
+        params.__set_compress_type(TFileCompressType::PLAIN);
+        params.__set_file_type(TFileType::FILE_LOCAL);
+        TFileTextScanRangeParams text_params;
+        text_params.__set_column_separator(",");
+        text_params.__set_line_delimiter(line_delimiter);
+        TFileAttributes file_attributes;
+        file_attributes.__set_text_params(text_params);
+        params.__set_file_attributes(file_attributes);
+        std::vector<TFileScanSlotInfo> required_slots;
+        for (const auto* slot : _slots(tuple_id)) {
+            TFileScanSlotInfo slot_info;
+            slot_info.__set_slot_id(slot->id());
+            slot_info.__set_is_file_slot(slot->col_name() != "p");
+            required_slots.push_back(slot_info);
+        }
+        params.__set_required_slots(required_slots);
+        params.__set_column_idxs(column_idxs);
+        return params;
+    }
+
+    TFileScanRangeParams _split_params(const std::string& line_delimiter) const {
+        return _scan_params(line_delimiter, SPLIT_TUPLE, {0, 1});
+    }
+
+    // The value of a file slot, where an hll is its cardinality.
+    static std::string _value_string(const SlotDescriptor* slot,
+                                     const ColumnWithTypeAndName& column, size_t row) {
+        const auto& null_column = assert_cast<const ColumnNullable&>(*column.column);
+        if (null_column.is_null_at(row)) {
+            return "NULL";
+        }
+        if (slot->type().type == TYPE_HLL) {
+            const auto& hll_column = assert_cast<const ColumnHLL&>(null_column.get_nested_column());
+            return std::to_string(hll_column.get_element(row).estimate_cardinality());
+        }
+        return column.type->to_string(*column.column, row);
+    }
+
+    // The rows of the range [start_offset, start_offset + size) as the comma separated values of
+    // the file slots. The block of a query has the columns of all the slots of the tuple, in
+    // which the partition column is not filled by the reader. The block of a load has the
+    // columns of the file slots.
+    std::vector<std::string> _read_range(const TFileScanRangeParams& params, int64_t start_offset,
+                                         int64_t size, TTupleId tuple_id = SPLIT_TUPLE,
+                                         bool is_load = false) {
+        TFileRangeDesc range;
+        range.__set_path(_file_path);
+        range.__set_start_offset(start_offset);
+        range.__set_size(size);
+        range.__set_file_size(_file_size);
+        RuntimeProfile profile("CsvReaderTest");
+        ScannerCounter counter;
+        const auto file_slots = _file_slots(tuple_id);
+        const auto& block_slots = is_load ? file_slots : _slots(tuple_id);
+        CsvReader reader(_state.get(), &profile, &counter, params, range, file_slots, nullptr);
+        auto st = reader.init_reader(is_load);
+        EXPECT_TRUE(st.ok()) << st;
+
+        std::vector<std::string> rows;
+        bool eof = false;
+        while (st.ok() && !eof) {
+            Block block;
+            for (const auto* slot : block_slots) {
+                block.insert({slot->get_empty_mutable_column(), slot->get_data_type_ptr(),
+                              slot->col_name()});
+            }
+            size_t read_rows = 0;
+            st = reader.get_next_block(&block, &read_rows, &eof);
+            EXPECT_TRUE(st.ok()) << st;
+            for (size_t i = 0; i < read_rows; ++i) {
+                std::string row;
+                for (size_t pos = 0; pos < block_slots.size(); ++pos) {
+                    const auto* slot = block_slots[pos];
+                    if (slot->col_name() == "p") {
+                        continue;
+                    }
+                    const auto& column = block.get_by_position(pos);
+                    EXPECT_EQ(read_rows, column.column->size()) << slot->col_name();
+                    row += (row.empty() ? "" : ",") + _value_string(slot, column, i);
+                }
+                rows.push_back(std::move(row));
+            }
+        }
+        return rows;
+    }
+
+    // Reads the file in two ranges split at every offset, which includes the offsets inside a
+    // multi-byte line delimiter and at either side of each delimiter.
+    void _check_split_at_every_offset(const std::string& line_delimiter,
+                                      bool trailing_delimiter) {
+        auto lines = _lines();
+        _write_file(lines, line_delimiter, trailing_delimiter);
+        auto params = _split_params(line_delimiter);
+        for (int64_t offset = 1; offset <= _file_size; ++offset) {
+            auto rows = _read_range(params, 0, offset);
+            auto second_rows = _read_range(params, offset, _file_size - offset);
+            rows.insert(rows.end(), second_rows.begin(), second_rows.end());
+            EXPECT_EQ(lines, rows) << "split at " << offset;
+        }
+    }
+
+    // Reads the file in the ranges of `range_size` bytes, so that a range may start and end
+    // inside the same line or the same delimiter.
+    void _check_small_ranges(const std::string& line_delimiter, bool trailing_delimiter) {
+        auto lines = _lines();
+        _write_file(lines, line_delimiter, trailing_delimiter);
+        auto params = _split_params(line_delimiter);
+        for (int64_t range_size = 1; range_size <= 8; ++range_size) {
+            std::vector<std::string> rows;
+            for (int64_t offset = 0; offset < _file_size; offset += range_size) {
+                auto range_rows =
+                        _read_range(params, offset, std::min(range_size, _file_size - offset));
+                rows.insert(rows.end(), range_rows.begin(), range_rows.end());
+            }
+            EXPECT_EQ(lines, rows) << "range size " << range_size;
+        }
+    }
+
+    // An hll of one value, whose serialized bytes are printable.
+    static std::string _hll_text() {
+        HyperLogLog hll(0x4142434445464748);
+        std::string text(hll.max_serialized_size(), '\0');
+        text.resize(hll.serialize(reinterpret_cast<uint8_t*>(text.data())));
+        return text;
+    }
+
+    // The fields of row i of the parse tests: k, h, a column which is not read by the query,
+    // d and s. The fields which can not be parsed are "x" of k, "bad" of h, which is read as an
+    // empty hll, and "x" of d, while "nan", "inf" and the out of range "1e400" of d are parsed.
+    static std::vector<std::string> _parse_fields(int i) {
+        static const std::string special_doubles[] = {"nan", "inf", "1e400", "x"};
+        std::string k = i % 11 == 0 ? "\\N" : i % 13 == 0 ? "x" : std::to_string(i);
+        std::string h = i % 3 == 0 ? "\\N" : i % 3 == 1 ? _hll_text() : "bad";
+        std::string d = i % 7 == 0 ? special_doubles[i / 7 % 4] : std::to_string(i) + ".5";
+        std::string s = i % 5 == 0 ? "\\N" : "s" + std::to_string(i);
+        return {k, h, "unread", d, s};
+    }
+
+    static std::string _join(const std::vector<std::string>& fields) {
+        std::string line;
+        for (const auto& field : fields) {
+            line += (line.empty() ? "" : ",") + field;
+        }
+        return line;
+    }
+
+    void _write_parse_file() {
+        std::vector<std::string> lines;
+        for (int i = 0; i < PARSE_ROWS; ++i) {
+            lines.push_back(_join(_parse_fields(i)));
+        }
+        _write_file(lines, "\n", true);
+    }
+
+    // more than one block of rows
+    static constexpr int PARSE_ROWS = 5000;
+    static constexpr auto kTestDir = "./ut_dir/csv_reader_test";
+    const std::string _file_path = std::string(kTestDir) + "/test.csv";
+    int64_t _file_size = 0;
+    ObjectPool _pool;
+    TDescriptorTable _t_desc_tbl;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::unique_ptr<RuntimeState> _state;
+};
+
+TEST_F(CsvReaderTest, split_single_byte_delimiter) {
+    _check_split_at_every_offset("\n", true);
+    _check_split_at_every_offset("\n", false);
+    _check_small_ranges("\n", true);
+    _check_small_ranges("\n", false);
+}
+
+TEST_F(CsvReaderTest, split_crlf_delimiter) {
+    _check_split_at_every_offset("\r\n", true);
+    _check_split_at_every_offset("\r\n", false);
+    _check_small_ranges("\r\n", true);
+    _check_small_ranges("\r\n", false);
+
+    // the split offset is between '\r' and '\n' of the first line
+    auto lines = _lines();
+    _write_file(lines, "\r\n", true);
+    auto params = _split_params("\r\n");
+    int64_t offset = lines[0].size() + 1;
+    EXPECT_EQ(std::vector<std::string>({lines[0]}), _read_range(params, 0, offset));
+    auto rows = _read_range(params, offset, _file_size - offset);
+    EXPECT_EQ(std::vector<std::string>(lines.begin() + 1, lines.end()), rows);
+}
+
+TEST_F(CsvReaderTest, split_scan_ranges) {
+    auto origin_split_size = config::csv_scan_range_split_size_mb;
+    config::csv_scan_range_split_size_mb = 2;
+    constexpr int64_t MB = 1 << 20;
+
+    TScanRangeParams scan_range;
+    auto& file_scan_range = scan_range.scan_range.ext_scan_range.file_scan_range;
+    file_scan_range.__set_params(_split_params("\n"));
+    TFileRangeDesc large_range;
+    large_range.__set_path("large.csv");
+    large_range.__set_start_offset(100);
+    large_range.__set_size(5 * MB);
+    TFileRangeDesc small_range;
+    small_range.__set_path("small.csv");
+    small_range.__set_start_offset(0);
+    small_range.__set_size(MB);
+    file_scan_range.__set_ranges({large_range, small_range});
+
+    // the large range is split into contiguous ranges, the small range is kept
+    auto split_ranges = NewFileScanNode::_split_csv_scan_ranges({scan_range});
+    ASSERT_EQ(4, split_ranges.size());
+    int64_t offset = 100;
+    for (int i = 0; i < 3; ++i) {
+        const auto& ranges = split_ranges[i].scan_range.ext_scan_range.file_scan_range.ranges;
+        ASSERT_EQ(1, ranges.size());
+        EXPECT_EQ("large.csv", ranges[0].path);
+        EXPECT_EQ(offset, ranges[0].start_offset);
+        EXPECT_EQ(i < 2 ? 2 * MB : MB, ranges[0].size);
+        offset += ranges[0].size;
+    }
+    const auto& small_ranges = split_ranges[3].scan_range.ext_scan_range.file_scan_range.ranges;
+    ASSERT_EQ(1, small_ranges.size());
+    EXPECT_EQ("small.csv", small_ranges[0].path);
+
+    // the compressed file can not be read from an offset
+    file_scan_range.params.__set_compress_type(TFileCompressType::GZ);
+    EXPECT_EQ(1, NewFileScanNode::_split_csv_scan_ranges({scan_range}).size());
+
+    config::csv_scan_range_split_size_mb = origin_split_size;
+}
+
+// In a query, h is written by TextConverter value by value while the other columns are parsed in
+// batches after the rows of the block are split, so the columns must stay aligned.
+TEST_F(CsvReaderTest, parse_query_columns) {
+    _write_parse_file();
+    auto params = _scan_params("\n", QUERY_TUPLE, {0, 1, 3, 4});
+    ASSERT_TRUE(_slots(QUERY_TUPLE)[2]->type().type == TYPE_HLL);
+    std::vector<std::string> expected;
+    for (int i = 0; i < PARSE_ROWS; ++i) {
+        std::string k = i % 11 == 0 || i % 13 == 0 ? "NULL" : std::to_string(i);
+        std::string h = i % 3 == 0 ? "NULL" : i % 3 == 1 ? "1" : "0";
+        // parsed as TextConverter does, where only "x" fails and 1e400 overflows to inf
+        static const std::string special_doubles[] = {"nan", "inf", "inf", "NULL"};
+        std::string d = i % 7 == 0 ? special_doubles[i / 7 % 4] : std::to_string(i) + ".5";
+        std::string s = i % 5 == 0 ? "NULL" : "s" + std::to_string(i);
+        expected.push_back(_join({k, h, d, s}));
+    }
+    EXPECT_EQ(expected, _read_range(params, 0, _file_size, QUERY_TUPLE));
+}
+
+// A load reads every column as a string, which is written straight from the line.
+TEST_F(CsvReaderTest, parse_load_columns) {
+    _write_parse_file();
+    auto params = _scan_params("\n", LOAD_TUPLE, {});
+    std::vector<std::string> expected;
+    for (int i = 0; i < PARSE_ROWS; ++i) {
+        auto fields = _parse_fields(i);
+        for (auto& field : fields) {
+            if (field == "\\N") {
+                field = "NULL";
+            }
+        }
+        expected.push_back(_join(fields));
+    }
+    EXPECT_EQ(expected, _read_range(params, 0, _file_size, LOAD_TUPLE, true));
+}
+
+} // namespace doris::vectorized
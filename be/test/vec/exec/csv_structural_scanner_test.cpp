@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/csv/csv_structural_scanner.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace doris::vectorized {
+
+// The positions of `separator` before the first `delimiter` in text[from, to), byte by byte.
+static std::vector<size_t> expected_positions(const std::string& text, size_t from, size_t to,
+                                              char separator, char delimiter, size_t* line_end) {
+    std::vector<size_t> positions;
+    *line_end = std::string::npos;
+    for (size_t i = from; i < to; ++i) {
+        if (text[i] == delimiter) {
+            *line_end = i;
+            break;
+        }
+        if (text[i] == separator) {
+            positions.push_back(i);
+        }
+    }
+    return positions;
+}
+
+TEST(CsvStructuralScannerTest, find_line_delimiter) {
+    std::string text;
+    for (int i = 0; i < 1000; ++i) {
+        text += std::to_string(i * 7919 % 1000);
+        text += (i % 13 == 12) ? '\n' : ',';
+    }
+    CsvStructuralScanner scanner(',', '\n');
+    // start from every offset to cover the tails shorter than 32 bytes
+    for (size_t from = 0; from < 100; ++from) {
+        size_t line_end;
+        auto expected = expected_positions(text, from, text.size(), ',', '\n', &line_end);
+        std::vector<size_t> positions;
+        const char* pos = scanner.find_line_delimiter(text.data(), from, text.size(), &positions);
+        ASSERT_NE(nullptr, pos);
+        EXPECT_EQ(line_end, pos - text.data());
+        EXPECT_EQ(expected, positions);
+    }
+
+    // no line delimiter
+    std::string line = text.substr(0, text.find('\n'));
+    std::vector<size_t> positions;
+    EXPECT_EQ(nullptr, scanner.find_line_delimiter(line.data(), 0, line.size(), &positions));
+    size_t line_end;
+    EXPECT_EQ(expected_positions(line, 0, line.size(), ',', '\n', &line_end), positions);
+}
+
+TEST(CsvStructuralScannerTest, column_separator_only) {
+    std::string text(100, 'a');
+    text[3] = '\n';
+    text[5] = '|';
+    text[40] = '|';
+    text[99] = '|';
+    CsvStructuralScanner scanner('|');
+    std::vector<size_t> positions;
+    EXPECT_EQ(nullptr, scanner.find_line_delimiter(text.data(), 0, text.size(), &positions));
+    EXPECT_EQ(std::vector<size_t>({5, 40, 99}), positions);
+}
+
+} // namespace doris::vectorized
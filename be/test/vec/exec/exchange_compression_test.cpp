@@ -0,0 +1,131 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/exchange_compression.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "agent/be_exec_version_manager.h"
+#include "common/config.h"
+#include "gen_cpp/data.pb.h"
+#include "vec/columns/column_string.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+class AdaptiveExchangeCompressionTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _old_interval = config::adaptive_exchange_compression_sample_interval;
+        _old_bandwidth = config::adaptive_exchange_compression_bandwidth_mb;
+        config::adaptive_exchange_compression_sample_interval = 4;
+    }
+
+    void TearDown() override {
+        config::adaptive_exchange_compression_sample_interval = _old_interval;
+        config::adaptive_exchange_compression_bandwidth_mb = _old_bandwidth;
+    }
+
+    // Distinct strings with a lot of repeated text, so that the dictionary encoding does not
+    // apply but the codecs compress well.
+    static Block make_block() {
+        auto column = ColumnString::create();
+        for (int i = 0; i < 4096; ++i) {
+            std::string value = "a repeated prefix of some length " + std::to_string(i);
+            column->insert_data(value.data(), value.size());
+        }
+        return Block({{column->get_ptr(), std::make_shared<DataTypeString>(), "test_string"}});
+    }
+
+    // Sends `num_blocks` blocks and returns the codec used for the last one.
+    static segment_v2::CompressionTypePB send(AdaptiveExchangeCompression* compression,
+                                              const Block& block, int num_blocks) {
+        for (int i = 0; i < num_blocks; ++i) {
+            PBlock pblock;
+            size_t uncompressed_bytes = 0;
+            size_t compressed_bytes = 0;
+            int64_t compress_time_ns = 0;
+            if (compression->need_sample()) {
+                EXPECT_TRUE(block.serialize(BeExecVersionManager::get_newest_version(), &pblock,
+                                            &uncompressed_bytes, &compressed_bytes,
+                                            segment_v2::CompressionTypePB::NO_COMPRESSION)
+                                    .ok());
+                EXPECT_TRUE(
+                        compression->sample(&pblock, &compressed_bytes, &compress_time_ns).ok());
+            } else {
+                EXPECT_TRUE(block.serialize(BeExecVersionManager::get_newest_version(), &pblock,
+                                            &uncompressed_bytes, &compressed_bytes,
+                                            compression->codec())
+                                    .ok());
+                compression->update(uncompressed_bytes, compressed_bytes, compress_time_ns);
+            }
+            EXPECT_EQ(compressed_bytes, pblock.column_values().size());
+            Block block2(pblock);
+            EXPECT_EQ(block.dump_data(), block2.dump_data());
+        }
+        return compression->codec();
+    }
+
+    int32_t _old_interval;
+    int32_t _old_bandwidth;
+};
+
+TEST_F(AdaptiveExchangeCompressionTest, FastNetwork) {
+    config::adaptive_exchange_compression_bandwidth_mb = 100000000;
+    AdaptiveExchangeCompression compression;
+    Block block = make_block();
+    EXPECT_EQ(segment_v2::CompressionTypePB::NO_COMPRESSION, send(&compression, block, 10));
+}
+
+TEST_F(AdaptiveExchangeCompressionTest, SlowNetwork) {
+    config::adaptive_exchange_compression_bandwidth_mb = 1;
+    AdaptiveExchangeCompression compression;
+    Block block = make_block();
+    EXPECT_NE(segment_v2::CompressionTypePB::NO_COMPRESSION, send(&compression, block, 10));
+}
+
+TEST_F(AdaptiveExchangeCompressionTest, MeasuredThroughput) {
+    // the configured bandwidth is fast, the channels measure their own
+    config::adaptive_exchange_compression_bandwidth_mb = 100000000;
+    Block block = make_block();
+    AdaptiveExchangeCompression slow_channel;
+    AdaptiveExchangeCompression fast_channel;
+    for (int i = 0; i < 10; ++i) {
+        // 1 MB/s
+        slow_channel.update_transfer(1024 * 1024, 1000L * 1000 * 1000);
+    }
+    EXPECT_NE(segment_v2::CompressionTypePB::NO_COMPRESSION, send(&slow_channel, block, 10));
+    EXPECT_EQ(segment_v2::CompressionTypePB::NO_COMPRESSION, send(&fast_channel, block, 10));
+
+    // the codec follows a change of the throughput before the next sample
+    for (int i = 0; i < 100; ++i) {
+        slow_channel.update_transfer(1024 * 1024, 1000);
+    }
+    EXPECT_EQ(segment_v2::CompressionTypePB::NO_COMPRESSION, send(&slow_channel, block, 1));
+
+    // the time of a small RPC is mostly the round trip
+    AdaptiveExchangeCompression small_rpcs;
+    for (int i = 0; i < 10; ++i) {
+        small_rpcs.update_transfer(100, 1000L * 1000 * 1000);
+    }
+    EXPECT_EQ(segment_v2::CompressionTypePB::NO_COMPRESSION, send(&small_rpcs, block, 10));
+}
+
+} // namespace doris::vectorized
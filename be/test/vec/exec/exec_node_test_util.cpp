@@ -0,0 +1,142 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/exec_node_test_util.h"
+
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include "exec/exec_node.h"
+#include "io/fs/local_file_system.h"
+#include "olap/options.h"
+#include "runtime/block_spill_manager.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_filter_mgr.h"
+#include "runtime/runtime_state.h"
+#include "runtime/types.h"
+
+namespace doris::vectorized {
+
+TSlotDescriptor create_slot_desc(PrimitiveType type, const std::string& name, bool nullable) {
+    return TSlotDescriptorBuilder().type(type).nullable(nullable).column_name(name).build();
+}
+
+TExprNode create_slot_ref_node(const TSlotDescriptor& slot) {
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::SLOT_REF);
+    node.__set_type(slot.slotType);
+    node.__set_num_children(0);
+    node.__set_is_nullable(slot.nullIndicatorBit >= 0);
+    TSlotRef slot_ref;
+    slot_ref.__set_slot_id(slot.id);
+    slot_ref.__set_tuple_id(slot.parent);
+    node.__set_slot_ref(slot_ref);
+    return node;
+}
+
+TExpr create_slot_ref(const TSlotDescriptor& slot) {
+    TExpr expr;
+    expr.nodes.push_back(create_slot_ref_node(slot));
+    return expr;
+}
+
+TExpr create_agg_fn_expr(const std::string& fn_name, const std::vector<TSlotDescriptor>& args,
+                         PrimitiveType ret_type) {
+    TFunction fn;
+    fn.name.__set_function_name(fn_name);
+    fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+    for (const auto& arg : args) {
+        fn.arg_types.push_back(arg.slotType);
+    }
+    fn.__set_ret_type(TypeDescriptor(ret_type).to_thrift());
+    fn.__set_has_var_args(false);
+
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::AGG_EXPR);
+    node.__set_type(fn.ret_type);
+    node.__set_num_children(args.size());
+    node.__set_is_nullable(false);
+    node.__set_fn(fn);
+    TAggregateExpr agg_expr;
+    agg_expr.__set_is_merge_agg(false);
+    node.__set_agg_expr(agg_expr);
+
+    TExpr expr;
+    expr.nodes.push_back(node);
+    for (const auto& arg : args) {
+        expr.nodes.push_back(create_slot_ref_node(arg));
+    }
+    return expr;
+}
+
+TPlanNode create_plan_node(TPlanNodeType::type node_type, int node_id,
+                           const std::vector<TTupleId>& row_tuples, int num_children) {
+    TPlanNode node;
+    node.__set_node_id(node_id);
+    node.__set_node_type(node_type);
+    node.__set_num_children(num_children);
+    node.__set_limit(-1);
+    node.__set_row_tuples(row_tuples);
+    node.__set_nullable_tuples(std::vector<bool>(row_tuples.size(), false));
+    node.__set_compact_data(false);
+    return node;
+}
+
+TPlanNode create_empty_set_node(int node_id, TTupleId tuple_id) {
+    return create_plan_node(TPlanNodeType::EMPTY_SET_NODE, node_id, {tuple_id}, 0);
+}
+
+ExecNodeTestEnv::ExecNodeTestEnv(const TQueryOptions& query_options,
+                                 const TDescriptorTable& desc_tbl) {
+    _state = std::make_unique<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(),
+                                            ExecEnv::GetInstance());
+    _state->init_mem_trackers(TUniqueId());
+    CHECK(_state->runtime_filter_mgr()->init().ok());
+    CHECK(DescriptorTbl::create(&_pool, desc_tbl, &_desc_tbl).ok());
+    _state->set_desc_tbl(_desc_tbl);
+
+    char buffer[1024];
+    CHECK(getcwd(buffer, sizeof(buffer)) != nullptr);
+    _spill_dir = fmt::format("{}/exec_node_test_spill_{}", buffer, getpid());
+    CHECK(io::global_local_filesystem()->delete_and_create_directory(_spill_dir).ok());
+    _spill_mgr = std::make_unique<BlockSpillManager>(std::vector<StorePath> {{_spill_dir, -1}});
+    CHECK(_spill_mgr->init().ok());
+    _origin_spill_mgr = ExecEnv::GetInstance()->_block_spill_mgr;
+    ExecEnv::GetInstance()->_block_spill_mgr = _spill_mgr.get();
+}
+
+ExecNodeTestEnv::~ExecNodeTestEnv() {
+    for (auto* root : _roots) {
+        static_cast<void>(root->close(_state.get()));
+    }
+    ExecEnv::GetInstance()->_block_spill_mgr = _origin_spill_mgr;
+    _spill_mgr.reset();
+    static_cast<void>(io::global_local_filesystem()->delete_directory(_spill_dir));
+}
+
+Status ExecNodeTestEnv::create_exec_node(const std::vector<TPlanNode>& nodes, ExecNode** root) {
+    TPlan plan;
+    plan.__set_nodes(nodes);
+    RETURN_IF_ERROR(ExecNode::create_tree(_state.get(), &_pool, plan, *_desc_tbl, root));
+    _roots.push_back(*root);
+    RETURN_IF_ERROR((*root)->prepare(_state.get()));
+    return (*root)->alloc_resource(_state.get());
+}
+
+} // namespace doris::vectorized
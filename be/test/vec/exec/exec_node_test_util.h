@@ -0,0 +1,83 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "common/status.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PaloInternalService_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/primitive_type.h"
+
+namespace doris {
+class BlockSpillManager;
+class DescriptorTbl;
+class ExecNode;
+class RuntimeState;
+
+namespace vectorized {
+
+// A slot of `type` to add to a TTupleDescriptorBuilder.
+TSlotDescriptor create_slot_desc(PrimitiveType type, const std::string& name,
+                                 bool nullable = false);
+
+// Thrift exprs of the slots of a TDescriptorTable, used to plan the exec nodes under test.
+TExprNode create_slot_ref_node(const TSlotDescriptor& slot);
+TExpr create_slot_ref(const TSlotDescriptor& slot);
+
+// An aggregate function `fn_name(args)` returning a non-nullable `ret_type`.
+TExpr create_agg_fn_expr(const std::string& fn_name, const std::vector<TSlotDescriptor>& args,
+                         PrimitiveType ret_type);
+
+TPlanNode create_plan_node(TPlanNodeType::type node_type, int node_id,
+                           const std::vector<TTupleId>& row_tuples, int num_children);
+
+// An empty set node, the dummy child of the nodes whose input blocks are pushed by the test.
+TPlanNode create_empty_set_node(int node_id, TTupleId tuple_id);
+
+// Runs exec nodes outside of a fragment. It owns the runtime state and the descriptor table,
+// and spills to a temporary directory while it is alive.
+class ExecNodeTestEnv {
+public:
+    ExecNodeTestEnv(const TQueryOptions& query_options, const TDescriptorTable& desc_tbl);
+    ~ExecNodeTestEnv();
+
+    // Creates the tree of `nodes` in preorder, then prepares and opens the root.
+    Status create_exec_node(const std::vector<TPlanNode>& nodes, ExecNode** root);
+
+    RuntimeState* state() { return _state.get(); }
+    const DescriptorTbl& desc_tbl() const { return *_desc_tbl; }
+
+private:
+    ObjectPool _pool;
+    std::unique_ptr<RuntimeState> _state;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::vector<ExecNode*> _roots;
+
+    std::string _spill_dir;
+    std::unique_ptr<BlockSpillManager> _spill_mgr;
+    BlockSpillManager* _origin_spill_mgr = nullptr;
+};
+
+} // namespace vectorized
+} // namespace doris
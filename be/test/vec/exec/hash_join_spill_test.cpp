@@ -0,0 +1,375 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "exprs/bloom_filter_func.h"
+#include "exprs/runtime_filter.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/runtime_filter_mgr.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exec/exec_node_test_util.h"
+#include "vec/exec/join/vhash_join_node.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+struct Row {
+    int32_t k;
+    int32_t v;
+};
+
+bool output_left(TJoinOp::type op) {
+    return op != TJoinOp::RIGHT_SEMI_JOIN && op != TJoinOp::RIGHT_ANTI_JOIN;
+}
+
+bool output_right(TJoinOp::type op) {
+    return op != TJoinOp::LEFT_SEMI_JOIN && op != TJoinOp::LEFT_ANTI_JOIN;
+}
+
+std::string format_row(const Row* left, const Row* right, TJoinOp::type op) {
+    auto format = [](const Row* row) {
+        return row ? fmt::format("{},{}", row->k, row->v) : std::string("NULL,NULL");
+    };
+    std::string result;
+    if (output_left(op)) {
+        result += format(left);
+    }
+    if (output_right(op)) {
+        result += (result.empty() ? "" : ",") + format(right);
+    }
+    return result;
+}
+
+// Joins the rows by nested loops.
+std::vector<std::string> naive_join(const std::vector<Row>& left, const std::vector<Row>& right,
+                                    TJoinOp::type op) {
+    std::vector<std::string> result;
+    std::vector<bool> right_matched(right.size(), false);
+    for (const auto& l : left) {
+        bool matched = false;
+        for (size_t i = 0; i < right.size(); ++i) {
+            if (l.k != right[i].k) {
+                continue;
+            }
+            matched = true;
+            right_matched[i] = true;
+            if (op == TJoinOp::INNER_JOIN || op == TJoinOp::LEFT_OUTER_JOIN ||
+                op == TJoinOp::RIGHT_OUTER_JOIN || op == TJoinOp::FULL_OUTER_JOIN) {
+                result.push_back(format_row(&l, &right[i], op));
+            }
+        }
+        if ((matched && op == TJoinOp::LEFT_SEMI_JOIN) ||
+            (!matched && op == TJoinOp::LEFT_ANTI_JOIN)) {
+            result.push_back(format_row(&l, nullptr, op));
+        } else if (!matched &&
+                   (op == TJoinOp::LEFT_OUTER_JOIN || op == TJoinOp::FULL_OUTER_JOIN)) {
+            result.push_back(format_row(&l, nullptr, op));
+        }
+    }
+    for (size_t i = 0; i < right.size(); ++i) {
+        const bool matched = right_matched[i];
+        if ((matched && op == TJoinOp::RIGHT_SEMI_JOIN) ||
+            (!matched && op == TJoinOp::RIGHT_ANTI_JOIN) ||
+            (!matched && (op == TJoinOp::RIGHT_OUTER_JOIN || op == TJoinOp::FULL_OUTER_JOIN))) {
+            result.push_back(format_row(nullptr, &right[i], op));
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+Block rows_to_block(const std::vector<Row>& rows, size_t begin, size_t end) {
+    auto k = ColumnInt32::create();
+    auto v = ColumnInt32::create();
+    for (size_t i = begin; i < end; ++i) {
+        k->insert_value(rows[i].k);
+        v->insert_value(rows[i].v);
+    }
+    auto type = std::make_shared<DataTypeInt32>();
+    Block block;
+    block.insert(ColumnWithTypeAndName(std::move(k), type, "k"));
+    block.insert(ColumnWithTypeAndName(std::move(v), type, "v"));
+    return block;
+}
+
+std::string column_value(const ColumnWithTypeAndName& column, size_t row) {
+    if (column.column->is_null_at(row)) {
+        return "NULL";
+    }
+    return std::to_string(remove_nullable(column.column)->get_int(row));
+}
+
+} // namespace
+
+// select * from l join r on l.k = r.k, with l as the probe side and r as the build side.
+class HashJoinSpillTest : public testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 3000; ++i) {
+            _left.push_back({i % 700, i});
+        }
+        for (int i = 0; i < 2000; ++i) {
+            _right.push_back({i % 600 + 300, i});
+        }
+    }
+
+    // tuple 0 and 1: the rows of l and r, tuple 2 and 3: l and r in the join block,
+    // tuple 4: the output.
+    static TDescriptorTable join_desc_tbl(TJoinOp::type op) {
+        const bool left_nullable =
+                op == TJoinOp::RIGHT_OUTER_JOIN || op == TJoinOp::FULL_OUTER_JOIN;
+        const bool right_nullable =
+                op == TJoinOp::LEFT_OUTER_JOIN || op == TJoinOp::FULL_OUTER_JOIN;
+        TDescriptorTableBuilder builder;
+        for (bool nullable : {false, false, left_nullable, right_nullable}) {
+            TTupleDescriptorBuilder()
+                    .add_slot(create_slot_desc(TYPE_INT, "k", nullable))
+                    .add_slot(create_slot_desc(TYPE_INT, "v", nullable))
+                    .build(&builder);
+        }
+        TTupleDescriptorBuilder output;
+        for (int i = 0; i < output_left(op) + output_right(op); ++i) {
+            output.add_slot(create_slot_desc(TYPE_INT, "k", true))
+                    .add_slot(create_slot_desc(TYPE_INT, "v", true));
+        }
+        output.build(&builder);
+        return builder.desc_tbl();
+    }
+
+    static TRuntimeFilterDesc runtime_filter_desc(const TDescriptorTable& desc_tbl) {
+        const auto& slots = desc_tbl.slotDescriptors;
+        TRuntimeFilterDesc desc;
+        desc.__set_filter_id(0);
+        desc.__set_src_expr(create_slot_ref(slots[2]));
+        desc.__set_expr_order(0);
+        desc.__set_planId_to_target_expr({{1, create_slot_ref(slots[0])}});
+        desc.__set_is_broadcast_join(false);
+        desc.__set_has_local_targets(true);
+        desc.__set_has_remote_targets(false);
+        desc.__set_type(TRuntimeFilterType::IN_OR_BLOOM);
+        desc.__set_bloom_filter_size_bytes(1 << 20);
+        return desc;
+    }
+
+    static std::vector<TPlanNode> join_plan(TJoinOp::type op, const TDescriptorTable& desc_tbl,
+                                            const std::vector<TRuntimeFilterDesc>& filters) {
+        const auto& slots = desc_tbl.slotDescriptors;
+        auto join_node = create_plan_node(TPlanNodeType::HASH_JOIN_NODE, 0, {4}, 2);
+        THashJoinNode join;
+        join.__set_join_op(op);
+        TEqJoinCondition eq_join_conjunct;
+        eq_join_conjunct.__set_left(create_slot_ref(slots[0]));
+        eq_join_conjunct.__set_right(create_slot_ref(slots[2]));
+        join.__set_eq_join_conjuncts({eq_join_conjunct});
+        std::vector<TTupleId> intermediate_tuples;
+        std::vector<TExpr> output_exprs;
+        if (output_left(op)) {
+            intermediate_tuples.push_back(2);
+            output_exprs.push_back(create_slot_ref(slots[4]));
+            output_exprs.push_back(create_slot_ref(slots[5]));
+        }
+        if (output_right(op)) {
+            intermediate_tuples.push_back(3);
+            output_exprs.push_back(create_slot_ref(slots[6]));
+            output_exprs.push_back(create_slot_ref(slots[7]));
+        }
+        join.__set_vintermediate_tuple_id_list(intermediate_tuples);
+        join.__set_srcExprList(output_exprs);
+        join.__set_voutput_tuple_id(4);
+        join.__set_is_broadcast_join(false);
+        join_node.__set_hash_join_node(join);
+        if (!filters.empty()) {
+            join_node.__set_runtime_filters(filters);
+        }
+        return {join_node, create_empty_set_node(1, 0), create_empty_set_node(2, 1)};
+    }
+
+    // Runs the join the way the pipeline operators drive it. `check_build` is called once
+    // the whole build side has been sunk, and `check_end` once all the rows are pulled.
+    std::vector<std::string> join(TJoinOp::type op, int64_t spill_threshold,
+                                  bool with_runtime_filter,
+                                  const std::function<void(HashJoinNode*)>& check_build,
+                                  const std::function<void(HashJoinNode*)>& check_end = {}) {
+        TQueryOptions query_options;
+        query_options.__set_batch_size(1024);
+        query_options.__set_runtime_filter_max_in_num(1024);
+        query_options.__set_external_join_bytes_threshold(spill_threshold);
+        auto desc_tbl = join_desc_tbl(op);
+        ExecNodeTestEnv env(query_options, desc_tbl);
+        if (_query_mem_limit >= 0) {
+            env.state()->set_query_mem_tracker(std::make_shared<MemTrackerLimiter>(
+                    MemTrackerLimiter::Type::QUERY, "HashJoinSpillTest", _query_mem_limit));
+        }
+        std::vector<TRuntimeFilterDesc> filters;
+        if (with_runtime_filter) {
+            filters.push_back(runtime_filter_desc(desc_tbl));
+            auto st = env.state()->runtime_filter_mgr()->register_filter(
+                    RuntimeFilterRole::CONSUMER, filters[0], query_options, 1);
+            EXPECT_TRUE(st.ok()) << st;
+        }
+        ExecNode* node = nullptr;
+        auto st = env.create_exec_node(join_plan(op, desc_tbl, filters), &node);
+        EXPECT_TRUE(st.ok()) << st;
+        if (!st.ok()) {
+            return {};
+        }
+        auto* join_node = static_cast<HashJoinNode*>(node);
+
+        for (size_t begin = 0; begin < _right.size(); begin += 500) {
+            auto block = rows_to_block(_right, begin, std::min(begin + 500, _right.size()));
+            st = node->sink(env.state(), &block, false);
+            EXPECT_TRUE(st.ok()) << st;
+        }
+        Block empty_block;
+        st = node->sink(env.state(), &empty_block, true);
+        EXPECT_TRUE(st.ok()) << st;
+        check_build(join_node);
+
+        std::vector<std::string> result;
+        size_t probe_begin = 0;
+        bool eos = false;
+        while (!eos) {
+            if (join_node->need_more_input_data()) {
+                size_t probe_end = std::min(probe_begin + 700, _left.size());
+                auto block = rows_to_block(_left, probe_begin, probe_end);
+                probe_begin = probe_end;
+                join_node->prepare_for_next();
+                st = node->push(env.state(), &block, probe_end == _left.size());
+                EXPECT_TRUE(st.ok()) << st;
+            }
+            if (join_node->need_more_input_data()) {
+                continue;
+            }
+            Block block;
+            _pull_status = node->pull(env.state(), &block, &eos);
+            if (!_pull_status.ok()) {
+                break;
+            }
+            for (size_t row = 0; row < block.rows(); ++row) {
+                std::string line;
+                for (size_t i = 0; i < block.columns(); ++i) {
+                    line += (i == 0 ? "" : ",") + column_value(block.get_by_position(i), row);
+                }
+                result.push_back(line);
+            }
+        }
+        // only a query with a memory limit may fail
+        EXPECT_TRUE(_pull_status.ok() || _query_mem_limit >= 0) << _pull_status;
+        if (check_end) {
+            check_end(join_node);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::vector<Row> _left;
+    std::vector<Row> _right;
+    // the memory limit of the query, -1 means no limit
+    int64_t _query_mem_limit = -1;
+    Status _pull_status;
+};
+
+TEST_F(HashJoinSpillTest, every_join_type) {
+    for (auto op : {TJoinOp::INNER_JOIN, TJoinOp::LEFT_OUTER_JOIN, TJoinOp::RIGHT_OUTER_JOIN,
+                    TJoinOp::FULL_OUTER_JOIN, TJoinOp::LEFT_SEMI_JOIN, TJoinOp::LEFT_ANTI_JOIN,
+                    TJoinOp::RIGHT_SEMI_JOIN, TJoinOp::RIGHT_ANTI_JOIN}) {
+        auto expected = naive_join(_left, _right, op);
+        auto in_memory = join(op, 0, false, [](HashJoinNode* node) {
+            EXPECT_FALSE(node->_is_build_spilled);
+        });
+        EXPECT_EQ(expected, in_memory) << static_cast<int>(op);
+        // A threshold of 1 byte spills the whole build side, and splits every partition again
+        // when it is loaded.
+        auto spilled = join(op, 1, false, [](HashJoinNode* node) {
+            EXPECT_TRUE(node->_is_build_spilled);
+        });
+        EXPECT_EQ(expected, spilled) << static_cast<int>(op);
+    }
+}
+
+TEST_F(HashJoinSpillTest, repartition_depth_is_bounded) {
+    auto result = join(
+            TJoinOp::INNER_JOIN, 1, false,
+            [](HashJoinNode* node) {
+                EXPECT_EQ(HashJoinNode::SPILL_PARTITION_COUNT, node->_spilled_partitions.size());
+            },
+            [](HashJoinNode* node) {
+                // The partitions are split until every partition holds one key. A key is in one
+                // partition of each level, so at most 600 partitions are split at every level.
+                const int64_t partition_count = HashJoinNode::SPILL_PARTITION_COUNT;
+                EXPECT_GT(node->_spill_repartition_count->value(), partition_count);
+                EXPECT_LE(node->_spill_repartition_count->value(),
+                          600 * HashJoinNode::MAX_SPILL_LEVEL);
+            });
+    EXPECT_EQ(naive_join(_left, _right, TJoinOp::INNER_JOIN), result);
+}
+
+TEST_F(HashJoinSpillTest, skewed_partition) {
+    // all the build rows share one key, so splitting their partition does not make it smaller
+    for (auto& row : _right) {
+        row.k = 350;
+    }
+    auto expected = naive_join(_left, _right, TJoinOp::INNER_JOIN);
+    auto result = join(
+            TJoinOp::INNER_JOIN, 1, false,
+            [](HashJoinNode* node) { EXPECT_TRUE(node->_is_build_spilled); },
+            [](HashJoinNode* node) {
+                // the partition is split once, then joined in memory
+                EXPECT_EQ(1, node->_spill_repartition_count->value());
+            });
+    EXPECT_EQ(expected, result);
+
+    // without the memory for it, the query fails instead of exceeding its memory limit
+    _query_mem_limit = 1;
+    result = join(TJoinOp::INNER_JOIN, 1, false,
+                  [](HashJoinNode* node) { EXPECT_TRUE(node->_is_build_spilled); });
+    EXPECT_TRUE(_pull_status.is<ErrorCode::MEM_LIMIT_EXCEEDED>()) << _pull_status;
+}
+
+TEST_F(HashJoinSpillTest, runtime_filter_with_spilled_build) {
+    // The build side has only 600 distinct keys, fewer than runtime_filter_max_in_num, but it
+    // is spilled, so a bloom filter is built out of all the build rows.
+    auto result = join(TJoinOp::INNER_JOIN, 1, true, [&](HashJoinNode* node) {
+        ASSERT_TRUE(node->_is_build_spilled);
+        ASSERT_EQ(1, node->_runtime_filters.size());
+        auto* filter = node->_runtime_filters[0];
+        EXPECT_FALSE(filter->is_ignored());
+        ASSERT_TRUE(filter->is_bloomfilter());
+        for (const auto& row : _right) {
+            EXPECT_TRUE(filter->get_bloomfilter()->find(&row.k)) << row.k;
+        }
+        size_t false_positives = 0;
+        for (int32_t k = 0; k < 300; ++k) {
+            false_positives += filter->get_bloomfilter()->find(&k);
+        }
+        EXPECT_LT(false_positives, 30);
+    });
+    EXPECT_EQ(naive_join(_left, _right, TJoinOp::INNER_JOIN), result);
+}
+
+} // namespace doris::vectorized
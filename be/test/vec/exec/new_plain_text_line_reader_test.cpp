@@ -0,0 +1,144 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/file_reader/new_plain_text_line_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/fs/file_reader.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+
+// A file in memory which returns at most `chunk_size` bytes on each read, so that a line is
+// found after several refills of the line reader's buffer.
+class ChunkedFileReader : public io::FileReader {
+public:
+    ChunkedFileReader(std::string data, size_t chunk_size)
+            : _data(std::move(data)), _chunk_size(chunk_size) {}
+
+    Status close() override {
+        _closed = true;
+        return Status::OK();
+    }
+
+    const io::Path& path() const override { return _path; }
+
+    size_t size() const override { return _data.size(); }
+
+    bool closed() const override { return _closed; }
+
+    std::shared_ptr<io::FileSystem> fs() const override { return nullptr; }
+
+protected:
+    Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                        const io::IOContext* io_ctx) override {
+        size_t bytes = std::min({result.size, _chunk_size,
+                                 _data.size() - std::min(offset, _data.size())});
+        memcpy(result.data, _data.data() + offset, bytes);
+        *bytes_read = bytes;
+        return Status::OK();
+    }
+
+private:
+    std::string _data;
+    size_t _chunk_size;
+    io::Path _path = "chunked_file";
+    bool _closed = false;
+};
+
+class NewPlainTextLineReaderTest : public testing::Test {
+protected:
+    // Lines of various lengths and numbers of fields, some of them longer than a chunk.
+    static std::vector<std::string> _lines(size_t total_size) {
+        std::vector<std::string> lines;
+        size_t size = 0;
+        for (int i = 0; size < total_size; ++i) {
+            std::string line;
+            int num_fields = 1 + i % 40;
+            int field_size = i % 17 == 0 ? 10000 : (i * 7919) % 97;
+            for (int field = 0; field < num_fields; ++field) {
+                line += std::string(field_size, 'a' + field % 26);
+                line += ',';
+            }
+            size += line.size() + 1;
+            lines.push_back(std::move(line));
+        }
+        return lines;
+    }
+
+    static std::vector<size_t> _expected_field_pos(const std::string& line) {
+        std::vector<size_t> positions;
+        for (size_t i = 0; i < line.size(); ++i) {
+            if (line[i] == ',') {
+                positions.push_back(i);
+            }
+        }
+        return positions;
+    }
+
+    // Reads the lines, the last of which is not ended by the line delimiter, and checks the
+    // saved field positions of each line.
+    static void _check_field_pos(size_t total_size, size_t chunk_size) {
+        auto lines = _lines(total_size);
+        std::string data;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            data += lines[i];
+            if (i + 1 < lines.size()) {
+                data += '\n';
+            }
+        }
+        auto file_reader = std::make_shared<ChunkedFileReader>(data, chunk_size);
+        RuntimeProfile profile("NewPlainTextLineReaderTest");
+        NewPlainTextLineReader reader(&profile, file_reader, nullptr, data.size(), "\n", 1, 0);
+        reader.set_column_separator(',');
+
+        const uint8_t* ptr = nullptr;
+        size_t size = 0;
+        bool eof = false;
+        for (const auto& line : lines) {
+            ASSERT_TRUE(reader.read_line(&ptr, &size, &eof, nullptr).ok());
+            ASSERT_FALSE(eof);
+            ASSERT_EQ(line, std::string(reinterpret_cast<const char*>(ptr), size));
+            ASSERT_NE(nullptr, reader.field_pos());
+            ASSERT_EQ(_expected_field_pos(line), *reader.field_pos());
+        }
+        ASSERT_TRUE(reader.read_line(&ptr, &size, &eof, nullptr).ok());
+        EXPECT_TRUE(eof);
+    }
+};
+
+TEST_F(NewPlainTextLineReaderTest, field_pos_across_refills) {
+    // each byte is appended by a refill, and only the appended byte is scanned
+    _check_field_pos(64 * 1024, 1);
+    // refills which end at any offset of the 32 bytes scanned at a time
+    _check_field_pos(256 * 1024, 33);
+}
+
+TEST_F(NewPlainTextLineReaderTest, field_pos_after_buffer_compaction) {
+    // more than the 8MB output buffer, so the unread bytes of the line being scanned are moved
+    // to the beginning of the buffer before a refill
+    _check_field_pos(9 * 1024 * 1024, 4093);
+}
+
+} // namespace doris
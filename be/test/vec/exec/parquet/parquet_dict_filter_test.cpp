@@ -0,0 +1,451 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <gtest/gtest.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "io/fs/local_file_system.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/timezone_utils.h"
+#include "vec/columns/column_dict_codes.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/exec/exec_node_test_util.h"
+#include "vec/exec/format/parquet/vparquet_reader.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+// select id, s from t where <predicate on s>, where the string column s is fully dictionary
+// encoded in row group 0 and falls back to plain encoding in the middle of row group 1.
+class ParquetDictFilterTest : public testing::Test {
+public:
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+        TimezoneUtils::find_cctz_time_zone(TimezoneUtils::default_time_zone, _ctz);
+        _write_file();
+
+        TDescriptorTableBuilder builder;
+        TTupleDescriptorBuilder()
+                .add_slot(create_slot_desc(TYPE_INT, "id", true))
+                .add_slot(create_slot_desc(TYPE_STRING, "s", true))
+                .build(&builder);
+        _t_desc_tbl = builder.desc_tbl();
+        EXPECT_TRUE(DescriptorTbl::create(&_pool, _t_desc_tbl, &_desc_tbl).ok());
+        _state.reset(new RuntimeState(TQueryGlobals()));
+        _state->init_mem_trackers();
+        _state->set_desc_tbl(_desc_tbl);
+        _row_desc.reset(new RowDescriptor(*_desc_tbl, {0}, {false}));
+    }
+
+    void TearDown() override {
+        for (auto* ctx : _ctxs) {
+            ctx->close(_state.get());
+        }
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+    }
+
+protected:
+    using Predicate = std::function<bool(const std::optional<std::string>&)>;
+
+    static std::optional<std::string> _value(int row) {
+        static const char* LOW_CARDINALITY_VALUES[] = {"a", "b", "c", "d"};
+        if (row % 7 == 0) {
+            return std::nullopt;
+        }
+        if (row < 3 * GROUP_ROWS / 2 || row % 3 == 0) {
+            return LOW_CARDINALITY_VALUES[row % 4];
+        }
+        // grows the dictionary over dictionary_pagesize_limit
+        return "distinct_" + std::to_string(row);
+    }
+
+    void _write_file() {
+        arrow::Int32Builder id_builder;
+        arrow::StringBuilder s_builder;
+        for (int row = 0; row < NUM_GROUPS * GROUP_ROWS; ++row) {
+            EXPECT_TRUE(id_builder.Append(row).ok());
+            auto value = _value(row);
+            EXPECT_TRUE((value ? s_builder.Append(*value) : s_builder.AppendNull()).ok());
+        }
+        std::shared_ptr<arrow::Array> id_array;
+        std::shared_ptr<arrow::Array> s_array;
+        EXPECT_TRUE(id_builder.Finish(&id_array).ok());
+        EXPECT_TRUE(s_builder.Finish(&s_array).ok());
+        auto schema = arrow::schema(
+                {arrow::field("id", arrow::int32()), arrow::field("s", arrow::utf8())});
+        auto table = arrow::Table::Make(schema, {id_array, s_array});
+
+        parquet::WriterProperties::Builder builder;
+        builder.enable_dictionary()
+                ->dictionary_pagesize_limit(1024)
+                ->data_pagesize(1024)
+                ->write_batch_size(128);
+        auto output = arrow::io::FileOutputStream::Open(_file_path).ValueOrDie();
+        EXPECT_TRUE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), output,
+                                               GROUP_ROWS, builder.build())
+                            .ok());
+        EXPECT_TRUE(output->Close().ok());
+    }
+
+    const TSlotDescriptor& _slot(int i) const { return _t_desc_tbl.slotDescriptors[i]; }
+
+    static TExprNode _bool_expr_node(TExprNodeType::type node_type, int num_children) {
+        TExprNode node;
+        node.__set_node_type(node_type);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        node.__set_num_children(num_children);
+        node.__set_is_nullable(true);
+        return node;
+    }
+
+    static TExprNode _string_literal_node(const std::string& value) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::STRING_LITERAL);
+        node.__set_type(TypeDescriptor(TYPE_STRING).to_thrift());
+        node.__set_num_children(0);
+        node.__set_is_nullable(false);
+        TStringLiteral literal;
+        literal.__set_value(value);
+        node.__set_string_literal(literal);
+        return node;
+    }
+
+    // `slot` `fn_name` `literal`, e.g. eq for s = 'b'
+    static TExpr _binary_pred(const TSlotDescriptor& slot, TExprOpcode::type opcode,
+                              const std::string& fn_name, const TExprNode& literal) {
+        TFunction fn;
+        fn.name.__set_function_name(fn_name);
+        fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        fn.__set_arg_types({slot.slotType, literal.type});
+        fn.__set_ret_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        fn.__set_has_var_args(false);
+        TExprNode node = _bool_expr_node(TExprNodeType::BINARY_PRED, 2);
+        node.__set_opcode(opcode);
+        node.__set_fn(fn);
+        TExpr expr;
+        expr.nodes = {node, create_slot_ref_node(slot), literal};
+        return expr;
+    }
+
+    TExpr _in_pred(bool is_not_in, const std::vector<std::string>& values) const {
+        TExprNode node = _bool_expr_node(TExprNodeType::IN_PRED, values.size() + 1);
+        node.__set_opcode(is_not_in ? TExprOpcode::FILTER_NOT_IN : TExprOpcode::FILTER_IN);
+        TInPredicate in_predicate;
+        in_predicate.__set_is_not_in(is_not_in);
+        node.__set_in_predicate(in_predicate);
+        TExpr expr;
+        expr.nodes = {node, create_slot_ref_node(_slot(1))};
+        for (const auto& value : values) {
+            expr.nodes.push_back(_string_literal_node(value));
+        }
+        return expr;
+    }
+
+    VExprContext* _prepare(const TExpr& texpr) {
+        VExprContext* ctx = nullptr;
+        EXPECT_TRUE(VExpr::create_expr_tree(&_pool, texpr, &ctx).ok());
+        EXPECT_TRUE(ctx->prepare(_state.get(), *_row_desc).ok());
+        EXPECT_TRUE(ctx->open(_state.get()).ok());
+        _ctxs.push_back(ctx);
+        return ctx;
+    }
+
+    // Reads the file with `s_pred` pushed down like VFileScanner does, returns the read rows
+    // by id and the row groups which are filtered by the dictionary codes of s. With
+    // `lazy_read`, id is only read for the rows selected by `s_pred`, otherwise id >= 0 is
+    // another predicate so that both columns are read first.
+    std::map<int32_t, std::optional<std::string>> _read(const TExpr& s_pred, bool lazy_read,
+                                                        std::set<int32_t>* dict_filter_groups) {
+        std::unordered_map<int, std::vector<VExprContext*>> slot_id_to_filter_conjuncts;
+        slot_id_to_filter_conjuncts[_slot(1).id].push_back(_prepare(s_pred));
+        VExprContext* vconjunct_ctx = nullptr;
+        if (lazy_read) {
+            vconjunct_ctx = _prepare(s_pred);
+        } else {
+            TExprNode int_literal;
+            int_literal.__set_node_type(TExprNodeType::INT_LITERAL);
+            int_literal.__set_type(TypeDescriptor(TYPE_INT).to_thrift());
+            int_literal.__set_num_children(0);
+            int_literal.__set_is_nullable(false);
+            TIntLiteral literal;
+            literal.__set_value(0);
+            int_literal.__set_int_literal(literal);
+            TExpr id_pred = _binary_pred(_slot(0), TExprOpcode::GE, "ge", int_literal);
+            slot_id_to_filter_conjuncts[_slot(0).id].push_back(_prepare(id_pred));
+
+            TExprNode and_node = _bool_expr_node(TExprNodeType::COMPOUND_PRED, 2);
+            and_node.__set_opcode(TExprOpcode::COMPOUND_AND);
+            TExpr and_pred;
+            and_pred.nodes.push_back(and_node);
+            and_pred.nodes.insert(and_pred.nodes.end(), s_pred.nodes.begin(), s_pred.nodes.end());
+            and_pred.nodes.insert(and_pred.nodes.end(), id_pred.nodes.begin(),
+                                  id_pred.nodes.end());
+            vconjunct_ctx = _prepare(and_pred);
+        }
+        std::unordered_map<std::string, int> colname_to_slot_id = {{"id", _slot(0).id},
+                                                                   {"s", _slot(1).id}};
+        std::vector<VExprContext*> not_single_slot_filter_conjuncts;
+
+        io::FileReaderSPtr file_reader;
+        EXPECT_TRUE(io::global_local_filesystem()->open_file(_file_path, &file_reader).ok());
+        TFileScanRangeParams scan_params;
+        TFileRangeDesc scan_range;
+        scan_range.__set_path(_file_path);
+        scan_range.start_offset = 0;
+        scan_range.size = file_reader->size();
+        ParquetReader reader(nullptr, scan_params, scan_range, 992, &_ctz, nullptr, _state.get());
+        reader.set_file_reader(file_reader);
+        EXPECT_TRUE(reader.open().ok());
+        std::vector<std::string> column_names = {"id", "s"};
+        std::vector<std::string> missing_column_names;
+        auto* tuple_desc = _desc_tbl->get_tuple_descriptor(0);
+        Status st = reader.init_reader(column_names, missing_column_names, nullptr, vconjunct_ctx,
+                                       tuple_desc, _row_desc.get(), &colname_to_slot_id,
+                                       &not_single_slot_filter_conjuncts,
+                                       &slot_id_to_filter_conjuncts);
+        EXPECT_TRUE(st.ok()) << st;
+        _check_encodings(*reader._t_metadata);
+        EXPECT_TRUE(reader.set_fill_columns({}, {}).ok());
+
+        std::map<int32_t, std::optional<std::string>> rows;
+        bool eof = false;
+        while (!eof) {
+            Block block;
+            for (auto* slot_desc : tuple_desc->slots()) {
+                block.insert({slot_desc->get_empty_mutable_column(),
+                              slot_desc->get_data_type_ptr(), slot_desc->col_name()});
+            }
+            size_t read_rows = 0;
+            st = reader.get_next_block(&block, &read_rows, &eof);
+            EXPECT_TRUE(st.ok()) << st;
+            if (!st.ok()) {
+                break;
+            }
+            auto& group_reader = reader._current_group_reader;
+            if (group_reader != nullptr && !group_reader->_dict_filter_cols.empty()) {
+                dict_filter_groups->insert(group_reader->_row_group_id);
+            }
+            _collect(block, &rows);
+        }
+        return rows;
+    }
+
+    // The encodings this test is about, as decided by the writer.
+    static void _check_encodings(const tparquet::FileMetaData& t_metadata) {
+        ASSERT_EQ(NUM_GROUPS, t_metadata.row_groups.size());
+        for (int group = 0; group < NUM_GROUPS; ++group) {
+            const auto& meta_data = t_metadata.row_groups[group].columns[1].meta_data;
+            ASSERT_TRUE(meta_data.__isset.dictionary_page_offset);
+            ASSERT_TRUE(meta_data.__isset.encoding_stats);
+            bool has_dict_page = false;
+            bool has_plain_page = false;
+            for (const auto& encoding_stat : meta_data.encoding_stats) {
+                if (encoding_stat.page_type != tparquet::PageType::DATA_PAGE &&
+                    encoding_stat.page_type != tparquet::PageType::DATA_PAGE_V2) {
+                    continue;
+                }
+                if (encoding_stat.encoding == tparquet::Encoding::PLAIN) {
+                    has_plain_page = true;
+                } else {
+                    has_dict_page = true;
+                }
+            }
+            EXPECT_TRUE(has_dict_page);
+            EXPECT_EQ(group == 1, has_plain_page);
+        }
+    }
+
+    static void _collect(const Block& block, std::map<int32_t, std::optional<std::string>>* rows) {
+        const auto& id_column =
+                assert_cast<const ColumnNullable&>(*block.get_by_position(0).column);
+        const auto& s_column =
+                assert_cast<const ColumnNullable&>(*block.get_by_position(1).column);
+        const auto& ids = assert_cast<const ColumnInt32&>(id_column.get_nested_column());
+        // ColumnString, or ColumnDictCodes if s is read as dictionary codes
+        const IColumn& strings = s_column.get_nested_column();
+        for (size_t i = 0; i < block.rows(); ++i) {
+            std::optional<std::string> value;
+            if (!s_column.is_null_at(i)) {
+                value = strings.get_data_at(i).to_string();
+            }
+            EXPECT_EQ(0, rows->count(ids.get_element(i)));
+            rows->emplace(ids.get_element(i), value);
+        }
+    }
+
+    // Reads the file asking for s as dictionary codes like an aggregation grouping by s does,
+    // returns the read rows by id and the row groups whose s is read as ColumnDictCodes. With
+    // `id_pred`, id >= 0 is pushed down so that s is lazily read. The block is reused between
+    // the batches like the scanners do.
+    std::map<int32_t, std::optional<std::string>> _read_dict_codes(
+            bool id_pred, std::set<int32_t>* dict_code_groups) {
+        std::unordered_map<int, std::vector<VExprContext*>> slot_id_to_filter_conjuncts;
+        VExprContext* vconjunct_ctx = nullptr;
+        if (id_pred) {
+            TExprNode int_literal;
+            int_literal.__set_node_type(TExprNodeType::INT_LITERAL);
+            int_literal.__set_type(TypeDescriptor(TYPE_INT).to_thrift());
+            int_literal.__set_num_children(0);
+            int_literal.__set_is_nullable(false);
+            TIntLiteral literal;
+            literal.__set_value(0);
+            int_literal.__set_int_literal(literal);
+            TExpr pred = _binary_pred(_slot(0), TExprOpcode::GE, "ge", int_literal);
+            slot_id_to_filter_conjuncts[_slot(0).id].push_back(_prepare(pred));
+            vconjunct_ctx = _prepare(pred);
+        }
+        std::unordered_map<std::string, int> colname_to_slot_id = {{"id", _slot(0).id},
+                                                                   {"s", _slot(1).id}};
+        std::vector<VExprContext*> not_single_slot_filter_conjuncts;
+
+        io::FileReaderSPtr file_reader;
+        EXPECT_TRUE(io::global_local_filesystem()->open_file(_file_path, &file_reader).ok());
+        TFileScanRangeParams scan_params;
+        TFileRangeDesc scan_range;
+        scan_range.__set_path(_file_path);
+        scan_range.start_offset = 0;
+        scan_range.size = file_reader->size();
+        ParquetReader reader(nullptr, scan_params, scan_range, 992, &_ctz, nullptr, _state.get());
+        reader.set_file_reader(file_reader);
+        EXPECT_TRUE(reader.open().ok());
+        std::vector<std::string> column_names = {"id", "s"};
+        std::vector<std::string> missing_column_names;
+        auto* tuple_desc = _desc_tbl->get_tuple_descriptor(0);
+        Status st = reader.init_reader(column_names, missing_column_names, nullptr, vconjunct_ctx,
+                                       tuple_desc, _row_desc.get(), &colname_to_slot_id,
+                                       &not_single_slot_filter_conjuncts,
+                                       &slot_id_to_filter_conjuncts);
+        EXPECT_TRUE(st.ok()) << st;
+        EXPECT_TRUE(reader.set_fill_columns({}, {}).ok());
+        reader.set_dict_code_slot_ids({_slot(1).id});
+
+        std::map<int32_t, std::optional<std::string>> rows;
+        Block block;
+        for (auto* slot_desc : tuple_desc->slots()) {
+            block.insert({slot_desc->get_empty_mutable_column(), slot_desc->get_data_type_ptr(),
+                          slot_desc->col_name()});
+        }
+        bool eof = false;
+        while (!eof) {
+            block.clear_column_data();
+            size_t read_rows = 0;
+            st = reader.get_next_block(&block, &read_rows, &eof);
+            EXPECT_TRUE(st.ok()) << st;
+            if (!st.ok()) {
+                break;
+            }
+            const auto& s_column = block.get_by_position(1);
+            EXPECT_TRUE(s_column.type->equals(*tuple_desc->slots()[1]->get_data_type_ptr()));
+            auto& group_reader = reader._current_group_reader;
+            if (group_reader != nullptr && block.rows() > 0 &&
+                ColumnDictCodes::get_dict_codes(*s_column.column) != nullptr) {
+                dict_code_groups->insert(group_reader->_row_group_id);
+            }
+            _collect(block, &rows);
+        }
+        return rows;
+    }
+
+    static std::map<int32_t, std::optional<std::string>> _expected(const Predicate& predicate) {
+        std::map<int32_t, std::optional<std::string>> rows;
+        for (int row = 0; row < NUM_GROUPS * GROUP_ROWS; ++row) {
+            if (predicate(_value(row))) {
+                rows.emplace(row, _value(row));
+            }
+        }
+        return rows;
+    }
+
+    void _check(const TExpr& s_pred, const Predicate& predicate,
+                const std::set<int32_t>& expected_dict_filter_groups) {
+        auto expected = _expected(predicate);
+        for (bool lazy_read : {true, false}) {
+            std::set<int32_t> dict_filter_groups;
+            EXPECT_EQ(expected, _read(s_pred, lazy_read, &dict_filter_groups))
+                    << "lazy read: " << lazy_read;
+            EXPECT_EQ(expected_dict_filter_groups, dict_filter_groups);
+        }
+    }
+
+    static constexpr int NUM_GROUPS = 2;
+    static constexpr int GROUP_ROWS = 2000;
+    const std::string kTestDir = "./ut_dir/parquet_dict_filter_test";
+    const std::string _file_path = kTestDir + "/dict_filter.parquet";
+    cctz::time_zone _ctz;
+    ObjectPool _pool;
+    TDescriptorTable _t_desc_tbl;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::unique_ptr<RuntimeState> _state;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::vector<VExprContext*> _ctxs;
+};
+
+TEST_F(ParquetDictFilterTest, eq) {
+    _check(_binary_pred(_slot(1), TExprOpcode::EQ, "eq", _string_literal_node("b")),
+           [](const auto& value) { return value == "b"; }, {0});
+}
+
+TEST_F(ParquetDictFilterTest, in) {
+    // distinct_3002 is only in the plain encoded pages of row group 1
+    _check(_in_pred(false, {"a", "c", "distinct_3002"}),
+           [](const auto& value) {
+               return value == "a" || value == "c" || value == "distinct_3002";
+           },
+           {0});
+}
+
+TEST_F(ParquetDictFilterTest, not_in) {
+    _check(_in_pred(true, {"a", "b"}),
+           [](const auto& value) { return value.has_value() && value != "a" && value != "b"; },
+           {0});
+    // every value of the dictionary of row group 0 is selected, only the nulls are filtered
+    _check(_in_pred(true, {"zzz"}), [](const auto& value) { return value.has_value(); }, {0});
+}
+
+TEST_F(ParquetDictFilterTest, no_dict_value_selected) {
+    // row group 0 is skipped as a whole once its dictionary is checked
+    _check(_binary_pred(_slot(1), TExprOpcode::EQ, "eq", _string_literal_node("distinct_3001")),
+           [](const auto& value) { return value == "distinct_3001"; }, {0});
+}
+
+TEST_F(ParquetDictFilterTest, dict_codes) {
+    auto expected = _expected([](const auto&) { return true; });
+    for (bool id_pred : {false, true}) {
+        // s falls back to plain encoding in row group 1, so it is read as strings there
+        std::set<int32_t> dict_code_groups;
+        EXPECT_EQ(expected, _read_dict_codes(id_pred, &dict_code_groups)) << "id pred: " << id_pred;
+        EXPECT_EQ(std::set<int32_t>({0}), dict_code_groups) << "id pred: " << id_pred;
+    }
+}
+
+} // namespace doris::vectorized
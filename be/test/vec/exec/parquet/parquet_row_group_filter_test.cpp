@@ -0,0 +1,266 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <gen_cpp/parquet_types.h>
+#include <gtest/gtest.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "exec/olap_common.h"
+#include "io/fs/local_file_system.h"
+#include "util/coding.h"
+#include "util/thrift_util.h"
+#include "util/timezone_utils.h"
+#include "vec/exec/format/parquet/vparquet_bloom_filter.h"
+#include "vec/exec/format/parquet/vparquet_reader.h"
+
+namespace doris::vectorized {
+
+// The row groups of a file whose min/max statistics can not filter anything, but whose
+// dictionaries (k, s) and bloom filters (b) can.
+class ParquetRowGroupFilterTest : public testing::Test {
+public:
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+        TimezoneUtils::find_cctz_time_zone(TimezoneUtils::default_time_zone, _ctz);
+        _write_file();
+        _append_bloom_filters();
+    }
+
+    void TearDown() override {
+        config::enable_parquet_dict_filter = true;
+        config::enable_parquet_bloom_filter = true;
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+    }
+
+protected:
+    // Every row group has 0 and 1000, so the min/max statistics are the same for all of them,
+    // the other values of row group g are the even numbers in [g * 100, g * 100 + 96].
+    static int64_t _value(int group, int row) {
+        if (row < 2) {
+            return row * 1000;
+        }
+        return group * 100 + 2 * ((row - 2) % 49);
+    }
+
+    static std::string _string_value(int group, int row) {
+        if (row < 2) {
+            return row == 0 ? "a" : "z";
+        }
+        return "m" + std::to_string(_value(group, row));
+    }
+
+    void _write_file() {
+        arrow::Int32Builder k_builder;
+        arrow::StringBuilder s_builder;
+        arrow::Int64Builder b_builder;
+        for (int group = 0; group < NUM_GROUPS; ++group) {
+            for (int row = 0; row < GROUP_ROWS; ++row) {
+                EXPECT_TRUE(k_builder.Append(static_cast<int32_t>(_value(group, row))).ok());
+                EXPECT_TRUE(s_builder.Append(_string_value(group, row)).ok());
+                EXPECT_TRUE(b_builder.Append(_value(group, row)).ok());
+            }
+        }
+        std::shared_ptr<arrow::Array> k_array;
+        std::shared_ptr<arrow::Array> s_array;
+        std::shared_ptr<arrow::Array> b_array;
+        EXPECT_TRUE(k_builder.Finish(&k_array).ok());
+        EXPECT_TRUE(s_builder.Finish(&s_array).ok());
+        EXPECT_TRUE(b_builder.Finish(&b_array).ok());
+        auto schema = arrow::schema({arrow::field("k", arrow::int32()),
+                                     arrow::field("s", arrow::utf8()),
+                                     arrow::field("b", arrow::int64())});
+        auto table = arrow::Table::Make(schema, {k_array, s_array, b_array});
+
+        parquet::WriterProperties::Builder builder;
+        builder.enable_dictionary()->disable_dictionary("b");
+        auto output = arrow::io::FileOutputStream::Open(_file_path).ValueOrDie();
+        EXPECT_TRUE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), output,
+                                               GROUP_ROWS, builder.build())
+                            .ok());
+        EXPECT_TRUE(output->Close().ok());
+    }
+
+    // The writer of arrow has no bloom filter, so they are appended after the column chunks
+    // and the footer is written again with their offsets.
+    void _append_bloom_filters() {
+        std::ifstream input(_file_path, std::ios::binary);
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(input)),
+                                   std::istreambuf_iterator<char>());
+        input.close();
+        ASSERT_GT(bytes.size(), 12);
+        uint32_t footer_size = decode_fixed32_le(bytes.data() + bytes.size() - 8);
+        size_t footer_offset = bytes.size() - 8 - footer_size;
+        tparquet::FileMetaData t_metadata;
+        ASSERT_TRUE(deserialize_thrift_msg(bytes.data() + footer_offset, &footer_size, true,
+                                           &t_metadata)
+                            .ok());
+        bytes.resize(footer_offset);
+
+        ThriftSerializer serializer(true, 1024);
+        ASSERT_EQ(NUM_GROUPS, t_metadata.row_groups.size());
+        for (int group = 0; group < NUM_GROUPS; ++group) {
+            ParquetBloomFilter bloom_filter;
+            ASSERT_TRUE(bloom_filter.init(BLOOM_FILTER_BYTES).ok());
+            for (int row = 0; row < GROUP_ROWS; ++row) {
+                int64_t value = _value(group, row);
+                bloom_filter.insert_hash(ParquetBloomFilter::hash(&value, sizeof(value)));
+            }
+            tparquet::BloomFilterHeader header;
+            header.numBytes = BLOOM_FILTER_BYTES;
+            header.algorithm.__set_BLOCK(tparquet::SplitBlockAlgorithm());
+            header.hash.__set_XXHASH(tparquet::XxHash());
+            header.compression.__set_UNCOMPRESSED(tparquet::Uncompressed());
+            std::vector<uint8_t> header_bytes;
+            ASSERT_TRUE(serializer.serialize(&header, &header_bytes).ok());
+
+            auto& b_chunk = t_metadata.row_groups[group].columns[2];
+            b_chunk.meta_data.__set_bloom_filter_offset(bytes.size());
+            bytes.insert(bytes.end(), header_bytes.begin(), header_bytes.end());
+            auto* bitset = reinterpret_cast<const uint8_t*>(bloom_filter._bitset.get());
+            bytes.insert(bytes.end(), bitset, bitset + BLOOM_FILTER_BYTES);
+        }
+
+        std::vector<uint8_t> footer;
+        ASSERT_TRUE(serializer.serialize(&t_metadata, &footer).ok());
+        bytes.insert(bytes.end(), footer.begin(), footer.end());
+        uint8_t footer_size_buf[4];
+        encode_fixed32_le(footer_size_buf, footer.size());
+        bytes.insert(bytes.end(), footer_size_buf, footer_size_buf + 4);
+        bytes.insert(bytes.end(), {'P', 'A', 'R', '1'});
+        std::ofstream output(_file_path, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+
+    // Returns the ids of the row groups to read.
+    std::vector<int32_t> _filter_row_groups(
+            std::unordered_map<std::string, ColumnValueRangeType>* colname_to_value_range,
+            ParquetReader::Statistics* statistics) {
+        io::FileReaderSPtr file_reader;
+        EXPECT_TRUE(io::global_local_filesystem()->open_file(_file_path, &file_reader).ok());
+        TFileScanRangeParams scan_params;
+        TFileRangeDesc scan_range;
+        scan_range.__set_path(_file_path);
+        scan_range.start_offset = 0;
+        scan_range.size = file_reader->size();
+        ParquetReader reader(nullptr, scan_params, scan_range, 992, &_ctz, nullptr, nullptr);
+        reader.set_file_reader(file_reader);
+        EXPECT_TRUE(reader.open().ok());
+        std::vector<std::string> missing_column_names;
+        Status st = reader.init_reader(_column_names, missing_column_names,
+                                       colname_to_value_range, nullptr, nullptr, nullptr,
+                                       nullptr, nullptr, nullptr);
+        EXPECT_TRUE(st.ok() || st.is<ErrorCode::END_OF_FILE>()) << st;
+        std::vector<int32_t> row_groups;
+        for (auto& row_group : reader._read_row_groups) {
+            row_groups.push_back(row_group.row_group_id);
+        }
+        *statistics = reader._statistics;
+        return row_groups;
+    }
+
+    static constexpr int NUM_GROUPS = 4;
+    static constexpr int GROUP_ROWS = 100;
+    static constexpr int BLOOM_FILTER_BYTES = 1024;
+    const std::string kTestDir = "./ut_dir/parquet_row_group_filter_test";
+    const std::string _file_path = kTestDir + "/filter.parquet";
+    const std::vector<std::string> _column_names = {"k", "s", "b"};
+    cctz::time_zone _ctz;
+};
+
+TEST_F(ParquetRowGroupFilterTest, dict_filter) {
+    // 101 is in no dictionary, 204 is only in the dictionary of row group 2
+    std::unordered_map<std::string, ColumnValueRangeType> ranges;
+    ColumnValueRange<TYPE_INT> k_range("k");
+    ASSERT_TRUE(k_range.add_fixed_value(101).ok());
+    ASSERT_TRUE(k_range.add_fixed_value(204).ok());
+    ranges.emplace("k", k_range);
+    ParquetReader::Statistics statistics;
+    EXPECT_EQ(std::vector<int32_t>({2}), _filter_row_groups(&ranges, &statistics));
+    EXPECT_EQ(3, statistics.filtered_row_groups);
+    EXPECT_EQ(3, statistics.dict_filtered_row_groups);
+    EXPECT_EQ(0, statistics.bloom_filtered_row_groups);
+
+    // 150 < k < 160 is only satisfied by the dictionary of row group 1
+    ranges.clear();
+    ColumnValueRange<TYPE_INT> k_between("k");
+    ASSERT_TRUE(k_between.add_range(FILTER_LARGER, 150).ok());
+    ASSERT_TRUE(k_between.add_range(FILTER_LESS, 160).ok());
+    ranges.emplace("k", k_between);
+    EXPECT_EQ(std::vector<int32_t>({1}), _filter_row_groups(&ranges, &statistics));
+    EXPECT_EQ(3, statistics.dict_filtered_row_groups);
+
+    std::string odd = "m101";
+    std::string even = "m304";
+    ranges.clear();
+    ColumnValueRange<TYPE_STRING> s_range("s");
+    ASSERT_TRUE(s_range.add_fixed_value(StringRef(odd)).ok());
+    ASSERT_TRUE(s_range.add_fixed_value(StringRef(even)).ok());
+    ranges.emplace("s", s_range);
+    EXPECT_EQ(std::vector<int32_t>({3}), _filter_row_groups(&ranges, &statistics));
+    EXPECT_EQ(3, statistics.dict_filtered_row_groups);
+
+    // no value of the dictionaries satisfies the predicates
+    ranges.clear();
+    ColumnValueRange<TYPE_INT> k_missing("k");
+    ASSERT_TRUE(k_missing.add_fixed_value(101).ok());
+    ranges.emplace("k", k_missing);
+    EXPECT_TRUE(_filter_row_groups(&ranges, &statistics).empty());
+    EXPECT_EQ(4, statistics.dict_filtered_row_groups);
+
+    config::enable_parquet_dict_filter = false;
+    EXPECT_EQ(std::vector<int32_t>({0, 1, 2, 3}), _filter_row_groups(&ranges, &statistics));
+    EXPECT_EQ(0, statistics.filtered_row_groups);
+}
+
+TEST_F(ParquetRowGroupFilterTest, bloom_filter) {
+    // b has no dictionary, 101 is in no bloom filter and 204 is only in the one of row group 2
+    std::unordered_map<std::string, ColumnValueRangeType> ranges;
+    ColumnValueRange<TYPE_BIGINT> b_range("b");
+    ASSERT_TRUE(b_range.add_fixed_value(101).ok());
+    ASSERT_TRUE(b_range.add_fixed_value(204).ok());
+    ranges.emplace("b", b_range);
+    ParquetReader::Statistics statistics;
+    EXPECT_EQ(std::vector<int32_t>({2}), _filter_row_groups(&ranges, &statistics));
+    EXPECT_EQ(3, statistics.filtered_row_groups);
+    EXPECT_EQ(0, statistics.dict_filtered_row_groups);
+    EXPECT_EQ(3, statistics.bloom_filtered_row_groups);
+
+    // a range can not be checked by the bloom filters
+    ranges.clear();
+    ColumnValueRange<TYPE_BIGINT> b_between("b");
+    ASSERT_TRUE(b_between.add_range(FILTER_LARGER, 150).ok());
+    ASSERT_TRUE(b_between.add_range(FILTER_LESS, 160).ok());
+    ranges.emplace("b", b_between);
+    EXPECT_EQ(std::vector<int32_t>({0, 1, 2, 3}), _filter_row_groups(&ranges, &statistics));
+
+    ranges.clear();
+    ranges.emplace("b", b_range);
+    config::enable_parquet_bloom_filter = false;
+    EXPECT_EQ(std::vector<int32_t>({0, 1, 2, 3}), _filter_row_groups(&ranges, &statistics));
+    EXPECT_EQ(0, statistics.bloom_filtered_row_groups);
+}
+
+} // namespace doris::vectorized
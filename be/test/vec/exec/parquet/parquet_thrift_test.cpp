@@ -35,6 +35,7 @@
 #include "vec/data_types/data_type_factory.hpp"
 #include "vec/exec/format/parquet/parquet_thrift_util.h"
 #include "vec/exec/format/parquet/vparquet_column_chunk_reader.h"
+#include "vec/exec/format/parquet/vparquet_bloom_filter.h"
 #include "vec/exec/format/parquet/vparquet_column_reader.h"
 #include "vec/exec/format/parquet/vparquet_file_metadata.h"
 #include "vec/exec/format/parquet/vparquet_group_reader.h"
@@ -525,6 +526,63 @@ TEST_F(ParquetThriftReaderTest, group_reader) {
     ASSERT_STREQ(block.dump_data(0, 10).c_str(), reinterpret_cast<char*>(result_buf));
     delete meta_data;
 }
+
+TEST_F(ParquetThriftReaderTest, bloom_filter) {
+    ParquetBloomFilter bloom_filter;
+    ASSERT_FALSE(bloom_filter.init(100).ok());
+    ASSERT_TRUE(bloom_filter.init(ParquetBloomFilter::BYTES_PER_BLOCK * 64).ok());
+    for (int64_t i = 0; i < 200; ++i) {
+        bloom_filter.insert_hash(ParquetBloomFilter::hash(&i, sizeof(i)));
+    }
+    for (int64_t i = 0; i < 200; ++i) {
+        ASSERT_TRUE(bloom_filter.find(&i, sizeof(i)));
+    }
+    int false_positives = 0;
+    for (int64_t i = 200; i < 10200; ++i) {
+        false_positives += bloom_filter.find(&i, sizeof(i));
+    }
+    ASSERT_LT(false_positives, 100);
+}
+
+// The hashes are computed by the reference XXH64 with seed 0 and the bitset by the block insert
+// of the split block bloom filter in the parquet format spec, so that the filters written by
+// other writers are probed with the same bits.
+TEST_F(ParquetThriftReaderTest, bloom_filter_known_answer) {
+    EXPECT_EQ(0xef46db3751d8e999ULL, ParquetBloomFilter::hash("", 0));
+    EXPECT_EQ(0xd24ec4f1a98c6e5bULL, ParquetBloomFilter::hash("a", 1));
+    EXPECT_EQ(0x9681a1ec834e6a56ULL, ParquetBloomFilter::hash("doris", 5));
+    std::string sentence = "the quick brown fox jumps over the lazy dog";
+    EXPECT_EQ(0xed714233c5a9a792ULL, ParquetBloomFilter::hash(sentence.data(), sentence.size()));
+    int32_t int_value = 42;
+    int64_t bigint_value = 42;
+    EXPECT_EQ(0xd756d7b62fc50bf1ULL, ParquetBloomFilter::hash(&int_value, sizeof(int_value)));
+    EXPECT_EQ(0xb556806fb6d14353ULL,
+              ParquetBloomFilter::hash(&bigint_value, sizeof(bigint_value)));
+
+    ParquetBloomFilter bloom_filter;
+    ASSERT_TRUE(bloom_filter.init(ParquetBloomFilter::BYTES_PER_BLOCK * 4).ok());
+    bloom_filter.insert_hash(ParquetBloomFilter::hash(&int_value, sizeof(int_value)));
+    bloom_filter.insert_hash(ParquetBloomFilter::hash(&bigint_value, sizeof(bigint_value)));
+    bloom_filter.insert_hash(ParquetBloomFilter::hash("doris", 5));
+    const uint32_t expected[32] = {
+            0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+            0x00000000, 0x00000000, 0x00000900, 0x00010080, 0x40000200, 0x00004040, 0x00000480,
+            0x20008000, 0x08010000, 0x00000810, 0x10000000, 0x00001000, 0x08000000, 0x00000010,
+            0x00000020, 0x00001000, 0x20000000, 0x40000000};
+    for (int i = 0; i < 32; ++i) {
+        EXPECT_EQ(expected[i], bloom_filter._bitset[i]) << "word " << i;
+    }
+
+    // a filter read from the bytes of a file finds the same values
+    ParquetBloomFilter read_filter;
+    auto* bitset = reinterpret_cast<const uint8_t*>(expected);
+    ASSERT_TRUE(read_filter.init(bitset, sizeof(expected)).ok());
+    EXPECT_TRUE(read_filter.find(&int_value, sizeof(int_value)));
+    EXPECT_TRUE(read_filter.find(&bigint_value, sizeof(bigint_value)));
+    EXPECT_TRUE(read_filter.find("doris", 5));
+    EXPECT_FALSE(read_filter.find("a", 1));
+}
 } // namespace vectorized
 
 } // namespace doris
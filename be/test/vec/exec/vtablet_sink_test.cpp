@@ -18,7 +18,10 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
 #include <map>
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -818,5 +821,238 @@ TEST_F(VOlapTableSinkTest, decimal) {
     ASSERT_TRUE(output_set.count("(12, 12.300000000)") > 0);
     ASSERT_TRUE(output_set.count("(13, 123.120000000)") > 0);
 }
+
+// Range partitions on c2 of the sink of get_data_sink(): partition i is [i * 10, i * 10 + width),
+// except that the first one has no start key and the last one has no end key (MAXVALUE) if
+// `with_maxvalue`. A width below 10 leaves gaps between the partitions.
+static void set_range_partitions(TOlapTableSink* tsink, int num_partitions, int width,
+                                 bool with_maxvalue) {
+    auto key = [](int64_t value) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::INT_LITERAL);
+        node.__set_type(TypeDescriptor(TYPE_BIGINT).to_thrift());
+        node.__set_num_children(0);
+        TIntLiteral literal;
+        literal.__set_value(value);
+        node.__set_int_literal(literal);
+        return std::vector<TExprNode> {node};
+    };
+    auto& tpartition = tsink->partition;
+    tpartition.__set_partition_column("c2");
+    tpartition.partitions.resize(num_partitions);
+    tsink->location.tablets.clear();
+    for (int i = 0; i < num_partitions; ++i) {
+        auto& partition = tpartition.partitions[i];
+        partition = TOlapTablePartition();
+        partition.id = 100 + i;
+        partition.num_buckets = 3;
+        partition.indexes.resize(1);
+        partition.indexes[0].index_id = 4;
+        for (int bucket = 0; bucket < partition.num_buckets; ++bucket) {
+            int64_t tablet_id = 1000 + i * 10 + bucket;
+            partition.indexes[0].tablets.push_back(tablet_id);
+            TTabletLocation location;
+            location.tablet_id = tablet_id;
+            // two replicas on different nodes
+            location.node_ids = {(i + bucket) % 3, (i + bucket + 1) % 3};
+            tsink->location.tablets.push_back(location);
+        }
+        if (i > 0) {
+            partition.__set_start_keys(key(i * 10));
+        }
+        if (i < num_partitions - 1 || !with_maxvalue) {
+            partition.__set_end_keys(key(i * 10 + width));
+        }
+    }
+}
+
+// The partition of c2 = `key` in set_range_partitions(), -1 if it is in none. Null is less than
+// any key, so it is in the first partition which has no start key.
+static int expected_partition(std::optional<int64_t> key, int num_partitions, int width,
+                              bool with_maxvalue) {
+    if (!key.has_value()) {
+        return 0;
+    }
+    for (int i = 0; i < num_partitions; ++i) {
+        bool above_start = i == 0 || *key >= i * 10;
+        bool below_end = (i == num_partitions - 1 && with_maxvalue) || *key < i * 10 + width;
+        if (above_start && below_end) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Rows of (c1, c2, c3) with c2 around all the partition bounds, and some nulls.
+static vectorized::Block partition_test_block(const TupleDescriptor* tuple_desc,
+                                              int num_partitions, int width,
+                                              std::vector<std::optional<int64_t>>* keys) {
+    keys->clear();
+    for (int i = 0; i <= num_partitions; ++i) {
+        for (int64_t key : {i * 10 - 1, i * 10, i * 10 + width - 1, i * 10 + width, i * 10 + 7}) {
+            keys->push_back(key);
+        }
+        if (i % 4 == 0) {
+            keys->push_back(std::nullopt);
+        }
+    }
+    keys->push_back(std::numeric_limits<int64_t>::min());
+    keys->push_back(std::numeric_limits<int64_t>::max());
+    keys->push_back(-1000);
+
+    std::vector<vectorized::MutableColumnPtr> columns;
+    for (const auto* slot : tuple_desc->slots()) {
+        columns.push_back(slot->get_empty_mutable_column());
+    }
+    for (size_t row = 0; row < keys->size(); ++row) {
+        if (row % 5 == 0) {
+            columns[0]->insert_data(nullptr, 0);
+        } else {
+            int32_t c1 = row * 7;
+            columns[0]->insert_data(reinterpret_cast<const char*>(&c1), 0);
+        }
+        const auto& key = (*keys)[row];
+        if (key.has_value()) {
+            columns[1]->insert_data(reinterpret_cast<const char*>(&*key), 0);
+        } else {
+            columns[1]->insert_data(nullptr, 0);
+        }
+        auto c3 = fmt::format("s{}", row % 11);
+        columns[2]->insert_data(c3.data(), c3.size());
+    }
+    vectorized::Block block;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const auto* slot = tuple_desc->slots()[i];
+        block.insert(vectorized::ColumnWithTypeAndName(
+                std::move(columns[i]), slot->get_data_type_ptr(), slot->col_name()));
+    }
+    return block;
+}
+
+TEST_F(VOlapTableSinkTest, find_partitions_and_tablets) {
+    ObjectPool obj_pool;
+    TDescriptorTable tdesc_tbl;
+    auto t_data_sink = get_data_sink(&tdesc_tbl);
+    auto& tsink = t_data_sink.olap_table_sink;
+
+    // up to 32 partitions are searched linearly, more with a binary search
+    for (int num_partitions : {1, 5, 32, 33, 70}) {
+        for (int width : {5, 10}) {
+            for (bool with_maxvalue : {false, true}) {
+                SCOPED_TRACE(fmt::format("partitions: {}, width: {}, maxvalue: {}",
+                                         num_partitions, width, with_maxvalue));
+                set_range_partitions(&tsink, num_partitions, width, with_maxvalue);
+                auto schema = std::make_shared<OlapTableSchemaParam>();
+                ASSERT_TRUE(schema->init(tsink.schema).ok());
+                VOlapTablePartitionParam part_param(schema, tsink.partition);
+                ASSERT_TRUE(part_param.init().ok());
+                EXPECT_EQ(TYPE_BIGINT, part_param._range_key_type);
+
+                std::vector<std::optional<int64_t>> keys;
+                auto block =
+                        partition_test_block(schema->tuple_desc(), num_partitions, width, &keys);
+                std::vector<uint8_t> skip(block.rows(), 0);
+                skip[3] = 1;
+                std::vector<const VOlapTablePartition*> partitions;
+                part_param.find_partitions(&block, skip.data(), &partitions);
+                std::vector<uint32_t> tablet_indexes;
+                part_param.find_tablets(&block, partitions, &tablet_indexes);
+
+                ASSERT_EQ(block.rows(), partitions.size());
+                ASSERT_EQ(block.rows(), tablet_indexes.size());
+                for (size_t row = 0; row < block.rows(); ++row) {
+                    SCOPED_TRACE(fmt::format("row {}, key {}", row,
+                                             keys[row] ? std::to_string(*keys[row]) : "null"));
+                    if (skip[row]) {
+                        EXPECT_EQ(nullptr, partitions[row]);
+                        continue;
+                    }
+                    // the same partition as the per row lookup
+                    BlockRow block_row {&block, (int32_t)row};
+                    const VOlapTablePartition* partition = nullptr;
+                    part_param.find_partition(&block_row, &partition);
+                    EXPECT_EQ(partition, partitions[row]);
+
+                    int expected =
+                            expected_partition(keys[row], num_partitions, width, with_maxvalue);
+                    if (expected < 0) {
+                        EXPECT_EQ(nullptr, partitions[row]);
+                        continue;
+                    }
+                    ASSERT_NE(nullptr, partitions[row]);
+                    EXPECT_EQ(100 + expected, partitions[row]->id);
+                    // the same bucket hash as the per row lookup
+                    EXPECT_EQ(part_param.find_tablet(&block_row, *partitions[row]),
+                              tablet_indexes[row]);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(VOlapTableSinkTest, rows_distribution_payload) {
+    TUniqueId fragment_id;
+    TQueryOptions query_options;
+    query_options.batch_size = 1024;
+    RuntimeState state(fragment_id, query_options, TQueryGlobals(), _env);
+    state.init_mem_trackers(TUniqueId());
+
+    ObjectPool obj_pool;
+    TDescriptorTable tdesc_tbl;
+    auto t_data_sink = get_data_sink(&tdesc_tbl);
+    const int num_partitions = 40;
+    const int width = 5;
+    set_range_partitions(&t_data_sink.olap_table_sink, num_partitions, width, true);
+
+    DescriptorTbl* desc_tbl = nullptr;
+    auto st = DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    ASSERT_TRUE(st.ok());
+    state._desc_tbl = desc_tbl;
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    RowDescriptor row_desc(*desc_tbl, {0}, {false});
+
+    VOlapTableSink sink(&obj_pool, row_desc, {}, &st);
+    ASSERT_TRUE(st.ok());
+    st = sink.init(t_data_sink);
+    ASSERT_TRUE(st.ok()) << st;
+    st = sink.prepare(&state);
+    ASSERT_TRUE(st.ok()) << st;
+
+    std::vector<std::optional<int64_t>> keys;
+    auto block = partition_test_block(tuple_desc, num_partitions, width, &keys);
+    sink._vpartition->find_partitions(&block, nullptr, &sink._row_partitions);
+    sink._vpartition->find_tablets(&block, sink._row_partitions, &sink._row_tablet_indexes);
+
+    // the (row, tablet) pairs sent to each node, computed row by row
+    std::map<int64_t, std::multiset<std::pair<uint32_t, int64_t>>> expected;
+    int64_t expected_output_rows = 0;
+    for (size_t row = 0; row < block.rows(); ++row) {
+        BlockRow block_row {&block, (int32_t)row};
+        const VOlapTablePartition* partition = nullptr;
+        if (!sink._vpartition->find_partition(&block_row, &partition)) {
+            continue;
+        }
+        auto tablet_index = sink._vpartition->find_tablet(&block_row, *partition);
+        auto tablet_id = partition->indexes[0].tablets[tablet_index];
+        for (auto node_id : sink._location->find_tablet(tablet_id)->node_ids) {
+            expected[node_id].emplace(row, tablet_id);
+        }
+        expected_output_rows++;
+    }
+    ASSERT_GT(expected_output_rows, 0);
+
+    std::vector<std::unordered_map<VNodeChannel*, Payload>> payload(sink._channels.size());
+    sink._generate_rows_distribution_payload(payload, block.rows());
+    std::map<int64_t, std::multiset<std::pair<uint32_t, int64_t>>> actual;
+    for (const auto& [channel, rows] : payload[0]) {
+        ASSERT_EQ(rows.first->size(), rows.second.size());
+        for (size_t i = 0; i < rows.second.size(); ++i) {
+            actual[channel->node_id()].emplace((*rows.first)[i], rows.second[i]);
+        }
+    }
+    EXPECT_EQ(expected, actual);
+    EXPECT_EQ(expected_output_rows, sink._number_output_rows);
+}
+
 } // namespace stream_load
 } // namespace doris
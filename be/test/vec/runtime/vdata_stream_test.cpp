@@ -25,7 +25,9 @@
 #include "service/brpc.h"
 #include "testutil/desc_tbl_builder.h"
 #include "util/brpc_client_cache.h"
+#include "util/defer_op.h"
 #include "util/proto_util.h"
+#include "vec/common/assert_cast.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 #include "vec/runtime/vdata_stream_recvr.h"
@@ -101,8 +103,46 @@ class VDataStreamTest : public testing::Test {
     virtual void TearDown() override {}
 
 private:
+    // A pipeline receiver of int blocks from `num_senders` senders on this BE.
+    std::shared_ptr<VDataStreamRecvr> _create_local_recvr(PlanNodeId nid, int num_senders,
+                                                          RuntimeProfile* profile) {
+        if (_runtime_state == nullptr) {
+            DescriptorTblBuilder builder(&_object_pool);
+            builder.declare_tuple() << TYPE_INT;
+            _desc_tbl = builder.build();
+            _row_desc = std::make_unique<RowDescriptor>(
+                    const_cast<TupleDescriptor*>(_desc_tbl->get_tuple_descriptor(0)), false);
+            TQueryOptions query_options;
+            query_options.__set_enable_pipeline_engine(true);
+            _runtime_state = std::make_unique<RuntimeState>(TUniqueId(), query_options,
+                                                            TQueryGlobals(), nullptr);
+            _runtime_state->init_mem_trackers();
+            _runtime_state->set_desc_tbl(_desc_tbl);
+        }
+        return _instance.create_recvr(_runtime_state.get(), *_row_desc, TUniqueId(), nid,
+                                      num_senders, profile, false,
+                                      std::make_shared<QueryStatisticsRecvr>());
+    }
+
+    static Block _int_block(const std::vector<int32_t>& values) {
+        auto column = ColumnVector<Int32>::create();
+        column->get_data().assign(values.begin(), values.end());
+        ColumnWithTypeAndName type_and_name(column->get_ptr(), std::make_shared<DataTypeInt32>(),
+                                            "test_int");
+        return Block({type_and_name});
+    }
+
+    static std::vector<int32_t> _int_values(const Block& block) {
+        auto& data = assert_cast<const ColumnVector<Int32>&>(*block.get_by_position(0).column)
+                             .get_data();
+        return std::vector<int32_t>(data.begin(), data.end());
+    }
+
     VDataStreamMgr _instance;
     ObjectPool _object_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::unique_ptr<RuntimeState> _runtime_state;
 };
 
 TEST_F(VDataStreamTest, BasicTest) {
@@ -185,4 +225,88 @@ TEST_F(VDataStreamTest, BasicTest) {
     sender.close(&runtime_stat, exec_status);
     recv->close();
 }
+
+TEST_F(VDataStreamTest, LocalBlocksKeepSenderOrder) {
+    auto capacity = config::exchg_node_local_queue_capacity;
+    config::exchg_node_local_queue_capacity = 2;
+    Defer defer {[&]() { config::exchg_node_local_queue_capacity = capacity; }};
+
+    RuntimeProfile profile("profile");
+    auto recv = _create_local_recvr(1, 1, &profile);
+
+    // the ring holds 0 and 1, the others overflow into the block queue
+    for (int i = 0; i < 4; ++i) {
+        recv->add_block(std::make_shared<SharedBlock>(_int_block({i})), 0);
+    }
+    std::vector<int32_t> values;
+    Block block;
+    bool eos = false;
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_TRUE(recv->get_next(&block, &eos).ok());
+        auto block_values = _int_values(block);
+        values.insert(values.end(), block_values.begin(), block_values.end());
+    }
+    // the ring has free slots again, but 2 and 3 are still queued
+    for (int i = 4; i < 6; ++i) {
+        recv->add_block(std::make_shared<SharedBlock>(_int_block({i})), 0);
+    }
+    recv->remove_sender(0, 0);
+    while (true) {
+        ASSERT_TRUE(recv->get_next(&block, &eos).ok());
+        if (eos) {
+            break;
+        }
+        auto block_values = _int_values(block);
+        values.insert(values.end(), block_values.begin(), block_values.end());
+    }
+    EXPECT_EQ(values, std::vector<int32_t>({0, 1, 2, 3, 4, 5}));
+    recv->close();
+}
+
+TEST_F(VDataStreamTest, SharedLocalBlockCopiedUntilLastHolder) {
+    RuntimeProfile profile_1("profile_1");
+    RuntimeProfile profile_2("profile_2");
+    auto recv_1 = _create_local_recvr(1, 1, &profile_1);
+    auto recv_2 = _create_local_recvr(2, 1, &profile_2);
+
+    auto shared = std::make_shared<SharedBlock>(_int_block({1, 2, 3}), 2);
+    recv_1->add_block(shared, 0);
+    recv_2->add_block(shared, 0);
+
+    Block block;
+    bool eos = false;
+    ASSERT_TRUE(recv_1->get_next(&block, &eos).ok());
+    EXPECT_EQ(_int_values(block), std::vector<int32_t>({1, 2, 3}));
+    EXPECT_EQ(profile_1.get_counter("LocalBlocksCopied")->value(), 1);
+    EXPECT_EQ(shared->block().rows(), 3);
+
+    // recv_1 is done with the block, so recv_2 takes the columns
+    block.clear();
+    ASSERT_TRUE(recv_2->get_next(&block, &eos).ok());
+    EXPECT_EQ(_int_values(block), std::vector<int32_t>({1, 2, 3}));
+    EXPECT_EQ(profile_2.get_counter("LocalBlocksCopied")->value(), 0);
+    EXPECT_EQ(shared->block().rows(), 0);
+
+    recv_1->close();
+    recv_2->close();
+}
+
+TEST_F(VDataStreamTest, SharedLocalBlockReleasedOnClose) {
+    RuntimeProfile profile_1("profile_1");
+    RuntimeProfile profile_2("profile_2");
+    auto recv_1 = _create_local_recvr(1, 1, &profile_1);
+    auto recv_2 = _create_local_recvr(2, 1, &profile_2);
+
+    auto shared = std::make_shared<SharedBlock>(_int_block({1, 2, 3}), 2);
+    recv_1->add_block(shared, 0);
+    recv_2->add_block(shared, 0);
+    recv_1->close();
+
+    Block block;
+    bool eos = false;
+    ASSERT_TRUE(recv_2->get_next(&block, &eos).ok());
+    EXPECT_EQ(_int_values(block), std::vector<int32_t>({1, 2, 3}));
+    EXPECT_EQ(profile_2.get_counter("LocalBlocksCopied")->value(), 0);
+    recv_2->close();
+}
 } // namespace doris::vectorized
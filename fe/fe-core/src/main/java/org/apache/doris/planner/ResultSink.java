@@ -22,6 +22,7 @@ import org.apache.doris.thrift.TDataSink;
 import org.apache.doris.thrift.TDataSinkType;
 import org.apache.doris.thrift.TExplainLevel;
 import org.apache.doris.thrift.TResultSink;
+import org.apache.doris.thrift.TResultSinkType;
 
 /**
  * Result sink that forwards data to
@@ -30,11 +31,20 @@ import org.apache.doris.thrift.TResultSink;
  */
 public class ResultSink extends DataSink {
     private final PlanNodeId exchNodeId;
+    private TResultSinkType resultSinkType = TResultSinkType.MYSQL_PROTOCAL;
 
     public ResultSink(PlanNodeId exchNodeId) {
         this.exchNodeId = exchNodeId;
     }
 
+    public TResultSinkType getResultSinkType() {
+        return resultSinkType;
+    }
+
+    public void setResultSinkType(TResultSinkType resultSinkType) {
+        this.resultSinkType = resultSinkType;
+    }
+
     @Override
     public String getExplainString(String prefix, TExplainLevel explainLevel) {
         StringBuilder strBuilder = new StringBuilder();
@@ -50,6 +60,7 @@ public class ResultSink extends DataSink {
     protected TDataSink toThrift() {
         TDataSink result = new TDataSink(TDataSinkType.RESULT_SINK);
         TResultSink tResultSink = new TResultSink();
+        tResultSink.setType(resultSinkType);
         result.setResultSink(tResultSink);
         return result;
     }
@@ -94,6 +94,7 @@ import org.apache.doris.thrift.TQueryType;
 import org.apache.doris.thrift.TReportExecStatusParams;
 import org.apache.doris.thrift.TResourceInfo;
 import org.apache.doris.thrift.TResourceLimit;
+import org.apache.doris.thrift.TResultSinkType;
 import org.apache.doris.thrift.TRuntimeFilterParams;
 import org.apache.doris.thrift.TRuntimeFilterTargetParams;
 import org.apache.doris.thrift.TScanRangeLocation;
@@ -209,6 +210,10 @@ public class Coordinator {
     private final List<BackendExecState> needCheckBackendExecStates = Lists.newArrayList();
     private final List<PipelineExecContext> needCheckPipelineExecContexts = Lists.newArrayList();
     private ResultReceiver receiver;
+    // If true, the client fetches the query result as Arrow record batches from the result sink.
+    private boolean enableArrowResultFetch = false;
+    private TUniqueId resultInstanceId;
+    private TNetworkAddress resultBrpcAddress;
     private final List<ScanNode> scanNodes;
     // number of instances of this query, equals to
     // number of backends executing plan fragments on behalf of this query;
@@ -606,8 +611,13 @@ public class Coordinator {
         this.timeoutDeadline = System.currentTimeMillis() + queryOptions.getExecutionTimeout() * 1000L;
         if (topDataSink instanceof ResultSink || topDataSink instanceof ResultFileSink) {
             TNetworkAddress execBeAddr = topParams.instanceExecParams.get(0).host;
-            receiver = new ResultReceiver(topParams.instanceExecParams.get(0).instanceId,
-                    addressToBackendID.get(execBeAddr), toBrpcHost(execBeAddr), this.timeoutDeadline);
+            resultInstanceId = topParams.instanceExecParams.get(0).instanceId;
+            resultBrpcAddress = toBrpcHost(execBeAddr);
+            receiver = new ResultReceiver(resultInstanceId,
+                    addressToBackendID.get(execBeAddr), resultBrpcAddress, this.timeoutDeadline);
+            if (enableArrowResultFetch && topDataSink instanceof ResultSink) {
+                ((ResultSink) topDataSink).setResultSinkType(TResultSinkType.ARROW_PROTOCAL);
+            }
             if (LOG.isDebugEnabled()) {
                 LOG.debug("dispatch query job: {} to {}", DebugUtil.printId(queryId),
                         topParams.instanceExecParams.get(0).host);
@@ -1161,6 +1171,24 @@ public class Coordinator {
         }
     }
 
+    // Must be called before exec(). The result sink is then planned to send Arrow record batches,
+    // which are fetched by the client from getResultBrpcAddress() instead of by getNext().
+    public void setEnableArrowResultFetch(boolean enableArrowResultFetch) {
+        this.enableArrowResultFetch = enableArrowResultFetch;
+    }
+
+    public boolean isArrowResultFetch() {
+        return enableArrowResultFetch && fragments.get(0).getSink() instanceof ResultSink;
+    }
+
+    public TUniqueId getResultInstanceId() {
+        return resultInstanceId;
+    }
+
+    public TNetworkAddress getResultBrpcAddress() {
+        return resultBrpcAddress;
+    }
+
     public RowBatch getNext() throws Exception {
         if (receiver == null) {
             throw new UserException("There is no receiver.");
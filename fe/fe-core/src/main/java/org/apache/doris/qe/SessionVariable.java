@@ -275,6 +275,12 @@ public class SessionVariable implements Serializable, Writable {
 
     public static final String EXTERNAL_SORT_BYTES_THRESHOLD = "external_sort_bytes_threshold";
 
+    public static final String EXTERNAL_AGG_BYTES_THRESHOLD = "external_agg_bytes_threshold";
+
+    public static final String EXTERNAL_JOIN_BYTES_THRESHOLD = "external_join_bytes_threshold";
+
+    public static final String EXTERNAL_ANALYTIC_BYTES_THRESHOLD = "external_analytic_bytes_threshold";
+
     public static final String ENABLE_TWO_PHASE_READ_OPT = "enable_two_phase_read_opt";
     public static final String TOPN_OPT_LIMIT_THRESHOLD = "topn_opt_limit_threshold";
 
@@ -295,6 +301,8 @@ public class SessionVariable implements Serializable, Writable {
 
     public static final String DRY_RUN_QUERY = "dry_run_query";
 
+    public static final String ENABLE_ARROW_RESULT_FETCH = "enable_arrow_result_fetch";
+
     public static final List<String> DEBUG_VARIABLES = ImmutableList.of(
             SKIP_DELETE_PREDICATE,
             SKIP_DELETE_BITMAP,
@@ -751,6 +759,28 @@ public class SessionVariable implements Serializable, Writable {
             checker = "checkExternalSortBytesThreshold", fuzzy = true)
     public long externalSortBytesThreshold = 0;
 
+    // If the memory consumption of hash aggregation exceed this limit, will trigger spill to disk;
+    // Set to 0 to disable; min: 128M
+    public static final long MIN_EXTERNAL_AGG_BYTES_THRESHOLD = 134217728;
+    @VariableMgr.VarAttr(name = EXTERNAL_AGG_BYTES_THRESHOLD,
+            checker = "checkExternalAggBytesThreshold", fuzzy = true)
+    public long externalAggBytesThreshold = 0;
+
+    // If the build side of hash join exceed this limit, will trigger grace hash join;
+    // Set to 0 to disable; min: 128M
+    public static final long MIN_EXTERNAL_JOIN_BYTES_THRESHOLD = 134217728;
+    @VariableMgr.VarAttr(name = EXTERNAL_JOIN_BYTES_THRESHOLD,
+            checker = "checkExternalJoinBytesThreshold", fuzzy = true)
+    public long externalJoinBytesThreshold = 0;
+
+    // If the input buffered by an analytic node exceed this limit, the columns not needed to find
+    // the partition and peer group boundaries will be spilled to disk;
+    // Set to 0 to disable; min: 128M
+    public static final long MIN_EXTERNAL_ANALYTIC_BYTES_THRESHOLD = 134217728;
+    @VariableMgr.VarAttr(name = EXTERNAL_ANALYTIC_BYTES_THRESHOLD,
+            checker = "checkExternalAnalyticBytesThreshold", fuzzy = true)
+    public long externalAnalyticBytesThreshold = 0;
+
     // Whether enable two phase read optimization
     // 1. read related rowids along with necessary column data
     // 2. spawn fetch RPC to other nodes to get related data by sorted rowids
@@ -790,6 +820,12 @@ public class SessionVariable implements Serializable, Writable {
     @VariableMgr.VarAttr(name = DRY_RUN_QUERY, needForward = true)
     public boolean dryRunQuery = false;
 
+    // If set to true, the result of a query is not returned by FE. Instead FE returns the BE address
+    // and fragment instance id of the result sink, and the client fetches the result as Arrow
+    // record batches from BE with the fetch_data rpc.
+    @VariableMgr.VarAttr(name = ENABLE_ARROW_RESULT_FETCH, needForward = true)
+    public boolean enableArrowResultFetch = false;
+
     // If this fe is in fuzzy mode, then will use initFuzzyModeVariables to generate some variables,
     // not the default value set in the code.
     public void initFuzzyModeVariables() {
@@ -824,6 +860,10 @@ public class SessionVariable implements Serializable, Writable {
                 this.externalSortBytesThreshold = 100 * 1024 * 1024 * 1024;
                 break;
         }
+        // random thresholds between 1M and 1G, so that the spills start at different points
+        this.externalAggBytesThreshold = random.nextBoolean() ? 0 : 1L << (20 + random.nextInt(11));
+        this.externalJoinBytesThreshold = random.nextBoolean() ? 0 : 1L << (20 + random.nextInt(11));
+        this.externalAnalyticBytesThreshold = random.nextBoolean() ? 0 : 1L << (20 + random.nextInt(11));
         // pull_request_id default value is 0
         if (Config.pull_request_id % 2 == 1) {
             this.enablePipelineEngine = true;
@@ -1584,6 +1624,31 @@ public class SessionVariable implements Serializable, Writable {
         }
     }
 
+    public void checkExternalAggBytesThreshold(String externalAggBytesThreshold) {
+        long value = Long.valueOf(externalAggBytesThreshold);
+        if (value > 0 && value < MIN_EXTERNAL_AGG_BYTES_THRESHOLD) {
+            LOG.warn("external agg bytes threshold: {}, min: {}", value, MIN_EXTERNAL_AGG_BYTES_THRESHOLD);
+            throw new UnsupportedOperationException("minimum value is " + MIN_EXTERNAL_AGG_BYTES_THRESHOLD);
+        }
+    }
+
+    public void checkExternalJoinBytesThreshold(String externalJoinBytesThreshold) {
+        long value = Long.valueOf(externalJoinBytesThreshold);
+        if (value > 0 && value < MIN_EXTERNAL_JOIN_BYTES_THRESHOLD) {
+            LOG.warn("external join bytes threshold: {}, min: {}", value, MIN_EXTERNAL_JOIN_BYTES_THRESHOLD);
+            throw new UnsupportedOperationException("minimum value is " + MIN_EXTERNAL_JOIN_BYTES_THRESHOLD);
+        }
+    }
+
+    public void checkExternalAnalyticBytesThreshold(String externalAnalyticBytesThreshold) {
+        long value = Long.valueOf(externalAnalyticBytesThreshold);
+        if (value > 0 && value < MIN_EXTERNAL_ANALYTIC_BYTES_THRESHOLD) {
+            LOG.warn("external analytic bytes threshold: {}, min: {}", value,
+                    MIN_EXTERNAL_ANALYTIC_BYTES_THRESHOLD);
+            throw new UnsupportedOperationException("minimum value is " + MIN_EXTERNAL_ANALYTIC_BYTES_THRESHOLD);
+        }
+    }
+
     public boolean isEnableFileCache() {
         return enableFileCache;
     }
@@ -1673,6 +1738,12 @@ public class SessionVariable implements Serializable, Writable {
 
         tResult.setExternalSortBytesThreshold(externalSortBytesThreshold);
 
+        tResult.setExternalAggBytesThreshold(externalAggBytesThreshold);
+
+        tResult.setExternalJoinBytesThreshold(externalJoinBytesThreshold);
+
+        tResult.setExternalAnalyticBytesThreshold(externalAnalyticBytesThreshold);
+
         tResult.setEnableFileCache(enableFileCache);
 
         if (dryRunQuery) {
@@ -213,6 +213,15 @@ public class StmtExecutor implements ProfileWriter {
     private static final CommonResultSetMetaData DRY_RUN_QUERY_METADATA = new CommonResultSetMetaData(
             Lists.newArrayList(new Column("ReturnedRows", PrimitiveType.STRING)));
 
+    // The result schema if "enable_arrow_result_fetch" is true.
+    // The client fetches the Arrow record batches of the query result with the fetch_data rpc of
+    // the BE brpc service at Host:BrpcPort, with FragmentInstanceId as finst_id.
+    private static final CommonResultSetMetaData ARROW_RESULT_FETCH_METADATA = new CommonResultSetMetaData(
+            Lists.newArrayList(new Column("QueryId", PrimitiveType.STRING),
+                    new Column("FragmentInstanceId", PrimitiveType.STRING),
+                    new Column("Host", PrimitiveType.STRING),
+                    new Column("BrpcPort", PrimitiveType.STRING)));
+
     // this constructor is mainly for proxy
     public StmtExecutor(ConnectContext context, OriginStatement originStmt, boolean isProxy) {
         this.context = context;
@@ -1284,7 +1293,8 @@ public class StmtExecutor implements ProfileWriter {
 
         // Sql and PartitionCache
         CacheAnalyzer cacheAnalyzer = new CacheAnalyzer(context, parsedStmt, planner);
-        if (cacheAnalyzer.enableCache() && !isOutfileQuery && queryStmt instanceof SelectStmt) {
+        if (cacheAnalyzer.enableCache() && !isOutfileQuery && queryStmt instanceof SelectStmt
+                && !context.getSessionVariable().enableArrowResultFetch) {
             handleCacheStmt(cacheAnalyzer, channel, (SelectStmt) queryStmt);
             return;
         }
@@ -1317,6 +1327,9 @@ public class StmtExecutor implements ProfileWriter {
         QeProcessorImpl.INSTANCE.registerQuery(context.queryId(),
                 new QeProcessorImpl.QueryInfo(context, originStmt.originStmt, coord));
         coord.setProfileWriter(this);
+        coord.setEnableArrowResultFetch(!isOutfileQuery && cacheAnalyzer == null
+                && context.getSessionVariable().enableArrowResultFetch
+                && !context.getSessionVariable().dryRunQuery);
         Span queryScheduleSpan =
                 context.getTracer().spanBuilder("query schedule").setParent(Context.current()).startSpan();
         try (Scope scope = queryScheduleSpan.makeCurrent()) {
@@ -1329,6 +1342,17 @@ public class StmtExecutor implements ProfileWriter {
         }
         plannerProfile.setQueryScheduleFinishTime();
         writeProfile(false);
+        if (coord.isArrowResultFetch()) {
+            // The result is not fetched by FE, the fragments keep running until the client fetches
+            // the result or the query times out.
+            List<String> data = Lists.newArrayList(DebugUtil.printId(context.queryId()),
+                    DebugUtil.printId(coord.getResultInstanceId()),
+                    coord.getResultBrpcAddress().getHostname(),
+                    String.valueOf(coord.getResultBrpcAddress().getPort()));
+            sendResultSet(new CommonResultSet(ARROW_RESULT_FETCH_METADATA, Collections.singletonList(data)));
+            plannerProfile.setQueryFetchResultFinishTime();
+            return;
+        }
         Span fetchResultSpan = context.getTracer().spanBuilder("fetch result").setParent(Context.current()).startSpan();
         try (Scope scope = fetchResultSpan.makeCurrent()) {
             while (true) {
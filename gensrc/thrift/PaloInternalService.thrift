@@ -209,6 +209,12 @@ struct TQueryOptions {
   66: optional i32 parallel_instance = 1
   // Indicate where useServerPrepStmts enabled
   67: optional bool mysql_row_binary_format = false;
+
+  68: optional i64 external_agg_bytes_threshold = 0
+
+  69: optional i64 external_join_bytes_threshold = 0
+
+  70: optional i64 external_analytic_bytes_threshold = 0
 }
     
 
@@ -577,6 +583,14 @@ struct TPipelineInstanceParams {
 }
 
 // ExecPlanFragment
+struct TPipelineTaskGroup {
+  1: optional i64 id
+  2: optional string name
+  3: optional i64 cpu_share
+  // max cpu of the pipeline executors the group may use, in percent, 0 means no limit
+  4: optional i32 cpu_hard_limit
+}
+
 struct TPipelineFragmentParams {
   1: required PaloInternalServiceVersion protocol_version
   2: required Types.TUniqueId query_id
@@ -604,6 +618,8 @@ struct TPipelineFragmentParams {
   23: optional Planner.TPlanFragment fragment
   24: list<TPipelineInstanceParams> local_params
   25: optional bool shared_scan_opt = false;
+  // the task group the pipeline tasks of the query are scheduled in
+  26: optional TPipelineTaskGroup task_group
 }
 
 struct TPipelineFragmentParamsList {